@@ -6,10 +6,14 @@
  * exposes lightweight diagnostics: total frame time, maximum single-agent
  * time, agent count, and whether the configured budget was exceeded.
  *
+ * Timings use the unified profiler clock; the AI frame and each recorded agent
+ * tick also appear as "ai_frame" / "ai_agent" zones in profiler traces.
+ *
  * This module is intentionally simple and not thread-safe. It is intended
  * for use from a single-threaded update loop or with external synchronization.
  */
 #include "ai_profiler.h"
+#include "../../util/profiler.h"
 
 /** Default per-frame AI budget in milliseconds. */
 static double g_budget_ms = 1.0; /* default 1ms */
@@ -21,6 +25,10 @@ static double g_max_agent_ms = 0.0;
 static int g_agent_count = 0;
 /** Budget-exceeded flag for the current frame (1 if exceeded, else 0). */
 static int g_budget_exceeded = 0;
+/** Unified profiler zones (registered on first use). */
+static RogueProfZoneSlot g_frame_zone, g_agent_zone;
+/** 1 while the "ai_frame" profiler scope is open. */
+static int g_frame_open = 0;
 
 /**
  * @brief Set the per-frame AI budget in milliseconds.
@@ -47,10 +55,15 @@ double rogue_ai_profiler_get_budget_ms(void) { return g_budget_ms; }
  * @brief Begin a new profiling frame.
  *
  * Resets accumulated counters and flags. Call at the start of the AI update
- * frame before recording per-agent timings.
+ * frame before recording per-agent timings. Opens the "ai_frame" profiler scope.
  */
 void rogue_ai_profiler_begin_frame(void)
 {
+    if (!g_frame_open)
+    {
+        rogue_prof_begin(rogue_prof_zone_slot(&g_frame_zone, "ai_frame"));
+        g_frame_open = 1;
+    }
     g_accum_ms = 0.0;
     g_max_agent_ms = 0.0;
     g_agent_count = 0;
@@ -79,12 +92,39 @@ void rogue_ai_profiler_record_agent(double ms)
 }
 
 /**
- * @brief End of frame hook (no-op placeholder).
+ * @brief Start timing one agent tick.
+ * @return unsigned long long Monotonic timestamp to pass to rogue_ai_profiler_agent_end.
+ */
+unsigned long long rogue_ai_profiler_agent_begin(void) { return rogue_prof_now_ns(); }
+
+/**
+ * @brief Finish timing one agent tick and record it.
+ *
+ * Records the elapsed time via rogue_ai_profiler_record_agent and emits an
+ * "ai_agent" profiler scope covering the tick.
+ *
+ * @param begin_ns Timestamp returned by rogue_ai_profiler_agent_begin.
+ */
+void rogue_ai_profiler_agent_end(unsigned long long begin_ns)
+{
+    unsigned long long dur_ns = rogue_prof_now_ns() - begin_ns;
+    rogue_prof_complete(rogue_prof_zone_slot(&g_agent_zone, "ai_agent"), dur_ns);
+    rogue_ai_profiler_record_agent((double) dur_ns / 1e6);
+}
+
+/**
+ * @brief End of frame hook.
  *
- * Present for API symmetry; future instrumentation or rollover logic may be
- * placed here.
+ * Closes the "ai_frame" profiler scope opened by rogue_ai_profiler_begin_frame;
+ * the frame counters stay readable until the next begin.
  */
-void rogue_ai_profiler_end_frame(void) {}
+void rogue_ai_profiler_end_frame(void)
+{
+    if (!g_frame_open)
+        return;
+    rogue_prof_end(rogue_prof_zone_slot(&g_frame_zone, "ai_frame"));
+    g_frame_open = 0;
+}
 
 /**
  * @brief Snapshot current profiler state into the provided structure.
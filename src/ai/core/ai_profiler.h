@@ -19,6 +19,9 @@ extern "C"
     double rogue_ai_profiler_get_budget_ms(void);
     void rogue_ai_profiler_begin_frame(void);
     void rogue_ai_profiler_record_agent(double ms);
+    /* Time one agent tick on the unified profiler clock: end records the elapsed ms. */
+    unsigned long long rogue_ai_profiler_agent_begin(void);
+    void rogue_ai_profiler_agent_end(unsigned long long begin_ns);
     void rogue_ai_profiler_end_frame(void);
     void rogue_ai_profiler_snapshot(RogueAIProfileSnapshot* out);
     void rogue_ai_profiler_reset_for_tests(void);
@@ -10,6 +10,7 @@
  */
 #include "ai_scheduler.h"
 #include "../../core/app/app_state.h"
+#include "ai_profiler.h"
 #include "../../entities/enemy.h"
 #include <math.h>
 
@@ -111,6 +112,7 @@ static void maintenance_tick(RogueEnemy* e, float dt)
  *    bucket_count equals the current bucket are processed this frame; others
  *    receive the maintenance tick.
  *  - For selected enemies, call rogue_enemy_ai_bt_tick to execute behavior tree logic.
+ *    Each call is one AI profiler frame; full behavior tree ticks are recorded as agents.
  *
  * The function increments the internal frame counter each invocation. If
  * enemies is NULL or count <= 0 the function simply increments the frame and returns.
@@ -127,6 +129,7 @@ void rogue_ai_scheduler_tick(RogueEnemy* enemies, int count, float dt_seconds)
         return;
     }
     int bucket = g_frame % g_buckets;
+    rogue_ai_profiler_begin_frame();
     for (int i = 0; i < count; i++)
     {
         RogueEnemy* e = &enemies[i];
@@ -154,7 +157,10 @@ void rogue_ai_scheduler_tick(RogueEnemy* enemies, int count, float dt_seconds)
             }
         }
         /* Full behavior tree tick */
+        unsigned long long t0 = rogue_ai_profiler_agent_begin();
         rogue_enemy_ai_bt_tick(e, dt_seconds);
+        rogue_ai_profiler_agent_end(t0);
     }
+    rogue_ai_profiler_end_frame();
     g_frame++;
 }
@@ -21,6 +21,19 @@ typedef enum RogueEffectPriority
     ROGUE_FX_PRI_AMBIENCE = 3
 } RogueEffectPriority;
 
+/* Interned FX ids: gameplay event keys, audio ids and VFX ids map to dense integer handles that
+   stay valid for the process lifetime, so registries and the bus compare / index integers. */
+typedef uint32_t RogueFxId;
+#define ROGUE_FX_ID_NONE 0u
+#define ROGUE_FX_ID_MAX_LEN 31 /* longer strings are not internable */
+
+/* Insert-or-find; returns ROGUE_FX_ID_NONE for NULL, empty or over-long strings. */
+RogueFxId rogue_fx_intern(const char* s);
+/* Lookup without inserting (ROGUE_FX_ID_NONE when the string was never interned). */
+RogueFxId rogue_fx_id_find(const char* s);
+/* String behind a handle, or NULL when invalid. */
+const char* rogue_fx_id_str(RogueFxId id);
+
 typedef struct RogueEffectEvent
 {
     uint32_t emit_frame; /* producer frame index (optional; 0 if unknown) */
@@ -30,7 +43,8 @@ typedef struct RogueEffectEvent
     uint16_t repeats;    /* frame compaction: number of identical events merged (>=1) */
     /* Payload: for audio, string id key (small fixed buffer); for vfx, params TBD */
     char id[24];
-    float x, y; /* for VFX/world-space if needed */
+    float x, y;     /* for VFX/world-space if needed */
+    RogueFxId id_h; /* interned id (assigned by the bus on emit) */
 } RogueEffectEvent;
 
 /* Frame lifecycle */
@@ -71,6 +85,54 @@ void rogue_audio_play_by_id(const char* id);
 int rogue_audio_registry_get_path(const char* id, char* out, size_t out_sz);
 void rogue_audio_registry_clear(void);
 
+/* -------- Audio preload + decoded sample cache -------- */
+
+/* Decoder hook: returns an owned sample for path (NULL on failure) and its resident size. The
+   default decodes through SDL_mixer when available; without it no decoder is installed and the
+   cache stays inert. Install before rogue_audio_preload_start (decoders run on worker threads). */
+typedef void* (*RogueAudioDecodeFn)(const char* path, size_t* out_bytes);
+typedef void (*RogueAudioReleaseFn)(void* sample);
+void rogue_audio_cache_set_decoder(RogueAudioDecodeFn decode, RogueAudioReleaseFn release);
+
+/* Start decode workers (at most 4). Returns the worker count; with 0 (workers <= 0 or no thread
+   support) queued preloads are decoded one per rogue_audio_cache_poll instead. */
+int rogue_audio_preload_start(int workers);
+/* Stop workers and release every decoded sample (call before closing the audio device). */
+void rogue_audio_preload_shutdown(void);
+
+/* Queue registered sounds for background decode; higher priority decodes first. Returns the
+   number of sounds newly queued (or re-prioritised), or -1 for an unknown id. */
+int rogue_audio_preload_id(const char* id, int priority);
+int rogue_audio_preload_category(RogueAudioCategory cat, int priority);
+/* Block until every queued preload is resident (loading screens / tests). */
+void rogue_audio_preload_wait(void);
+
+/* Resident byte budget for unpinned samples (least recently played evicted first). */
+void rogue_audio_cache_set_budget(size_t bytes);
+/* Reference-counted pin: pinned sounds are preloaded first and never evicted. Music tracks and
+   the active layer are pinned automatically while audible. Return the new count or -1. */
+int rogue_audio_cache_pin(const char* id);
+int rogue_audio_cache_unpin(const char* id);
+
+/* Per-frame: publish finished decodes and enforce the budget. */
+void rogue_audio_cache_poll(void);
+
+typedef struct RogueAudioCacheStats
+{
+    uint32_t resident;    /* decoded samples held */
+    uint32_t pinned;      /* sounds with a pin count > 0 */
+    uint32_t pending;     /* queued or decoding */
+    uint32_t hits;        /* plays served from a resident sample */
+    uint32_t stalls;      /* plays that had to decode (or wait for a decode) in-frame */
+    uint32_t async_loads; /* decodes finished off the play path */
+    uint32_t evictions;
+    uint32_t failures;
+    uint64_t resident_bytes;
+    uint64_t budget_bytes;
+    double stall_ms; /* total time plays spent blocked on decode */
+} RogueAudioCacheStats;
+void rogue_audio_cache_get_stats(RogueAudioCacheStats* out);
+
 /* Channel mixer (Phase 2.3) */
 void rogue_audio_mixer_set_master(float gain); /* 0..1 */
 float rogue_audio_mixer_get_master(void);
@@ -297,6 +359,9 @@ void rogue_fx_map_clear(void);
     For VFX entries, (x,y) are used as the spawn position. For audio entries, (x,y) feed positional
     attenuation when enabled. Returns number of FX events enqueued. */
 int rogue_fx_trigger_event(const char* gameplay_event_key, float x, float y);
+/* Same as rogue_fx_trigger_event with a pre-interned key (rogue_fx_intern); skips the string
+    lookup on hot paths. */
+int rogue_fx_trigger_event_id(RogueFxId gameplay_event_key, float x, float y);
 
 /* ---- Damage event hook (Phase 5.2) ---- */
 /* Bind an observer to combat damage events that translates events into gameplay keys and triggers
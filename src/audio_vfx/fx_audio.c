@@ -2,6 +2,7 @@
 #include "effects.h"
 #include "fx_internal.h"
 #include <math.h>
+#include <stdlib.h>
 #include <string.h>
 
 #ifdef ROGUE_HAVE_SDL_MIXER
@@ -11,17 +12,21 @@
 typedef struct AudioReg
 {
     char id[24];
+    RogueFxId id_h;
     char path[128];
     uint8_t cat;
     float base_gain;
-#ifdef ROGUE_HAVE_SDL_MIXER
-    Mix_Chunk* chunk;
-#endif
 } AudioReg;
 
-#define ROGUE_AUDIO_REG_CAP 64
 static AudioReg g_audio_reg[ROGUE_AUDIO_REG_CAP];
 static int g_audio_reg_count = 0;
+static RogueFxIdMap g_audio_by_id; /* interned id -> registry index */
+/* Variant lists ("<base>_*" registry indices) cached per base id until the registry changes:
+   g_audio_variants maps the base id to an offset in g_audio_var_pool holding [count, idx...]. */
+static RogueFxIdMap g_audio_variants;
+static int* g_audio_var_pool = NULL;
+static int g_audio_var_pool_count = 0;
+static int g_audio_var_pool_cap = 0;
 
 /* Channel mixer state */
 static float g_mixer_master = 1.0f;
@@ -57,6 +62,8 @@ static MusicLayerReg g_music_layers[ROGUE_MUSIC_STATE_COUNT][ROGUE_MUSIC_MAX_LAY
 static uint8_t g_music_layer_counts[ROGUE_MUSIC_STATE_COUNT];
 static char g_music_active_sweetener[24];
 static float g_music_active_sweetener_gain = 0.0f;
+/* Registry indices pinned in the sample cache for the active, fading and layer tracks. */
+static int g_music_pinned[3] = {-1, -1, -1};
 
 /* Environment */
 static RogueAudioReverbPreset g_reverb_preset = ROGUE_AUDIO_REVERB_NONE;
@@ -75,10 +82,45 @@ static int g_voice_cap = 16;
 
 static int audio_reg_find(const char* id)
 {
-    for (int i = 0; i < g_audio_reg_count; ++i)
-        if (strncmp(g_audio_reg[i].id, id, sizeof g_audio_reg[i].id) == 0)
-            return i;
-    return -1;
+    return rogue_fx_idmap_get(&g_audio_by_id, rogue_fx_id_find(id));
+}
+
+static void audio_variants_invalidate(void)
+{
+    rogue_fx_idmap_reset(&g_audio_variants);
+    g_audio_var_pool_count = 0;
+}
+
+/* Registry indices of the "<base>_*" variants of an event id (at most 32, registry order). */
+static const int* audio_variants(const RogueEffectEvent* e, int* out_count)
+{
+    *out_count = 0;
+    int off = rogue_fx_idmap_get(&g_audio_variants, e->id_h);
+    if (off < 0)
+    {
+        if (g_audio_var_pool_count + 33 > g_audio_var_pool_cap)
+        {
+            int cap = g_audio_var_pool_cap ? g_audio_var_pool_cap * 2 : 256;
+            int* pool = (int*) realloc(g_audio_var_pool, sizeof(int) * (size_t) cap);
+            if (!pool)
+                return NULL;
+            g_audio_var_pool = pool;
+            g_audio_var_pool_cap = cap;
+        }
+        off = g_audio_var_pool_count;
+        int* list = &g_audio_var_pool[off];
+        int base_len = (int) strnlen(e->id, sizeof e->id);
+        list[0] = 0;
+        for (int ridx = 0; ridx < g_audio_reg_count && list[0] < 32; ++ridx)
+            if (strncmp(g_audio_reg[ridx].id, e->id, (size_t) base_len) == 0 &&
+                g_audio_reg[ridx].id[base_len] == '_')
+                list[1 + list[0]++] = ridx;
+        if (rogue_fx_idmap_set(&g_audio_variants, e->id_h, off) != 0)
+            return NULL;
+        g_audio_var_pool_count += 1 + list[0];
+    }
+    *out_count = g_audio_var_pool[off];
+    return &g_audio_var_pool[off + 1];
 }
 
 int rogue_audio_registry_register(const char* id, const char* path, RogueAudioCategory cat,
@@ -87,19 +129,32 @@ int rogue_audio_registry_register(const char* id, const char* path, RogueAudioCa
     if (!id || !*id || !path || !*path)
         return -2;
     int idx = audio_reg_find(id);
+    int path_changed = 1;
     if (idx < 0)
     {
         if (g_audio_reg_count >= ROGUE_AUDIO_REG_CAP)
             return -3;
-        idx = g_audio_reg_count++;
-        memset(&g_audio_reg[idx], 0, sizeof g_audio_reg[idx]);
+        AudioReg* r = &g_audio_reg[g_audio_reg_count];
+        memset(r, 0, sizeof *r);
 #if defined(_MSC_VER)
-        strncpy_s(g_audio_reg[idx].id, sizeof g_audio_reg[idx].id, id, _TRUNCATE);
+        strncpy_s(r->id, sizeof r->id, id, _TRUNCATE);
 #else
-        strncpy(g_audio_reg[idx].id, id, sizeof g_audio_reg[idx].id - 1);
-        g_audio_reg[idx].id[sizeof g_audio_reg[idx].id - 1] = '\0';
+        strncpy(r->id, id, sizeof r->id - 1);
+        r->id[sizeof r->id - 1] = '\0';
 #endif
+        r->id_h = rogue_fx_intern(r->id);
+        idx = rogue_fx_idmap_get(&g_audio_by_id, r->id_h);
+        if (idx < 0)
+        {
+            if (r->id_h == ROGUE_FX_ID_NONE ||
+                rogue_fx_idmap_set(&g_audio_by_id, r->id_h, g_audio_reg_count) != 0)
+                return -3;
+            idx = g_audio_reg_count++;
+            audio_variants_invalidate();
+        }
     }
+    else
+        path_changed = strncmp(g_audio_reg[idx].path, path, sizeof g_audio_reg[idx].path - 1) != 0;
 #if defined(_MSC_VER)
     strncpy_s(g_audio_reg[idx].path, sizeof g_audio_reg[idx].path, path, _TRUNCATE);
 #else
@@ -108,49 +163,30 @@ int rogue_audio_registry_register(const char* id, const char* path, RogueAudioCa
 #endif
     g_audio_reg[idx].cat = (uint8_t) cat;
     g_audio_reg[idx].base_gain = (base_gain < 0 ? 0 : (base_gain > 1 ? 1 : base_gain));
-#ifdef ROGUE_HAVE_SDL_MIXER
-    if (g_audio_reg[idx].chunk)
-    {
-        Mix_FreeChunk(g_audio_reg[idx].chunk);
-        g_audio_reg[idx].chunk = NULL;
-    }
-#endif
+    if (path_changed)
+        rogue_audio_cache_invalidate(idx);
     return 0;
 }
 
-void rogue_audio_play_by_id(const char* id)
+static void audio_play_index(int idx, const char* id)
 {
-    int idx = audio_reg_find(id);
     if (idx < 0)
     {
         ROGUE_LOG_WARN("Audio id not found: %s", id ? id : "<null>");
         return;
     }
+    void* sample = rogue_audio_cache_acquire(idx, g_audio_reg[idx].path);
 #ifdef ROGUE_HAVE_SDL_MIXER
-    if (g_audio_reg[idx].chunk)
-    {
-        if (g_voice_cap > 0 && Mix_Playing(-1) >= g_voice_cap)
-            return;
-        Mix_PlayChannel(-1, g_audio_reg[idx].chunk, 0);
-    }
-    else
-    {
-        g_audio_reg[idx].chunk = Mix_LoadWAV(g_audio_reg[idx].path);
-        if (!g_audio_reg[idx].chunk)
-        {
-            ROGUE_LOG_WARN("Audio lazy load failed id=%s path=%s err=%s", id, g_audio_reg[idx].path,
-                           Mix_GetError());
-            return;
-        }
-        if (g_voice_cap > 0 && Mix_Playing(-1) >= g_voice_cap)
-            return;
-        Mix_PlayChannel(-1, g_audio_reg[idx].chunk, 0);
-    }
+    if (!sample || (g_voice_cap > 0 && Mix_Playing(-1) >= g_voice_cap))
+        return;
+    Mix_PlayChannel(-1, (Mix_Chunk*) sample, 0);
 #else
-    (void) idx;
+    (void) sample;
 #endif
 }
 
+void rogue_audio_play_by_id(const char* id) { audio_play_index(audio_reg_find(id), id); }
+
 int rogue_audio_registry_get_path(const char* id, char* out, size_t out_sz)
 {
     int idx = audio_reg_find(id);
@@ -166,17 +202,13 @@ int rogue_audio_registry_get_path(const char* id, char* out, size_t out_sz)
 
 void rogue_audio_registry_clear(void)
 {
-#ifdef ROGUE_HAVE_SDL_MIXER
+    rogue_audio_cache_reset();
+    for (int i = 0; i < 3; ++i)
+        g_music_pinned[i] = -1;
     for (int i = 0; i < g_audio_reg_count; ++i)
-    {
-        if (g_audio_reg[i].chunk)
-        {
-            Mix_FreeChunk(g_audio_reg[i].chunk);
-            g_audio_reg[i].chunk = NULL;
-        }
-    }
-#endif
+        rogue_fx_idmap_set(&g_audio_by_id, g_audio_reg[i].id_h, -1);
     g_audio_reg_count = 0;
+    audio_variants_invalidate();
     for (int i = 0; i < ROGUE_MUSIC_STATE_COUNT; ++i)
     {
         g_music_state_tracks[i][0] = '\0';
@@ -198,6 +230,34 @@ void rogue_audio_registry_clear(void)
     g_lowpass_min_factor = 0.4f;
 }
 
+int rogue_audio_preload_id(const char* id, int priority)
+{
+    int idx = audio_reg_find(id);
+    if (idx < 0)
+        return -1;
+    return rogue_audio_cache_request(idx, g_audio_reg[idx].path, priority);
+}
+
+int rogue_audio_preload_category(RogueAudioCategory cat, int priority)
+{
+    int queued = 0;
+    for (int i = 0; i < g_audio_reg_count; ++i)
+        if (g_audio_reg[i].cat == (uint8_t) cat)
+            queued += rogue_audio_cache_request(i, g_audio_reg[i].path, priority);
+    return queued;
+}
+
+int rogue_audio_cache_pin(const char* id)
+{
+    int idx = audio_reg_find(id);
+    return idx < 0 ? -1 : rogue_audio_cache_pin_index(idx, g_audio_reg[idx].path);
+}
+
+int rogue_audio_cache_unpin(const char* id)
+{
+    return rogue_audio_cache_unpin_index(audio_reg_find(id));
+}
+
 void rogue_audio_mixer_set_master(float gain)
 {
     g_mixer_master = gain < 0 ? 0 : (gain > 1 ? 1 : gain);
@@ -246,9 +306,8 @@ static float compute_attenuation(float x, float y)
     return a;
 }
 
-float rogue_audio_debug_effective_gain(const char* id, unsigned repeats, float x, float y)
+static float audio_effective_gain_index(int idx, unsigned repeats, float x, float y)
 {
-    int idx = audio_reg_find(id);
     if (idx < 0)
         return 0.0f;
     float rep = repeats < 1 ? 1.0f : (float) repeats;
@@ -308,6 +367,11 @@ float rogue_audio_debug_effective_gain(const char* id, unsigned repeats, float x
     return eff;
 }
 
+float rogue_audio_debug_effective_gain(const char* id, unsigned repeats, float x, float y)
+{
+    return audio_effective_gain_index(audio_reg_find(id), repeats, x, y);
+}
+
 int rogue_audio_music_register(RogueMusicState state, const char* track_id)
 {
     if ((int) state < 0 || state >= ROGUE_MUSIC_STATE_COUNT || !track_id || !*track_id)
@@ -324,6 +388,27 @@ int rogue_audio_music_register(RogueMusicState state, const char* track_id)
     return 0;
 }
 
+/* Keep the audible music tracks pinned: pin the new set before releasing the old one so a track
+   that stays audible never drops to a zero count. */
+static void music_pins_sync(void)
+{
+    const char* tracks[3] = {g_music_active_track, g_music_fadeout_track,
+                             g_music_active_sweetener};
+    int want[3];
+    for (int i = 0; i < 3; ++i)
+    {
+        want[i] = tracks[i][0] ? audio_reg_find(tracks[i]) : -1;
+        if (want[i] >= 0)
+            rogue_audio_cache_pin_index(want[i], g_audio_reg[want[i]].path);
+    }
+    for (int i = 0; i < 3; ++i)
+    {
+        if (g_music_pinned[i] >= 0)
+            rogue_audio_cache_unpin_index(g_music_pinned[i]);
+        g_music_pinned[i] = want[i];
+    }
+}
+
 static void music_begin_crossfade(const char* new_track, uint32_t crossfade_ms)
 {
     if (!new_track || !*new_track)
@@ -413,6 +498,7 @@ int rogue_audio_music_set_state(RogueMusicState state, uint32_t crossfade_ms)
     if (!track[0])
         return -2;
     music_begin_crossfade(track, crossfade_ms);
+    music_pins_sync();
     return 0;
 }
 
@@ -539,6 +625,7 @@ void rogue_audio_music_update(uint32_t dt_ms)
     if (step > 1.0f)
         step = 1.0f;
     g_reverb_wet += diff * step;
+    music_pins_sync();
 }
 
 void rogue_audio_env_set_reverb_preset(RogueAudioReverbPreset preset)
@@ -699,43 +786,44 @@ void rogue_audio_dispatch_play_event(const RogueEffectEvent* e)
 {
     if (!e)
         return;
-    /* Determine variant choice */
-    int base_len = (int) strnlen(e->id, sizeof e->id);
-    const char* chosen = e->id;
-    int var_indices[32];
-    int var_count = 0;
-    for (int ridx = 0;
-         ridx < g_audio_reg_count && var_count < (int) (sizeof var_indices / sizeof var_indices[0]);
-         ++ridx)
+    RogueEffectEvent resolved;
+    if (e->id_h == ROGUE_FX_ID_NONE)
     {
-        if (strncmp(g_audio_reg[ridx].id, e->id, (size_t) base_len) == 0 &&
-            g_audio_reg[ridx].id[base_len] == '_')
-            var_indices[var_count++] = ridx;
+        /* direct callers may pass unresolved events */
+        resolved = *e;
+        char id[sizeof resolved.id + 1];
+        memcpy(id, resolved.id, sizeof resolved.id);
+        id[sizeof resolved.id] = '\0';
+        resolved.id_h = rogue_fx_intern(id);
+        e = &resolved;
     }
+    /* Determine variant choice */
+    int base_idx = rogue_fx_idmap_get(&g_audio_by_id, e->id_h);
+    int ci = base_idx;
+    int var_count = 0;
+    const int* var_indices = audio_variants(e, &var_count);
     if (var_count > 0)
     {
         uint32_t s =
             (rogue_fx_internal_current_frame() * 2654435761u) ^ e->seq ^ rogue_fx_rand_u32();
         int pick = (int) (s % (uint32_t) var_count);
-        chosen = g_audio_reg[var_indices[pick]].id;
+        ci = var_indices[pick];
     }
 #ifdef ROGUE_HAVE_SDL_MIXER
-    int ci = audio_reg_find(chosen);
     if (ci >= 0)
     {
-        if (!g_audio_reg[ci].chunk)
-            g_audio_reg[ci].chunk = Mix_LoadWAV(g_audio_reg[ci].path);
-        if (g_audio_reg[ci].chunk && !(g_voice_cap > 0 && Mix_Playing(-1) >= g_voice_cap))
+        Mix_Chunk* chunk = (Mix_Chunk*) rogue_audio_cache_acquire(ci, g_audio_reg[ci].path);
+        if (chunk && !(g_voice_cap > 0 && Mix_Playing(-1) >= g_voice_cap))
         {
-            float eff = rogue_audio_debug_effective_gain(
-                chosen, (unsigned) (e->repeats ? e->repeats : 1), e->x, e->y);
+            float eff = audio_effective_gain_index(ci, (unsigned) (e->repeats ? e->repeats : 1),
+                                                   e->x, e->y);
             int vol = (int) (eff * 128.0f);
             Mix_Volume(-1, vol);
-            Mix_PlayChannel(-1, g_audio_reg[ci].chunk, 0);
+            Mix_PlayChannel(-1, chunk, 0);
         }
     }
 #else
-    (void) chosen;
-    rogue_audio_play_by_id(e->id);
+    (void) base_idx;
+    audio_play_index(ci, e->id);
 #endif
 }
@@ -0,0 +1,501 @@
+/* fx_audio_cache.c - Background audio preloading and byte-budgeted decoded sample cache */
+#include "../util/log.h"
+#include "effects.h"
+#include "fx_internal.h"
+#include <string.h>
+#include <time.h>
+
+#if defined(ROGUE_HAVE_SDL)
+#include <SDL.h>
+#endif
+#ifdef ROGUE_HAVE_SDL_MIXER
+#include <SDL_mixer.h>
+#endif
+
+/* Slots are indexed like the audio registry. Preloads move a slot EMPTY -> QUEUED -> LOADING ->
+ * DECODED on a worker; the main thread publishes DECODED -> READY (poll or first play) so byte
+ * accounting, eviction and sample release stay on the thread that plays sounds. A generation
+ * counter discards decodes whose registry entry changed while they were in flight. */
+
+typedef enum CacheSlotState
+{
+    SLOT_EMPTY = 0,
+    SLOT_QUEUED,
+    SLOT_LOADING,
+    SLOT_DECODED,
+    SLOT_READY,
+    SLOT_FAILED
+} CacheSlotState;
+
+typedef struct CacheSlot
+{
+    uint8_t state;
+    int priority;
+    uint32_t seq; /* request order, breaks priority ties */
+    uint32_t gen;
+    int pins;
+    char path[128];
+    void* sample;
+    size_t bytes;
+    uint64_t last_use;
+} CacheSlot;
+
+#define ROGUE_AUDIO_LOADER_MAX_WORKERS 4
+
+static CacheSlot g_slots[ROGUE_AUDIO_REG_CAP];
+static uint32_t g_seq = 0;
+static uint64_t g_use_clock = 0;
+static size_t g_budget = (size_t) 32 * 1024 * 1024;
+static RogueAudioCacheStats g_stats;
+
+#ifdef ROGUE_HAVE_SDL_MIXER
+static void* mixer_decode(const char* path, size_t* out_bytes)
+{
+    Mix_Chunk* c = Mix_LoadWAV(path);
+    *out_bytes = c ? (size_t) c->alen : 0;
+    return c;
+}
+static void mixer_release(void* sample) { Mix_FreeChunk((Mix_Chunk*) sample); }
+static RogueAudioDecodeFn g_decode = mixer_decode;
+static RogueAudioReleaseFn g_release = mixer_release;
+#else
+static RogueAudioDecodeFn g_decode = NULL;
+static RogueAudioReleaseFn g_release = NULL;
+#endif
+
+#if defined(ROGUE_HAVE_SDL)
+static SDL_mutex* g_lock = NULL;
+static SDL_cond* g_work_cv = NULL; /* signalled when a slot is queued */
+static SDL_cond* g_done_cv = NULL; /* broadcast when a decode finishes */
+static SDL_Thread* g_workers[ROGUE_AUDIO_LOADER_MAX_WORKERS];
+static int g_worker_count = 0;
+static volatile int g_running = 0;
+#endif
+
+static void cache_lock(void)
+{
+#if defined(ROGUE_HAVE_SDL)
+    if (g_lock)
+        SDL_LockMutex(g_lock);
+#endif
+}
+
+static void cache_unlock(void)
+{
+#if defined(ROGUE_HAVE_SDL)
+    if (g_lock)
+        SDL_UnlockMutex(g_lock);
+#endif
+}
+
+static int have_workers(void)
+{
+#if defined(ROGUE_HAVE_SDL)
+    return g_worker_count > 0;
+#else
+    return 0;
+#endif
+}
+
+static double cache_now_ms(void)
+{
+#if defined(ROGUE_HAVE_SDL)
+    return (double) SDL_GetPerformanceCounter() * 1000.0 / (double) SDL_GetPerformanceFrequency();
+#else
+    return (double) clock() * 1000.0 / (double) CLOCKS_PER_SEC;
+#endif
+}
+
+static void set_path(CacheSlot* s, const char* path)
+{
+    if (!path)
+        path = "";
+    size_t n = strlen(path);
+    if (n >= sizeof s->path)
+        n = sizeof s->path - 1;
+    memcpy(s->path, path, n);
+    s->path[n] = '\0';
+}
+
+static void release_sample(void* sample)
+{
+    if (sample && g_release)
+        g_release(sample);
+}
+
+/* Highest priority queued slot (oldest request first), -1 when the queue is empty. */
+static int pick_job_locked(void)
+{
+    int best = -1;
+    for (int i = 0; i < ROGUE_AUDIO_REG_CAP; ++i)
+    {
+        const CacheSlot* s = &g_slots[i];
+        if (s->state != SLOT_QUEUED)
+            continue;
+        if (best < 0 || s->priority > g_slots[best].priority ||
+            (s->priority == g_slots[best].priority && s->seq < g_slots[best].seq))
+            best = i;
+    }
+    return best;
+}
+
+/* Decode slot idx with the lock released. Leaves it DECODED / FAILED, or untouched (the stale
+   sample is released) when the slot was invalidated meanwhile. Called with the lock held. */
+static void load_slot_locked(int idx)
+{
+    CacheSlot* s = &g_slots[idx];
+    char path[sizeof s->path];
+    memcpy(path, s->path, sizeof path);
+    uint32_t gen = s->gen;
+    s->state = SLOT_LOADING;
+    cache_unlock();
+    size_t bytes = 0;
+    void* sample = g_decode ? g_decode(path, &bytes) : NULL;
+    cache_lock();
+    if (s->gen != gen || s->state != SLOT_LOADING)
+    {
+        cache_unlock();
+        release_sample(sample);
+        cache_lock();
+        return;
+    }
+    s->sample = sample;
+    s->bytes = sample ? bytes : 0;
+    s->state = (uint8_t) (sample ? SLOT_DECODED : SLOT_FAILED);
+    if (!sample)
+        g_stats.failures++;
+}
+
+static void publish_locked(CacheSlot* s)
+{
+    s->state = SLOT_READY;
+    g_stats.resident++;
+    g_stats.resident_bytes += s->bytes;
+}
+
+static void publish_all_locked(void)
+{
+    for (int i = 0; i < ROGUE_AUDIO_REG_CAP; ++i)
+        if (g_slots[i].state == SLOT_DECODED)
+        {
+            publish_locked(&g_slots[i]);
+            g_stats.async_loads++;
+        }
+}
+
+static void drop_resident_locked(CacheSlot* s)
+{
+    if (s->state == SLOT_READY)
+    {
+        g_stats.resident--;
+        g_stats.resident_bytes -= s->bytes;
+    }
+    if (s->state == SLOT_READY || s->state == SLOT_DECODED)
+        release_sample(s->sample);
+    s->sample = NULL;
+    s->bytes = 0;
+    s->state = SLOT_EMPTY;
+}
+
+/* Evict least recently used unpinned samples until under budget; keep is never evicted. */
+static void evict_locked(int keep)
+{
+    while (g_stats.resident_bytes > g_budget)
+    {
+        int victim = -1;
+        for (int i = 0; i < ROGUE_AUDIO_REG_CAP; ++i)
+        {
+            const CacheSlot* s = &g_slots[i];
+            if (i == keep || s->state != SLOT_READY || s->pins > 0)
+                continue;
+            if (victim < 0 || s->last_use < g_slots[victim].last_use)
+                victim = i;
+        }
+        if (victim < 0)
+            return;
+        drop_resident_locked(&g_slots[victim]);
+        g_stats.evictions++;
+    }
+}
+
+static int queue_locked(int idx, const char* path, int priority)
+{
+    CacheSlot* s = &g_slots[idx];
+    if (s->state == SLOT_QUEUED)
+    {
+        if (priority <= s->priority)
+            return 0;
+        s->priority = priority;
+        return 1;
+    }
+    if (s->state != SLOT_EMPTY)
+        return 0;
+    set_path(s, path);
+    s->state = SLOT_QUEUED;
+    s->priority = priority;
+    s->seq = g_seq++;
+#if defined(ROGUE_HAVE_SDL)
+    if (g_work_cv)
+        SDL_CondSignal(g_work_cv);
+#endif
+    return 1;
+}
+
+#if defined(ROGUE_HAVE_SDL)
+static int loader_worker(void* ud)
+{
+    (void) ud;
+    SDL_LockMutex(g_lock);
+    while (g_running)
+    {
+        int idx = pick_job_locked();
+        if (idx < 0)
+        {
+            SDL_CondWait(g_work_cv, g_lock);
+            continue;
+        }
+        load_slot_locked(idx);
+        SDL_CondBroadcast(g_done_cv);
+    }
+    SDL_UnlockMutex(g_lock);
+    return 0;
+}
+#endif
+
+void rogue_audio_cache_set_decoder(RogueAudioDecodeFn decode, RogueAudioReleaseFn release)
+{
+    g_decode = decode;
+    g_release = release;
+}
+
+int rogue_audio_preload_start(int workers)
+{
+#if defined(ROGUE_HAVE_SDL)
+    if (g_worker_count > 0 || workers <= 0)
+        return g_worker_count;
+    if (workers > ROGUE_AUDIO_LOADER_MAX_WORKERS)
+        workers = ROGUE_AUDIO_LOADER_MAX_WORKERS;
+    g_lock = SDL_CreateMutex();
+    g_work_cv = SDL_CreateCond();
+    g_done_cv = SDL_CreateCond();
+    if (!g_lock || !g_work_cv || !g_done_cv)
+    {
+        ROGUE_LOG_WARN("Audio preload: thread primitives unavailable (%s)", SDL_GetError());
+        rogue_audio_preload_shutdown();
+        return 0;
+    }
+    g_running = 1;
+    for (int i = 0; i < workers; ++i)
+    {
+        SDL_Thread* t = SDL_CreateThread(loader_worker, "rogue_audio_load", NULL);
+        if (!t)
+            break;
+        g_workers[g_worker_count++] = t;
+    }
+    if (g_worker_count == 0)
+        rogue_audio_preload_shutdown();
+    return g_worker_count;
+#else
+    (void) workers;
+    return 0;
+#endif
+}
+
+void rogue_audio_preload_shutdown(void)
+{
+#if defined(ROGUE_HAVE_SDL)
+    if (g_lock)
+    {
+        SDL_LockMutex(g_lock);
+        g_running = 0;
+        SDL_CondBroadcast(g_work_cv);
+        SDL_UnlockMutex(g_lock);
+    }
+    for (int i = 0; i < g_worker_count; ++i)
+        SDL_WaitThread(g_workers[i], NULL);
+    g_worker_count = 0;
+#endif
+    rogue_audio_cache_reset();
+#if defined(ROGUE_HAVE_SDL)
+    if (g_done_cv)
+        SDL_DestroyCond(g_done_cv);
+    if (g_work_cv)
+        SDL_DestroyCond(g_work_cv);
+    if (g_lock)
+        SDL_DestroyMutex(g_lock);
+    g_done_cv = g_work_cv = NULL;
+    g_lock = NULL;
+#endif
+    memset(&g_stats, 0, sizeof g_stats);
+}
+
+void* rogue_audio_cache_acquire(int idx, const char* path)
+{
+    if (idx < 0 || idx >= ROGUE_AUDIO_REG_CAP || !g_decode)
+        return NULL;
+    cache_lock();
+    CacheSlot* s = &g_slots[idx];
+    int stalled = 0;
+    double t0 = 0.0;
+    if (s->state == SLOT_EMPTY || s->state == SLOT_QUEUED || s->state == SLOT_LOADING)
+    {
+        stalled = 1;
+        t0 = cache_now_ms();
+        if (s->state == SLOT_EMPTY)
+            set_path(s, path);
+        if (s->state != SLOT_LOADING)
+            load_slot_locked(idx);
+#if defined(ROGUE_HAVE_SDL)
+        while (s->state == SLOT_LOADING && g_done_cv)
+            SDL_CondWait(g_done_cv, g_lock);
+#endif
+    }
+    if (s->state == SLOT_DECODED)
+    {
+        publish_locked(s);
+        if (!stalled)
+            g_stats.async_loads++;
+    }
+    void* sample = NULL;
+    if (s->state == SLOT_READY)
+    {
+        sample = s->sample;
+        s->last_use = ++g_use_clock;
+        evict_locked(idx);
+    }
+    if (stalled)
+    {
+        g_stats.stalls++;
+        g_stats.stall_ms += cache_now_ms() - t0;
+        if (!sample)
+            ROGUE_LOG_WARN("Audio load failed path=%s", s->path);
+    }
+    else if (sample)
+        g_stats.hits++;
+    cache_unlock();
+    return sample;
+}
+
+int rogue_audio_cache_request(int idx, const char* path, int priority)
+{
+    if (idx < 0 || idx >= ROGUE_AUDIO_REG_CAP || !g_decode)
+        return 0;
+    cache_lock();
+    int queued = queue_locked(idx, path, priority);
+    cache_unlock();
+    return queued;
+}
+
+int rogue_audio_cache_pin_index(int idx, const char* path)
+{
+    if (idx < 0 || idx >= ROGUE_AUDIO_REG_CAP)
+        return -1;
+    cache_lock();
+    int pins = ++g_slots[idx].pins;
+    if (g_decode)
+        queue_locked(idx, path, ROGUE_AUDIO_PRELOAD_PIN_PRIORITY);
+    cache_unlock();
+    return pins;
+}
+
+int rogue_audio_cache_unpin_index(int idx)
+{
+    if (idx < 0 || idx >= ROGUE_AUDIO_REG_CAP)
+        return -1;
+    cache_lock();
+    if (g_slots[idx].pins > 0)
+        g_slots[idx].pins--;
+    int pins = g_slots[idx].pins;
+    cache_unlock();
+    return pins;
+}
+
+void rogue_audio_cache_invalidate(int idx)
+{
+    if (idx < 0 || idx >= ROGUE_AUDIO_REG_CAP)
+        return;
+    cache_lock();
+    CacheSlot* s = &g_slots[idx];
+    s->gen++;
+    drop_resident_locked(s);
+    cache_unlock();
+}
+
+void rogue_audio_cache_reset(void)
+{
+    cache_lock();
+    for (int i = 0; i < ROGUE_AUDIO_REG_CAP; ++i)
+    {
+        g_slots[i].gen++;
+        g_slots[i].pins = 0;
+        drop_resident_locked(&g_slots[i]);
+    }
+    cache_unlock();
+}
+
+void rogue_audio_cache_poll(void)
+{
+    cache_lock();
+    publish_all_locked();
+    if (!have_workers())
+    {
+        /* no workers: decode one queued sound per frame on the caller */
+        int idx = pick_job_locked();
+        if (idx >= 0)
+        {
+            load_slot_locked(idx);
+            publish_all_locked();
+        }
+    }
+    evict_locked(-1);
+    cache_unlock();
+}
+
+void rogue_audio_preload_wait(void)
+{
+    cache_lock();
+    for (;;)
+    {
+        int busy = 0;
+        for (int i = 0; i < ROGUE_AUDIO_REG_CAP && !busy; ++i)
+            busy = g_slots[i].state == SLOT_QUEUED || g_slots[i].state == SLOT_LOADING;
+        if (!busy)
+            break;
+        int idx = have_workers() ? -1 : pick_job_locked();
+        if (idx >= 0)
+            load_slot_locked(idx);
+#if defined(ROGUE_HAVE_SDL)
+        else if (g_done_cv)
+            SDL_CondWait(g_done_cv, g_lock);
+#endif
+    }
+    publish_all_locked();
+    evict_locked(-1);
+    cache_unlock();
+}
+
+void rogue_audio_cache_set_budget(size_t bytes)
+{
+    cache_lock();
+    g_budget = bytes;
+    evict_locked(-1);
+    cache_unlock();
+}
+
+void rogue_audio_cache_get_stats(RogueAudioCacheStats* out)
+{
+    if (!out)
+        return;
+    cache_lock();
+    *out = g_stats;
+    out->budget_bytes = g_budget;
+    out->pinned = out->pending = 0;
+    for (int i = 0; i < ROGUE_AUDIO_REG_CAP; ++i)
+    {
+        if (g_slots[i].pins > 0)
+            out->pinned++;
+        if (g_slots[i].state == SLOT_QUEUED || g_slots[i].state == SLOT_LOADING)
+            out->pending++;
+    }
+    cache_unlock();
+}
@@ -7,12 +7,14 @@
 
 /* -------- Event bus (double buffer minimal) -------- */
 
-#define ROGUE_FX_MAX_EVENTS 256
+/* Queues grow on demand up to this many events per frame. */
+#define ROGUE_FX_MAX_EVENTS 16384
 
 typedef struct FxQueue
 {
-    RogueEffectEvent ev[ROGUE_FX_MAX_EVENTS];
+    RogueEffectEvent* ev;
     int count;
+    int cap;
 } FxQueue;
 
 static FxQueue g_fx_a, g_fx_b;
@@ -22,16 +24,26 @@ static uint32_t g_frame_index = 0;
 static uint32_t g_seq_counter = 0;
 static uint32_t g_frame_digest = 0;
 
-/* Gameplay->effects mapping (Phase 5.1) */
+/* Dispatch sort scratch (radix keys / indices and the permuted events) */
+static uint32_t* g_sort_keys = NULL;
+static uint32_t* g_sort_idx = NULL;
+static RogueEffectEvent* g_sort_ev = NULL;
+static int g_sort_cap = 0;
+
+/* Gameplay->effects mapping (Phase 5.1). Entries sharing a key are chained in registration order;
+   g_fx_map_heads maps the interned key to the first entry. */
 typedef struct FxMapEntry
 {
-    char key[32];
+    RogueFxId key;
     uint8_t type; /* RogueFxMapType */
     char effect_id[24];
+    RogueFxId effect;
     uint8_t priority; /* RogueEffectPriority */
+    int next;         /* next entry with the same key (-1 = end) */
 } FxMapEntry;
 static FxMapEntry g_fx_map[96];
 static int g_fx_map_count = 0;
+static RogueFxIdMap g_fx_map_heads;
 
 /* Damage hook observer id (-1 if not bound) */
 static int g_damage_observer_id = -1;
@@ -88,9 +100,26 @@ void rogue_fx_frame_end(void)
     g_write = tmp;
 }
 
-int rogue_fx_emit(const RogueEffectEvent* ev)
+static int queue_reserve(FxQueue* q)
 {
-    if (!ev || g_write->count >= ROGUE_FX_MAX_EVENTS)
+    if (q->count < q->cap)
+        return 1;
+    if (q->cap >= ROGUE_FX_MAX_EVENTS)
+        return 0;
+    int cap = q->cap ? q->cap * 2 : 256;
+    RogueEffectEvent* ev =
+        (RogueEffectEvent*) realloc(q->ev, sizeof(RogueEffectEvent) * (size_t) cap);
+    if (!ev)
+        return 0;
+    q->ev = ev;
+    q->cap = cap;
+    return 1;
+}
+
+/* Append an event whose id_h is already resolved. */
+static int emit_interned(const RogueEffectEvent* ev)
+{
+    if (!queue_reserve(g_write))
         return -1;
     RogueEffectEvent* out = &g_write->ev[g_write->count++];
     *out = *ev;
@@ -101,6 +130,21 @@ int rogue_fx_emit(const RogueEffectEvent* ev)
     return 0;
 }
 
+int rogue_fx_emit(const RogueEffectEvent* ev)
+{
+    if (!ev)
+        return -1;
+    /* Caller-provided handles are never trusted (replays may come from another process). */
+    RogueEffectEvent e = *ev;
+    char id[sizeof e.id + 1];
+    memcpy(id, e.id, sizeof e.id);
+    id[sizeof e.id] = '\0';
+    e.id_h = rogue_fx_intern(id);
+    if (e.id_h == ROGUE_FX_ID_NONE && id[0])
+        return -1;
+    return emit_interned(&e);
+}
+
 int rogue_fx_map_register(const char* gameplay_event_key, RogueFxMapType type,
                           const char* effect_id, RogueEffectPriority priority)
 {
@@ -108,58 +152,86 @@ int rogue_fx_map_register(const char* gameplay_event_key, RogueFxMapType type,
         return -1;
     if (g_fx_map_count >= (int) (sizeof g_fx_map / sizeof g_fx_map[0]))
         return -2;
-    FxMapEntry* e = &g_fx_map[g_fx_map_count++];
+    /* keys are truncated to ROGUE_FX_ID_MAX_LEN chars, effect ids to the event id buffer */
+    char key[ROGUE_FX_ID_MAX_LEN + 1];
+    FxMapEntry* e = &g_fx_map[g_fx_map_count];
     memset(e, 0, sizeof *e);
 #if defined(_MSC_VER)
-    strncpy_s(e->key, sizeof e->key, gameplay_event_key, _TRUNCATE);
+    strncpy_s(key, sizeof key, gameplay_event_key, _TRUNCATE);
     strncpy_s(e->effect_id, sizeof e->effect_id, effect_id, _TRUNCATE);
 #else
-    strncpy(e->key, gameplay_event_key, sizeof e->key - 1);
-    e->key[sizeof e->key - 1] = '\0';
+    strncpy(key, gameplay_event_key, sizeof key - 1);
+    key[sizeof key - 1] = '\0';
     strncpy(e->effect_id, effect_id, sizeof e->effect_id - 1);
     e->effect_id[sizeof e->effect_id - 1] = '\0';
 #endif
+    e->key = rogue_fx_intern(key);
+    e->effect = rogue_fx_intern(e->effect_id);
+    if (e->key == ROGUE_FX_ID_NONE || e->effect == ROGUE_FX_ID_NONE)
+        return -3;
     e->type = (uint8_t) type;
     e->priority = (uint8_t) priority;
+    e->next = -1;
+    int idx = g_fx_map_count;
+    int head = rogue_fx_idmap_get(&g_fx_map_heads, e->key);
+    if (head < 0)
+    {
+        if (rogue_fx_idmap_set(&g_fx_map_heads, e->key, idx) != 0)
+            return -3;
+    }
+    else
+    {
+        while (g_fx_map[head].next >= 0)
+            head = g_fx_map[head].next;
+        g_fx_map[head].next = idx;
+    }
+    g_fx_map_count++;
     return 0;
 }
-void rogue_fx_map_clear(void) { g_fx_map_count = 0; }
+void rogue_fx_map_clear(void)
+{
+    for (int i = 0; i < g_fx_map_count; ++i)
+        rogue_fx_idmap_set(&g_fx_map_heads, g_fx_map[i].key, -1);
+    g_fx_map_count = 0;
+}
 
-int rogue_fx_trigger_event(const char* gameplay_event_key, float x, float y)
+int rogue_fx_trigger_event_id(RogueFxId gameplay_event_key, float x, float y)
 {
-    if (!gameplay_event_key || !*gameplay_event_key)
-        return 0;
     int emitted = 0;
-    for (int i = 0; i < g_fx_map_count; ++i)
+    for (int i = rogue_fx_idmap_get(&g_fx_map_heads, gameplay_event_key); i >= 0;
+         i = g_fx_map[i].next)
     {
-        if (strncmp(g_fx_map[i].key, gameplay_event_key, sizeof g_fx_map[i].key) != 0)
-            continue;
+        const FxMapEntry* m = &g_fx_map[i];
         RogueEffectEvent ev;
         memset(&ev, 0, sizeof ev);
-        ev.priority = g_fx_map[i].priority;
+        ev.priority = m->priority;
         ev.repeats = 1;
-#if defined(_MSC_VER)
-        strncpy_s(ev.id, sizeof ev.id, g_fx_map[i].effect_id, _TRUNCATE);
-#else
-        strncpy(ev.id, g_fx_map[i].effect_id, sizeof ev.id - 1);
-        ev.id[sizeof ev.id - 1] = '\0';
-#endif
+        memcpy(ev.id, m->effect_id, sizeof ev.id);
+        ev.id_h = m->effect;
         ev.x = x;
         ev.y = y;
-        if (g_fx_map[i].type == ROGUE_FX_MAP_AUDIO)
+        if (m->type == ROGUE_FX_MAP_AUDIO)
             ev.type = ROGUE_FX_AUDIO_PLAY;
-        else if (g_fx_map[i].type == ROGUE_FX_MAP_VFX)
+        else if (m->type == ROGUE_FX_MAP_VFX)
             ev.type = ROGUE_FX_VFX_SPAWN;
         else
             continue;
-        if (rogue_fx_emit(&ev) == 0)
+        if (emit_interned(&ev) == 0)
             ++emitted;
     }
     return emitted;
 }
 
+int rogue_fx_trigger_event(const char* gameplay_event_key, float x, float y)
+{
+    if (!gameplay_event_key || !*gameplay_event_key)
+        return 0;
+    RogueFxId key = rogue_fx_id_find(gameplay_event_key);
+    return key == ROGUE_FX_ID_NONE ? 0 : rogue_fx_trigger_event_id(key, x, y);
+}
+
 /* ---- Phase 5.2: Damage event observer hook ---- */
-static const char* dmg_type_to_key(unsigned char t)
+static const char* dmg_type_to_key(unsigned int t)
 {
     switch (t)
     {
@@ -182,37 +254,41 @@ static const char* dmg_type_to_key(unsigned char t)
     }
 }
 
-static void fx_on_damage_event(const RogueDamageEvent* ev, void* user)
+/* Interned "damage/<type>/{hit,crit,execution}" keys, one row per damage type plus "unknown". */
+#define FX_DMG_KEY_ROWS (ROGUE_DMG_TYPE_COUNT + 1)
+static RogueFxId g_dmg_keys[FX_DMG_KEY_ROWS][3];
+
+static void dmg_keys_init(void)
 {
-    (void) user;
-    if (!ev)
+    static const char* const suffix[3] = {"hit", "crit", "execution"};
+    if (g_dmg_keys[0][0] != ROGUE_FX_ID_NONE)
         return;
-    char key[64];
-    const char* type_key = dmg_type_to_key(ev->damage_type);
+    for (int t = 0; t < FX_DMG_KEY_ROWS; ++t)
+        for (int k = 0; k < 3; ++k)
+        {
+            char key[64];
 #if defined(_MSC_VER)
-    _snprintf_s(key, sizeof key, _TRUNCATE, "damage/%s/hit", type_key);
+            _snprintf_s(key, sizeof key, _TRUNCATE, "damage/%s/%s", dmg_type_to_key((unsigned) t),
+                        suffix[k]);
 #else
-    snprintf(key, sizeof key, "damage/%s/hit", type_key);
+            snprintf(key, sizeof key, "damage/%s/%s", dmg_type_to_key((unsigned) t), suffix[k]);
 #endif
-    rogue_fx_trigger_event(key, 0.0f, 0.0f);
+            g_dmg_keys[t][k] = rogue_fx_intern(key);
+        }
+}
+
+static void fx_on_damage_event(const RogueDamageEvent* ev, void* user)
+{
+    (void) user;
+    if (!ev)
+        return;
+    dmg_keys_init();
+    int row = ev->damage_type < ROGUE_DMG_TYPE_COUNT ? (int) ev->damage_type : FX_DMG_KEY_ROWS - 1;
+    rogue_fx_trigger_event_id(g_dmg_keys[row][0], 0.0f, 0.0f);
     if (ev->crit)
-    {
-#if defined(_MSC_VER)
-        _snprintf_s(key, sizeof key, _TRUNCATE, "damage/%s/crit", type_key);
-#else
-        snprintf(key, sizeof key, "damage/%s/crit", type_key);
-#endif
-        rogue_fx_trigger_event(key, 0.0f, 0.0f);
-    }
+        rogue_fx_trigger_event_id(g_dmg_keys[row][1], 0.0f, 0.0f);
     if (ev->execution)
-    {
-#if defined(_MSC_VER)
-        _snprintf_s(key, sizeof key, _TRUNCATE, "damage/%s/execution", type_key);
-#else
-        snprintf(key, sizeof key, "damage/%s/execution", type_key);
-#endif
-        rogue_fx_trigger_event(key, 0.0f, 0.0f);
-    }
+        rogue_fx_trigger_event_id(g_dmg_keys[row][2], 0.0f, 0.0f);
 }
 
 int rogue_fx_damage_hook_bind(void)
@@ -235,7 +311,10 @@ void rogue_fx_damage_hook_unbind(void)
 extern void rogue_audio_dispatch_play_event(const RogueEffectEvent* e);
 extern void rogue_vfx_dispatch_spawn_event(const RogueEffectEvent* e);
 
-/* Simple stable sort by (priority, id, seq) */
+/* Rank table used by cmp_ev (lexical order of interned ids). */
+static const uint32_t* g_cmp_ranks = NULL;
+
+/* Fallback comparison sort by (emit_frame, priority, id, seq) */
 static int cmp_ev(const void* a, const void* b)
 {
     const RogueEffectEvent* ea = (const RogueEffectEvent*) a;
@@ -244,9 +323,9 @@ static int cmp_ev(const void* a, const void* b)
         return (ea->emit_frame < eb->emit_frame) ? -1 : 1;
     if (ea->priority != eb->priority)
         return (int) ea->priority - (int) eb->priority;
-    int idcmp = strncmp(ea->id, eb->id, sizeof ea->id);
-    if (idcmp != 0)
-        return idcmp;
+    uint32_t ra = g_cmp_ranks[ea->id_h], rb = g_cmp_ranks[eb->id_h];
+    if (ra != rb)
+        return ra < rb ? -1 : 1;
     if (ea->seq < eb->seq)
         return -1;
     if (ea->seq > eb->seq)
@@ -254,11 +333,101 @@ static int cmp_ev(const void* a, const void* b)
     return 0;
 }
 
+static int sort_reserve(int n)
+{
+    if (n <= g_sort_cap)
+        return 1;
+    int cap = g_sort_cap ? g_sort_cap : 256;
+    while (cap < n)
+        cap *= 2;
+    uint32_t* keys = (uint32_t*) realloc(g_sort_keys, sizeof(uint32_t) * 2 * (size_t) cap);
+    if (!keys)
+        return 0;
+    g_sort_keys = keys;
+    uint32_t* idx = (uint32_t*) realloc(g_sort_idx, sizeof(uint32_t) * 2 * (size_t) cap);
+    if (!idx)
+        return 0;
+    g_sort_idx = idx;
+    RogueEffectEvent* ev =
+        (RogueEffectEvent*) realloc(g_sort_ev, sizeof(RogueEffectEvent) * (size_t) cap);
+    if (!ev)
+        return 0;
+    g_sort_ev = ev;
+    g_sort_cap = cap;
+    return 1;
+}
+
+/* Stable LSD radix sort of the read queue on (priority << 24 | id rank). Queue order is emit
+   order (seq ascending), so stability preserves the seq tie-break of cmp_ev. Returns 0 when the
+   queue does not fit the key layout (mixed emit frames, > 2^24 ids); the caller then falls back
+   to qsort. */
+static int radix_sort_queue(FxQueue* q, const uint32_t* ranks)
+{
+    int n = q->count;
+    if (rogue_fx_id_count() >= (1u << 24) || !sort_reserve(n))
+        return 0;
+    uint32_t *keys = g_sort_keys, *idx = g_sort_idx;
+    uint32_t *keys2 = g_sort_keys + g_sort_cap, *idx2 = g_sort_idx + g_sort_cap;
+    uint32_t hist[4][256];
+    memset(hist, 0, sizeof hist);
+    for (int i = 0; i < n; ++i)
+    {
+        const RogueEffectEvent* e = &q->ev[i];
+        if (e->emit_frame != q->ev[0].emit_frame)
+            return 0;
+        uint32_t k = ((uint32_t) e->priority << 24) | ranks[e->id_h];
+        keys[i] = k;
+        idx[i] = (uint32_t) i;
+        for (int b = 0; b < 4; ++b)
+            hist[b][(k >> (b * 8)) & 0xFFu]++;
+    }
+    for (int b = 0; b < 4; ++b)
+    {
+        if (hist[b][(keys[0] >> (b * 8)) & 0xFFu] == (uint32_t) n)
+            continue; /* every key shares this byte */
+        uint32_t sum = 0;
+        for (int v = 0; v < 256; ++v)
+        {
+            uint32_t c = hist[b][v];
+            hist[b][v] = sum;
+            sum += c;
+        }
+        for (int i = 0; i < n; ++i)
+        {
+            uint32_t dst = hist[b][(keys[i] >> (b * 8)) & 0xFFu]++;
+            keys2[dst] = keys[i];
+            idx2[dst] = idx[i];
+        }
+        uint32_t* t = keys;
+        keys = keys2;
+        keys2 = t;
+        t = idx;
+        idx = idx2;
+        idx2 = t;
+    }
+    for (int i = 0; i < n; ++i)
+        g_sort_ev[i] = q->ev[idx[i]];
+    RogueEffectEvent* t = q->ev;
+    q->ev = g_sort_ev;
+    g_sort_ev = t;
+    return 1;
+}
+
 int rogue_fx_dispatch_process(void)
 {
     if (g_read->count <= 0)
         return 0;
-    qsort(g_read->ev, (size_t) g_read->count, sizeof g_read->ev[0], cmp_ev);
+    const uint32_t* ranks = rogue_fx_id_ranks();
+    if (!ranks)
+    {
+        g_read->count = 0; /* nothing interned (allocation failure) */
+        return 0;
+    }
+    if (!radix_sort_queue(g_read, ranks))
+    {
+        g_cmp_ranks = ranks;
+        qsort(g_read->ev, (size_t) g_read->count, sizeof g_read->ev[0], cmp_ev);
+    }
     /* Frame compaction */
     int write_i = 0;
     for (int i = 0; i < g_read->count;)
@@ -269,8 +438,7 @@ int rogue_fx_dispatch_process(void)
         while (j < g_read->count)
         {
             RogueEffectEvent* n = &g_read->ev[j];
-            if (n->type != merged.type || n->priority != merged.priority ||
-                strncmp(n->id, merged.id, sizeof merged.id) != 0)
+            if (n->type != merged.type || n->priority != merged.priority || n->id_h != merged.id_h)
                 break;
             merged.repeats += (n->repeats == 0 ? 1 : n->repeats);
             ++j;
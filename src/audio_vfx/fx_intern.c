@@ -0,0 +1,186 @@
+/* fx_intern.c - Interned FX ids (event keys, audio / VFX ids) and id-indexed side tables */
+#include "effects.h"
+#include "fx_internal.h"
+#include <stdlib.h>
+#include <string.h>
+
+typedef char FxIdStr[ROGUE_FX_ID_MAX_LEN + 1];
+
+/* Handle h (1..g_count) owns g_strs[h] / g_hashes[h]; index 0 is the NONE sentinel. */
+static FxIdStr* g_strs = NULL;
+static uint32_t* g_hashes = NULL;
+static uint32_t g_count = 0;
+static uint32_t g_cap = 0;
+/* Open-addressing table of handles (0 = empty), power-of-two sized, load <= 1/2. */
+static uint32_t* g_slots = NULL;
+static uint32_t g_mask = 0;
+/* Lexical rank per handle, rebuilt lazily after new strings are interned. */
+static uint32_t* g_ranks = NULL;
+static int g_ranks_dirty = 1;
+
+static uint32_t fnv1a32(const char* s, size_t n)
+{
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < n; ++i)
+    {
+        h ^= (uint32_t) (unsigned char) s[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static uint32_t lookup(const char* s, size_t n, uint32_t hash)
+{
+    if (!g_slots)
+        return ROGUE_FX_ID_NONE;
+    for (uint32_t i = hash & g_mask;; i = (i + 1) & g_mask)
+    {
+        uint32_t h = g_slots[i];
+        if (h == ROGUE_FX_ID_NONE)
+            return ROGUE_FX_ID_NONE;
+        if (g_hashes[h] == hash && strncmp(g_strs[h], s, n) == 0 && g_strs[h][n] == '\0')
+            return h;
+    }
+}
+
+static int grow_slots(void)
+{
+    uint32_t size = g_slots ? (g_mask + 1) * 2 : 256;
+    uint32_t* slots = (uint32_t*) calloc(size, sizeof(uint32_t));
+    if (!slots)
+        return 0;
+    free(g_slots);
+    g_slots = slots;
+    g_mask = size - 1;
+    for (uint32_t h = 1; h <= g_count; ++h)
+    {
+        uint32_t i = g_hashes[h] & g_mask;
+        while (g_slots[i] != ROGUE_FX_ID_NONE)
+            i = (i + 1) & g_mask;
+        g_slots[i] = h;
+    }
+    return 1;
+}
+
+static int grow_strings(void)
+{
+    uint32_t cap = g_cap ? g_cap * 2 : 128;
+    FxIdStr* strs = (FxIdStr*) realloc(g_strs, sizeof(FxIdStr) * cap);
+    if (!strs)
+        return 0;
+    g_strs = strs;
+    uint32_t* hashes = (uint32_t*) realloc(g_hashes, sizeof(uint32_t) * cap);
+    if (!hashes)
+        return 0;
+    g_hashes = hashes;
+    uint32_t* ranks = (uint32_t*) realloc(g_ranks, sizeof(uint32_t) * cap);
+    if (!ranks)
+        return 0;
+    g_ranks = ranks;
+    g_cap = cap;
+    return 1;
+}
+
+/* Length of s when it is internable (1..ROGUE_FX_ID_MAX_LEN chars), else 0. */
+static size_t id_len(const char* s)
+{
+    if (!s)
+        return 0;
+    size_t n = strnlen(s, ROGUE_FX_ID_MAX_LEN + 1);
+    return n > ROGUE_FX_ID_MAX_LEN ? 0 : n;
+}
+
+RogueFxId rogue_fx_intern(const char* s)
+{
+    size_t n = id_len(s);
+    if (n == 0)
+        return ROGUE_FX_ID_NONE;
+    uint32_t hash = fnv1a32(s, n);
+    uint32_t h = lookup(s, n, hash);
+    if (h != ROGUE_FX_ID_NONE)
+        return h;
+    if (g_count + 2 > g_cap && !grow_strings())
+        return ROGUE_FX_ID_NONE;
+    if ((g_count + 1) * 2 > (g_slots ? g_mask + 1 : 0) && !grow_slots())
+        return ROGUE_FX_ID_NONE;
+    h = ++g_count;
+    memcpy(g_strs[h], s, n);
+    g_strs[h][n] = '\0';
+    g_hashes[h] = hash;
+    uint32_t i = hash & g_mask;
+    while (g_slots[i] != ROGUE_FX_ID_NONE)
+        i = (i + 1) & g_mask;
+    g_slots[i] = h;
+    g_ranks_dirty = 1;
+    return h;
+}
+
+RogueFxId rogue_fx_id_find(const char* s)
+{
+    size_t n = id_len(s);
+    return n ? lookup(s, n, fnv1a32(s, n)) : ROGUE_FX_ID_NONE;
+}
+
+const char* rogue_fx_id_str(RogueFxId id)
+{
+    return (id != ROGUE_FX_ID_NONE && id <= g_count) ? g_strs[id] : NULL;
+}
+
+uint32_t rogue_fx_id_count(void) { return g_count; }
+
+static int cmp_handle_str(const void* a, const void* b)
+{
+    return strcmp(g_strs[*(const uint32_t*) a], g_strs[*(const uint32_t*) b]);
+}
+
+const uint32_t* rogue_fx_id_ranks(void)
+{
+    if (!g_ranks_dirty || !g_ranks)
+        return g_ranks;
+    uint32_t* order = (uint32_t*) malloc(sizeof(uint32_t) * (g_count + 1));
+    if (!order)
+        return NULL;
+    for (uint32_t h = 1; h <= g_count; ++h)
+        order[h - 1] = h;
+    qsort(order, g_count, sizeof order[0], cmp_handle_str);
+    g_ranks[0] = 0;
+    for (uint32_t r = 0; r < g_count; ++r)
+        g_ranks[order[r]] = r + 1;
+    free(order);
+    g_ranks_dirty = 0;
+    return g_ranks;
+}
+
+/* -------- Id-indexed side tables -------- */
+
+int rogue_fx_idmap_get(const RogueFxIdMap* m, RogueFxId id)
+{
+    return (id < m->cap) ? m->slot[id] : -1;
+}
+
+int rogue_fx_idmap_set(RogueFxIdMap* m, RogueFxId id, int value)
+{
+    if (id == ROGUE_FX_ID_NONE)
+        return -1;
+    if (id >= m->cap)
+    {
+        uint32_t cap = m->cap ? m->cap : 64;
+        while (cap <= id)
+            cap *= 2;
+        int* slot = (int*) realloc(m->slot, sizeof(int) * cap);
+        if (!slot)
+            return -1;
+        for (uint32_t i = m->cap; i < cap; ++i)
+            slot[i] = -1;
+        m->slot = slot;
+        m->cap = cap;
+    }
+    m->slot[id] = value;
+    return 0;
+}
+
+void rogue_fx_idmap_reset(RogueFxIdMap* m)
+{
+    for (uint32_t i = 0; i < m->cap; ++i)
+        m->slot[i] = -1;
+}
@@ -2,6 +2,7 @@
 #ifndef ROGUE_FX_INTERNAL_H
 #define ROGUE_FX_INTERNAL_H
 
+#include "effects.h"
 #include <stdint.h>
 
 /* Shared deterministic RNG for FX systems */
@@ -9,4 +10,31 @@ uint32_t rogue_fx_rand_u32(void);
 float rogue_fx_rand01(void);
 float rogue_fx_rand_normal01(void);
 
+/* Interned id helpers (fx_intern.c) */
+uint32_t rogue_fx_id_count(void);
+/* Lexical rank of every interned id (index = handle, NONE ranks 0); rebuilt lazily after new ids
+   are interned. NULL when nothing has been interned (or on allocation failure). */
+const uint32_t* rogue_fx_id_ranks(void);
+
+/* Dense side table from interned ids to registry indices (-1 = unset), grown on demand. */
+typedef struct RogueFxIdMap
+{
+    int* slot;
+    uint32_t cap;
+} RogueFxIdMap;
+int rogue_fx_idmap_get(const RogueFxIdMap* m, RogueFxId id);
+int rogue_fx_idmap_set(RogueFxIdMap* m, RogueFxId id, int value); /* 0 on success */
+void rogue_fx_idmap_reset(RogueFxIdMap* m);                       /* every id -> -1 */
+
+/* Decoded sample cache (fx_audio_cache.c), one slot per audio registry index. */
+#define ROGUE_AUDIO_REG_CAP 64
+#define ROGUE_AUDIO_PRELOAD_PIN_PRIORITY 1000000
+/* Resident sample for a play; decodes in-frame (counted as a stall) when not yet loaded. */
+void* rogue_audio_cache_acquire(int idx, const char* path);
+int rogue_audio_cache_request(int idx, const char* path, int priority); /* 1 when queued */
+int rogue_audio_cache_pin_index(int idx, const char* path);
+int rogue_audio_cache_unpin_index(int idx);
+void rogue_audio_cache_invalidate(int idx); /* registry path changed */
+void rogue_audio_cache_reset(void);         /* registry cleared: drop samples, pins and queue */
+
 #endif /* ROGUE_FX_INTERNAL_H */
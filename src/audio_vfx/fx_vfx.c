@@ -6,6 +6,7 @@
 typedef struct VfxReg
 {
     char id[24];
+    RogueFxId id_h;
     uint8_t layer;
     uint8_t world_space;
     uint32_t lifetime_ms;
@@ -44,6 +45,7 @@ typedef struct VfxInst
 #define ROGUE_VFX_REG_CAP 64
 static VfxReg g_vfx_reg[ROGUE_VFX_REG_CAP];
 static int g_vfx_reg_count = 0;
+static RogueFxIdMap g_vfx_by_id; /* interned id -> registry index */
 #define ROGUE_VFX_INST_CAP 256
 static VfxInst g_vfx_inst[ROGUE_VFX_INST_CAP];
 static float g_vfx_timescale = 1.0f;
@@ -106,10 +108,7 @@ static Shake g_shakes[8];
 
 static int vfx_reg_find(const char* id)
 {
-    for (int i = 0; i < g_vfx_reg_count; ++i)
-        if (strncmp(g_vfx_reg[i].id, id, sizeof g_vfx_reg[i].id) == 0)
-            return i;
-    return -1;
+    return rogue_fx_idmap_get(&g_vfx_by_id, rogue_fx_id_find(id));
 }
 static int vfx_part_alloc(void)
 {
@@ -214,14 +213,23 @@ int rogue_vfx_registry_register(const char* id, RogueVfxLayer layer, uint32_t li
     {
         if (g_vfx_reg_count >= ROGUE_VFX_REG_CAP)
             return -2;
-        idx = g_vfx_reg_count++;
-        memset(&g_vfx_reg[idx], 0, sizeof g_vfx_reg[idx]);
+        VfxReg* r = &g_vfx_reg[g_vfx_reg_count];
+        memset(r, 0, sizeof *r);
 #if defined(_MSC_VER)
-        strncpy_s(g_vfx_reg[idx].id, sizeof g_vfx_reg[idx].id, id, _TRUNCATE);
+        strncpy_s(r->id, sizeof r->id, id, _TRUNCATE);
 #else
-        strncpy(g_vfx_reg[idx].id, id, sizeof g_vfx_reg[idx].id - 1);
-        g_vfx_reg[idx].id[sizeof g_vfx_reg[idx].id - 1] = '\0';
+        strncpy(r->id, id, sizeof r->id - 1);
+        r->id[sizeof r->id - 1] = '\0';
 #endif
+        r->id_h = rogue_fx_intern(r->id);
+        idx = rogue_fx_idmap_get(&g_vfx_by_id, r->id_h);
+        if (idx < 0)
+        {
+            if (r->id_h == ROGUE_FX_ID_NONE ||
+                rogue_fx_idmap_set(&g_vfx_by_id, r->id_h, g_vfx_reg_count) != 0)
+                return -2;
+            idx = g_vfx_reg_count++;
+        }
     }
     g_vfx_reg[idx].layer = (uint8_t) layer;
     g_vfx_reg[idx].lifetime_ms = lifetime_ms;
@@ -257,7 +265,12 @@ int rogue_vfx_registry_get(const char* id, RogueVfxLayer* out_layer, uint32_t* o
         *out_world_space = g_vfx_reg[idx].world_space;
     return 0;
 }
-void rogue_vfx_registry_clear(void) { g_vfx_reg_count = 0; }
+void rogue_vfx_registry_clear(void)
+{
+    for (int i = 0; i < g_vfx_reg_count; ++i)
+        rogue_fx_idmap_set(&g_vfx_by_id, g_vfx_reg[i].id_h, -1);
+    g_vfx_reg_count = 0;
+}
 int rogue_vfx_registry_set_emitter(const char* id, float spawn_rate_hz,
                                    uint32_t particle_lifetime_ms, int max_particles)
 {
@@ -671,9 +684,8 @@ int rogue_vfx_debug_peek_first(const char* id, int* out_world_space, float* out_
     }
     return -2;
 }
-int rogue_vfx_spawn_by_id(const char* id, float x, float y)
+static int vfx_spawn_index(int ridx, float x, float y)
 {
-    int ridx = vfx_reg_find(id);
     if (ridx < 0)
         return -1;
     int ii = vfx_inst_alloc();
@@ -685,6 +697,10 @@ int rogue_vfx_spawn_by_id(const char* id, float x, float y)
     g_vfx_inst[ii].age_ms = 0;
     return 0;
 }
+int rogue_vfx_spawn_by_id(const char* id, float x, float y)
+{
+    return vfx_spawn_index(vfx_reg_find(id), x, y);
+}
 int rogue_vfx_spawn_with_overrides(const char* id, float x, float y, const RogueVfxOverrides* ov)
 {
     int ridx = vfx_reg_find(id);
@@ -710,7 +726,10 @@ void rogue_vfx_dispatch_spawn_event(const RogueEffectEvent* e)
 {
     if (!e)
         return;
-    (void) rogue_vfx_spawn_by_id(e->id, e->x, e->y);
+    if (e->id_h == ROGUE_FX_ID_NONE)
+        (void) rogue_vfx_spawn_by_id(e->id, e->x, e->y);
+    else
+        (void) vfx_spawn_index(rogue_fx_idmap_get(&g_vfx_by_id, e->id_h), e->x, e->y);
 }
 
 int rogue_vfx_shake_add(float amplitude, float frequency_hz, uint32_t duration_ms)
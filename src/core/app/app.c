@@ -22,6 +22,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 #include "app.h"
+#include "../../audio_vfx/effects.h"
 #include "../../entities/enemy.h"
 #include "../../entities/player.h"
 #include "../../game/buffs.h"
@@ -37,6 +38,7 @@ SOFTWARE.
 #include "../../graphics/font.h"
 #include "../../graphics/scene_drawlist.h"
 #include "../../graphics/sprite.h"
+#include "../../graphics/texture_cache.h"
 #include "../../graphics/tile_sprites.h"
 #include "../../input/input.h"
 #include "../../input/input_events.h"
@@ -134,6 +136,7 @@ RogueEnemy* rogue_test_spawn_hostile_enemy(float x, float y)
             ne->max_health = 10;
             ne->health = 10;
             ne->alive = 1;
+            rogue_combat_clear_enemy_status(ne, i);
             ne->hurt_timer = 0;
             ne->anim_time = 0;
             ne->anim_frame = 0;
@@ -262,8 +265,16 @@ bool rogue_app_init(const RogueAppConfig* cfg)
     else
     {
         rogue_asset_load_sounds();
+        /* Decode registered sounds off the frame; UI cues first so menus never stall. */
+        rogue_audio_preload_start(2);
+        rogue_audio_preload_category(ROGUE_AUDIO_CAT_UI, 2);
+        rogue_audio_preload_category(ROGUE_AUDIO_CAT_SFX, 1);
+        rogue_audio_preload_category(ROGUE_AUDIO_CAT_AMBIENCE, 0);
     }
 #endif
+    /* Baked atlas placements (tools/atlas_bake); without a manifest sheets pack at load time. */
+    if (rogue_texture_cache_load_manifest(ROGUE_TEXTURE_ATLAS_MANIFEST) == 0)
+        ROGUE_LOG_INFO("Loaded texture atlas manifest %s", ROGUE_TEXTURE_ATLAS_MANIFEST);
     g_app.tileset_loaded = 0; /* registry not finalized yet */
     g_app.tile_size = 16;     /* terrain tiles */
     g_app.player_frame_size = 64;
@@ -482,6 +493,7 @@ void rogue_app_step(void)
     {
         g_app.frame_draw_calls = 0;
         g_app.frame_tile_quads = 0; /* reset metrics each frame */
+        rogue_texture_cache_frame_reset();
         /* TODO(modularization): Consider extracting tile sprite LUT build into a tile_sprite_cache
          * module. */
         /* Lazy one-time load of assets (avoid repeated loads). Adjust paths to actual asset
@@ -554,6 +566,7 @@ void rogue_app_step(void)
 
         /* Update timed buffs & projectiles */
         rogue_buffs_update(g_app.game_time_ms);
+        rogue_combat_status_update(g_app.game_time_ms);
         rogue_projectiles_update(dt_ms);
         /* Render world tiles */
         rogue_world_render_tiles();
@@ -646,8 +659,10 @@ void rogue_app_shutdown(void)
         Mix_FreeChunk(g_app.sfx_levelup);
         g_app.sfx_levelup = NULL;
     }
+    rogue_audio_preload_shutdown();
     Mix_CloseAudio();
 #endif
+    rogue_texture_cache_shutdown(); /* before the renderer goes away */
     rogue_platform_shutdown();
     rogue_skills_shutdown();
     if (g_app.chunk_dirty)
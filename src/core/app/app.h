@@ -49,6 +49,7 @@ typedef struct RogueAppConfig
     int integer_scale;           /* 1 = force integer scaling for crisp pixels */
     RogueWindowMode window_mode; /* initial window mode */
     RogueColor background_color; /* Clear color */
+    int sim_hz;                  /* fixed simulation rate; 0 = one variable sim step per frame */
 } RogueAppConfig;
 
 bool rogue_app_init(const RogueAppConfig* cfg);
@@ -89,4 +90,20 @@ void rogue_app_get_metrics(double* out_fps, double* out_frame_ms, double* out_av
 /* Time since last frame in seconds (clamped). */
 double rogue_app_delta_time(void);
 
+/* Fixed-step simulation. With a step > 0 each frame runs as many sim ticks as accumulated time
+ * allows (capped per frame), publishes a render snapshot per tick and renders interpolated between
+ * the last two snapshots. step_ms <= 0 restores one variable-length sim step per frame. */
+void rogue_app_set_sim_step_ms(double step_ms);
+double rogue_app_sim_step_ms(void);
+/* Interpolation factor used by the last rendered frame (0..1). */
+float rogue_app_sim_alpha(void);
+/* Total sim ticks executed since init. */
+unsigned int rogue_app_sim_tick_count(void);
+/* Run ticks simulation steps of step_ms each without touching the renderer (headless throughput /
+ * determinism runs). Returns the number of ticks executed. */
+int rogue_app_sim_run(int ticks, double step_ms);
+/* Latch this frame's key press edges for the sim. The next sim tick consumes them, so a press is
+ * applied exactly once whether the frame runs zero, one or several ticks. */
+void rogue_app_latch_input_edges(void);
+
 #endif
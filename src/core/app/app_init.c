@@ -36,9 +36,11 @@ SOFTWARE.
 #include "../../game/start_screen.h"
 #include "../../game/stat_cache.h"
 #include "../../graphics/animation_system.h"
+#include "../../graphics/texture_cache.h"
 #include "../../util/asset_config.h"
 #include "../../util/log.h"
 #include "../../util/metrics.h"
+#include "../../util/profiler.h"
 #include "../../world/tile_sprite_cache.h"
 #include "../../world/world_gen.h"
 #include "../../world/world_gen_config.h"
@@ -47,6 +49,7 @@ SOFTWARE.
 #include "../loot/loot_instances.h"
 #include "../loot/loot_item_defs.h"
 #include "../loot/loot_logging.h"
+#include "../loot/loot_pack.h"
 #include "../loot/loot_tables.h"
 #include "../persistence/persistence.h"
 #include "../persistence/persistence_autosave.h"
@@ -62,6 +65,8 @@ SOFTWARE.
 #include "../vendor/vendor.h"
 #include "app.h"
 #include "app_state.h"
+#include "content_manifest.h"
+#include "render_snapshot.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -148,6 +153,8 @@ bool rogue_app_init(const RogueAppConfig* cfg)
     g_app.noclip_enabled = 0;      /* debug off by default */
     g_app.god_mode_enabled = 0;    /* debug off by default */
     rogue_loot_logging_init_from_env();
+    /* Headless profiling: ROGUE_PROF_TRACE / ROGUE_PROF_SPIKE_MS (see util/profiler.h) */
+    rogue_prof_configure_from_env();
     /* Load hitbox tuning if present */
     RogueHitboxTuning* tune = rogue_hitbox_tuning_get();
     tune->enemy_radius = 0.40f; /* default */
@@ -310,12 +317,64 @@ bool rogue_app_init(const RogueAppConfig* cfg)
     g_app.vendor_x = 4.5f;
     g_app.vendor_y = 4.5f;
     g_app.show_equipment_panel = 0;
-    int items_loaded = rogue_item_defs_load_directory("assets/items");
-    if (items_loaded <= 0)
+    /* Item + loot content. A baked pack (ROGUE_CONTENT_PACK=<file>, see tools/content_bake.c)
+       is mapped and used without parsing; otherwise the text files are parsed in parallel by
+       dependency level and committed here in order. */
+    RogueContentLoadResult content = {0, 0, 0};
+    int content_from_pack = 0;
     {
-        items_loaded = rogue_item_defs_load_from_cfg("assets/test_items.cfg");
+        char pack_path[512] = {0};
+#if defined(_MSC_VER)
+        char* cp = NULL;
+        size_t cpl = 0;
+        if (_dupenv_s(&cp, &cpl, "ROGUE_CONTENT_PACK") == 0 && cp)
+        {
+            strncpy_s(pack_path, sizeof pack_path, cp, _TRUNCATE);
+            free(cp);
+        }
+#else
+        const char* cp = getenv("ROGUE_CONTENT_PACK");
+        if (cp)
+        {
+            strncpy(pack_path, cp, sizeof pack_path - 1);
+        }
+#endif
+        if (pack_path[0])
+        {
+            int n = rogue_loot_pack_load_file(pack_path);
+            if (n > 0)
+            {
+                content_from_pack = 1;
+                content.items_loaded = n;
+                content.tables_loaded = rogue_loot_tables_count();
+                ROGUE_LOG_INFO("content_pack_loaded: %s items=%d tables=%d", pack_path, n,
+                               content.tables_loaded);
+            }
+            else
+                ROGUE_LOG_WARN("content pack %s rejected (%d), loading text content", pack_path,
+                               n);
+        }
+    }
+    if (!content_from_pack)
+    {
+        RogueContentTimeline* content_tl = (RogueContentTimeline*) malloc(sizeof *content_tl);
+        if (rogue_content_manifest_load(0, &content, content_tl) != 0)
+        {
+            content.items_loaded = rogue_item_defs_load_directory("assets/items");
+            if (content.items_loaded <= 0)
+                content.items_loaded = rogue_item_defs_load_from_cfg("assets/test_items.cfg");
+            content.tables_loaded =
+                rogue_loot_tables_load_from_cfg("assets/test_loot_tables.cfg");
+        }
+        else if (content_tl)
+        {
+            char report[4096];
+            rogue_content_timeline_format(content_tl, report, (int) sizeof report);
+            ROGUE_LOG_INFO("%s", report);
+        }
+        free(content_tl);
     }
-    int tables_loaded = rogue_loot_tables_load_from_cfg("assets/test_loot_tables.cfg");
+    int tables_loaded = content.tables_loaded;
     if (tables_loaded > 0)
     {
         RogueGenerationContext vctx = {.enemy_level = g_app.player.level,
@@ -339,6 +398,11 @@ bool rogue_app_init(const RogueAppConfig* cfg)
     else
     {
         rogue_asset_load_sounds();
+        /* Decode registered sounds off the frame; UI cues first so menus never stall. */
+        rogue_audio_preload_start(2);
+        rogue_audio_preload_category(ROGUE_AUDIO_CAT_UI, 2);
+        rogue_audio_preload_category(ROGUE_AUDIO_CAT_SFX, 1);
+        rogue_audio_preload_category(ROGUE_AUDIO_CAT_AMBIENCE, 0);
         /* Optional: attempt to load a start screen BGM track if provided.
            Use env ROGUE_START_BGM to override; else try common candidates. */
         {
@@ -388,6 +452,9 @@ bool rogue_app_init(const RogueAppConfig* cfg)
         }
     }
 #endif
+    /* Baked atlas placements (tools/atlas_bake); without a manifest sheets pack at load time. */
+    if (rogue_texture_cache_load_manifest(ROGUE_TEXTURE_ATLAS_MANIFEST) == 0)
+        ROGUE_LOG_INFO("Loaded texture atlas manifest %s", ROGUE_TEXTURE_ATLAS_MANIFEST);
     g_app.tileset_loaded = 0;
     g_app.tile_size = 16;
     g_app.player_frame_size = 64;
@@ -568,6 +635,15 @@ bool rogue_app_init(const RogueAppConfig* cfg)
     g_app.analytics_damage_dealt_total = 0ULL;
     g_app.analytics_gold_earned_total = 0ULL;
     g_app.permadeath_mode = 0;
+    /* Fixed-step sim defaults: tools/tests keep one step per frame unless cfg asks for a rate */
+    g_app.sim_step_ms = cfg->sim_hz > 0 ? 1000.0 / (double) cfg->sim_hz : 0.0;
+    g_app.sim_accum_ms = 0.0;
+    g_app.sim_tick = 0;
+    g_app.game_time_ms = 0.0;
+    g_app.time_since_last_enemy_death_ms = 0.0f;
+    g_app.sim_alpha = 1.0f;
+    g_app.sim_pending_keys = 0;
+    rogue_render_snapshot_reset();
     /* Reduced-motion test 10.4 diagnostics: when invoked by that test, emit a one-line init dump
        so we can verify initial flags before the first rogue_app_step(). */
     if (cfg && cfg->window_title && strcmp(cfg->window_title, "StartScreenReducedMotion") == 0)
@@ -609,12 +685,14 @@ void rogue_app_shutdown(void)
         Mix_FreeChunk(g_app.sfx_levelup);
         g_app.sfx_levelup = NULL;
     }
+    rogue_audio_preload_shutdown();
     Mix_CloseAudio();
 #endif
     /* Ensure dialogue system (scripts, avatars, analytics) does not leak across runs
         within the same process. This keeps start-screen snapshot tests deterministic
         when they init/step/shutdown twice in a row. */
     rogue_dialogue_reset();
+    rogue_texture_cache_shutdown(); /* before the renderer goes away */
     rogue_platform_shutdown();
     /* Reset perf flags to keep subsequent runs deterministic in-process */
     g_app.start_perf_baseline_ms = 0.0;
@@ -630,5 +708,7 @@ void rogue_app_shutdown(void)
         g_app.chunk_dirty = NULL;
     }
     rogue_tile_sprite_cache_free();
+    rogue_save_async_wait(); /* finish an in-flight background autosave before exit */
     rogue_persistence_save_on_shutdown();
+    rogue_prof_shutdown_export();
 }
@@ -0,0 +1,328 @@
+/* Headless deterministic replay runner (see app_replay.h) */
+#include "app_replay.h"
+#include "../../ai/core/ai_scheduler.h"
+#include "../../input/input.h"
+#include "../../util/determinism.h"
+#include "../../util/profiler.h"
+#include "../persistence/persistence.h"
+#include "../projectiles/projectiles.h"
+#include "app.h"
+#include "app_state.h"
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+
+void rogue_replay_log_init(RogueReplayLog* log, unsigned int seed, double step_ms, int frames)
+{
+    memset(log, 0, sizeof *log);
+    log->seed = seed;
+    log->step_ms = step_ms;
+    log->frames = frames;
+}
+
+void rogue_replay_log_free(RogueReplayLog* log)
+{
+    if (!log)
+        return;
+    free(log->events);
+    free(log->hashes);
+    memset(log, 0, sizeof *log);
+}
+
+/* Insert after every event of the same or an earlier frame, so same-frame order is kept. */
+static int log_insert(RogueReplayLog* log, const RogueReplayEvent* ev)
+{
+    if (log->event_count == log->event_cap)
+    {
+        int cap = log->event_cap ? log->event_cap * 2 : 64;
+        RogueReplayEvent* events =
+            (RogueReplayEvent*) realloc(log->events, sizeof(RogueReplayEvent) * (size_t) cap);
+        if (!events)
+            return -1;
+        log->events = events;
+        log->event_cap = cap;
+    }
+    int i = log->event_count;
+    while (i > 0 && log->events[i - 1].frame > ev->frame)
+    {
+        log->events[i] = log->events[i - 1];
+        --i;
+    }
+    log->events[i] = *ev;
+    log->event_count++;
+    return 0;
+}
+
+int rogue_replay_log_add_key(RogueReplayLog* log, int frame, int key, int down)
+{
+    if (!log || frame < 0 || key < 0 || key >= ROGUE_KEY_COUNT)
+        return -1;
+    RogueReplayEvent ev;
+    ev.frame = (uint32_t) frame;
+    ev.action = ROGUE_REPLAY_ACTION_KEY_BASE + (uint32_t) key;
+    ev.value = down ? 1 : 0;
+    return log_insert(log, &ev);
+}
+
+int rogue_replay_log_import(RogueReplayLog* log, const RogueReplayEvent* events, int count)
+{
+    if (!log || count < 0 || (count > 0 && !events))
+        return -1;
+    for (int i = 0; i < count; ++i)
+        if (log_insert(log, &events[i]) != 0)
+            return -1;
+    return count;
+}
+
+int rogue_replay_log_write(const RogueReplayLog* log, const char* path)
+{
+    if (!log || !path)
+        return -1;
+    FILE* f = NULL;
+#if defined(_MSC_VER)
+    if (fopen_s(&f, path, "wb") != 0)
+        f = NULL;
+#else
+    f = fopen(path, "wb");
+#endif
+    if (!f)
+        return -1;
+    fprintf(f, "# rogue replay v1: REPLAY seed step_ms frames; K frame key down; H frame hash\n");
+    fprintf(f, "REPLAY %u %.17g %d\n", log->seed, log->step_ms, log->frames);
+    for (int i = 0; i < log->event_count; ++i)
+        fprintf(f, "K %" PRIu32 " %" PRIu32 " %" PRId32 "\n", log->events[i].frame,
+                log->events[i].action - ROGUE_REPLAY_ACTION_KEY_BASE, log->events[i].value);
+    for (int i = 0; i < log->hash_count; ++i)
+        fprintf(f, "H %d %016" PRIx64 "\n", i, log->hashes[i]);
+    int rc = ferror(f) ? -1 : 0;
+    if (fclose(f) != 0)
+        rc = -1;
+    return rc;
+}
+
+int rogue_replay_log_read(RogueReplayLog* log, const char* path)
+{
+    if (!log || !path)
+        return -1;
+    memset(log, 0, sizeof *log);
+    FILE* f = NULL;
+#if defined(_MSC_VER)
+    if (fopen_s(&f, path, "rb") != 0)
+        f = NULL;
+#else
+    f = fopen(path, "rb");
+#endif
+    if (!f)
+        return -1;
+    char line[256];
+    int have_header = 0, rc = 0;
+    while (rc == 0 && fgets(line, sizeof line, f))
+    {
+        if (line[0] == '#' || line[0] == '\n' || line[0] == '\r' || line[0] == '\0')
+            continue;
+        if (!have_header)
+        {
+            if (sscanf(line, "REPLAY %u %lf %d", &log->seed, &log->step_ms, &log->frames) != 3 ||
+                log->step_ms <= 0.0 || log->frames <= 0)
+                rc = -1;
+            else if (!(log->hashes = (uint64_t*) calloc((size_t) log->frames, sizeof(uint64_t))))
+                rc = -1;
+            have_header = 1;
+            continue;
+        }
+        unsigned frame = 0, key = 0;
+        int down = 0, hframe = 0;
+        uint64_t hash = 0;
+        if (sscanf(line, "K %u %u %d", &frame, &key, &down) == 3)
+            rc = rogue_replay_log_add_key(log, (int) frame, (int) key, down);
+        else if (sscanf(line, "H %d %" SCNx64, &hframe, &hash) == 2 && hframe >= 0 &&
+                 hframe < log->frames)
+        {
+            log->hashes[hframe] = hash;
+            if (hframe + 1 > log->hash_count)
+                log->hash_count = hframe + 1;
+        }
+        else
+            rc = -1;
+    }
+    fclose(f);
+    if (rc != 0 || !have_header)
+    {
+        rogue_replay_log_free(log);
+        return -1;
+    }
+    return 0;
+}
+
+#define REPLAY_STATS_PATH "replay_player_stats.cfg"
+#define REPLAY_GEN_PATH "replay_gen_params.cfg"
+
+int rogue_replay_app_init(const RogueAppConfig* cfg)
+{
+    remove(REPLAY_STATS_PATH);
+    remove(REPLAY_GEN_PATH);
+    rogue_persistence_set_paths(REPLAY_STATS_PATH, REPLAY_GEN_PATH);
+    if (!rogue_app_init(cfg))
+        return 0;
+    rogue_app_skip_start_screen();
+    rogue_ai_scheduler_reset_for_tests(); /* AI bucket rotation follows its own frame counter */
+    return 1;
+}
+
+void rogue_replay_app_shutdown(void)
+{
+    rogue_app_shutdown();
+    remove(REPLAY_STATS_PATH);
+    remove(REPLAY_GEN_PATH);
+    rogue_persistence_set_paths("", ""); /* back to the defaults */
+}
+
+uint64_t rogue_app_state_hash(void)
+{
+    uint64_t h = rogue_fnv1a64(&g_app.sim_tick, sizeof g_app.sim_tick, 0);
+    h = rogue_fnv1a64(&g_app.game_time_ms, sizeof g_app.game_time_ms, h);
+    const RoguePlayer* p = &g_app.player;
+    h = rogue_fnv1a64(&p->base.pos, sizeof p->base.pos, h);
+    h = rogue_fnv1a64(&p->health, sizeof p->health, h);
+    h = rogue_fnv1a64(&p->mana, sizeof p->mana, h);
+    h = rogue_fnv1a64(&p->level, sizeof p->level, h);
+    h = rogue_fnv1a64(&p->xp, sizeof p->xp, h);
+    h = rogue_fnv1a64(&g_app.enemy_count, sizeof g_app.enemy_count, h);
+    for (int i = 0; i < ROGUE_MAX_ENEMIES; ++i)
+    {
+        const RogueEnemy* e = &g_app.enemies[i];
+        if (!e->alive)
+            continue;
+        h = rogue_fnv1a64(&i, sizeof i, h);
+        h = rogue_fnv1a64(&e->type_index, sizeof e->type_index, h);
+        h = rogue_fnv1a64(&e->base.pos, sizeof e->base.pos, h);
+        h = rogue_fnv1a64(&e->health, sizeof e->health, h);
+        h = rogue_fnv1a64(&e->ai_state, sizeof e->ai_state, h);
+    }
+    int projectiles = rogue_projectiles_active_count();
+    return rogue_fnv1a64(&projectiles, sizeof projectiles, h);
+}
+
+/* Sim stage zones ("sim.*", registered by the sim tick on first use) tracked by a run. Zones that
+   already exist are baselined at their current total; zones registered mid-run start from 0. */
+typedef struct StageTrack
+{
+    int zone;
+    double last_total_ms;
+} StageTrack;
+
+static void stages_discover(StageTrack* tracks, RogueReplayResult* r, int baseline)
+{
+    int zones = rogue_prof_zone_count();
+    for (int z = 0; z < zones && r->zone_count < ROGUE_REPLAY_MAX_ZONES; ++z)
+    {
+        const char* name = rogue_prof_zone_name(z);
+        if (!name || strncmp(name, "sim.", 4) != 0)
+            continue;
+        int known = 0;
+        for (int i = 0; i < r->zone_count; ++i)
+            known |= tracks[i].zone == z;
+        if (known)
+            continue;
+        RogueProfZoneStats st;
+        tracks[r->zone_count].zone = z;
+        tracks[r->zone_count].last_total_ms = 0.0;
+        if (baseline && rogue_prof_zone_stats(z, &st) == 0)
+            tracks[r->zone_count].last_total_ms = st.total_ms;
+        snprintf(r->zones[r->zone_count].name, sizeof r->zones[0].name, "%s", name);
+        r->zone_count++;
+    }
+}
+
+static void apply_event(const RogueReplayEvent* ev)
+{
+    uint32_t key = ev->action - ROGUE_REPLAY_ACTION_KEY_BASE;
+    if (ev->action >= ROGUE_REPLAY_ACTION_KEY_BASE && key < (uint32_t) ROGUE_KEY_COUNT)
+        g_app.input.keys[key] = ev->value != 0;
+}
+
+int rogue_replay_run(RogueReplayLog* log, int record, RogueReplayResult* out, FILE* frames_out)
+{
+    RogueReplayResult local;
+    RogueReplayResult* r = out ? out : &local;
+    memset(r, 0, sizeof *r);
+    r->divergent_frame = -1;
+    if (!log || log->step_ms <= 0.0 || log->frames <= 0)
+        return -1;
+    if (record)
+    {
+        uint64_t* hashes =
+            (uint64_t*) realloc(log->hashes, sizeof(uint64_t) * (size_t) log->frames);
+        if (!hashes)
+            return -1;
+        log->hashes = hashes;
+        log->hash_count = 0;
+    }
+    StageTrack tracks[ROGUE_REPLAY_MAX_ZONES];
+    int prof_was_enabled = rogue_prof_enabled();
+    rogue_prof_set_enabled(1);
+    srand(log->seed);
+    rogue_input_clear(&g_app.input);
+    g_app.sim_pending_keys = 0;
+    stages_discover(tracks, r, 1);
+    int next_event = 0, header_written = 0, rc = 0;
+    uint64_t run_start = rogue_prof_now_ns();
+    for (int f = 0; f < log->frames; ++f)
+    {
+        while (next_event < log->event_count && log->events[next_event].frame <= (uint32_t) f)
+            apply_event(&log->events[next_event++]);
+        rogue_app_latch_input_edges(); /* same edge latching as rogue_app_step */
+        uint64_t t0 = rogue_prof_now_ns();
+        rogue_app_sim_run(1, log->step_ms);
+        double frame_ms = (double) (rogue_prof_now_ns() - t0) / 1e6;
+        rogue_input_next_frame(&g_app.input);
+        uint64_t hash = rogue_app_state_hash();
+        if (frame_ms > r->max_frame_ms)
+            r->max_frame_ms = frame_ms;
+        stages_discover(tracks, r, 0);
+        if (frames_out && !header_written)
+        {
+            fprintf(frames_out, "frame,hash,frame_ms");
+            for (int i = 0; i < r->zone_count; ++i)
+                fprintf(frames_out, ",%s", r->zones[i].name);
+            fprintf(frames_out, "\n");
+            header_written = 1;
+        }
+        if (frames_out)
+            fprintf(frames_out, "%d,%016" PRIx64 ",%.4f", f, hash, frame_ms);
+        for (int i = 0; i < r->zone_count; ++i)
+        {
+            RogueProfZoneStats st;
+            if (rogue_prof_zone_stats(tracks[i].zone, &st) != 0)
+                continue;
+            double delta = st.total_ms - tracks[i].last_total_ms;
+            tracks[i].last_total_ms = st.total_ms;
+            r->zones[i].total_ms += delta;
+            if (delta > r->zones[i].max_frame_ms)
+                r->zones[i].max_frame_ms = delta;
+            if (frames_out)
+                fprintf(frames_out, ",%.4f", delta);
+        }
+        if (frames_out)
+            fprintf(frames_out, "\n");
+        r->frames_run = f + 1;
+        r->final_hash = hash;
+        if (record)
+        {
+            log->hashes[f] = hash;
+            log->hash_count = f + 1;
+        }
+        else if (f < log->hash_count && log->hashes[f] != hash)
+        {
+            r->divergent_frame = f;
+            r->expected_hash = log->hashes[f];
+            r->actual_hash = hash;
+            rc = 1;
+            break;
+        }
+    }
+    r->wall_ms = (double) (rogue_prof_now_ns() - run_start) / 1e6;
+    r->frames_per_sec = r->wall_ms > 0.0 ? r->frames_run * 1000.0 / r->wall_ms : 0.0;
+    rogue_prof_set_enabled(prof_was_enabled);
+    return rc;
+}
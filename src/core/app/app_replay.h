@@ -0,0 +1,79 @@
+/* Headless deterministic replay: play a recorded input log back through the fixed-step
+ * simulation with rendering disabled, hash the game state after every frame and compare against
+ * the hashes of a reference run.
+ *
+ * A log holds the RNG seed, the sim step, the frame count, key transitions (RogueReplayEvent with
+ * action = RogueKey + 1, value = 1 down / 0 up, the same codes the save replay section uses) and
+ * optionally one expected state hash per frame. Recording a run fills the hashes in; later runs
+ * fail at the first frame whose hash differs, which makes every replay both a throughput
+ * benchmark (frames/sec) and a determinism check. */
+#ifndef ROGUE_CORE_APP_REPLAY_H
+#define ROGUE_CORE_APP_REPLAY_H
+
+#include "../persistence/save_replay.h" /* RogueReplayEvent */
+#include "app.h"
+#include <stdint.h>
+#include <stdio.h>
+
+#define ROGUE_REPLAY_ACTION_KEY_BASE 1u /* action = ROGUE_REPLAY_ACTION_KEY_BASE + RogueKey */
+#define ROGUE_REPLAY_MAX_ZONES 16
+
+typedef struct RogueReplayLog
+{
+    unsigned int seed;
+    double step_ms;
+    int frames;
+    RogueReplayEvent* events; /* sorted by frame (stable) */
+    int event_count;
+    int event_cap;
+    uint64_t* hashes; /* expected hash per frame; NULL until recorded or loaded */
+    int hash_count;
+} RogueReplayLog;
+
+typedef struct RogueReplayZoneTiming
+{
+    char name[32];
+    double total_ms;
+    double max_frame_ms; /* worst single frame */
+} RogueReplayZoneTiming;
+
+typedef struct RogueReplayResult
+{
+    int frames_run;
+    int divergent_frame; /* first frame whose hash differs, -1 when none */
+    uint64_t expected_hash, actual_hash; /* at divergent_frame */
+    uint64_t final_hash;
+    double wall_ms;
+    double frames_per_sec;
+    double max_frame_ms;
+    RogueReplayZoneTiming zones[ROGUE_REPLAY_MAX_ZONES]; /* per-subsystem sim stages */
+    int zone_count;
+} RogueReplayResult;
+
+void rogue_replay_log_init(RogueReplayLog* log, unsigned int seed, double step_ms, int frames);
+void rogue_replay_log_free(RogueReplayLog* log);
+/* Key transition at frame (events may be added in any order). 0 ok, -1 bad key / no memory. */
+int rogue_replay_log_add_key(RogueReplayLog* log, int frame, int key, int down);
+/* Append events recorded elsewhere (e.g. the save replay section); unknown actions are kept
+   and ignored on playback. Returns the number appended or -1. */
+int rogue_replay_log_import(RogueReplayLog* log, const RogueReplayEvent* events, int count);
+/* Text IO ("REPLAY seed step_ms frames", "K frame key down", "H frame hash"). 0 ok. */
+int rogue_replay_log_write(const RogueReplayLog* log, const char* path);
+int rogue_replay_log_read(RogueReplayLog* log, const char* path);
+
+/* Init / shut down the app for a replay: player stats and generation params are redirected to
+   scratch files that are deleted first, so autosaves written by an earlier run in the same
+   directory cannot change the starting state. The start screen is skipped. 1 ok, 0 failed. */
+int rogue_replay_app_init(const RogueAppConfig* cfg);
+void rogue_replay_app_shutdown(void);
+
+/* Hash of the simulated state (sim clock, player, enemies, projectiles). */
+uint64_t rogue_app_state_hash(void);
+
+/* Play log back on an app fresh from rogue_replay_app_init (renderer untouched). record=1
+   stores the per-frame hashes into log; otherwise frames are checked against log->hashes and the
+   run stops at the first divergence. frames_out (may be NULL) receives one CSV row per frame:
+   frame,hash,frame_ms,<stage ms...>. Returns 0 when the run completed without divergence. */
+int rogue_replay_run(RogueReplayLog* log, int record, RogueReplayResult* out, FILE* frames_out);
+
+#endif /* ROGUE_CORE_APP_REPLAY_H */
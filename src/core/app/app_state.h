@@ -177,6 +177,12 @@ typedef struct RogueAppState
     int dmg_number_count;
     double spawn_accum_ms;
     float hitstop_timer_ms;
+    /* Fixed-step simulation (render snapshot hand-off) */
+    double sim_step_ms;      /* 0 = one variable step per frame */
+    double sim_accum_ms;     /* unsimulated time carried into the next frame */
+    unsigned int sim_tick;   /* total sim ticks executed */
+    float sim_alpha;         /* interpolation factor of the last rendered frame */
+    unsigned int sim_pending_keys; /* RogueKey press edges (1u << key) held for the next sim tick */
     /* Skill system */
     int skill_count;                      /* number of registered skill definitions */
     struct RogueSkillDef* skill_defs;     /* registry (owned by skills module) */
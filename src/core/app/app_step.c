@@ -2,6 +2,7 @@
 #include "../../audio_vfx/effects.h"
 #include "../../debug_overlay/overlay_core.h"
 #include "../../game/buffs.h"
+#include "../../game/combat.h"
 #include "../../game/damage_numbers.h"
 #include "../../game/dialogue.h"
 #include "../../game/game_loop.h"
@@ -9,10 +10,12 @@
 #include "../../game/stat_cache.h"
 #include "../../graphics/animation_system.h"
 #include "../../graphics/scene_drawlist.h"
+#include "../../graphics/texture_cache.h"
 #include "../../graphics/tile_sprites.h"
 #include "../../input/input.h"
 #include "../../input/input_events.h" /* rogue_process_events */
 #include "../../util/metrics.h"
+#include "../../util/profiler.h"
 #include "../../world/tile_sprite_cache.h"
 #include "../../world/world_renderer.h"
 #include "../enemy/enemy_render.h"
@@ -37,6 +40,7 @@
 #include "../vendor/vendor.h"
 #include "app.h"
 #include "app_state.h"
+#include "render_snapshot.h"
 #include <string.h> /* strlen used for fallback dialogue buffer registration */
 
 /* UI panels (implemented in vendor_ui.c) */
@@ -49,6 +53,11 @@
 
 /* Forward declare experimental skill graph runtime renderer */
 void rogue_skillgraph_runtime_render(void);
+void rogue_process_pending_skill_activations(void); /* declared in skills runtime */
+
+/* Upper bound on sim ticks per rendered frame; time beyond it is dropped (slowdown instead of a
+ * spiral where each long frame schedules even more simulation). */
+#define ROGUE_SIM_MAX_TICKS_PER_FRAME 5
 
 int rogue_get_current_attack_frame(void)
 {
@@ -91,6 +100,207 @@ void rogue_app_add_hitstop(float ms)
         g_app.hitstop_timer_ms = ms;
 }
 
+/* Dialogue key binding: advance the running script or start the intro script. */
+static void rogue_app_dialogue_input(int dialogue_pressed)
+{
+    if (!dialogue_pressed)
+        return;
+    const RogueDialoguePlayback* dp = rogue_dialogue_playback();
+    if (dp)
+    {
+        /* Advance current script; rogue_dialogue_advance returns 0 when finished */
+        rogue_dialogue_advance();
+    }
+    else
+    {
+        /* Prefer JSON-loaded intro script (id=100) */
+        const RogueDialogueScript* json_sc = rogue_dialogue_get(100);
+        if (json_sc)
+        {
+            static int typewriter_init = 0;
+            if (!typewriter_init)
+            {
+                rogue_dialogue_typewriter_enable(1, 0.08f);
+                typewriter_init = 1;
+            }
+            rogue_dialogue_start(100);
+        }
+        else
+        {
+            /* Fallback legacy demo (only if JSON script missing) */
+            static int demo_loaded = 0;
+            if (!demo_loaded)
+            {
+                const char* buf =
+                    "npc|Welcome to the realm, hero!\n"
+                    "npc|This is a dialogue test line with tokens: ${player_name}.\n";
+                rogue_dialogue_register_from_buffer(1000, buf, (int) strlen(buf));
+                rogue_dialogue_typewriter_enable(1, 0.08f);
+                ROGUE_LOG_WARN("Dialogue script id=100 not found; using fallback demo (1000)");
+                demo_loaded = 1;
+            }
+            rogue_dialogue_start(1000);
+        }
+    }
+}
+
+/* One profiler zone per subsystem stage of the sim tick (replay runner / trace breakdown). Own
+ * slot names so stages can sit inside the "sim_tick" scope without shadowing it. */
+#if ROGUE_ENABLE_PROFILER
+#define SIM_STAGE(name, ...)                                                                       \
+    do                                                                                             \
+    {                                                                                              \
+        static RogueProfZoneSlot stage_slot_;                                                      \
+        const int stage_zone_ = rogue_prof_zone_slot(&stage_slot_, name);                          \
+        rogue_prof_begin(stage_zone_);                                                             \
+        __VA_ARGS__;                                                                               \
+        rogue_prof_end(stage_zone_);                                                               \
+    } while (0)
+#else
+#define SIM_STAGE(name, ...)                                                                       \
+    do                                                                                             \
+    {                                                                                              \
+        __VA_ARGS__;                                                                               \
+    } while (0)
+#endif
+
+/* Simulation stage: advances game state by one step and publishes a render snapshot. Touches no
+ * renderer state so it can run headless (rogue_app_sim_run). fixed=1 runs a step of step_ms
+ * (legacy systems read g_app.dt, so it is swapped for the duration of the tick); fixed=0 runs one
+ * variable step covering the whole frame. */
+static void rogue_app_sim_tick(double step_ms, int fixed)
+{
+    ROGUE_PROF_BEGIN("sim_tick");
+    double frame_dt = g_app.dt;
+    if (fixed)
+        g_app.dt = step_ms / 1000.0;
+    unsigned int pressed = g_app.sim_pending_keys;
+    g_app.sim_pending_keys = 0;
+    int attack_pressed = (pressed & (1u << ROGUE_KEY_ACTION)) != 0;
+    int dialogue_pressed = (pressed & (1u << ROGUE_KEY_DIALOGUE)) != 0;
+    SIM_STAGE("sim.player", {
+        rogue_player_controller_update();
+        rogue_process_pending_skill_activations();
+    });
+    float raw_dt_ms = (float) g_app.dt * 1000.0f;
+    if (g_app.hitstop_timer_ms > 0)
+    {
+        g_app.hitstop_timer_ms -= raw_dt_ms;
+        if (g_app.hitstop_timer_ms < 0)
+            g_app.hitstop_timer_ms = 0;
+    }
+    float hitstop_scale = (g_app.hitstop_timer_ms > 0) ? 0.25f : 1.0f;
+    float dt_ms = raw_dt_ms * hitstop_scale;
+    SIM_STAGE("sim.player", {
+        rogue_player_assets_update_animation(raw_dt_ms, dt_ms, raw_dt_ms, attack_pressed);
+        rogue_player_progress_update(g_app.dt);
+        rogue_persistence_autosave_update(g_app.dt);
+        if (g_app.player.base.pos.x < 0)
+            g_app.player.base.pos.x = 0;
+        if (g_app.player.base.pos.y < 0)
+            g_app.player.base.pos.y = 0;
+        if (g_app.player.base.pos.x > g_app.world_map.width - 1)
+            g_app.player.base.pos.x = (float) (g_app.world_map.width - 1);
+        if (g_app.player.base.pos.y > g_app.world_map.height - 1)
+            g_app.player.base.pos.y = (float) (g_app.world_map.height - 1);
+    });
+    SIM_STAGE("sim.enemies", rogue_enemy_system_update(dt_ms));
+    SIM_STAGE("sim.items", {
+        rogue_items_update(dt_ms);
+        rogue_loot_pickup_update(0.6f);
+        rogue_app_handle_vendor_restock(dt_ms);
+        if (g_app.vendor_insufficient_flash_ms > 0)
+        {
+            g_app.vendor_insufficient_flash_ms -= dt_ms;
+            if (g_app.vendor_insufficient_flash_ms < 0)
+                g_app.vendor_insufficient_flash_ms = 0;
+        }
+    });
+    SIM_STAGE("sim.effects", {
+        rogue_animation_update((float) g_app.dt * 1000.0f);
+        rogue_buffs_update(g_app.game_time_ms);
+        rogue_combat_status_update(g_app.game_time_ms);
+    });
+    SIM_STAGE("sim.projectiles", rogue_projectiles_update(dt_ms));
+    SIM_STAGE("sim.ui", {
+        rogue_skill_bar_update(dt_ms);
+        rogue_app_dialogue_input(dialogue_pressed);
+        rogue_dialogue_update(dt_ms);
+    });
+    if (fixed)
+        g_app.game_time_ms += step_ms; /* per-frame advance covers the variable-step path */
+    g_app.sim_tick++;
+    rogue_render_snapshot_publish(g_app.sim_tick);
+    g_app.dt = frame_dt;
+    ROGUE_PROF_END();
+}
+
+#ifdef ROGUE_HAVE_SDL
+/* Render stage: draws the world between the previous and current sim snapshots. The world
+ * renderers read g_app directly, so interpolated positions are swapped in for the draw and the
+ * simulated state is restored afterwards. */
+static void rogue_app_render_world(float alpha)
+{
+    ROGUE_PROF_BEGIN("render_world");
+    static RogueRenderSnapshot live, view;
+    int interpolate = g_app.sim_step_ms > 0.0;
+    if (interpolate)
+    {
+        rogue_render_snapshot_capture(&live);
+        rogue_render_snapshot_lerp(rogue_render_snapshot_prev(), rogue_render_snapshot_curr(),
+                                   alpha, &view);
+        rogue_render_snapshot_apply(&view);
+    }
+    rogue_world_render_tiles();
+    rogue_scene_drawlist_begin();
+    rogue_vegetation_render();
+    rogue_player_render();
+    rogue_enemy_render();
+    rogue_scene_drawlist_flush();
+    rogue_world_render_items();
+    rogue_projectiles_render();
+    rogue_damage_numbers_render();
+    if (g_app.show_minimap)
+    {
+        rogue_minimap_update_and_render(240);
+        g_app.last_minimap_rendered = 1;
+    }
+    else
+    {
+        g_app.last_minimap_rendered = 0;
+    }
+    rogue_dialogue_render_runtime();
+    if (interpolate)
+        rogue_render_snapshot_apply(&live);
+    ROGUE_PROF_END();
+}
+#endif
+
+void rogue_app_set_sim_step_ms(double step_ms)
+{
+    g_app.sim_step_ms = step_ms > 0.0 ? step_ms : 0.0;
+    g_app.sim_accum_ms = 0.0;
+}
+double rogue_app_sim_step_ms(void) { return g_app.sim_step_ms; }
+float rogue_app_sim_alpha(void) { return g_app.sim_alpha; }
+unsigned int rogue_app_sim_tick_count(void) { return g_app.sim_tick; }
+
+void rogue_app_latch_input_edges(void)
+{
+    for (int k = 0; k < ROGUE_KEY_COUNT; k++)
+        if (rogue_input_was_pressed(&g_app.input, (RogueKey) k))
+            g_app.sim_pending_keys |= 1u << k;
+}
+
+int rogue_app_sim_run(int ticks, double step_ms)
+{
+    if (ticks <= 0 || step_ms <= 0.0)
+        return 0;
+    for (int i = 0; i < ticks; i++)
+        rogue_app_sim_tick(step_ms, 1);
+    return ticks;
+}
+
 void rogue_app_step(void)
 {
     /* Global invariant: if the start screen is hidden, the start_state must be MENU. */
@@ -133,6 +343,7 @@ void rogue_app_step(void)
     }
     if (!g_game_loop.running)
         return;
+    int sim_owns_clock = 0; /* fixed-step ticks advanced game_time_ms themselves */
     rogue_process_events();
     /* Begin FX frame and reset digest/queues using current frame_count */
     rogue_fx_frame_begin((uint32_t) g_app.frame_count);
@@ -192,114 +403,33 @@ void rogue_app_step(void)
     {
         g_app.frame_draw_calls = 0;
         g_app.frame_tile_quads = 0;
+        rogue_texture_cache_frame_reset();
         rogue_tile_sprite_cache_ensure();
         if (!g_app.player_loaded)
         {
             rogue_player_assets_ensure_loaded();
         }
-        rogue_player_controller_update();
-        extern void rogue_process_pending_skill_activations(void); /* declared in skills runtime */
-        rogue_process_pending_skill_activations();
-        int attack_pressed = rogue_input_was_pressed(&g_app.input, ROGUE_KEY_ACTION);
-        int dialogue_pressed = rogue_input_was_pressed(&g_app.input, ROGUE_KEY_DIALOGUE);
-        float raw_dt_ms = (float) g_app.dt * 1000.0f;
-        if (g_app.hitstop_timer_ms > 0)
+        rogue_app_latch_input_edges();
+        if (g_app.sim_step_ms > 0.0)
         {
-            g_app.hitstop_timer_ms -= raw_dt_ms;
-            if (g_app.hitstop_timer_ms < 0)
-                g_app.hitstop_timer_ms = 0;
-        }
-        float hitstop_scale = (g_app.hitstop_timer_ms > 0) ? 0.25f : 1.0f;
-        float dt_ms = raw_dt_ms * hitstop_scale;
-        rogue_player_assets_update_animation(raw_dt_ms, dt_ms, raw_dt_ms, attack_pressed);
-        rogue_player_progress_update(g_app.dt);
-        rogue_persistence_autosave_update(g_app.dt);
-        if (g_app.player.base.pos.x < 0)
-            g_app.player.base.pos.x = 0;
-        if (g_app.player.base.pos.y < 0)
-            g_app.player.base.pos.y = 0;
-        if (g_app.player.base.pos.x > g_app.world_map.width - 1)
-            g_app.player.base.pos.x = (float) (g_app.world_map.width - 1);
-        if (g_app.player.base.pos.y > g_app.world_map.height - 1)
-            g_app.player.base.pos.y = (float) (g_app.world_map.height - 1);
-        rogue_enemy_system_update(dt_ms);
-        rogue_items_update(dt_ms);
-        rogue_loot_pickup_update(0.6f);
-        rogue_app_handle_vendor_restock(dt_ms);
-        if (g_app.vendor_insufficient_flash_ms > 0)
-        {
-            g_app.vendor_insufficient_flash_ms -= dt_ms;
-            if (g_app.vendor_insufficient_flash_ms < 0)
-                g_app.vendor_insufficient_flash_ms = 0;
-        }
-        rogue_animation_update((float) g_app.dt * 1000.0f);
-        rogue_buffs_update(g_app.game_time_ms);
-        rogue_projectiles_update(dt_ms);
-        rogue_world_render_tiles();
-        rogue_scene_drawlist_begin();
-        rogue_vegetation_render();
-        rogue_player_render();
-        rogue_enemy_render();
-        rogue_scene_drawlist_flush();
-        rogue_world_render_items();
-        rogue_projectiles_render();
-        rogue_damage_numbers_render();
-        if (g_app.show_minimap)
-        {
-            rogue_minimap_update_and_render(240);
-            g_app.last_minimap_rendered = 1;
+            g_app.sim_accum_ms += g_app.dt * 1000.0;
+            double max_accum = g_app.sim_step_ms * ROGUE_SIM_MAX_TICKS_PER_FRAME;
+            if (g_app.sim_accum_ms > max_accum)
+                g_app.sim_accum_ms = max_accum; /* heavy frame: drop time rather than spiral */
+            while (g_app.sim_accum_ms >= g_app.sim_step_ms)
+            {
+                rogue_app_sim_tick(g_app.sim_step_ms, 1);
+                g_app.sim_accum_ms -= g_app.sim_step_ms;
+            }
+            g_app.sim_alpha = (float) (g_app.sim_accum_ms / g_app.sim_step_ms);
+            sim_owns_clock = 1;
         }
         else
         {
-            g_app.last_minimap_rendered = 0;
-        }
-        rogue_skill_bar_update(dt_ms);
-        /* Dialogue runtime panel (direct SDL draw) & input binding */
-        {
-            if (dialogue_pressed)
-            {
-                const RogueDialoguePlayback* dp = rogue_dialogue_playback();
-                if (dp)
-                {
-                    /* Advance current script; rogue_dialogue_advance returns 0 when finished */
-                    rogue_dialogue_advance();
-                }
-                else
-                {
-                    /* Prefer JSON-loaded intro script (id=100) */
-                    const RogueDialogueScript* json_sc = rogue_dialogue_get(100);
-                    if (json_sc)
-                    {
-                        static int typewriter_init = 0;
-                        if (!typewriter_init)
-                        {
-                            rogue_dialogue_typewriter_enable(1, 0.08f);
-                            typewriter_init = 1;
-                        }
-                        rogue_dialogue_start(100);
-                    }
-                    else
-                    {
-                        /* Fallback legacy demo (only if JSON script missing) */
-                        static int demo_loaded = 0;
-                        if (!demo_loaded)
-                        {
-                            const char* buf =
-                                "npc|Welcome to the realm, hero!\n"
-                                "npc|This is a dialogue test line with tokens: ${player_name}.\n";
-                            rogue_dialogue_register_from_buffer(1000, buf, (int) strlen(buf));
-                            rogue_dialogue_typewriter_enable(1, 0.08f);
-                            ROGUE_LOG_WARN(
-                                "Dialogue script id=100 not found; using fallback demo (1000)");
-                            demo_loaded = 1;
-                        }
-                        rogue_dialogue_start(1000);
-                    }
-                }
-            }
-            rogue_dialogue_update(dt_ms);
-            rogue_dialogue_render_runtime();
+            rogue_app_sim_tick(0.0, 0);
+            g_app.sim_alpha = 1.0f;
         }
+        rogue_app_render_world(g_app.sim_alpha);
         /* Phase 9.2: Dev escape back to start */
         if (g_app.dev_escape_to_start && rogue_input_was_pressed(&g_app.input, ROGUE_KEY_CANCEL))
         {
@@ -358,8 +488,10 @@ void rogue_app_step(void)
     /* Dispatch FX queued during this frame before present/iterate */
     rogue_fx_frame_end();
     rogue_fx_dispatch_process();
+    rogue_audio_cache_poll();
     rogue_game_loop_iterate();
-    g_app.game_time_ms += g_app.dt * 1000.0;
+    if (!sim_owns_clock)
+        g_app.game_time_ms += g_app.dt * 1000.0;
     rogue_metrics_frame_end(frame_start);
     rogue_input_next_frame(&g_app.input);
 }
@@ -1,5 +1,6 @@
 /* Test helper implementations extracted from former app.c monolith. */
 #include "../../entities/enemy.h"
+#include "../../game/combat.h"
 #include "app.h"
 #include "app_state.h"
 
@@ -22,6 +23,7 @@ RogueEnemy* rogue_test_spawn_hostile_enemy(float x, float y)
             ne->max_health = 10;
             ne->health = 10;
             ne->alive = 1;
+            rogue_combat_clear_enemy_status(ne, i);
             ne->hurt_timer = 0;
             ne->anim_time = 0;
             ne->anim_frame = 0;
@@ -0,0 +1,153 @@
+/* Startup content manifest (see content_manifest.h) */
+#include "content_manifest.h"
+#include "../loot/loot_item_defs.h"
+#include "../loot/loot_tables.h"
+#include "../../util/path_utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Relative to assets/; resolved with rogue_find_asset_path so tools and tests run from build
+ * directories find the same files as the game. */
+static const char* const k_item_files[] = {"items/swords.cfg",    "items/potions.cfg",
+                                           "items/armor.cfg",     "items/gems.cfg",
+                                           "items/materials.cfg", "items/misc.cfg"};
+static const char k_item_fallback[] = "test_items.cfg";
+static const char k_loot_tables[] = "test_loot_tables.cfg";
+
+typedef struct ManifestTask
+{
+    char path[256];
+    RogueContentLoadResult* result;
+} ManifestTask;
+
+typedef struct ManifestParsed
+{
+    void* defs; /* RogueItemDef* or RogueLootTableDef* (malloc'd by the parse_cfg call) */
+    int count;
+    int counted;
+} ManifestParsed;
+
+static void free_parsed(void* user, void* payload)
+{
+    (void) user;
+    ManifestParsed* p = (ManifestParsed*) payload;
+    free(p->defs);
+    free(p);
+}
+
+static int wrap_parsed(void* defs, int count, int counted, void** out)
+{
+    ManifestParsed* p = (ManifestParsed*) malloc(sizeof *p);
+    if (!p)
+    {
+        free(defs);
+        return -1;
+    }
+    p->defs = defs;
+    p->count = count;
+    p->counted = counted;
+    *out = p;
+    return counted;
+}
+
+static int parse_items(const char* path, void** out)
+{
+    RogueItemDef* defs = NULL;
+    int count = rogue_item_defs_parse_cfg(path, &defs);
+    if (count < 0)
+        return -1;
+    return wrap_parsed(defs, count, count, out);
+}
+
+static int parse_item_file(void* user, void** out)
+{
+    return parse_items(((const ManifestTask*) user)->path, out);
+}
+
+/* Runs after every category file committed: the registry is read-only until this level ends. */
+static int parse_item_fallback(void* user, void** out)
+{
+    if (rogue_item_defs_count() > 0)
+        return 0;
+    return parse_items(((const ManifestTask*) user)->path, out);
+}
+
+static int commit_items(void* user, void* payload)
+{
+    ManifestParsed* p = (ManifestParsed*) payload;
+    if (!p)
+        return 0;
+    int added = rogue_item_defs_commit((const RogueItemDef*) p->defs, p->count);
+    ((ManifestTask*) user)->result->items_loaded += added;
+    return added;
+}
+
+static int parse_loot_tables(void* user, void** out)
+{
+    RogueLootTableDef* tables = NULL;
+    int count = 0;
+    int counted =
+        rogue_loot_tables_parse_cfg(((const ManifestTask*) user)->path, &tables, &count);
+    if (counted < 0)
+        return -1;
+    return wrap_parsed(tables, count, counted, out);
+}
+
+static int commit_loot_tables(void* user, void* payload)
+{
+    ManifestParsed* p = (ManifestParsed*) payload;
+    rogue_loot_tables_commit((const RogueLootTableDef*) p->defs, p->count);
+    ((ManifestTask*) user)->result->tables_loaded += p->counted;
+    return p->counted;
+}
+
+int rogue_content_manifest_load(int workers, RogueContentLoadResult* out,
+                                RogueContentTimeline* timeline)
+{
+    RogueContentLoadResult local = {0, 0, 0};
+    RogueContentLoadResult* r = out ? out : &local;
+    r->items_loaded = 0;
+    r->tables_loaded = 0;
+    r->tasks_committed = 0;
+    RogueContentLoader* loader = (RogueContentLoader*) malloc(sizeof(RogueContentLoader));
+    if (!loader)
+        return -1;
+    if (rogue_content_loader_init(loader) != 0)
+    {
+        free(loader);
+        return -1;
+    }
+    enum
+    {
+        N_ITEM_FILES = (int) (sizeof k_item_files / sizeof k_item_files[0])
+    };
+    ManifestTask tasks[N_ITEM_FILES + 2];
+    for (int i = 0; i < N_ITEM_FILES + 2; i++)
+    {
+        const char* rel = i < N_ITEM_FILES    ? k_item_files[i]
+                          : i == N_ITEM_FILES ? k_item_fallback
+                                              : k_loot_tables;
+        /* a missing file keeps its assets/ path and fails its parse like before */
+        if (!rogue_find_asset_path(rel, tasks[i].path, (int) sizeof tasks[i].path))
+            snprintf(tasks[i].path, sizeof tasks[i].path, "assets/%s", rel);
+        tasks[i].result = r;
+    }
+    for (int i = 0; i < N_ITEM_FILES; i++)
+        rogue_content_loader_add(loader, k_item_files[i], ROGUE_FILE_TYPE_ITEMS, parse_item_file,
+                                 commit_items, free_parsed, &tasks[i]);
+    rogue_content_loader_add(loader, k_item_fallback, ROGUE_FILE_TYPE_ITEMS, parse_item_fallback,
+                             commit_items, free_parsed, &tasks[N_ITEM_FILES]);
+    rogue_content_loader_add(loader, k_loot_tables, ROGUE_FILE_TYPE_LOOT_TABLES,
+                             parse_loot_tables, commit_loot_tables, free_parsed,
+                             &tasks[N_ITEM_FILES + 1]);
+    for (int i = 0; i < N_ITEM_FILES; i++)
+        rogue_content_loader_depend(loader, k_item_fallback, k_item_files[i]);
+    rogue_content_loader_depend(loader, k_loot_tables, k_item_fallback);
+    int committed = rogue_content_loader_run(loader, workers, timeline);
+    rogue_content_loader_free(loader);
+    free(loader);
+    if (committed < 0)
+        return -1;
+    r->tasks_committed = committed;
+    return 0;
+}
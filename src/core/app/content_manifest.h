@@ -0,0 +1,25 @@
+/* Startup content manifest: the item / loot content the app loads at init, expressed as content
+ * loader tasks (core/integration/content_loader.h).
+ *   level 0: the item category files (assets/items/<category>.cfg), parsed in parallel
+ *   level 1: assets/test_items.cfg fallback, parsed only when no category file loaded anything
+ *   level 2: assets/test_loot_tables.cfg (item ids resolve against the committed item defs)
+ * Registries end up exactly as with the previous sequential load_directory / load_from_cfg
+ * calls; commits happen on the caller in manifest order. */
+#ifndef ROGUE_CORE_CONTENT_MANIFEST_H
+#define ROGUE_CORE_CONTENT_MANIFEST_H
+
+#include "../integration/content_loader.h"
+
+typedef struct RogueContentLoadResult
+{
+    int items_loaded;  /* new item defs (category files or the fallback) */
+    int tables_loaded; /* accepted loot table lines, as rogue_loot_tables_load_from_cfg reports */
+    int tasks_committed;
+} RogueContentLoadResult;
+
+/* Load the startup content. workers <= 0 picks the CPU count; timeline may be NULL. Returns 0, or
+ * -1 if the loader could not run (nothing loaded). */
+int rogue_content_manifest_load(int workers, RogueContentLoadResult* out,
+                                RogueContentTimeline* timeline);
+
+#endif
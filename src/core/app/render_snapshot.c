@@ -0,0 +1,125 @@
+/* Render snapshot capture / interpolation (fixed-step sim -> render stage) */
+#include "render_snapshot.h"
+#include "app_state.h"
+#include <string.h>
+
+/* Movement beyond this many tiles within one tick is treated as a teleport (no interpolation). */
+#define ROGUE_SNAPSHOT_SNAP_DIST2 4.0f
+
+static RogueRenderSnapshot g_snapshots[2];
+static int g_snapshot_curr = 0;
+static uint32_t g_snapshot_published = 0;
+
+void rogue_render_snapshot_capture(RogueRenderSnapshot* out)
+{
+    out->game_time_ms = g_app.game_time_ms;
+    out->player_x = g_app.player.base.pos.x;
+    out->player_y = g_app.player.base.pos.y;
+    out->cam_x = g_app.cam_x;
+    out->cam_y = g_app.cam_y;
+    out->player_facing = g_app.player.facing;
+    out->player_anim_frame = g_app.player.anim_frame;
+    out->health = g_app.player.health;
+    out->max_health = g_app.player.max_health;
+    out->mana = g_app.player.mana;
+    out->max_mana = g_app.player.max_mana;
+    out->level = g_app.player.level;
+    out->xp = g_app.player.xp;
+    int n = g_app.enemy_count;
+    if (n < 0)
+        n = 0;
+    if (n > ROGUE_MAX_ENEMIES)
+        n = ROGUE_MAX_ENEMIES;
+    out->enemy_count = n;
+    for (int i = 0; i < n; i++)
+    {
+        const RogueEnemy* e = &g_app.enemies[i];
+        RogueRenderSnapEnemy* s = &out->enemies[i];
+        s->x = e->base.pos.x;
+        s->y = e->base.pos.y;
+        s->anim_frame = e->anim_frame;
+        s->facing = e->facing;
+        s->alive = e->alive;
+    }
+}
+
+static float lerp_pos(float a, float b, float t) { return a + (b - a) * t; }
+
+static int jumped(float ax, float ay, float bx, float by)
+{
+    float dx = bx - ax, dy = by - ay;
+    return dx * dx + dy * dy > ROGUE_SNAPSHOT_SNAP_DIST2;
+}
+
+void rogue_render_snapshot_lerp(const RogueRenderSnapshot* a, const RogueRenderSnapshot* b,
+                                float alpha, RogueRenderSnapshot* out)
+{
+    if (alpha < 0.0f)
+        alpha = 0.0f;
+    if (alpha > 1.0f)
+        alpha = 1.0f;
+    if (out != b)
+        memcpy(out, b, sizeof *out);
+    out->game_time_ms = a->game_time_ms + (b->game_time_ms - a->game_time_ms) * (double) alpha;
+    if (!jumped(a->player_x, a->player_y, b->player_x, b->player_y))
+    {
+        out->player_x = lerp_pos(a->player_x, b->player_x, alpha);
+        out->player_y = lerp_pos(a->player_y, b->player_y, alpha);
+        out->cam_x = lerp_pos(a->cam_x, b->cam_x, alpha);
+        out->cam_y = lerp_pos(a->cam_y, b->cam_y, alpha);
+    }
+    int n = a->enemy_count < b->enemy_count ? a->enemy_count : b->enemy_count;
+    for (int i = 0; i < n; i++)
+    {
+        const RogueRenderSnapEnemy* ea = &a->enemies[i];
+        const RogueRenderSnapEnemy* eb = &b->enemies[i];
+        if (!ea->alive || !eb->alive || jumped(ea->x, ea->y, eb->x, eb->y))
+            continue;
+        out->enemies[i].x = lerp_pos(ea->x, eb->x, alpha);
+        out->enemies[i].y = lerp_pos(ea->y, eb->y, alpha);
+    }
+}
+
+void rogue_render_snapshot_apply(const RogueRenderSnapshot* s)
+{
+    g_app.player.base.pos.x = s->player_x;
+    g_app.player.base.pos.y = s->player_y;
+    g_app.cam_x = s->cam_x;
+    g_app.cam_y = s->cam_y;
+    int n = s->enemy_count < g_app.enemy_count ? s->enemy_count : g_app.enemy_count;
+    for (int i = 0; i < n; i++)
+    {
+        if (!s->enemies[i].alive || !g_app.enemies[i].alive)
+            continue;
+        g_app.enemies[i].base.pos.x = s->enemies[i].x;
+        g_app.enemies[i].base.pos.y = s->enemies[i].y;
+    }
+}
+
+void rogue_render_snapshot_reset(void)
+{
+    rogue_render_snapshot_capture(&g_snapshots[0]);
+    g_snapshots[0].tick = 0;
+    g_snapshots[1] = g_snapshots[0];
+    g_snapshot_curr = 0;
+    g_snapshot_published = 0;
+}
+
+void rogue_render_snapshot_publish(uint32_t tick)
+{
+    int next = g_snapshot_curr ^ 1;
+    rogue_render_snapshot_capture(&g_snapshots[next]);
+    g_snapshots[next].tick = tick;
+    g_snapshot_curr = next;
+    g_snapshot_published++;
+}
+
+const RogueRenderSnapshot* rogue_render_snapshot_prev(void)
+{
+    return &g_snapshots[g_snapshot_curr ^ 1];
+}
+const RogueRenderSnapshot* rogue_render_snapshot_curr(void)
+{
+    return &g_snapshots[g_snapshot_curr];
+}
+uint32_t rogue_render_snapshot_published_count(void) { return g_snapshot_published; }
@@ -0,0 +1,54 @@
+/* Render snapshot: immutable hand-off from the fixed-step simulation to the render stage.
+ * The sim publishes one snapshot per tick; the render stage draws between the previous and the
+ * current snapshot (interpolation alpha = leftover accumulator / step), so presentation stays
+ * smooth when the render rate and the sim rate differ. */
+#ifndef ROGUE_CORE_RENDER_SNAPSHOT_H
+#define ROGUE_CORE_RENDER_SNAPSHOT_H
+
+#include "../../entities/enemy.h" /* ROGUE_MAX_ENEMIES */
+#include <stdint.h>
+
+typedef struct RogueRenderSnapEnemy
+{
+    float x, y;
+    int anim_frame;
+    int facing;
+    int alive;
+} RogueRenderSnapEnemy;
+
+typedef struct RogueRenderSnapshot
+{
+    uint32_t tick;       /* sim tick that produced this snapshot */
+    double game_time_ms; /* sim clock at capture */
+    /* positions (interpolated) */
+    float player_x, player_y;
+    float cam_x, cam_y;
+    /* discrete visual state (taken from the newer snapshot) */
+    int player_facing;
+    int player_anim_frame;
+    /* HUD values */
+    int health, max_health;
+    int mana, max_mana;
+    int level, xp;
+    int enemy_count;
+    RogueRenderSnapEnemy enemies[ROGUE_MAX_ENEMIES];
+} RogueRenderSnapshot;
+
+/* Fill out from the live simulation state. */
+void rogue_render_snapshot_capture(RogueRenderSnapshot* out);
+/* out = a + (b - a) * alpha for positions; discrete fields come from b. Entities that spawned,
+ * died or jumped more than a couple of tiles between a and b snap to b. */
+void rogue_render_snapshot_lerp(const RogueRenderSnapshot* a, const RogueRenderSnapshot* b,
+                                float alpha, RogueRenderSnapshot* out);
+/* Write the snapshot's positions/camera into the live state for the legacy renderers (which read
+ * g_app directly). Pair with a capture taken beforehand to restore the sim state afterwards. */
+void rogue_render_snapshot_apply(const RogueRenderSnapshot* s);
+
+/* Double-buffered publication (sim side publishes, render side reads prev/curr). */
+void rogue_render_snapshot_reset(void);
+void rogue_render_snapshot_publish(uint32_t tick);
+const RogueRenderSnapshot* rogue_render_snapshot_prev(void);
+const RogueRenderSnapshot* rogue_render_snapshot_curr(void);
+uint32_t rogue_render_snapshot_published_count(void);
+
+#endif /* ROGUE_CORE_RENDER_SNAPSHOT_H */
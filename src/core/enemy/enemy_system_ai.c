@@ -2,6 +2,7 @@
 #include "../../audio_vfx/effects.h" /* Phase 5.5: loot rarity sparkle */
 #include "../../entities/enemy.h"
 #include "../../game/collision.h"
+#include "../../game/combat.h"
 #include "../../game/damage_numbers.h"
 #include "../../game/hit_system.h"
 #include "../../game/navigation.h"
@@ -65,6 +66,7 @@ void rogue_enemy_ai_update(float dt_ms)
             if (p_dist2 > (float) (t->aggro_radius * t->aggro_radius * 64))
             {
                 e->alive = 0;
+                rogue_combat_clear_enemy_status(e, i);
                 g_app.enemy_count--;
                 if (g_app.per_type_counts[e->type_index] > 0)
                     g_app.per_type_counts[e->type_index]--;
@@ -100,6 +102,7 @@ void rogue_enemy_ai_update(float dt_ms)
             {
                 move_speed *= prof->move_speed_mult;
             }
+            move_speed *= rogue_combat_enemy_move_scale(i); /* Phase 14: chill slow */
             /* Behavior Tree Feature Flag: if enabled movement already driven by scheduler tick */
             if (!(e->ai_bt_enabled && e->ai_tree))
             {
@@ -374,10 +377,18 @@ void rogue_enemy_ai_update(float dt_ms)
                             /* FX: loot drop cue keyed by rarity (0..4). Mapping key scheme:
                                "loot/<rarity>/drop". Position uses item spawn position. */
                             {
+                                static RogueFxId drop_keys[8];
                                 int rr = rar[di] >= 0 ? rar[di] : 0;
-                                char key[32];
-                                snprintf(key, sizeof key, "loot/%d/drop", rr);
-                                rogue_fx_trigger_event(key, jx, jy);
+                                RogueFxId drop_id = rr < 8 ? drop_keys[rr] : ROGUE_FX_ID_NONE;
+                                if (drop_id == ROGUE_FX_ID_NONE)
+                                {
+                                    char key[32];
+                                    snprintf(key, sizeof key, "loot/%d/drop", rr);
+                                    drop_id = rogue_fx_intern(key);
+                                    if (rr < 8)
+                                        drop_keys[rr] = drop_id;
+                                }
+                                rogue_fx_trigger_event_id(drop_id, jx, jy);
                             }
                         }
                     }
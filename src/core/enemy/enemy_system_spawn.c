@@ -1,3 +1,4 @@
+#include "../../game/combat.h"
 #include "../../world/tilemap.h"
 #include "enemy_system_internal.h"
 #include <math.h>
@@ -110,6 +111,7 @@ void rogue_enemy_spawn_update(float dt_ms)
                                     ne->max_health = 1;
                                 ne->health = ne->max_health;
                                 ne->alive = 1;
+                                rogue_combat_clear_enemy_status(ne, slot);
                                 ne->hurt_timer = 0;
                                 ne->anim_time = 0;
                                 ne->anim_frame = 0;
@@ -184,6 +186,7 @@ void rogue_enemy_spawn_update(float dt_ms)
                         ne->max_health = 1;
                     ne->health = ne->max_health;
                     ne->alive = 1;
+                    rogue_combat_clear_enemy_status(ne, slot);
                     ne->hurt_timer = 0;
                     ne->anim_time = 0;
                     ne->anim_frame = 0;
@@ -128,7 +128,7 @@ int rogue_equip_try(enum RogueEquipSlot slot, int inst_index)
     RogueItemInstance* mut = (RogueItemInstance*) it;
     mut->equip_hash_chain = equip_mix64(mut->equip_hash_chain, ((unsigned long long) slot << 56) ^
                                                                    mut->guid ^ 0xE11AFBULL);
-    rogue_stat_cache_mark_dirty();
+    rogue_stat_cache_mark_equipment_slot_dirty((int) slot);
     /* Immediate stat recompute so synchronous tests / UI observe updated totals */
     extern RoguePlayer g_exposed_player_for_stats; /* declared in app_state.h */
     rogue_equipment_apply_stat_bonuses(&g_exposed_player_for_stats);
@@ -150,7 +150,7 @@ int rogue_equip_unequip(enum RogueEquipSlot slot)
             mut->equip_hash_chain = equip_mix64(
                 mut->equip_hash_chain, ((unsigned long long) slot << 56) ^ mut->guid ^ 0x51CED9ULL);
         }
-        rogue_stat_cache_mark_dirty();
+        rogue_stat_cache_mark_equipment_slot_dirty((int) slot);
         extern RoguePlayer g_exposed_player_for_stats;
         rogue_equipment_apply_stat_bonuses(&g_exposed_player_for_stats);
     }
@@ -91,7 +91,7 @@ void rogue_budget_analyzer_run(RogueBudgetReport* out)
 {
     RogueBudgetReport r;
     memset(&r, 0, sizeof(r));
-    int count_cap = ROGUE_ITEM_INSTANCE_CAP; /* iterate full pool; use active instances */
+    int count_cap = rogue_items_capacity(); /* iterate full pool; use active instances */
     for (int i = 0; i < count_cap; i++)
     {
         const RogueItemInstance* inst = rogue_item_instance_at(i);
@@ -0,0 +1,175 @@
+#include "equipment_contrib.h"
+#include "../loot/loot_affixes.h"
+#include "../loot/loot_instances.h"
+#include "../loot/loot_item_defs.h"
+#include "equipment.h"
+#include "equipment_content.h"
+#include "equipment_gems.h"
+#include "equipment_uniques.h"
+#include <string.h>
+
+/* Placeholder: determine runeword pattern for an item instance (Phase 4.5).
+    For now, reuse item id as pattern key. */
+static const RogueRuneword* item_runeword(const RogueItemDef* d)
+{
+    return rogue_runeword_find(d ? d->id : NULL);
+}
+
+static void add_affix(int* v, int affix_index, int value)
+{
+    if (affix_index < 0)
+        return;
+    const RogueAffixDef* a = rogue_affix_at(affix_index);
+    if (!a)
+        return;
+    int field = -1;
+    switch (a->stat)
+    {
+    case ROGUE_AFFIX_STAT_STRENGTH_FLAT:
+        field = ROGUE_EQUIP_CONTRIB_AFFIX + 0;
+        break;
+    case ROGUE_AFFIX_STAT_DEXTERITY_FLAT:
+    case ROGUE_AFFIX_STAT_AGILITY_FLAT: /* legacy */
+        field = ROGUE_EQUIP_CONTRIB_AFFIX + 1;
+        break;
+    case ROGUE_AFFIX_STAT_VITALITY_FLAT:
+        field = ROGUE_EQUIP_CONTRIB_AFFIX + 2;
+        break;
+    case ROGUE_AFFIX_STAT_INTELLIGENCE_FLAT:
+        field = ROGUE_EQUIP_CONTRIB_AFFIX + 3;
+        break;
+    case ROGUE_AFFIX_STAT_ARMOR_FLAT:
+        field = ROGUE_EQUIP_CONTRIB_ARMOR_FLAT;
+        break;
+    case ROGUE_AFFIX_STAT_RESIST_PHYSICAL:
+        field = ROGUE_EQUIP_CONTRIB_RESIST + 0;
+        break;
+    case ROGUE_AFFIX_STAT_RESIST_FIRE:
+        field = ROGUE_EQUIP_CONTRIB_RESIST + 1;
+        break;
+    case ROGUE_AFFIX_STAT_RESIST_COLD:
+        field = ROGUE_EQUIP_CONTRIB_RESIST + 2;
+        break;
+    case ROGUE_AFFIX_STAT_RESIST_LIGHTNING:
+        field = ROGUE_EQUIP_CONTRIB_RESIST + 3;
+        break;
+    case ROGUE_AFFIX_STAT_RESIST_POISON:
+        field = ROGUE_EQUIP_CONTRIB_RESIST + 4;
+        break;
+    case ROGUE_AFFIX_STAT_RESIST_STATUS:
+        field = ROGUE_EQUIP_CONTRIB_RESIST + 5;
+        break;
+    case ROGUE_AFFIX_STAT_BLOCK_CHANCE:
+        field = ROGUE_EQUIP_CONTRIB_BLOCK_CHANCE;
+        break; /* Phase 7 */
+    case ROGUE_AFFIX_STAT_BLOCK_VALUE:
+        field = ROGUE_EQUIP_CONTRIB_BLOCK_VALUE;
+        break; /* Phase 7 */
+    case ROGUE_AFFIX_STAT_PHYS_CONV_FIRE_PCT:
+        field = ROGUE_EQUIP_CONTRIB_PHYS_CONV_FIRE;
+        break; /* 7.2 */
+    case ROGUE_AFFIX_STAT_PHYS_CONV_FROST_PCT:
+        field = ROGUE_EQUIP_CONTRIB_PHYS_CONV_FROST;
+        break; /* 7.2 */
+    case ROGUE_AFFIX_STAT_PHYS_CONV_ARCANE_PCT:
+        field = ROGUE_EQUIP_CONTRIB_PHYS_CONV_ARCANE;
+        break; /* 7.2 */
+    case ROGUE_AFFIX_STAT_GUARD_RECOVERY_PCT:
+        field = ROGUE_EQUIP_CONTRIB_GUARD_RECOVERY;
+        break; /* 7.3 */
+    case ROGUE_AFFIX_STAT_THORNS_PERCENT:
+        field = ROGUE_EQUIP_CONTRIB_THORNS_PERCENT;
+        break; /* 7.5 */
+    case ROGUE_AFFIX_STAT_THORNS_CAP:
+        field = ROGUE_EQUIP_CONTRIB_THORNS_CAP;
+        break; /* 7.5 */
+    default:
+        break;
+    }
+    if (field >= 0)
+        v[field] += value;
+}
+
+/* Adds one source's primary stats, flat armor and resists (physical first) to the given layer. */
+static void add_source(int* v, int layer, int str, int dex, int vit, int intel, int armor,
+                       int r_phys, int r_fire, int r_cold, int r_light, int r_poison, int r_status)
+{
+    v[layer + 0] += str;
+    v[layer + 1] += dex;
+    v[layer + 2] += vit;
+    v[layer + 3] += intel;
+    v[ROGUE_EQUIP_CONTRIB_ARMOR_FLAT] += armor;
+    v[ROGUE_EQUIP_CONTRIB_RESIST + 0] += r_phys;
+    v[ROGUE_EQUIP_CONTRIB_RESIST + 1] += r_fire;
+    v[ROGUE_EQUIP_CONTRIB_RESIST + 2] += r_cold;
+    v[ROGUE_EQUIP_CONTRIB_RESIST + 3] += r_light;
+    v[ROGUE_EQUIP_CONTRIB_RESIST + 4] += r_poison;
+    v[ROGUE_EQUIP_CONTRIB_RESIST + 5] += r_status;
+}
+
+int rogue_equip_contrib_gather(int inst_index, int* v, int* set_id)
+{
+    memset(v, 0, sizeof(int) * ROGUE_EQUIP_CONTRIB_ITEM_FIELDS);
+    *set_id = 0;
+    const RogueItemInstance* it = inst_index >= 0 ? rogue_item_instance_at(inst_index) : NULL;
+    if (!it)
+        return 0;
+    RogueGemDef gems; /* flat gem stats fold into the affix layer */
+    memset(&gems, 0, sizeof gems);
+    rogue_gems_sum_instance(inst_index, &gems);
+    add_source(v, ROGUE_EQUIP_CONTRIB_AFFIX, gems.strength, gems.dexterity, gems.vitality,
+               gems.intelligence, gems.armor_flat, gems.resist_physical, gems.resist_fire,
+               gems.resist_cold, gems.resist_lightning, gems.resist_poison, gems.resist_status);
+    v[ROGUE_EQUIP_CONTRIB_GEM_PCT + 0] += gems.pct_strength;
+    v[ROGUE_EQUIP_CONTRIB_GEM_PCT + 1] += gems.pct_dexterity;
+    v[ROGUE_EQUIP_CONTRIB_GEM_PCT + 2] += gems.pct_vitality;
+    v[ROGUE_EQUIP_CONTRIB_GEM_PCT + 3] += gems.pct_intelligence;
+    add_affix(v, it->prefix_index, it->prefix_value);
+    add_affix(v, it->suffix_index, it->suffix_value);
+    const RogueItemDef* d = rogue_item_def_at(it->def_index);
+    if (!d)
+        return 0;
+    *set_id = d->set_id;
+    add_source(v, ROGUE_EQUIP_CONTRIB_IMPLICIT, d->implicit_strength, d->implicit_dexterity,
+               d->implicit_vitality, d->implicit_intelligence, d->implicit_armor_flat,
+               d->implicit_resist_physical, d->implicit_resist_fire, d->implicit_resist_cold,
+               d->implicit_resist_lightning, d->implicit_resist_poison, d->implicit_resist_status);
+    int uidx = rogue_unique_find_by_base_def(it->def_index);
+    const RogueUniqueDef* u = uidx >= 0 ? rogue_unique_at(uidx) : NULL;
+    if (u)
+        add_source(v, ROGUE_EQUIP_CONTRIB_UNIQUE, u->strength, u->dexterity, u->vitality,
+                   u->intelligence, u->armor_flat, u->resist_physical, u->resist_fire,
+                   u->resist_cold, u->resist_lightning, u->resist_poison, u->resist_status);
+    const RogueRuneword* rw = item_runeword(d);
+    if (rw)
+        add_source(v, ROGUE_EQUIP_CONTRIB_RUNEWORD, rw->strength, rw->dexterity, rw->vitality,
+                   rw->intelligence, rw->armor_flat, rw->resist_physical, rw->resist_fire,
+                   rw->resist_cold, rw->resist_light, rw->resist_poison, rw->resist_status);
+    return 1;
+}
+
+/* Counts equipped items per distinct set id, then applies any bonuses whose threshold <= count,
+ * interpolating linearly between thresholds (rogue_set_preview_apply). */
+void rogue_equip_contrib_set_layer(const int* slot_set, int* v)
+{
+    int str = 0, dex = 0, vit = 0, intel = 0, armor = 0;
+    int r_phys = 0, r_fire = 0, r_cold = 0, r_light = 0, r_poison = 0, r_status = 0;
+    memset(v, 0, sizeof(int) * ROGUE_EQUIP_CONTRIB__COUNT);
+    for (int s = 0; s < ROGUE_EQUIP__COUNT; ++s)
+    {
+        int id = slot_set[s];
+        if (id < 0)
+            continue;
+        int seen = 0, have = 0;
+        for (int t = 0; t < s && !seen; ++t)
+            seen = slot_set[t] == id;
+        if (seen)
+            continue;
+        for (int t = s; t < ROGUE_EQUIP__COUNT; ++t)
+            have += slot_set[t] == id;
+        rogue_set_preview_apply(id, have, &str, &dex, &vit, &intel, &armor, &r_fire, &r_cold,
+                                &r_light, &r_poison, &r_status, &r_phys);
+    }
+    add_source(v, ROGUE_EQUIP_CONTRIB_SET, str, dex, vit, intel, armor, r_phys, r_fire, r_cold,
+               r_light, r_poison, r_status);
+}
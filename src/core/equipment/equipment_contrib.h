@@ -0,0 +1,42 @@
+/* Per-item equipment contributions shared by the live stat aggregation (equipment_stats.c) and
+ * the side-effect-free loadout evaluator (util/loadout_eval.c). Both sum the same field layout
+ * filled by the same gather routine, so an item scores exactly what it adds once equipped. */
+#ifndef ROGUE_EQUIPMENT_CONTRIB_H
+#define ROGUE_EQUIPMENT_CONTRIB_H
+
+enum RogueEquipContribField
+{
+    /* primary stats are stored str, dex, vit, int from each layer's base index */
+    ROGUE_EQUIP_CONTRIB_IMPLICIT = 0,
+    ROGUE_EQUIP_CONTRIB_UNIQUE = 4,
+    ROGUE_EQUIP_CONTRIB_RUNEWORD = 8,
+    ROGUE_EQUIP_CONTRIB_AFFIX = 12,   /* item affixes plus flat gem stats */
+    ROGUE_EQUIP_CONTRIB_GEM_PCT = 16, /* percent gem bonuses, converted against the base layer */
+    ROGUE_EQUIP_CONTRIB_ARMOR_FLAT = 20,
+    ROGUE_EQUIP_CONTRIB_RESIST = 21, /* physical, fire, cold, lightning, poison, status */
+    ROGUE_EQUIP_CONTRIB_BLOCK_CHANCE = 27,
+    ROGUE_EQUIP_CONTRIB_BLOCK_VALUE,
+    ROGUE_EQUIP_CONTRIB_PHYS_CONV_FIRE,
+    ROGUE_EQUIP_CONTRIB_PHYS_CONV_FROST,
+    ROGUE_EQUIP_CONTRIB_PHYS_CONV_ARCANE,
+    ROGUE_EQUIP_CONTRIB_GUARD_RECOVERY,
+    ROGUE_EQUIP_CONTRIB_THORNS_PERCENT,
+    ROGUE_EQUIP_CONTRIB_THORNS_CAP,
+    ROGUE_EQUIP_CONTRIB_ITEM_FIELDS, /* fields a single item fills */
+    /* set layer primaries (whole loadout only; flat armor and resists reuse the fields above) */
+    ROGUE_EQUIP_CONTRIB_SET = ROGUE_EQUIP_CONTRIB_ITEM_FIELDS,
+    ROGUE_EQUIP_CONTRIB__COUNT = ROGUE_EQUIP_CONTRIB_SET + 4
+};
+
+/* Clears v[0..ROGUE_EQUIP_CONTRIB_ITEM_FIELDS) and adds every layer instance inst_index feeds:
+ * affixes, socketed gems (Phase 5.2), implicits (4.1), unique fixed bonuses (4.2) and runewords
+ * (4.5). Returns 1 and stores the definition's set id in *set_id when the instance resolves to an
+ * item definition (it then counts toward set bonuses); returns 0 with *set_id = 0 otherwise. */
+int rogue_equip_contrib_gather(int inst_index, int* v, int* set_id);
+
+/* Set layer (Phase 4.3/4.4) for per-slot set ids (ROGUE_EQUIP__COUNT entries, -1 = slot does not
+ * count): clears v[0..ROGUE_EQUIP_CONTRIB__COUNT) and fills the set primaries, flat armor and
+ * resists. */
+void rogue_equip_contrib_set_layer(const int* slot_set, int* v);
+
+#endif
@@ -1,5 +1,4 @@
 #include "equipment_gems.h"
-#include "../../game/stat_cache.h"
 #include "../inventory/inventory.h"
 #include "../loot/loot_instances.h"
 #include "../loot/loot_item_defs.h"
@@ -174,64 +173,35 @@ int rogue_gem_defs_load_from_cfg(const char* path)
     return added;
 }
 
-/* Aggregation helper (called from equipment_stats) */
-void rogue_gems_aggregate_equipped(void)
+/* Aggregation helper (called from equipment_stats once per changed slot) */
+void rogue_gems_sum_instance(int inst_index, RogueGemDef* sum)
 {
-    int str = 0, dex = 0, vit = 0, intel = 0, armor = 0;
-    int r_phys = 0, r_fire = 0, r_cold = 0, r_light = 0, r_poison = 0, r_status = 0;
-    int pct_str = 0, pct_dex = 0, pct_vit = 0, pct_int = 0;
-    for (int slot = 0; slot < ROGUE_EQUIP__COUNT; ++slot)
+    if (!sum || inst_index < 0)
+        return;
+    int sc = rogue_item_instance_socket_count(inst_index);
+    for (int s = 0; s < sc; s++)
     {
-        int inst = rogue_equip_get((enum RogueEquipSlot) slot);
-        if (inst < 0)
+        int gem_item_def = rogue_item_instance_get_socket(inst_index, s);
+        if (gem_item_def < 0)
             continue;
-        int sc = rogue_item_instance_socket_count(inst);
-        if (sc <= 0)
+        int gidx = rogue_gem_find_by_item_def(gem_item_def);
+        if (gidx < 0)
             continue;
-        for (int s = 0; s < sc; s++)
-        {
-            int gem_item_def = rogue_item_instance_get_socket(inst, s);
-            if (gem_item_def < 0)
-                continue;
-            int gidx = rogue_gem_find_by_item_def(gem_item_def);
-            if (gidx < 0)
-                continue;
-            const RogueGemDef* g = rogue_gem_at(gidx);
-            str += g->strength;
-            dex += g->dexterity;
-            vit += g->vitality;
-            intel += g->intelligence;
-            armor += g->armor_flat;
-            r_phys += g->resist_physical;
-            r_fire += g->resist_fire;
-            r_cold += g->resist_cold;
-            r_light += g->resist_lightning;
-            r_poison += g->resist_poison;
-            r_status += g->resist_status;
-            pct_str += g->pct_strength;
-            pct_dex += g->pct_dexterity;
-            pct_vit += g->pct_vitality;
-            pct_int += g->pct_intelligence;
-        }
+        const RogueGemDef* g = rogue_gem_at(gidx);
+        sum->strength += g->strength;
+        sum->dexterity += g->dexterity;
+        sum->vitality += g->vitality;
+        sum->intelligence += g->intelligence;
+        sum->armor_flat += g->armor_flat;
+        sum->resist_physical += g->resist_physical;
+        sum->resist_fire += g->resist_fire;
+        sum->resist_cold += g->resist_cold;
+        sum->resist_lightning += g->resist_lightning;
+        sum->resist_poison += g->resist_poison;
+        sum->resist_status += g->resist_status;
+        sum->pct_strength += g->pct_strength;
+        sum->pct_dexterity += g->pct_dexterity;
+        sum->pct_vitality += g->pct_vitality;
+        sum->pct_intelligence += g->pct_intelligence;
     }
-    g_player_stat_cache.affix_strength += str;
-    g_player_stat_cache.affix_dexterity += dex;
-    g_player_stat_cache.affix_vitality += vit;
-    g_player_stat_cache.affix_intelligence += intel;
-    g_player_stat_cache.affix_armor_flat += armor;
-    g_player_stat_cache.resist_physical += r_phys;
-    g_player_stat_cache.resist_fire += r_fire;
-    g_player_stat_cache.resist_cold += r_cold;
-    g_player_stat_cache.resist_lightning += r_light;
-    g_player_stat_cache.resist_poison += r_poison;
-    g_player_stat_cache.resist_status += r_status; /* Percent bonuses (approx flat conversion) */
-    if (pct_str > 0)
-        g_player_stat_cache.affix_strength += (g_player_stat_cache.base_strength * pct_str) / 100;
-    if (pct_dex > 0)
-        g_player_stat_cache.affix_dexterity += (g_player_stat_cache.base_dexterity * pct_dex) / 100;
-    if (pct_vit > 0)
-        g_player_stat_cache.affix_vitality += (g_player_stat_cache.base_vitality * pct_vit) / 100;
-    if (pct_int > 0)
-        g_player_stat_cache.affix_intelligence +=
-            (g_player_stat_cache.base_intelligence * pct_int) / 100;
 }
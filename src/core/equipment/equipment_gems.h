@@ -39,7 +39,9 @@ int rogue_item_instance_socket_insert_pay(int inst_index, int slot, int gem_def_
                                           int* out_cost);
 int rogue_item_instance_socket_remove_refund(int inst_index, int slot, int return_to_inventory);
 
-/* Aggregation hook (invoked inside equipment_stats) */
-void rogue_gems_aggregate_equipped(void);
+/* Aggregation hook (invoked inside equipment_stats per equipped slot): adds the flat and percent
+ * stat fields of every gem socketed in inst_index into sum. Percent bonuses are converted against
+ * the base layer by the caller. */
+void rogue_gems_sum_instance(int inst_index, RogueGemDef* sum);
 
 #endif
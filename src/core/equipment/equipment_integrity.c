@@ -21,6 +21,7 @@
 #include "equipment.h"
 #include "equipment_procs.h"
 
+#include <stdlib.h>
 #include <string.h>
 
 /* ---------------- Proc Rate Auditor (15.4) ---------------- */
@@ -226,7 +227,7 @@ unsigned long long rogue_integrity_expected_item_equip_hash(int inst_index)
 int rogue_integrity_scan_equip_chain_mismatches(RogueItemChainMismatch* out, int max_out)
 {
     int written = 0;
-    for (int i = 0; i < ROGUE_ITEM_INSTANCE_CAP; i++)
+    for (int i = 0, n = rogue_items_capacity(); i < n; i++)
     {
         const RogueItemInstance* it = rogue_item_instance_at(i);
         if (!it)
@@ -246,6 +247,24 @@ int rogue_integrity_scan_equip_chain_mismatches(RogueItemChainMismatch* out, int
     return written;
 }
 
+/* (GUID, index) pair for the duplicate scan; sorts by GUID, then by slot. */
+typedef struct GuidEntry
+{
+    unsigned long long guid;
+    int index;
+} GuidEntry;
+
+static int guid_entry_cmp(const void* pa, const void* pb)
+{
+    const GuidEntry* a = (const GuidEntry*) pa;
+    const GuidEntry* b = (const GuidEntry*) pb;
+    if (a->guid != b->guid)
+        return a->guid < b->guid ? -1 : 1;
+    return a->index - b->index;
+}
+
+static int int_cmp(const void* pa, const void* pb) { return *(const int*) pa - *(const int*) pb; }
+
 /**
  * @brief Scan for duplicate item GUIDs
  *
@@ -257,40 +276,52 @@ int rogue_integrity_scan_equip_chain_mismatches(RogueItemChainMismatch* out, int
  * @param max_out Maximum number of duplicates to report
  * @return int Number of items with duplicate GUIDs detected
  *
- * @note Uses O(n²) algorithm due to small instance capacity
+ * @note Sorts (GUID, index) pairs, O(n log n) in the number of live items
  * @note Set max_out to 0 to count duplicates without storing details
- * @note Only reports the first occurrence of each duplicate GUID
+ * @note Only reports later occurrences of a GUID (the lowest index is the original), in
+ *       ascending index order
  * @note Invalid item instances are skipped during scanning
+ * @note Returns -1 if the scratch buffer cannot be allocated
  */
 int rogue_integrity_scan_duplicate_guids(int* out, int max_out)
 {
-    unsigned long long seen[ROGUE_ITEM_INSTANCE_CAP];
-    int seen_count = 0;
-    int dup_written = 0;
-    for (int i = 0; i < ROGUE_ITEM_INSTANCE_CAP; i++)
+    int cap = rogue_items_capacity();
+    if (cap <= 0)
+        return 0;
+    GuidEntry* entries = (GuidEntry*) malloc(sizeof(GuidEntry) * (size_t) cap);
+    if (!entries)
+        return -1;
+    int count = 0;
+    for (int i = 0; i < cap; i++)
     {
         const RogueItemInstance* it = rogue_item_instance_at(i);
         if (!it)
             continue;
-        int duplicate = 0;
-        for (int j = 0; j < seen_count; j++)
-        {
-            if (seen[j] == it->guid)
-            {
-                duplicate = 1;
-                break;
-            }
-        }
-        if (duplicate)
-        {
-            if (out && dup_written < max_out)
-                out[dup_written] = i;
-            dup_written++;
-        }
-        else
+        entries[count].guid = it->guid;
+        entries[count].index = i;
+        count++;
+    }
+    qsort(entries, (size_t) count, sizeof(GuidEntry), guid_entry_cmp);
+    /* reuse the index field as the output list: duplicates are compacted to the front */
+    int dup_written = 0;
+    for (int i = 1; i < count; i++)
+        if (entries[i].guid == entries[i - 1].guid)
+            entries[dup_written++].index = entries[i].index;
+    if (out && max_out > 0)
+    {
+        int* dups = (int*) malloc(sizeof(int) * (size_t) (dup_written > 0 ? dup_written : 1));
+        if (!dups)
         {
-            seen[seen_count++] = it->guid;
+            free(entries);
+            return -1;
         }
+        for (int i = 0; i < dup_written; i++)
+            dups[i] = entries[i].index;
+        qsort(dups, (size_t) dup_written, sizeof(int), int_cmp);
+        for (int i = 0; i < dup_written && i < max_out; i++)
+            out[i] = dups[i];
+        free(dups);
     }
+    free(entries);
     return dup_written;
 }
@@ -10,21 +10,21 @@
  * This module implements several optimization techniques:
  * - SoA Buffers: Struct-of-Arrays storage for better cache locality
  * - Linear Arena: Single-frame temporary memory allocation
- * - Profiler: Minimal performance monitoring with string-based zones
+ * - Profiler: Per-zone totals on top of the unified profiler (util/profiler.h)
  * - SIMD-like Aggregation: Batched processing for improved throughput
  *
  * @note All optimizations focus on cache efficiency and reduced memory access patterns
- * @note Profiler uses string hashing for zone identification
+ * @note Profiler zones share ids, clock and trace output with the unified profiler
  * @note Arena allocator is single-frame (reset each frame)
  */
 
 #include "equipment_perf.h"
 #include "../loot/loot_instances.h"
 #include "../loot/loot_item_defs.h"
+#include "../../util/profiler.h"
 #include "equipment.h"
 #include <stdio.h>
 #include <string.h>
-#include <time.h>
 
 /* ---- Struct-of-Arrays (SoA) Buffers ---- */
 
@@ -183,24 +183,22 @@ size_t rogue_equip_frame_capacity(void) { return EQUIP_FRAME_ARENA_CAP; }
 
 /* ---- Minimal Profiler ---- */
 
-/** @brief Maximum number of profiling zones */
-#define PROF_ZONE_CAP 16
-
 /**
  * @brief Profiling zone data structure
+ *
+ * Indexed by unified profiler zone id (util/profiler.h), so names are resolved once through the
+ * shared registry and the id-based entry points never compare strings.
  */
 typedef struct
 {
-    char name[24];      /**< Zone name (null-terminated) */
-    double total_ms;    /**< Total time spent in zone */
-    int count;          /**< Number of times zone was executed */
-    int used;           /**< Whether this zone slot is in use */
-    clock_t begin_clock; /**< Clock value when zone began */
-    int active;         /**< Whether zone is currently active */
+    double total_ms;   /**< Total time spent in zone */
+    int count;         /**< Number of times zone was executed */
+    uint64_t begin_ns; /**< Monotonic timestamp when zone began */
+    int active;        /**< Whether zone is currently active */
 } Zone;
 
-/** @brief Global array of profiling zones */
-static Zone g_zones[PROF_ZONE_CAP];
+/** @brief Equipment profiler zones, indexed by unified profiler zone id */
+static Zone g_zones[ROGUE_PROF_MAX_ZONES];
 
 /**
  * @brief Reset all profiling data
@@ -211,88 +209,74 @@ static Zone g_zones[PROF_ZONE_CAP];
 void rogue_equip_profiler_reset(void) { memset(g_zones, 0, sizeof g_zones); }
 
 /**
- * @brief Find or create a profiling zone
+ * @brief Resolve a zone name to its unified profiler id
  *
- * Locates an existing profiling zone by name, or creates a new one
- * if it doesn't exist and space is available.
+ * @param name Zone name identifier
+ * @return int Zone id, or -1 if the registry is full
+ */
+int rogue_equip_profiler_zone_id(const char* name) { return rogue_prof_zone_register(name); }
+
+/**
+ * @brief Begin profiling a code zone by id
+ *
+ * Starts timing a code section on the unified profiler clock and opens the matching trace scope.
+ * Nested calls to the same zone are ignored.
  *
- * @param name Zone name (up to 23 characters)
- * @return Zone* Pointer to zone structure, or NULL if not found and no space available
+ * @param zone Zone id from rogue_equip_profiler_zone_id / rogue_prof_zone_slot
  *
- * @note Uses linear search for zone lookup
- * @note Zone names are truncated to fit in 23 characters
  * @note Thread-unsafe - should not be called concurrently
+ * @note Nested begin calls are ignored (no re-entrant timing)
  */
-static Zone* find_zone(const char* name)
+void rogue_equip_profiler_begin_id(int zone)
 {
-    int free_idx = -1;
-    for (int i = 0; i < PROF_ZONE_CAP; i++)
-    {
-        if (g_zones[i].used)
-        {
-            if (strncmp(g_zones[i].name, name, sizeof g_zones[i].name) == 0)
-                return &g_zones[i];
-        }
-        else if (free_idx < 0)
-            free_idx = i;
-    }
-    if (free_idx >= 0)
-    {
-        Zone* z = &g_zones[free_idx];
-        z->used = 1; /* safe copy */
-        size_t len = strlen(name);
-        if (len >= sizeof z->name)
-            len = sizeof z->name - 1;
-        memcpy(z->name, name, len);
-        z->name[len] = '\0';
-        return z;
-    }
-    return NULL;
+    if (zone < 0 || zone >= ROGUE_PROF_MAX_ZONES || g_zones[zone].active)
+        return;
+    g_zones[zone].begin_ns = rogue_prof_now_ns();
+    g_zones[zone].active = 1;
+    rogue_prof_begin(zone);
+}
+
+/**
+ * @brief End profiling a code zone by id
+ *
+ * Stops timing the zone, accumulates the elapsed time and closes the trace scope.
+ * Mismatched end calls are ignored.
+ *
+ * @param zone Zone id (must match begin call)
+ */
+void rogue_equip_profiler_end_id(int zone)
+{
+    if (zone < 0 || zone >= ROGUE_PROF_MAX_ZONES || !g_zones[zone].active)
+        return;
+    rogue_prof_end(zone);
+    Zone* z = &g_zones[zone];
+    z->total_ms += (double) (rogue_prof_now_ns() - z->begin_ns) / 1e6;
+    z->count++;
+    z->active = 0;
 }
 
 /**
  * @brief Begin profiling a code zone
  *
- * Starts timing a code section. If the zone doesn't exist, it will be created.
- * Nested calls to the same zone are ignored.
+ * Name-based wrapper over rogue_equip_profiler_begin_id (registers the zone on first use).
  *
  * @param name Zone name identifier
- *
- * @note Uses system clock() function for timing
- * @note Thread-unsafe - should not be called concurrently
- * @note Nested begin calls are ignored (no re-entrant timing)
  */
 void rogue_equip_profiler_zone_begin(const char* name)
 {
-    Zone* z = find_zone(name);
-    if (!z || z->active)
-        return;
-    z->begin_clock = clock();
-    z->active = 1;
+    rogue_equip_profiler_begin_id(rogue_equip_profiler_zone_id(name));
 }
 
 /**
  * @brief End profiling a code zone
  *
- * Stops timing the specified code zone and accumulates the elapsed time.
- * Must be paired with a corresponding zone_begin call.
+ * Name-based wrapper over rogue_equip_profiler_end_id.
  *
  * @param name Zone name identifier (must match begin call)
- *
- * @note Calculates elapsed time in milliseconds
- * @note Accumulates total time and execution count
- * @note Mismatched begin/end calls are ignored
  */
 void rogue_equip_profiler_zone_end(const char* name)
 {
-    Zone* z = find_zone(name);
-    if (!z || !z->active)
-        return;
-    clock_t end = clock();
-    double ms = 1000.0 * (double) (end - z->begin_clock) / (double) CLOCKS_PER_SEC;
-    z->total_ms += ms;
-    z->count++;
-    z->active = 0;
+    rogue_equip_profiler_end_id(rogue_equip_profiler_zone_id(name));
 }
 
 /**
@@ -310,13 +294,13 @@ void rogue_equip_profiler_zone_end(const char* name)
  */
 int rogue_equip_profiler_zone_stats(const char* name, double* total_ms, int* count)
 {
-    Zone* z = find_zone(name);
-    if (!z || z->count == 0)
+    int zone = rogue_equip_profiler_zone_id(name);
+    if (zone < 0 || g_zones[zone].count == 0)
         return -1;
     if (total_ms)
-        *total_ms = z->total_ms;
+        *total_ms = g_zones[zone].total_ms;
     if (count)
-        *count = z->count;
+        *count = g_zones[zone].count;
     return 0;
 }
 
@@ -344,13 +328,13 @@ int rogue_equip_profiler_dump(char* buf, int cap)
     if (n < 0 || n >= cap - off)
         return -1;
     off += n;
-    for (int i = 0; i < PROF_ZONE_CAP; i++)
+    for (int i = 0; i < ROGUE_PROF_MAX_ZONES; i++)
     {
         Zone* z = &g_zones[i];
-        if (!z->used || z->count == 0)
+        if (z->count == 0)
             continue;
-        n = snprintf(buf + off, cap - off, "\"%s\":{\"ms\":%.3f,\"count\":%d},", z->name,
-                     z->total_ms, z->count);
+        n = snprintf(buf + off, cap - off, "\"%s\":{\"ms\":%.3f,\"count\":%d},",
+                     rogue_prof_zone_name(i), z->total_ms, z->count);
         if (n < 0 || n >= cap - off)
             return -1;
         off += n;
@@ -532,10 +516,14 @@ static void aggregate_simd_like(void)
  */
 void rogue_equipment_aggregate(enum RogueEquipAggregateMode mode)
 {
-    rogue_equip_profiler_zone_begin(mode == ROGUE_EQUIP_AGGREGATE_SIMD ? "agg_simd" : "agg_scalar");
+    static RogueProfZoneSlot simd_slot, scalar_slot;
+    int zone = mode == ROGUE_EQUIP_AGGREGATE_SIMD
+                   ? rogue_prof_zone_slot(&simd_slot, "agg_simd")
+                   : rogue_prof_zone_slot(&scalar_slot, "agg_scalar");
+    rogue_equip_profiler_begin_id(zone);
     if (mode == ROGUE_EQUIP_AGGREGATE_SIMD)
         aggregate_simd_like();
     else
         aggregate_scalar();
-    rogue_equip_profiler_zone_end(mode == ROGUE_EQUIP_AGGREGATE_SIMD ? "agg_simd" : "agg_scalar");
+    rogue_equip_profiler_end_id(zone);
 }
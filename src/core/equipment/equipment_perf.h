@@ -36,8 +36,13 @@ extern "C"
     };
     void rogue_equipment_aggregate(enum RogueEquipAggregateMode mode);
 
-    /* Lightweight profiler zones (micro-profiler). */
+    /* Lightweight profiler zones (micro-profiler). Zones are unified profiler zones
+       (util/profiler.h): timing uses its monotonic clock and each scope also shows up in traces.
+       Hot paths should cache the id (rogue_prof_zone_slot) and use the *_id variants. */
     void rogue_equip_profiler_reset(void);
+    int rogue_equip_profiler_zone_id(const char* name);
+    void rogue_equip_profiler_begin_id(int zone);
+    void rogue_equip_profiler_end_id(int zone);
     void rogue_equip_profiler_zone_begin(const char* name);
     void rogue_equip_profiler_zone_end(const char* name);
     int rogue_equip_profiler_zone_stats(const char* name, double* total_ms,
@@ -1,6 +1,7 @@
 #include "equipment_procs.h"
+#include "../../util/json_tok.h"
 #include <stdio.h>  /* FILE, fopen_s, fseek, ftell, fread, fclose, snprintf */
-#include <stdlib.h> /* malloc, free, strtol */
+#include <stdlib.h> /* malloc, free */
 #include <string.h>
 
 #ifndef ROGUE_PROC_CAP
@@ -107,42 +108,6 @@ int rogue_proc_validate(const RogueProcDef* def)
     return 0;
 }
 
-static const char* ws(const char* s)
-{
-    while (*s && (unsigned char) *s <= 32)
-        ++s;
-    return s;
-}
-static const char* jstring(const char* s, char* out, int cap)
-{
-    s = ws(s);
-    if (*s != '"')
-        return NULL;
-    ++s;
-    int i = 0;
-    while (*s && *s != '"')
-    {
-        if (*s == '\\' && s[1])
-            s++;
-        if (i + 1 < cap)
-            out[i++] = *s;
-        ++s;
-    }
-    if (*s != '"')
-        return NULL;
-    out[i] = '\0';
-    return s + 1;
-}
-static const char* jnumber(const char* s, int* out)
-{
-    s = ws(s);
-    char* end = NULL;
-    long v = strtol(s, &end, 10);
-    if (end == s)
-        return NULL;
-    *out = (int) v;
-    return end;
-}
 static int parse_trigger(const char* str)
 {
     if (strcmp(str, "ON_HIT") == 0)
@@ -200,130 +165,61 @@ int rogue_procs_load_from_json(const char* path)
     size_t rd = fread(buf, 1, (size_t) sz, f);
     buf[rd] = '\0';
     fclose(f);
-    const char* s = ws(buf);
-    if (*s != '[')
+    RogueJsonTokenizer t;
+    RogueJsonToken v, item;
+    RogueJsonView key;
+    rogue_json_tok_init(&t, buf, rd);
+    if (rogue_json_tok_next(&t, &v) != ROGUE_JTOK_ARRAY_BEGIN)
     {
         free(buf);
         return -1;
     }
-    ++s;
-    char key[64];
     int added = 0;
-    while (1)
+    while (rogue_json_tok_element(&t, &item) > 0)
     {
-        s = ws(s);
-        if (*s == ']')
+        if (item.type != ROGUE_JTOK_OBJECT_BEGIN)
         {
-            ++s;
-            break;
+            (void) rogue_json_tok_skip(&t, &item);
+            continue;
         }
-        if (*s != '{')
-            break;
-        ++s;
         RogueProcDef def;
         memset(&def, 0, sizeof def);
-        while (1)
+        char sbuf[32];
+        int r;
+        while ((r = rogue_json_tok_member(&t, &key, &v)) > 0)
         {
-            s = ws(s);
-            if (*s == '}')
-            {
-                ++s;
-                break;
-            }
-            const char* ns = jstring(s, key, sizeof key);
-            if (!ns)
+            if (rogue_json_view_eq(key, "name"))
+                rogue_json_tok_copy(&v, def.name, sizeof def.name);
+            else if (rogue_json_view_eq(key, "trigger"))
             {
-                s++;
-                continue;
+                rogue_json_tok_copy(&v, sbuf, sizeof sbuf);
+                def.trigger = (RogueProcTrigger) parse_trigger(sbuf);
             }
-            s = ws(ns);
-            if (*s != ':')
+            else if (rogue_json_view_eq(key, "stack_rule"))
             {
-                free(buf);
-                return added;
-            }
-            ++s;
-            if (strcmp(key, "name") == 0)
-            {
-                char nbuf[64];
-                const char* adv = jstring(s, nbuf, sizeof nbuf);
-                if (!adv)
-                {
-                    free(buf);
-                    return added;
-                }
-                int ni = 0;
-                while (nbuf[ni] && ni < (int) sizeof(def.name) - 1)
-                {
-                    def.name[ni] = nbuf[ni];
-                    ++ni;
-                }
-                def.name[ni] = '\0';
-                s = adv;
-            }
-            else if (strcmp(key, "trigger") == 0)
-            {
-                char tbuf[32];
-                const char* ts = jstring(s, tbuf, sizeof tbuf);
-                if (!ts)
-                {
-                    free(buf);
-                    return added;
-                }
-                def.trigger = (RogueProcTrigger) parse_trigger(tbuf);
-                s = ts;
-            }
-            else if (strcmp(key, "stack_rule") == 0)
-            {
-                char sbuf[32];
-                const char* ss = jstring(s, sbuf, sizeof sbuf);
-                if (!ss)
-                {
-                    free(buf);
-                    return added;
-                }
+                rogue_json_tok_copy(&v, sbuf, sizeof sbuf);
                 def.stack_rule = (RogueProcStackRule) parse_stack_rule(sbuf);
-                s = ss;
             }
+            else if (rogue_json_view_eq(key, "icd_ms"))
+                rogue_json_tok_int(&v, &def.icd_ms);
+            else if (rogue_json_view_eq(key, "duration_ms"))
+                rogue_json_tok_int(&v, &def.duration_ms);
+            else if (rogue_json_view_eq(key, "magnitude"))
+                rogue_json_tok_int(&v, &def.magnitude);
+            else if (rogue_json_view_eq(key, "max_stacks"))
+                rogue_json_tok_int(&v, &def.max_stacks);
+            else if (rogue_json_view_eq(key, "param"))
+                rogue_json_tok_int(&v, &def.param);
             else
-            {
-                int v;
-                const char* vs = jnumber(s, &v);
-                if (!vs)
-                {
-                    free(buf);
-                    return added;
-                }
-                if (strcmp(key, "icd_ms") == 0)
-                    def.icd_ms = v;
-                else if (strcmp(key, "duration_ms") == 0)
-                    def.duration_ms = v;
-                else if (strcmp(key, "magnitude") == 0)
-                    def.magnitude = v;
-                else if (strcmp(key, "max_stacks") == 0)
-                    def.max_stacks = v;
-                else if (strcmp(key, "param") == 0)
-                    def.param = v;
-                s = vs;
-            }
-            s = ws(s);
-            if (*s == ',')
-            {
-                ++s;
-                continue;
-            }
+                (void) rogue_json_tok_skip(&t, &v);
         }
+        if (r < 0)
+            break; /* malformed: keep what was registered so far */
         if (rogue_proc_validate(&def) == 0)
         {
             if (rogue_proc_register(&def) >= 0)
                 added++;
         }
-        s = ws(s);
-        if (*s == ',')
-        {
-            ++s;
-            continue;
-        }
     }
     free(buf);
     return added;
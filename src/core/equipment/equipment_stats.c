@@ -5,394 +5,172 @@
 #include "../loot/loot_instances.h"
 #include "../loot/loot_item_defs.h"
 #include "equipment.h"
+#include "equipment_contrib.h"
 #include "equipment_content.h" /* Phase 16.2 external set/runeword registries */
 #include "equipment_gems.h"    /* Phase 5.2 gem aggregation */
 #include "equipment_uniques.h"
 #include <stdio.h>
+#include <string.h>
 
-/* Placeholder: determine runeword pattern for an item instance (Phase 4.5).
-    For now, reuse item id as pattern key. */
-static const RogueRuneword* item_runeword(const RogueItemDef* d)
-{
-    return rogue_runeword_find(d ? d->id : NULL);
-}
 /* Phase 4.1: Implicit + set bonus + runeword scaffolding
     For Phase 4.1 we populate only implicits; future sub-phases will extend with unique/set/runeword
    layers. */
 
-/* Collect affix-derived flat bonuses across all equipped items and populate stat cache affix_*
-   fields. This supports Equipment Phase 2.1+ layered aggregation without mutating base player stats
-   directly. */
-static void gather_affix_primary_and_armor(void)
+/* Incremental aggregation: every equipped slot owns a cached contribution (all layers it feeds)
+   keyed by the state of the item in it. A pass re-gathers only slots whose key changed or that were
+   marked dirty, folding the difference into per-layer partial sums; the set layer depends on the
+   whole loadout and is rebuilt from cached set ids only when some slot changed. Steady-state frames
+   (buffs ticking in combat) therefore never walk affixes, uniques, runewords or gems. */
+typedef struct EquipContrib
 {
-    int str = 0, dex = 0, vit = 0, intel = 0, armor = 0;
-    int r_phys = 0, r_fire = 0, r_cold = 0, r_light = 0, r_poison = 0, r_status = 0;
-    int block_chance = 0, block_value = 0;
-    int phys_conv_fire = 0, phys_conv_frost = 0, phys_conv_arc = 0;
-    int guard_recovery = 0;
-    int thorns_pct = 0, thorns_cap = 0;
-    for (int slot = 0; slot < ROGUE_EQUIP__COUNT; ++slot)
-    {
-        int inst_index = rogue_equip_get((enum RogueEquipSlot) slot);
-        if (inst_index < 0)
-            continue;
-        const RogueItemInstance* it = rogue_item_instance_at(inst_index);
-        if (!it)
-            continue;
-        if (it->prefix_index >= 0)
-        {
-            const RogueAffixDef* a = rogue_affix_at(it->prefix_index);
-            if (a)
-            {
-                switch (a->stat)
-                {
-                case ROGUE_AFFIX_STAT_STRENGTH_FLAT:
-                    str += it->prefix_value;
-                    break;
-                case ROGUE_AFFIX_STAT_DEXTERITY_FLAT:
-                    dex += it->prefix_value;
-                    break;
-                case ROGUE_AFFIX_STAT_VITALITY_FLAT:
-                    vit += it->prefix_value;
-                    break;
-                case ROGUE_AFFIX_STAT_INTELLIGENCE_FLAT:
-                    intel += it->prefix_value;
-                    break;
-                case ROGUE_AFFIX_STAT_ARMOR_FLAT:
-                    armor += it->prefix_value;
-                    break;
-                case ROGUE_AFFIX_STAT_AGILITY_FLAT:
-                    dex += it->prefix_value;
-                    break; /* legacy */
-                case ROGUE_AFFIX_STAT_RESIST_PHYSICAL:
-                    r_phys += it->prefix_value;
-                    break;
-                case ROGUE_AFFIX_STAT_RESIST_FIRE:
-                    r_fire += it->prefix_value;
-                    break;
-                case ROGUE_AFFIX_STAT_RESIST_COLD:
-                    r_cold += it->prefix_value;
-                    break;
-                case ROGUE_AFFIX_STAT_RESIST_LIGHTNING:
-                    r_light += it->prefix_value;
-                    break;
-                case ROGUE_AFFIX_STAT_RESIST_POISON:
-                    r_poison += it->prefix_value;
-                    break;
-                case ROGUE_AFFIX_STAT_RESIST_STATUS:
-                    r_status += it->prefix_value;
-                    break;
-                case ROGUE_AFFIX_STAT_BLOCK_CHANCE:
-                    block_chance += it->prefix_value;
-                    break; /* Phase 7 */
-                case ROGUE_AFFIX_STAT_BLOCK_VALUE:
-                    block_value += it->prefix_value;
-                    break; /* Phase 7 */
-                case ROGUE_AFFIX_STAT_PHYS_CONV_FIRE_PCT:
-                    phys_conv_fire += it->prefix_value;
-                    break; /* 7.2 */
-                case ROGUE_AFFIX_STAT_PHYS_CONV_FROST_PCT:
-                    phys_conv_frost += it->prefix_value;
-                    break; /* 7.2 */
-                case ROGUE_AFFIX_STAT_PHYS_CONV_ARCANE_PCT:
-                    phys_conv_arc += it->prefix_value;
-                    break; /* 7.2 */
-                case ROGUE_AFFIX_STAT_GUARD_RECOVERY_PCT:
-                    guard_recovery += it->prefix_value;
-                    break; /* 7.3 */
-                case ROGUE_AFFIX_STAT_THORNS_PERCENT:
-                    thorns_pct += it->prefix_value;
-                    break; /* 7.5 */
-                case ROGUE_AFFIX_STAT_THORNS_CAP:
-                    thorns_cap += it->prefix_value;
-                    break; /* 7.5 */
-                default:
-                    break;
-                }
-            }
-        }
-        if (it->suffix_index >= 0)
-        {
-            const RogueAffixDef* a = rogue_affix_at(it->suffix_index);
-            if (a)
-            {
-                switch (a->stat)
-                {
-                case ROGUE_AFFIX_STAT_STRENGTH_FLAT:
-                    str += it->suffix_value;
-                    break;
-                case ROGUE_AFFIX_STAT_DEXTERITY_FLAT:
-                    dex += it->suffix_value;
-                    break;
-                case ROGUE_AFFIX_STAT_VITALITY_FLAT:
-                    vit += it->suffix_value;
-                    break;
-                case ROGUE_AFFIX_STAT_INTELLIGENCE_FLAT:
-                    intel += it->suffix_value;
-                    break;
-                case ROGUE_AFFIX_STAT_ARMOR_FLAT:
-                    armor += it->suffix_value;
-                    break;
-                case ROGUE_AFFIX_STAT_AGILITY_FLAT:
-                    dex += it->suffix_value;
-                    break; /* legacy */
-                case ROGUE_AFFIX_STAT_RESIST_PHYSICAL:
-                    r_phys += it->suffix_value;
-                    break;
-                case ROGUE_AFFIX_STAT_RESIST_FIRE:
-                    r_fire += it->suffix_value;
-                    break;
-                case ROGUE_AFFIX_STAT_RESIST_COLD:
-                    r_cold += it->suffix_value;
-                    break;
-                case ROGUE_AFFIX_STAT_RESIST_LIGHTNING:
-                    r_light += it->suffix_value;
-                    break;
-                case ROGUE_AFFIX_STAT_RESIST_POISON:
-                    r_poison += it->suffix_value;
-                    break;
-                case ROGUE_AFFIX_STAT_RESIST_STATUS:
-                    r_status += it->suffix_value;
-                    break;
-                case ROGUE_AFFIX_STAT_BLOCK_CHANCE:
-                    block_chance += it->suffix_value;
-                    break; /* Phase 7 */
-                case ROGUE_AFFIX_STAT_BLOCK_VALUE:
-                    block_value += it->suffix_value;
-                    break; /* Phase 7 */
-                case ROGUE_AFFIX_STAT_PHYS_CONV_FIRE_PCT:
-                    phys_conv_fire += it->suffix_value;
-                    break; /* 7.2 */
-                case ROGUE_AFFIX_STAT_PHYS_CONV_FROST_PCT:
-                    phys_conv_frost += it->suffix_value;
-                    break; /* 7.2 */
-                case ROGUE_AFFIX_STAT_PHYS_CONV_ARCANE_PCT:
-                    phys_conv_arc += it->suffix_value;
-                    break; /* 7.2 */
-                case ROGUE_AFFIX_STAT_GUARD_RECOVERY_PCT:
-                    guard_recovery += it->suffix_value;
-                    break; /* 7.3 */
-                case ROGUE_AFFIX_STAT_THORNS_PERCENT:
-                    thorns_pct += it->suffix_value;
-                    break; /* 7.5 */
-                case ROGUE_AFFIX_STAT_THORNS_CAP:
-                    thorns_cap += it->suffix_value;
-                    break; /* 7.5 */
-                default:
-                    break;
-                }
-            }
-        }
-    }
-    g_player_stat_cache.affix_strength = str;
-    g_player_stat_cache.affix_dexterity = dex;
-    g_player_stat_cache.affix_vitality = vit;
-    g_player_stat_cache.affix_intelligence = intel;
-    g_player_stat_cache.affix_armor_flat =
-        armor; /* new extension field (added below if not present) */
-    /* Store raw resistance sums (percentage points). */
-    g_player_stat_cache.resist_physical = r_phys;
-    g_player_stat_cache.resist_fire = r_fire;
-    g_player_stat_cache.resist_cold = r_cold;
-    g_player_stat_cache.resist_lightning = r_light;
-    g_player_stat_cache.resist_poison = r_poison;
-    g_player_stat_cache.resist_status = r_status;
-    /* Phase 7 defensive extensions (currently zero until affix/stat sources defined) */
-    g_player_stat_cache.block_chance += block_chance;
-    g_player_stat_cache.block_value += block_value;
-    g_player_stat_cache.phys_conv_fire_pct += phys_conv_fire;
-    g_player_stat_cache.phys_conv_frost_pct += phys_conv_frost;
-    g_player_stat_cache.phys_conv_arcane_pct += phys_conv_arc;
-    g_player_stat_cache.guard_recovery_pct += guard_recovery;
-    g_player_stat_cache.thorns_percent += thorns_pct;
-    g_player_stat_cache.thorns_cap += thorns_cap;
+    int v[ROGUE_EQUIP_CONTRIB__COUNT];
+} EquipContrib;
+
+/* Everything a slot's contribution depends on besides the content registries. Zero-filled before
+   use so it can be compared with memcmp. */
+typedef struct EquipSlotKey
+{
+    int inst;
+    int def_index;
+    int rarity;
+    int prefix_index, prefix_value;
+    int suffix_index, suffix_value;
+    int socket_count;
+    int sockets[6];
+    unsigned long long guid;
+} EquipSlotKey;
+
+typedef struct EquipSlotState
+{
+    int valid;
+    int has_def; /* counts toward set bonuses */
+    int set_id;
+    EquipSlotKey key;
+    EquipContrib contrib;
+} EquipSlotState;
+
+static EquipSlotState g_slot_state[ROGUE_EQUIP__COUNT];
+static EquipContrib g_slot_sum; /* partial sums of every per-slot layer */
+static EquipContrib g_set_sum;  /* set layer */
+static int g_content_key[6];
+static unsigned int g_slot_gather_count = 0;
+
+static void contrib_fold(EquipContrib* sum, const EquipContrib* c, int sign)
+{
+    for (int i = 0; i < ROGUE_EQUIP_CONTRIB__COUNT; ++i)
+        sum->v[i] += sign * c->v[i];
 }
 
-/* Gather implicit stats from base item definitions of equipped items. These feed the implicit_*
- * layer in stat cache. */
-static void gather_implicit_primary_and_armor(void)
+static void slot_key(int inst_index, EquipSlotKey* k)
 {
-    int str = 0, dex = 0, vit = 0, intel = 0, armor_flat = 0;
-    int r_phys = 0, r_fire = 0, r_cold = 0, r_light = 0, r_poison = 0, r_status = 0;
-    for (int slot = 0; slot < ROGUE_EQUIP__COUNT; ++slot)
-    {
-        int inst_index = rogue_equip_get((enum RogueEquipSlot) slot);
-        if (inst_index < 0)
-            continue;
-        const RogueItemInstance* it = rogue_item_instance_at(inst_index);
-        if (!it)
-            continue;
-        const RogueItemDef* d = rogue_item_def_at(it->def_index);
-        if (!d)
-            continue;
-        str += d->implicit_strength;
-        dex += d->implicit_dexterity;
-        vit += d->implicit_vitality;
-        intel += d->implicit_intelligence;
-        armor_flat += d->implicit_armor_flat;
-        r_phys += d->implicit_resist_physical;
-        r_fire += d->implicit_resist_fire;
-        r_cold += d->implicit_resist_cold;
-        r_light += d->implicit_resist_lightning;
-        r_poison += d->implicit_resist_poison;
-        r_status += d->implicit_resist_status;
-    }
-    g_player_stat_cache.implicit_strength = str;
-    g_player_stat_cache.implicit_dexterity = dex;
-    g_player_stat_cache.implicit_vitality = vit;
-    g_player_stat_cache.implicit_intelligence = intel;
-    /* For armor/resists, implicit layer contributes directly to aggregate resist fields (currently
-       single-layer). We add to existing sums so affix and implicit sources combine. */
-    g_player_stat_cache.affix_armor_flat +=
-        armor_flat; /* reuse flat armor field for now (no separate implicit armor field) */
-    g_player_stat_cache.resist_physical += r_phys;
-    g_player_stat_cache.resist_fire += r_fire;
-    g_player_stat_cache.resist_cold += r_cold;
-    g_player_stat_cache.resist_lightning += r_light;
-    g_player_stat_cache.resist_poison += r_poison;
-    g_player_stat_cache.resist_status += r_status;
+    memset(k, 0, sizeof *k);
+    k->inst = inst_index;
+    k->def_index = -1;
+    if (inst_index < 0)
+        return;
+    const RogueItemInstance* it = rogue_item_instance_at(inst_index);
+    if (!it)
+        return;
+    k->def_index = it->def_index;
+    k->rarity = it->rarity;
+    k->prefix_index = it->prefix_index;
+    k->prefix_value = it->prefix_value;
+    k->suffix_index = it->suffix_index;
+    k->suffix_value = it->suffix_value;
+    k->socket_count = it->socket_count;
+    memcpy(k->sockets, it->sockets, sizeof k->sockets);
+    k->guid = it->guid;
 }
 
-/* Gather unique item fixed bonuses into unique_* layer (Phase 4.2). */
-static void gather_unique_primary(void)
+/* Gathers every layer one equipped item feeds through the shared contribution routine. */
+static void gather_slot(int inst_index, EquipSlotState* st)
 {
-    int str = 0, dex = 0, vit = 0, intel = 0;
-    int armor_flat = 0;
-    int r_phys = 0, r_fire = 0, r_cold = 0, r_light = 0, r_poison = 0, r_status = 0;
+    memset(&st->contrib, 0, sizeof st->contrib);
+    st->has_def = rogue_equip_contrib_gather(inst_index, st->contrib.v, &st->set_id);
+}
+
+/* Set layer (Phase 4.3 & 4.4 partial scaling) from the cached slot set ids, so no instance lookups
+ * happen here. */
+static void gather_set_bonuses(const EquipSlotState* slots, EquipContrib* out)
+{
+    int slot_set[ROGUE_EQUIP__COUNT];
     for (int slot = 0; slot < ROGUE_EQUIP__COUNT; ++slot)
-    {
-        int inst_index = rogue_equip_get((enum RogueEquipSlot) slot);
-        if (inst_index < 0)
-            continue;
-        const RogueItemInstance* it = rogue_item_instance_at(inst_index);
-        if (!it)
-            continue;
-        const RogueItemDef* d = rogue_item_def_at(it->def_index);
-        if (!d)
-            continue;
-        int uidx = rogue_unique_find_by_base_def(it->def_index);
-        if (uidx < 0)
-            continue;
-        const RogueUniqueDef* u = rogue_unique_at(uidx);
-        if (!u)
-            continue;
-        str += u->strength;
-        dex += u->dexterity;
-        vit += u->vitality;
-        intel += u->intelligence;
-        armor_flat += u->armor_flat;
-        r_phys += u->resist_physical;
-        r_fire += u->resist_fire;
-        r_cold += u->resist_cold;
-        r_light += u->resist_lightning;
-        r_poison += u->resist_poison;
-        r_status += u->resist_status;
-    }
-    g_player_stat_cache.unique_strength = str;
-    g_player_stat_cache.unique_dexterity = dex;
-    g_player_stat_cache.unique_vitality = vit;
-    g_player_stat_cache.unique_intelligence = intel;
-    g_player_stat_cache.affix_armor_flat +=
-        armor_flat; /* fold into shared flat armor contribution */
-    g_player_stat_cache.resist_physical += r_phys;
-    g_player_stat_cache.resist_fire += r_fire;
-    g_player_stat_cache.resist_cold += r_cold;
-    g_player_stat_cache.resist_lightning += r_light;
-    g_player_stat_cache.resist_poison += r_poison;
-    g_player_stat_cache.resist_status += r_status;
+        slot_set[slot] = slots[slot].has_def ? slots[slot].set_id : -1;
+    rogue_equip_contrib_set_layer(slot_set, out->v);
+}
+
+/* Registry sizes: content registered or reset after items were equipped invalidates every slot. */
+static int content_changed(void)
+{
+    int key[6] = {rogue_affix_count(),   rogue_item_defs_count(), rogue_unique_count(),
+                  rogue_runeword_count(), rogue_set_count(),      rogue_gem_count()};
+    if (memcmp(key, g_content_key, sizeof key) == 0)
+        return 0;
+    memcpy(g_content_key, key, sizeof key);
+    return 1;
 }
 
-/* Aggregate set bonuses (Phase 4.3 & 4.4 partial scaling). Approach: count equipped items per
- * set_id, then apply any bonuses whose threshold <= count. Partial scaling: if count is between
- * thresholds and next threshold exists, interpolate linearly. */
-static void gather_set_bonuses(void)
+/* Re-gathers changed or dirty slots and folds them into the partial sums. Returns non-zero when
+   any equipment layer changed. */
+static int refresh_slot_contributions(unsigned int force_mask)
 {
-    int str = 0, dex = 0, vit = 0, intel = 0, armor = 0;
-    int r_phys = 0, r_fire = 0, r_cold = 0, r_light = 0, r_poison = 0, r_status = 0;
-    /* For each distinct set encountered gather count first (small N approach). */
-    for (int si = 0; si < rogue_set_count(); ++si)
+    int changed = 0;
+    if (content_changed())
+        force_mask = 0xFFFFFFFFu;
+    for (int slot = 0; slot < ROGUE_EQUIP__COUNT; ++slot)
     {
-        const RogueSetDef* sd = rogue_set_at(si);
-        if (!sd)
+        EquipSlotState* st = &g_slot_state[slot];
+        EquipSlotKey key;
+        slot_key(rogue_equip_get((enum RogueEquipSlot) slot), &key);
+        if (st->valid && !(force_mask & (1u << slot)) && memcmp(&key, &st->key, sizeof key) == 0)
             continue;
-        int have = 0;
-        for (int slot = 0; slot < ROGUE_EQUIP__COUNT; ++slot)
-        {
-            int inst = rogue_equip_get((enum RogueEquipSlot) slot);
-            if (inst < 0)
-                continue;
-            const RogueItemInstance* it = rogue_item_instance_at(inst);
-            if (!it)
-                continue;
-            const RogueItemDef* d = rogue_item_def_at(it->def_index);
-            if (!d)
-                continue;
-            if (d->set_id == sd->set_id)
-                have++;
-        }
-        if (have > 0)
-        {
-            rogue_set_preview_apply(sd->set_id, have, &str, &dex, &vit, &intel, &armor, &r_fire,
-                                    &r_cold, &r_light, &r_poison, &r_status, &r_phys);
-        }
+        if (st->valid)
+            contrib_fold(&g_slot_sum, &st->contrib, -1);
+        gather_slot(key.inst, st);
+        contrib_fold(&g_slot_sum, &st->contrib, 1);
+        st->key = key;
+        st->valid = 1;
+        g_slot_gather_count++;
+        changed = 1;
     }
-    g_player_stat_cache.set_strength = str;
-    g_player_stat_cache.set_dexterity = dex;
-    g_player_stat_cache.set_vitality = vit;
-    g_player_stat_cache.set_intelligence = intel;
-    g_player_stat_cache.affix_armor_flat += armor;
-    g_player_stat_cache.resist_physical += r_phys;
-    g_player_stat_cache.resist_fire += r_fire;
-    g_player_stat_cache.resist_cold += r_cold;
-    g_player_stat_cache.resist_lightning += r_light;
-    g_player_stat_cache.resist_poison += r_poison;
-    g_player_stat_cache.resist_status += r_status;
+    if (changed)
+        gather_set_bonuses(g_slot_state, &g_set_sum);
+    return changed;
 }
 
-/* Aggregate runeword bonuses (Phase 4.5) */
-static void gather_runeword_bonuses(void)
+/* Verify mode: rebuilds every slot from scratch and compares with the incremental sums. On mismatch
+   the scratch result replaces the cached state and 1 is returned. */
+static int verify_slot_contributions(void)
 {
-    int str = 0, dex = 0, vit = 0, intel = 0, armor = 0;
-    int r_phys = 0, r_fire = 0, r_cold = 0, r_light = 0, r_poison = 0, r_status = 0;
+    static EquipSlotState scratch[ROGUE_EQUIP__COUNT];
+    EquipContrib sum, set_sum;
+    memset(&sum, 0, sizeof sum);
     for (int slot = 0; slot < ROGUE_EQUIP__COUNT; ++slot)
     {
-        int inst = rogue_equip_get((enum RogueEquipSlot) slot);
-        if (inst < 0)
-            continue;
-        const RogueItemInstance* it = rogue_item_instance_at(inst);
-        if (!it)
-            continue;
-        const RogueItemDef* d = rogue_item_def_at(it->def_index);
-        if (!d)
-            continue;
-        const RogueRuneword* rw = item_runeword(d);
-        if (!rw)
-            continue;
-        str += rw->strength;
-        dex += rw->dexterity;
-        vit += rw->vitality;
-        intel += rw->intelligence;
-        armor += rw->armor_flat;
-        r_phys += rw->resist_physical;
-        r_fire += rw->resist_fire;
-        r_cold += rw->resist_cold;
-        r_light += rw->resist_light;
-        r_poison += rw->resist_poison;
-        r_status += rw->resist_status;
+        slot_key(rogue_equip_get((enum RogueEquipSlot) slot), &scratch[slot].key);
+        gather_slot(scratch[slot].key.inst, &scratch[slot]);
+        scratch[slot].valid = 1;
+        contrib_fold(&sum, &scratch[slot].contrib, 1);
     }
-    g_player_stat_cache.runeword_strength = str;
-    g_player_stat_cache.runeword_dexterity = dex;
-    g_player_stat_cache.runeword_vitality = vit;
-    g_player_stat_cache.runeword_intelligence = intel;
-    g_player_stat_cache.affix_armor_flat += armor;
-    g_player_stat_cache.resist_physical += r_phys;
-    g_player_stat_cache.resist_fire += r_fire;
-    g_player_stat_cache.resist_cold += r_cold;
-    g_player_stat_cache.resist_lightning += r_light;
-    g_player_stat_cache.resist_poison += r_poison;
-    g_player_stat_cache.resist_status += r_status;
+    gather_set_bonuses(scratch, &set_sum);
+    if (memcmp(&sum, &g_slot_sum, sizeof sum) == 0 && memcmp(&set_sum, &g_set_sum, sizeof sum) == 0)
+        return 0;
+    const int armor = ROGUE_EQUIP_CONTRIB_ARMOR_FLAT;
+    int armor_inc = g_slot_sum.v[armor] + g_set_sum.v[armor];
+    int armor_full = sum.v[armor] + set_sum.v[armor];
+    g_player_stat_cache.verify_mismatch_count++;
+    ROGUE_LOG_WARN("stat cache verify: equipment partial sums diverged from full aggregation "
+                   "(affix str %d vs %d, armor %d vs %d)",
+                   g_slot_sum.v[ROGUE_EQUIP_CONTRIB_AFFIX], sum.v[ROGUE_EQUIP_CONTRIB_AFFIX],
+                   armor_inc, armor_full);
+    memcpy(g_slot_state, scratch, sizeof scratch);
+    g_slot_sum = sum;
+    g_set_sum = set_sum;
+    return 1;
 }
 
+unsigned int rogue_equipment_stats_slot_gather_count(void) { return g_slot_gather_count; }
+
 void rogue_equipment_apply_stat_bonuses(RoguePlayer* p)
 {
     /* Maintain layered cache model but also (legacy test compatibility) reflect primary stat deltas
@@ -434,34 +212,76 @@ void rogue_equipment_apply_stat_bonuses(RoguePlayer* p)
 #endif
     }
 
-    /* Reset dynamic aggregation fields we own before recomputing. Base & implicit fields cleared in
-     * stat cache compute_layers. */
-    g_player_stat_cache.affix_strength = g_player_stat_cache.affix_dexterity = 0;
-    g_player_stat_cache.affix_vitality = g_player_stat_cache.affix_intelligence = 0;
-    g_player_stat_cache.affix_armor_flat = 0;
-    /* Resist fields reset to 0 before summing from affix + implicit layers. */
-    g_player_stat_cache.resist_physical = g_player_stat_cache.resist_fire = 0;
-    g_player_stat_cache.resist_cold = g_player_stat_cache.resist_lightning = 0;
-    g_player_stat_cache.resist_poison = g_player_stat_cache.resist_status = 0;
-    g_player_stat_cache.block_chance = g_player_stat_cache.block_value = 0;
-    g_player_stat_cache.phys_conv_fire_pct = g_player_stat_cache.phys_conv_frost_pct = 0;
-    g_player_stat_cache.phys_conv_arcane_pct = 0;
-    g_player_stat_cache.guard_recovery_pct = 0;
-    g_player_stat_cache.thorns_percent = 0;
-    g_player_stat_cache.thorns_cap = 0;
-    gather_affix_primary_and_armor(); /* affix layer (later in precedence) */
-    gather_implicit_primary_and_armor();
-    gather_unique_primary();
-    rogue_gems_aggregate_equipped(); /* Phase 5.2: gem contributions before sets/runewords (still
-                                        additive into affix_* layer) */
-    gather_set_bonuses();
-    gather_runeword_bonuses();
+    /* Refresh only the slots whose item changed (or were marked dirty), then write every layer we
+     * own from the partial sums; the writes are cheap and restore fields callers reset directly. */
+    int equipment_changed = refresh_slot_contributions(g_player_stat_cache.equipment_slot_dirty);
+    g_player_stat_cache.equipment_slot_dirty = 0;
+    if (rogue_stat_cache_verify_enabled() && verify_slot_contributions())
+        equipment_changed = 1;
+    const int* v = g_slot_sum.v;
+    const int* sv = g_set_sum.v;
+    g_player_stat_cache.implicit_strength = v[ROGUE_EQUIP_CONTRIB_IMPLICIT + 0];
+    g_player_stat_cache.implicit_dexterity = v[ROGUE_EQUIP_CONTRIB_IMPLICIT + 1];
+    g_player_stat_cache.implicit_vitality = v[ROGUE_EQUIP_CONTRIB_IMPLICIT + 2];
+    g_player_stat_cache.implicit_intelligence = v[ROGUE_EQUIP_CONTRIB_IMPLICIT + 3];
+    g_player_stat_cache.unique_strength = v[ROGUE_EQUIP_CONTRIB_UNIQUE + 0];
+    g_player_stat_cache.unique_dexterity = v[ROGUE_EQUIP_CONTRIB_UNIQUE + 1];
+    g_player_stat_cache.unique_vitality = v[ROGUE_EQUIP_CONTRIB_UNIQUE + 2];
+    g_player_stat_cache.unique_intelligence = v[ROGUE_EQUIP_CONTRIB_UNIQUE + 3];
+    g_player_stat_cache.runeword_strength = v[ROGUE_EQUIP_CONTRIB_RUNEWORD + 0];
+    g_player_stat_cache.runeword_dexterity = v[ROGUE_EQUIP_CONTRIB_RUNEWORD + 1];
+    g_player_stat_cache.runeword_vitality = v[ROGUE_EQUIP_CONTRIB_RUNEWORD + 2];
+    g_player_stat_cache.runeword_intelligence = v[ROGUE_EQUIP_CONTRIB_RUNEWORD + 3];
+    g_player_stat_cache.set_strength = sv[ROGUE_EQUIP_CONTRIB_SET + 0];
+    g_player_stat_cache.set_dexterity = sv[ROGUE_EQUIP_CONTRIB_SET + 1];
+    g_player_stat_cache.set_vitality = sv[ROGUE_EQUIP_CONTRIB_SET + 2];
+    g_player_stat_cache.set_intelligence = sv[ROGUE_EQUIP_CONTRIB_SET + 3];
+    /* Affix layer also carries gems; percent gem bonuses convert against the current base layer */
+    int base_primary[4] = {g_player_stat_cache.base_strength, g_player_stat_cache.base_dexterity,
+                           g_player_stat_cache.base_vitality,
+                           g_player_stat_cache.base_intelligence};
+    int affix[4];
+    for (int i = 0; i < 4; ++i)
+    {
+        affix[i] = v[ROGUE_EQUIP_CONTRIB_AFFIX + i];
+        if (v[ROGUE_EQUIP_CONTRIB_GEM_PCT + i] > 0)
+            affix[i] += (base_primary[i] * v[ROGUE_EQUIP_CONTRIB_GEM_PCT + i]) / 100;
+    }
+    g_player_stat_cache.affix_strength = affix[0];
+    g_player_stat_cache.affix_dexterity = affix[1];
+    g_player_stat_cache.affix_vitality = affix[2];
+    g_player_stat_cache.affix_intelligence = affix[3];
+    /* Flat armor and resists are single aggregate fields shared by every source layer */
+    g_player_stat_cache.affix_armor_flat =
+        v[ROGUE_EQUIP_CONTRIB_ARMOR_FLAT] + sv[ROGUE_EQUIP_CONTRIB_ARMOR_FLAT];
+    const int* res = v + ROGUE_EQUIP_CONTRIB_RESIST;
+    const int* set_res = sv + ROGUE_EQUIP_CONTRIB_RESIST;
+    g_player_stat_cache.resist_physical = res[0] + set_res[0];
+    g_player_stat_cache.resist_fire = res[1] + set_res[1];
+    g_player_stat_cache.resist_cold = res[2] + set_res[2];
+    g_player_stat_cache.resist_lightning = res[3] + set_res[3];
+    g_player_stat_cache.resist_poison = res[4] + set_res[4];
+    g_player_stat_cache.resist_status = res[5] + set_res[5];
+    g_player_stat_cache.block_chance = v[ROGUE_EQUIP_CONTRIB_BLOCK_CHANCE];
+    g_player_stat_cache.block_value = v[ROGUE_EQUIP_CONTRIB_BLOCK_VALUE];
+    g_player_stat_cache.phys_conv_fire_pct = v[ROGUE_EQUIP_CONTRIB_PHYS_CONV_FIRE];
+    g_player_stat_cache.phys_conv_frost_pct = v[ROGUE_EQUIP_CONTRIB_PHYS_CONV_FROST];
+    g_player_stat_cache.phys_conv_arcane_pct = v[ROGUE_EQUIP_CONTRIB_PHYS_CONV_ARCANE];
+    g_player_stat_cache.guard_recovery_pct = v[ROGUE_EQUIP_CONTRIB_GUARD_RECOVERY];
+    g_player_stat_cache.thorns_percent = v[ROGUE_EQUIP_CONTRIB_THORNS_PERCENT];
+    g_player_stat_cache.thorns_cap = v[ROGUE_EQUIP_CONTRIB_THORNS_CAP];
     /* Debug (filterable): raw aggregated resist values before derived clamping */
     ROGUE_LOG_DEBUG("DBG_RESISTS raw: phys=%d fire=%d cold=%d light=%d poison=%d status=%d",
                     g_player_stat_cache.resist_physical, g_player_stat_cache.resist_fire,
                     g_player_stat_cache.resist_cold, g_player_stat_cache.resist_lightning,
                     g_player_stat_cache.resist_poison, g_player_stat_cache.resist_status);
-    rogue_stat_cache_mark_dirty();
+    /* Attribute, passive and buff sources are polled every pass (constant-time queries); the
+     * equipment scans behind derived metrics rerun only when a slot actually changed. */
+    rogue_stat_cache_mark_attr_dirty();
+    rogue_stat_cache_mark_passive_dirty();
+    rogue_stat_cache_mark_buff_dirty();
+    if (equipment_changed)
+        g_player_stat_cache.dirty_bits |= ROGUE_STAT_DIRTY_EQUIPMENT;
     if (p)
     {
         /* Ensure cache treats these as base-only inputs */
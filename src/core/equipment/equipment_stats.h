@@ -14,4 +14,9 @@
  */
 void rogue_equipment_apply_stat_bonuses(RoguePlayer* p);
 
+/* Number of per-slot contribution gathers performed so far. Each pass re-gathers only slots whose
+ * item changed or that were marked via rogue_stat_cache_mark_equipment_slot_dirty /
+ * rogue_stat_cache_mark_equipment_dirty; unchanged passes leave this counter alone. */
+unsigned int rogue_equipment_stats_slot_gather_count(void);
+
 #endif
@@ -0,0 +1,330 @@
+// Parallel, dependency-ordered content loader (see content_loader.h).
+// Worker threads follow the batch pattern used by the skill simulator and loadout search: spawn
+// workers 1..n-1, run worker 0 on the caller, pull work from an atomic cursor, join. Threads are
+// spawned per level; startup content has a handful of levels, so the spawn cost is noise next to
+// file I/O and keeps every commit strictly between parse phases.
+#include "content_loader.h"
+#include "../../util/profiler.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if defined(ROGUE_HAVE_SDL)
+#include <SDL.h>
+#endif
+
+#if defined(ROGUE_HAVE_SDL)
+typedef SDL_atomic_t ContentAtomic;
+#define content_atomic_add(a, v) SDL_AtomicAdd((a), (v))
+#else
+typedef struct ContentAtomic
+{
+    int value;
+} ContentAtomic;
+static int content_atomic_add(ContentAtomic* a, int v)
+{
+    int old = a->value;
+    a->value += v;
+    return old;
+}
+#endif
+
+typedef struct ContentLevel
+{
+    RogueContentLoader* loader;
+    const int* tasks; // task indices of this level that have a parse step
+    int count;
+    void** payloads;                // by task index
+    RogueContentTaskTiming* timing; // by task index
+    uint64_t t0;
+    ContentAtomic next;
+} ContentLevel;
+
+typedef struct ContentWorker
+{
+    ContentLevel* level;
+    int id;
+} ContentWorker;
+
+static double ms_since(uint64_t t0) { return (double) (rogue_prof_now_ns() - t0) / 1e6; }
+
+static int find_task(const RogueContentLoader* loader, const char* name)
+{
+    for (int i = 0; i < loader->task_count; i++)
+        if (strcmp(loader->tasks[i].name, name) == 0)
+            return i;
+    return -1;
+}
+
+int rogue_content_loader_init(RogueContentLoader* loader)
+{
+    if (!loader)
+        return -1;
+    memset(loader, 0, sizeof *loader);
+    loader->deps = rogue_dependency_manager_create();
+    if (!loader->deps)
+        return -1;
+    /* a cycle fails the load order instead of silently breaking it */
+    rogue_dependency_manager_set_strict_mode(loader->deps, true);
+    return 0;
+}
+
+void rogue_content_loader_free(RogueContentLoader* loader)
+{
+    if (!loader)
+        return;
+    rogue_dependency_manager_destroy(loader->deps);
+    loader->deps = NULL;
+    loader->task_count = 0;
+}
+
+int rogue_content_loader_add(RogueContentLoader* loader, const char* name, RogueFileType type,
+                             RogueContentParseFn parse, RogueContentCommitFn commit,
+                             RogueContentFreeFn free_payload, void* user)
+{
+    if (!loader || !loader->deps || !name || !name[0] || !commit ||
+        loader->task_count >= ROGUE_CONTENT_MAX_TASKS ||
+        strlen(name) >= ROGUE_CONTENT_NAME_CAP || find_task(loader, name) >= 0)
+        return -1;
+    int idx = loader->task_count;
+    if (!rogue_dependency_manager_add_file(loader->deps, name, type, idx))
+        return -1;
+    RogueContentTask* t = &loader->tasks[idx];
+    memset(t, 0, sizeof *t);
+    memcpy(t->name, name, strlen(name) + 1);
+    t->type = type;
+    t->parse = parse;
+    t->commit = commit;
+    t->free_payload = free_payload;
+    t->user = user;
+    loader->task_count++;
+    return idx;
+}
+
+int rogue_content_loader_depend(RogueContentLoader* loader, const char* name,
+                                const char* depends_on)
+{
+    if (!loader || !loader->deps || !name || !depends_on || find_task(loader, name) < 0 ||
+        find_task(loader, depends_on) < 0)
+        return -1;
+    return rogue_dependency_manager_add_dependency(loader->deps, name, depends_on, "content",
+                                                   ROGUE_DEP_TYPE_STRONG, 0, NULL)
+               ? 0
+               : -1;
+}
+
+static void content_worker_run(ContentWorker* w)
+{
+    static RogueProfZoneSlot parse_slot;
+    int zone = rogue_prof_zone_slot(&parse_slot, "content_parse");
+    ContentLevel* lv = w->level;
+    for (;;)
+    {
+        int k = content_atomic_add(&lv->next, 1);
+        if (k >= lv->count)
+            break;
+        int ti = lv->tasks[k];
+        RogueContentTask* t = &lv->loader->tasks[ti];
+        RogueContentTaskTiming* tm = &lv->timing[ti];
+        tm->worker = w->id;
+        tm->parse_start_ms = ms_since(lv->t0);
+        rogue_prof_begin(zone);
+        tm->parse_result = t->parse(t->user, &lv->payloads[ti]);
+        rogue_prof_end(zone);
+        tm->parse_end_ms = ms_since(lv->t0);
+    }
+}
+
+#if defined(ROGUE_HAVE_SDL)
+static int content_worker_thread(void* ud)
+{
+    rogue_prof_thread_name("content_loader");
+    content_worker_run((ContentWorker*) ud);
+    return 0;
+}
+#endif
+
+static void parse_level(ContentLevel* lv, int workers)
+{
+    if (workers > lv->count)
+        workers = lv->count;
+    if (workers <= 0)
+        return;
+    ContentWorker ws[ROGUE_CONTENT_MAX_WORKERS];
+    for (int i = 0; i < workers; i++)
+    {
+        ws[i].level = lv;
+        ws[i].id = i;
+    }
+#if defined(ROGUE_HAVE_SDL)
+    SDL_Thread* threads[ROGUE_CONTENT_MAX_WORKERS] = {0};
+    for (int i = 1; i < workers; i++)
+        threads[i] = SDL_CreateThread(content_worker_thread, "content_loader", &ws[i]);
+    content_worker_run(&ws[0]);
+    for (int i = 1; i < workers; i++)
+    {
+        if (threads[i])
+            SDL_WaitThread(threads[i], NULL);
+        else
+            content_worker_run(&ws[i]); /* thread creation failed: drain remaining tasks here */
+    }
+#else
+    content_worker_run(&ws[0]);
+#endif
+}
+
+int rogue_content_loader_run(RogueContentLoader* loader, int workers,
+                             RogueContentTimeline* timeline)
+{
+    if (!loader || !loader->deps)
+        return -1;
+    int n = loader->task_count;
+    RogueLoadOrder* order = (RogueLoadOrder*) malloc(sizeof(RogueLoadOrder));
+    if (!order)
+        return -1;
+    if (!rogue_dependency_manager_generate_load_order(loader->deps, order) ||
+        order->file_count != n)
+    {
+        free(order);
+        return -1;
+    }
+    /* load order -> task indices -> levels (one past the deepest dependency) */
+    int seq[ROGUE_CONTENT_MAX_TASKS];
+    int level_of[ROGUE_CONTENT_MAX_TASKS] = {0};
+    int level_count = 0;
+    for (int i = 0; i < n; i++)
+    {
+        int ti = find_task(loader, order->files[i]);
+        if (ti < 0)
+        {
+            free(order);
+            return -1;
+        }
+        seq[i] = ti;
+        int lvl = 0;
+        RogueDependencyNode* node =
+            rogue_dependency_manager_find_node(loader->deps, order->files[i]);
+        for (int d = 0; node && d < node->dependency_count; d++)
+        {
+            int dep = find_task(loader, node->dependencies[d].target_file);
+            if (dep >= 0 && level_of[dep] + 1 > lvl)
+                lvl = level_of[dep] + 1;
+        }
+        level_of[ti] = lvl;
+        if (lvl + 1 > level_count)
+            level_count = lvl + 1;
+    }
+    free(order);
+
+#if defined(ROGUE_HAVE_SDL)
+    if (workers <= 0)
+        workers = SDL_GetCPUCount();
+#endif
+    if (workers <= 0)
+        workers = 1;
+    if (workers > ROGUE_CONTENT_MAX_WORKERS)
+        workers = ROGUE_CONTENT_MAX_WORKERS;
+
+    void* payloads[ROGUE_CONTENT_MAX_TASKS];
+    RogueContentTaskTiming timing[ROGUE_CONTENT_MAX_TASKS];
+    memset(payloads, 0, sizeof payloads);
+    memset(timing, 0, sizeof timing);
+    static RogueProfZoneSlot commit_slot;
+    int commit_zone = rogue_prof_zone_slot(&commit_slot, "content_commit");
+    uint64_t t0 = rogue_prof_now_ns();
+    int committed = 0;
+    for (int lvl = 0; lvl < level_count; lvl++)
+    {
+        int parse_tasks[ROGUE_CONTENT_MAX_TASKS];
+        ContentLevel lv;
+        memset(&lv, 0, sizeof lv);
+        lv.loader = loader;
+        lv.tasks = parse_tasks;
+        lv.payloads = payloads;
+        lv.timing = timing;
+        lv.t0 = t0;
+        for (int i = 0; i < n; i++)
+        {
+            int ti = seq[i];
+            if (level_of[ti] != lvl)
+                continue;
+            timing[ti].level = lvl;
+            timing[ti].worker = -1;
+            if (loader->tasks[ti].parse)
+                parse_tasks[lv.count++] = ti;
+        }
+        parse_level(&lv, workers);
+        /* commit on the caller in load order: deterministic regardless of parse timing */
+        for (int i = 0; i < n; i++)
+        {
+            int ti = seq[i];
+            if (level_of[ti] != lvl)
+                continue;
+            RogueContentTask* t = &loader->tasks[ti];
+            RogueContentTaskTiming* tm = &timing[ti];
+            tm->commit_start_ms = ms_since(t0);
+            if (tm->parse_result >= 0)
+            {
+                rogue_prof_begin(commit_zone);
+                tm->commit_result = t->commit(t->user, payloads[ti]);
+                rogue_prof_end(commit_zone);
+                if (tm->commit_result >= 0)
+                    committed++;
+            }
+            else
+                tm->commit_result = -1;
+            if (t->free_payload && payloads[ti])
+                t->free_payload(t->user, payloads[ti]);
+            payloads[ti] = NULL;
+            tm->commit_end_ms = ms_since(t0);
+        }
+    }
+
+    if (timeline)
+    {
+        memset(timeline, 0, sizeof *timeline);
+        timeline->task_count = n;
+        timeline->level_count = level_count;
+        timeline->workers = workers;
+        timeline->wall_ms = ms_since(t0);
+        for (int i = 0; i < n; i++)
+        {
+            int ti = seq[i];
+            RogueContentTaskTiming* tm = &timeline->tasks[i];
+            *tm = timing[ti];
+            memcpy(tm->name, loader->tasks[ti].name, sizeof tm->name);
+            timeline->parse_ms_sum += tm->parse_end_ms - tm->parse_start_ms;
+            timeline->commit_ms_sum += tm->commit_end_ms - tm->commit_start_ms;
+        }
+    }
+    return committed;
+}
+
+int rogue_content_timeline_format(const RogueContentTimeline* timeline, char* buf, int cap)
+{
+    if (!timeline || cap < 0 || (!buf && cap > 0))
+        return -1;
+    int len = 0;
+#define CL_APPEND(...)                                                                             \
+    do                                                                                             \
+    {                                                                                              \
+        int w_ = snprintf(len < cap ? buf + len : NULL, len < cap ? (size_t) (cap - len) : 0,      \
+                          __VA_ARGS__);                                                            \
+        if (w_ > 0)                                                                                \
+            len += w_;                                                                             \
+    } while (0)
+    CL_APPEND("content load: %d tasks, %d levels, %d workers\n", timeline->task_count,
+              timeline->level_count, timeline->workers);
+    for (int i = 0; i < timeline->task_count; i++)
+    {
+        const RogueContentTaskTiming* tm = &timeline->tasks[i];
+        CL_APPEND("  L%d w%-2d %-24s parse %8.2f..%8.2f  commit %8.2f..%8.2f  rc=%d/%d\n",
+                  tm->level, tm->worker, tm->name, tm->parse_start_ms, tm->parse_end_ms,
+                  tm->commit_start_ms, tm->commit_end_ms, tm->parse_result, tm->commit_result);
+    }
+    double serial = timeline->parse_ms_sum + timeline->commit_ms_sum;
+    CL_APPEND("  wall %.2f ms, serial %.2f ms (parse %.2f + commit %.2f), speedup %.2fx\n",
+              timeline->wall_ms, serial, timeline->parse_ms_sum, timeline->commit_ms_sum,
+              timeline->wall_ms > 0.0 ? serial / timeline->wall_ms : 1.0);
+#undef CL_APPEND
+    return len;
+}
@@ -0,0 +1,102 @@
+// Parallel, dependency-ordered content loading (startup).
+// Content files register as tasks with a parse step and a commit step:
+//  - parse runs on a worker thread and must not touch shared registries; it returns a payload
+//    (e.g. an array of parsed defs) built only from the file and already committed content.
+//  - commit runs on the calling (main) thread and publishes the payload into the registries.
+// Dependencies go through the RogueDependencyManager graph; its topological load order is split
+// into levels (a task's level is one past its deepest dependency). Each level parses in parallel
+// (atomic work cursor, caller thread participates), then commits in load order on the caller, so
+// registry contents never depend on thread timing. Without SDL every parse runs on the caller.
+// Every run fills a timeline (per task: level, worker, parse / commit start and end) that can be
+// printed as the startup report; parse and commit also show up as profiler zones.
+
+#ifndef ROGUE_CONTENT_LOADER_H
+#define ROGUE_CONTENT_LOADER_H
+
+#include "dependency_manager.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define ROGUE_CONTENT_MAX_TASKS 64
+#define ROGUE_CONTENT_MAX_WORKERS 8
+#define ROGUE_CONTENT_NAME_CAP 64
+
+    // Worker thread: build *out_payload (may stay NULL). Return <0 on failure (commit skipped).
+    typedef int (*RogueContentParseFn)(void* user, void** out_payload);
+    // Caller thread: publish the payload. Returns a task-defined count, <0 on failure.
+    typedef int (*RogueContentCommitFn)(void* user, void* payload);
+    // Caller thread, after commit (or after a failed parse): release the payload.
+    typedef void (*RogueContentFreeFn)(void* user, void* payload);
+
+    typedef struct RogueContentTask
+    {
+        char name[ROGUE_CONTENT_NAME_CAP];
+        RogueFileType type;
+        RogueContentParseFn parse; // NULL: commit-only task (runs its whole load on the caller)
+        RogueContentCommitFn commit;
+        RogueContentFreeFn free_payload;
+        void* user;
+    } RogueContentTask;
+
+    typedef struct RogueContentTaskTiming
+    {
+        char name[ROGUE_CONTENT_NAME_CAP];
+        int level;
+        int worker; // parse worker (0 = caller), -1 for commit-only tasks
+        int parse_result;
+        int commit_result;     // -1 as well when skipped after a failed parse
+        double parse_start_ms; // all times relative to the start of the run
+        double parse_end_ms;
+        double commit_start_ms;
+        double commit_end_ms;
+    } RogueContentTaskTiming;
+
+    typedef struct RogueContentTimeline
+    {
+        int task_count; // entries in load order
+        int level_count;
+        int workers;
+        double wall_ms;
+        double parse_ms_sum; // serial cost of all parses
+        double commit_ms_sum;
+        RogueContentTaskTiming tasks[ROGUE_CONTENT_MAX_TASKS];
+    } RogueContentTimeline;
+
+    typedef struct RogueContentLoader
+    {
+        RogueDependencyManager* deps;
+        int task_count;
+        RogueContentTask tasks[ROGUE_CONTENT_MAX_TASKS];
+    } RogueContentLoader;
+
+    // Returns 0, or -1 when the dependency manager cannot be created.
+    int rogue_content_loader_init(RogueContentLoader* loader);
+    void rogue_content_loader_free(RogueContentLoader* loader);
+
+    // Register a task under a unique name. Returns the task index or -1 (full, duplicate, no
+    // commit function).
+    int rogue_content_loader_add(RogueContentLoader* loader, const char* name, RogueFileType type,
+                                 RogueContentParseFn parse, RogueContentCommitFn commit,
+                                 RogueContentFreeFn free_payload, void* user);
+    // `name` loads after `depends_on` is committed. Both must be registered. Returns 0 or -1.
+    int rogue_content_loader_depend(RogueContentLoader* loader, const char* name,
+                                    const char* depends_on);
+
+    // Load everything. workers <= 0 picks the CPU count (capped by ROGUE_CONTENT_MAX_WORKERS).
+    // timeline may be NULL. Returns the number of tasks whose commit succeeded, or -1 when the
+    // graph has a cycle.
+    int rogue_content_loader_run(RogueContentLoader* loader, int workers,
+                                 RogueContentTimeline* timeline);
+
+    // Human readable startup report (one line per task plus a summary). Returns the full length
+    // like snprintf; output truncated when >= cap.
+    int rogue_content_timeline_format(const RogueContentTimeline* timeline, char* buf, int cap);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
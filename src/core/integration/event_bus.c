@@ -22,6 +22,50 @@
 #define rogue_event_mutex_unlock(m) pthread_mutex_unlock((pthread_mutex_t*) m)
 #endif
 
+/* Portable atomics for the publish path (Interlocked on MSVC, GCC/Clang builtins elsewhere) */
+#if defined(_MSC_VER)
+#define eb_load32(p) ((uint32_t) InterlockedCompareExchange((volatile LONG*) (p), 0, 0))
+#define eb_store32(p, v) InterlockedExchange((volatile LONG*) (p), (LONG) (v))
+#define eb_add32(p, v) ((uint32_t) InterlockedExchangeAdd((volatile LONG*) (p), (LONG) (v)))
+#define eb_cas32(p, o, n)                                                                          \
+    (InterlockedCompareExchange((volatile LONG*) (p), (LONG) (n), (LONG) (o)) == (LONG) (o))
+#define eb_load64(p) ((uint64_t) InterlockedCompareExchange64((volatile LONG64*) (p), 0, 0))
+#define eb_store64(p, v) InterlockedExchange64((volatile LONG64*) (p), (LONG64) (v))
+#define eb_add64(p, v) ((uint64_t) InterlockedExchangeAdd64((volatile LONG64*) (p), (LONG64) (v)))
+#define eb_cas64(p, o, n)                                                                          \
+    (InterlockedCompareExchange64((volatile LONG64*) (p), (LONG64) (n), (LONG64) (o)) ==          \
+     (LONG64) (o))
+#define eb_xchg_ptr(p, v) InterlockedExchangePointer((PVOID volatile*) (p), (PVOID) (v))
+#else
+#define eb_load32(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define eb_store32(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define eb_add32(p, v) __atomic_fetch_add((p), (v), __ATOMIC_ACQ_REL)
+#define eb_cas32(p, o, n) eb_cas32_impl((p), (o), (n))
+#define eb_load64(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define eb_store64(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define eb_add64(p, v) __atomic_fetch_add((p), (v), __ATOMIC_ACQ_REL)
+#define eb_cas64(p, o, n) eb_cas64_impl((p), (o), (n))
+#define eb_xchg_ptr(p, v) __atomic_exchange_n((p), (v), __ATOMIC_ACQ_REL)
+static int eb_cas32_impl(uint32_t* p, uint32_t expected, uint32_t desired)
+{
+    return __atomic_compare_exchange_n(p, &expected, desired, 0, __ATOMIC_ACQ_REL,
+                                       __ATOMIC_ACQUIRE);
+}
+static int eb_cas64_impl(uint64_t* p, uint64_t expected, uint64_t desired)
+{
+    return __atomic_compare_exchange_n(p, &expected, desired, 0, __ATOMIC_ACQ_REL,
+                                       __ATOMIC_ACQUIRE);
+}
+#endif
+
+/* Everything the bus logs is in the events category. Debug traces sit on the publish / dispatch
+   hot path; the macros test the category threshold first, so a disabled trace neither formats nor
+   evaluates its arguments (several of which read shared counters). */
+#define EB_TRACE(...) ROGUE_LOGC_DEBUG(ROGUE_LOG_CAT_EVENTS, __VA_ARGS__)
+#define EB_INFO(...) ROGUE_LOGC_INFO(ROGUE_LOG_CAT_EVENTS, __VA_ARGS__)
+#define EB_WARN(...) ROGUE_LOGC_WARN(ROGUE_LOG_CAT_EVENTS, __VA_ARGS__)
+#define EB_ERROR(...) ROGUE_LOGC_ERROR(ROGUE_LOG_CAT_EVENTS, __VA_ARGS__)
+
 /* Global event bus instance */
 static RogueEventBus g_event_bus = {0};
 
@@ -45,7 +89,12 @@ static RogueEvent* create_event(RogueEventTypeId type_id, const RogueEventPayloa
                                 RogueEventPriority priority, uint32_t source_system_id,
                                 const char* source_name);
 static void free_event(RogueEvent* event);
+static bool ring_init(RogueEventRing* ring, uint32_t capacity);
+static bool ring_push(RogueEventRing* ring, RogueEvent* event);
+static bool reserve_queue_slots(uint32_t count);
 static void enqueue_event(RogueEvent* event);
+static uint32_t merge_pending_events(void);
+static bool has_queued_events(RogueEventPriority priority);
 static RogueEvent* dequeue_event(RogueEventPriority priority);
 static void record_event_for_replay(const RogueEvent* event);
 static void update_statistics_on_publish(void);
@@ -59,13 +108,13 @@ bool rogue_event_bus_init(const RogueEventBusConfig* config)
 {
     if (g_event_bus.initialized)
     {
-        ROGUE_LOG_WARN("Event bus already initialized");
+        EB_WARN("Event bus already initialized");
         return true;
     }
 
     if (!config)
     {
-        ROGUE_LOG_ERROR("Event bus configuration is NULL");
+        EB_ERROR("Event bus configuration is NULL");
         return false;
     }
 
@@ -82,19 +131,46 @@ bool rogue_event_bus_init(const RogueEventBusConfig* config)
         g_event_bus.mutex = malloc(sizeof(ROGUE_EVENT_MUTEX_TYPE));
         if (!g_event_bus.mutex)
         {
-            ROGUE_LOG_ERROR("Failed to allocate mutex for event bus");
+            EB_ERROR("Failed to allocate mutex for event bus");
             return false;
         }
         rogue_event_mutex_init(g_event_bus.mutex);
     }
 
+    /* Pending rings: each priority can hold the whole queue, so a publish admitted by the
+       capacity check never finds its ring full */
+    uint32_t ring_capacity = 16;
+    while (ring_capacity < config->max_queue_size && ring_capacity < (1u << 30))
+        ring_capacity <<= 1;
+    bool rings_ok = true;
+    for (int priority = 0; priority < ROGUE_EVENT_PRIORITY_COUNT; priority++)
+        rings_ok = rings_ok && ring_init(&g_event_bus.pending[priority], ring_capacity);
+    g_event_bus.merge_scratch = malloc(sizeof(RogueEvent*) * ring_capacity);
+    if (!rings_ok || !g_event_bus.merge_scratch)
+    {
+        EB_ERROR("Failed to allocate event bus pending rings");
+        for (int priority = 0; priority < ROGUE_EVENT_PRIORITY_COUNT; priority++)
+            free(g_event_bus.pending[priority].cells);
+        free(g_event_bus.merge_scratch);
+        if (g_event_bus.mutex)
+        {
+            rogue_event_mutex_destroy(g_event_bus.mutex);
+            free(g_event_bus.mutex);
+        }
+        memset(&g_event_bus, 0, sizeof(RogueEventBus));
+        return false;
+    }
+
     /* Initialize replay history if enabled (Phase 1.6.1) */
     if (config->enable_replay_recording && config->replay_history_depth > 0)
     {
         g_event_bus.replay_history = malloc(sizeof(RogueEvent*) * config->replay_history_depth);
         if (!g_event_bus.replay_history)
         {
-            ROGUE_LOG_ERROR("Failed to allocate replay history buffer");
+            EB_ERROR("Failed to allocate replay history buffer");
+            for (int priority = 0; priority < ROGUE_EVENT_PRIORITY_COUNT; priority++)
+                free(g_event_bus.pending[priority].cells);
+            free(g_event_bus.merge_scratch);
             if (g_event_bus.mutex)
             {
                 rogue_event_mutex_destroy(g_event_bus.mutex);
@@ -116,7 +192,7 @@ bool rogue_event_bus_init(const RogueEventBusConfig* config)
     /* Initialize configuration version manager (Phase 2.6) */
     if (!rogue_config_version_init("./config"))
     {
-        ROGUE_LOG_WARN("Failed to initialize configuration version manager, using fallback limits");
+        EB_WARN("Failed to initialize configuration version manager, using fallback limits");
     }
 
     /* Clear event type registry */
@@ -180,9 +256,9 @@ bool rogue_event_bus_init(const RogueEventBusConfig* config)
 
     g_event_bus.initialized = true;
 
-    ROGUE_LOG_INFO("Event bus '%s' initialized (Strategy: %d, Max Queue: %u, Threads: %u)",
-                   config->name, (int) config->processing_strategy, config->max_queue_size,
-                   config->worker_thread_count);
+    EB_INFO("Event bus '%s' initialized (Strategy: %d, Max Queue: %u, Threads: %u)",
+            config->name, (int) config->processing_strategy, config->max_queue_size,
+            config->worker_thread_count);
 
     return true;
 }
@@ -197,6 +273,7 @@ void rogue_event_bus_shutdown(void)
     event_bus_lock();
 
     /* Process any remaining events */
+    merge_pending_events();
     uint32_t remaining_events = 0;
     for (int priority = 0; priority < ROGUE_EVENT_PRIORITY_COUNT; priority++)
     {
@@ -210,8 +287,15 @@ void rogue_event_bus_shutdown(void)
 
     if (remaining_events > 0)
     {
-        ROGUE_LOG_WARN("Event bus shutdown with %u unprocessed events", remaining_events);
+        EB_WARN("Event bus shutdown with %u unprocessed events", remaining_events);
+    }
+    for (int priority = 0; priority < ROGUE_EVENT_PRIORITY_COUNT; priority++)
+    {
+        free(g_event_bus.pending[priority].cells);
+        g_event_bus.pending[priority].cells = NULL;
     }
+    free(g_event_bus.merge_scratch);
+    g_event_bus.merge_scratch = NULL;
 
     /* Clean up subscriptions */
     for (uint32_t type_idx = 0; type_idx < ROGUE_MAX_EVENT_TYPES; type_idx++)
@@ -250,9 +334,8 @@ void rogue_event_bus_shutdown(void)
         g_event_bus.mutex = NULL;
     }
 
-    ROGUE_LOG_INFO("Event bus '%s' shutdown complete (Processed: %llu events)",
-                   g_event_bus.config.name,
-                   (unsigned long long) g_event_bus.stats.events_processed);
+    EB_INFO("Event bus '%s' shutdown complete (Processed: %llu events)", g_event_bus.config.name,
+            (unsigned long long) g_event_bus.stats.events_processed);
 
     /* Clear the structure */
     memset(&g_event_bus, 0, sizeof(RogueEventBus));
@@ -279,30 +362,27 @@ bool rogue_event_publish_with_deadline(RogueEventTypeId type_id, const RogueEven
 {
     if (!g_event_bus.initialized)
     {
-        ROGUE_LOG_ERROR("Event bus not initialized");
+        EB_ERROR("Event bus not initialized");
         return false;
     }
 
     if (!payload)
     {
-        ROGUE_LOG_ERROR("Event payload is NULL");
+        EB_ERROR("Event payload is NULL");
         return false;
     }
 
     if (priority >= ROGUE_EVENT_PRIORITY_COUNT)
     {
-        ROGUE_LOG_ERROR("Invalid event priority: %d", priority);
+        EB_ERROR("Invalid event priority: %d", priority);
         return false;
     }
 
-    event_bus_lock();
-
-    /* Check queue capacity */
-    if (g_event_bus.total_queue_size >= g_event_bus.config.max_queue_size)
+    /* Reserve queue capacity (lock-free; no bus lock on the publish path) */
+    if (!reserve_queue_slots(1))
     {
-        event_bus_unlock();
-        ROGUE_LOG_WARN("Event queue full, dropping event type %u", type_id);
-        g_event_bus.stats.events_dropped++;
+        EB_WARN("Event queue full, dropping event type %u", type_id);
+        eb_add64(&g_event_bus.stats.events_dropped, 1);
         return false;
     }
 
@@ -310,10 +390,11 @@ bool rogue_event_publish_with_deadline(RogueEventTypeId type_id, const RogueEven
     RogueEvent* event = create_event(type_id, payload, priority, source_system_id, source_name);
     if (!event)
     {
-        event_bus_unlock();
-        ROGUE_LOG_ERROR("Failed to create event");
+        eb_add32(&g_event_bus.total_queue_size, 0u - 1u);
+        EB_ERROR("Failed to create event");
         return false;
     }
+    event->sequence_number = eb_add64(&g_event_bus.next_sequence_number, 1);
 
     /* Set deadline if specified */
     if (deadline_us > 0)
@@ -321,27 +402,20 @@ bool rogue_event_publish_with_deadline(RogueEventTypeId type_id, const RogueEven
         event->deadline_us = deadline_us;
     }
 
-    /* Enqueue event */
-    enqueue_event(event);
-
-    /* Record for replay if enabled */
+    /* Record for replay if enabled (before the push: once pushed the consumer owns the event) */
     if (g_event_bus.replay_recording_enabled)
     {
         record_event_for_replay(event);
     }
 
+    /* Enqueue event */
+    enqueue_event(event);
+
     /* Update statistics */
     update_statistics_on_publish();
 
-    event_bus_unlock();
-
-    ROGUE_LOG_DEBUG(
-        "Post-publish stats: total_queue_size=%u, current_queue_depth=%u, events_published=%llu",
-        g_event_bus.total_queue_size, g_event_bus.stats.current_queue_depth,
-        (unsigned long long) g_event_bus.stats.events_published);
-
-    ROGUE_LOG_DEBUG("Published event type %u from system %u (Queue depth: %u)", type_id,
-                    source_system_id, g_event_bus.total_queue_size);
+    EB_TRACE("Published event type %u from system %u (Queue depth: %u)", type_id, source_system_id,
+             eb_load32(&g_event_bus.total_queue_size));
 
     return true;
 }
@@ -350,31 +424,31 @@ bool rogue_event_publish_batch(const RogueEvent* events, uint32_t event_count)
 {
     if (!g_event_bus.initialized)
     {
-        ROGUE_LOG_ERROR("Event bus not initialized");
+        EB_ERROR("Event bus not initialized");
         return false;
     }
 
     if (!events || event_count == 0)
     {
-        ROGUE_LOG_ERROR("Invalid batch parameters");
+        EB_ERROR("Invalid batch parameters");
         return false;
     }
 
-    event_bus_lock();
-
-    /* Check if we have capacity for all events */
-    if (g_event_bus.total_queue_size + event_count > g_event_bus.config.max_queue_size)
+    /* Reserve capacity for all events at once; the batch gets a contiguous sequence range */
+    if (!reserve_queue_slots(event_count))
     {
-        event_bus_unlock();
-        ROGUE_LOG_WARN("Insufficient queue capacity for batch of %u events", event_count);
+        EB_WARN("Insufficient queue capacity for batch of %u events", event_count);
         return false;
     }
+    uint64_t sequence = eb_add64(&g_event_bus.next_sequence_number, (uint64_t) event_count);
 
     /* Process all events in batch */
     uint32_t successfully_queued = 0;
     for (uint32_t i = 0; i < event_count; i++)
     {
         const RogueEvent* source_event = &events[i];
+        if (source_event->priority >= ROGUE_EVENT_PRIORITY_COUNT)
+            continue;
 
         /* Create copy of event */
         RogueEvent* event =
@@ -382,26 +456,26 @@ bool rogue_event_publish_batch(const RogueEvent* events, uint32_t event_count)
                          source_event->source_system_id, source_event->source_name);
         if (event)
         {
+            event->sequence_number = sequence + i;
             event->deadline_us = source_event->deadline_us;
-            enqueue_event(event);
 
             if (g_event_bus.replay_recording_enabled)
             {
                 record_event_for_replay(event);
             }
 
+            enqueue_event(event);
             successfully_queued++;
         }
     }
+    if (successfully_queued < event_count)
+        eb_add32(&g_event_bus.total_queue_size, 0u - (event_count - successfully_queued));
 
     /* Update statistics */
-    g_event_bus.stats.events_published += successfully_queued;
-    g_event_bus.stats.current_queue_depth = g_event_bus.total_queue_size;
-
-    event_bus_unlock();
+    eb_add64(&g_event_bus.stats.events_published, (uint64_t) successfully_queued);
+    eb_store32(&g_event_bus.stats.current_queue_depth, eb_load32(&g_event_bus.total_queue_size));
 
-    ROGUE_LOG_DEBUG("Published batch: %u/%u events queued successfully", successfully_queued,
-                    event_count);
+    EB_TRACE("Published batch: %u/%u events queued successfully", successfully_queued, event_count);
 
     return successfully_queued == event_count;
 }
@@ -421,13 +495,13 @@ uint32_t rogue_event_subscribe_conditional(RogueEventTypeId type_id, RogueEventC
 {
     if (!g_event_bus.initialized)
     {
-        ROGUE_LOG_ERROR("Event bus not initialized");
+        EB_ERROR("Event bus not initialized");
         return 0;
     }
 
     if (!callback)
     {
-        ROGUE_LOG_ERROR("Event callback is NULL");
+        EB_ERROR("Event callback is NULL");
         return 0;
     }
 
@@ -438,7 +512,7 @@ uint32_t rogue_event_subscribe_conditional(RogueEventTypeId type_id, RogueEventC
     if (!subscription)
     {
         event_bus_unlock();
-        ROGUE_LOG_ERROR("Failed to allocate subscription");
+        EB_ERROR("Failed to allocate subscription");
         return 0;
     }
 
@@ -463,8 +537,8 @@ uint32_t rogue_event_subscribe_conditional(RogueEventTypeId type_id, RogueEventC
 
     event_bus_unlock();
 
-    ROGUE_LOG_DEBUG("System %u subscribed to event type %u (Subscription ID: %u)",
-                    subscriber_system_id, type_id, subscription->subscription_id);
+    EB_TRACE("System %u subscribed to event type %u (Subscription ID: %u)",
+             subscriber_system_id, type_id, subscription->subscription_id);
 
     return subscription->subscription_id;
 }
@@ -495,8 +569,8 @@ uint32_t rogue_event_subscribe_rate_limited(RogueEventTypeId type_id, RogueEvent
 
         event_bus_unlock();
 
-        ROGUE_LOG_DEBUG("Set rate limit %u/sec for subscription %u", rate_limit_per_second,
-                        subscription_id);
+        EB_TRACE("Set rate limit %u/sec for subscription %u", rate_limit_per_second,
+                 subscription_id);
     }
 
     return subscription_id;
@@ -523,9 +597,9 @@ bool rogue_event_unsubscribe(uint32_t subscription_id)
                 RogueEventSubscription* to_remove = *current;
                 *current = to_remove->next;
 
-                ROGUE_LOG_DEBUG("Unsubscribed subscription %u (System %u, Type %u)",
-                                subscription_id, to_remove->subscriber_system_id,
-                                to_remove->event_type_id);
+                EB_TRACE("Unsubscribed subscription %u (System %u, Type %u)",
+                         subscription_id, to_remove->subscriber_system_id,
+                         to_remove->event_type_id);
 
                 free(to_remove);
                 g_event_bus.subscription_count--;
@@ -539,7 +613,7 @@ bool rogue_event_unsubscribe(uint32_t subscription_id)
     }
 
     event_bus_unlock();
-    ROGUE_LOG_WARN("Subscription %u not found for unsubscribe", subscription_id);
+    EB_WARN("Subscription %u not found for unsubscribe", subscription_id);
     return false;
 }
 
@@ -582,7 +656,7 @@ void rogue_event_unsubscribe_system(uint32_t system_id)
 
     if (removed_count > 0)
     {
-        ROGUE_LOG_INFO("Unsubscribed %u subscriptions for system %u", removed_count, system_id);
+        EB_INFO("Unsubscribed %u subscriptions for system %u", removed_count, system_id);
     }
 }
 
@@ -599,12 +673,13 @@ uint32_t rogue_event_process_sync(uint32_t max_events, uint32_t time_budget_us)
     uint32_t processed_count = 0;
 
     event_bus_lock();
+    merge_pending_events();
 
     /* Process events by priority (Phase 1.3.1) */
     for (int priority = 0; priority < ROGUE_EVENT_PRIORITY_COUNT && processed_count < max_events;
          priority++)
     {
-        while (g_event_bus.event_queue_heads[priority] && processed_count < max_events)
+        while (processed_count < max_events && has_queued_events((RogueEventPriority) priority))
         {
             uint64_t current_time = rogue_event_get_timestamp_us();
 
@@ -621,8 +696,8 @@ uint32_t rogue_event_process_sync(uint32_t max_events, uint32_t time_budget_us)
             /* Check deadline (Phase 1.3.6) */
             if (event->deadline_us > 0 && current_time > event->deadline_us)
             {
-                ROGUE_LOG_WARN("Event type %u missed deadline by %llu microseconds", event->type_id,
-                               (unsigned long long) (current_time - event->deadline_us));
+                EB_WARN("Event type %u missed deadline by %llu microseconds", event->type_id,
+                        (unsigned long long) (current_time - event->deadline_us));
                 free_event(event);
                 g_event_bus.stats.events_failed++;
                 continue;
@@ -635,9 +710,9 @@ uint32_t rogue_event_process_sync(uint32_t max_events, uint32_t time_budget_us)
             bool event_processed = false;
             bool callback_invoked = false;
 
-            ROGUE_LOG_DEBUG("process_sync: begin event type=%u retries=%u max=%u priority=%d",
-                            event->type_id, (unsigned) event->retry_count,
-                            (unsigned) event->max_retries, (int) event->priority);
+            EB_TRACE("process_sync: begin event type=%u retries=%u max=%u priority=%d",
+                     event->type_id, (unsigned) event->retry_count,
+                     (unsigned) event->max_retries, (int) event->priority);
 
             for (;;)
             {
@@ -689,13 +764,11 @@ uint32_t rogue_event_process_sync(uint32_t max_events, uint32_t time_budget_us)
                         if (callback_result)
                         {
                             event_processed = true;
-                            ROGUE_LOG_DEBUG("process_sync: callback success for type=%u",
-                                            event->type_id);
+                            EB_TRACE("process_sync: callback success for type=%u", event->type_id);
                         }
                         else
                         {
-                            ROGUE_LOG_DEBUG("process_sync: callback failed for type=%u",
-                                            event->type_id);
+                            EB_TRACE("process_sync: callback failed for type=%u", event->type_id);
                         }
                     }
 
@@ -711,8 +784,7 @@ uint32_t rogue_event_process_sync(uint32_t max_events, uint32_t time_budget_us)
                     event->processed = true;
                     processed_count++;
                     free_event(event);
-                    ROGUE_LOG_DEBUG("process_sync: success finalize, processed_count=%u",
-                                    processed_count);
+                    EB_TRACE("process_sync: success finalize, processed_count=%u", processed_count);
                     break;
                 }
 
@@ -724,9 +796,8 @@ uint32_t rogue_event_process_sync(uint32_t max_events, uint32_t time_budget_us)
                     /* Do not call update_statistics_on_process, as it's not a success */
                     processed_count++;
                     free_event(event);
-                    ROGUE_LOG_DEBUG(
-                        "process_sync: no eligible subscriber, consumed, processed_count=%u",
-                        processed_count);
+                    EB_TRACE("process_sync: no eligible subscriber, consumed, processed_count=%u",
+                             processed_count);
                     break;
                 }
 
@@ -735,8 +806,8 @@ uint32_t rogue_event_process_sync(uint32_t max_events, uint32_t time_budget_us)
                 {
                     event->retry_count++;
                     /* Retry immediately within the same processing call */
-                    ROGUE_LOG_DEBUG("process_sync: retrying type=%u attempt=%u/%u", event->type_id,
-                                    (unsigned) event->retry_count, (unsigned) event->max_retries);
+                    EB_TRACE("process_sync: retrying type=%u attempt=%u/%u", event->type_id,
+                             (unsigned) event->retry_count, (unsigned) event->max_retries);
                     continue;
                 }
                 else
@@ -744,10 +815,10 @@ uint32_t rogue_event_process_sync(uint32_t max_events, uint32_t time_budget_us)
                     /* Exhausted retries: mark as failed and drop without incrementing processed */
                     event_bus_lock();
                     g_event_bus.stats.events_failed++;
+                    EB_TRACE("process_sync: exhausted retries for type=%u; dropping "
+                             "(processed_count=%u)",
+                             event->type_id, processed_count);
                     free_event(event);
-                    ROGUE_LOG_DEBUG("process_sync: exhausted retries for type=%u; dropping "
-                                    "(processed_count=%u)",
-                                    event->type_id, processed_count);
                     break;
                 }
             }
@@ -758,8 +829,8 @@ uint32_t rogue_event_process_sync(uint32_t max_events, uint32_t time_budget_us)
 
     if (processed_count > 0)
     {
-        ROGUE_LOG_DEBUG("Processed %u events in %llu microseconds", processed_count,
-                        (unsigned long long) (rogue_event_get_timestamp_us() - start_time));
+        EB_TRACE("Processed %u events in %llu microseconds", processed_count,
+                 (unsigned long long) (rogue_event_get_timestamp_us() - start_time));
     }
 
     return processed_count;
@@ -776,8 +847,9 @@ uint32_t rogue_event_process_priority(RogueEventPriority priority, uint32_t time
     uint32_t processed_count = 0;
 
     event_bus_lock();
+    merge_pending_events();
 
-    while (g_event_bus.event_queue_heads[priority])
+    while (has_queued_events(priority))
     {
         uint64_t current_time = rogue_event_get_timestamp_us();
 
@@ -816,13 +888,10 @@ uint32_t rogue_event_process_priority(RogueEventPriority priority, uint32_t time
                     }
 
                     invoked_this_attempt = true;
-                    if (event->type_id == ROGUE_EVENT_DAMAGE_DEALT)
-                    {
-                        fprintf(stderr,
-                                "[event_bus] invoking sub id=%u sys=%u for DAMAGE_DEALT pri=%d\n",
-                                (unsigned) sub->subscription_id,
-                                (unsigned) sub->subscriber_system_id, (int) event->priority);
-                    }
+                    EB_TRACE("process_priority: invoking sub id=%u sys=%u for type=%u pri=%d",
+                             (unsigned) sub->subscription_id,
+                             (unsigned) sub->subscriber_system_id, event->type_id,
+                             (int) event->priority);
                     if (sub->callback(event, sub->user_data))
                     {
                         event_processed = true;
@@ -874,7 +943,7 @@ bool rogue_event_process_async(uint32_t worker_count)
 {
     /* Async processing would require thread management - for now, stub implementation */
     (void) worker_count; /* Suppress unused parameter warning */
-    ROGUE_LOG_WARN("Async event processing not yet implemented");
+    EB_WARN("Async event processing not yet implemented");
     return false;
 }
 
@@ -887,11 +956,11 @@ const RogueEventBusStats* rogue_event_bus_get_stats(void)
         return NULL;
     }
 
-    ROGUE_LOG_DEBUG("get_stats: total_queue_size=%u, current_queue_depth=%u, "
-                    "events_published=%llu, events_processed=%llu",
-                    g_event_bus.total_queue_size, g_event_bus.stats.current_queue_depth,
-                    (unsigned long long) g_event_bus.stats.events_published,
-                    (unsigned long long) g_event_bus.stats.events_processed);
+    EB_TRACE("get_stats: total_queue_size=%u, current_queue_depth=%u, "
+             "events_published=%llu, events_processed=%llu",
+             eb_load32(&g_event_bus.total_queue_size), g_event_bus.stats.current_queue_depth,
+             (unsigned long long) g_event_bus.stats.events_published,
+             (unsigned long long) g_event_bus.stats.events_processed);
 
     return &g_event_bus.stats;
 }
@@ -908,7 +977,7 @@ void rogue_event_bus_reset_stats(void)
     g_event_bus.stats.active_subscribers = g_event_bus.subscription_count;
     event_bus_unlock();
 
-    ROGUE_LOG_INFO("Event bus statistics reset");
+    EB_INFO("Event bus statistics reset");
 }
 
 uint32_t rogue_event_bus_get_queue_depth(RogueEventPriority priority)
@@ -918,7 +987,7 @@ uint32_t rogue_event_bus_get_queue_depth(RogueEventPriority priority)
         return 0;
     }
 
-    return g_event_bus.queue_sizes[priority];
+    return eb_load32(&g_event_bus.queue_sizes[priority]);
 }
 
 bool rogue_event_bus_is_overloaded(void)
@@ -928,7 +997,8 @@ bool rogue_event_bus_is_overloaded(void)
         return false;
     }
 
-    return g_event_bus.total_queue_size >= (g_event_bus.config.max_queue_size * 0.9f);
+    return (float) eb_load32(&g_event_bus.total_queue_size) >=
+           ((float) g_event_bus.config.max_queue_size * 0.9f);
 }
 
 /* ===== Event Type Registry Implementation ===== */
@@ -937,7 +1007,7 @@ bool rogue_event_register_type(RogueEventTypeId type_id, const char* type_name)
 {
     if (!type_name)
     {
-        ROGUE_LOG_ERROR("Event type name is NULL");
+        EB_ERROR("Event type name is NULL");
         return false;
     }
 
@@ -945,8 +1015,8 @@ bool rogue_event_register_type(RogueEventTypeId type_id, const char* type_name)
     {
         if (g_event_type_registered[type_id])
         {
-            ROGUE_LOG_WARN("Event type %u already registered as '%s'", type_id,
-                           g_event_type_names[type_id]);
+            EB_WARN("Event type %u already registered as '%s'", type_id,
+                    g_event_type_names[type_id]);
             return true;
         }
 #ifdef _MSC_VER
@@ -957,7 +1027,7 @@ bool rogue_event_register_type(RogueEventTypeId type_id, const char* type_name)
         g_event_type_names[type_id][sizeof(g_event_type_names[type_id]) - 1] = '\0';
 #endif
         g_event_type_registered[type_id] = true;
-        ROGUE_LOG_DEBUG("Registered event type %u: '%s'", type_id, type_name);
+        EB_TRACE("Registered event type %u: '%s'", type_id, type_name);
         return true;
     }
 
@@ -984,12 +1054,11 @@ bool rogue_event_register_type(RogueEventTypeId type_id, const char* type_name)
             g_event_type_overflow[i].name[sizeof(g_event_type_overflow[i].name) - 1] = '\0';
 #endif
             g_event_type_overflow[i].used = true;
-            ROGUE_LOG_DEBUG("Registered overflow event type %u: '%s'", type_id, type_name);
+            EB_TRACE("Registered overflow event type %u: '%s'", type_id, type_name);
             return true;
         }
     }
-    ROGUE_LOG_ERROR("Event type overflow registry full; cannot register id %u ('%s')", type_id,
-                    type_name);
+    EB_ERROR("Event type overflow registry full; cannot register id %u ('%s')", type_id, type_name);
     return false;
 }
 
@@ -1034,7 +1103,7 @@ bool rogue_event_bus_update_config(const RogueEventBusConfig* new_config)
 
     event_bus_unlock();
 
-    ROGUE_LOG_INFO("Event bus configuration updated");
+    EB_INFO("Event bus configuration updated");
     return true;
 }
 
@@ -1054,7 +1123,7 @@ void rogue_event_bus_set_replay_recording(bool enabled)
     g_event_bus.replay_recording_enabled = enabled && (g_event_bus.replay_history != NULL);
     event_bus_unlock();
 
-    ROGUE_LOG_INFO("Event replay recording %s", enabled ? "enabled" : "disabled");
+    EB_INFO("Event replay recording %s", enabled ? "enabled" : "disabled");
 }
 
 const RogueEvent** rogue_event_bus_get_replay_history(uint32_t* history_size)
@@ -1073,7 +1142,7 @@ bool rogue_event_bus_replay_events(uint32_t start_index, uint32_t count)
     /* Replay implementation would be complex - stub for now */
     (void) start_index; /* Suppress unused parameter warning */
     (void) count;       /* Suppress unused parameter warning */
-    ROGUE_LOG_WARN("Event replay not yet implemented");
+    EB_WARN("Event replay not yet implemented");
     return false;
 }
 
@@ -1097,10 +1166,11 @@ void rogue_event_bus_clear_replay_history(void)
 
     g_event_bus.replay_history_size = 0;
     g_event_bus.replay_history_index = 0;
+    g_event_bus.replay_cursor = 0;
 
     event_bus_unlock();
 
-    ROGUE_LOG_INFO("Event replay history cleared");
+    EB_INFO("Event replay history cleared");
 }
 
 /* ===== Utility Functions Implementation ===== */
@@ -1200,7 +1270,6 @@ static RogueEvent* create_event(RogueEventTypeId type_id, const RogueEventPayloa
     event->payload = *payload;
     event->source_system_id = source_system_id;
     event->timestamp_us = rogue_event_get_timestamp_us();
-    event->sequence_number = g_event_bus.next_sequence_number++;
     event->max_retries = 3; /* Default retry count */
 
     if (source_name)
@@ -1224,43 +1293,148 @@ static void free_event(RogueEvent* event)
     }
 }
 
-static void enqueue_event(RogueEvent* event)
+static bool ring_init(RogueEventRing* ring, uint32_t capacity)
 {
-    if (!event || event->priority >= ROGUE_EVENT_PRIORITY_COUNT)
+    ring->cells = malloc(sizeof(RogueEventRingCell) * capacity);
+    if (!ring->cells)
+        return false;
+    for (uint32_t i = 0; i < capacity; i++)
     {
-        return;
+        ring->cells[i].turn = i;
+        ring->cells[i].event = NULL;
+    }
+    ring->mask = capacity - 1;
+    ring->tail = 0;
+    ring->head = 0;
+    return true;
+}
+
+/* Producer side: claim the tail cell, then publish it by advancing its turn. A cell whose turn
+   lags its position still holds an event the consumer has not popped (ring full). */
+static bool ring_push(RogueEventRing* ring, RogueEvent* event)
+{
+    uint64_t pos = eb_load64(&ring->tail);
+    for (;;)
+    {
+        RogueEventRingCell* cell = &ring->cells[pos & ring->mask];
+        int64_t lag = (int64_t) (eb_load64(&cell->turn) - pos);
+        if (lag == 0)
+        {
+            if (eb_cas64(&ring->tail, pos, pos + 1))
+            {
+                cell->event = event;
+                eb_store64(&cell->turn, pos + 1);
+                return true;
+            }
+        }
+        else if (lag < 0)
+        {
+            return false;
+        }
+        eb_add64(&g_event_bus.stats.publish_cas_retries, 1);
+        pos = eb_load64(&ring->tail);
     }
+}
 
-    event->next = NULL;
+/* Consumer side (bus lock held): pop the head cell once its producer has published it. */
+static RogueEvent* ring_pop(RogueEventRing* ring)
+{
+    RogueEventRingCell* cell = &ring->cells[ring->head & ring->mask];
+    if (eb_load64(&cell->turn) != ring->head + 1)
+        return NULL;
+    RogueEvent* event = cell->event;
+    eb_store64(&cell->turn, ring->head + ring->mask + 1);
+    ring->head++;
+    return event;
+}
 
-    if (g_event_bus.event_queue_tails[event->priority])
+/* Admission control for count events against max_queue_size. */
+static bool reserve_queue_slots(uint32_t count)
+{
+    uint32_t depth = eb_add32(&g_event_bus.total_queue_size, count) + count;
+    if (depth > g_event_bus.config.max_queue_size)
     {
-        g_event_bus.event_queue_tails[event->priority]->next = event;
+        eb_add32(&g_event_bus.total_queue_size, 0u - count);
+        return false;
     }
-    else
+    uint32_t peak = eb_load32(&g_event_bus.stats.max_queue_depth_reached);
+    while (depth > peak)
+    {
+        if (eb_cas32(&g_event_bus.stats.max_queue_depth_reached, peak, depth))
+            break;
+        peak = eb_load32(&g_event_bus.stats.max_queue_depth_reached);
+    }
+    return true;
+}
+
+/* Push an admitted event onto its priority's pending ring. */
+static void enqueue_event(RogueEvent* event)
+{
+    event->next = NULL;
+    eb_add32(&g_event_bus.queue_sizes[event->priority], 1u);
+    if (!ring_push(&g_event_bus.pending[event->priority], event))
     {
-        g_event_bus.event_queue_heads[event->priority] = event;
+        /* Unreachable while admission holds total depth under the ring capacity */
+        eb_add32(&g_event_bus.queue_sizes[event->priority], 0u - 1u);
+        eb_add32(&g_event_bus.total_queue_size, 0u - 1u);
+        eb_add64(&g_event_bus.stats.events_dropped, 1);
+        free_event(event);
     }
+}
 
-    g_event_bus.event_queue_tails[event->priority] = event;
-    g_event_bus.queue_sizes[event->priority]++;
-    g_event_bus.total_queue_size++;
+static int compare_event_sequence(const void* a, const void* b)
+{
+    uint64_t x = (*(RogueEvent* const*) a)->sequence_number;
+    uint64_t y = (*(RogueEvent* const*) b)->sequence_number;
+    return (x > y) - (x < y);
+}
 
-    /* Update max queue depth statistic */
-    if (g_event_bus.total_queue_size > g_event_bus.stats.max_queue_depth_reached)
+/* Consumer side (bus lock held): move every published ring entry onto the per-priority lists.
+   Producers that race each other can land in a ring out of sequence order, so each drained
+   batch is sorted by sequence number before it is appended; processing then walks the lists
+   in (priority, sequence) order. Returns the number of events moved. */
+static uint32_t merge_pending_events(void)
+{
+    uint32_t moved = 0;
+    for (int priority = 0; priority < ROGUE_EVENT_PRIORITY_COUNT; priority++)
     {
-        g_event_bus.stats.max_queue_depth_reached = g_event_bus.total_queue_size;
+        RogueEventRing* ring = &g_event_bus.pending[priority];
+        if (!ring->cells)
+            continue;
+        uint32_t n = 0;
+        RogueEvent* event;
+        while (n <= ring->mask && (event = ring_pop(ring)) != NULL)
+            g_event_bus.merge_scratch[n++] = event;
+        if (n == 0)
+            continue;
+        if (n > 1)
+            qsort(g_event_bus.merge_scratch, n, sizeof(RogueEvent*), compare_event_sequence);
+        for (uint32_t i = 0; i < n; i++)
+        {
+            event = g_event_bus.merge_scratch[i];
+            if (g_event_bus.event_queue_tails[priority])
+                g_event_bus.event_queue_tails[priority]->next = event;
+            else
+                g_event_bus.event_queue_heads[priority] = event;
+            g_event_bus.event_queue_tails[priority] = event;
+        }
+        moved += n;
     }
+    if (moved > 0)
+    {
+        g_event_bus.stats.merge_batches++;
+        if (moved > g_event_bus.stats.max_merge_batch)
+            g_event_bus.stats.max_merge_batch = moved;
+    }
+    return moved;
+}
 
-    /* Keep current queue depth stat in sync on enqueue as well */
-    g_event_bus.stats.current_queue_depth = g_event_bus.total_queue_size;
-
-    /* Debug tracing to validate queue depth updates */
-    ROGUE_LOG_DEBUG("enqueue_event: priority=%d, queue_sizes[%d]=%u, total_queue_size=%u, "
-                    "current_queue_depth=%u",
-                    (int) event->priority, (int) event->priority,
-                    g_event_bus.queue_sizes[event->priority], g_event_bus.total_queue_size,
-                    g_event_bus.stats.current_queue_depth);
+/* Consumer side (bus lock held). An empty list re-merges first so events published by callbacks
+   during processing are picked up in the same call, as they were with the locked list queues. */
+static bool has_queued_events(RogueEventPriority priority)
+{
+    return g_event_bus.event_queue_heads[priority] ||
+           (merge_pending_events() > 0 && g_event_bus.event_queue_heads[priority]);
 }
 
 static RogueEvent* dequeue_event(RogueEventPriority priority)
@@ -1278,14 +1452,16 @@ static RogueEvent* dequeue_event(RogueEventPriority priority)
         g_event_bus.event_queue_tails[priority] = NULL;
     }
 
-    g_event_bus.queue_sizes[priority]--;
-    g_event_bus.total_queue_size--;
-    g_event_bus.stats.current_queue_depth = g_event_bus.total_queue_size;
+    eb_add32(&g_event_bus.queue_sizes[priority], 0u - 1u);
+    uint32_t depth = eb_add32(&g_event_bus.total_queue_size, 0u - 1u) - 1u;
+    eb_store32(&g_event_bus.stats.current_queue_depth, depth);
 
     event->next = NULL;
     return event;
 }
 
+/* Lock-free: each publisher claims the next history slot from replay_cursor and swaps its copy
+   in, freeing whatever the slot held one lap earlier. */
 static void record_event_for_replay(const RogueEvent* event)
 {
     if (!g_event_bus.replay_history || !event)
@@ -1303,26 +1479,25 @@ static void record_event_for_replay(const RogueEvent* event)
     *replay_event = *event;
     replay_event->next = NULL;
 
-    /* Free old event if history buffer is full */
-    if (g_event_bus.replay_history[g_event_bus.replay_history_index])
+    uint32_t depth = g_event_bus.config.replay_history_depth;
+    uint64_t slot = eb_add64(&g_event_bus.replay_cursor, 1);
+    RogueEvent* old = eb_xchg_ptr(&g_event_bus.replay_history[slot % depth], replay_event);
+    if (old)
     {
-        free_event(g_event_bus.replay_history[g_event_bus.replay_history_index]);
+        free_event(old);
     }
 
-    g_event_bus.replay_history[g_event_bus.replay_history_index] = replay_event;
-    g_event_bus.replay_history_index =
-        (g_event_bus.replay_history_index + 1) % g_event_bus.config.replay_history_depth;
-
-    if (g_event_bus.replay_history_size < g_event_bus.config.replay_history_depth)
+    eb_store32(&g_event_bus.replay_history_index, (uint32_t) ((slot + 1) % depth));
+    if (slot < depth)
     {
-        g_event_bus.replay_history_size++;
+        eb_add32(&g_event_bus.replay_history_size, 1u);
     }
 }
 
 static void update_statistics_on_publish(void)
 {
-    g_event_bus.stats.events_published++;
-    g_event_bus.stats.current_queue_depth = g_event_bus.total_queue_size;
+    eb_add64(&g_event_bus.stats.events_published, 1);
+    eb_store32(&g_event_bus.stats.current_queue_depth, eb_load32(&g_event_bus.total_queue_size));
 }
 
 static void update_statistics_on_process(const RogueEvent* event, uint64_t processing_time_us)
@@ -37,6 +37,11 @@ extern "C"
         double average_latency_us;
         double peak_latency_us;
         uint32_t active_subscribers;
+
+        /* Publish-side contention (lock-free pending rings) */
+        uint64_t publish_cas_retries; /* producer CAS losses / rereads on a ring tail */
+        uint64_t merge_batches;       /* process-time drains that moved at least one event */
+        uint32_t max_merge_batch;     /* most events moved by a single drain */
     } RogueEventBusStats;
 
     /* Event Priority Levels (Phase 1.3.1) */
@@ -304,6 +309,23 @@ extern "C"
         struct RogueEventSubscription* next;
     } RogueEventSubscription;
 
+    /* Bounded multi-producer / single-consumer ring (one per priority). Producers claim a cell
+       by CAS on tail and publish it by bumping the cell's turn; the consumer, holding the bus
+       lock, pops from head. */
+    typedef struct
+    {
+        uint64_t turn;
+        RogueEvent* event;
+    } RogueEventRingCell;
+
+    typedef struct
+    {
+        RogueEventRingCell* cells;
+        uint32_t mask; /* capacity - 1 (power of two) */
+        uint64_t tail; /* next cell producers claim */
+        uint64_t head; /* next cell the consumer pops */
+    } RogueEventRing;
+
     /* Event Bus Configuration (Phase 1.1.7) */
     typedef struct
     {
@@ -323,9 +345,13 @@ extern "C"
     {
         RogueEventBusConfig config;
 
-        /* Event queue management */
+        /* Event queue management. Publishers push into the lock-free pending rings; processing
+           merges them into the per-priority lists in sequence order. The sizes count both and
+           are updated atomically. */
         RogueEvent* event_queue_heads[ROGUE_EVENT_PRIORITY_COUNT];
         RogueEvent* event_queue_tails[ROGUE_EVENT_PRIORITY_COUNT];
+        RogueEventRing pending[ROGUE_EVENT_PRIORITY_COUNT];
+        RogueEvent** merge_scratch; /* one ring's worth, consumer only */
         uint32_t queue_sizes[ROGUE_EVENT_PRIORITY_COUNT];
         uint32_t total_queue_size;
 
@@ -345,6 +371,7 @@ extern "C"
         RogueEvent** replay_history;
         uint32_t replay_history_size;
         uint32_t replay_history_index;
+        uint64_t replay_cursor; /* total recorded; producers claim slots from it */
         bool replay_recording_enabled;
 
         /* Sequence number generation */
@@ -377,7 +404,8 @@ extern "C"
 
     /**
      * Publish an event to the bus
-     * Returns true if event was queued successfully
+     * Returns true if event was queued successfully. Safe to call from any thread without
+     * taking the bus lock; events become visible to processing at its next merge.
      */
     bool rogue_event_publish(RogueEventTypeId type_id, const RogueEventPayload* payload,
                              RogueEventPriority priority, uint32_t source_system_id,
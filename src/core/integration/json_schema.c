@@ -36,24 +36,6 @@ static void add_validation_error(RogueSchemaValidationResult* result, RogueSchem
     result->is_valid = false;
 }
 
-static const RogueJsonValue* json_schema_object_get(const RogueJsonValue* object, const char* key)
-{
-    if (!object || object->type != JSON_OBJECT)
-    {
-        return NULL;
-    }
-
-    for (size_t i = 0; i < object->data.object_value.count; i++)
-    {
-        if (strcmp(object->data.object_value.keys[i], key) == 0)
-        {
-            return object->data.object_value.values[i];
-        }
-    }
-
-    return NULL;
-}
-
 static bool json_value_matches_type(const RogueJsonValue* value, RogueSchemaType schema_type)
 {
     if (!value)
@@ -428,7 +410,7 @@ bool rogue_schema_validate_json(const RogueSchema* schema, const RogueJsonValue*
     for (uint32_t i = 0; i < schema->field_count; i++)
     {
         const RogueSchemaField* field = &schema->fields[i];
-        const RogueJsonValue* value = json_schema_object_get(json, field->name);
+        const RogueJsonValue* value = json_object_get(json, field->name);
 
         char field_path[ROGUE_SCHEMA_MAX_PATH_LENGTH];
         snprintf(field_path, sizeof(field_path), "%s", field->name);
@@ -1,6 +1,6 @@
 #include "inventory_entries.h"
 #include "../persistence/save_manager.h" /* mark component dirty for incremental saves */
-#include "inventory_query.h"             /* Phase 4.6 cache invalidation */
+#include "inventory_query.h"             /* Phase 4.6 query index / cache upkeep */
 #include "inventory_tag_rules.h"         /* Phase 3.3 auto-tag rules */
 #include <stdlib.h>
 #include <string.h>
@@ -62,6 +62,7 @@ int rogue_inventory_entries_init(void)
     g_entry_cap_soft = 1024;
     g_cap_handler = NULL;
     dirty_clear();
+    rogue_inventory_query_cache_invalidate_all();
     return 0;
 }
 int rogue_inventory_set_unique_cap(unsigned cap)
@@ -152,8 +153,8 @@ int rogue_inventory_register_pickup(int def_index, uint64_t add_qty)
             return -1;
         g_entries[g_entry_count++] = (InvEntry){def_index, add_qty, 0u};
         dirty_mark(def_index);
+        rogue_inventory_query_on_quantity_change(def_index, add_qty);
         rogue_inv_tag_rules_apply_def(def_index);
-        rogue_inventory_query_cache_invalidate_all();
         return 0;
     }
     uint64_t before = g_entries[idx].qty;
@@ -161,7 +162,7 @@ int rogue_inventory_register_pickup(int def_index, uint64_t add_qty)
     if (g_entries[idx].qty != before)
     {
         dirty_mark(def_index);
-        rogue_inventory_query_cache_invalidate_all();
+        rogue_inventory_query_on_quantity_change(def_index, g_entries[idx].qty);
     }
     return 0;
 }
@@ -180,7 +181,7 @@ int rogue_inventory_register_remove(int def_index, uint64_t remove_qty)
     if (g_entries[idx].qty != before)
     {
         dirty_mark(def_index);
-        rogue_inventory_query_cache_invalidate_all();
+        rogue_inventory_query_on_quantity_change(def_index, g_entries[idx].qty);
     }
     if (g_entries[idx].qty == 0)
     {
@@ -189,7 +190,6 @@ int rogue_inventory_register_remove(int def_index, uint64_t remove_qty)
             g_entries[idx] = g_entries[last];
         g_entry_count--;
         dirty_mark(def_index);
-        rogue_inventory_query_cache_invalidate_all();
     }
     return 0;
 }
@@ -123,7 +123,23 @@ static void lex_next(Lexer* L)
     L->s++;
 }
 
-/* ---- AST ---- */
+/* Parser diagnostics (simple last-error string) */
+static char g_last_parse_error[64];
+static void set_parse_error(const char* msg)
+{
+#if defined(_MSC_VER)
+    strncpy_s(g_last_parse_error, sizeof g_last_parse_error, msg, _TRUNCATE);
+#else
+    strncpy(g_last_parse_error, msg, sizeof g_last_parse_error - 1);
+    g_last_parse_error[sizeof g_last_parse_error - 1] = '\0';
+#endif
+}
+const char* rogue_inventory_query_last_error(void) { return g_last_parse_error; }
+
+/* ---- Compiled plan ----
+ * The expression compiles once into a postfix program over predicate slots. Parse failures inside
+ * a factor compile to OP_ALL (match every owned definition), as the tree evaluator always did, and
+ * leave a diagnostic in the last-error string. */
 typedef enum
 {
     PRED_RARITY,
@@ -154,25 +170,62 @@ typedef struct Predicate
     char str_val[24];
 } Predicate;
 
-typedef struct Node Node;
-typedef struct NodeList NodeList;
-struct Node
-{
-    int is_pred;
-    Predicate pred;
-    Node* left;
-    Node* right;
-    int is_or;
+typedef enum
+{
+    OP_PRED,
+    OP_ALL,
+    OP_AND,
+    OP_OR
+} PlanOpKind;
+typedef struct PlanOp
+{
+    unsigned char kind;
+    unsigned char pred;
+} PlanOp;
+
+/* Dependency mask: which index columns a plan reads (drives selective cache maintenance). */
+#define PLAN_DEP_QTY 0x1u
+#define PLAN_DEP_TAG 0x2u
+#define PLAN_DEP_INSTANCE 0x4u
+
+struct RogueInvQueryPlan
+{
+    int op_count;
+    int pred_count;
+    int operand_count;
+    unsigned deps;
+    PlanOp ops[2 * ROGUE_INV_QUERY_MAX_TERMS];
+    Predicate preds[ROGUE_INV_QUERY_MAX_TERMS];
 };
 
-static Node* alloc_node(void)
+typedef struct Compiler
 {
-    Node* n = (Node*) calloc(1, sizeof(Node));
-    return n;
+    Lexer L;
+    RogueInvQueryPlan* plan;
+    int overflow;
+} Compiler;
+
+static void emit(Compiler* C, PlanOpKind kind, int pred)
+{
+    RogueInvQueryPlan* p = C->plan;
+    if (kind == OP_PRED || kind == OP_ALL)
+    {
+        if (p->operand_count >= ROGUE_INV_QUERY_MAX_TERMS)
+        {
+            C->overflow = 1;
+            return;
+        }
+        p->operand_count++;
+    }
+    if (C->overflow)
+        return;
+    p->ops[p->op_count].kind = (unsigned char) kind;
+    p->ops[p->op_count].pred = (unsigned char) pred;
+    p->op_count++;
 }
 
 /* Forward declarations */
-static Node* parse_expr(Lexer* L);
+static void compile_expr(Compiler* C);
 
 static int match_ident(const char* s, PredField* out_field)
 {
@@ -238,27 +291,53 @@ static CmpOp op_from(const char* s)
     return CMP_EQ;
 }
 
-static Node* parse_factor(Lexer* L)
+static unsigned pred_deps(PredField f)
 {
+    switch (f)
+    {
+    case PRED_QTY:
+        return PLAN_DEP_QTY;
+    case PRED_TAG:
+        return PLAN_DEP_TAG;
+    case PRED_AFFIX_WEIGHT:
+    case PRED_QUALITY:
+    case PRED_DUR_PCT:
+        return PLAN_DEP_INSTANCE;
+    default:
+        return 0; /* definition attributes: fixed while owned */
+    }
+}
+
+static void compile_factor(Compiler* C)
+{
+    Lexer* L = &C->L;
     if (L->cur.type == TK_LPAREN)
     {
         lex_next(L);
-        Node* e = parse_expr(L);
+        compile_expr(C);
         if (L->cur.type == TK_RPAREN)
             lex_next(L);
-        return e;
+        else
+            set_parse_error("missing ')'");
+        return;
     }
     if (L->cur.type == TK_IDENT)
     {
         PredField f;
         if (!match_ident(L->cur.text, &f))
         {
+            set_parse_error("unknown field");
             lex_next(L);
-            return NULL;
+            emit(C, OP_ALL, 0);
+            return;
         }
         lex_next(L);
         if (L->cur.type != TK_OP)
-            return NULL;
+        {
+            set_parse_error("expected operator");
+            emit(C, OP_ALL, 0);
+            return;
+        }
         CmpOp op = op_from(L->cur.op);
         lex_next(L);
         Predicate p;
@@ -273,66 +352,77 @@ static Node* parse_factor(Lexer* L)
         else if (L->cur.type == TK_IDENT || L->cur.type == TK_STRING)
         {
 #if defined(_MSC_VER)
-            strncpy_s(p.str_val, sizeof p.str_val,
-                      (L->cur.type == TK_STRING ? L->cur.text : L->cur.text), _TRUNCATE);
+            strncpy_s(p.str_val, sizeof p.str_val, L->cur.text, _TRUNCATE);
 #else
-            strncpy(p.str_val, (L->cur.type == TK_STRING ? L->cur.text : L->cur.text),
-                    sizeof p.str_val - 1);
+            strncpy(p.str_val, L->cur.text, sizeof p.str_val - 1);
             p.str_val[sizeof p.str_val - 1] = '\0';
 #endif
             lex_next(L);
         }
-        Node* n = alloc_node();
-        n->is_pred = 1;
-        n->pred = p;
-        return n;
+        RogueInvQueryPlan* plan = C->plan;
+        if (plan->pred_count >= ROGUE_INV_QUERY_MAX_TERMS)
+        {
+            C->overflow = 1;
+            return;
+        }
+        plan->preds[plan->pred_count] = p;
+        plan->deps |= pred_deps(f);
+        emit(C, OP_PRED, plan->pred_count++);
+        return;
     }
-    return NULL;
+    set_parse_error("expected predicate or '('");
+    emit(C, OP_ALL, 0);
 }
 
-static Node* parse_term(Lexer* L)
+static void compile_term(Compiler* C)
 {
-    Node* left = parse_factor(L);
-    while (L->cur.type == TK_IDENT && (strcmp(L->cur.text, "and") == 0))
+    compile_factor(C);
+    while (C->L.cur.type == TK_IDENT && (strcmp(C->L.cur.text, "and") == 0))
     {
-        lex_next(L);
-        Node* right = parse_factor(L);
-        Node* parent = alloc_node();
-        parent->left = left;
-        parent->right = right;
-        parent->is_or = 0;
-        left = parent;
-    }
-    return left;
+        lex_next(&C->L);
+        compile_factor(C);
+        emit(C, OP_AND, 0);
+    }
 }
-static Node* parse_expr(Lexer* L)
+static void compile_expr(Compiler* C)
 {
-    Node* left = parse_term(L);
-    while (L->cur.type == TK_IDENT && (strcmp(L->cur.text, "or") == 0))
+    compile_term(C);
+    while (C->L.cur.type == TK_IDENT && (strcmp(C->L.cur.text, "or") == 0))
     {
-        lex_next(L);
-        Node* right = parse_term(L);
-        Node* parent = alloc_node();
-        parent->left = left;
-        parent->right = right;
-        parent->is_or = 1;
-        left = parent;
-    }
-    return left;
+        lex_next(&C->L);
+        compile_term(C);
+        emit(C, OP_OR, 0);
+    }
 }
 
-static Node* parse(const char* s)
+RogueInvQueryPlan* rogue_inventory_query_compile(const char* expr)
 {
-    Lexer L = {s, {0}};
-    lex_next(&L);
-    return parse_expr(&L);
+    set_parse_error("");
+    if (!expr || !*expr)
+    {
+        set_parse_error("empty query");
+        return NULL;
+    }
+    Compiler C;
+    memset(&C, 0, sizeof C);
+    C.plan = (RogueInvQueryPlan*) calloc(1, sizeof(RogueInvQueryPlan));
+    if (!C.plan)
+        return NULL;
+    C.L.s = expr;
+    lex_next(&C.L);
+    compile_expr(&C);
+    if (C.overflow)
+    {
+        set_parse_error("too many predicates");
+        free(C.plan);
+        return NULL;
+    }
+    return C.plan;
 }
 
+void rogue_inventory_query_plan_free(RogueInvQueryPlan* plan) { free(plan); }
+
 /* ---- Evaluation helpers ---- */
-static int icase_eq(char a, char b)
-{
-    return tolower((unsigned char) a) == tolower((unsigned char) b);
-}
 static int icase_strstr(const char* hay, const char* needle)
 {
     if (!*needle)
@@ -367,21 +457,16 @@ static int category_from_string(const char* s)
     return -1;
 }
 
-static int equip_slot_matches_category(const char* slot_str, int category)
+static int equip_slot_category(const char* slot_str)
 { /* heuristic mapping */
     if (icase_strstr(slot_str, "weapon"))
-        return category == ROGUE_ITEM_WEAPON;
+        return ROGUE_ITEM_WEAPON;
     if (icase_strstr(slot_str, "armor") || icase_strstr(slot_str, "helm") ||
         icase_strstr(slot_str, "chest") || icase_strstr(slot_str, "legs") ||
         icase_strstr(slot_str, "ring") || icase_strstr(slot_str, "amulet") ||
         icase_strstr(slot_str, "belt") || icase_strstr(slot_str, "cloak"))
-        return category == ROGUE_ITEM_ARMOR;
-    return category == ROGUE_ITEM_MISC;
-}
-
-static int def_has_tag(int def_index, const char* tag)
-{
-    return rogue_inv_tags_has(def_index, tag);
+        return ROGUE_ITEM_ARMOR;
+    return ROGUE_ITEM_MISC;
 }
 
 static int compare_int(int lhs, int rhs, CmpOp op)
@@ -405,151 +490,381 @@ static int compare_int(int lhs, int rhs, CmpOp op)
     }
 }
 
-static int eval_predicate(const Predicate* p, int def_index)
+/* ---- Column index ----
+ * One bit per definition index. Owned definitions (quantity > 0) carry their quantity, rarity and
+ * category in value columns: small values (0..QBUCKETS-1) get one bitset per value so a comparison
+ * is an OR of whole words, larger values fall back to a per-definition compare. Tags map to one
+ * bitset per distinct tag string. Entries / tags keep the index current through the hooks below;
+ * the index is rebuilt from scratch only after rogue_inventory_query_cache_invalidate_all. */
+#define QWORDS ((ROGUE_ITEM_DEF_CAP + 63) / 64)
+#define QBUCKETS 8
+#define QTAGS 64
+
+typedef struct ValueColumn
 {
-    int qty = (int) rogue_inventory_quantity(def_index);
-    const RogueItemDef* d = NULL;
-    switch (p->field)
-    {
-    case PRED_QTY:
-        return compare_int(qty, p->int_val, p->op);
-    case PRED_RARITY:
-        d = rogue_item_def_at(def_index);
-        if (!d)
-            return 0;
-        return compare_int(d->rarity, p->int_val, p->op);
-    case PRED_CATEGORY:
+    uint64_t eq[QBUCKETS][QWORDS];
+    uint64_t wide[QWORDS];
+    int value[ROGUE_ITEM_DEF_CAP];
+} ValueColumn;
+
+static int g_index_dirty = 1;
+static uint64_t g_owned[QWORDS];
+static uint64_t g_has_def[QWORDS]; /* owned and backed by a loaded definition */
+static ValueColumn g_qty_col, g_rarity_col, g_category_col;
+static char g_tag_names[QTAGS][ROGUE_INV_TAG_SHORT_LEN];
+static uint64_t g_tag_bits[QTAGS][QWORDS];
+static int g_tag_count = 0;
+static int g_tag_overflow = 0; /* more distinct tags than QTAGS: evaluate tags per definition */
+
+static int next_bit(uint64_t* bits)
+{
+    uint64_t b = *bits;
+#if defined(__GNUC__) || defined(__clang__)
+    int i = __builtin_ctzll(b);
+#else
+    int i = 0;
+    while (!((b >> i) & 1u))
+        i++;
+#endif
+    *bits = b & (b - 1);
+    return i;
+}
+
+static void column_clear(ValueColumn* c, int d)
+{
+    uint64_t mask = ~(1ull << (d & 63));
+    int w = d >> 6;
+    for (int v = 0; v < QBUCKETS; v++)
+        c->eq[v][w] &= mask;
+    c->wide[w] &= mask;
+}
+static void column_set(ValueColumn* c, int d, int value)
+{
+    column_clear(c, d);
+    c->value[d] = value;
+    if (value >= 0 && value < QBUCKETS)
+        c->eq[value][d >> 6] |= 1ull << (d & 63);
+    else
+        c->wide[d >> 6] |= 1ull << (d & 63);
+}
+static void column_eval(const ValueColumn* c, CmpOp op, int rhs, int lo, int hi, uint64_t* out)
+{
+    for (int w = lo; w < hi; w++)
+        out[w] = 0;
+    for (int v = 0; v < QBUCKETS; v++)
+        if (compare_int(v, rhs, op))
+            for (int w = lo; w < hi; w++)
+                out[w] |= c->eq[v][w];
+    for (int w = lo; w < hi; w++)
     {
-        d = rogue_item_def_at(def_index);
-        if (!d)
-            return 0;
-        int cat = -1;
-        if (p->str_val[0])
-            cat = category_from_string(p->str_val);
-        if (cat < 0)
-            cat = p->int_val;
-        if (p->op == CMP_SUBSTR && p->str_val[0])
-        { /* substring match on name */
-            return icase_strstr(d->name, p->str_val);
+        uint64_t bits = c->wide[w];
+        while (bits)
+        {
+            int d = w * 64 + next_bit(&bits);
+            if (compare_int(c->value[d], rhs, op))
+                out[w] |= 1ull << (d & 63);
         }
-        return compare_int(d->category, cat, p->op);
     }
-    case PRED_TAG:
+}
+
+static void index_load_tags(int d)
+{
+    uint64_t bit = 1ull << (d & 63);
+    int w = d >> 6;
+    for (int t = 0; t < g_tag_count; t++)
+        g_tag_bits[t][w] &= ~bit;
+    if (!(g_owned[w] & bit))
+        return;
+    const char* tags[ROGUE_INV_TAG_MAX_TAGS_PER_DEF];
+    int n = rogue_inv_tags_list(d, tags, ROGUE_INV_TAG_MAX_TAGS_PER_DEF);
+    if (n > ROGUE_INV_TAG_MAX_TAGS_PER_DEF)
+        n = ROGUE_INV_TAG_MAX_TAGS_PER_DEF;
+    for (int i = 0; i < n; i++)
     {
-        d = rogue_item_def_at(def_index);
-        if (!d)
-            return 0;
-        if (p->op == CMP_EQ)
+        int t = 0;
+        while (t < g_tag_count && strncmp(g_tag_names[t], tags[i], ROGUE_INV_TAG_SHORT_LEN) != 0)
+            t++;
+        if (t == g_tag_count)
         {
-            return def_has_tag(def_index, p->str_val);
-        }
-        if (p->op == CMP_NE)
-        {
-            return !def_has_tag(def_index, p->str_val);
-        }
-        if (p->op == CMP_SUBSTR)
-        { /* any tag contains substring */
-            const char* tags[8];
-            int n = rogue_inv_tags_list(def_index, tags, 8);
-            for (int i = 0; i < n; i++)
+            if (g_tag_count == QTAGS)
             {
-                if (tags[i] && icase_strstr(tags[i], p->str_val))
-                    return 1;
+                g_tag_overflow = 1;
+                continue;
             }
-            return 0;
+            memcpy(g_tag_names[t], tags[i], ROGUE_INV_TAG_SHORT_LEN);
+            g_tag_names[t][ROGUE_INV_TAG_SHORT_LEN - 1] = '\0';
+            memset(g_tag_bits[t], 0, sizeof g_tag_bits[t]);
+            g_tag_count++;
         }
-        return 0;
+        g_tag_bits[t][w] |= bit;
     }
-    case PRED_EQUIP_SLOT:
-        d = rogue_item_def_at(def_index);
-        if (!d)
-            return 0;
-        return equip_slot_matches_category(p->str_val, d->category);
-    case PRED_AFFIX_WEIGHT:
+}
+
+/* Apply a new quantity for definition d; returns 1 when its owned state flipped. */
+static int index_set_quantity(int d, uint64_t qty)
+{
+    uint64_t bit = 1ull << (d & 63);
+    int w = d >> 6;
+    int was_owned = (g_owned[w] & bit) != 0;
+    if (qty == 0)
     {
-        d = rogue_item_def_at(def_index);
-        if (!d)
+        if (!was_owned)
             return 0;
-        /* ANY instance semantics */ for (int i = 0; i < ROGUE_ITEM_INSTANCE_CAP; i++)
-        {
-            const RogueItemInstance* it = rogue_item_instance_at(i);
-            if (!it)
-                continue;
-            if (it->def_index != def_index)
-                continue;
-            int w = rogue_item_instance_total_affix_weight(i);
-            if (compare_int(w, p->int_val, p->op))
-                return 1;
-        }
+        g_owned[w] &= ~bit;
+        g_has_def[w] &= ~bit;
+        column_clear(&g_qty_col, d);
+        column_clear(&g_rarity_col, d);
+        column_clear(&g_category_col, d);
+        index_load_tags(d);
+        return 1;
+    }
+    column_set(&g_qty_col, d, qty > 0x7fffffffULL ? 0x7fffffff : (int) qty);
+    if (was_owned)
         return 0;
+    g_owned[w] |= bit;
+    const RogueItemDef* def = rogue_item_def_at(d);
+    if (def)
+    {
+        g_has_def[w] |= bit;
+        column_set(&g_rarity_col, d, def->rarity);
+        column_set(&g_category_col, d, (int) def->category);
     }
-    case PRED_QUALITY:
+    index_load_tags(d);
+    return 1;
+}
+
+static void index_sync(void)
+{
+    if (!g_index_dirty)
+        return;
+    memset(g_owned, 0, sizeof g_owned);
+    memset(g_has_def, 0, sizeof g_has_def);
+    memset(&g_qty_col, 0, sizeof g_qty_col);
+    memset(&g_rarity_col, 0, sizeof g_rarity_col);
+    memset(&g_category_col, 0, sizeof g_category_col);
+    g_tag_count = 0;
+    g_tag_overflow = 0;
+    for (int d = 0; d < ROGUE_ITEM_DEF_CAP; d++)
     {
-        d = rogue_item_def_at(def_index);
-        if (!d)
-            return 0;
-        for (int i = 0; i < ROGUE_ITEM_INSTANCE_CAP; i++)
+        uint64_t q = rogue_inventory_quantity(d);
+        if (q > 0)
+            index_set_quantity(d, q);
+    }
+    g_index_dirty = 0;
+}
+
+/* ---- Plan evaluation over word range [lo, hi) ---- */
+static int find_tag_slot(const char* tag)
+{
+    for (int t = 0; t < g_tag_count; t++)
+        if (strncmp(g_tag_names[t], tag, ROGUE_INV_TAG_SHORT_LEN) == 0)
+            return t;
+    return -1;
+}
+
+static int def_tag_matches(int d, const Predicate* p)
+{
+    if (p->op == CMP_EQ)
+        return rogue_inv_tags_has(d, p->str_val);
+    if (p->op == CMP_NE)
+        return !rogue_inv_tags_has(d, p->str_val);
+    const char* tags[ROGUE_INV_TAG_MAX_TAGS_PER_DEF];
+    int n = rogue_inv_tags_list(d, tags, ROGUE_INV_TAG_MAX_TAGS_PER_DEF);
+    if (n > ROGUE_INV_TAG_MAX_TAGS_PER_DEF)
+        n = ROGUE_INV_TAG_MAX_TAGS_PER_DEF;
+    for (int i = 0; i < n; i++)
+        if (tags[i] && icase_strstr(tags[i], p->str_val))
+            return 1;
+    return 0;
+}
+
+static void eval_tag(const Predicate* p, int lo, int hi, uint64_t* out)
+{
+    for (int w = lo; w < hi; w++)
+        out[w] = 0;
+    if (p->op != CMP_EQ && p->op != CMP_NE && p->op != CMP_SUBSTR)
+        return;
+    if (g_tag_overflow)
+    {
+        for (int w = lo; w < hi; w++)
         {
-            const RogueItemInstance* it = rogue_item_instance_at(i);
-            if (!it)
-                continue;
-            if (it->def_index != def_index)
-                continue;
-            int q = rogue_item_instance_get_quality(i);
-            if (compare_int(q, p->int_val, p->op))
-                return 1;
+            uint64_t bits = g_has_def[w];
+            while (bits)
+            {
+                int d = w * 64 + next_bit(&bits);
+                if (def_tag_matches(d, p))
+                    out[w] |= 1ull << (d & 63);
+            }
         }
-        return 0;
+        return;
     }
-    case PRED_DUR_PCT:
+    if (p->op == CMP_SUBSTR)
     {
-        d = rogue_item_def_at(def_index);
-        if (!d)
-            return 0;
-        for (int i = 0; i < ROGUE_ITEM_INSTANCE_CAP; i++)
+        for (int t = 0; t < g_tag_count; t++)
+            if (icase_strstr(g_tag_names[t], p->str_val))
+                for (int w = lo; w < hi; w++)
+                    out[w] |= g_tag_bits[t][w];
+    }
+    else
+    {
+        int t = find_tag_slot(p->str_val);
+        if (t >= 0)
+            for (int w = lo; w < hi; w++)
+                out[w] = g_tag_bits[t][w];
+        if (p->op == CMP_NE)
+            for (int w = lo; w < hi; w++)
+                out[w] = ~out[w];
+    }
+    for (int w = lo; w < hi; w++)
+        out[w] &= g_has_def[w];
+}
+
+/* Instance-derived fields: one pass over the instance pool, ANY-instance semantics. */
+static void eval_instances(const Predicate* p, int lo, int hi, uint64_t* out)
+{
+    for (int w = lo; w < hi; w++)
+        out[w] = 0;
+    for (int i = 0, n = rogue_items_capacity(); i < n; i++)
+    {
+        const RogueItemInstance* it = rogue_item_instance_at(i);
+        if (!it)
+            continue;
+        int d = it->def_index;
+        if (d < lo * 64 || d >= hi * 64 || d >= ROGUE_ITEM_DEF_CAP)
+            continue;
+        uint64_t bit = 1ull << (d & 63);
+        int w = d >> 6;
+        if (!(g_has_def[w] & bit) || (out[w] & bit))
+            continue;
+        int v;
+        if (p->field == PRED_AFFIX_WEIGHT)
+            v = rogue_item_instance_total_affix_weight(i);
+        else if (p->field == PRED_QUALITY)
+            v = rogue_item_instance_get_quality(i);
+        else
         {
-            const RogueItemInstance* it = rogue_item_instance_at(i);
-            if (!it)
+            if (it->durability_max <= 0)
                 continue;
-            if (it->def_index != def_index)
-                continue;
-            if (it->durability_max > 0)
+            v = (int) ((it->durability_cur * 100) / (it->durability_max));
+        }
+        if (compare_int(v, p->int_val, p->op))
+            out[w] |= bit;
+    }
+}
+
+static void eval_predicate(const Predicate* p, int lo, int hi, uint64_t* out)
+{
+    switch (p->field)
+    {
+    case PRED_QTY:
+        column_eval(&g_qty_col, p->op, p->int_val, lo, hi, out);
+        return;
+    case PRED_RARITY:
+        column_eval(&g_rarity_col, p->op, p->int_val, lo, hi, out);
+        return;
+    case PRED_CATEGORY:
+    {
+        if (p->op == CMP_SUBSTR && p->str_val[0])
+        { /* substring match on name */
+            for (int w = lo; w < hi; w++)
             {
-                int pct = (int) ((it->durability_cur * 100) / (it->durability_max));
-                if (compare_int(pct, p->int_val, p->op))
-                    return 1;
+                out[w] = 0;
+                uint64_t bits = g_has_def[w];
+                while (bits)
+                {
+                    int d = w * 64 + next_bit(&bits);
+                    const RogueItemDef* def = rogue_item_def_at(d);
+                    if (def && icase_strstr(def->name, p->str_val))
+                        out[w] |= 1ull << (d & 63);
+                }
             }
+            return;
         }
-        return 0;
+        int cat = -1;
+        if (p->str_val[0])
+            cat = category_from_string(p->str_val);
+        if (cat < 0)
+            cat = p->int_val;
+        column_eval(&g_category_col, p->op, cat, lo, hi, out);
+        return;
     }
+    case PRED_EQUIP_SLOT:
+        column_eval(&g_category_col, CMP_EQ, equip_slot_category(p->str_val), lo, hi, out);
+        return;
+    case PRED_TAG:
+        eval_tag(p, lo, hi, out);
+        return;
+    case PRED_AFFIX_WEIGHT:
+    case PRED_QUALITY:
+    case PRED_DUR_PCT:
+        eval_instances(p, lo, hi, out);
+        return;
     }
-    return 0;
+    for (int w = lo; w < hi; w++)
+        out[w] = 0;
 }
 
-static int eval_node(Node* n, int def_index)
+static void plan_eval(const RogueInvQueryPlan* plan, int lo, int hi, uint64_t* out)
 {
-    if (!n)
-        return 1;
-    if (n->is_pred)
-        return eval_predicate(&n->pred, def_index);
-    int l = eval_node(n->left, def_index);
-    int r = eval_node(n->right, def_index);
-    return n->is_or ? (l || r) : (l && r);
+    uint64_t stack[ROGUE_INV_QUERY_MAX_TERMS][QWORDS];
+    int sp = 0;
+    for (int i = 0; i < plan->op_count; i++)
+    {
+        const PlanOp* op = &plan->ops[i];
+        switch (op->kind)
+        {
+        case OP_PRED:
+            eval_predicate(&plan->preds[op->pred], lo, hi, stack[sp++]);
+            break;
+        case OP_ALL:
+            memcpy(&stack[sp++][lo], &g_owned[lo], sizeof(uint64_t) * (size_t) (hi - lo));
+            break;
+        case OP_AND:
+            sp--;
+            for (int w = lo; w < hi; w++)
+                stack[sp - 1][w] &= stack[sp][w];
+            break;
+        default:
+            sp--;
+            for (int w = lo; w < hi; w++)
+                stack[sp - 1][w] |= stack[sp][w];
+            break;
+        }
+    }
+    for (int w = lo; w < hi; w++)
+        out[w] = g_owned[w] & stack[0][w];
+}
+
+static int bits_to_indices(const uint64_t* bits, int* out_def_indices, int cap)
+{
+    int count = 0;
+    for (int w = 0; w < QWORDS && count < cap; w++)
+    {
+        uint64_t b = bits[w];
+        while (b && count < cap)
+            out_def_indices[count++] = w * 64 + next_bit(&b);
+    }
+    return count;
+}
+
+int rogue_inventory_query_plan_execute(const RogueInvQueryPlan* plan, int* out_def_indices,
+                                       int cap)
+{
+    if (!plan || !out_def_indices || cap <= 0)
+        return 0;
+    index_sync();
+    uint64_t result[QWORDS];
+    plan_eval(plan, 0, QWORDS, result);
+    return bits_to_indices(result, out_def_indices, cap);
 }
 
 int rogue_inventory_query_execute(const char* expr, int* out_def_indices, int cap)
 {
     if (!expr || !*expr || !out_def_indices || cap <= 0)
         return 0;
-    Node* root = parse(expr);
-    int count = 0;
-    for (int i = 0; i < ROGUE_ITEM_DEF_CAP && count < cap; i++)
-    {
-        if (rogue_inventory_quantity(i) <= 0)
-            continue;
-        if (eval_node(root, i))
-            out_def_indices[count++] = i;
-    } /* free omitted (short-lived) */
+    RogueInvQueryPlan* plan = rogue_inventory_query_compile(expr);
+    int count = rogue_inventory_query_plan_execute(plan, out_def_indices, cap);
+    rogue_inventory_query_plan_free(plan);
     return count;
 }
 
@@ -672,6 +987,7 @@ int rogue_inventory_query_sort(int* def_indices, int count, const char* keys)
     }
     if (pk == 0)
         return 0;
+    index_sync();
     SortDecor* deco = (SortDecor*) malloc(sizeof(SortDecor) * count);
     if (!deco)
         return -1;
@@ -692,6 +1008,12 @@ int rogue_inventory_query_sort(int* def_indices, int count, const char* keys)
                 break;
             case 1:
             {
+                if (di >= 0 && di < ROGUE_ITEM_DEF_CAP)
+                { /* quantity column (already clamped); unowned reads 0 */
+                    int owned = (int) ((g_owned[di >> 6] >> (di & 63)) & 1u);
+                    deco[i].keys[keyslot] = owned ? g_qty_col.value[di] : 0;
+                    break;
+                }
                 uint64_t q = rogue_inventory_quantity(di);
                 if (q > 0x7fffffffULL)
                     q = 0x7fffffffULL;
@@ -957,10 +1279,10 @@ int rogue_inventory_saved_search_name(int index, char* out_name, int cap)
 }
 
 /* Persistence for saved searches (component id 12) */
-int rogue_inventory_saved_searches_write(FILE* f)
+int rogue_inventory_saved_searches_write(RogueSaveBuffer* out)
 {
     uint32_t count = (uint32_t) g_saved_count;
-    if (fwrite(&count, sizeof count, 1, f) != 1)
+    if (rogue_save_buffer_append(out, &count, sizeof count) != 0)
         return -1;
     for (uint32_t i = 0; i < count; i++)
     {
@@ -968,20 +1290,20 @@ int rogue_inventory_saved_searches_write(FILE* f)
         unsigned char nl = (unsigned char) strlen(s->name);
         unsigned char ql = (unsigned char) strlen(s->query);
         unsigned char sl = (unsigned char) strlen(s->sort);
-        fwrite(&nl, 1, 1, f);
-        fwrite(s->name, 1, nl, f);
-        fwrite(&ql, 1, 1, f);
-        fwrite(s->query, 1, ql, f);
-        fwrite(&sl, 1, 1, f);
-        fwrite(s->sort, 1, sl, f);
+        rogue_save_buffer_append(out, &nl, 1);
+        rogue_save_buffer_append(out, s->name, nl);
+        rogue_save_buffer_append(out, &ql, 1);
+        rogue_save_buffer_append(out, s->query, ql);
+        rogue_save_buffer_append(out, &sl, 1);
+        rogue_save_buffer_append(out, s->sort, sl);
     }
     return 0;
 }
-int rogue_inventory_saved_searches_read(FILE* f, size_t size)
+int rogue_inventory_saved_searches_read(RogueSaveReader* in, size_t size)
 {
     (void) size;
     uint32_t count = 0;
-    if (fread(&count, sizeof count, 1, f) != 1)
+    if (rogue_save_reader_read(in, &count, sizeof count) != 0)
         return -1;
     if (count > ROGUE_INV_SAVED_MAX)
         count = ROGUE_INV_SAVED_MAX;
@@ -989,25 +1311,25 @@ int rogue_inventory_saved_searches_read(FILE* f, size_t size)
     for (uint32_t i = 0; i < count; i++)
     {
         unsigned char nl = 0, ql = 0, sl = 0;
-        if (fread(&nl, 1, 1, f) != 1)
+        if (rogue_save_reader_read(in, &nl, 1) != 0)
             return -1;
         if (nl >= sizeof g_saved[0].name)
             nl = (unsigned char) (sizeof g_saved[0].name - 1);
-        if (fread(g_saved[i].name, 1, nl, f) != nl)
+        if (rogue_save_reader_read(in, g_saved[i].name, nl) != 0)
             return -1;
         g_saved[i].name[nl] = '\0';
-        if (fread(&ql, 1, 1, f) != 1)
+        if (rogue_save_reader_read(in, &ql, 1) != 0)
             return -1;
         if (ql >= sizeof g_saved[0].query)
             ql = (unsigned char) (sizeof g_saved[0].query - 1);
-        if (fread(g_saved[i].query, 1, ql, f) != ql)
+        if (rogue_save_reader_read(in, g_saved[i].query, ql) != 0)
             return -1;
         g_saved[i].query[ql] = '\0';
-        if (fread(&sl, 1, 1, f) != 1)
+        if (rogue_save_reader_read(in, &sl, 1) != 0)
             return -1;
         if (sl >= sizeof g_saved[0].sort)
             sl = (unsigned char) (sizeof g_saved[0].sort - 1);
-        if (fread(g_saved[i].sort, 1, sl, f) != sl)
+        if (rogue_save_reader_read(in, g_saved[i].sort, sl) != 0)
             return -1;
         g_saved[i].sort[sl] = '\0';
         g_saved_count++;
@@ -1031,19 +1353,23 @@ int rogue_inventory_quick_action_apply(int index, int* out_def_indices, int cap)
     return rogue_inventory_saved_search_apply(name, out_def_indices, cap);
 }
 
-/* ---- Query Result Cache (Phase 4.6) ---- */
+/* ---- Query Result Cache (Phase 4.6) ----
+ * Entries keep the compiled plan and the result bitset. Inventory, tag and instance mutations
+ * re-evaluate only the 64-definition word holding the changed definition, and only in entries
+ * whose plan reads the changed column, so results stay warm across ordinary pickups. */
 #define ROGUE_INV_QUERY_CACHE_MAX 32
 typedef struct QueryCacheEntry
 {
     unsigned hash;
-    int count;
-    int def_indices[64];
+    int valid;
+    char expr[ROGUE_INV_QUERY_CACHE_EXPR_MAX];
+    RogueInvQueryPlan* plan;
+    uint64_t result[QWORDS];
     unsigned last_use;
 } QueryCacheEntry;
 static QueryCacheEntry g_qcache[ROGUE_INV_QUERY_CACHE_MAX];
 static unsigned g_qcache_stamp = 1;
 static int g_qcache_enabled = 1;
-static int g_qcache_size = 0;
 static unsigned g_qcache_hits = 0, g_qcache_misses = 0;
 static unsigned hash_expr(const char* s)
 {
@@ -1058,10 +1384,9 @@ static unsigned hash_expr(const char* s)
 }
 static QueryCacheEntry* qcache_find(unsigned h, const char* expr)
 {
-    (void) expr;
     for (int i = 0; i < ROGUE_INV_QUERY_CACHE_MAX; i++)
     {
-        if (g_qcache[i].hash == h && g_qcache[i].count > 0)
+        if (g_qcache[i].valid && g_qcache[i].hash == h && strcmp(g_qcache[i].expr, expr) == 0)
         {
             return &g_qcache[i];
         }
@@ -1073,7 +1398,7 @@ static QueryCacheEntry* qcache_evict_slot(void)
     QueryCacheEntry* best = NULL;
     for (int i = 0; i < ROGUE_INV_QUERY_CACHE_MAX; i++)
     {
-        if (g_qcache[i].count == 0)
+        if (!g_qcache[i].valid)
             return &g_qcache[i];
         if (!best || g_qcache[i].last_use < best->last_use)
             best = &g_qcache[i];
@@ -1084,44 +1409,54 @@ void rogue_inventory_query_cache_invalidate_all(void)
 {
     for (int i = 0; i < ROGUE_INV_QUERY_CACHE_MAX; i++)
     {
-        g_qcache[i].count = 0;
+        rogue_inventory_query_plan_free(g_qcache[i].plan);
+        g_qcache[i].plan = NULL;
+        g_qcache[i].valid = 0;
         g_qcache[i].hash = 0;
     }
+    g_index_dirty = 1;
+}
+/* Re-evaluate the word holding def_index in every cached plan reading one of `deps` (0 = all). */
+static void qcache_refresh_def(int def_index, unsigned deps)
+{
+    int w = def_index >> 6;
+    for (int i = 0; i < ROGUE_INV_QUERY_CACHE_MAX; i++)
+    {
+        QueryCacheEntry* e = &g_qcache[i];
+        if (e->valid && (!deps || (e->plan->deps & deps)))
+            plan_eval(e->plan, w, w + 1, e->result);
+    }
 }
-static void qcache_invalidate_on_mutation(void) { rogue_inventory_query_cache_invalidate_all(); }
 int rogue_inventory_query_execute_cached(const char* expr, int* out_def_indices, int cap)
 {
-    if (!expr)
+    if (!expr || !*expr || !out_def_indices || cap <= 0)
         return 0;
-    if (!g_qcache_enabled)
+    if (!g_qcache_enabled || strlen(expr) >= ROGUE_INV_QUERY_CACHE_EXPR_MAX)
     {
         return rogue_inventory_query_execute(expr, out_def_indices, cap);
     }
+    index_sync();
     unsigned h = hash_expr(expr);
     QueryCacheEntry* e = qcache_find(h, expr);
     if (e)
     {
         g_qcache_hits++;
         e->last_use = ++g_qcache_stamp;
-        int n = (e->count < cap) ? e->count : cap;
-        for (int i = 0; i < n; i++)
-            out_def_indices[i] = e->def_indices[i];
-        return n;
+        return bits_to_indices(e->result, out_def_indices, cap);
     }
     g_qcache_misses++;
-    int tmp[64];
-    int n = rogue_inventory_query_execute(expr, tmp, (cap < 64 ? cap : 64));
+    RogueInvQueryPlan* plan = rogue_inventory_query_compile(expr);
+    if (!plan)
+        return 0;
     e = qcache_evict_slot();
+    rogue_inventory_query_plan_free(e->plan);
+    e->plan = plan;
     e->hash = h;
-    e->count = n;
-    for (int i = 0; i < n; i++)
-        e->def_indices[i] = tmp[i];
+    e->valid = 1;
+    memcpy(e->expr, expr, strlen(expr) + 1);
+    plan_eval(plan, 0, QWORDS, e->result);
     e->last_use = ++g_qcache_stamp;
-    if (n > cap)
-        n = cap;
-    for (int i = 0; i < n; i++)
-        out_def_indices[i] = tmp[i];
-    return n;
+    return bits_to_indices(e->result, out_def_indices, cap);
 }
 void rogue_inventory_query_cache_stats(unsigned* out_hits, unsigned* out_misses)
 {
@@ -1136,6 +1471,25 @@ void rogue_inventory_query_cache_stats_reset(void)
     g_qcache_misses = 0;
 }
 
+/* ---- Incremental index maintenance ---- */
+void rogue_inventory_query_on_quantity_change(int def_index, uint64_t qty)
+{
+    if (def_index < 0 || def_index >= ROGUE_ITEM_DEF_CAP)
+        return;
+    if (g_index_dirty)
+        return; /* full rebuild pending; cache is empty */
+    int flipped = index_set_quantity(def_index, qty);
+    qcache_refresh_def(def_index, flipped ? 0u : PLAN_DEP_QTY);
+}
+
+void rogue_inventory_query_on_tags_change(int def_index)
+{
+    if (def_index < 0 || def_index >= ROGUE_ITEM_DEF_CAP || g_index_dirty)
+        return;
+    index_load_tags(def_index);
+    qcache_refresh_def(def_index, PLAN_DEP_TAG);
+}
+
 /* Wire cache + fuzzy incremental: call from mutation hook */
 void rogue_inventory_query_on_instance_mutation(int inst_index)
 {
@@ -1143,9 +1497,12 @@ void rogue_inventory_query_on_instance_mutation(int inst_index)
     if (!it)
         return; /* mark trigram dirty */
     int d = it->def_index;
+    if (d < 0 || d >= ROGUE_ITEM_DEF_CAP)
+        return;
     int w = d / 32;
     g_trigram_dirty_mask[w] |= (1u << (d % 32));
-    qcache_invalidate_on_mutation();
+    if (!g_index_dirty)
+        qcache_refresh_def(d, PLAN_DEP_INSTANCE);
 }
 
 /* Saved search quick-apply */
@@ -1162,16 +1519,3 @@ int rogue_inventory_saved_search_apply(const char* name, int* out_def_indices, i
         rogue_inventory_query_sort(out_def_indices, n, sort);
     return n;
 }
-
-/* Parser diagnostics (simple last-error string) */
-static char g_last_parse_error[64];
-static void set_parse_error(const char* msg)
-{
-#if defined(_MSC_VER)
-    strncpy_s(g_last_parse_error, sizeof g_last_parse_error, msg, _TRUNCATE);
-#else
-    strncpy(g_last_parse_error, msg, sizeof g_last_parse_error - 1);
-    g_last_parse_error[sizeof g_last_parse_error - 1] = '\0';
-#endif
-}
-const char* rogue_inventory_query_last_error(void) { return g_last_parse_error; }
@@ -19,18 +19,35 @@
  * - qty and quantity are aliases.
  * - Quick action bar (Phase 4.4): thin enumeration/apply layer over saved searches for UI binding.
  * - Parser diagnostics (Phase 4.1 enhancement): last error string accessible after failed parse.
+ * - Compiled plans: an expression compiles once into a postfix plan evaluated against column
+ *   bitsets (one bit per definition: owned set, quantity / rarity / category value columns, one
+ *   set per tag). Entry and tag mutations update the columns in place; instance-derived fields are
+ *   gathered in one pass over the instance pool per predicate. After reloading item definitions
+ *   call rogue_inventory_query_cache_invalidate_all so rarity / category columns are rebuilt.
  */
 #ifndef ROGUE_INVENTORY_QUERY_H
 #define ROGUE_INVENTORY_QUERY_H
 
 #include <stddef.h> /* size_t */
 #include <stdint.h>
-#include <stdio.h> /* FILE */
 #ifdef __cplusplus
 extern "C"
 {
 #endif
 
+#define ROGUE_INV_QUERY_MAX_TERMS 32        /* predicates + unparsable factors per plan */
+#define ROGUE_INV_QUERY_CACHE_EXPR_MAX 128 /* longer expressions bypass the result cache */
+
+    typedef struct RogueInvQueryPlan RogueInvQueryPlan;
+
+    /* Compile an expression into a reusable plan. NULL on empty input, allocation failure or more
+     * than ROGUE_INV_QUERY_MAX_TERMS terms (see rogue_inventory_query_last_error). */
+    RogueInvQueryPlan* rogue_inventory_query_compile(const char* expr);
+    /* Run a plan: matching definition indices in ascending order, at most cap. */
+    int rogue_inventory_query_plan_execute(const RogueInvQueryPlan* plan, int* out_def_indices,
+                                           int cap);
+    void rogue_inventory_query_plan_free(RogueInvQueryPlan* plan);
+
     /* Execute query expression, writing matching definition indices (unsorted). */
     int rogue_inventory_query_execute(const char* expr, int* out_def_indices, int cap);
 
@@ -77,12 +94,19 @@ extern "C"
 
     /* Persistence (Phase 4.4): write/read saved searches as component id
      * ROGUE_SAVE_COMP_INV_SAVED_SEARCHES */
-    int rogue_inventory_saved_searches_write(FILE* f);             /* returns 0 */
-    int rogue_inventory_saved_searches_read(FILE* f, size_t size); /* returns 0 */
+    struct RogueSaveBuffer;
+    struct RogueSaveReader;
+    int rogue_inventory_saved_searches_write(struct RogueSaveBuffer* out); /* returns 0 */
+    int rogue_inventory_saved_searches_read(struct RogueSaveReader* in,
+                                            size_t size); /* returns 0 */
 
     /* Mutation hook: call when item instance metadata (affix weight / quality / durability) changes
      * so we can re-index fuzzy needed sets (Phase 4.5). */
     void rogue_inventory_query_on_instance_mutation(int inst_index);
+    /* Index hooks: inventory entries report every quantity change (0 = entry removed), inventory
+     * tags report tag edits. Cached results are patched for the affected definition only. */
+    void rogue_inventory_query_on_quantity_change(int def_index, uint64_t qty);
+    void rogue_inventory_query_on_tags_change(int def_index);
 
     /* Parser diagnostics (Phase 4.1 enhancement): returns last parse error message (or empty string
      * if none). */
@@ -1,5 +1,6 @@
 #include "inventory_tag_rules.h"
 #include "../loot/loot_item_defs.h" /* for rogue_item_def_at */
+#include "../persistence/save_utils.h"
 #include "inventory_tags.h"
 #include <stdlib.h>
 #include <string.h>
@@ -110,44 +111,45 @@ uint32_t rogue_inv_tag_rules_accent_color(int def_index)
  *  uint8 tag_len
  *  bytes tag (tag_len, no null)
  */
-int rogue_inv_tag_rules_write(FILE* f)
+int rogue_inv_tag_rules_write(RogueSaveBuffer* out)
 {
-    if (!f)
+    if (!out)
         return -1;
     uint16_t rc = (uint16_t) g_rule_count;
-    if (fwrite(&rc, sizeof(rc), 1, f) != 1)
+    if (rogue_save_buffer_append(out, &rc, sizeof(rc)) != 0)
         return -1;
     for (int i = 0; i < g_rule_count; i++)
     {
         const RogueInvTagRule* r = &g_rules[i];
         uint8_t tag_len = (uint8_t) strlen(r->tag);
-        if (fwrite(&r->min_rarity, 1, 1, f) != 1)
+        if (rogue_save_buffer_append(out, &r->min_rarity, 1) != 0)
             return -1;
-        if (fwrite(&r->max_rarity, 1, 1, f) != 1)
+        if (rogue_save_buffer_append(out, &r->max_rarity, 1) != 0)
             return -1;
-        if (fwrite(&r->category_mask, sizeof(r->category_mask), 1, f) != 1)
+        if (rogue_save_buffer_append(out, &r->category_mask, sizeof(r->category_mask)) != 0)
             return -1;
-        if (fwrite(&r->accent_color_rgba, sizeof(r->accent_color_rgba), 1, f) != 1)
+        if (rogue_save_buffer_append(out, &r->accent_color_rgba, sizeof(r->accent_color_rgba)) !=
+            0)
             return -1;
-        if (fwrite(&tag_len, 1, 1, f) != 1)
+        if (rogue_save_buffer_append(out, &tag_len, 1) != 0)
             return -1;
         if (tag_len > 0)
         {
-            if (fwrite(r->tag, 1, tag_len, f) != tag_len)
+            if (rogue_save_buffer_append(out, r->tag, tag_len) != 0)
                 return -1;
         }
     }
     return 0;
 }
 
-int rogue_inv_tag_rules_read(FILE* f, size_t size)
+int rogue_inv_tag_rules_read(RogueSaveReader* in, size_t size)
 {
     (void) size;
-    if (!f)
+    if (!in)
         return -1;
     g_rule_count = 0;
     uint16_t rc = 0;
-    if (fread(&rc, sizeof(rc), 1, f) != 1)
+    if (rogue_save_reader_read(in, &rc, sizeof(rc)) != 0)
         return -1;
     if (rc > ROGUE_INV_TAG_RULE_MAX)
         rc = ROGUE_INV_TAG_RULE_MAX;
@@ -156,21 +158,22 @@ int rogue_inv_tag_rules_read(FILE* f, size_t size)
         RogueInvTagRule r;
         memset(&r, 0, sizeof r);
         uint8_t tag_len = 0;
-        if (fread(&r.min_rarity, 1, 1, f) != 1)
+        if (rogue_save_reader_read(in, &r.min_rarity, 1) != 0)
             return -1;
-        if (fread(&r.max_rarity, 1, 1, f) != 1)
+        if (rogue_save_reader_read(in, &r.max_rarity, 1) != 0)
             return -1;
-        if (fread(&r.category_mask, sizeof(r.category_mask), 1, f) != 1)
+        if (rogue_save_reader_read(in, &r.category_mask, sizeof(r.category_mask)) != 0)
             return -1;
-        if (fread(&r.accent_color_rgba, sizeof(r.accent_color_rgba), 1, f) != 1)
+        if (rogue_save_reader_read(in, &r.accent_color_rgba, sizeof(r.accent_color_rgba)) !=
+            0)
             return -1;
-        if (fread(&tag_len, 1, 1, f) != 1)
+        if (rogue_save_reader_read(in, &tag_len, 1) != 0)
             return -1;
         if (tag_len >= sizeof(r.tag))
             tag_len = sizeof(r.tag) - 1;
         if (tag_len > 0)
         {
-            if (fread(r.tag, 1, tag_len, f) != tag_len)
+            if (rogue_save_reader_read(in, r.tag, tag_len) != 0)
                 return -1;
             r.tag[tag_len] = '\0';
         }
@@ -3,7 +3,6 @@
 
 #include <stddef.h>
 #include <stdint.h>
-#include <stdio.h> /* FILE */
 #ifdef __cplusplus
 extern "C"
 {
@@ -44,8 +43,10 @@ extern "C"
     uint32_t rogue_inv_tag_rules_accent_color(int def_index);
 
     /* Persistence (component id ROGUE_SAVE_COMP_INV_TAG_RULES) */
-    int rogue_inv_tag_rules_write(FILE* f);             /* internal */
-    int rogue_inv_tag_rules_read(FILE* f, size_t size); /* internal */
+    struct RogueSaveBuffer;
+    struct RogueSaveReader;
+    int rogue_inv_tag_rules_write(struct RogueSaveBuffer* out); /* internal */
+    int rogue_inv_tag_rules_read(struct RogueSaveReader* in, size_t size); /* internal */
 
 #ifdef __cplusplus
 }
@@ -1,4 +1,5 @@
 #include "inventory_tags.h"
+#include "inventory_query.h" /* tag column upkeep */
 #include <ctype.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -24,6 +25,7 @@ int rogue_inv_tags_init(void)
     {
         memset(g_tag_table, 0, sizeof(InvTagRec) * ROGUE_INV_TAG_MAX_DEFS);
     }
+    rogue_inventory_query_cache_invalidate_all();
     return 0;
 }
 static int valid_def(int d) { return d >= 0 && d < ROGUE_INV_TAG_MAX_DEFS; }
@@ -67,6 +69,7 @@ int rogue_inv_tags_add_tag(int def_index, const char* tag)
     memset(r->tags[r->tag_count], 0, ROGUE_INV_TAG_SHORT_LEN);
     memcpy(r->tags[r->tag_count], tag, len);
     r->tag_count++;
+    rogue_inventory_query_on_tags_change(def_index);
     return 0;
 }
 int rogue_inv_tags_remove_tag(int def_index, const char* tag)
@@ -81,6 +84,7 @@ int rogue_inv_tags_remove_tag(int def_index, const char* tag)
         memcpy(r->tags[idx], r->tags[last], ROGUE_INV_TAG_SHORT_LEN);
     }
     r->tag_count--;
+    rogue_inventory_query_on_tags_change(def_index);
     return 0;
 }
 int rogue_inv_tags_list(int def_index, const char** out_tags, int cap)
@@ -21,6 +21,16 @@ const RogueAffixDef* rogue_affix_at(int index)
         return NULL;
     return &g_affixes[index];
 }
+int rogue_affixes_commit(const RogueAffixDef* defs, int count)
+{
+    int added = 0;
+    for (int i = 0; i < count && g_affix_count < ROGUE_MAX_AFFIXES; i++)
+    {
+        g_affixes[g_affix_count++] = defs[i];
+        added++;
+    }
+    return added;
+}
 int rogue_affix_index(const char* id)
 {
     if (!id)
@@ -52,6 +52,8 @@ int rogue_affixes_reset(void);
 int rogue_affixes_load_from_cfg(const char* path); /* returns number added */
 int rogue_affix_count(void);
 const RogueAffixDef* rogue_affix_at(int index);
+/* Append already built defs (baked content packs). Returns how many fit. */
+int rogue_affixes_commit(const RogueAffixDef* defs, int count);
 int rogue_affix_index(const char* id);
 int rogue_affix_roll(RogueAffixType type, int rarity, unsigned int* rng_state);
 /* Roll a concrete stat value for an already selected affix index using its min/max range.
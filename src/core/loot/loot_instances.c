@@ -4,20 +4,231 @@
 #include "loot_logging.h"
 #include "loot_rarity_adv.h"
 #include "loot_vfx.h"
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
 /* Forward declaration (12.4) */
 int rogue_minimap_ping_loot(float x, float y, int rarity);
 
-static RogueItemInstance g_instances[ROGUE_ITEM_INSTANCE_CAP];
+/* ---- Instance pool ----
+ * Contiguous slots growing by doubling. An occupancy bitmap doubles as the free list: spawns take
+ * the lowest free slot (keeping slot-derived GUIDs / socket seeds identical to the fixed array),
+ * found a word at a time from a lowest-free-word hint. Scans stop at the high-water mark. */
+static RogueItemInstance* g_instances = NULL;
+static int g_capacity = 0;
+static int g_high_water = 0;
+static uint64_t* g_used = NULL;
+static int g_free_word_hint = 0;
+static int* g_scratch = NULL; /* capacity-sized gather buffer (merge / queries) */
+
+/* ---- Spatial hash ----
+ * Uniform grid with cell edge ROGUE_ITEM_STACK_MERGE_RADIUS, so every merge partner lies in the
+ * 3x3 cells around an item. Cells hash into a power-of-two bucket table (one bucket per slot);
+ * each slot keeps an intrusive doubly linked node plus its cell so collisions are filtered out. */
+typedef struct ItemCellLink
+{
+    int next, prev;
+    int cx, cy;
+    int bucket; /* -1 = not linked */
+} ItemCellLink;
+static ItemCellLink* g_links = NULL;
+static int* g_bucket_head = NULL;
+static unsigned g_bucket_mask = 0;
+
 /* Runtime flag (Phase 18.6): allow tests to suppress INFO spam from loot spawns without
     requiring compile-time macro injection into core sources. */
 int g_rogue_loot_suppress_spawn_log = 0;
 
+static int slot_used(int i) { return (int) ((g_used[i >> 6] >> (i & 63)) & 1u); }
+
+static int cell_coord(float v)
+{
+    float c = floorf(v * (1.0f / ROGUE_ITEM_STACK_MERGE_RADIUS));
+    if (c < -1.0e9f)
+        c = -1.0e9f;
+    if (c > 1.0e9f)
+        c = 1.0e9f;
+    return (int) c;
+}
+
+static unsigned cell_bucket(int cx, int cy)
+{
+    return (((unsigned) cx * 73856093u) ^ ((unsigned) cy * 19349663u)) & g_bucket_mask;
+}
+
+static void link_insert(int i)
+{
+    ItemCellLink* l = &g_links[i];
+    l->cx = cell_coord(g_instances[i].x);
+    l->cy = cell_coord(g_instances[i].y);
+    l->bucket = (int) cell_bucket(l->cx, l->cy);
+    l->prev = -1;
+    l->next = g_bucket_head[l->bucket];
+    if (l->next >= 0)
+        g_links[l->next].prev = i;
+    g_bucket_head[l->bucket] = i;
+}
+
+static void link_remove(int i)
+{
+    ItemCellLink* l = &g_links[i];
+    if (l->bucket < 0)
+        return;
+    if (l->prev >= 0)
+        g_links[l->prev].next = l->next;
+    else
+        g_bucket_head[l->bucket] = l->next;
+    if (l->next >= 0)
+        g_links[l->next].prev = l->prev;
+    l->bucket = -1;
+}
+
+static void slot_release(int i)
+{
+    g_instances[i].active = 0;
+    link_remove(i);
+    g_used[i >> 6] &= ~(1ULL << (i & 63));
+    if ((i >> 6) < g_free_word_hint)
+        g_free_word_hint = i >> 6;
+}
+
+/* Lowest free slot, or -1 when every slot below capacity is taken. */
+static int slot_find_free(void)
+{
+    int words = g_capacity >> 6;
+    for (int w = g_free_word_hint; w < words; w++)
+    {
+        uint64_t v = ~g_used[w];
+        if (!v)
+            continue;
+        g_free_word_hint = w;
+#if defined(__GNUC__) || defined(__clang__)
+        return (w << 6) + __builtin_ctzll(v);
+#else
+        int b = 0;
+        while (!((v >> b) & 1u))
+            b++;
+        return (w << 6) + b;
+#endif
+    }
+    g_free_word_hint = words;
+    return -1;
+}
+
+static void hash_rebuild(void)
+{
+    for (unsigned b = 0; b <= g_bucket_mask; b++)
+        g_bucket_head[b] = -1;
+    for (int i = 0; i < g_capacity; i++)
+    {
+        g_links[i].bucket = -1;
+        if (i < g_high_water && slot_used(i))
+            link_insert(i);
+    }
+}
+
+/* Grow every slot-parallel array to hold at least `need` slots. 0 when the pool is at its max. */
+static int pool_reserve(int need)
+{
+    if (need <= g_capacity)
+        return 1;
+    if (need > ROGUE_ITEM_INSTANCE_MAX)
+        return 0;
+    int cap = g_capacity ? g_capacity : ((ROGUE_ITEM_INSTANCE_CAP + 63) & ~63);
+    while (cap < need)
+        cap *= 2;
+    if (cap > ROGUE_ITEM_INSTANCE_MAX)
+        cap = (ROGUE_ITEM_INSTANCE_MAX + 63) & ~63;
+    unsigned buckets = 1;
+    while (buckets < (unsigned) cap)
+        buckets <<= 1;
+    int view_was_pool = g_instances && g_app.item_instances == g_instances;
+    RogueItemInstance* inst =
+        (RogueItemInstance*) realloc(g_instances, sizeof(RogueItemInstance) * (size_t) cap);
+    if (!inst)
+        return 0;
+    g_instances = inst;
+    ItemCellLink* links = (ItemCellLink*) realloc(g_links, sizeof(ItemCellLink) * (size_t) cap);
+    uint64_t* used = (uint64_t*) realloc(g_used, sizeof(uint64_t) * (size_t) (cap >> 6));
+    int* scratch = (int*) realloc(g_scratch, sizeof(int) * (size_t) cap);
+    int* heads = (int*) realloc(g_bucket_head, sizeof(int) * (size_t) buckets);
+    if (links)
+        g_links = links;
+    if (used)
+        g_used = used;
+    if (scratch)
+        g_scratch = scratch;
+    if (heads)
+        g_bucket_head = heads;
+    if (!links || !used || !scratch || !heads)
+        return 0;
+    memset(g_instances + g_capacity, 0, sizeof(RogueItemInstance) * (size_t) (cap - g_capacity));
+    memset(g_used + (g_capacity >> 6), 0, sizeof(uint64_t) * (size_t) ((cap - g_capacity) >> 6));
+    g_capacity = cap;
+    g_bucket_mask = buckets - 1;
+    hash_rebuild();
+    if (view_was_pool)
+    {
+        g_app.item_instances = g_instances;
+        g_app.item_instance_cap = g_capacity;
+    }
+    return 1;
+}
+
+/* Collect active instances within `radius` of (x,y) into g_scratch (slot order not guaranteed).
+ * Falls back to a linear sweep when the radius spans more cells than there are live slots. */
+static int gather_radius(float x, float y, float radius)
+{
+    if (!g_capacity || radius < 0.0f)
+        return 0;
+    float r2 = radius * radius;
+    int cx0 = cell_coord(x - radius), cx1 = cell_coord(x + radius);
+    int cy0 = cell_coord(y - radius), cy1 = cell_coord(y + radius);
+    long long cells = ((long long) cx1 - cx0 + 1) * ((long long) cy1 - cy0 + 1);
+    int n = 0;
+    if (cells > (long long) g_high_water)
+    {
+        for (int i = 0; i < g_high_water; i++)
+        {
+            float dx = g_instances[i].x - x, dy = g_instances[i].y - y;
+            if (g_instances[i].active && dx * dx + dy * dy <= r2)
+                g_scratch[n++] = i;
+        }
+        return n;
+    }
+    for (int cy = cy0; cy <= cy1; cy++)
+        for (int cx = cx0; cx <= cx1; cx++)
+            for (int i = g_bucket_head[cell_bucket(cx, cy)]; i >= 0; i = g_links[i].next)
+            {
+                if (g_links[i].cx != cx || g_links[i].cy != cy || !g_instances[i].active)
+                    continue;
+                float dx = g_instances[i].x - x, dy = g_instances[i].y - y;
+                if (dx * dx + dy * dy <= r2)
+                    g_scratch[n++] = i;
+            }
+    return n;
+}
+
+static int cmp_int_asc(const void* a, const void* b)
+{
+    int x = *(const int*) a, y = *(const int*) b;
+    return (x > y) - (x < y);
+}
+
 void rogue_items_init_runtime(void)
 {
-    memset(g_instances, 0, sizeof g_instances);
+    pool_reserve(ROGUE_ITEM_INSTANCE_CAP);
+    if (g_capacity)
+    {
+        memset(g_instances, 0, sizeof(RogueItemInstance) * (size_t) g_capacity);
+        memset(g_used, 0, sizeof(uint64_t) * (size_t) (g_capacity >> 6));
+        hash_rebuild();
+    }
+    g_high_water = 0;
+    g_free_word_hint = 0;
     g_app.item_instances = g_instances;
-    g_app.item_instance_cap = ROGUE_ITEM_INSTANCE_CAP;
+    g_app.item_instance_cap = g_capacity;
     g_app.item_instance_count = 0;
 }
 void rogue_items_shutdown_runtime(void)
@@ -29,11 +240,12 @@ void rogue_items_shutdown_runtime(void)
 
 void rogue_items_sync_app_view(void)
 {
-    /* Wire global app view to the internal static pool without mutating item state. */
+    /* Wire global app view to the internal pool without mutating item state. */
+    pool_reserve(ROGUE_ITEM_INSTANCE_CAP);
     g_app.item_instances = g_instances;
-    g_app.item_instance_cap = ROGUE_ITEM_INSTANCE_CAP;
+    g_app.item_instance_cap = g_capacity;
     int c = 0;
-    for (int i = 0; i < ROGUE_ITEM_INSTANCE_CAP; i++)
+    for (int i = 0; i < g_high_water; i++)
     {
         if (g_instances[i].active)
             c++;
@@ -46,6 +258,43 @@ void rogue_items_sync_app_view(void)
 #endif
 }
 
+int rogue_items_capacity(void) { return g_capacity; }
+
+int rogue_items_query_radius(float x, float y, float radius, int* out, int cap)
+{
+    if (!out || cap <= 0)
+        return 0;
+    int n = gather_radius(x, y, radius);
+    if (n > 1)
+        qsort(g_scratch, (size_t) n, sizeof(int), cmp_int_asc);
+    if (n > cap)
+        n = cap;
+    memcpy(out, g_scratch, sizeof(int) * (size_t) n);
+    return n;
+}
+
+int rogue_items_despawn(int index)
+{
+    if (!rogue_item_instance_at(index))
+        return -1;
+    slot_release(index);
+    rogue_loot_vfx_on_despawn(index);
+    return 0;
+}
+
+/* True when a same-rarity drop younger than the coalesce window already sits next to (x,y). */
+static int recent_drop_nearby(float x, float y, int rarity)
+{
+    int n = gather_radius(x, y, ROGUE_ITEM_STACK_MERGE_RADIUS);
+    for (int k = 0; k < n; k++)
+    {
+        const RogueItemInstance* it = &g_instances[g_scratch[k]];
+        if (it->rarity == rarity && it->life_ms < ROGUE_ITEM_PING_COALESCE_MS)
+            return 1;
+    }
+    return 0;
+}
+
 int rogue_items_spawn(int def_index, int quantity, float x, float y)
 {
     if (def_index < 0 || quantity <= 0)
@@ -53,92 +302,109 @@ int rogue_items_spawn(int def_index, int quantity, float x, float y)
         ROGUE_LOOT_LOG_DEBUG("loot_spawn: rejected def=%d qty=%d", def_index, quantity);
         return -1;
     }
-    for (int i = 0; i < ROGUE_ITEM_INSTANCE_CAP; i++)
-        if (!g_instances[i].active)
+    int i = g_capacity ? slot_find_free() : -1;
+    if (i < 0)
+    {
+        /* slots whose `active` flag was cleared directly are reused before the pool grows */
+        for (int k = 0; k < g_high_water; k++)
+            if (slot_used(k) && !g_instances[k].active)
+                slot_release(k);
+        i = slot_find_free();
+    }
+    if (i < 0)
+    {
+        if (!pool_reserve(g_capacity + 1))
         {
-            const RogueItemDef* idef = rogue_item_def_at(def_index);
-            int rarity = (idef ? idef->rarity : 0);
-            g_instances[i].def_index = def_index;
-            g_instances[i].quantity = quantity;
-            g_instances[i].x = x;
-            g_instances[i].y = y;
-            g_instances[i].life_ms = 0;
-            g_instances[i].active = 1;
-            g_instances[i].rarity = rarity;
-            g_instances[i].item_level = 1; /* baseline */
-            g_instances[i].prefix_index = -1;
-            g_instances[i].suffix_index = -1;
-            g_instances[i].prefix_value = 0;
-            g_instances[i].suffix_value = 0;
-            g_instances[i].hidden_filter = 0;
-            g_instances[i].fractured = 0;
-            g_instances[i].quality = 0;
-            g_instances[i].stored_affix_index = -1;
-            g_instances[i].stored_affix_value = 0;
-            g_instances[i].stored_affix_used = 0;
-            g_instances[i].guid = ((unsigned long long) def_index << 32) ^
-                                  (unsigned long long) ((i + 1) * 0x9E3779B185EBCA87ULL) ^
-                                  (unsigned long long) (quantity * 0xC2B2AE3D27D4EB4FULL);
-            g_instances[i].equip_hash_chain = 0ULL;
-            /* Initialize sockets (Phase 5.1). Random count inside min..max if range >0 using local
-             * deterministic LCG seeded from position & def_index. */
-            g_instances[i].socket_count = 0;
-            for (int s = 0; s < 6; s++)
-                g_instances[i].sockets[s] = -1;
-            if (idef)
-            {
-                int min = idef->socket_min, max = idef->socket_max;
-                if (max > 6)
-                    max = 6;
-                if (min < 0)
-                    min = 0;
-                if (max >= min && max > 0)
-                {
-                    unsigned int seed =
-                        (unsigned int) (i * 2654435761u) ^ (unsigned int) def_index ^
-                        (unsigned int) ((int) x * 73856093) ^ (unsigned int) ((int) y * 19349663);
-                    seed = seed * 1664525u + 1013904223u;
-                    int span = (max - min) + 1;
-                    int roll = (span > 0) ? (int) (seed % (unsigned int) span) : 0;
-                    g_instances[i].socket_count = min + roll;
-                    if (g_instances[i].socket_count > 6)
-                        g_instances[i].socket_count = 6;
-                }
-            }
-            /* Set durability baseline: weapons & armor categories get base derived from level &
-             * rarity. */
-            if (idef && (idef->category == ROGUE_ITEM_WEAPON || idef->category == ROGUE_ITEM_ARMOR))
-            {
-                int base_dur = 50 + rarity * 25;
-                g_instances[i].durability_max = base_dur;
-                g_instances[i].durability_cur = base_dur;
-            }
-            else
-            {
-                g_instances[i].durability_max = 0;
-                g_instances[i].durability_cur = 0;
-            }
-            if (i >= g_app.item_instance_count)
-                g_app.item_instance_count = i + 1;
-            /* 12.4 spawn minimap loot ping */
-            rogue_minimap_ping_loot(x, y, rarity);
-            rogue_loot_vfx_on_spawn(i, rarity);
-            if (!g_rogue_loot_suppress_spawn_log)
-            {
-                ROGUE_LOOT_LOG_INFO(
-                    "loot_spawn: def=%d qty=%d at(%.2f,%.2f) slot=%d active_total=%d", def_index,
-                    quantity, x, y, i, rogue_items_active_count() + 1);
-            }
-            return i;
+            ROGUE_LOG_WARN("loot_spawn: pool full (cap=%d) def=%d qty=%d", g_capacity, def_index,
+                           quantity);
+            return -1;
         }
-    ROGUE_LOG_WARN("loot_spawn: pool full (cap=%d) def=%d qty=%d", ROGUE_ITEM_INSTANCE_CAP,
-                   def_index, quantity);
-    return -1;
+        i = slot_find_free();
+    }
+    const RogueItemDef* idef = rogue_item_def_at(def_index);
+    int rarity = (idef ? idef->rarity : 0);
+    int ping = !recent_drop_nearby(x, y, rarity);
+    g_instances[i].def_index = def_index;
+    g_instances[i].quantity = quantity;
+    g_instances[i].x = x;
+    g_instances[i].y = y;
+    g_instances[i].life_ms = 0;
+    g_instances[i].active = 1;
+    g_instances[i].rarity = rarity;
+    g_instances[i].item_level = 1; /* baseline */
+    g_instances[i].prefix_index = -1;
+    g_instances[i].suffix_index = -1;
+    g_instances[i].prefix_value = 0;
+    g_instances[i].suffix_value = 0;
+    g_instances[i].hidden_filter = 0;
+    g_instances[i].fractured = 0;
+    g_instances[i].quality = 0;
+    g_instances[i].stored_affix_index = -1;
+    g_instances[i].stored_affix_value = 0;
+    g_instances[i].stored_affix_used = 0;
+    g_instances[i].guid = ((unsigned long long) def_index << 32) ^
+                          (unsigned long long) ((i + 1) * 0x9E3779B185EBCA87ULL) ^
+                          (unsigned long long) (quantity * 0xC2B2AE3D27D4EB4FULL);
+    g_instances[i].equip_hash_chain = 0ULL;
+    /* Initialize sockets (Phase 5.1). Random count inside min..max if range >0 using local
+     * deterministic LCG seeded from position & def_index. */
+    g_instances[i].socket_count = 0;
+    for (int s = 0; s < 6; s++)
+        g_instances[i].sockets[s] = -1;
+    if (idef)
+    {
+        int min = idef->socket_min, max = idef->socket_max;
+        if (max > 6)
+            max = 6;
+        if (min < 0)
+            min = 0;
+        if (max >= min && max > 0)
+        {
+            unsigned int seed =
+                (unsigned int) (i * 2654435761u) ^ (unsigned int) def_index ^
+                (unsigned int) ((int) x * 73856093) ^ (unsigned int) ((int) y * 19349663);
+            seed = seed * 1664525u + 1013904223u;
+            int span = (max - min) + 1;
+            int roll = (span > 0) ? (int) (seed % (unsigned int) span) : 0;
+            g_instances[i].socket_count = min + roll;
+            if (g_instances[i].socket_count > 6)
+                g_instances[i].socket_count = 6;
+        }
+    }
+    /* Set durability baseline: weapons & armor categories get base derived from level &
+     * rarity. */
+    if (idef && (idef->category == ROGUE_ITEM_WEAPON || idef->category == ROGUE_ITEM_ARMOR))
+    {
+        int base_dur = 50 + rarity * 25;
+        g_instances[i].durability_max = base_dur;
+        g_instances[i].durability_cur = base_dur;
+    }
+    else
+    {
+        g_instances[i].durability_max = 0;
+        g_instances[i].durability_cur = 0;
+    }
+    g_used[i >> 6] |= 1ULL << (i & 63);
+    link_insert(i);
+    if (i >= g_high_water)
+        g_high_water = i + 1;
+    if (i >= g_app.item_instance_count)
+        g_app.item_instance_count = i + 1;
+    /* 12.4 spawn minimap loot ping (coalesced with recent neighbouring drops) */
+    if (ping)
+        rogue_minimap_ping_loot(x, y, rarity);
+    rogue_loot_vfx_on_spawn(i, rarity);
+    if (!g_rogue_loot_suppress_spawn_log)
+    {
+        ROGUE_LOOT_LOG_INFO("loot_spawn: def=%d qty=%d at(%.2f,%.2f) slot=%d active_total=%d",
+                            def_index, quantity, x, y, i, rogue_items_active_count());
+    }
+    return i;
 }
 
 const RogueItemInstance* rogue_item_instance_at(int index)
 {
-    if (index < 0 || index >= ROGUE_ITEM_INSTANCE_CAP)
+    if (index < 0 || index >= g_capacity)
         return NULL;
     if (!g_instances[index].active)
         return NULL;
@@ -158,7 +424,7 @@ unsigned long long rogue_item_instance_equip_chain(int inst_index)
 
 int rogue_item_instance_generate_affixes(int inst_index, unsigned int* rng_state, int rarity)
 {
-    if (inst_index < 0 || inst_index >= ROGUE_ITEM_INSTANCE_CAP)
+    if (inst_index < 0 || inst_index >= g_capacity)
         return -1;
     if (!rng_state)
         return -1;
@@ -323,7 +589,7 @@ int rogue_item_instance_damage_max(int inst_index)
 int rogue_item_instance_apply_affixes(int inst_index, int rarity, int prefix_index,
                                       int prefix_value, int suffix_index, int suffix_value)
 {
-    if (inst_index < 0 || inst_index >= ROGUE_ITEM_INSTANCE_CAP)
+    if (inst_index < 0 || inst_index >= g_capacity)
         return -1;
     RogueItemInstance* it = &g_instances[inst_index];
     if (!it->active)
@@ -744,7 +1010,7 @@ int rogue_item_instance_fusion(int target_inst_index, int sacrifice_inst_index)
     int* dst_value = cand_is_pref[best] ? &tgt->prefix_value : &tgt->suffix_value;
     *dst_index = cand_idx[best];
     *dst_value = applied_val;
-    sac->active = 0; /* sacrifice consumed */
+    slot_release(sacrifice_inst_index); /* sacrifice consumed */
     ROGUE_LOOT_LOG_DEBUG(
         "fusion: applied %s idx=%d val=%d (clamped_from=%d) to tgt=%d cur=%d cap=%d",
         cand_is_pref[best] ? "PREFIX" : "SUFFIX", cand_idx[best], applied_val, cand_val[best],
@@ -799,7 +1065,7 @@ int rogue_item_instance_socket_remove(int inst_index, int slot)
 int rogue_items_active_count(void)
 {
     int c = 0;
-    for (int i = 0; i < ROGUE_ITEM_INSTANCE_CAP; i++)
+    for (int i = 0; i < g_high_water; i++)
     {
         if (g_instances[i].active)
             c++;
@@ -809,7 +1075,7 @@ int rogue_items_active_count(void)
 int rogue_items_visible_count(void)
 {
     int c = 0;
-    for (int i = 0; i < ROGUE_ITEM_INSTANCE_CAP; i++)
+    for (int i = 0; i < g_high_water; i++)
     {
         if (g_instances[i].active && !g_instances[i].hidden_filter)
             c++;
@@ -820,7 +1086,7 @@ int rogue_items_visible_count(void)
 int rogue_loot_filter_match(const RogueItemDef* def);
 void rogue_items_reapply_filter(void)
 {
-    for (int i = 0; i < ROGUE_ITEM_INSTANCE_CAP; i++)
+    for (int i = 0; i < g_high_water; i++)
     {
         if (!g_instances[i].active)
             continue;
@@ -828,57 +1094,73 @@ void rogue_items_reapply_filter(void)
         g_instances[i].hidden_filter = (rogue_loot_filter_match(d) == 0) ? 1 : 0;
     }
 }
+
+/* Stack merge for one receiver: same def / rarity partners with a higher slot inside the merge
+ * radius (all in the 3x3 neighbouring cells) drain into `i` in slot order until it is full. */
+static void merge_into(int i)
+{
+    RogueItemInstance* dst = &g_instances[i];
+    const RogueItemDef* d = rogue_item_def_at(dst->def_index);
+    int stack_max = d ? d->stack_max : 999999;
+    if (dst->quantity >= stack_max)
+        return;
+    int n = gather_radius(dst->x, dst->y, ROGUE_ITEM_STACK_MERGE_RADIUS), m = 0;
+    for (int k = 0; k < n; k++)
+    {
+        const RogueItemInstance* src = &g_instances[g_scratch[k]];
+        if (g_scratch[k] > i && src->def_index == dst->def_index && src->rarity == dst->rarity)
+            g_scratch[m++] = g_scratch[k];
+    }
+    if (m > 1)
+        qsort(g_scratch, (size_t) m, sizeof(int), cmp_int_asc);
+    for (int k = 0; k < m && dst->quantity < stack_max; k++)
+    {
+        RogueItemInstance* src = &g_instances[g_scratch[k]];
+        int space = stack_max - dst->quantity;
+        int move = src->quantity < space ? src->quantity : space;
+        dst->quantity += move;
+        src->quantity -= move;
+        if (src->quantity <= 0)
+            slot_release(g_scratch[k]);
+    }
+}
+
 void rogue_items_update(float dt_ms)
 {
-    /* Advance lifetime & mark for despawn */
-    for (int i = 0; i < ROGUE_ITEM_INSTANCE_CAP; i++)
-        if (g_instances[i].active)
+    /* Advance lifetime & mark for despawn; reclaim slots deactivated outside the pool API and
+     * re-bucket instances whose position was edited in place. */
+    for (int i = 0; i < g_high_water; i++)
+    {
+        if (!slot_used(i))
+            continue;
+        if (!g_instances[i].active)
         {
-            g_instances[i].life_ms += dt_ms;
-            int override_ms =
-                rogue_rarity_get_despawn_ms(g_instances[i].rarity); /* advanced rarity override */
-            int limit = override_ms > 0 ? override_ms : ROGUE_ITEM_DESPAWN_MS;
-            if (g_instances[i].life_ms >= (float) limit)
-            {
-                g_instances[i].active = 0;
-                rogue_loot_vfx_on_despawn(i);
-                continue;
-            }
+            slot_release(i);
+            continue;
         }
-    /* Stack merge pass (single sweep O(n^2) small cap) */
-    for (int i = 0; i < ROGUE_ITEM_INSTANCE_CAP; i++)
-        if (g_instances[i].active)
+        g_instances[i].life_ms += dt_ms;
+        int override_ms =
+            rogue_rarity_get_despawn_ms(g_instances[i].rarity); /* advanced rarity override */
+        int limit = override_ms > 0 ? override_ms : ROGUE_ITEM_DESPAWN_MS;
+        if (g_instances[i].life_ms >= (float) limit)
         {
-            for (int j = i + 1; j < ROGUE_ITEM_INSTANCE_CAP; j++)
-                if (g_instances[j].active)
-                {
-                    if (g_instances[i].def_index == g_instances[j].def_index &&
-                        g_instances[i].rarity == g_instances[j].rarity)
-                    {
-                        float dx = g_instances[i].x - g_instances[j].x;
-                        float dy = g_instances[i].y - g_instances[j].y;
-                        if (dx * dx + dy * dy <=
-                            ROGUE_ITEM_STACK_MERGE_RADIUS * ROGUE_ITEM_STACK_MERGE_RADIUS)
-                        {
-                            /* Merge j into i respecting stack_max */
-                            const RogueItemDef* d = rogue_item_def_at(g_instances[i].def_index);
-                            int stack_max = d ? d->stack_max : 999999;
-                            int space = stack_max - g_instances[i].quantity;
-                            if (space > 0)
-                            {
-                                int move = g_instances[j].quantity < space ? g_instances[j].quantity
-                                                                           : space;
-                                g_instances[i].quantity += move;
-                                g_instances[j].quantity -= move;
-                                if (g_instances[j].quantity <= 0)
-                                {
-                                    g_instances[j].active = 0;
-                                }
-                            }
-                        }
-                    }
-                }
+            slot_release(i);
+            rogue_loot_vfx_on_despawn(i);
+            continue;
         }
+        if (g_links[i].cx != cell_coord(g_instances[i].x) ||
+            g_links[i].cy != cell_coord(g_instances[i].y))
+        {
+            link_remove(i);
+            link_insert(i);
+        }
+    }
+    /* Stack merge pass (spatial hash: neighbouring cells only) */
+    for (int i = 0; i < g_high_water; i++)
+        if (g_instances[i].active)
+            merge_into(i);
+    while (g_high_water > 0 && !slot_used(g_high_water - 1))
+        g_high_water--;
     /* Update VFX after lifetime & potential merges */
     rogue_loot_vfx_update(dt_ms);
 }
@@ -3,10 +3,15 @@
 #include "loot_item_defs.h"
 #include <stdint.h>
 
+/* Initial ground item pool capacity; the pool doubles on demand up to ROGUE_ITEM_INSTANCE_MAX. */
 #ifndef ROGUE_ITEM_INSTANCE_CAP
 #define ROGUE_ITEM_INSTANCE_CAP 256
 #endif
 
+#ifndef ROGUE_ITEM_INSTANCE_MAX
+#define ROGUE_ITEM_INSTANCE_MAX 65536
+#endif
+
 #ifndef ROGUE_ITEM_DESPAWN_MS
 #define ROGUE_ITEM_DESPAWN_MS 60000 /* 60s default */
 #endif
@@ -15,6 +20,12 @@
 #define ROGUE_ITEM_STACK_MERGE_RADIUS 0.45f
 #endif
 
+/* A spawn skips its minimap ping when a same-rarity item younger than this already sits within
+ * the merge radius (burst drops collapse into one ping). */
+#ifndef ROGUE_ITEM_PING_COALESCE_MS
+#define ROGUE_ITEM_PING_COALESCE_MS 1000.0f
+#endif
+
 typedef struct RogueItemInstance
 {
     int def_index; /* base item definition index */
@@ -67,6 +78,14 @@ void rogue_items_shutdown_runtime(void);
     Safe to call anytime; updates pointer, cap, and scans active count. */
 void rogue_items_sync_app_view(void);
 int rogue_items_spawn(int def_index, int quantity, float x, float y);
+/* Deactivate an instance and return its slot to the pool (pickup / consumption). Code that clears
+ * `active` directly has its slot reclaimed on the next rogue_items_update. 0 ok, -1 inactive. */
+int rogue_items_despawn(int index);
+/* Current pool capacity (slot indices are always < capacity). */
+int rogue_items_capacity(void);
+/* Active instances within `radius` of (x,y) via the merge-radius spatial hash. Writes up to `cap`
+ * indices in ascending slot order (lowest first) and returns the number written. */
+int rogue_items_query_radius(float x, float y, float radius, int* out, int cap);
 /* Runtime suppression flag for high-volume spawn logging (e.g., fuzz tests). 0=log, 1=suppress. */
 extern int g_rogue_loot_suppress_spawn_log;
 int rogue_items_active_count(void);
@@ -1,5 +1,6 @@
 #include "loot_item_defs.h"
 #include "loot_affixes.h" /* ensure affixes present for tests that roll immediately */
+#include "../../util/json_tok.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -277,8 +278,11 @@ int rogue_item_defs_validate_file(const char* path, int* out_lines, int cap)
     return malformed;
 }
 
-int rogue_item_defs_load_from_cfg(const char* path)
+int rogue_item_defs_parse_cfg(const char* path, RogueItemDef** out_defs)
 {
+    if (!out_defs)
+        return -1;
+    *out_defs = NULL;
     FILE* f = NULL;
 #if defined(_MSC_VER)
     if (fopen_s(&f, path, "rb") != 0)
@@ -310,7 +314,8 @@ int rogue_item_defs_load_from_cfg(const char* path)
             return -1;
     }
     char line[512];
-    int added = 0;
+    RogueItemDef* defs = NULL;
+    int count = 0, cap = 0;
     int lineno = 0;
     while (fgets(line, sizeof line, f))
     {
@@ -331,11 +336,34 @@ int rogue_item_defs_load_from_cfg(const char* path)
         }
         if (r == 0)
             continue; /* skip */
+        if (count == cap)
+        {
+            int ncap = cap ? cap * 2 : 32;
+            RogueItemDef* grown =
+                (RogueItemDef*) realloc(defs, sizeof(RogueItemDef) * (size_t) ncap);
+            if (!grown)
+                break;
+            defs = grown;
+            cap = ncap;
+        }
+        defs[count++] = d;
+    }
+    fclose(f);
+    *out_defs = defs;
+    return count;
+}
+
+int rogue_item_defs_commit(const RogueItemDef* defs, int count)
+{
+    int added = 0;
+    for (int i = 0; i < count; i++)
+    {
+        const RogueItemDef* d = &defs[i];
         /* If an item with this id already exists, update it in place instead of duplicating. */
-        int existing = rogue_item_def_index(d.id);
+        int existing = rogue_item_def_index(d->id);
         if (existing >= 0)
         {
-            g_item_defs[existing] = d; /* update */
+            g_item_defs[existing] = *d; /* update */
         }
         else
         {
@@ -344,11 +372,10 @@ int rogue_item_defs_load_from_cfg(const char* path)
                 fprintf(stderr, "item_defs: cap reached (%d)\n", ROGUE_ITEM_DEF_CAP);
                 break;
             }
-            g_item_defs[g_item_def_count++] = d;
+            g_item_defs[g_item_def_count++] = *d;
             added++;
         }
     }
-    fclose(f);
     /* Rebuild hash index after each file load to keep fast path current (cost acceptable for small
      * counts) */
     rogue_item_defs_build_index();
@@ -377,44 +404,18 @@ int rogue_item_defs_load_from_cfg(const char* path)
     return added;
 }
 
-/* ---- Phase 16.1: JSON Import / Export ---- */
-static const char* skip_ws(const char* s)
-{
-    while (*s && (unsigned char) *s <= 32)
-        ++s;
-    return s;
-}
-static const char* parse_string(const char* s, char* out, int cap)
-{
-    s = skip_ws(s);
-    if (*s != '"')
-        return NULL;
-    ++s;
-    int i = 0;
-    while (*s && *s != '"')
-    {
-        if (*s == '\\' && s[1])
-            s++;
-        if (i + 1 < cap)
-            out[i++] = *s;
-        ++s;
-    }
-    if (*s != '"')
-        return NULL;
-    out[i] = '\0';
-    return s + 1;
-}
-static const char* parse_number(const char* s, int* out)
+int rogue_item_defs_load_from_cfg(const char* path)
 {
-    s = skip_ws(s);
-    char* end = NULL;
-    long v = strtol(s, &end, 10);
-    if (end == s)
-        return NULL;
-    *out = (int) v;
-    return end;
+    RogueItemDef* defs = NULL;
+    int count = rogue_item_defs_parse_cfg(path, &defs);
+    if (count < 0)
+        return -1;
+    int added = rogue_item_defs_commit(defs, count);
+    free(defs);
+    return added;
 }
 
+/* ---- Phase 16.1: JSON Import / Export ---- */
 int rogue_item_defs_load_from_json(const char* path)
 {
     if (!path)
@@ -445,164 +446,101 @@ int rogue_item_defs_load_from_json(const char* path)
     size_t rd = fread(buf, 1, (size_t) sz, f);
     buf[rd] = '\0';
     fclose(f);
-    const char* s = skip_ws(buf);
-    if (*s != '[')
+    RogueJsonTokenizer t;
+    RogueJsonToken v, obj;
+    RogueJsonView key;
+    rogue_json_tok_init(&t, buf, rd);
+    if (rogue_json_tok_next(&t, &v) != ROGUE_JTOK_ARRAY_BEGIN)
     {
         free(buf);
         return -1;
     }
-    ++s;
     int added = 0;
-    char key[64];
-    char sval[256];
-    while (1)
+    while (rogue_json_tok_element(&t, &obj) > 0)
     {
-        s = skip_ws(s);
-        if (*s == ']')
-        {
-            ++s;
-            break;
-        }
-        if (*s != '{')
+        if (obj.type != ROGUE_JTOK_OBJECT_BEGIN)
         {
-            break;
+            (void) rogue_json_tok_skip(&t, &obj);
+            continue;
         }
-        ++s;
         RogueItemDef d;
         memset(&d, 0, sizeof d);
         d.stack_max = 1;
         int have_id = 0, have_name = 0;
-        int done_obj = 0;
-        while (!done_obj)
+        int r, num;
+        while ((r = rogue_json_tok_member(&t, &key, &v)) > 0)
         {
-            s = skip_ws(s);
-            if (*s == '}')
-            {
-                ++s;
-                break;
-            }
-            const char* ns = parse_string(s, key, sizeof key);
-            if (!ns)
+            if (v.type == ROGUE_JTOK_STRING)
             {
-                done_obj = 1;
-                break;
-            }
-            s = skip_ws(ns);
-            if (*s != ':')
-            {
-                done_obj = 1;
-                break;
-            }
-            ++s;
-            s = skip_ws(s);
-            if (*s == '"')
-            {
-                const char* vs = parse_string(s, sval, sizeof sval);
-                if (!vs)
-                {
-                    done_obj = 1;
-                    break;
-                }
-                s = skip_ws(vs);
-                if (strcmp(key, "id") == 0)
-                {
-#if defined(_MSC_VER)
-                    strncpy_s(d.id, sizeof d.id, sval, _TRUNCATE);
-#else
-                    strncpy(d.id, sval, sizeof d.id - 1);
-#endif
-                    have_id = 1;
-                }
-                else if (strcmp(key, "name") == 0)
-                {
-#if defined(_MSC_VER)
-                    strncpy_s(d.name, sizeof d.name, sval, _TRUNCATE);
-#else
-                    strncpy(d.name, sval, sizeof d.name - 1);
-#endif
-                    have_name = 1;
-                }
-                else if (strcmp(key, "sprite_sheet") == 0)
-                {
-#if defined(_MSC_VER)
-                    strncpy_s(d.sprite_sheet, sizeof d.sprite_sheet, sval, _TRUNCATE);
-#else
-                    strncpy(d.sprite_sheet, sval, sizeof d.sprite_sheet - 1);
-#endif
-                }
+                if (rogue_json_view_eq(key, "id"))
+                    have_id = rogue_json_tok_copy(&v, d.id, sizeof d.id) > 0;
+                else if (rogue_json_view_eq(key, "name"))
+                    have_name = rogue_json_tok_copy(&v, d.name, sizeof d.name) > 0;
+                else if (rogue_json_view_eq(key, "sprite_sheet"))
+                    rogue_json_tok_copy(&v, d.sprite_sheet, sizeof d.sprite_sheet);
             }
-            else if ((*s >= '0' && *s <= '9') || *s == '-')
+            else if (v.type == ROGUE_JTOK_NUMBER && rogue_json_tok_int(&v, &num))
             {
-                int num;
-                const char* vs = parse_number(s, &num);
-                if (!vs)
-                {
-                    done_obj = 1;
-                    break;
-                }
-                s = skip_ws(vs);
-                if (strcmp(key, "category") == 0)
+                if (rogue_json_view_eq(key, "category"))
                     d.category = (RogueItemCategory) num;
-                else if (strcmp(key, "level_req") == 0)
+                else if (rogue_json_view_eq(key, "level_req"))
                     d.level_req = num;
-                else if (strcmp(key, "stack_max") == 0)
+                else if (rogue_json_view_eq(key, "stack_max"))
                     d.stack_max = num > 0 ? num : 1;
-                else if (strcmp(key, "base_value") == 0)
+                else if (rogue_json_view_eq(key, "base_value"))
                     d.base_value = num;
-                else if (strcmp(key, "base_damage_min") == 0)
+                else if (rogue_json_view_eq(key, "base_damage_min"))
                     d.base_damage_min = num;
-                else if (strcmp(key, "base_damage_max") == 0)
+                else if (rogue_json_view_eq(key, "base_damage_max"))
                     d.base_damage_max = num;
-                else if (strcmp(key, "base_armor") == 0)
+                else if (rogue_json_view_eq(key, "base_armor"))
                     d.base_armor = num;
-                else if (strcmp(key, "sprite_tx") == 0)
+                else if (rogue_json_view_eq(key, "sprite_tx"))
                     d.sprite_tx = num;
-                else if (strcmp(key, "sprite_ty") == 0)
+                else if (rogue_json_view_eq(key, "sprite_ty"))
                     d.sprite_ty = num;
-                else if (strcmp(key, "sprite_tw") == 0)
+                else if (rogue_json_view_eq(key, "sprite_tw"))
                     d.sprite_tw = num > 0 ? num : 1;
-                else if (strcmp(key, "sprite_th") == 0)
+                else if (rogue_json_view_eq(key, "sprite_th"))
                     d.sprite_th = num > 0 ? num : 1;
-                else if (strcmp(key, "rarity") == 0)
+                else if (rogue_json_view_eq(key, "rarity"))
                     d.rarity = num < 0 ? 0 : num;
-                else if (strcmp(key, "flags") == 0)
+                else if (rogue_json_view_eq(key, "flags"))
                     d.flags = num;
-                else if (strcmp(key, "implicit_strength") == 0)
+                else if (rogue_json_view_eq(key, "implicit_strength"))
                     d.implicit_strength = num;
-                else if (strcmp(key, "implicit_dexterity") == 0)
+                else if (rogue_json_view_eq(key, "implicit_dexterity"))
                     d.implicit_dexterity = num;
-                else if (strcmp(key, "implicit_vitality") == 0)
+                else if (rogue_json_view_eq(key, "implicit_vitality"))
                     d.implicit_vitality = num;
-                else if (strcmp(key, "implicit_intelligence") == 0)
+                else if (rogue_json_view_eq(key, "implicit_intelligence"))
                     d.implicit_intelligence = num;
-                else if (strcmp(key, "implicit_armor_flat") == 0)
+                else if (rogue_json_view_eq(key, "implicit_armor_flat"))
                     d.implicit_armor_flat = num;
-                else if (strcmp(key, "implicit_resist_physical") == 0)
+                else if (rogue_json_view_eq(key, "implicit_resist_physical"))
                     d.implicit_resist_physical = num;
-                else if (strcmp(key, "implicit_resist_fire") == 0)
+                else if (rogue_json_view_eq(key, "implicit_resist_fire"))
                     d.implicit_resist_fire = num;
-                else if (strcmp(key, "implicit_resist_cold") == 0)
+                else if (rogue_json_view_eq(key, "implicit_resist_cold"))
                     d.implicit_resist_cold = num;
-                else if (strcmp(key, "implicit_resist_lightning") == 0)
+                else if (rogue_json_view_eq(key, "implicit_resist_lightning"))
                     d.implicit_resist_lightning = num;
-                else if (strcmp(key, "implicit_resist_poison") == 0)
+                else if (rogue_json_view_eq(key, "implicit_resist_poison"))
                     d.implicit_resist_poison = num;
-                else if (strcmp(key, "implicit_resist_status") == 0)
+                else if (rogue_json_view_eq(key, "implicit_resist_status"))
                     d.implicit_resist_status = num;
-                else if (strcmp(key, "set_id") == 0)
+                else if (rogue_json_view_eq(key, "set_id"))
                     d.set_id = num;
-                else if (strcmp(key, "socket_min") == 0)
+                else if (rogue_json_view_eq(key, "socket_min"))
                     d.socket_min = num;
-                else if (strcmp(key, "socket_max") == 0)
+                else if (rogue_json_view_eq(key, "socket_max"))
                     d.socket_max = num;
             }
-            s = skip_ws(s);
-            if (*s == ',')
-            {
-                ++s;
-                continue;
-            }
+            else
+                (void) rogue_json_tok_skip(&t, &v);
         }
+        if (r < 0)
+            break; /* malformed: keep the defs accepted so far */
         if (have_id && have_name)
         {
             if (d.socket_min < 0)
@@ -623,12 +561,6 @@ int rogue_item_defs_load_from_json(const char* path)
                 added++;
             }
         }
-        s = skip_ws(s);
-        if (*s == ',')
-        {
-            ++s;
-            continue;
-        }
     }
     free(buf);
     rogue_item_defs_build_index();
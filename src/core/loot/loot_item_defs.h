@@ -60,6 +60,13 @@ typedef struct RogueItemDef
 
 /* Runtime registry */
 int rogue_item_defs_load_from_cfg(const char* path); /* returns count added or <0 on error */
+/* Parse/commit split of load_from_cfg for parallel content loading. parse_cfg reads a cfg file
+ * (same relative fallbacks) into a malloc'd array without touching the registry, so it is safe on
+ * any thread; free() *out_defs after commit. Returns the number of parsed defs or -1 if the file
+ * cannot be opened. commit upserts by id on the owning thread, rebuilds the index, lazily loads
+ * affixes like load_from_cfg and returns the number of new defs. */
+int rogue_item_defs_parse_cfg(const char* path, RogueItemDef** out_defs);
+int rogue_item_defs_commit(const RogueItemDef* defs, int count);
 /* Phase 16.1 (Tooling): JSON import path (array of objects). Path must end with .json. */
 int rogue_item_defs_load_from_json(const char* path); /* returns count added or <0 on error */
 /* Phase 16.1 (Tooling): Export all currently loaded item defs to JSON array string. Returns number
@@ -0,0 +1,299 @@
+/* Baked loot content pack sections (see loot_pack.h) */
+#include "loot_pack.h"
+#include "loot_affixes.h"
+#include "loot_item_defs.h"
+#include "loot_tables.h"
+#include <stdlib.h>
+#include <string.h>
+
+static void copy_str(char* dst, size_t cap, const char* src)
+{
+    size_t n = strlen(src);
+    if (n >= cap)
+        n = cap - 1;
+    memcpy(dst, src, n);
+    dst[n] = '\0';
+}
+
+int rogue_loot_pack_bake(RoguePackWriter* w)
+{
+    if (!w)
+        return -1;
+    int n_affix = rogue_affix_count();
+    int n_items = rogue_item_defs_count();
+    int n_tables = rogue_loot_tables_count();
+    int n_entries = 0;
+    for (int i = 0; i < n_tables; i++)
+        n_entries += rogue_loot_table_at(i)->entry_count;
+    RogueLootPackAffix* affixes =
+        (RogueLootPackAffix*) calloc((size_t) n_affix + 1, sizeof(RogueLootPackAffix));
+    RogueLootPackItem* items =
+        (RogueLootPackItem*) calloc((size_t) n_items + 1, sizeof(RogueLootPackItem));
+    RogueLootPackTable* tables =
+        (RogueLootPackTable*) calloc((size_t) n_tables + 1, sizeof(RogueLootPackTable));
+    RogueLootPackEntry* entries =
+        (RogueLootPackEntry*) calloc((size_t) n_entries + 1, sizeof(RogueLootPackEntry));
+    int rc = -1;
+    if (!affixes || !items || !tables || !entries)
+        goto done;
+    for (int i = 0; i < n_affix; i++)
+    {
+        const RogueAffixDef* a = rogue_affix_at(i);
+        RogueLootPackAffix* r = &affixes[i];
+        r->id = rogue_pack_writer_string(w, a->id);
+        r->type = (int32_t) a->type;
+        r->stat = (int32_t) a->stat;
+        r->min_value = a->min_value;
+        r->max_value = a->max_value;
+        for (int k = 0; k < 5; k++)
+            r->weight_per_rarity[k] = a->weight_per_rarity[k];
+    }
+    for (int i = 0; i < n_items; i++)
+    {
+        const RogueItemDef* d = rogue_item_def_at(i);
+        RogueLootPackItem* r = &items[i];
+        r->id = rogue_pack_writer_string(w, d->id);
+        r->name = rogue_pack_writer_string(w, d->name);
+        r->sprite_sheet = rogue_pack_writer_string(w, d->sprite_sheet);
+#define BAKE_FIELD(f) r->f = (int32_t) d->f;
+        ROGUE_LOOT_PACK_ITEM_INTS(BAKE_FIELD)
+#undef BAKE_FIELD
+    }
+    int e = 0;
+    for (int i = 0; i < n_tables; i++)
+    {
+        const RogueLootTableDef* t = rogue_loot_table_at(i);
+        RogueLootPackTable* r = &tables[i];
+        r->id = rogue_pack_writer_string(w, t->id);
+        r->rolls_min = t->rolls_min;
+        r->rolls_max = t->rolls_max;
+        r->first_entry = e;
+        r->entry_count = t->entry_count;
+        for (int k = 0; k < t->entry_count; k++, e++)
+        {
+            const RogueLootEntry* src = &t->entries[k];
+            entries[e].item_index = src->item_def_index;
+            entries[e].weight = src->weight;
+            entries[e].qmin = src->qmin;
+            entries[e].qmax = src->qmax;
+            entries[e].rarity_min = src->rarity_min;
+            entries[e].rarity_max = src->rarity_max;
+        }
+    }
+    if (rogue_pack_writer_section(w, ROGUE_LOOT_PACK_AFFIXES, sizeof(RogueLootPackAffix), affixes,
+                                  n_affix) == 0 &&
+        rogue_pack_writer_section(w, ROGUE_LOOT_PACK_ITEMS, sizeof(RogueLootPackItem), items,
+                                  n_items) == 0 &&
+        rogue_pack_writer_section(w, ROGUE_LOOT_PACK_TABLES, sizeof(RogueLootPackTable), tables,
+                                  n_tables) == 0 &&
+        rogue_pack_writer_section(w, ROGUE_LOOT_PACK_ENTRIES, sizeof(RogueLootPackEntry),
+                                  entries, n_entries) == 0)
+        rc = 0;
+done:
+    free(affixes);
+    free(items);
+    free(tables);
+    free(entries);
+    return rc;
+}
+
+int rogue_loot_pack_bake_file(const char* path)
+{
+    RoguePackWriter w;
+    if (rogue_pack_writer_init(&w) != 0)
+        return -1;
+    int rc = rogue_loot_pack_bake(&w);
+    if (rc == 0)
+        rc = rogue_pack_writer_save(&w, path);
+    rogue_pack_writer_free(&w);
+    return rc;
+}
+
+const RogueLootPackItem* rogue_loot_pack_items(const RoguePack* pack, int* count)
+{
+    return (const RogueLootPackItem*) rogue_pack_section(pack, ROGUE_LOOT_PACK_ITEMS,
+                                                         sizeof(RogueLootPackItem), count);
+}
+const RogueLootPackAffix* rogue_loot_pack_affixes(const RoguePack* pack, int* count)
+{
+    return (const RogueLootPackAffix*) rogue_pack_section(pack, ROGUE_LOOT_PACK_AFFIXES,
+                                                          sizeof(RogueLootPackAffix), count);
+}
+const RogueLootPackTable* rogue_loot_pack_tables(const RoguePack* pack, int* count)
+{
+    return (const RogueLootPackTable*) rogue_pack_section(pack, ROGUE_LOOT_PACK_TABLES,
+                                                          sizeof(RogueLootPackTable), count);
+}
+const RogueLootPackEntry* rogue_loot_pack_entries(const RoguePack* pack, int* count)
+{
+    return (const RogueLootPackEntry*) rogue_pack_section(pack, ROGUE_LOOT_PACK_ENTRIES,
+                                                          sizeof(RogueLootPackEntry), count);
+}
+
+/* All four sections present, table entry ranges and entry item indices in bounds. */
+typedef struct PackView
+{
+    const RogueLootPackAffix* affixes;
+    const RogueLootPackItem* items;
+    const RogueLootPackTable* tables;
+    const RogueLootPackEntry* entries;
+    int n_affix, n_items, n_tables, n_entries;
+} PackView;
+
+static int view_pack(const RoguePack* pack, PackView* v)
+{
+    v->affixes = rogue_loot_pack_affixes(pack, &v->n_affix);
+    v->items = rogue_loot_pack_items(pack, &v->n_items);
+    v->tables = rogue_loot_pack_tables(pack, &v->n_tables);
+    v->entries = rogue_loot_pack_entries(pack, &v->n_entries);
+    if (!v->affixes || !v->items || !v->tables || !v->entries)
+        return ROGUE_PACK_ERR_FORMAT;
+    for (int i = 0; i < v->n_tables; i++)
+    {
+        const RogueLootPackTable* t = &v->tables[i];
+        if (t->first_entry < 0 || t->entry_count < 0 || t->entry_count > ROGUE_MAX_LOOT_ENTRIES ||
+            t->first_entry > v->n_entries - t->entry_count)
+            return ROGUE_PACK_ERR_FORMAT;
+    }
+    for (int i = 0; i < v->n_entries; i++)
+        if (v->entries[i].item_index < -1 || v->entries[i].item_index >= v->n_items)
+            return ROGUE_PACK_ERR_FORMAT;
+    return 0;
+}
+
+static void to_affix(const RoguePack* pack, const RogueLootPackAffix* r, RogueAffixDef* a)
+{
+    memset(a, 0, sizeof *a);
+    copy_str(a->id, sizeof a->id, rogue_pack_string(pack, r->id));
+    a->type = (RogueAffixType) r->type;
+    a->stat = (RogueAffixStat) r->stat;
+    a->min_value = r->min_value;
+    a->max_value = r->max_value;
+    for (int k = 0; k < 5; k++)
+        a->weight_per_rarity[k] = r->weight_per_rarity[k];
+}
+
+static void to_item(const RoguePack* pack, const RogueLootPackItem* r, RogueItemDef* d)
+{
+    memset(d, 0, sizeof *d);
+    copy_str(d->id, sizeof d->id, rogue_pack_string(pack, r->id));
+    copy_str(d->name, sizeof d->name, rogue_pack_string(pack, r->name));
+    copy_str(d->sprite_sheet, sizeof d->sprite_sheet, rogue_pack_string(pack, r->sprite_sheet));
+#define LOAD_FIELD(f) d->f = r->f;
+    ROGUE_LOOT_PACK_ITEM_INTS(LOAD_FIELD)
+#undef LOAD_FIELD
+}
+
+static void to_table(const PackView* v, const RoguePack* pack, const RogueLootPackTable* r,
+                     RogueLootTableDef* t)
+{
+    memset(t, 0, sizeof *t);
+    copy_str(t->id, sizeof t->id, rogue_pack_string(pack, r->id));
+    t->rolls_min = r->rolls_min;
+    t->rolls_max = r->rolls_max;
+    t->entry_count = r->entry_count;
+    for (int k = 0; k < r->entry_count; k++)
+    {
+        const RogueLootPackEntry* src = &v->entries[r->first_entry + k];
+        RogueLootEntry* e = &t->entries[k];
+        e->item_def_index = src->item_index;
+        e->weight = src->weight;
+        e->qmin = src->qmin;
+        e->qmax = src->qmax;
+        e->rarity_min = src->rarity_min;
+        e->rarity_max = src->rarity_max;
+    }
+}
+
+int rogue_loot_pack_load(const RoguePack* pack)
+{
+    PackView v;
+    if (view_pack(pack, &v) != 0)
+        return ROGUE_PACK_ERR_FORMAT;
+    RogueAffixDef* affixes =
+        (RogueAffixDef*) malloc(sizeof(RogueAffixDef) * (size_t) (v.n_affix + 1));
+    RogueItemDef* items =
+        (RogueItemDef*) malloc(sizeof(RogueItemDef) * (size_t) (v.n_items + 1));
+    RogueLootTableDef* tables =
+        (RogueLootTableDef*) malloc(sizeof(RogueLootTableDef) * (size_t) (v.n_tables + 1));
+    int rc = -1;
+    if (affixes && items && tables)
+    {
+        for (int i = 0; i < v.n_affix; i++)
+            to_affix(pack, &v.affixes[i], &affixes[i]);
+        for (int i = 0; i < v.n_items; i++)
+            to_item(pack, &v.items[i], &items[i]);
+        for (int i = 0; i < v.n_tables; i++)
+            to_table(&v, pack, &v.tables[i], &tables[i]);
+        /* affixes first: item commit only falls back to affixes.cfg when none are loaded */
+        rogue_affixes_reset();
+        rogue_affixes_commit(affixes, v.n_affix);
+        rogue_item_defs_reset();
+        rogue_item_defs_commit(items, v.n_items);
+        rogue_loot_tables_reset();
+        rogue_loot_tables_commit(tables, v.n_tables);
+        rc = rogue_item_defs_count();
+    }
+    free(affixes);
+    free(items);
+    free(tables);
+    return rc;
+}
+
+int rogue_loot_pack_load_file(const char* path)
+{
+    RoguePack pack;
+    int rc = rogue_pack_open(&pack, path);
+    if (rc != 0)
+        return rc;
+    rc = rogue_loot_pack_load(&pack);
+    rogue_pack_close(&pack);
+    return rc;
+}
+
+int rogue_loot_pack_verify(const RoguePack* pack)
+{
+    PackView v;
+    if (view_pack(pack, &v) != 0)
+        return ROGUE_PACK_ERR_FORMAT;
+    int bad = 0;
+    if (v.n_affix != rogue_affix_count() || v.n_items != rogue_item_defs_count() ||
+        v.n_tables != rogue_loot_tables_count())
+        bad++;
+    for (int i = 0; i < v.n_affix && i < rogue_affix_count(); i++)
+    {
+        RogueAffixDef a;
+        to_affix(pack, &v.affixes[i], &a);
+        const RogueAffixDef* live = rogue_affix_at(i);
+        if (strcmp(a.id, live->id) != 0 || a.type != live->type || a.stat != live->stat ||
+            a.min_value != live->min_value || a.max_value != live->max_value ||
+            memcmp(a.weight_per_rarity, live->weight_per_rarity, sizeof a.weight_per_rarity) != 0)
+            bad++;
+    }
+    for (int i = 0; i < v.n_items && i < rogue_item_defs_count(); i++)
+    {
+        RogueItemDef d;
+        to_item(pack, &v.items[i], &d);
+        const RogueItemDef* live = rogue_item_def_at(i);
+        int same = strcmp(d.id, live->id) == 0 && strcmp(d.name, live->name) == 0 &&
+                   strcmp(d.sprite_sheet, live->sprite_sheet) == 0;
+#define CMP_FIELD(f) same = same && d.f == live->f;
+        ROGUE_LOOT_PACK_ITEM_INTS(CMP_FIELD)
+#undef CMP_FIELD
+        if (!same)
+            bad++;
+    }
+    for (int i = 0; i < v.n_tables && i < rogue_loot_tables_count(); i++)
+    {
+        RogueLootTableDef t;
+        to_table(&v, pack, &v.tables[i], &t);
+        const RogueLootTableDef* live = rogue_loot_table_at(i);
+        int same = strcmp(t.id, live->id) == 0 && t.rolls_min == live->rolls_min &&
+                   t.rolls_max == live->rolls_max && t.entry_count == live->entry_count;
+        for (int k = 0; same && k < t.entry_count; k++)
+            same = memcmp(&t.entries[k], &live->entries[k], sizeof t.entries[k]) == 0;
+        if (!same)
+            bad++;
+    }
+    return bad;
+}
@@ -0,0 +1,97 @@
+/* Baked loot content: item defs, affixes and loot tables as content pack sections
+ * (util/content_pack.h), so startup can map one file instead of parsing the cfg text.
+ *
+ * Records are fixed-width integers plus string pool offsets and are used in place through the
+ * section views below. Loot table entries reference items by their index in the pack's item
+ * section, which rogue_loot_pack_load keeps equal to the registry index. Text loading stays the
+ * source of truth for hot reload and modding; the offline bake (tools/content_bake.c) reads the
+ * text, writes the pack and verifies it against the registries it came from. */
+#ifndef ROGUE_LOOT_PACK_H
+#define ROGUE_LOOT_PACK_H
+
+#include "../../util/content_pack.h"
+
+#define ROGUE_LOOT_PACK_ITEMS ROGUE_PACK_FOURCC('I', 'T', 'E', 'M')
+#define ROGUE_LOOT_PACK_AFFIXES ROGUE_PACK_FOURCC('A', 'F', 'F', 'X')
+#define ROGUE_LOOT_PACK_TABLES ROGUE_PACK_FOURCC('L', 'T', 'B', 'L')
+#define ROGUE_LOOT_PACK_ENTRIES ROGUE_PACK_FOURCC('L', 'E', 'N', 'T')
+
+/* Integer fields of RogueItemDef in record order (category stored as its enum value). */
+#define ROGUE_LOOT_PACK_ITEM_INTS(X)                                                               \
+    X(category)                                                                                    \
+    X(level_req)                                                                                   \
+    X(stack_max)                                                                                   \
+    X(base_value)                                                                                  \
+    X(base_damage_min)                                                                             \
+    X(base_damage_max)                                                                             \
+    X(base_armor)                                                                                  \
+    X(sprite_tx)                                                                                   \
+    X(sprite_ty)                                                                                   \
+    X(sprite_tw)                                                                                   \
+    X(sprite_th)                                                                                   \
+    X(rarity)                                                                                      \
+    X(flags)                                                                                       \
+    X(implicit_strength)                                                                           \
+    X(implicit_dexterity)                                                                          \
+    X(implicit_vitality)                                                                           \
+    X(implicit_intelligence)                                                                       \
+    X(implicit_armor_flat)                                                                         \
+    X(implicit_resist_physical)                                                                    \
+    X(implicit_resist_fire)                                                                        \
+    X(implicit_resist_cold)                                                                        \
+    X(implicit_resist_lightning)                                                                   \
+    X(implicit_resist_poison)                                                                      \
+    X(implicit_resist_status)                                                                      \
+    X(set_id)                                                                                      \
+    X(socket_min)                                                                                  \
+    X(socket_max)
+
+typedef struct RogueLootPackItem
+{
+    uint32_t id, name, sprite_sheet; /* string pool offsets */
+#define ROGUE_LOOT_PACK_FIELD(f) int32_t f;
+    ROGUE_LOOT_PACK_ITEM_INTS(ROGUE_LOOT_PACK_FIELD)
+#undef ROGUE_LOOT_PACK_FIELD
+} RogueLootPackItem;
+
+typedef struct RogueLootPackAffix
+{
+    uint32_t id;
+    int32_t type, stat, min_value, max_value;
+    int32_t weight_per_rarity[5];
+} RogueLootPackAffix;
+
+typedef struct RogueLootPackTable
+{
+    uint32_t id;
+    int32_t rolls_min, rolls_max;
+    int32_t first_entry, entry_count; /* range in the entry section */
+} RogueLootPackTable;
+
+typedef struct RogueLootPackEntry
+{
+    int32_t item_index; /* pack item index, -1 unresolved */
+    int32_t weight, qmin, qmax, rarity_min, rarity_max;
+} RogueLootPackEntry;
+
+/* Bake the current item / affix / loot table registries. Returns 0 or a negative error. */
+int rogue_loot_pack_bake(RoguePackWriter* w);
+int rogue_loot_pack_bake_file(const char* path);
+
+/* In-place views (NULL with *count 0 when the section is missing or its layout differs). */
+const RogueLootPackItem* rogue_loot_pack_items(const RoguePack* pack, int* count);
+const RogueLootPackAffix* rogue_loot_pack_affixes(const RoguePack* pack, int* count);
+const RogueLootPackTable* rogue_loot_pack_tables(const RoguePack* pack, int* count);
+const RogueLootPackEntry* rogue_loot_pack_entries(const RoguePack* pack, int* count);
+
+/* Replace the affix, item def and loot table registries with the pack contents. Returns the
+ * number of item defs loaded or ROGUE_PACK_ERR_FORMAT when a section is missing / malformed. */
+int rogue_loot_pack_load(const RoguePack* pack);
+/* rogue_pack_open + load + close. Returns item count or a ROGUE_PACK_ERR_* code. */
+int rogue_loot_pack_load_file(const char* path);
+
+/* Compare the live registries with the pack record by record. Returns the number of mismatching
+ * records (0 = identical) or ROGUE_PACK_ERR_FORMAT. */
+int rogue_loot_pack_verify(const RoguePack* pack);
+
+#endif
@@ -1,13 +1,9 @@
 #include "loot_perf.h"
+#include "../../util/profiler.h"
 #include <string.h>
-#include <time.h>
 #ifdef _MSC_VER
 #include <intrin.h>
 #endif
-#if defined(_WIN32)
-#define WIN32_LEAN_AND_MEAN
-#include <windows.h> /* LARGE_INTEGER, QueryPerformanceCounter */
-#endif
 #if defined(__SSE2__) || defined(_M_X64) || defined(_M_IX86_FP)
 #include <emmintrin.h>
 #endif
@@ -33,36 +29,6 @@ static struct
     unsigned long long affix_roll_t0;
 } g_perf;
 
-/* Cross-platform monotonic time (nanoseconds). Uses clock_gettime if available, else clock()
- * fallback (low resolution). */
-static unsigned long long rogue_time_now_ns(void)
-{
-#if defined(_WIN32) && (defined(_MSC_VER))
-    static int inited = 0;
-    static double freq_inv = 0.0;
-    static LARGE_INTEGER f;
-    LARGE_INTEGER c;
-    if (!inited)
-    {
-        QueryPerformanceFrequency(&f);
-        freq_inv = 1000000000.0 / (double) f.QuadPart;
-        inited = 1;
-    }
-    QueryPerformanceCounter(&c);
-    return (unsigned long long) ((double) c.QuadPart * freq_inv);
-#elif defined(CLOCK_MONOTONIC_RAW)
-    struct timespec ts;
-    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
-    return (unsigned long long) ts.tv_sec * 1000000000ull + (unsigned long long) ts.tv_nsec;
-#elif defined(CLOCK_MONOTONIC)
-    struct timespec ts;
-    clock_gettime(CLOCK_MONOTONIC, &ts);
-    return (unsigned long long) ts.tv_sec * 1000000000ull + (unsigned long long) ts.tv_nsec;
-#else
-    return (unsigned long long) clock() * (1000000000ull / (unsigned long long) CLOCKS_PER_SEC);
-#endif
-}
-
 void* rogue_loot_weight_scratch_acquire(void)
 {
     for (int i = 0; i < ROGUE_LOOT_WEIGHT_SCRATCH_CAP; i++)
@@ -92,21 +58,21 @@ void rogue_loot_weight_scratch_release(void* p)
 
 static int sum_weights_scalar(const int* w, int n)
 {
-    unsigned long long t0 = rogue_time_now_ns();
+    unsigned long long t0 = rogue_prof_now_ns();
     int total = 0;
     for (int i = 0; i < n; i++)
     {
         total += w[i];
     }
     g_perf.m.affix_roll_scalar_sums++;
-    g_perf.m.weight_sum_time_ns += (rogue_time_now_ns() - t0);
+    g_perf.m.weight_sum_time_ns += (rogue_prof_now_ns() - t0);
     return total;
 }
 
 static int sum_weights_simd(const int* w, int n)
 {
 #if defined(__SSE2__) || defined(_M_X64) || defined(_M_IX86_FP)
-    unsigned long long t0 = rogue_time_now_ns();
+    unsigned long long t0 = rogue_prof_now_ns();
     int i = 0;
     __m128i acc = _mm_setzero_si128();
     for (; i + 4 <= n; i += 4)
@@ -120,7 +86,7 @@ static int sum_weights_simd(const int* w, int n)
     for (; i < n; i++)
         total += w[i];
     g_perf.m.affix_roll_simd_sums++;
-    g_perf.m.weight_sum_time_ns += (rogue_time_now_ns() - t0);
+    g_perf.m.weight_sum_time_ns += (rogue_prof_now_ns() - t0);
     return total;
 #else
     return sum_weights_scalar(w, n);
@@ -151,13 +117,15 @@ void rogue_loot_perf_get(RogueLootPerfMetrics* out)
     }
 }
 
-void rogue_loot_perf_affix_roll_begin(void) { g_perf.affix_roll_t0 = rogue_time_now_ns(); }
+void rogue_loot_perf_affix_roll_begin(void) { g_perf.affix_roll_t0 = rogue_prof_now_ns(); }
 void rogue_loot_perf_affix_roll_end(void)
 {
     if (g_perf.affix_roll_t0)
     {
-        unsigned long long dt = rogue_time_now_ns() - g_perf.affix_roll_t0;
+        static RogueProfZoneSlot slot;
+        unsigned long long dt = rogue_prof_now_ns() - g_perf.affix_roll_t0;
         g_perf.m.affix_roll_time_ns += dt;
+        rogue_prof_complete(rogue_prof_zone_slot(&slot, "loot_affix_roll"), dt);
         g_perf.affix_roll_t0 = 0;
     }
 }
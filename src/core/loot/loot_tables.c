@@ -37,6 +37,12 @@ int rogue_loot_tables_reset(void)
     return 0;
 }
 int rogue_loot_tables_count(void) { return g_table_count; }
+const RogueLootTableDef* rogue_loot_table_at(int index)
+{
+    if (index < 0 || index >= g_table_count)
+        return NULL;
+    return &g_tables[index];
+}
 
 static char* lt_next_field(char** cur)
 {
@@ -59,7 +65,9 @@ static char* lt_next_field(char** cur)
     *cur = (*p) ? p : NULL;
     return s;
 }
-static int parse_line(char* line)
+/* Parse one cfg line into *t_out (registry untouched). Returns -1 malformed, 0 skipped, 1 counted;
+ * only tables with entries are kept. */
+static int parse_line(char* line, RogueLootTableDef* t_out)
 {
     for (char* p = line; *p; ++p)
     {
@@ -125,12 +133,8 @@ static int parse_line(char* line)
         }
         if (e->item_def_index >= 0 && e->weight > 0)
             t.entry_count = 1;
-        if (t.entry_count > 0 && g_table_count < ROGUE_MAX_LOOT_TABLES)
-        {
-            g_tables[g_table_count++] = t;
-            return 1;
-        }
-        return 0;
+        *t_out = t;
+        return t.entry_count > 0 ? 1 : 0;
     }
 
     /* Newer format: id,rolls_min,rolls_max, then ';' separated segments of item entries */
@@ -207,17 +211,18 @@ static int parse_line(char* line)
         else
             seg_cursor = semi + 1;
     }
-    if (g_table_count < ROGUE_MAX_LOOT_TABLES && t.entry_count > 0)
-    {
-        g_tables[g_table_count++] = t;
-    }
+    *t_out = t;
     return 1;
 }
 
-int rogue_loot_tables_load_from_cfg(const char* path)
+int rogue_loot_tables_parse_cfg(const char* path, RogueLootTableDef** out_tables, int* out_count)
 {
+    if (!out_tables || !out_count)
+        return -1;
+    *out_tables = NULL;
+    *out_count = 0;
     FILE* f = NULL;
-    int added = 0;
+    int counted = 0;
 #if defined(_MSC_VER)
     fopen_s(&f, path, "rb");
 #else
@@ -225,6 +230,8 @@ int rogue_loot_tables_load_from_cfg(const char* path)
 #endif
     if (!f)
         return -1;
+    RogueLootTableDef* tables = NULL;
+    int count = 0, cap = 0;
     char line[1024];
     while (fgets(line, sizeof line, f))
     {
@@ -235,14 +242,53 @@ int rogue_loot_tables_load_from_cfg(const char* path)
         strncpy(work, line, sizeof work - 1);
         work[sizeof work - 1] = '\0';
 #endif
-        int r = parse_line(work);
-        if (r > 0)
-            added++;
+        RogueLootTableDef t;
+        int r = parse_line(work, &t);
+        if (r <= 0)
+            continue;
+        counted++;
+        if (t.entry_count <= 0)
+            continue;
+        if (count == cap)
+        {
+            int ncap = cap ? cap * 2 : 8;
+            RogueLootTableDef* grown =
+                (RogueLootTableDef*) realloc(tables, sizeof(RogueLootTableDef) * (size_t) ncap);
+            if (!grown)
+                break;
+            tables = grown;
+            cap = ncap;
+        }
+        tables[count++] = t;
     }
     fclose(f);
+    *out_tables = tables;
+    *out_count = count;
+    return counted;
+}
+
+int rogue_loot_tables_commit(const RogueLootTableDef* tables, int count)
+{
+    int added = 0;
+    for (int i = 0; i < count && g_table_count < ROGUE_MAX_LOOT_TABLES; i++)
+    {
+        g_tables[g_table_count++] = tables[i];
+        added++;
+    }
     return added;
 }
 
+int rogue_loot_tables_load_from_cfg(const char* path)
+{
+    RogueLootTableDef* tables = NULL;
+    int count = 0;
+    int counted = rogue_loot_tables_parse_cfg(path, &tables, &count);
+    if (counted >= 0)
+        rogue_loot_tables_commit(tables, count);
+    free(tables);
+    return counted;
+}
+
 const RogueLootTableDef* rogue_loot_table_by_id(const char* id)
 {
     if (!id)
@@ -28,9 +28,17 @@ typedef struct RogueLootTableDef
 
 int rogue_loot_tables_reset(void);
 int rogue_loot_tables_load_from_cfg(const char* path); /* returns number added */
+/* Parse/commit split for parallel content loading. parse_cfg reads a cfg file into a malloc'd
+ * array (free() it after commit) without touching the table registry; item ids resolve against
+ * the item defs already committed, so it may run on a worker once those are loaded. Returns the
+ * number of accepted lines (what load_from_cfg reports) or -1 if the file cannot be opened.
+ * commit appends parsed tables on the owning thread and returns how many fit. */
+int rogue_loot_tables_parse_cfg(const char* path, RogueLootTableDef** out_tables, int* out_count);
+int rogue_loot_tables_commit(const RogueLootTableDef* tables, int count);
 const RogueLootTableDef* rogue_loot_table_by_id(const char* id);
 int rogue_loot_table_index(const char* id);
 int rogue_loot_tables_count(void);
+const RogueLootTableDef* rogue_loot_table_at(int index); /* NULL if out of range */
 
 /* Roll API (Phase 1): returns number of concrete drops produced into out arrays */
 int rogue_loot_roll(int table_index, unsigned int* rng_state, int max_out,
@@ -1,16 +1,39 @@
 #include "loot_vfx.h"
 #include "../app/app_state.h"
 #include "loot_instances.h"
+#include <stdlib.h>
 #include <string.h>
 
-/* Simple parallel array indexed by instance slot */
-static RogueLootVFXState g_vfx[ROGUE_ITEM_INSTANCE_CAP];
+/* Simple parallel array indexed by instance slot; grows alongside the instance pool. */
+static RogueLootVFXState* g_vfx = NULL;
+static int g_vfx_cap = 0;
 
-void rogue_loot_vfx_reset(void) { memset(g_vfx, 0, sizeof g_vfx); }
+void rogue_loot_vfx_reset(void)
+{
+    if (g_vfx)
+        memset(g_vfx, 0, sizeof(RogueLootVFXState) * (size_t) g_vfx_cap);
+}
+
+static int vfx_reserve(int inst_index)
+{
+    if (inst_index < g_vfx_cap)
+        return 1;
+    int cap = g_vfx_cap ? g_vfx_cap : ROGUE_ITEM_INSTANCE_CAP;
+    while (cap <= inst_index)
+        cap *= 2;
+    RogueLootVFXState* v =
+        (RogueLootVFXState*) realloc(g_vfx, sizeof(RogueLootVFXState) * (size_t) cap);
+    if (!v)
+        return 0;
+    memset(v + g_vfx_cap, 0, sizeof(RogueLootVFXState) * (size_t) (cap - g_vfx_cap));
+    g_vfx = v;
+    g_vfx_cap = cap;
+    return 1;
+}
 
 void rogue_loot_vfx_on_spawn(int inst_index, int rarity)
 {
-    if (inst_index < 0 || inst_index >= ROGUE_ITEM_INSTANCE_CAP)
+    if (inst_index < 0 || inst_index >= ROGUE_ITEM_INSTANCE_MAX || !vfx_reserve(inst_index))
         return;
     RogueLootVFXState* s = &g_vfx[inst_index];
     memset(s, 0, sizeof *s);
@@ -20,14 +43,14 @@ void rogue_loot_vfx_on_spawn(int inst_index, int rarity)
 
 void rogue_loot_vfx_on_despawn(int inst_index)
 {
-    if (inst_index < 0 || inst_index >= ROGUE_ITEM_INSTANCE_CAP)
+    if (inst_index < 0 || inst_index >= g_vfx_cap)
         return;
     memset(&g_vfx[inst_index], 0, sizeof g_vfx[inst_index]);
 }
 
 int rogue_loot_vfx_get(int inst_index, RogueLootVFXState* out)
 {
-    if (inst_index < 0 || inst_index >= ROGUE_ITEM_INSTANCE_CAP)
+    if (inst_index < 0 || inst_index >= g_vfx_cap)
         return 0;
     const RogueItemInstance* it = rogue_item_instance_at(inst_index);
     if (!it)
@@ -42,7 +65,7 @@ int rogue_loot_vfx_get(int inst_index, RogueLootVFXState* out)
 int rogue_loot_vfx_edge_notifiers(void)
 {
     int count = 0;
-    for (int i = 0; i < ROGUE_ITEM_INSTANCE_CAP; i++)
+    for (int i = 0; i < g_app.item_instance_cap; i++)
         if (g_app.item_instances && g_app.item_instances[i].active)
         {
             float dx = g_app.item_instances[i].x - g_app.player.base.pos.x;
@@ -56,7 +79,8 @@ int rogue_loot_vfx_edge_notifiers(void)
 
 void rogue_loot_vfx_update(float dt_ms)
 {
-    for (int i = 0; i < ROGUE_ITEM_INSTANCE_CAP; i++)
+    int n = g_vfx_cap < g_app.item_instance_cap ? g_vfx_cap : g_app.item_instance_cap;
+    for (int i = 0; i < n; i++)
         if (g_app.item_instances && g_app.item_instances[i].active)
         {
             RogueLootVFXState* s = &g_vfx[i];
@@ -0,0 +1,146 @@
+#include "save_internal.h"
+#include "save_paths.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(ROGUE_HAVE_SDL)
+#include <SDL.h>
+#endif
+
+/* Asynchronous autosave: the component snapshot is taken on the caller thread (frame boundary);
+ * compression, CRC32, SHA256, signing and the durable write run on a short-lived worker thread.
+ * Results are published back on the caller thread by rogue_save_async_poll / the scheduler. */
+
+typedef struct RogueSaveAsyncJob
+{
+    RogueSaveCapture cap;
+    char path[260];
+    int rc;
+    double capture_ms;
+    double worker_ms;
+} RogueSaveAsyncJob;
+
+static RogueSaveAsyncJob* g_job = NULL;
+static uint32_t g_async_completed = 0;
+#if defined(ROGUE_HAVE_SDL)
+static SDL_Thread* g_async_thread = NULL;
+static SDL_atomic_t g_async_done;
+#endif
+
+static double async_now_ms(void)
+{
+#if defined(ROGUE_HAVE_SDL)
+    return (double) SDL_GetPerformanceCounter() * 1000.0 / (double) SDL_GetPerformanceFrequency();
+#else
+    return (double) clock() * 1000.0 / (double) CLOCKS_PER_SEC;
+#endif
+}
+
+static void run_job(RogueSaveAsyncJob* job)
+{
+    double t0 = async_now_ms();
+    job->rc = rogue__save_encode(&job->cap);
+    if (job->rc == 0)
+        job->rc = rogue__save_write_image(job->path, &job->cap);
+    job->worker_ms = async_now_ms() - t0;
+}
+
+#if defined(ROGUE_HAVE_SDL)
+static int async_worker(void* ud)
+{
+    run_job((RogueSaveAsyncJob*) ud);
+    SDL_AtomicSet(&g_async_done, 1);
+    return 0;
+}
+#endif
+
+static void finish_job(void)
+{
+#if defined(ROGUE_HAVE_SDL)
+    if (g_async_thread)
+    {
+        SDL_WaitThread(g_async_thread, NULL);
+        g_async_thread = NULL;
+    }
+#endif
+    rogue__save_commit(&g_job->cap, g_job->rc, g_job->capture_ms + g_job->worker_ms);
+    rogue__save_capture_free(&g_job->cap);
+    free(g_job);
+    g_job = NULL;
+    g_async_completed++;
+}
+
+int rogue_save_set_async(int enabled)
+{
+    if (!enabled)
+        rogue__save_async_drain();
+    g_save_async_enabled = enabled ? 1 : 0;
+    return 0;
+}
+
+int rogue_save_async_pending(void) { return g_job != NULL; }
+uint32_t rogue_save_async_completed_count(void) { return g_async_completed; }
+double rogue_save_last_capture_ms(void) { return g_save_last_capture_ms; }
+
+int rogue_save_async_poll(void)
+{
+    if (!g_job)
+        return 0;
+#if defined(ROGUE_HAVE_SDL)
+    if (g_async_thread && !SDL_AtomicGet(&g_async_done))
+        return 0;
+#endif
+    finish_job();
+    return 1;
+}
+
+void rogue__save_async_drain(void)
+{
+    if (g_job)
+        finish_job(); /* SDL_WaitThread blocks until the worker is done */
+}
+
+int rogue_save_async_wait(void)
+{
+    rogue__save_async_drain();
+    return g_save_last_rc;
+}
+
+int rogue_save_manager_autosave_async(int slot_index)
+{
+    if (slot_index < 0)
+        slot_index = 0;
+    if (!g_save_async_enabled)
+        return rogue_save_manager_autosave(slot_index);
+    if (g_job)
+        return ROGUE_SAVE_ERR_BUSY;
+    RogueSaveAsyncJob* job = (RogueSaveAsyncJob*) calloc(1, sizeof *job);
+    if (!job)
+        return -2;
+    double t0 = async_now_ms();
+    int rc = rogue__save_capture(&job->cap);
+    job->capture_ms = async_now_ms() - t0;
+    g_save_last_capture_ms = job->capture_ms;
+    if (rc != 0)
+    {
+        rogue__save_commit(&job->cap, rc, job->capture_ms);
+        rogue__save_capture_free(&job->cap);
+        free(job);
+        return rc;
+    }
+    snprintf(job->path, sizeof job->path, "%s", rogue_build_autosave_path(slot_index));
+    /* Resolve hash backends (CRC tables, cpuid) here so the worker never races their lazy setup */
+    (void) rogue_crc32_backend();
+    (void) rogue_sha256_backend();
+    g_job = job;
+#if defined(ROGUE_HAVE_SDL)
+    SDL_AtomicSet(&g_async_done, 0);
+    g_async_thread = SDL_CreateThread(async_worker, "rogue_autosave", job);
+    if (g_async_thread)
+        return 0;
+#endif
+    /* No thread support (or creation failed): finish inline, result still goes through poll */
+    run_job(job);
+    return 0;
+}
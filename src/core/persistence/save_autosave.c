@@ -23,9 +23,13 @@ int rogue_save_status_string(char* buf, size_t cap)
 {
     if (!buf || cap == 0)
         return -1;
-    int n = snprintf(buf, cap, "save rc=%d bytes=%u ms=%.2f autosaves=%u interval=%d throttle=%d",
+    int n = snprintf(buf, cap,
+                     "save rc=%d bytes=%u ms=%.2f autosaves=%u interval=%d throttle=%d "
+                     "async=%d pending=%d capture_ms=%.2f",
                      g_save_last_rc, g_save_last_bytes, g_save_last_ms, g_save_autosave_count,
-                     g_save_autosave_interval_ms, g_save_autosave_throttle_ms);
+                     g_save_autosave_interval_ms, g_save_autosave_throttle_ms,
+                     g_save_async_enabled, rogue_save_async_pending(),
+                     g_save_last_capture_ms);
     return (n < 0 || (size_t) n >= cap) ? -1 : 0;
 }
 
@@ -35,6 +39,7 @@ int rogue_save_manager_autosave(int slot_index);
 int rogue_save_manager_update(uint32_t now_ms, int in_combat)
 {
     static uint32_t g_last_any_save_time = 0;
+    rogue_save_async_poll(); /* publish a finished background autosave at the frame boundary */
     if (g_save_autosave_interval_ms <= 0)
         return 0;
     if (in_combat)
@@ -49,7 +54,9 @@ int rogue_save_manager_update(uint32_t now_ms, int in_combat)
         {
             return 0;
         }
-        int rc = rogue_save_manager_autosave(g_save_autosave_count);
+        int rc = rogue_save_manager_autosave_async(g_save_autosave_count);
+        if (rc == ROGUE_SAVE_ERR_BUSY)
+            return 0; /* previous autosave still writing; retry next update */
         if (rc == 0)
             g_save_autosave_count++;
         g_last_autosave_time = now_ms;
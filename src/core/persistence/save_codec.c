@@ -0,0 +1,647 @@
+#include "save_codec.h"
+#include "save_manager.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* ---- LZ (LZ4 block layout) ---------------------------------------------------------------- */
+
+#define LZ_MINMATCH 4
+#define LZ_LASTLITERALS 5 /* final bytes always emitted as literals */
+#define LZ_MFLIMIT 12     /* no match may start within the last 12 bytes */
+#define LZ_HASH_LOG 16
+#define LZ_HASH_SIZE (1u << LZ_HASH_LOG)
+#define LZ_CHAIN_SIZE 65536u
+#define LZ_SANITY_MAX (16u * 1024u * 1024u) /* matches the historical 16MB section cap */
+
+static uint32_t lz_read32(const unsigned char* p)
+{
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+static uint32_t lz_hash(uint32_t v) { return (v * 2654435761u) >> (32 - LZ_HASH_LOG); }
+
+/* Number of equal bytes at a and b, with a bounded by limit. */
+static size_t lz_count(const unsigned char* a, const unsigned char* b, const unsigned char* limit)
+{
+    const unsigned char* start = a;
+    while (a + 8 <= limit)
+    {
+        uint64_t x, y;
+        memcpy(&x, a, 8);
+        memcpy(&y, b, 8);
+        uint64_t diff = x ^ y;
+        if (diff)
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return (size_t) (a - start) + (size_t) (__builtin_ctzll(diff) >> 3);
+#else
+            while (*a == *b)
+            {
+                a++;
+                b++;
+            }
+            return (size_t) (a - start);
+#endif
+        }
+        a += 8;
+        b += 8;
+    }
+    while (a < limit && *a == *b)
+    {
+        a++;
+        b++;
+    }
+    return (size_t) (a - start);
+}
+
+size_t rogue_save_lz_bound(size_t n) { return n + n / 255 + 16; }
+
+/* Append one sequence (literals + optional match). Returns NULL if it does not fit. */
+static unsigned char* lz_emit(unsigned char* op, unsigned char* oend, const unsigned char* lit,
+                              size_t lit_len, size_t offset, size_t match_len)
+{
+    size_t need = 1 + lit_len + lit_len / 255 + 1 + (match_len ? 2 + match_len / 255 + 1 : 0);
+    if ((size_t) (oend - op) < need)
+        return NULL;
+    unsigned char* token = op++;
+    size_t ml = match_len ? match_len - LZ_MINMATCH : 0;
+    *token = (unsigned char) (((lit_len >= 15 ? 15 : lit_len) << 4) | (ml >= 15 ? 15 : ml));
+    if (lit_len >= 15)
+    {
+        size_t r = lit_len - 15;
+        for (; r >= 255; r -= 255)
+            *op++ = 255;
+        *op++ = (unsigned char) r;
+    }
+    memcpy(op, lit, lit_len);
+    op += lit_len;
+    if (match_len)
+    {
+        *op++ = (unsigned char) (offset & 0xFF);
+        *op++ = (unsigned char) (offset >> 8);
+        if (ml >= 15)
+        {
+            size_t r = ml - 15;
+            for (; r >= 255; r -= 255)
+                *op++ = 255;
+            *op++ = (unsigned char) r;
+        }
+    }
+    return op;
+}
+
+typedef struct LzMatcher
+{
+    const unsigned char* base;
+    const unsigned char* match_limit;
+    int32_t* head;
+    uint16_t* chain; /* distance to previous position with the same hash (levels >= 2) */
+    uint32_t next_insert;
+    unsigned depth;
+} LzMatcher;
+
+static void lz_insert_upto(LzMatcher* m, uint32_t target)
+{
+    while (m->next_insert < target)
+    {
+        uint32_t pos = m->next_insert++;
+        uint32_t h = lz_hash(lz_read32(m->base + pos));
+        int32_t prev = m->head[h];
+        uint32_t delta = (prev >= 0) ? pos - (uint32_t) prev : 0u;
+        m->chain[pos & (LZ_CHAIN_SIZE - 1)] =
+            (uint16_t) (delta <= ROGUE_SAVE_LZ_MAX_OFFSET ? delta : 0u);
+        m->head[h] = (int32_t) pos;
+    }
+}
+
+/* Longest match for ip; returns its length (0 if < LZ_MINMATCH) and stores the offset. */
+static size_t lz_find(LzMatcher* m, const unsigned char* ip, size_t* offset)
+{
+    uint32_t pos = (uint32_t) (ip - m->base);
+    uint32_t seq = lz_read32(ip);
+    size_t best = 0;
+    if (!m->chain)
+    { /* level 1: single probe, table only remembers the most recent position */
+        uint32_t h = lz_hash(seq);
+        int32_t cand = m->head[h];
+        m->head[h] = (int32_t) pos;
+        if (cand >= 0 && pos - (uint32_t) cand <= ROGUE_SAVE_LZ_MAX_OFFSET &&
+            lz_read32(m->base + cand) == seq)
+        {
+            best = LZ_MINMATCH + lz_count(ip + LZ_MINMATCH, m->base + cand + LZ_MINMATCH,
+                                          m->match_limit);
+            *offset = pos - (uint32_t) cand;
+        }
+        return best;
+    }
+    lz_insert_upto(m, pos);
+    int32_t cand = m->head[lz_hash(seq)];
+    for (unsigned d = 0; cand >= 0 && d < m->depth; d++)
+    {
+        uint32_t dist = pos - (uint32_t) cand;
+        if (dist > ROGUE_SAVE_LZ_MAX_OFFSET)
+            break;
+        const unsigned char* cp = m->base + cand;
+        if (cp[best] == ip[best] && lz_read32(cp) == seq)
+        {
+            size_t len = LZ_MINMATCH + lz_count(ip + LZ_MINMATCH, cp + LZ_MINMATCH, m->match_limit);
+            if (len > best)
+            {
+                best = len;
+                *offset = dist;
+                if (ip + len >= m->match_limit)
+                    break;
+            }
+        }
+        uint16_t delta = m->chain[(uint32_t) cand & (LZ_CHAIN_SIZE - 1)];
+        if (!delta)
+            break;
+        cand -= delta;
+    }
+    lz_insert_upto(m, pos + 1);
+    return best >= LZ_MINMATCH ? best : 0;
+}
+
+size_t rogue_save_lz_compress(const unsigned char* src, size_t n, unsigned char* dst, size_t cap,
+                              int level)
+{
+    if (level < ROGUE_SAVE_LZ_LEVEL_MIN)
+        level = ROGUE_SAVE_LZ_LEVEL_MIN;
+    if (level > ROGUE_SAVE_LZ_LEVEL_MAX)
+        level = ROGUE_SAVE_LZ_LEVEL_MAX;
+    if (n > 0x7FFFFFFFu)
+        return 0;
+    unsigned char* op = dst;
+    unsigned char* oend = dst + cap;
+    const unsigned char* anchor = src;
+    if (n > LZ_MFLIMIT)
+    {
+        LzMatcher m;
+        memset(&m, 0, sizeof m);
+        m.base = src;
+        m.match_limit = src + n - LZ_LASTLITERALS;
+        m.head = (int32_t*) malloc(LZ_HASH_SIZE * sizeof(int32_t));
+        if (level > 1)
+            m.chain = (uint16_t*) malloc(LZ_CHAIN_SIZE * sizeof(uint16_t));
+        if (!m.head || (level > 1 && !m.chain))
+        {
+            free(m.head);
+            free(m.chain);
+            return 0;
+        }
+        memset(m.head, 0xFF, LZ_HASH_SIZE * sizeof(int32_t));
+        m.depth = level > 1 ? (1u << (level - 1)) : 1u;
+        if (m.depth > 256u)
+            m.depth = 256u;
+        int lazy = level >= 4;
+        const unsigned char* ip = src;
+        const unsigned char* mflimit = src + n - LZ_MFLIMIT;
+        unsigned misses = 0;
+        while (ip < mflimit)
+        {
+            size_t off = 0;
+            size_t len = lz_find(&m, ip, &off);
+            if (!len)
+            {
+                /* level 1 accelerates through incompressible stretches like LZ4 does */
+                ip += (level == 1) ? 1u + (misses++ >> 6) : 1u;
+                continue;
+            }
+            if (lazy && ip + 1 < mflimit)
+            {
+                size_t off2 = 0;
+                size_t len2 = lz_find(&m, ip + 1, &off2);
+                if (len2 > len + 1)
+                {
+                    ip++;
+                    len = len2;
+                    off = off2;
+                }
+            }
+            op = lz_emit(op, oend, anchor, (size_t) (ip - anchor), off, len);
+            if (!op)
+                break;
+            ip += len;
+            anchor = ip;
+            misses = 0;
+            if (!m.chain && ip - 2 > src && ip < mflimit)
+                m.head[lz_hash(lz_read32(ip - 2))] = (int32_t) (ip - 2 - src);
+        }
+        free(m.head);
+        free(m.chain);
+        if (!op)
+            return 0;
+    }
+    op = lz_emit(op, oend, anchor, (size_t) (src + n - anchor), 0, 0);
+    return op ? (size_t) (op - dst) : 0;
+}
+
+long rogue_save_lz_decompress(const unsigned char* src, size_t n, unsigned char* dst, size_t cap)
+{
+    const unsigned char* ip = src;
+    const unsigned char* iend = src + n;
+    unsigned char* op = dst;
+    unsigned char* oend = dst + cap;
+    if (n == 0)
+        return -1;
+    for (;;)
+    {
+        unsigned token = *ip++;
+        size_t lit = token >> 4;
+        if (lit == 15)
+        {
+            unsigned b;
+            do
+            {
+                if (ip >= iend)
+                    return -1;
+                b = *ip++;
+                lit += b;
+            } while (b == 255);
+        }
+        if (lit > (size_t) (iend - ip) || lit > (size_t) (oend - op))
+            return -1;
+        memcpy(op, ip, lit);
+        ip += lit;
+        op += lit;
+        if (ip == iend)
+            break; /* last sequence carries literals only */
+        if (iend - ip < 2)
+            return -1;
+        size_t off = (size_t) ip[0] | ((size_t) ip[1] << 8);
+        ip += 2;
+        if (off == 0 || off > (size_t) (op - dst))
+            return -1;
+        size_t ml = token & 15;
+        if (ml == 15)
+        {
+            unsigned b;
+            do
+            {
+                if (ip >= iend)
+                    return -1;
+                b = *ip++;
+                ml += b;
+            } while (b == 255);
+        }
+        ml += LZ_MINMATCH;
+        if (ml > (size_t) (oend - op))
+            return -1;
+        const unsigned char* mp = op - off;
+        if (off >= ml)
+        {
+            memcpy(op, mp, ml);
+            op += ml;
+        }
+        else
+        {
+            for (size_t i = 0; i < ml; i++)
+                *op++ = *mp++; /* overlapping copy replicates the period */
+        }
+        if (ip >= iend)
+            return -1; /* a match must be followed by a final literal sequence */
+    }
+    return (long) (op - dst);
+}
+
+/* ---- Legacy RLE (v6) ----------------------------------------------------------------------- */
+
+size_t rogue_save_rle_compress(const unsigned char* src, size_t n, unsigned char* dst, size_t cap)
+{
+    size_t ci = 0;
+    for (size_t p = 0; p < n;)
+    {
+        unsigned char b = src[p];
+        size_t run = 1;
+        while (p + run < n && src[p + run] == b && run < 255)
+            run++;
+        if (ci + 2 > cap)
+            return 0;
+        dst[ci++] = b;
+        dst[ci++] = (unsigned char) run;
+        p += run;
+    }
+    return ci;
+}
+
+size_t rogue_save_rle_decompress(const unsigned char* src, size_t n, unsigned char* dst, size_t cap)
+{
+    size_t ci = 0;
+    size_t ui = 0;
+    while (ci + 1 < n && ui < cap)
+    {
+        unsigned char b = src[ci++];
+        unsigned char run = src[ci++];
+        for (int r = 0; r < run && ui < cap; r++)
+            dst[ui++] = b;
+    }
+    return ui;
+}
+
+/* ---- Streaming decoder --------------------------------------------------------------------- */
+
+enum
+{
+    DS_TOKEN = 0,
+    DS_LITLEN_EXT,
+    DS_LITERALS,
+    DS_OFF_LO,
+    DS_OFF_HI,
+    DS_MLEN_EXT,
+    DS_RLE_BYTE,
+    DS_RLE_RUN
+};
+
+#define DS_MASK (ROGUE_SAVE_DECODE_RING - 1u)
+
+static int ds_flush(RogueSaveDecodeStream* s)
+{
+    while (s->flushed < s->out_total)
+    {
+        size_t idx = (size_t) (s->flushed & DS_MASK);
+        size_t n = (size_t) (s->out_total - s->flushed);
+        if (n > ROGUE_SAVE_DECODE_RING - idx)
+            n = ROGUE_SAVE_DECODE_RING - idx;
+        if (s->sink && s->sink(s->window + idx, n, s->user) != 0)
+            return -1;
+        s->flushed += n;
+    }
+    return 0;
+}
+
+/* Account for n freshly written ring bytes; flush whenever the ring wraps so unflushed output
+ * never exceeds the ring. */
+static int ds_advance(RogueSaveDecodeStream* s, size_t n)
+{
+    s->out_total += n;
+    if ((s->out_total & DS_MASK) == 0)
+        return ds_flush(s);
+    return 0;
+}
+
+static int ds_room(RogueSaveDecodeStream* s, uint64_t n)
+{
+    return !s->out_limit || s->out_total + n <= s->out_limit;
+}
+
+static int ds_put(RogueSaveDecodeStream* s, const unsigned char* p, size_t n)
+{
+    if (!ds_room(s, n))
+        return -1;
+    while (n)
+    {
+        size_t idx = (size_t) (s->out_total & DS_MASK);
+        size_t chunk = ROGUE_SAVE_DECODE_RING - idx;
+        if (chunk > n)
+            chunk = n;
+        memcpy(s->window + idx, p, chunk);
+        p += chunk;
+        n -= chunk;
+        if (ds_advance(s, chunk) != 0)
+            return -1;
+    }
+    return 0;
+}
+
+static int ds_fill(RogueSaveDecodeStream* s, unsigned char b, size_t n)
+{
+    if (!ds_room(s, n))
+        return -1;
+    while (n)
+    {
+        size_t idx = (size_t) (s->out_total & DS_MASK);
+        size_t chunk = ROGUE_SAVE_DECODE_RING - idx;
+        if (chunk > n)
+            chunk = n;
+        memset(s->window + idx, b, chunk);
+        n -= chunk;
+        if (ds_advance(s, chunk) != 0)
+            return -1;
+    }
+    return 0;
+}
+
+static int ds_match(RogueSaveDecodeStream* s, uint32_t off, uint32_t ml)
+{
+    if (off == 0 || off > s->out_total || !ds_room(s, ml))
+        return -1;
+    uint64_t start = s->out_total - off;
+    uint32_t eff = off; /* any multiple of off reproduces the same bytes; grow it for short
+                           periods so runs copy in large blocks */
+    while (ml)
+    {
+        size_t didx = (size_t) (s->out_total & DS_MASK);
+        size_t sidx = (size_t) ((s->out_total - eff) & DS_MASK);
+        size_t n = ml;
+        if (n > eff)
+            n = eff;
+        if (n > ROGUE_SAVE_DECODE_RING - didx)
+            n = ROGUE_SAVE_DECODE_RING - didx;
+        if (n > ROGUE_SAVE_DECODE_RING - sidx)
+            n = ROGUE_SAVE_DECODE_RING - sidx;
+        memcpy(s->window + didx, s->window + sidx, n);
+        ml -= (uint32_t) n;
+        if (ds_advance(s, n) != 0)
+            return -1;
+        while (eff <= ROGUE_SAVE_LZ_MAX_OFFSET / 2 && (uint64_t) eff * 2 <= s->out_total - start)
+            eff *= 2;
+    }
+    return 0;
+}
+
+int rogue_save_decode_stream_init(RogueSaveDecodeStream* s, int codec, uint64_t out_limit,
+                                  RogueSaveDecodeSinkFn sink, void* user)
+{
+    if (!s || (codec != ROGUE_SAVE_CODEC_RLE && codec != ROGUE_SAVE_CODEC_LZ))
+        return -1;
+    s->codec = codec;
+    s->state = (codec == ROGUE_SAVE_CODEC_LZ) ? DS_TOKEN : DS_RLE_BYTE;
+    s->lit_left = 0;
+    s->match_len = 0;
+    s->offset = 0;
+    s->rle_byte = 0;
+    s->error = 0;
+    s->in_total = 0;
+    s->out_total = 0;
+    s->flushed = 0;
+    s->out_limit = out_limit;
+    s->sink = sink;
+    s->user = user;
+    return 0;
+}
+
+int rogue_save_decode_stream_feed(RogueSaveDecodeStream* s, const void* data, size_t len)
+{
+    const unsigned char* p = (const unsigned char*) data;
+    const unsigned char* e = p + len;
+    if (s->error)
+        return -1;
+    s->in_total += len;
+    while (p < e && !s->error)
+    {
+        switch (s->state)
+        {
+        case DS_TOKEN:
+        {
+            unsigned token = *p++;
+            s->lit_left = token >> 4;
+            s->match_len = token & 15;
+            s->state = (s->lit_left == 15) ? DS_LITLEN_EXT
+                                           : (s->lit_left ? DS_LITERALS : DS_OFF_LO);
+            break;
+        }
+        case DS_LITLEN_EXT:
+        {
+            unsigned b = *p++;
+            s->lit_left += b;
+            if (s->lit_left > LZ_SANITY_MAX * 8u)
+                s->error = 1;
+            else if (b != 255)
+                s->state = DS_LITERALS;
+            break;
+        }
+        case DS_LITERALS:
+        {
+            size_t n = (size_t) (e - p);
+            if (n > s->lit_left)
+                n = s->lit_left;
+            if (ds_put(s, p, n) != 0)
+                s->error = 1;
+            p += n;
+            s->lit_left -= (uint32_t) n;
+            if (!s->lit_left)
+                s->state = DS_OFF_LO;
+            break;
+        }
+        case DS_OFF_LO:
+            s->offset = *p++;
+            s->state = DS_OFF_HI;
+            break;
+        case DS_OFF_HI:
+            s->offset |= (uint32_t) (*p++) << 8;
+            if (s->match_len == 15)
+                s->state = DS_MLEN_EXT;
+            else
+            {
+                if (ds_match(s, s->offset, s->match_len + LZ_MINMATCH) != 0)
+                    s->error = 1;
+                s->state = DS_TOKEN;
+            }
+            break;
+        case DS_MLEN_EXT:
+        {
+            unsigned b = *p++;
+            s->match_len += b;
+            if (s->match_len > LZ_SANITY_MAX * 8u)
+                s->error = 1;
+            else if (b != 255)
+            {
+                if (ds_match(s, s->offset, s->match_len + LZ_MINMATCH) != 0)
+                    s->error = 1;
+                s->state = DS_TOKEN;
+            }
+            break;
+        }
+        case DS_RLE_BYTE:
+            s->rle_byte = *p++;
+            s->state = DS_RLE_RUN;
+            break;
+        case DS_RLE_RUN:
+            if (ds_fill(s, s->rle_byte, *p++) != 0)
+                s->error = 1;
+            s->state = DS_RLE_BYTE;
+            break;
+        default:
+            s->error = 1;
+            break;
+        }
+    }
+    return s->error ? -1 : 0;
+}
+
+int rogue_save_decode_stream_finish(RogueSaveDecodeStream* s)
+{
+    if (s->error || ds_flush(s) != 0)
+        return -1;
+    if (s->codec == ROGUE_SAVE_CODEC_LZ)
+        return (s->in_total > 0 && s->state == DS_OFF_LO) ? 0 : -1;
+    return 0; /* RLE: a dangling byte without run length is ignored (historical behaviour) */
+}
+
+/* ---- Stored form ---------------------------------------------------------------------------- */
+
+size_t rogue_save_codec_header_bytes(uint32_t version)
+{
+    return sizeof(uint32_t) + (version >= 10 ? 1u : 0u);
+}
+
+const char* rogue_save_codec_name(int codec)
+{
+    switch (codec)
+    {
+    case ROGUE_SAVE_CODEC_RLE:
+        return "rle";
+    case ROGUE_SAVE_CODEC_LZ:
+        return "lz";
+    default:
+        return "raw";
+    }
+}
+
+int rogue_save_codec_encode(uint32_t version, int codec, int level, const unsigned char* raw,
+                            size_t n, RogueSaveBuffer* out)
+{
+    if (version < 10)
+        codec = ROGUE_SAVE_CODEC_RLE; /* pre-v10 stored forms carry no codec id */
+    else
+    {
+        unsigned char id = (unsigned char) codec;
+        if (rogue_save_buffer_append(out, &id, 1) != 0)
+            return -1;
+    }
+    size_t bound = (codec == ROGUE_SAVE_CODEC_LZ) ? rogue_save_lz_bound(n) : n * 2 + 16;
+    if (rogue_save_buffer_reserve(out, bound) != 0)
+        return -1;
+    size_t w = (codec == ROGUE_SAVE_CODEC_LZ)
+                   ? rogue_save_lz_compress(raw, n, out->data + out->len, bound, level)
+                   : rogue_save_rle_compress(raw, n, out->data + out->len, bound);
+    if (w == 0 && n != 0)
+        return -1;
+    out->len += w;
+    return 0;
+}
+
+int rogue_save_codec_decode(uint32_t version, const unsigned char* stored, size_t stored_size,
+                            RogueSaveBuffer* out, int* out_codec)
+{
+    size_t hdr = rogue_save_codec_header_bytes(version);
+    if (stored_size < hdr)
+        return -1;
+    uint32_t usz = 0;
+    memcpy(&usz, stored, 4);
+    if (usz > LZ_SANITY_MAX)
+        return -1;
+    int codec = (version >= 10) ? (int) stored[4] : ROGUE_SAVE_CODEC_RLE;
+    if (out_codec)
+        *out_codec = codec;
+    if (rogue_save_buffer_reserve(out, usz) != 0)
+        return -1;
+    const unsigned char* body = stored + hdr;
+    size_t body_len = stored_size - hdr;
+    if (codec == ROGUE_SAVE_CODEC_LZ)
+    {
+        long d = rogue_save_lz_decompress(body, body_len, out->data + out->len, usz);
+        if (d != (long) usz)
+            return -1;
+        out->len += usz;
+        return 0;
+    }
+    if (codec == ROGUE_SAVE_CODEC_RLE)
+    {
+        out->len += rogue_save_rle_decompress(body, body_len, out->data + out->len, usz);
+        return 0;
+    }
+    return -1; /* unknown codec id */
+}
@@ -0,0 +1,76 @@
+#ifndef ROGUE_SAVE_CODEC_H
+#define ROGUE_SAVE_CODEC_H
+
+#include "save_utils.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/* Section compression codecs (Phase 3.6 follow-up).
+    v6-v9 compressed sections: [uint32 uncompressed_size][RLE (byte,run) pairs]
+    v10+  compressed sections: [uint32 uncompressed_size][uint8 codec id][codec body]
+   The LZ codec uses the LZ4 block layout (token nibbles, 255-continued lengths, uint16 LE
+   offsets, 64 KiB window, last 5 bytes always literals) and is implemented in-tree. */
+
+#define ROGUE_SAVE_LZ_MAX_OFFSET 65535u
+#define ROGUE_SAVE_DECODE_RING 131072u /* 2x max offset: match copies never alias */
+#define ROGUE_SAVE_LZ_LEVEL_MIN 1
+#define ROGUE_SAVE_LZ_LEVEL_MAX 9
+
+/* Worst-case encoded size for n input bytes. */
+size_t rogue_save_lz_bound(size_t n);
+/* Encode src into dst (cap bytes). level 1 = single-probe greedy (fastest), higher levels walk
+ * longer hash chains and enable lazy matching. Returns encoded length, 0 if dst is too small. */
+size_t rogue_save_lz_compress(const unsigned char* src, size_t n, unsigned char* dst, size_t cap,
+                              int level);
+/* Bounds-checked one-shot decode. Returns decoded length or -1 on malformed input / overflow. */
+long rogue_save_lz_decompress(const unsigned char* src, size_t n, unsigned char* dst, size_t cap);
+
+/* Legacy v6 RLE codec. compress returns encoded length (0 if cap too small); decompress returns
+ * decoded length (stops early on a truncated pair, matching the historical loader). */
+size_t rogue_save_rle_compress(const unsigned char* src, size_t n, unsigned char* dst, size_t cap);
+size_t rogue_save_rle_decompress(const unsigned char* src, size_t n, unsigned char* dst,
+                                 size_t cap);
+
+/* Streaming section decoder: compressed bytes are pushed in arbitrary chunks and decoded output
+ * is handed to sink in pieces of at most ROGUE_SAVE_DECODE_RING bytes, so neither the compressed
+ * nor the uncompressed section has to be materialized. The struct carries the 128 KiB history
+ * ring; heap-allocate it. */
+typedef int (*RogueSaveDecodeSinkFn)(const unsigned char* data, size_t len, void* user);
+
+typedef struct RogueSaveDecodeStream
+{
+    int codec;
+    int state;
+    uint32_t lit_left;
+    uint32_t match_len;
+    uint32_t offset;
+    unsigned char rle_byte;
+    int error;
+    uint64_t in_total;
+    uint64_t out_total;
+    uint64_t flushed;
+    uint64_t out_limit; /* decoded bytes beyond this are rejected (0 = unlimited) */
+    RogueSaveDecodeSinkFn sink;
+    void* user;
+    unsigned char window[ROGUE_SAVE_DECODE_RING];
+} RogueSaveDecodeStream;
+
+int rogue_save_decode_stream_init(RogueSaveDecodeStream* s, int codec, uint64_t out_limit,
+                                  RogueSaveDecodeSinkFn sink, void* user);
+/* Returns 0 on success, -1 on malformed input or sink failure (sticky). */
+int rogue_save_decode_stream_feed(RogueSaveDecodeStream* s, const void* data, size_t len);
+/* Flushes remaining output. Returns 0 if the stream ended on a sequence boundary. */
+int rogue_save_decode_stream_finish(RogueSaveDecodeStream* s);
+
+/* Stored-form helpers used by the save pipeline. encode appends [codec][body] for v10 (or just the
+ * RLE body for older versions) to out; returns 0 on success. decode reads a complete stored
+ * compressed payload (including the uncompressed_size prefix) into out. */
+int rogue_save_codec_encode(uint32_t version, int codec, int level, const unsigned char* raw,
+                            size_t n, RogueSaveBuffer* out);
+int rogue_save_codec_decode(uint32_t version, const unsigned char* stored, size_t stored_size,
+                            RogueSaveBuffer* out, int* out_codec);
+/* Bytes of stored-form header that precede the codec body (uncompressed_size [+ codec id]). */
+size_t rogue_save_codec_header_bytes(uint32_t version);
+const char* rogue_save_codec_name(int codec);
+
+#endif /* ROGUE_SAVE_CODEC_H */
@@ -16,30 +16,30 @@
 #include <string.h>
 
 /* Forward-declared helpers from original implementation */
-static int write_player_component(FILE* f);
-static int read_player_component(FILE* f, size_t size);
-static int write_inventory_component(FILE* f);
-static int read_inventory_component(FILE* f, size_t size);
-static int write_skills_component(FILE* f);
-static int read_skills_component(FILE* f, size_t size);
-static int write_buffs_component(FILE* f);
-static int read_buffs_component(FILE* f, size_t size);
-static int write_vendor_component(FILE* f);
-static int read_vendor_component(FILE* f, size_t size);
-static int write_strings_component(FILE* f);
-static int read_strings_component(FILE* f, size_t size);
-static int write_world_meta_component(FILE* f);
-static int read_world_meta_component(FILE* f, size_t size);
-static int write_replay_component(FILE* f);
-static int read_replay_component(FILE* f, size_t size);
-static int write_inv_entries_component(FILE* f);
-static int read_inv_entries_component(FILE* f, size_t size);
-static int write_inv_tags_component(FILE* f);
-static int read_inv_tags_component(FILE* f, size_t size);
-static int write_inv_tag_rules_component(FILE* f);
-static int read_inv_tag_rules_component(FILE* f, size_t size);
-static int write_inv_saved_searches_component(FILE* f);
-static int read_inv_saved_searches_component(FILE* f, size_t size);
+static int write_player_component(RogueSaveBuffer* buf);
+static int read_player_component(RogueSaveReader* in, size_t size);
+static int write_inventory_component(RogueSaveBuffer* buf);
+static int read_inventory_component(RogueSaveReader* in, size_t size);
+static int write_skills_component(RogueSaveBuffer* buf);
+static int read_skills_component(RogueSaveReader* in, size_t size);
+static int write_buffs_component(RogueSaveBuffer* buf);
+static int read_buffs_component(RogueSaveReader* in, size_t size);
+static int write_vendor_component(RogueSaveBuffer* buf);
+static int read_vendor_component(RogueSaveReader* in, size_t size);
+static int write_strings_component(RogueSaveBuffer* buf);
+static int read_strings_component(RogueSaveReader* in, size_t size);
+static int write_world_meta_component(RogueSaveBuffer* buf);
+static int read_world_meta_component(RogueSaveReader* in, size_t size);
+static int write_replay_component(RogueSaveBuffer* buf);
+static int read_replay_component(RogueSaveReader* in, size_t size);
+static int write_inv_entries_component(RogueSaveBuffer* buf);
+static int read_inv_entries_component(RogueSaveReader* in, size_t size);
+static int write_inv_tags_component(RogueSaveBuffer* buf);
+static int read_inv_tags_component(RogueSaveReader* in, size_t size);
+static int write_inv_tag_rules_component(RogueSaveBuffer* buf);
+static int read_inv_tag_rules_component(RogueSaveReader* in, size_t size);
+static int write_inv_saved_searches_component(RogueSaveBuffer* buf);
+static int read_inv_saved_searches_component(RogueSaveReader* in, size_t size);
 
 /* Inventory record diff metrics (exposed via header functions) */
 void rogue_save_inventory_diff_metrics(unsigned* reused, unsigned* rewritten);
@@ -47,161 +47,171 @@ void rogue_save_inventory_diff_metrics(unsigned* reused, unsigned* rewritten);
 /* Implementations moved wholesale from original source (trimmed of unrelated static state) */
 
 /* Player */
-static int write_player_component(FILE* f)
+static int write_player_component(RogueSaveBuffer* buf)
 {
-    fwrite(&g_app.player.level, sizeof g_app.player.level, 1, f);
-    fwrite(&g_app.player.xp, sizeof g_app.player.xp, 1, f);
-    fwrite(&g_app.player.xp_to_next, sizeof g_app.player.xp_to_next, 1, f);
-    fwrite(&g_app.player.xp_total_accum, sizeof g_app.player.xp_total_accum, 1, f);
-    fwrite(&g_app.player.health, sizeof g_app.player.health, 1, f);
-    fwrite(&g_app.player.mana, sizeof g_app.player.mana, 1, f);
-    fwrite(&g_app.player.action_points, sizeof g_app.player.action_points, 1, f);
-    fwrite(&g_app.player.strength, sizeof g_app.player.strength, 1, f);
-    fwrite(&g_app.player.dexterity, sizeof g_app.player.dexterity, 1, f);
-    fwrite(&g_app.player.vitality, sizeof g_app.player.vitality, 1, f);
-    fwrite(&g_app.player.intelligence, sizeof g_app.player.intelligence, 1, f);
-    fwrite(&g_app.talent_points, sizeof g_app.talent_points, 1, f);
-    fwrite(&g_app.analytics_damage_dealt_total, sizeof g_app.analytics_damage_dealt_total, 1, f);
-    fwrite(&g_app.analytics_gold_earned_total, sizeof g_app.analytics_gold_earned_total, 1, f);
-    fwrite(&g_app.permadeath_mode, sizeof g_app.permadeath_mode, 1, f);
-    fwrite(&g_app.player.equipped_weapon_id, sizeof g_app.player.equipped_weapon_id, 1, f);
-    fwrite(&g_app.player.weapon_infusion, sizeof g_app.player.weapon_infusion, 1, f);
-    fwrite(&g_app.session_start_seconds, sizeof g_app.session_start_seconds, 1, f);
-    fwrite(&g_app.inventory_sort_mode, sizeof g_app.inventory_sort_mode, 1, f);
+    rogue_save_buffer_append(buf, &g_app.player.level, sizeof g_app.player.level);
+    rogue_save_buffer_append(buf, &g_app.player.xp, sizeof g_app.player.xp);
+    rogue_save_buffer_append(buf, &g_app.player.xp_to_next, sizeof g_app.player.xp_to_next);
+    rogue_save_buffer_append(buf, &g_app.player.xp_total_accum, sizeof g_app.player.xp_total_accum);
+    rogue_save_buffer_append(buf, &g_app.player.health, sizeof g_app.player.health);
+    rogue_save_buffer_append(buf, &g_app.player.mana, sizeof g_app.player.mana);
+    rogue_save_buffer_append(buf, &g_app.player.action_points, sizeof g_app.player.action_points);
+    rogue_save_buffer_append(buf, &g_app.player.strength, sizeof g_app.player.strength);
+    rogue_save_buffer_append(buf, &g_app.player.dexterity, sizeof g_app.player.dexterity);
+    rogue_save_buffer_append(buf, &g_app.player.vitality, sizeof g_app.player.vitality);
+    rogue_save_buffer_append(buf, &g_app.player.intelligence, sizeof g_app.player.intelligence);
+    rogue_save_buffer_append(buf, &g_app.talent_points, sizeof g_app.talent_points);
+    rogue_save_buffer_append(buf, &g_app.analytics_damage_dealt_total,
+                             sizeof g_app.analytics_damage_dealt_total);
+    rogue_save_buffer_append(buf, &g_app.analytics_gold_earned_total,
+                             sizeof g_app.analytics_gold_earned_total);
+    rogue_save_buffer_append(buf, &g_app.permadeath_mode, sizeof g_app.permadeath_mode);
+    rogue_save_buffer_append(buf, &g_app.player.equipped_weapon_id,
+                             sizeof g_app.player.equipped_weapon_id);
+    rogue_save_buffer_append(buf, &g_app.player.weapon_infusion,
+                             sizeof g_app.player.weapon_infusion);
+    rogue_save_buffer_append(buf, &g_app.session_start_seconds, sizeof g_app.session_start_seconds);
+    rogue_save_buffer_append(buf, &g_app.inventory_sort_mode, sizeof g_app.inventory_sort_mode);
     int equip_count = ROGUE_EQUIP__COUNT;
-    fwrite(&equip_count, sizeof equip_count, 1, f);
+    rogue_save_buffer_append(buf, &equip_count, sizeof equip_count);
     for (int i = 0; i < equip_count; i++)
     {
         int inst = rogue_equip_get((enum RogueEquipSlot) i);
-        fwrite(&inst, sizeof inst, 1, f);
+        rogue_save_buffer_append(buf, &inst, sizeof inst);
     }
     return 0;
 }
 
-static int read_player_component(FILE* f, size_t size)
+static int read_player_component(RogueSaveReader* in, size_t size)
 {
     if (size < sizeof(int) * 4)
         return -1;
-    long start = ftell(f);
+    size_t start = rogue_save_reader_tell(in);
     int remain = (int) size;
-    fread(&g_app.player.level, sizeof g_app.player.level, 1, f);
-    fread(&g_app.player.xp, sizeof g_app.player.xp, 1, f);
+    rogue_save_reader_read(in, &g_app.player.level, sizeof g_app.player.level);
+    rogue_save_reader_read(in, &g_app.player.xp, sizeof g_app.player.xp);
     remain -= sizeof(int) * 2;
     if (remain >= (int) sizeof(int))
     {
-        fread(&g_app.player.xp_to_next, sizeof g_app.player.xp_to_next, 1, f);
+        rogue_save_reader_read(in, &g_app.player.xp_to_next, sizeof g_app.player.xp_to_next);
         remain -= sizeof(int);
     }
     else
         g_app.player.xp_to_next = 0;
     if (remain >= (int) sizeof(unsigned long long))
     {
-        fread(&g_app.player.xp_total_accum, sizeof g_app.player.xp_total_accum, 1, f);
+        rogue_save_reader_read(in, &g_app.player.xp_total_accum,
+                               sizeof g_app.player.xp_total_accum);
         remain -= (int) sizeof(unsigned long long);
     }
     else
         g_app.player.xp_total_accum = 0ULL;
     if (remain >= (int) sizeof(int))
     {
-        fread(&g_app.player.health, sizeof g_app.player.health, 1, f);
+        rogue_save_reader_read(in, &g_app.player.health, sizeof g_app.player.health);
         remain -= sizeof(int);
     }
     else
         g_app.player.health = 0;
     if (remain >= (int) sizeof(int))
     {
-        fread(&g_app.player.mana, sizeof g_app.player.mana, 1, f);
+        rogue_save_reader_read(in, &g_app.player.mana, sizeof g_app.player.mana);
         remain -= sizeof(int);
     }
     else
         g_app.player.mana = 0;
     if (remain >= (int) sizeof(int))
     {
-        fread(&g_app.player.action_points, sizeof g_app.player.action_points, 1, f);
+        rogue_save_reader_read(in, &g_app.player.action_points, sizeof g_app.player.action_points);
         remain -= sizeof(int);
     }
     else
         g_app.player.action_points = 0;
     if (remain >= (int) sizeof(int))
     {
-        fread(&g_app.player.strength, sizeof g_app.player.strength, 1, f);
+        rogue_save_reader_read(in, &g_app.player.strength, sizeof g_app.player.strength);
         remain -= sizeof(int);
     }
     else
         g_app.player.strength = 5;
     if (remain >= (int) sizeof(int))
     {
-        fread(&g_app.player.dexterity, sizeof g_app.player.dexterity, 1, f);
+        rogue_save_reader_read(in, &g_app.player.dexterity, sizeof g_app.player.dexterity);
         remain -= sizeof(int);
     }
     else
         g_app.player.dexterity = 5;
     if (remain >= (int) sizeof(int))
     {
-        fread(&g_app.player.vitality, sizeof g_app.player.vitality, 1, f);
+        rogue_save_reader_read(in, &g_app.player.vitality, sizeof g_app.player.vitality);
         remain -= sizeof(int);
     }
     else
         g_app.player.vitality = 15;
     if (remain >= (int) sizeof(int))
     {
-        fread(&g_app.player.intelligence, sizeof g_app.player.intelligence, 1, f);
+        rogue_save_reader_read(in, &g_app.player.intelligence, sizeof g_app.player.intelligence);
         remain -= sizeof(int);
     }
     else
         g_app.player.intelligence = 5;
     if (remain >= (int) sizeof(int))
     {
-        fread(&g_app.talent_points, sizeof g_app.talent_points, 1, f);
+        rogue_save_reader_read(in, &g_app.talent_points, sizeof g_app.talent_points);
         remain -= sizeof(int);
     }
     else
         g_app.talent_points = 0;
     if (remain >= (int) sizeof(unsigned long long))
     {
-        fread(&g_app.analytics_damage_dealt_total, sizeof g_app.analytics_damage_dealt_total, 1, f);
+        rogue_save_reader_read(in, &g_app.analytics_damage_dealt_total,
+                               sizeof g_app.analytics_damage_dealt_total);
         remain -= (int) sizeof(unsigned long long);
     }
     else
         g_app.analytics_damage_dealt_total = 0ULL;
     if (remain >= (int) sizeof(unsigned long long))
     {
-        fread(&g_app.analytics_gold_earned_total, sizeof g_app.analytics_gold_earned_total, 1, f);
+        rogue_save_reader_read(in, &g_app.analytics_gold_earned_total,
+                               sizeof g_app.analytics_gold_earned_total);
         remain -= (int) sizeof(unsigned long long);
     }
     else
         g_app.analytics_gold_earned_total = 0ULL;
     if (remain >= (int) sizeof(int))
     {
-        fread(&g_app.permadeath_mode, sizeof g_app.permadeath_mode, 1, f);
+        rogue_save_reader_read(in, &g_app.permadeath_mode, sizeof g_app.permadeath_mode);
         remain -= sizeof(int);
     }
     else
         g_app.permadeath_mode = 0;
     if (remain >= (int) sizeof(int))
     {
-        fread(&g_app.player.equipped_weapon_id, sizeof g_app.player.equipped_weapon_id, 1, f);
+        rogue_save_reader_read(in, &g_app.player.equipped_weapon_id,
+                               sizeof g_app.player.equipped_weapon_id);
         remain -= sizeof(int);
     }
     else
         g_app.player.equipped_weapon_id = -1;
     if (remain >= (int) sizeof(int))
     {
-        fread(&g_app.player.weapon_infusion, sizeof g_app.player.weapon_infusion, 1, f);
+        rogue_save_reader_read(in, &g_app.player.weapon_infusion,
+                               sizeof g_app.player.weapon_infusion);
         remain -= sizeof(int);
     }
     else
         g_app.player.weapon_infusion = 0;
     if (remain >= (int) sizeof(double))
     {
-        fread(&g_app.session_start_seconds, sizeof g_app.session_start_seconds, 1, f);
+        rogue_save_reader_read(in, &g_app.session_start_seconds,
+                               sizeof g_app.session_start_seconds);
         remain -= sizeof(double);
     }
     else
         g_app.session_start_seconds = 0.0;
     if (remain >= (int) sizeof(int))
     {
-        fread(&g_app.inventory_sort_mode, sizeof g_app.inventory_sort_mode, 1, f);
+        rogue_save_reader_read(in, &g_app.inventory_sort_mode, sizeof g_app.inventory_sort_mode);
         remain -= sizeof(int);
     }
     else
@@ -209,14 +219,14 @@ static int read_player_component(FILE* f, size_t size)
     if (remain >= (int) sizeof(int))
     {
         int equip_count = 0;
-        fread(&equip_count, sizeof equip_count, 1, f);
+        rogue_save_reader_read(in, &equip_count, sizeof equip_count);
         remain -= sizeof(int);
         if (equip_count > 0 && equip_count <= ROGUE_EQUIP__COUNT)
         {
             for (int i = 0; i < equip_count && remain >= (int) sizeof(int); i++)
             {
                 int inst = -1;
-                fread(&inst, sizeof inst, 1, f);
+                rogue_save_reader_read(in, &inst, sizeof inst);
                 remain -= sizeof(int);
                 if (inst >= 0)
                     rogue_equip_try((enum RogueEquipSlot) i, inst);
@@ -264,7 +274,7 @@ static void inv_record_snapshot_update(const InvRecordSnapshot* cur, unsigned co
 int inventory_component_probe_and_prepare_reuse(void)
 {
     int count = 0;
-    for (int i = 0; i < ROGUE_ITEM_INSTANCE_CAP; i++)
+    for (int i = 0, n = rogue_items_capacity(); i < n; i++)
     {
         const RogueItemInstance* it = rogue_item_instance_at(i);
         if (it)
@@ -285,7 +295,7 @@ int inventory_component_probe_and_prepare_reuse(void)
     if (!cur)
         return 1;
     int out = 0;
-    for (int i = 0; i < ROGUE_ITEM_INSTANCE_CAP; i++)
+    for (int i = 0, n = rogue_items_capacity(); i < n; i++)
     {
         const RogueItemInstance* it = rogue_item_instance_at(i);
         if (!it)
@@ -320,10 +330,10 @@ int inventory_component_probe_and_prepare_reuse(void)
     return changed;
 }
 
-static int write_inventory_component(FILE* f)
+static int write_inventory_component(RogueSaveBuffer* buf)
 {
     int count = 0;
-    for (int i = 0; i < ROGUE_ITEM_INSTANCE_CAP; i++)
+    for (int i = 0, n = rogue_items_capacity(); i < n; i++)
     {
         const RogueItemInstance* it = rogue_item_instance_at(i);
         if (it)
@@ -331,12 +341,12 @@ static int write_inventory_component(FILE* f)
     }
     if (g_active_write_version >= 4)
     {
-        if (rogue_write_varuint(f, (uint32_t) count) != 0)
+        if (rogue_save_buffer_write_varuint(buf, (uint32_t) count) != 0)
             return -1;
     }
     else
     {
-        if (fwrite(&count, sizeof count, 1, f) != 1)
+        if (rogue_save_buffer_append(buf, &count, sizeof count) != 0)
             return -1;
     }
     if (count == 0)
@@ -351,7 +361,7 @@ static int write_inventory_component(FILE* f)
     if (!cur)
         return -1;
     int out = 0;
-    for (int i = 0; i < ROGUE_ITEM_INSTANCE_CAP; i++)
+    for (int i = 0, n = rogue_items_capacity(); i < n; i++)
     {
         const RogueItemInstance* it = rogue_item_instance_at(i);
         if (!it)
@@ -385,43 +395,43 @@ static int write_inventory_component(FILE* f)
     for (int i = 0; i < count; i++)
     {
         InvRecordSnapshot* r = &cur[i];
-        fwrite(&r->def_index, sizeof(r->def_index), 1, f);
-        fwrite(&r->quantity, sizeof(r->quantity), 1, f);
-        fwrite(&r->rarity, sizeof(r->rarity), 1, f);
-        fwrite(&r->prefix_index, sizeof(r->prefix_index), 1, f);
-        fwrite(&r->prefix_value, sizeof(r->prefix_value), 1, f);
-        fwrite(&r->suffix_index, sizeof(r->suffix_index), 1, f);
-        fwrite(&r->suffix_value, sizeof(r->suffix_value), 1, f);
-        fwrite(&r->durability_cur, sizeof(r->durability_cur), 1, f);
-        fwrite(&r->durability_max, sizeof(r->durability_max), 1, f);
-        fwrite(&r->enchant_level, sizeof(r->enchant_level), 1, f);
+        rogue_save_buffer_append(buf, &r->def_index, sizeof(r->def_index));
+        rogue_save_buffer_append(buf, &r->quantity, sizeof(r->quantity));
+        rogue_save_buffer_append(buf, &r->rarity, sizeof(r->rarity));
+        rogue_save_buffer_append(buf, &r->prefix_index, sizeof(r->prefix_index));
+        rogue_save_buffer_append(buf, &r->prefix_value, sizeof(r->prefix_value));
+        rogue_save_buffer_append(buf, &r->suffix_index, sizeof(r->suffix_index));
+        rogue_save_buffer_append(buf, &r->suffix_value, sizeof(r->suffix_value));
+        rogue_save_buffer_append(buf, &r->durability_cur, sizeof(r->durability_cur));
+        rogue_save_buffer_append(buf, &r->durability_max, sizeof(r->durability_max));
+        rogue_save_buffer_append(buf, &r->enchant_level, sizeof(r->enchant_level));
     }
     inv_record_snapshot_update(cur, (unsigned) count);
     free(cur);
     return 0;
 }
 
-static int read_inventory_component(FILE* f, size_t size)
+static int read_inventory_component(RogueSaveReader* in, size_t size)
 {
     if (!g_app.item_instances || g_app.item_instance_cap <= 0)
     {
         rogue_items_init_runtime();
     }
     int count = 0;
-    long section_start = ftell(f);
+    size_t section_start = rogue_save_reader_tell(in);
     if (g_active_read_version >= 4)
     {
         uint32_t c = 0;
-        if (rogue_read_varuint(f, &c) != 0)
+        if (rogue_save_reader_read_varuint(in, &c) != 0)
             return -1;
         count = (int) c;
     }
-    else if (fread(&count, sizeof count, 1, f) != 1)
+    else if (rogue_save_reader_read(in, &count, sizeof count) != 0)
         return -1;
     if (count < 0)
         return -1;
-    long after_count = ftell(f);
-    size_t count_bytes = (size_t) (after_count - section_start);
+    size_t after_count = rogue_save_reader_tell(in);
+    size_t count_bytes = after_count - section_start;
     if (count == 0)
         return 0;
     size_t remaining = (size_t) ((size > count_bytes) ? (size - count_bytes) : 0);
@@ -437,31 +447,31 @@ static int read_inventory_component(FILE* f, size_t size)
     for (int i = 0; i < count; i++)
     {
         int def_index = 0, quantity = 0, rarity = 0, pidx = 0, pval = 0, sidx = 0, sval = 0;
-        if (fread(&def_index, sizeof def_index, 1, f) != 1)
+        if (rogue_save_reader_read(in, &def_index, sizeof def_index) != 0)
             return -1;
-        if (fread(&quantity, sizeof quantity, 1, f) != 1)
+        if (rogue_save_reader_read(in, &quantity, sizeof quantity) != 0)
             return -1;
-        if (fread(&rarity, sizeof rarity, 1, f) != 1)
+        if (rogue_save_reader_read(in, &rarity, sizeof rarity) != 0)
             return -1;
-        if (fread(&pidx, sizeof pidx, 1, f) != 1)
+        if (rogue_save_reader_read(in, &pidx, sizeof pidx) != 0)
             return -1;
-        if (fread(&pval, sizeof pval, 1, f) != 1)
+        if (rogue_save_reader_read(in, &pval, sizeof pval) != 0)
             return -1;
-        if (fread(&sidx, sizeof sidx, 1, f) != 1)
+        if (rogue_save_reader_read(in, &sidx, sizeof sidx) != 0)
             return -1;
-        if (fread(&sval, sizeof sval, 1, f) != 1)
+        if (rogue_save_reader_read(in, &sval, sizeof sval) != 0)
             return -1;
         int durability_cur = 0, durability_max = 0, enchant_level = 0;
         if (rec_ints >= 9)
         {
-            if (fread(&durability_cur, sizeof durability_cur, 1, f) != 1)
+            if (rogue_save_reader_read(in, &durability_cur, sizeof durability_cur) != 0)
                 return -1;
-            if (fread(&durability_max, sizeof durability_max, 1, f) != 1)
+            if (rogue_save_reader_read(in, &durability_max, sizeof durability_max) != 0)
                 return -1;
         }
         if (rec_ints >= 10)
         {
-            if (fread(&enchant_level, sizeof enchant_level, 1, f) != 1)
+            if (rogue_save_reader_read(in, &enchant_level, sizeof enchant_level) != 0)
                 return -1;
         }
         int inst = rogue_items_spawn(def_index, quantity, 0.0f, 0.0f);
@@ -492,56 +502,56 @@ static int read_inventory_component(FILE* f, size_t size)
 }
 
 /* Skills */
-static int write_skills_component(FILE* f)
+static int write_skills_component(RogueSaveBuffer* buf)
 {
     if (g_active_write_version >= 4)
     {
-        if (rogue_write_varuint(f, (uint32_t) g_app.skill_count) != 0)
+        if (rogue_save_buffer_write_varuint(buf, (uint32_t) g_app.skill_count) != 0)
             return -1;
     }
     else
-        fwrite(&g_app.skill_count, sizeof g_app.skill_count, 1, f);
+        rogue_save_buffer_append(buf, &g_app.skill_count, sizeof g_app.skill_count);
     for (int i = 0; i < g_app.skill_count; i++)
     {
         const RogueSkillState* st = rogue_skill_get_state(i);
         int rank = st ? st->rank : 0;
         double cd = st ? st->cooldown_end_ms : 0.0;
-        fwrite(&rank, sizeof rank, 1, f);
-        fwrite(&cd, sizeof cd, 1, f);
+        rogue_save_buffer_append(buf, &rank, sizeof rank);
+        rogue_save_buffer_append(buf, &cd, sizeof cd);
         double cast_progress = st ? st->cast_progress_ms : 0.0;
         double channel_end = st ? st->channel_end_ms : 0.0;
         double next_charge_ready = st ? st->next_charge_ready_ms : 0.0;
         int charges_cur = st ? st->charges_cur : 0;
         unsigned char casting_active = st ? st->casting_active : 0;
         unsigned char channel_active = st ? st->channel_active : 0;
-        fwrite(&cast_progress, sizeof cast_progress, 1, f);
-        fwrite(&channel_end, sizeof channel_end, 1, f);
-        fwrite(&next_charge_ready, sizeof next_charge_ready, 1, f);
-        fwrite(&charges_cur, sizeof charges_cur, 1, f);
-        fwrite(&casting_active, sizeof casting_active, 1, f);
-        fwrite(&channel_active, sizeof channel_active, 1, f);
+        rogue_save_buffer_append(buf, &cast_progress, sizeof cast_progress);
+        rogue_save_buffer_append(buf, &channel_end, sizeof channel_end);
+        rogue_save_buffer_append(buf, &next_charge_ready, sizeof next_charge_ready);
+        rogue_save_buffer_append(buf, &charges_cur, sizeof charges_cur);
+        rogue_save_buffer_append(buf, &casting_active, sizeof casting_active);
+        rogue_save_buffer_append(buf, &channel_active, sizeof channel_active);
     }
     return 0;
 }
 
-static int read_skills_component(FILE* f, size_t size)
+static int read_skills_component(RogueSaveReader* in, size_t size)
 {
-    long section_start = ftell(f);
+    size_t section_start = rogue_save_reader_tell(in);
     int count = 0;
     size_t count_bytes = 0;
     if (g_active_read_version >= 4)
     {
         uint32_t c = 0;
-        if (rogue_read_varuint(f, &c) != 0)
+        if (rogue_save_reader_read_varuint(in, &c) != 0)
             return -1;
         count = (int) c;
     }
     else
     {
-        if (fread(&count, sizeof count, 1, f) != 1)
+        if (rogue_save_reader_read(in, &count, sizeof count) != 0)
             return -1;
     }
-    count_bytes = (size_t) (ftell(f) - section_start);
+    count_bytes = rogue_save_reader_tell(in) - section_start;
     if (count < 0 || count > 4096)
         return -1;
     size_t remaining = (size_t) size - count_bytes;
@@ -558,26 +568,26 @@ static int read_skills_component(FILE* f, size_t size)
     {
         int rank = 0;
         double cd = 0.0;
-        if (fread(&rank, sizeof rank, 1, f) != 1)
+        if (rogue_save_reader_read(in, &rank, sizeof rank) != 0)
             return -1;
-        if (fread(&cd, sizeof cd, 1, f) != 1)
+        if (rogue_save_reader_read(in, &cd, sizeof cd) != 0)
             return -1;
         double cast_progress = 0.0, channel_end = 0.0, next_charge_ready = 0.0;
         int charges_cur = 0;
         unsigned char casting_active = 0, channel_active = 0;
         if (has_extended)
         {
-            if (fread(&cast_progress, sizeof cast_progress, 1, f) != 1)
+            if (rogue_save_reader_read(in, &cast_progress, sizeof cast_progress) != 0)
                 return -1;
-            if (fread(&channel_end, sizeof channel_end, 1, f) != 1)
+            if (rogue_save_reader_read(in, &channel_end, sizeof channel_end) != 0)
                 return -1;
-            if (fread(&next_charge_ready, sizeof next_charge_ready, 1, f) != 1)
+            if (rogue_save_reader_read(in, &next_charge_ready, sizeof next_charge_ready) != 0)
                 return -1;
-            if (fread(&charges_cur, sizeof charges_cur, 1, f) != 1)
+            if (rogue_save_reader_read(in, &charges_cur, sizeof charges_cur) != 0)
                 return -1;
-            if (fread(&casting_active, sizeof casting_active, 1, f) != 1)
+            if (rogue_save_reader_read(in, &casting_active, sizeof casting_active) != 0)
                 return -1;
-            if (fread(&channel_active, sizeof channel_active, 1, f) != 1)
+            if (rogue_save_reader_read(in, &channel_active, sizeof channel_active) != 0)
                 return -1;
         }
         if (i < limit)
@@ -606,16 +616,16 @@ static int read_skills_component(FILE* f, size_t size)
 }
 
 /* Buffs */
-static int write_buffs_component(FILE* f)
+static int write_buffs_component(RogueSaveBuffer* buf)
 {
     int active_count = rogue_buffs_active_count();
     if (g_active_write_version >= 4)
     {
-        if (rogue_write_varuint(f, (uint32_t) active_count) != 0)
+        if (rogue_save_buffer_write_varuint(buf, (uint32_t) active_count) != 0)
             return -1;
     }
     else
-        fwrite(&active_count, sizeof active_count, 1, f);
+        rogue_save_buffer_append(buf, &active_count, sizeof active_count);
     for (int i = 0; i < active_count; i++)
     {
         RogueBuff tmp;
@@ -625,29 +635,29 @@ static int write_buffs_component(FILE* f)
         double remaining_ms = (tmp.end_ms > now) ? (tmp.end_ms - now) : 0.0;
         int type = tmp.type;
         int magnitude = tmp.magnitude;
-        fwrite(&type, sizeof type, 1, f);
-        fwrite(&magnitude, sizeof magnitude, 1, f);
-        fwrite(&remaining_ms, sizeof remaining_ms, 1, f);
+        rogue_save_buffer_append(buf, &type, sizeof type);
+        rogue_save_buffer_append(buf, &magnitude, sizeof magnitude);
+        rogue_save_buffer_append(buf, &remaining_ms, sizeof remaining_ms);
     }
     return 0;
 }
 
-static int read_buffs_component(FILE* f, size_t size)
+static int read_buffs_component(RogueSaveReader* in, size_t size)
 {
-    long start = ftell(f);
+    size_t start = rogue_save_reader_tell(in);
     int count = 0;
     if (g_active_read_version >= 4)
     {
         uint32_t c = 0;
-        if (rogue_read_varuint(f, &c) != 0)
+        if (rogue_save_reader_read_varuint(in, &c) != 0)
             return -1;
         count = (int) c;
     }
-    else if (fread(&count, sizeof count, 1, f) != 1)
+    else if (rogue_save_reader_read(in, &count, sizeof count) != 0)
         return -1;
     if (count < 0 || count > 512)
         return -1;
-    size_t count_bytes = (size_t) (ftell(f) - start);
+    size_t count_bytes = rogue_save_reader_tell(in) - start;
     size_t remaining = size - count_bytes;
     if (count == 0)
         return 0;
@@ -663,7 +673,7 @@ static int read_buffs_component(FILE* f, size_t size)
                 double end_ms;
                 int magnitude;
             } lb;
-            if (fread(&lb, sizeof lb, 1, f) != 1)
+            if (rogue_save_reader_read(in, &lb, sizeof lb) != 0)
                 return -1;
             double now = g_app.game_time_ms;
             double remaining_ms = (lb.end_ms > now) ? (lb.end_ms - now) : 0.0;
@@ -675,11 +685,11 @@ static int read_buffs_component(FILE* f, size_t size)
             int type = 0;
             int magnitude = 0;
             double remaining_ms = 0.0;
-            if (fread(&type, sizeof type, 1, f) != 1)
+            if (rogue_save_reader_read(in, &type, sizeof type) != 0)
                 return -1;
-            if (fread(&magnitude, sizeof magnitude, 1, f) != 1)
+            if (rogue_save_reader_read(in, &magnitude, sizeof magnitude) != 0)
                 return -1;
-            if (fread(&remaining_ms, sizeof remaining_ms, 1, f) != 1)
+            if (rogue_save_reader_read(in, &remaining_ms, sizeof remaining_ms) != 0)
                 return -1;
             double now = g_app.game_time_ms;
             rogue_buffs_apply((RogueBuffType) type, magnitude, remaining_ms, now,
@@ -690,45 +700,47 @@ static int read_buffs_component(FILE* f, size_t size)
 }
 
 /* Vendor */
-static int write_vendor_component(FILE* f)
+static int write_vendor_component(RogueSaveBuffer* buf)
 {
-    fwrite(&g_app.vendor_seed, sizeof g_app.vendor_seed, 1, f);
-    fwrite(&g_app.vendor_time_accum_ms, sizeof g_app.vendor_time_accum_ms, 1, f);
-    fwrite(&g_app.vendor_restock_interval_ms, sizeof g_app.vendor_restock_interval_ms, 1, f);
+    rogue_save_buffer_append(buf, &g_app.vendor_seed, sizeof g_app.vendor_seed);
+    rogue_save_buffer_append(buf, &g_app.vendor_time_accum_ms, sizeof g_app.vendor_time_accum_ms);
+    rogue_save_buffer_append(buf, &g_app.vendor_restock_interval_ms,
+                             sizeof g_app.vendor_restock_interval_ms);
     int count = rogue_vendor_item_count();
     if (count < 0)
         count = 0;
     if (count > ROGUE_VENDOR_SLOT_CAP)
         count = ROGUE_VENDOR_SLOT_CAP;
-    fwrite(&count, sizeof count, 1, f);
+    rogue_save_buffer_append(buf, &count, sizeof count);
     for (int i = 0; i < count; i++)
     {
         const RogueVendorItem* it = rogue_vendor_get(i);
         if (!it)
         {
             int zero = 0;
-            fwrite(&zero, sizeof zero, 1, f);
-            fwrite(&zero, sizeof zero, 1, f);
-            fwrite(&zero, sizeof zero, 1, f);
+            rogue_save_buffer_append(buf, &zero, sizeof zero);
+            rogue_save_buffer_append(buf, &zero, sizeof zero);
+            rogue_save_buffer_append(buf, &zero, sizeof zero);
         }
         else
         {
-            fwrite(&it->def_index, sizeof it->def_index, 1, f);
-            fwrite(&it->rarity, sizeof it->rarity, 1, f);
-            fwrite(&it->price, sizeof it->price, 1, f);
+            rogue_save_buffer_append(buf, &it->def_index, sizeof it->def_index);
+            rogue_save_buffer_append(buf, &it->rarity, sizeof it->rarity);
+            rogue_save_buffer_append(buf, &it->price, sizeof it->price);
         }
     }
     return 0;
 }
 
-static int read_vendor_component(FILE* f, size_t size)
+static int read_vendor_component(RogueSaveReader* in, size_t size)
 {
     (void) size;
-    fread(&g_app.vendor_seed, sizeof g_app.vendor_seed, 1, f);
-    fread(&g_app.vendor_time_accum_ms, sizeof g_app.vendor_time_accum_ms, 1, f);
-    fread(&g_app.vendor_restock_interval_ms, sizeof g_app.vendor_restock_interval_ms, 1, f);
+    rogue_save_reader_read(in, &g_app.vendor_seed, sizeof g_app.vendor_seed);
+    rogue_save_reader_read(in, &g_app.vendor_time_accum_ms, sizeof g_app.vendor_time_accum_ms);
+    rogue_save_reader_read(in, &g_app.vendor_restock_interval_ms,
+                           sizeof g_app.vendor_restock_interval_ms);
     int count = 0;
-    if (fread(&count, sizeof count, 1, f) != 1)
+    if (rogue_save_reader_read(in, &count, sizeof count) != 0)
         return 0;
     if (count < 0 || count > ROGUE_VENDOR_SLOT_CAP)
         count = 0;
@@ -736,11 +748,11 @@ static int read_vendor_component(FILE* f, size_t size)
     for (int i = 0; i < count; i++)
     {
         int def = 0, rar = 0, price = 0;
-        if (fread(&def, sizeof def, 1, f) != 1)
+        if (rogue_save_reader_read(in, &def, sizeof def) != 0)
             return -1;
-        if (fread(&rar, sizeof rar, 1, f) != 1)
+        if (rogue_save_reader_read(in, &rar, sizeof rar) != 0)
             return -1;
-        if (fread(&price, sizeof price, 1, f) != 1)
+        if (rogue_save_reader_read(in, &price, sizeof price) != 0)
             return -1;
         if (def >= 0)
         {
@@ -752,45 +764,45 @@ static int read_vendor_component(FILE* f, size_t size)
 }
 
 /* Strings intern table */
-static int write_strings_component(FILE* f)
+static int write_strings_component(RogueSaveBuffer* buf)
 {
     int count = rogue_save_intern_count();
     if (g_active_write_version >= 4)
     {
-        if (rogue_write_varuint(f, (uint32_t) count) != 0)
+        if (rogue_save_buffer_write_varuint(buf, (uint32_t) count) != 0)
             return -1;
     }
     else
-        fwrite(&count, sizeof count, 1, f);
+        rogue_save_buffer_append(buf, &count, sizeof count);
     for (int i = 0; i < count; i++)
     {
         const char* s = rogue_save_intern_get(i);
         uint32_t len = (uint32_t) strlen(s);
         if (g_active_write_version >= 4)
         {
-            if (rogue_write_varuint(f, len) != 0)
+            if (rogue_save_buffer_write_varuint(buf, len) != 0)
                 return -1;
         }
         else
-            fwrite(&len, sizeof len, 1, f);
-        if (fwrite(s, 1, len, f) != len)
+            rogue_save_buffer_append(buf, &len, sizeof len);
+        if (rogue_save_buffer_append(buf, s, len) != 0)
             return -1;
     }
     return 0;
 }
 
-static int read_strings_component(FILE* f, size_t size)
+static int read_strings_component(RogueSaveReader* in, size_t size)
 {
     (void) size;
     int count = 0;
     if (g_active_read_version >= 4)
     {
         uint32_t c = 0;
-        if (rogue_read_varuint(f, &c) != 0)
+        if (rogue_save_reader_read_varuint(in, &c) != 0)
             return -1;
         count = (int) c;
     }
-    else if (fread(&count, sizeof count, 1, f) != 1)
+    else if (rogue_save_reader_read(in, &count, sizeof count) != 0)
         return -1;
     if (count < 0)
         return -1;
@@ -800,17 +812,17 @@ static int read_strings_component(FILE* f, size_t size)
         uint32_t len = 0;
         if (g_active_read_version >= 4)
         {
-            if (rogue_read_varuint(f, &len) != 0)
+            if (rogue_save_reader_read_varuint(in, &len) != 0)
                 return -1;
         }
-        else if (fread(&len, sizeof len, 1, f) != 1)
+        else if (rogue_save_reader_read(in, &len, sizeof len) != 0)
             return -1;
         if (len > 4096)
             return -1;
         char* buf = (char*) malloc(len + 1);
         if (!buf)
             return -1;
-        if (fread(buf, 1, len, f) != len)
+        if (rogue_save_reader_read(in, buf, len) != 0)
         {
             free(buf);
             return -1;
@@ -822,78 +834,78 @@ static int read_strings_component(FILE* f, size_t size)
 }
 
 /* World meta */
-static int write_world_meta_component(FILE* f)
+static int write_world_meta_component(RogueSaveBuffer* buf)
 {
-    fwrite(&g_app.pending_seed, sizeof g_app.pending_seed, 1, f);
-    fwrite(&g_app.gen_water_level, sizeof g_app.gen_water_level, 1, f);
-    fwrite(&g_app.gen_cave_thresh, sizeof g_app.gen_cave_thresh, 1, f);
-    fwrite(&g_app.gen_noise_octaves, sizeof g_app.gen_noise_octaves, 1, f);
-    fwrite(&g_app.gen_noise_gain, sizeof g_app.gen_noise_gain, 1, f);
-    fwrite(&g_app.gen_noise_lacunarity, sizeof g_app.gen_noise_lacunarity, 1, f);
-    fwrite(&g_app.gen_river_sources, sizeof g_app.gen_river_sources, 1, f);
-    fwrite(&g_app.gen_river_max_length, sizeof g_app.gen_river_max_length, 1, f);
+    rogue_save_buffer_append(buf, &g_app.pending_seed, sizeof g_app.pending_seed);
+    rogue_save_buffer_append(buf, &g_app.gen_water_level, sizeof g_app.gen_water_level);
+    rogue_save_buffer_append(buf, &g_app.gen_cave_thresh, sizeof g_app.gen_cave_thresh);
+    rogue_save_buffer_append(buf, &g_app.gen_noise_octaves, sizeof g_app.gen_noise_octaves);
+    rogue_save_buffer_append(buf, &g_app.gen_noise_gain, sizeof g_app.gen_noise_gain);
+    rogue_save_buffer_append(buf, &g_app.gen_noise_lacunarity, sizeof g_app.gen_noise_lacunarity);
+    rogue_save_buffer_append(buf, &g_app.gen_river_sources, sizeof g_app.gen_river_sources);
+    rogue_save_buffer_append(buf, &g_app.gen_river_max_length, sizeof g_app.gen_river_max_length);
     return 0;
 }
 
-static int read_world_meta_component(FILE* f, size_t size)
+static int read_world_meta_component(RogueSaveReader* in, size_t size)
 {
     size_t remain = size;
     if (remain < sizeof(unsigned int) + sizeof(double) * 2)
         return -1;
-    fread(&g_app.pending_seed, sizeof g_app.pending_seed, 1, f);
+    rogue_save_reader_read(in, &g_app.pending_seed, sizeof g_app.pending_seed);
     remain -= sizeof g_app.pending_seed;
-    fread(&g_app.gen_water_level, sizeof g_app.gen_water_level, 1, f);
+    rogue_save_reader_read(in, &g_app.gen_water_level, sizeof g_app.gen_water_level);
     remain -= sizeof g_app.gen_water_level;
-    fread(&g_app.gen_cave_thresh, sizeof g_app.gen_cave_thresh, 1, f);
+    rogue_save_reader_read(in, &g_app.gen_cave_thresh, sizeof g_app.gen_cave_thresh);
     remain -= sizeof g_app.gen_cave_thresh;
     if (remain >= sizeof g_app.gen_noise_octaves)
     {
-        fread(&g_app.gen_noise_octaves, sizeof g_app.gen_noise_octaves, 1, f);
+        rogue_save_reader_read(in, &g_app.gen_noise_octaves, sizeof g_app.gen_noise_octaves);
         remain -= sizeof g_app.gen_noise_octaves;
     }
     if (remain >= sizeof g_app.gen_noise_gain)
     {
-        fread(&g_app.gen_noise_gain, sizeof g_app.gen_noise_gain, 1, f);
+        rogue_save_reader_read(in, &g_app.gen_noise_gain, sizeof g_app.gen_noise_gain);
         remain -= sizeof g_app.gen_noise_gain;
     }
     if (remain >= sizeof g_app.gen_noise_lacunarity)
     {
-        fread(&g_app.gen_noise_lacunarity, sizeof g_app.gen_noise_lacunarity, 1, f);
+        rogue_save_reader_read(in, &g_app.gen_noise_lacunarity, sizeof g_app.gen_noise_lacunarity);
         remain -= sizeof g_app.gen_noise_lacunarity;
     }
     if (remain >= sizeof g_app.gen_river_sources)
     {
-        fread(&g_app.gen_river_sources, sizeof g_app.gen_river_sources, 1, f);
+        rogue_save_reader_read(in, &g_app.gen_river_sources, sizeof g_app.gen_river_sources);
         remain -= sizeof g_app.gen_river_sources;
     }
     if (remain >= sizeof g_app.gen_river_max_length)
     {
-        fread(&g_app.gen_river_max_length, sizeof g_app.gen_river_max_length, 1, f);
+        rogue_save_reader_read(in, &g_app.gen_river_max_length, sizeof g_app.gen_river_max_length);
         remain -= sizeof g_app.gen_river_max_length;
     }
     return 0;
 }
 
 /* Replay (v8) */
-static int write_replay_component(FILE* f)
+static int write_replay_component(RogueSaveBuffer* buf)
 {
     rogue_replay_compute_hash();
     uint32_t count = g_replay_event_count;
-    fwrite(&count, sizeof count, 1, f);
+    rogue_save_buffer_append(buf, &count, sizeof count);
     if (count)
     {
-        fwrite(g_replay_events, sizeof(RogueReplayEvent), count, f);
+        rogue_save_buffer_append(buf, g_replay_events, sizeof(RogueReplayEvent) * count);
     }
-    fwrite(g_last_replay_hash, 1, 32, f);
+    rogue_save_buffer_append(buf, g_last_replay_hash, 32);
     return 0;
 }
 
-static int read_replay_component(FILE* f, size_t size)
+static int read_replay_component(RogueSaveReader* in, size_t size)
 {
     if (size < sizeof(uint32_t) + 32)
         return -1;
     uint32_t count = 0;
-    fread(&count, sizeof count, 1, f);
+    rogue_save_reader_read(in, &count, sizeof count);
     size_t need = (size_t) count * sizeof(RogueReplayEvent) + 32;
     if (size < sizeof(uint32_t) + need)
         return -1;
@@ -901,9 +913,9 @@ static int read_replay_component(FILE* f, size_t size)
         return -1;
     if (count)
     {
-        fread(g_replay_events, sizeof(RogueReplayEvent), count, f);
+        rogue_save_reader_read(in, g_replay_events, sizeof(RogueReplayEvent) * count);
     }
-    fread(g_last_replay_hash, 1, 32, f);
+    rogue_save_reader_read(in, g_last_replay_hash, 32);
     g_replay_event_count = count;
     RogueSHA256Ctx sha;
     unsigned char chk[32];
@@ -916,7 +928,7 @@ static int read_replay_component(FILE* f, size_t size)
 }
 
 /* Inventory entries */
-static int write_inv_entries_component(FILE* f)
+static int write_inv_entries_component(RogueSaveBuffer* buf)
 {
     uint32_t count = 0;
     for (int i = 0; i < 4096; i++)
@@ -924,7 +936,7 @@ static int write_inv_entries_component(FILE* f)
         if (rogue_inventory_quantity(i) > 0)
             count++;
     }
-    if (rogue_write_varuint(f, count) != 0)
+    if (rogue_save_buffer_write_varuint(buf, count) != 0)
         return -1;
     for (int i = 0; i < 4096; i++)
     {
@@ -933,19 +945,19 @@ static int write_inv_entries_component(FILE* f)
         {
             unsigned lbl = rogue_inventory_entry_labels(i);
             int def = i;
-            fwrite(&def, sizeof(def), 1, f);
-            fwrite(&q, sizeof(q), 1, f);
-            fwrite(&lbl, sizeof(lbl), 1, f);
+            rogue_save_buffer_append(buf, &def, sizeof(def));
+            rogue_save_buffer_append(buf, &q, sizeof(q));
+            rogue_save_buffer_append(buf, &lbl, sizeof(lbl));
         }
     }
     rogue_inventory_entries_dirty_pairs(NULL, NULL, 0);
     return 0;
 }
 
-static int read_inv_entries_component(FILE* f, size_t size)
+static int read_inv_entries_component(RogueSaveReader* in, size_t size)
 {
     uint32_t count = 0;
-    if (rogue_read_varuint(f, &count) != 0)
+    if (rogue_save_reader_read_varuint(in, &count) != 0)
         return -1;
     size_t need = (size_t) count * (sizeof(int) + sizeof(uint64_t) + sizeof(unsigned));
     if (size < need)
@@ -956,11 +968,11 @@ static int read_inv_entries_component(FILE* f, size_t size)
         int def = 0;
         uint64_t qty = 0;
         unsigned lbl = 0;
-        if (fread(&def, sizeof(def), 1, f) != 1)
+        if (rogue_save_reader_read(in, &def, sizeof(def)) != 0)
             return -1;
-        if (fread(&qty, sizeof(qty), 1, f) != 1)
+        if (rogue_save_reader_read(in, &qty, sizeof(qty)) != 0)
             return -1;
-        if (fread(&lbl, sizeof(lbl), 1, f) != 1)
+        if (rogue_save_reader_read(in, &lbl, sizeof(lbl)) != 0)
             return -1;
         if (def >= 0)
         {
@@ -974,7 +986,7 @@ static int read_inv_entries_component(FILE* f, size_t size)
 }
 
 /* Inventory tags */
-static int write_inv_tags_component(FILE* f)
+static int write_inv_tags_component(RogueSaveBuffer* buf)
 {
     uint32_t count = 0;
     for (int i = 0; i < ROGUE_INV_TAG_MAX_DEFS; i++)
@@ -982,7 +994,7 @@ static int write_inv_tags_component(FILE* f)
         if (rogue_inv_tags_get_flags(i) || rogue_inv_tags_list(i, NULL, 0) > 0)
             count++;
     }
-    if (rogue_write_varuint(f, count) != 0)
+    if (rogue_save_buffer_write_varuint(buf, count) != 0)
         return -1;
     if (count == 0)
         return 0;
@@ -996,10 +1008,10 @@ static int write_inv_tags_component(FILE* f)
             tc = 0;
         if (tc > ROGUE_INV_TAG_MAX_TAGS_PER_DEF)
             tc = ROGUE_INV_TAG_MAX_TAGS_PER_DEF;
-        fwrite(&i, sizeof(int), 1, f);
-        fwrite(&fl, sizeof(fl), 1, f);
+        rogue_save_buffer_append(buf, &i, sizeof(int));
+        rogue_save_buffer_append(buf, &fl, sizeof(fl));
         unsigned char tcc = (unsigned char) tc;
-        fwrite(&tcc, 1, 1, f);
+        rogue_save_buffer_append(buf, &tcc, 1);
         if (tc > 0)
         {
             const char* tmp[ROGUE_INV_TAG_MAX_TAGS_PER_DEF];
@@ -1010,18 +1022,18 @@ static int write_inv_tags_component(FILE* f)
                 if (len > 255)
                     len = 255;
                 unsigned char l = (unsigned char) len;
-                fwrite(&l, 1, 1, f);
-                fwrite(tmp[k], 1, len, f);
+                rogue_save_buffer_append(buf, &l, 1);
+                rogue_save_buffer_append(buf, tmp[k], len);
             }
         }
     }
     return 0;
 }
 
-static int read_inv_tags_component(FILE* f, size_t size)
+static int read_inv_tags_component(RogueSaveReader* in, size_t size)
 {
     uint32_t count = 0;
-    if (rogue_read_varuint(f, &count) != 0)
+    if (rogue_save_reader_read_varuint(in, &count) != 0)
         return -1;
     size_t consumed = 0;
     rogue_inv_tags_init();
@@ -1030,18 +1042,18 @@ static int read_inv_tags_component(FILE* f, size_t size)
         int def = 0;
         unsigned flags = 0;
         unsigned char tcc = 0;
-        if (fread(&def, sizeof(def), 1, f) != 1)
+        if (rogue_save_reader_read(in, &def, sizeof(def)) != 0)
             return -1;
-        if (fread(&flags, sizeof(flags), 1, f) != 1)
+        if (rogue_save_reader_read(in, &flags, sizeof(flags)) != 0)
             return -1;
-        if (fread(&tcc, 1, 1, f) != 1)
+        if (rogue_save_reader_read(in, &tcc, 1) != 0)
             return -1;
         consumed += sizeof(def) + sizeof(flags) + 1;
         rogue_inv_tags_set_flags(def, flags);
         for (unsigned char k = 0; k < tcc; k++)
         {
             unsigned char l = 0;
-            if (fread(&l, 1, 1, f) != 1)
+            if (rogue_save_reader_read(in, &l, 1) != 0)
                 return -1;
             consumed += 1;
             if (l > 0)
@@ -1049,7 +1061,7 @@ static int read_inv_tags_component(FILE* f, size_t size)
                 char buf[256];
                 if (l >= sizeof(buf))
                     l = (unsigned char) (sizeof(buf) - 1);
-                if (fread(buf, 1, l, f) != l)
+                if (rogue_save_reader_read(in, buf, l) != 0)
                     return -1;
                 buf[l] = '\0';
                 rogue_inv_tags_add_tag(def, buf);
@@ -1062,19 +1074,22 @@ static int read_inv_tags_component(FILE* f, size_t size)
     return 0;
 }
 
-static int write_inv_tag_rules_component(FILE* f) { return rogue_inv_tag_rules_write(f); }
-static int read_inv_tag_rules_component(FILE* f, size_t size)
+static int write_inv_tag_rules_component(RogueSaveBuffer* buf)
 {
-    return rogue_inv_tag_rules_read(f, size);
+    return rogue_inv_tag_rules_write(buf);
+}
+static int read_inv_tag_rules_component(RogueSaveReader* in, size_t size)
+{
+    return rogue_inv_tag_rules_read(in, size);
 }
 
-static int write_inv_saved_searches_component(FILE* f)
+static int write_inv_saved_searches_component(RogueSaveBuffer* buf)
 {
-    return rogue_inventory_saved_searches_write(f);
+    return rogue_inventory_saved_searches_write(buf);
 }
-static int read_inv_saved_searches_component(FILE* f, size_t size)
+static int read_inv_saved_searches_component(RogueSaveReader* in, size_t size)
 {
-    return rogue_inventory_saved_searches_read(f, size);
+    return rogue_inventory_saved_searches_read(in, size);
 }
 
 /* Component descriptors and registry */
@@ -16,9 +16,11 @@ int g_save_last_recovery_used = 0;
 int g_save_autosave_interval_ms = 0;
 int g_save_autosave_throttle_ms = 0;
 uint32_t g_save_autosave_count = 0;
+int g_save_async_enabled = 1; /* scheduler autosaves run on a worker unless disabled */
 int g_save_last_rc = 0;
 uint32_t g_save_last_bytes = 0;
 double g_save_last_ms = 0.0;
+double g_save_last_capture_ms = 0.0;
 
 uint32_t g_active_write_version = 0;
 uint32_t g_active_read_version = 0;
@@ -36,6 +38,9 @@ RogueCachedSection g_save_cached_sections[ROGUE_SAVE_MAX_COMPONENTS];
 unsigned g_save_last_sections_reused = 0;
 unsigned g_save_last_sections_written = 0;
 
+RogueSaveCodecStats g_save_codec_stats[ROGUE_SAVE_MAX_COMPONENTS];
+int g_save_codec_stats_count = 0;
+
 const RogueSaveComponent* rogue_find_component(int id)
 {
     for (int i = 0; i < g_save_component_count; i++)
@@ -0,0 +1,169 @@
+#include "save_hash_accel.h"
+#include "../../util/cpu_features.h"
+
+#if ROGUE_ARCH_X86
+#include <immintrin.h>
+#include <wmmintrin.h>
+
+int rogue__crc32_hw_available(void)
+{
+    const RogueCpuFeatures* f = rogue_cpu_features();
+    return f->pclmul && f->sse41;
+}
+
+/* Carry-less multiply folding for the reflected IEEE polynomial (Intel "Fast CRC Computation
+ * Using PCLMULQDQ"): four 128-bit lanes folded 64 bytes at a time, reduced to one lane, then a
+ * Barrett reduction down to 32 bits. */
+ROGUE_TARGET("pclmul,sse4.1")
+uint32_t rogue__crc32_pclmul(uint32_t reg, const unsigned char* p, size_t len)
+{
+    const __m128i k1k2 = _mm_set_epi64x(0x01c6e41596LL, 0x0154442bd4LL);
+    const __m128i k3k4 = _mm_set_epi64x(0x00ccaa009eLL, 0x01751997d0LL);
+    const __m128i k5k0 = _mm_set_epi64x(0, 0x0163cd6124LL);
+    const __m128i poly = _mm_set_epi64x(0x01f7011641LL, 0x01db710641LL);
+    const __m128i mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+    __m128i x1, x2, x3, x4, x5;
+    x1 = _mm_loadu_si128((const __m128i*) (p + 0x00));
+    x2 = _mm_loadu_si128((const __m128i*) (p + 0x10));
+    x3 = _mm_loadu_si128((const __m128i*) (p + 0x20));
+    x4 = _mm_loadu_si128((const __m128i*) (p + 0x30));
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((int) reg));
+    p += 64;
+    len -= 64;
+    while (len >= 64)
+    {
+        __m128i y1 = _mm_clmulepi64_si128(x1, k1k2, 0x00);
+        __m128i y2 = _mm_clmulepi64_si128(x2, k1k2, 0x00);
+        __m128i y3 = _mm_clmulepi64_si128(x3, k1k2, 0x00);
+        __m128i y4 = _mm_clmulepi64_si128(x4, k1k2, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, k1k2, 0x11);
+        x2 = _mm_clmulepi64_si128(x2, k1k2, 0x11);
+        x3 = _mm_clmulepi64_si128(x3, k1k2, 0x11);
+        x4 = _mm_clmulepi64_si128(x4, k1k2, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, y1), _mm_loadu_si128((const __m128i*) (p + 0x00)));
+        x2 = _mm_xor_si128(_mm_xor_si128(x2, y2), _mm_loadu_si128((const __m128i*) (p + 0x10)));
+        x3 = _mm_xor_si128(_mm_xor_si128(x3, y3), _mm_loadu_si128((const __m128i*) (p + 0x20)));
+        x4 = _mm_xor_si128(_mm_xor_si128(x4, y4), _mm_loadu_si128((const __m128i*) (p + 0x30)));
+        p += 64;
+        len -= 64;
+    }
+    /* Fold the four lanes into one */
+    x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+    x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+    x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+    /* Remaining 16-byte blocks */
+    while (len >= 16)
+    {
+        x2 = _mm_loadu_si128((const __m128i*) p);
+        x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+        p += 16;
+        len -= 16;
+    }
+    /* 128 -> 64 bits */
+    x2 = _mm_clmulepi64_si128(x1, k3k4, 0x10);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, mask32);
+    x1 = _mm_clmulepi64_si128(x1, k5k0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+    /* Barrett reduction to 32 bits */
+    x2 = _mm_and_si128(x1, mask32);
+    x2 = _mm_clmulepi64_si128(x2, poly, 0x10);
+    x2 = _mm_and_si128(x2, mask32);
+    x2 = _mm_clmulepi64_si128(x2, poly, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+    return (uint32_t) _mm_extract_epi32(x1, 1);
+}
+
+int rogue__sha256_hw_available(void)
+{
+    const RogueCpuFeatures* f = rogue_cpu_features();
+    return f->sha && f->sse41 && f->ssse3;
+}
+
+static const uint32_t k_sha256_K[64] = {
+    0x428a2f98u, 0x71374491u, 0xb5c0fbcfu, 0xe9b5dba5u, 0x3956c25bu, 0x59f111f1u, 0x923f82a4u,
+    0xab1c5ed5u, 0xd807aa98u, 0x12835b01u, 0x243185beu, 0x550c7dc3u, 0x72be5d74u, 0x80deb1feu,
+    0x9bdc06a7u, 0xc19bf174u, 0xe49b69c1u, 0xefbe4786u, 0x0fc19dc6u, 0x240ca1ccu, 0x2de92c6fu,
+    0x4a7484aau, 0x5cb0a9dcu, 0x76f988dau, 0x983e5152u, 0xa831c66du, 0xb00327c8u, 0xbf597fc7u,
+    0xc6e00bf3u, 0xd5a79147u, 0x06ca6351u, 0x14292967u, 0x27b70a85u, 0x2e1b2138u, 0x4d2c6dfcu,
+    0x53380d13u, 0x650a7354u, 0x766a0abbu, 0x81c2c92eu, 0x92722c85u, 0xa2bfe8a1u, 0xa81a664bu,
+    0xc24b8b70u, 0xc76c51a3u, 0xd192e819u, 0xd6990624u, 0xf40e3585u, 0x106aa070u, 0x19a4c116u,
+    0x1e376c08u, 0x2748774cu, 0x34b0bcb5u, 0x391c0cb3u, 0x4ed8aa4au, 0x5b9cca4fu, 0x682e6ff3u,
+    0x748f82eeu, 0x78a5636fu, 0x84c87814u, 0x8cc70208u, 0x90befffau, 0xa4506cebu, 0xbef9a3f7u,
+    0xc67178f2u};
+
+/* SHA-NI compression: state kept as ABEF/CDGH lane pairs, four rounds per sha256rnds2 pair,
+ * message schedule via sha256msg1/msg2. */
+ROGUE_TARGET("sha,sse4.1,ssse3")
+void rogue__sha256_blocks_shani(uint32_t h[8], const unsigned char* p, size_t nblocks)
+{
+    const __m128i bswap = _mm_set_epi64x(0x0c0d0e0f08090a0bLL, 0x0405060700010203LL);
+    __m128i tmp = _mm_loadu_si128((const __m128i*) &h[0]);
+    __m128i state1 = _mm_loadu_si128((const __m128i*) &h[4]);
+    tmp = _mm_shuffle_epi32(tmp, 0xB1);                /* CDAB */
+    state1 = _mm_shuffle_epi32(state1, 0x1B);          /* EFGH */
+    __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);  /* ABEF */
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);       /* CDGH */
+    while (nblocks--)
+    {
+        __m128i abef = state0, cdgh = state1;
+        __m128i w[4];
+        for (int q = 0; q < 16; q++)
+        {
+            __m128i m;
+            if (q < 4)
+            {
+                m = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) (p + 16 * q)), bswap);
+            }
+            else
+            {
+                /* W[q] = msg2(msg1(W[q-4], W[q-3]) + alignr(W[q-1], W[q-2], 4), W[q-1]) */
+                m = _mm_sha256msg1_epu32(w[q & 3], w[(q + 1) & 3]);
+                m = _mm_add_epi32(m, _mm_alignr_epi8(w[(q + 3) & 3], w[(q + 2) & 3], 4));
+                m = _mm_sha256msg2_epu32(m, w[(q + 3) & 3]);
+            }
+            w[q & 3] = m;
+            __m128i wk = _mm_add_epi32(m, _mm_loadu_si128((const __m128i*) &k_sha256_K[4 * q]));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, wk);
+            wk = _mm_shuffle_epi32(wk, 0x0E);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, wk);
+        }
+        state0 = _mm_add_epi32(state0, abef);
+        state1 = _mm_add_epi32(state1, cdgh);
+        p += 64;
+    }
+    tmp = _mm_shuffle_epi32(state0, 0x1B);       /* FEBA */
+    state1 = _mm_shuffle_epi32(state1, 0xB1);    /* DCHG */
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0); /* DCBA */
+    state1 = _mm_alignr_epi8(state1, tmp, 8);    /* HGFE */
+    _mm_storeu_si128((__m128i*) &h[0], state0);
+    _mm_storeu_si128((__m128i*) &h[4], state1);
+}
+
+#else /* !ROGUE_ARCH_X86 */
+
+int rogue__crc32_hw_available(void) { return 0; }
+uint32_t rogue__crc32_pclmul(uint32_t reg, const unsigned char* p, size_t len)
+{
+    (void) p;
+    (void) len;
+    return reg;
+}
+int rogue__sha256_hw_available(void) { return 0; }
+void rogue__sha256_blocks_shani(uint32_t h[8], const unsigned char* p, size_t nblocks)
+{
+    (void) h;
+    (void) p;
+    (void) nblocks;
+}
+
+#endif
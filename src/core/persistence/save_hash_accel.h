@@ -0,0 +1,16 @@
+#ifndef ROGUE_SAVE_HASH_ACCEL_H
+#define ROGUE_SAVE_HASH_ACCEL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Hardware kernels behind the CRC32 / SHA256 backends (x86 only; stubs elsewhere). Callers gate on
+ * the *_available() checks. */
+int rogue__crc32_hw_available(void);
+/* Folds len bytes (len >= 64, multiple of 16) into the raw (non-inverted) CRC register. */
+uint32_t rogue__crc32_pclmul(uint32_t reg, const unsigned char* p, size_t len);
+
+int rogue__sha256_hw_available(void);
+void rogue__sha256_blocks_shani(uint32_t h[8], const unsigned char* p, size_t nblocks);
+
+#endif /* ROGUE_SAVE_HASH_ACCEL_H */
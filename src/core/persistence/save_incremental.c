@@ -1,8 +1,11 @@
 #include "save_internal.h"
 #include <stdlib.h> /* free */
+#include <string.h>
 
 static int g_compress_enabled = 0;
 static int g_compress_min_bytes = 64;
+static int g_compress_codec = ROGUE_SAVE_CODEC_LZ;
+static int g_compress_level = 1;
 
 void rogue_save_last_section_reuse(unsigned* reused, unsigned* written)
 {
@@ -57,6 +60,52 @@ int rogue_save_set_compression(int enabled, int min_bytes)
     return 0;
 }
 
+int rogue_save_set_compression_codec(int codec)
+{
+    if (codec != ROGUE_SAVE_CODEC_RLE && codec != ROGUE_SAVE_CODEC_LZ)
+        return -1;
+    g_compress_codec = codec;
+    return 0;
+}
+
+int rogue_save_set_compression_level(int level)
+{
+    if (level < 1)
+        level = 1;
+    if (level > 9)
+        level = 9;
+    g_compress_level = level;
+    return 0;
+}
+
+RogueSaveCodecStats* rogue__save_codec_stats_slot(int component_id)
+{
+    for (int i = 0; i < g_save_codec_stats_count; i++)
+        if (g_save_codec_stats[i].component_id == component_id)
+            return &g_save_codec_stats[i];
+    if (g_save_codec_stats_count >= ROGUE_SAVE_MAX_COMPONENTS)
+        return NULL;
+    RogueSaveCodecStats* st = &g_save_codec_stats[g_save_codec_stats_count++];
+    memset(st, 0, sizeof *st);
+    st->component_id = component_id;
+    st->codec = -1;
+    return st;
+}
+
+int rogue_save_codec_stats(int component_id, RogueSaveCodecStats* out)
+{
+    for (int i = 0; i < g_save_codec_stats_count; i++)
+        if (g_save_codec_stats[i].component_id == component_id)
+        {
+            if (out)
+                *out = g_save_codec_stats[i];
+            return 0;
+        }
+    return -1;
+}
+
 /* Accessors for IO module */
 int rogue__compress_enabled(void) { return g_compress_enabled; }
 int rogue__compress_min_bytes(void) { return g_compress_min_bytes; }
+int rogue__compress_codec(void) { return g_compress_codec; }
+int rogue__compress_level(void) { return g_compress_level; }
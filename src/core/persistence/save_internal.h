@@ -19,9 +19,11 @@ extern int g_save_last_recovery_used;
 extern int g_save_autosave_interval_ms;
 extern int g_save_autosave_throttle_ms;
 extern uint32_t g_save_autosave_count;
+extern int g_save_async_enabled;
 extern int g_save_last_rc;
 extern uint32_t g_save_last_bytes;
 extern double g_save_last_ms;
+extern double g_save_last_capture_ms; /* caller-thread (in-frame) portion of the last save */
 
 extern uint32_t g_active_write_version;
 extern uint32_t g_active_read_version;
@@ -47,6 +49,7 @@ typedef struct RogueCachedSection
     unsigned char* data;
     uint32_t size;
     uint32_t crc32;
+    int compressed; /* payload carries the uncompressed_size prefix (+ v10 codec id) */
     int valid;
 } RogueCachedSection;
 
@@ -54,6 +57,57 @@ extern RogueCachedSection g_save_cached_sections[ROGUE_SAVE_MAX_COMPONENTS];
 extern unsigned g_save_last_sections_reused;
 extern unsigned g_save_last_sections_written;
 
+/* Per-component codec metrics (rogue_save_codec_stats) */
+extern RogueSaveCodecStats g_save_codec_stats[ROGUE_SAVE_MAX_COMPONENTS];
+extern int g_save_codec_stats_count;
+RogueSaveCodecStats* rogue__save_codec_stats_slot(int component_id); /* find or add */
+
+/* Save pipeline stages. capture runs on the caller thread at a frame boundary and snapshots every
+ * component payload into memory; encode + write only touch the capture (compression, CRC, SHA256,
+ * signature, file IO) so they may run on a worker; commit publishes metrics and the incremental
+ * section cache back on the caller thread. */
+typedef struct RogueSaveCapturedSection
+{
+    int id;
+    RogueSaveBuffer payload; /* raw write_fn bytes, or stored (cached) bytes when reused */
+    int reused;
+    int compressed;      /* stored form carries the uncompressed_size prefix (+ v10 codec id) */
+    uint32_t crc32;      /* CRC of the stored form */
+    int codec;           /* codec used when compressed (metrics) */
+    uint32_t raw_bytes;  /* uncompressed payload size (metrics) */
+    double encode_ms;
+    size_t image_offset; /* offset of the stored payload inside the encoded image */
+    uint32_t stored_size;
+} RogueSaveCapturedSection;
+
+typedef struct RogueSaveCapture
+{
+    RogueSaveDescriptor desc;
+    int section_count;
+    RogueSaveCapturedSection sections[ROGUE_SAVE_MAX_COMPONENTS];
+    /* settings frozen at capture time */
+    int compress_enabled;
+    int compress_min_bytes;
+    int compress_codec;
+    int compress_level;
+    int incremental;
+    int durable;
+    const struct RogueSaveSignatureProvider* sig_provider;
+    uint32_t dirty_mask; /* dirty bits cleared by this capture; restored if the save fails */
+    /* encode outputs */
+    RogueSaveBuffer image;
+    unsigned char sha256[32];
+} RogueSaveCapture;
+
+int rogue__save_capture(RogueSaveCapture* cap);
+int rogue__save_encode(RogueSaveCapture* cap);
+int rogue__save_write_image(const char* final_path, const RogueSaveCapture* cap);
+void rogue__save_commit(RogueSaveCapture* cap, int rc, double ms);
+void rogue__save_capture_free(RogueSaveCapture* cap);
+
+/* Async autosave (save_async.c): completes any in-flight background save before returning. */
+void rogue__save_async_drain(void);
+
 /* Paths */
 const char* rogue_build_slot_path(int slot);
 const char* rogue_build_autosave_path(int logical);
@@ -70,5 +124,7 @@ const RogueSaveComponent* rogue_find_component(int id);
 /* Internal accessors from incremental module (for IO paths) */
 int rogue__compress_enabled(void);
 int rogue__compress_min_bytes(void);
+int rogue__compress_codec(void);
+int rogue__compress_level(void);
 
 #endif /* ROGUE_SAVE_INTERNAL_H */
@@ -6,6 +6,7 @@
 #include "../skills/skills.h"
 #include "../vendor/vendor.h"
 #include "persistence.h"
+#include "save_codec.h"
 #include "save_intern.h"
 #include "save_internal.h"
 #include "save_paths.h"
@@ -63,9 +64,6 @@
 /* compression toggles now live in incremental module */
 #define g_compress_enabled (rogue__compress_enabled())
 #define g_compress_min_bytes (rogue__compress_min_bytes())
-/* varuint helper */
-#define read_varuint rogue_read_varuint
-#define write_varuint rogue_write_varuint
 
 /* local reentrancy guard */
 static int g_in_save = 0;
@@ -182,6 +180,7 @@ static int cmp_comp(const void* a, const void* b)
 
 void rogue_save_manager_reset_for_tests(void)
 {
+    rogue__save_async_drain(); /* an in-flight autosave still references the old components */
     g_save_component_count = 0;
     g_save_initialized = 0;
     g_save_migration_count = 0;
@@ -189,6 +188,7 @@ void rogue_save_manager_reset_for_tests(void)
     g_save_last_migration_steps = 0;
     g_save_last_migration_failed = 0;
     g_save_last_migration_ms = 0.0;
+    g_save_codec_stats_count = 0;
     /* Ensure test isolation for save paths */
     rogue_save_paths_set_prefix_tests();
 }
@@ -234,570 +234,402 @@ int rogue_save_read_descriptor(int slot_index, RogueSaveDescriptor* out_desc)
 
 /* Endianness helper provided by save_utils.c */
 
-static int internal_save_to(const char* final_path)
+/* Capture cached payload for incremental reuse (incremental mode only). */
+static void cache_section_payload(int id, const unsigned char* payload, uint32_t size,
+                                  uint32_t crc, int compressed)
 {
-    if (g_in_save)
-        return -99;
-    g_in_save = 1;
-    double t0 = (double) clock();
-    qsort(g_components, g_component_count, sizeof(RogueSaveComponent), cmp_comp);
-    /* Unique temp path to avoid collisions under parallel test processes */
-    char tmp_path[160];
-#if defined(_WIN32)
-    unsigned pid = (unsigned) _getpid();
-#else
-    unsigned pid = (unsigned) getpid();
-#endif
-    unsigned t = (unsigned) time(NULL);
-    unsigned clk = (unsigned) clock();
-    snprintf(tmp_path, sizeof tmp_path, "./tmp_save_%u_%u_%u.tmp", t, pid, clk);
-    FILE* f = NULL;
-#if defined(_MSC_VER)
-    fopen_s(&f, tmp_path, "w+b");
-#else
-    f = fopen(tmp_path, "w+b");
-#endif
-    if (!f)
-        return -2;
-    RogueSaveDescriptor desc = {0};
-    desc.version = ROGUE_SAVE_FORMAT_VERSION;
-    desc.timestamp_unix = (uint32_t) time(NULL);
-    g_active_write_version = desc.version;
-    if (fwrite(&desc, sizeof desc, 1, f) != 1)
+    for (int k = 0; k < ROGUE_SAVE_MAX_COMPONENTS; k++)
     {
-        fclose(f);
-        return -3;
+        if (g_cached_sections[k].valid && g_cached_sections[k].id == id)
+        { /* update existing (component dirty and rewritten) */
+            if (g_cached_sections[k].data && g_cached_sections[k].size != size)
+            {
+                unsigned char* nd = (unsigned char*) realloc(g_cached_sections[k].data, size);
+                if (nd)
+                {
+                    g_cached_sections[k].data = nd;
+                    g_cached_sections[k].size = size;
+                }
+            }
+            if (g_cached_sections[k].data && g_cached_sections[k].size == size)
+            {
+                memcpy(g_cached_sections[k].data, payload, size);
+                g_cached_sections[k].crc32 = crc;
+                g_cached_sections[k].compressed = compressed;
+            }
+            return;
+        }
+    }
+    for (int k = 0; k < ROGUE_SAVE_MAX_COMPONENTS; k++)
+    {
+        if (!g_cached_sections[k].valid)
+        {
+            g_cached_sections[k].id = id;
+            g_cached_sections[k].size = size;
+            g_cached_sections[k].data = (unsigned char*) malloc(size ? size : 1);
+            if (g_cached_sections[k].data)
+            {
+                memcpy(g_cached_sections[k].data, payload, size);
+                g_cached_sections[k].crc32 = crc;
+                g_cached_sections[k].compressed = compressed;
+                g_cached_sections[k].valid = 1;
+            }
+            return;
+        }
     }
-    desc.section_count = 0;
-    desc.component_mask = 0;
-    /* Write all sections */
+}
+
+/* Run a component write callback, appending its payload to out (dropped again on failure). */
+static int capture_component(const RogueSaveComponent* c, RogueSaveBuffer* out)
+{
+    size_t start = out->len;
+    if (c->write_fn(out) != 0)
+    {
+        out->len = start;
+        return -5;
+    }
+    return 0;
+}
+
+void rogue__save_capture_free(RogueSaveCapture* cap)
+{
+    for (int i = 0; i < cap->section_count; i++)
+        rogue_save_buffer_free(&cap->sections[i].payload);
+    cap->section_count = 0;
+    rogue_save_buffer_free(&cap->image);
+}
+
+int rogue__save_capture(RogueSaveCapture* cap)
+{
+    memset(cap, 0, sizeof *cap);
+    cap->desc.version = ROGUE_SAVE_FORMAT_VERSION;
+    cap->desc.timestamp_unix = (uint32_t) time(NULL);
+    cap->compress_enabled = g_compress_enabled;
+    cap->compress_min_bytes = g_compress_min_bytes;
+    cap->compress_codec = rogue__compress_codec();
+    cap->compress_level = rogue__compress_level();
+    cap->incremental = g_incremental_enabled;
+    cap->durable = g_durable_writes;
+    cap->sig_provider = g_sig_provider;
+    g_active_write_version = cap->desc.version;
+    qsort(g_components, g_component_count, sizeof(RogueSaveComponent), cmp_comp);
     g_last_sections_reused = 0;
     g_last_sections_written = 0;
     for (int i = 0; i < g_component_count; i++)
     {
-        ROGUE_LOG_DEBUG("writing component idx=%d id=%d name=%s at_offset=%ld", i,
-                        g_components[i].id, g_components[i].name ? g_components[i].name : "?",
-                        ftell(f));
         const RogueSaveComponent* c = &g_components[i];
-        long start = ftell(f);
-        if (desc.version >= 3)
+        RogueSaveCapturedSection* s = &cap->sections[cap->section_count++];
+        s->id = c->id;
+        rogue_save_buffer_init(&s->payload);
+        /* Phase 17.5: If inventory is clean but records changed, force fresh write and let
+           inventory component compute per-record diff metrics. If unchanged, update metrics
+           here so tests can observe reused==count, rewritten==0 even when reusing. */
+        if (g_incremental_enabled && c->id == ROGUE_SAVE_COMP_INVENTORY &&
+            !(g_dirty_mask & (1u << c->id)))
         {
-            uint16_t id16 = (uint16_t) c->id;
-            uint32_t size_placeholder32 = 0;
-            if (fwrite(&id16, sizeof id16, 1, f) != 1)
-            {
-                fclose(f);
-                return -4;
-            }
-            if (fwrite(&size_placeholder32, sizeof size_placeholder32, 1, f) != 1)
-            {
-                fclose(f);
-                return -4;
-            }
-            long payload_start = ftell(f);
-            int reused_cache = 0;
-            /* Phase 17.5: If inventory is clean but records changed, force fresh write and let
-               inventory component compute per-record diff metrics. If unchanged, update metrics
-               here so tests can observe reused==count, rewritten==0 even when reusing. */
-            if (g_incremental_enabled && c->id == ROGUE_SAVE_COMP_INVENTORY &&
-                !(g_dirty_mask & (1u << c->id)))
-            {
-                int changed = inventory_component_probe_and_prepare_reuse();
-                if (changed)
-                {
-                    g_dirty_mask |= (1u << c->id); /* force fresh write */
-                }
-            }
-            if (g_incremental_enabled && !(g_dirty_mask & (1u << c->id)))
-            { /* attempt reuse */
-                for (int k = 0; k < ROGUE_SAVE_MAX_COMPONENTS; k++)
-                    if (g_cached_sections[k].valid && g_cached_sections[k].id == c->id)
-                    {
-                        /* Reuse cached raw payload (already contains optional uncompressed_size
-                         * prefix for compressed data) */
-                        if (fwrite(g_cached_sections[k].data, 1, g_cached_sections[k].size, f) !=
-                            (size_t) g_cached_sections[k].size)
-                        {
-                            fclose(f);
-                            return -5;
-                        }
-                        long end = ftell(f);
-                        uint32_t section_size = g_cached_sections[k].size;
-                        fseek(f, start + sizeof(uint16_t), SEEK_SET);
-                        fwrite(&section_size, sizeof section_size, 1, f);
-                        fseek(f, end, SEEK_SET);
-                        if (desc.version >= 7)
-                        {
-                            uint32_t sec_crc = g_cached_sections[k].crc32;
-                            fwrite(&sec_crc, sizeof sec_crc, 1, f);
-                        }
-                        reused_cache = 1;
-                        break;
-                    }
-            }
-            if (reused_cache)
+            int changed = inventory_component_probe_and_prepare_reuse();
+            if (changed)
             {
-                g_last_sections_reused++;
+                g_dirty_mask |= (1u << c->id); /* force fresh write */
             }
-            else
-            {
-                g_last_sections_written++; /* fresh payload */
-                if (desc.version >= 6 && g_compress_enabled)
-                {
-                    FILE* mem = NULL;
-#if defined(_MSC_VER)
-                    tmpfile_s(&mem);
-#else
-                    mem = tmpfile();
-#endif
-                    if (!mem)
-                    {
-                        fclose(f);
-                        return -5;
-                    }
-                    if (c->write_fn(mem) != 0)
-                    {
-                        fclose(mem);
-                        fclose(f);
-                        return -5;
-                    }
-                    fflush(mem);
-                    fseek(mem, 0, SEEK_END);
-                    long usz = ftell(mem);
-                    fseek(mem, 0, SEEK_SET);
-                    unsigned char* ubuf = (unsigned char*) malloc((size_t) usz);
-                    if (!ubuf)
-                    {
-                        fclose(mem);
-                        fclose(f);
-                        return -5;
-                    }
-                    fread(ubuf, 1, (size_t) usz, mem);
-                    fclose(mem);
-                    unsigned char* cbuf = (unsigned char*) malloc((size_t) usz * 2 + 16);
-                    if (!cbuf)
-                    {
-                        free(ubuf);
-                        fclose(f);
-                        return -5;
-                    }
-                    size_t ci = 0;
-                    for (long p = 0; p < usz;)
-                    {
-                        unsigned char b = ubuf[p];
-                        int run = 1;
-                        while (p + run < usz && ubuf[p + run] == b && run < 255)
-                            run++;
-                        cbuf[ci++] = b;
-                        cbuf[ci++] = (unsigned char) run;
-                        p += run;
-                    }
-                    int use_compressed = (usz >= g_compress_min_bytes && ci < (size_t) usz);
-                    if (use_compressed)
-                    {
-                        long payload_pos = ftell(f);
-                        fwrite(&usz, sizeof(uint32_t), 1, f);
-                        if (fwrite(cbuf, 1, ci, f) != (size_t) ci)
-                        {
-                            free(cbuf);
-                            free(ubuf);
-                            fclose(f);
-                            return -5;
-                        }
-                        long end = ftell(f);
-                        uint32_t stored_size = (uint32_t) (end - payload_pos);
-                        uint32_t header_size_field = stored_size | 0x80000000u;
-                        fseek(f, start + sizeof(uint16_t), SEEK_SET);
-                        fwrite(&header_size_field, sizeof header_size_field, 1, f);
-                        fseek(f, end, SEEK_SET);
-                    }
-                    else
-                    {
-                        if (fwrite(ubuf, 1, (size_t) usz, f) != (size_t) usz)
-                        {
-                            free(cbuf);
-                            free(ubuf);
-                            fclose(f);
-                            return -5;
-                        }
-                        long end = ftell(f);
-                        uint32_t section_size = (uint32_t) (end - payload_start);
-                        fseek(f, start + sizeof(uint16_t), SEEK_SET);
-                        fwrite(&section_size, sizeof section_size, 1, f);
-                        fseek(f, end, SEEK_SET);
-                    }
-                    free(cbuf);
-                    free(ubuf);
-                }
-                else
+        }
+        if (g_incremental_enabled && !(g_dirty_mask & (1u << c->id)))
+        { /* attempt reuse: copy the cached stored form so the worker never touches the cache */
+            for (int k = 0; k < ROGUE_SAVE_MAX_COMPONENTS; k++)
+                if (g_cached_sections[k].valid && g_cached_sections[k].id == c->id)
                 {
-                    if (c->write_fn(f) != 0)
-                    {
-                        fclose(f);
+                    if (rogue_save_buffer_append(&s->payload, g_cached_sections[k].data,
+                                                 g_cached_sections[k].size) != 0)
                         return -5;
-                    }
-                    long end = ftell(f);
-                    uint32_t section_size = (uint32_t) (end - payload_start);
-                    fseek(f, start + sizeof(uint16_t), SEEK_SET);
-                    fwrite(&section_size, sizeof section_size, 1, f);
-                    fseek(f, end, SEEK_SET);
+                    s->reused = 1;
+                    s->compressed = g_cached_sections[k].compressed;
+                    s->crc32 = g_cached_sections[k].crc32;
+                    break;
                 }
-                if (desc.version >= 7)
-                {
-                    long end_after_payload = ftell(f);
-                    long payload_size = end_after_payload - payload_start;
-                    if (payload_size < 0)
-                    {
-                        fclose(f);
-                        return -14;
-                    }
-                    fseek(f, payload_start, SEEK_SET);
-                    unsigned char* tmp = (unsigned char*) malloc((size_t) payload_size);
-                    if (!tmp)
-                    {
-                        fclose(f);
-                        return -14;
-                    }
-                    if (fread(tmp, 1, (size_t) payload_size, f) != (size_t) payload_size)
-                    {
-                        free(tmp);
-                        fclose(f);
-                        return -14;
-                    }
-                    uint32_t sec_crc = rogue_crc32(tmp, (size_t) payload_size);
-                    free(tmp);
-                    fseek(f, end_after_payload, SEEK_SET);
-                    fwrite(&sec_crc, sizeof sec_crc, 1, f);
-                    if (g_incremental_enabled)
-                    { /* capture cache */
-                        int placed = 0;
-                        for (int k = 0; k < ROGUE_SAVE_MAX_COMPONENTS; k++)
-                        {
-                            if (g_cached_sections[k].valid && g_cached_sections[k].id == c->id)
-                            { /* update existing (component dirty and rewritten) */
-                                if (g_cached_sections[k].data &&
-                                    g_cached_sections[k].size != (uint32_t) payload_size)
-                                {
-                                    unsigned char* nd = (unsigned char*) realloc(
-                                        g_cached_sections[k].data, (size_t) payload_size);
-                                    if (nd)
-                                    {
-                                        g_cached_sections[k].data = nd;
-                                        g_cached_sections[k].size = (uint32_t) payload_size;
-                                    }
-                                }
-                                if (g_cached_sections[k].data)
-                                {
-                                    fseek(f, payload_start, SEEK_SET);
-                                    fread(g_cached_sections[k].data, 1, (size_t) payload_size, f);
-                                    fseek(f, end_after_payload + sizeof(uint32_t), SEEK_SET);
-                                    g_cached_sections[k].crc32 = sec_crc;
-                                }
-                                placed = 1;
-                                break;
-                            }
-                        }
-                        if (!placed)
-                        {
-                            for (int k = 0; k < ROGUE_SAVE_MAX_COMPONENTS; k++)
-                            {
-                                if (!g_cached_sections[k].valid)
-                                {
-                                    g_cached_sections[k].id = c->id;
-                                    g_cached_sections[k].size = (uint32_t) payload_size;
-                                    g_cached_sections[k].data =
-                                        (unsigned char*) malloc((size_t) payload_size);
-                                    if (g_cached_sections[k].data)
-                                    {
-                                        fseek(f, payload_start, SEEK_SET);
-                                        fread(g_cached_sections[k].data, 1, (size_t) payload_size,
-                                              f);
-                                        fseek(f, end_after_payload + sizeof(uint32_t), SEEK_SET);
-                                        g_cached_sections[k].crc32 = sec_crc;
-                                        g_cached_sections[k].valid = 1;
-                                    }
-                                    break;
-                                }
-                            }
-                        }
-                    }
-                } /* end if(desc.version>=7) */
-            } /* end fresh write vs reused */
-            if (g_incremental_enabled)
-            {
-                g_dirty_mask &= ~(1u << c->id);
-            }
-        } /* end version>=3 path */
+        }
+        if (s->reused)
+        {
+            g_last_sections_reused++;
+        }
         else
         {
-            uint32_t id = (uint32_t) c->id, size_placeholder = 0;
-            if (fwrite(&id, sizeof id, 1, f) != 1)
-            {
-                fclose(f);
-                return -4;
-            }
-            if (fwrite(&size_placeholder, sizeof size_placeholder, 1, f) != 1)
-            {
-                fclose(f);
-                return -4;
-            }
-            long payload_start = ftell(f);
-            if (c->write_fn(f) != 0)
-            {
-                fclose(f);
-                return -5;
-            }
-            long end = ftell(f);
-            uint32_t section_size = (uint32_t) (end - payload_start);
-            fseek(f, start + sizeof(uint32_t), SEEK_SET);
-            fwrite(&section_size, sizeof section_size, 1, f);
-            fseek(f, end, SEEK_SET);
+            g_last_sections_written++; /* fresh payload */
+            int rc = capture_component(c, &s->payload);
+            if (rc != 0)
+                return rc;
         }
-        long after = ftell(f);
-        if (after < 0)
+        ROGUE_LOG_DEBUG("captured component idx=%d id=%d name=%s bytes=%zu reused=%d", i, c->id,
+                        c->name ? c->name : "?", s->payload.len, s->reused);
+        if (g_incremental_enabled)
         {
-            fclose(f);
-            return -90;
+            cap->dirty_mask |= g_dirty_mask & (1u << c->id);
+            g_dirty_mask &= ~(1u << c->id);
         }
-        uint32_t wrote_bytes = (uint32_t) (after - start);
-        desc.section_count++;
-        desc.component_mask |= (1u << c->id);
-        ROGUE_LOG_DEBUG("finished component id=%d size_with_header=%u section_count=%u mask=0x%X "
-                        "reused=%u written=%u",
-                        c->id, wrote_bytes, desc.section_count, desc.component_mask,
-                        g_last_sections_reused, g_last_sections_written);
-    } /* end for each component */
+    }
     /* After a full save in incremental mode, all components become clean (unless marked during
      * write) so subsequent save can reuse */
     if (g_incremental_enabled)
     {
+        cap->dirty_mask |= g_dirty_mask;
         g_dirty_mask = 0;
     }
-    /* Marks end of payload (excludes integrity footers) */
-    long payload_end = ftell(f);
-    /* Compute descriptor CRC (over payload only) */
-    size_t crc_region = (size_t) (payload_end - (long) sizeof desc);
-    unsigned char* crc_buf = NULL;
-    uint32_t crc = 0;
-    if (crc_region > 0)
+    return 0;
+}
+
+/* Assemble the complete save image (descriptor, sections, integrity footers) in memory. Reads only
+ * the capture, so it is safe to run off the main thread. */
+int rogue__save_encode(RogueSaveCapture* cap)
+{
+    RogueSaveBuffer* out = &cap->image;
+    RogueSaveDescriptor desc = cap->desc;
+    size_t predicted = sizeof desc + 64;
+    for (int i = 0; i < cap->section_count; i++)
+        predicted += cap->sections[i].payload.len + 16;
+    if (rogue_save_buffer_reserve(out, predicted) != 0 ||
+        rogue_save_buffer_append(out, &desc, sizeof desc) != 0)
+        return -3;
+    RogueSaveBuffer scratch;
+    rogue_save_buffer_init(&scratch);
+    int rc = 0;
+    for (int i = 0; i < cap->section_count && rc == 0; i++)
     {
-        crc_buf = (unsigned char*) malloc(crc_region);
-        if (!crc_buf)
+        RogueSaveCapturedSection* s = &cap->sections[i];
+        size_t start = out->len;
+        uint16_t id16 = (uint16_t) s->id;
+        uint32_t size_placeholder32 = 0;
+        if (rogue_save_buffer_append(out, &id16, sizeof id16) != 0 ||
+            rogue_save_buffer_append(out, &size_placeholder32, sizeof size_placeholder32) != 0)
         {
-            fclose(f);
-            return -13;
+            rc = -4;
+            break;
         }
-        fseek(f, sizeof desc, SEEK_SET);
-        if (fread(crc_buf, 1, crc_region, f) != crc_region)
+        size_t payload_start = out->len;
+        const unsigned char* stored = s->payload.data;
+        size_t stored_len = s->payload.len;
+        uint32_t usz = (uint32_t) s->payload.len;
+        if (!s->reused)
         {
-            free(crc_buf);
-            fclose(f);
-            return -13;
+            s->compressed = 0;
+            s->codec = -1;
+            s->raw_bytes = usz;
+            s->encode_ms = 0.0;
+            if (desc.version >= 6 && cap->compress_enabled && s->payload.len > 0 &&
+                usz >= (uint32_t) cap->compress_min_bytes)
+            {
+                /* Stored form: [uint32 uncompressed_size][v10: uint8 codec][codec body] */
+                double t0 = (double) clock();
+                scratch.len = 0;
+                if (rogue_save_buffer_append(&scratch, &usz, sizeof usz) != 0 ||
+                    rogue_save_codec_encode(desc.version, cap->compress_codec,
+                                            cap->compress_level, s->payload.data, s->payload.len,
+                                            &scratch) != 0)
+                {
+                    rc = -5;
+                    break;
+                }
+                s->encode_ms = ((double) clock() - t0) * 1000.0 / (double) CLOCKS_PER_SEC;
+                if (scratch.len < (size_t) usz)
+                {
+                    stored = scratch.data;
+                    stored_len = scratch.len;
+                    s->compressed = 1;
+                    s->codec = desc.version >= 10 ? cap->compress_codec : ROGUE_SAVE_CODEC_RLE;
+                }
+            }
         }
-        crc = rogue_crc32(crc_buf, crc_region);
-    }
-    else
-    {
-        /* No sections written; define checksum of empty payload as 0 for stability */
-        crc = 0u;
+        if (rogue_save_buffer_append(out, stored, stored_len) != 0)
+        {
+            rc = -5;
+            break;
+        }
+        s->image_offset = payload_start;
+        s->stored_size = (uint32_t) (out->len - payload_start);
+        uint32_t header_size_field = s->stored_size | (s->compressed ? 0x80000000u : 0u);
+        rogue_save_buffer_patch(out, start + sizeof(uint16_t), &header_size_field,
+                                sizeof header_size_field);
+        if (desc.version >= 7)
+        {
+            if (!s->reused)
+                s->crc32 = rogue_crc32(out->data + payload_start, s->stored_size);
+            if (rogue_save_buffer_append(out, &s->crc32, sizeof s->crc32) != 0)
+            {
+                rc = -14;
+                break;
+            }
+        }
+        desc.section_count++;
+        desc.component_mask |= (1u << s->id);
     }
-    desc.checksum = crc; /* rogue_crc32 returns final xor */
+    rogue_save_buffer_free(&scratch);
+    if (rc != 0)
+        return rc;
+    /* Descriptor CRC covers the payload only (excludes integrity footers); the region is read
+     * straight out of the image buffer. Empty payload checksums to 0 for stability. */
+    size_t crc_region = out->len - sizeof desc;
+    desc.checksum = crc_region > 0 ? rogue_crc32(out->data + sizeof desc, crc_region) : 0u;
     /* SHA256 footer (v7+) over same region */
     if (desc.version >= 7)
     {
         RogueSHA256Ctx sha;
         rogue_sha256_init(&sha);
-        if (crc_region > 0 && crc_buf)
+        if (crc_region > 0)
         {
-            rogue_sha256_update(&sha, crc_buf, crc_region);
+            rogue_sha256_update(&sha, out->data + sizeof desc, crc_region);
         }
         /* else: digest of empty payload */
-        unsigned char digest[32];
-        rogue_sha256_final(&sha, digest);
-        memcpy(g_last_sha256, digest, 32);
+        rogue_sha256_final(&sha, cap->sha256);
         const char magic[4] = {'S', 'H', '3', '2'};
-        fseek(f, 0, SEEK_END);
-        fwrite(magic, 1, 4, f);
-        fwrite(digest, 1, 32, f);
-        /* Optional signature (v9+) signs payload + SHA footer */
-        if (desc.version >= 9 && g_sig_provider)
-        { /* Signature covers payload + SHA footer */
-            size_t total_for_sig = crc_region + 4 + 32;
-            unsigned char* sig_src = (unsigned char*) malloc(total_for_sig);
-            if (!sig_src)
-            {
-                if (crc_buf)
-                    free(crc_buf);
-                fclose(f);
-                return -16;
-            }
-            if (crc_region > 0 && crc_buf)
-                memcpy(sig_src, crc_buf, crc_region);
-            /* Append SH32 + digest */
-            memcpy(sig_src + crc_region, "SH32", 4);
-            memcpy(sig_src + crc_region + 4, digest, 32);
+        if (rogue_save_buffer_append(out, magic, 4) != 0 ||
+            rogue_save_buffer_append(out, cap->sha256, 32) != 0)
+            return -13;
+        /* Optional signature (v9+): payload + SHA footer are already contiguous in the image */
+        if (desc.version >= 9 && cap->sig_provider)
+        {
             unsigned char sigbuf[1024];
             uint32_t slen = sizeof sigbuf;
-            if (g_sig_provider->sign(sig_src, (size_t) total_for_sig, sigbuf, &slen) != 0)
-            {
-                free(sig_src);
-                if (crc_buf)
-                    free(crc_buf);
-                fclose(f);
+            if (cap->sig_provider->sign(out->data + sizeof desc, crc_region + 4 + 32, sigbuf,
+                                        &slen) != 0)
                 return -16;
-            }
-            free(sig_src);
             const char smagic[4] = {'S', 'G', 'N', '0'};
-            fwrite(&slen, sizeof(uint16_t), 1, f);
-            fwrite(smagic, 1, 4, f);
-            fwrite(sigbuf, 1, slen, f);
+            uint16_t slen16 = (uint16_t) slen;
+            if (rogue_save_buffer_append(out, &slen16, sizeof slen16) != 0 ||
+                rogue_save_buffer_append(out, smagic, 4) != 0 ||
+                rogue_save_buffer_append(out, sigbuf, slen) != 0)
+                return -16;
         }
     }
-    long file_end = ftell(f);
-    desc.total_size = (uint64_t) file_end;
-    if (crc_buf)
-        free(crc_buf);
+    desc.total_size = (uint64_t) out->len;
     /* Rewrite descriptor with final fields */
-    fseek(f, 0, SEEK_SET);
-    fwrite(&desc, sizeof desc, 1, f);
-    fflush(f);
-#if defined(_WIN32)
-    if (g_durable_writes)
+    rogue_save_buffer_patch(out, 0, &desc, sizeof desc);
+    cap->desc = desc;
+    return 0;
+}
+
+/* Write a finished image to path in one call (plus optional fsync/_commit). */
+static int write_image_file(const char* path, const RogueSaveBuffer* img, int durable)
+{
+    FILE* f = NULL;
+#if defined(_MSC_VER)
+    fopen_s(&f, path, "wb");
+#else
+    f = fopen(path, "wb");
+#endif
+    if (!f)
+        return -2;
+    /* Unbuffered: the whole image goes out in a single write call */
+    setvbuf(f, NULL, _IONBF, 0);
+    int ok = fwrite(img->data, 1, img->len, f) == img->len;
+    if (ok && durable)
     {
+#if defined(_WIN32)
         int fd = _fileno(f);
         if (fd != -1)
             _commit(fd);
-    }
 #else
-    if (g_durable_writes)
-    {
         int fd = fileno(f);
         if (fd != -1)
             fsync(fd);
+#endif
     }
+    if (fclose(f) != 0)
+        ok = 0;
+    return ok ? 0 : -3;
+}
+
+int rogue__save_write_image(const char* final_path, const RogueSaveCapture* cap)
+{
+    /* Unique temp path to avoid collisions under parallel test processes */
+    char tmp_path[160];
+#if defined(_WIN32)
+    unsigned pid = (unsigned) _getpid();
+#else
+    unsigned pid = (unsigned) getpid();
 #endif
-    fclose(f);
-    /* Move tmp to final and verify success. If move/copy fails, return error. */
-    int finalize_ok = 0;
-#if defined(_MSC_VER)
-    /* Best-effort atomic replacement. If rename fails (e.g., anti-virus locking),
-       retry after removing destination; if still failing, fall back to copy. */
-    remove(final_path);
-    if (rename(tmp_path, final_path) == 0)
+    unsigned t = (unsigned) time(NULL);
+    unsigned clk = (unsigned) clock();
+    snprintf(tmp_path, sizeof tmp_path, "./tmp_save_%u_%u_%u.tmp", t, pid, clk);
+    int rc = write_image_file(tmp_path, &cap->image, cap->durable);
+    if (rc != 0)
     {
-        finalize_ok = 1;
+        remove(tmp_path);
+        return rc;
     }
-    else
+#if defined(_MSC_VER)
+    /* Best-effort atomic replacement: rename fails on Windows if destination exists. */
+    remove(final_path);
+#endif
+    if (rename(tmp_path, final_path) != 0)
     {
-        FILE* src = NULL;
-        FILE* dst = NULL;
-        if (fopen_s(&src, tmp_path, "rb") == 0 && src && fopen_s(&dst, final_path, "wb") == 0 &&
-            dst)
-        {
-            unsigned char buf[8192];
-            size_t n;
-            int copy_failed = 0;
-            while ((n = fread(buf, 1, sizeof buf, src)) > 0)
-            {
-                if (fwrite(buf, 1, n, dst) != n)
-                {
-                    copy_failed = 1;
-                    break;
-                }
-            }
-            fflush(dst);
-            if (g_durable_writes)
-            {
-                int dfd = _fileno(dst);
-                if (dfd != -1)
-                    _commit(dfd);
-            }
-            fclose(src);
-            fclose(dst);
-            if (!copy_failed)
-            {
-                finalize_ok = 1;
-                remove(tmp_path);
-            }
-        }
-        else
-        {
-            if (src)
-                fclose(src);
-            if (dst)
-                fclose(dst);
-            /* leave tmp file for debugging */
-        }
+        /* Rename can fail (anti-virus locking, cross-device setups); the image is still in
+         * memory so write it to the destination directly instead of copying. */
+        if (write_image_file(final_path, &cap->image, cap->durable) != 0)
+            return -21; /* leave tmp file for debugging */
+        remove(tmp_path);
     }
-#else
-    if (rename(tmp_path, final_path) == 0)
+    return 0;
+}
+
+void rogue__save_commit(RogueSaveCapture* cap, int rc, double ms)
+{
+    g_last_save_rc = rc;
+    g_last_save_ms = ms;
+    if (rc != 0)
     {
-        finalize_ok = 1;
+        /* nothing reached disk: components captured as dirty must be written again next time */
+        g_dirty_mask |= cap->dirty_mask;
+        return;
     }
-    else
+    g_last_save_bytes = (uint32_t) cap->desc.total_size;
+    if (cap->desc.version >= 7)
+        memcpy(g_last_sha256, cap->sha256, 32);
+    for (int i = 0; i < cap->section_count; i++)
     {
-        /* Fallback to copy if rename failed (e.g., cross-device move in unusual setups) */
-        FILE* src = fopen(tmp_path, "rb");
-        FILE* dst = fopen(final_path, "wb");
-        if (src && dst)
-        {
-            unsigned char buf[8192];
-            size_t n;
-            int copy_failed = 0;
-            while ((n = fread(buf, 1, sizeof buf, src)) > 0)
-            {
-                if (fwrite(buf, 1, n, dst) != n)
-                {
-                    copy_failed = 1;
-                    break;
-                }
-            }
-            fflush(dst);
-            if (g_durable_writes)
-            {
-                int dfd = fileno(dst);
-                if (dfd != -1)
-                    fsync(dfd);
-            }
-            fclose(src);
-            fclose(dst);
-            if (!copy_failed)
-            {
-                finalize_ok = 1;
-                remove(tmp_path);
-            }
-        }
-        else
+        const RogueSaveCapturedSection* s = &cap->sections[i];
+        RogueSaveCodecStats* st = s->reused ? NULL : rogue__save_codec_stats_slot(s->id);
+        if (st)
         {
-            if (src)
-                fclose(src);
-            if (dst)
-                fclose(dst);
+            st->codec = s->compressed ? s->codec : -1;
+            st->raw_bytes = s->raw_bytes;
+            st->stored_bytes = s->stored_size;
+            st->encode_ms = s->encode_ms;
         }
     }
-#endif
-    /* Verify final file exists and is readable */
-    if (finalize_ok)
+    /* Refresh incremental cache from the stored forms (skip if incremental was switched off
+     * while a background save was in flight) */
+    if (cap->incremental && g_incremental_enabled && cap->desc.version >= 7)
     {
-        FILE* vf = NULL;
-#if defined(_MSC_VER)
-        fopen_s(&vf, final_path, "rb");
-#else
-        vf = fopen(final_path, "rb");
-#endif
-        if (vf)
-        {
-            fclose(vf);
-        }
-        else
+        for (int i = 0; i < cap->section_count; i++)
         {
-            finalize_ok = 0;
+            const RogueSaveCapturedSection* s = &cap->sections[i];
+            if (!s->reused)
+                cache_section_payload(s->id, cap->image.data + s->image_offset, s->stored_size,
+                                      s->crc32, s->compressed);
         }
     }
-    int rc = finalize_ok ? 0 : -21;
-    g_last_save_rc = rc;
-    g_last_save_bytes = (uint32_t) desc.total_size;
-    g_last_save_ms = ((double) clock() - t0) * 1000.0 / (double) CLOCKS_PER_SEC;
+}
+
+static int internal_save_to(const char* final_path)
+{
+    if (g_in_save)
+        return -99;
+    rogue__save_async_drain(); /* keep ordering with any background autosave */
+    g_in_save = 1;
+    double t0 = (double) clock();
+    RogueSaveCapture* cap = (RogueSaveCapture*) malloc(sizeof *cap);
+    if (!cap)
+    {
+        g_in_save = 0;
+        return -2;
+    }
+    int rc = rogue__save_capture(cap);
+    g_save_last_capture_ms = ((double) clock() - t0) * 1000.0 / (double) CLOCKS_PER_SEC;
+    if (rc == 0)
+        rc = rogue__save_encode(cap);
+    if (rc == 0)
+        rc = rogue__save_write_image(final_path, cap);
+    rogue__save_commit(cap, rc, ((double) clock() - t0) * 1000.0 / (double) CLOCKS_PER_SEC);
+    rogue__save_capture_free(cap);
+    free(cap);
     g_in_save = 0;
     return rc;
 }
@@ -1225,6 +1057,14 @@ int rogue_save_export_json(int slot_index, char* out, size_t out_cap)
     return 0;
 }
 
+/* Hand an in-memory section payload to a component read callback. */
+static int dispatch_section(const RogueSaveComponent* comp, const unsigned char* data, size_t len)
+{
+    RogueSaveReader in;
+    rogue_save_reader_init(&in, data, len);
+    return comp->read_fn(&in, len);
+}
+
 int rogue_save_reload_component_from_slot(int slot_index, int component_id)
 {
     if (slot_index < 0 || slot_index >= ROGUE_SAVE_SLOT_COUNT)
@@ -1279,87 +1119,26 @@ int rogue_save_reload_component_from_slot(int slot_index, int component_id)
             /* Prepare uncompressed bytes (decompress if necessary) */
             unsigned char* udata = NULL;
             size_t ulen = 0;
-            int free_udata = 0;
+            RogueSaveBuffer dec;
+            rogue_save_buffer_init(&dec);
             if (compressed)
             {
-                if (stored_size < sizeof(uint32_t))
-                {
-                    free(buf);
-                    return -4;
-                }
-                uint32_t uncompressed_size = 0;
-                memcpy(&uncompressed_size, p, 4);
-                if (uncompressed_size > (16u * 1024u * 1024u))
-                { /* sanity cap 16MB */
-                    free(buf);
-                    return -4;
-                }
-                uint32_t comp_bytes = stored_size - 4;
-                const unsigned char* csrc = p + 4;
-                unsigned char* out = (unsigned char*) malloc(uncompressed_size);
-                if (!out)
+                if (rogue_save_codec_decode(d.version, p, stored_size, &dec, NULL) != 0)
                 {
+                    rogue_save_buffer_free(&dec);
                     free(buf);
                     return -4;
                 }
-                size_t ci = 0;
-                size_t ui = 0;
-                while (ci < comp_bytes && ui < uncompressed_size)
-                {
-                    unsigned char b = csrc[ci++];
-                    if (ci >= comp_bytes)
-                        break;
-                    unsigned char run = csrc[ci++];
-                    for (int r = 0; r < run && ui < uncompressed_size; r++)
-                    {
-                        out[ui++] = b;
-                    }
-                }
-                udata = out;
-                ulen = ui;
-                free_udata =
-                    1; /* ui may be < uncompressed_size if truncated; still feed what we have */
+                udata = dec.data;
+                ulen = dec.len;
             }
             else
             {
                 udata = p;
                 ulen = stored_size;
             }
-            /* Feed through temp FILE* to reuse component read_fn contract */
-            char tmp[64];
-            snprintf(tmp, sizeof tmp, "_tmp_section_%d.bin", component_id);
-            FILE* tf = NULL;
-#if defined(_MSC_VER)
-            fopen_s(&tf, tmp, "wb");
-#else
-            tf = fopen(tmp, "wb");
-#endif
-            if (!tf)
-            {
-                if (free_udata)
-                    free(udata);
-                free(buf);
-                return -4;
-            }
-            fwrite(udata, 1, ulen, tf);
-            fclose(tf);
-#if defined(_MSC_VER)
-            fopen_s(&tf, tmp, "rb");
-#else
-            tf = fopen(tmp, "rb");
-#endif
-            if (!tf)
-            {
-                if (free_udata)
-                    free(udata);
-                free(buf);
-                return -4;
-            }
-            comp->read_fn(tf, (uint32_t) ulen);
-            fclose(tf);
-            remove(tmp);
-            if (free_udata)
-                free(udata);
+            dispatch_section(comp, udata, ulen);
+            rogue_save_buffer_free(&dec);
             applied = 0; /* success */
             /* Advance pointer past payload */
         }
@@ -1377,6 +1156,59 @@ int rogue_save_reload_component_from_slot(int slot_index, int component_id)
     return applied;
 }
 
+static int decode_sink_buffer(const unsigned char* data, size_t len, void* user)
+{
+    return rogue_save_buffer_append((RogueSaveBuffer*) user, data, len);
+}
+
+/* Stream a compressed section body from f in fixed-size chunks, decoding into out; the compressed
+ * section is never held in memory as a whole. */
+static int stream_decode_section(FILE* f, uint32_t comp_bytes, int codec, uint32_t usz,
+                                 RogueSaveBuffer* out)
+{
+    RogueSaveDecodeStream* ds = (RogueSaveDecodeStream*) malloc(sizeof *ds);
+    if (!ds)
+        return -1;
+    if (rogue_save_decode_stream_init(ds, codec, usz, decode_sink_buffer, out) != 0)
+    {
+        free(ds);
+        return -1;
+    }
+    unsigned char chunk[8192];
+    int rc = 0;
+    while (comp_bytes > 0 && rc == 0)
+    {
+        size_t want = comp_bytes < sizeof chunk ? comp_bytes : sizeof chunk;
+        if (fread(chunk, 1, want, f) != want)
+            rc = -1;
+        else
+            rc = rogue_save_decode_stream_feed(ds, chunk, want);
+        comp_bytes -= (uint32_t) want;
+    }
+    if (rc == 0)
+        rc = rogue_save_decode_stream_finish(ds);
+    if (rc == 0 && codec == ROGUE_SAVE_CODEC_LZ && out->len != usz)
+        rc = -1;
+    free(ds);
+    return rc;
+}
+
+/* Read an uncompressed section payload from f into a fresh allocation (caller frees). Returns
+ * NULL if fewer than size bytes remain before file_end. */
+static unsigned char* read_section_payload(FILE* f, uint32_t size, long file_end)
+{
+    long pos = ftell(f);
+    if (pos < 0 || pos > file_end || (uint64_t) size > (uint64_t) (file_end - pos))
+        return NULL;
+    unsigned char* data = (unsigned char*) malloc(size ? size : 1);
+    if (data && fread(data, 1, size, f) != size)
+    {
+        free(data);
+        return NULL;
+    }
+    return data;
+}
+
 int rogue_save_manager_load_slot(int slot_index)
 {
     if (slot_index < 0 || slot_index >= ROGUE_SAVE_SLOT_COUNT)
@@ -1645,92 +1477,69 @@ int rogue_save_manager_load_slot(int slot_index)
             int compressed = (desc.version >= 6 && (size & 0x80000000u));
             uint32_t stored_size = size & 0x7FFFFFFFu;
             const RogueSaveComponent* comp = rogue_find_component((int) id);
-            long payload_pos = ftell(f);
+            unsigned char* raw = NULL; /* uncompressed payload, kept for the v7 section CRC */
             if (compressed)
             {
                 uint32_t uncompressed_size = 0;
-                if (fread(&uncompressed_size, sizeof uncompressed_size, 1, f) != 1)
+                unsigned char codec = ROGUE_SAVE_CODEC_RLE; /* implied before v10 */
+                uint32_t hdr = (uint32_t) rogue_save_codec_header_bytes(desc.version);
+                if (stored_size < hdr ||
+                    fread(&uncompressed_size, sizeof uncompressed_size, 1, f) != 1 ||
+                    (desc.version >= 10 && fread(&codec, 1, 1, f) != 1))
                 {
                     fclose(f);
                     return -11;
                 }
-                uint32_t comp_bytes = stored_size - sizeof(uint32_t);
-                unsigned char* cbuf = (unsigned char*) malloc(comp_bytes);
-                if (!cbuf)
-                {
-                    fclose(f);
-                    return -12;
-                }
-                if (fread(cbuf, 1, comp_bytes, f) != comp_bytes)
-                {
-                    free(cbuf);
-                    fclose(f);
-                    return -12;
-                }
-                unsigned char* ubuf = (unsigned char*) malloc(uncompressed_size);
-                if (!ubuf)
+                uint32_t comp_bytes = stored_size - hdr;
+                if (!comp || !comp->read_fn)
                 {
-                    free(cbuf);
-                    fclose(f);
-                    return -12;
+                    fseek(f, (long) comp_bytes, SEEK_CUR);
                 }
-                /* RLE decode */
-                size_t ci = 0;
-                size_t ui = 0;
-                while (ci < comp_bytes && ui < uncompressed_size)
-                {
-                    unsigned char b = cbuf[ci++];
-                    if (ci >= comp_bytes)
-                    {
-                        break;
-                    }
-                    unsigned char run = cbuf[ci++];
-                    for (int r = 0; r < run && ui < uncompressed_size; r++)
-                    {
-                        ubuf[ui++] = b;
-                    }
-                }
-                /* feed via temp file to existing read_fn expecting FILE* */
-                if (comp && comp->read_fn)
+                else
                 {
-                    FILE* mf = NULL;
-#if defined(_MSC_VER)
-                    tmpfile_s(&mf);
-#else
-                    mf = tmpfile();
-#endif
-                    if (!mf)
+                    RogueSaveBuffer dec;
+                    rogue_save_buffer_init(&dec);
+                    double t0 = (double) clock();
+                    if (stream_decode_section(f, comp_bytes, codec, uncompressed_size, &dec) != 0)
                     {
-                        free(cbuf);
-                        free(ubuf);
+                        rogue_save_buffer_free(&dec);
                         fclose(f);
                         return -12;
                     }
-                    /* Write only the bytes we actually decoded */
-                    fwrite(ubuf, 1, ui, mf);
-                    fflush(mf);
-                    fseek(mf, 0, SEEK_SET);
-                    if (comp->read_fn(mf, ui) != 0)
+                    RogueSaveCodecStats* st = rogue__save_codec_stats_slot((int) id);
+                    if (st)
+                    {
+                        st->codec = codec;
+                        st->raw_bytes = (uint32_t) dec.len;
+                        st->stored_bytes = stored_size;
+                        st->decode_ms =
+                            ((double) clock() - t0) * 1000.0 / (double) CLOCKS_PER_SEC;
+                    }
+                    int rrc = dispatch_section(comp, dec.data, dec.len);
+                    rogue_save_buffer_free(&dec);
+                    if (rrc != 0)
                     {
-                        fclose(mf);
-                        free(cbuf);
-                        free(ubuf);
                         fclose(f);
                         return -9;
                     }
-                    fclose(mf);
                 }
-                free(cbuf);
-                free(ubuf); /* file already positioned just after compressed payload */
+                /* file already positioned just after compressed payload */
             }
             else
             {
+                raw = read_section_payload(f, stored_size, file_end);
+                if (!raw)
+                {
+                    fclose(f);
+                    return -12;
+                }
                 if (comp && comp->read_fn)
                 {
                     ROGUE_LOG_DEBUG("load_slot dispatch id=%u size=%u compressed=0", id,
                                     stored_size);
-                    if (comp->read_fn(f, stored_size) != 0)
+                    if (dispatch_section(comp, raw, stored_size) != 0)
                     {
+                        free(raw);
                         fclose(f);
                         return -9;
                     }
@@ -1739,52 +1548,27 @@ int rogue_save_manager_load_slot(int slot_index)
                 {
                     ROGUE_LOG_DEBUG("load_slot skip id=%u (no comp) size=%u", id, stored_size);
                 }
-                fseek(f, payload_pos + stored_size, SEEK_SET);
             }
             if (desc.version >= 7)
             { /* read and verify per-section CRC of uncompressed payload */
-                /* We captured uncompressed bytes only for compressed path; for uncompressed, we
-                 * must re-read */
-                long end_after_payload = ftell(f);
                 uint32_t sec_crc = 0;
                 if (fread(&sec_crc, sizeof sec_crc, 1, f) != 1)
                 {
+                    free(raw);
                     fclose(f);
                     return -10;
                 }
                 ROGUE_LOG_DEBUG("load_slot section id=%u crc=0x%08X", id, sec_crc);
-                /* Reconstruct uncompressed bytes */
-                if (compressed)
-                { /* Skipping deep verify for compressed section (future enhancement) */
-                    (void) payload_pos;
-                }
-                else
+                /* Skipping deep verify for compressed sections (future enhancement) */
+                if (raw && rogue_crc32(raw, stored_size) != sec_crc)
                 {
-                    long payload_size = stored_size;
-                    unsigned char* tmp = (unsigned char*) malloc((size_t) payload_size);
-                    if (!tmp)
-                    {
-                        fclose(f);
-                        return -12;
-                    }
-                    fseek(f, payload_pos, SEEK_SET);
-                    if (fread(tmp, 1, (size_t) payload_size, f) != (size_t) payload_size)
-                    {
-                        free(tmp);
-                        fclose(f);
-                        return -12;
-                    }
-                    uint32_t calc = rogue_crc32(tmp, (size_t) payload_size);
-                    free(tmp);
-                    fseek(f, end_after_payload + 4, SEEK_SET);
-                    if (calc != sec_crc)
-                    {
-                        g_last_tamper_flags |= ROGUE_TAMPER_FLAG_SECTION_CRC;
-                        fclose(f);
-                        return ROGUE_SAVE_ERR_SECTION_CRC;
-                    }
+                    g_last_tamper_flags |= ROGUE_TAMPER_FLAG_SECTION_CRC;
+                    free(raw);
+                    fclose(f);
+                    return ROGUE_SAVE_ERR_SECTION_CRC;
                 }
             }
+            free(raw);
         }
     }
     else
@@ -1804,16 +1588,19 @@ int rogue_save_manager_load_slot(int slot_index)
                 return -8;
             }
             const RogueSaveComponent* comp = rogue_find_component((int) id);
-            long payload_pos = ftell(f);
-            if (comp && comp->read_fn)
+            unsigned char* raw = read_section_payload(f, size, file_end);
+            if (!raw)
             {
-                if (comp->read_fn(f, size) != 0)
-                {
-                    fclose(f);
-                    return -9;
-                }
+                fclose(f);
+                return -12;
+            }
+            if (comp && comp->read_fn && dispatch_section(comp, raw, size) != 0)
+            {
+                free(raw);
+                fclose(f);
+                return -9;
             }
-            fseek(f, payload_pos + size, SEEK_SET);
+            free(raw);
         }
     }
     /* Finalize by syncing loot app view (helpful for headless/tests). */
@@ -1906,29 +1693,10 @@ int rogue_save_manager_load_slot_with_recovery(int slot_index)
                 return rc;
             }
             const RogueSaveComponent* comp = rogue_find_component((int) id16);
-            if (comp && comp->read_fn)
-            { /* feed via temp */
-                FILE* tf = NULL;
-#if defined(_MSC_VER)
-                tmpfile_s(&tf);
-#else
-                tf = tmpfile();
-#endif
-                if (!tf)
-                {
-                    free(buf);
-                    return rc;
-                }
-                fwrite(p, 1, size, tf);
-                fflush(tf);
-                fseek(tf, 0, SEEK_SET);
-                if (comp->read_fn(tf, size) != 0)
-                {
-                    fclose(tf);
-                    free(buf);
-                    return rc;
-                }
-                fclose(tf);
+            if (comp && comp->read_fn && dispatch_section(comp, p, size) != 0)
+            {
+                free(buf);
+                return rc;
             }
             p += size;
             if (d.version >= 7)
@@ -1,5 +1,6 @@
 #ifndef ROGUE_SAVE_MANAGER_H
 #define ROGUE_SAVE_MANAGER_H
+#include "save_utils.h"
 #include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -12,10 +13,10 @@
 
 /* Current binary save format version */
 #define ROGUE_SAVE_FORMAT_VERSION                                                                  \
-    9u /* v3: TLV headers (uint16 id + uint32 size); v4: varint counts/ids in section payloads;    \
+    10u /* v3: TLV headers (uint16 id + uint32 size); v4: varint counts/ids in section payloads;   \
           v5: string interning; v6: optional per-section compression; v7: per-section CRC32 +      \
           overall SHA256 footer; v8: replay hash + tamper recovery; v9: optional signature trailer \
-        */
+          v10: per-section codec id (RLE / LZ) */
 
 /* Component identifiers (stable) */
 typedef enum RogueSaveComponentId
@@ -60,14 +61,16 @@ typedef struct RogueSaveDescriptor
    gameplay-critical input events (frame, action, value) + event count for deterministic divergence
    checks (UI state excluded) v9: Optional signature trailer (if registered) appended after SHA256
    footer: [uint16 sig_len]["SGN0"][sig_len raw bytes]; descriptor checksum excludes SHA+signature
-   footers */
+   footers v10: Compressed sections carry a codec id byte after the uncompressed size prefix:
+   [uint32 uncompressed_size][uint8 codec][body] (0 = v6 RLE, 1 = LZ4-style block); older versions
+   imply RLE */
 
 /* Component callback interface */
 typedef struct RogueSaveComponent
 {
     int id;                               /* RogueSaveComponentId */
-    int (*write_fn)(FILE* f);             /* returns 0 on success */
-    int (*read_fn)(FILE* f, size_t size); /* size is section payload */
+    int (*write_fn)(RogueSaveBuffer* out);           /* appends the section payload; 0 on success */
+    int (*read_fn)(RogueSaveReader* in, size_t size); /* in holds exactly size payload bytes */
     const char* name;
 } RogueSaveComponent;
 
@@ -113,6 +116,17 @@ int rogue_save_set_autosave_throttle_ms(
     int ms); /* minimum gap after any save before next autosave */
 int rogue_save_status_string(char* buf, size_t cap); /* formatted status summary (UI indicator) */
 
+/* Asynchronous autosave: components are snapshotted on the calling thread, then compression,
+ * hashing and the durable write run on a worker. Results (rc/bytes/ms) are published through the
+ * accessors above once rogue_save_async_poll (or the scheduler) observes completion. */
+int rogue_save_set_async(int enabled); /* scheduler autosaves go async when enabled (default) */
+int rogue_save_manager_autosave_async(int slot_index); /* ROGUE_SAVE_ERR_BUSY if one in flight */
+int rogue_save_async_pending(void);                   /* 1 while a background save is in flight */
+int rogue_save_async_poll(void); /* publish finished background save; returns 1 if one completed */
+int rogue_save_async_wait(void); /* block until in-flight save completes; returns its rc */
+uint32_t rogue_save_async_completed_count(void);
+double rogue_save_last_capture_ms(void); /* in-frame (snapshot) portion of the last save */
+
 /* Migration metrics (Phase 2.4) */
 int rogue_save_last_migration_steps(void);  /* number of successful version bumps in last load */
 int rogue_save_last_migration_failed(void); /* 1 if a migration apply_fn failed */
@@ -141,6 +155,29 @@ int rogue_save_intern_count(void);
 int rogue_save_set_compression(
     int enabled, int min_bytes); /* enable and set minimum payload size to consider compression */
 
+/* Section codecs (v10). A section is stored compressed only if that makes it smaller. */
+typedef enum RogueSaveCodecId
+{
+    ROGUE_SAVE_CODEC_RLE = 0, /* legacy v6 (byte,run) pairs */
+    ROGUE_SAVE_CODEC_LZ = 1   /* LZ4-style block, 64 KiB window (default) */
+} RogueSaveCodecId;
+int rogue_save_set_compression_codec(int codec); /* RogueSaveCodecId; -1 if unknown */
+int rogue_save_set_compression_level(int level); /* LZ effort 1 (fastest) .. 9 (smallest) */
+
+/* Per-component codec metrics from the most recent save (encode) and load (decode) of each
+ * section. codec is -1 when the section was stored uncompressed. */
+typedef struct RogueSaveCodecStats
+{
+    int component_id;
+    int codec;
+    uint32_t raw_bytes;
+    uint32_t stored_bytes; /* section payload on disk (including the compression prefix) */
+    double encode_ms;
+    double decode_ms;
+} RogueSaveCodecStats;
+int rogue_save_codec_stats(int component_id,
+                           RogueSaveCodecStats* out); /* 0 if the component has stats */
+
 /* Endianness / numeric width assertion helper (Phase 3.3) */
 int rogue_save_format_endianness_is_le(void); /* returns 1 if little-endian (required). */
 
@@ -165,6 +202,7 @@ uint32_t rogue_save_last_replay_event_count(void);
 #define ROGUE_SAVE_ERR_MIGRATION_CHAIN -21
 #define ROGUE_SAVE_ERR_SECTION_CRC -22
 #define ROGUE_SAVE_ERR_SHA256 -23
+#define ROGUE_SAVE_ERR_BUSY -24 /* background autosave still in flight */
 
 /* Tamper flags (Phase 4.3) */
 #define ROGUE_TAMPER_FLAG_DESCRIPTOR_CRC 0x1u
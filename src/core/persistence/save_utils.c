@@ -1,32 +1,93 @@
 #include "save_utils.h"
+#include "save_hash_accel.h"
+#include <stdlib.h>
 #include <string.h>
 
+void rogue_save_buffer_init(RogueSaveBuffer* b)
+{
+    b->data = NULL;
+    b->len = 0;
+    b->cap = 0;
+}
+
+void rogue_save_buffer_free(RogueSaveBuffer* b)
+{
+    free(b->data);
+    rogue_save_buffer_init(b);
+}
+
+int rogue_save_buffer_reserve(RogueSaveBuffer* b, size_t extra)
+{
+    if (b->len + extra <= b->cap)
+        return 0;
+    size_t ncap = b->cap ? b->cap : 4096;
+    while (ncap < b->len + extra)
+        ncap *= 2;
+    unsigned char* nd = (unsigned char*) realloc(b->data, ncap);
+    if (!nd)
+        return -1;
+    b->data = nd;
+    b->cap = ncap;
+    return 0;
+}
+
+int rogue_save_buffer_append(RogueSaveBuffer* b, const void* data, size_t len)
+{
+    if (len == 0)
+        return 0;
+    if (rogue_save_buffer_reserve(b, len) != 0)
+        return -1;
+    memcpy(b->data + b->len, data, len);
+    b->len += len;
+    return 0;
+}
+
+int rogue_save_buffer_patch(RogueSaveBuffer* b, size_t offset, const void* data, size_t len)
+{
+    if (offset + len > b->len)
+        return -1;
+    memcpy(b->data + offset, data, len);
+    return 0;
+}
+
 /* Unsigned LEB128 style varint (7 bits per byte) */
-int rogue_write_varuint(FILE* f, uint32_t v)
+int rogue_save_buffer_write_varuint(RogueSaveBuffer* b, uint32_t v)
 {
+    unsigned char tmp[5];
+    size_t n = 0;
     while (v >= 0x80)
     {
-        unsigned char b = (unsigned char) ((v & 0x7Fu) | 0x80u);
-        if (fwrite(&b, 1, 1, f) != 1)
-            return -1;
+        tmp[n++] = (unsigned char) ((v & 0x7Fu) | 0x80u);
         v >>= 7;
     }
-    unsigned char b = (unsigned char) (v & 0x7Fu);
-    if (fwrite(&b, 1, 1, f) != 1)
+    tmp[n++] = (unsigned char) (v & 0x7Fu);
+    return rogue_save_buffer_append(b, tmp, n);
+}
+
+void rogue_save_reader_init(RogueSaveReader* r, const void* data, size_t len)
+{
+    r->data = (const unsigned char*) data;
+    r->len = data ? len : 0;
+    r->pos = 0;
+}
+
+int rogue_save_reader_read(RogueSaveReader* r, void* out, size_t len)
+{
+    if (len > r->len - r->pos)
         return -1;
+    if (len)
+        memcpy(out, r->data + r->pos, len);
+    r->pos += len;
     return 0;
 }
 
-int rogue_read_varuint(FILE* f, uint32_t* out)
+int rogue_save_reader_read_varuint(RogueSaveReader* r, uint32_t* out)
 {
     uint32_t result = 0;
     int shift = 0;
-    for (int i = 0; i < 5; i++)
+    for (int i = 0; i < 5 && r->pos < r->len; i++)
     {
-        int c = fgetc(f);
-        if (c == EOF)
-            return -1;
-        unsigned char bv = (unsigned char) c;
+        unsigned char bv = r->data[r->pos++];
         result |= (uint32_t) (bv & 0x7F) << shift;
         if (!(bv & 0x80))
         {
@@ -39,26 +100,113 @@ int rogue_read_varuint(FILE* f, uint32_t* out)
     return -1;
 }
 
-/* CRC32 (polynomial 0xEDB88320) */
-uint32_t rogue_crc32(const void* data, size_t len)
+size_t rogue_save_reader_tell(const RogueSaveReader* r) { return r->pos; }
+
+int rogue_save_reader_seek(RogueSaveReader* r, size_t pos)
+{
+    if (pos > r->len)
+        return -1;
+    r->pos = pos;
+    return 0;
+}
+
+/* CRC32 (polynomial 0xEDB88320). Table 0 is the classic byte table; tables 1..7 extend it for
+ * slice-by-8 (eight input bytes per step). Built once on first use. */
+static uint32_t g_crc_tables[8][256];
+static volatile int g_crc_tables_ready = 0;
+static RogueHashBackend g_crc_backend = ROGUE_HASH_BACKEND_AUTO;
+static RogueHashBackend g_sha_backend = ROGUE_HASH_BACKEND_AUTO;
+
+static void crc_tables_init(void)
 {
-    static uint32_t table[256];
-    static int have = 0;
-    if (!have)
+    if (g_crc_tables_ready)
+        return;
+    for (uint32_t i = 0; i < 256; i++)
     {
-        for (uint32_t i = 0; i < 256; i++)
-        {
-            uint32_t c = i;
-            for (int k = 0; k < 8; k++)
-                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : (c >> 1);
-            table[i] = c;
-        }
-        have = 1;
+        uint32_t c = i;
+        for (int k = 0; k < 8; k++)
+            c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : (c >> 1);
+        g_crc_tables[0][i] = c;
     }
-    uint32_t crc = 0xFFFFFFFFu;
-    const unsigned char* p = (const unsigned char*) data;
+    for (uint32_t i = 0; i < 256; i++)
+        for (int t = 1; t < 8; t++)
+            g_crc_tables[t][i] = (g_crc_tables[t - 1][i] >> 8) ^
+                                 g_crc_tables[0][g_crc_tables[t - 1][i] & 0xFF];
+    g_crc_tables_ready = 1;
+}
+
+static uint32_t crc_bytewise(uint32_t crc, const unsigned char* p, size_t len)
+{
     for (size_t i = 0; i < len; i++)
-        crc = table[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+        crc = g_crc_tables[0][(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+    return crc;
+}
+
+static uint32_t crc_slice8(uint32_t crc, const unsigned char* p, size_t len)
+{
+    const uint32_t(*t)[256] = (const uint32_t(*)[256]) g_crc_tables;
+    while (len >= 8)
+    {
+        uint32_t lo, hi; /* save format is little-endian only (Phase 3.3) */
+        memcpy(&lo, p, 4);
+        memcpy(&hi, p + 4, 4);
+        lo ^= crc;
+        crc = t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF] ^ t[5][(lo >> 16) & 0xFF] ^ t[4][lo >> 24] ^
+              t[3][hi & 0xFF] ^ t[2][(hi >> 8) & 0xFF] ^ t[1][(hi >> 16) & 0xFF] ^ t[0][hi >> 24];
+        p += 8;
+        len -= 8;
+    }
+    return crc_bytewise(crc, p, len);
+}
+
+int rogue_crc32_set_backend(RogueHashBackend b)
+{
+    if (b == ROGUE_HASH_BACKEND_AUTO)
+        b = rogue__crc32_hw_available() ? ROGUE_HASH_BACKEND_HW : ROGUE_HASH_BACKEND_SLICE8;
+    if (b == ROGUE_HASH_BACKEND_HW && !rogue__crc32_hw_available())
+        return -1;
+    crc_tables_init();
+    g_crc_backend = b;
+    return 0;
+}
+
+RogueHashBackend rogue_crc32_backend(void)
+{
+    if (g_crc_backend == ROGUE_HASH_BACKEND_AUTO)
+        rogue_crc32_set_backend(ROGUE_HASH_BACKEND_AUTO);
+    return g_crc_backend;
+}
+
+const char* rogue_hash_backend_name(RogueHashBackend b)
+{
+    switch (b)
+    {
+    case ROGUE_HASH_BACKEND_SCALAR:
+        return "scalar";
+    case ROGUE_HASH_BACKEND_SLICE8:
+        return "slice8";
+    case ROGUE_HASH_BACKEND_HW:
+        return "hw";
+    default:
+        return "auto";
+    }
+}
+
+uint32_t rogue_crc32(const void* data, size_t len)
+{
+    RogueHashBackend b = rogue_crc32_backend();
+    const unsigned char* p = (const unsigned char*) data;
+    uint32_t crc = 0xFFFFFFFFu;
+    if (b == ROGUE_HASH_BACKEND_HW && len >= 64)
+    {
+        size_t bulk = len & ~(size_t) 15;
+        crc = rogue__crc32_pclmul(crc, p, bulk);
+        crc = crc_slice8(crc, p + bulk, len - bulk);
+    }
+    else if (b == ROGUE_HASH_BACKEND_SCALAR)
+        crc = crc_bytewise(crc, p, len);
+    else
+        crc = crc_slice8(crc, p, len);
     return crc ^ 0xFFFFFFFFu;
 }
 
@@ -73,7 +221,7 @@ void rogue_sha256_init(RogueSHA256Ctx* c)
     c->buf_len = 0;
 }
 
-static void rogue_sha256_block(RogueSHA256Ctx* c, const unsigned char* p)
+static void rogue_sha256_block(uint32_t hs[8], const unsigned char* p)
 {
     static const uint32_t K[64] = {
         0x428a2f98u, 0x71374491u, 0xb5c0fbcfu, 0xe9b5dba5u, 0x3956c25bu, 0x59f111f1u, 0x923f82a4u,
@@ -98,8 +246,8 @@ static void rogue_sha256_block(RogueSHA256Ctx* c, const unsigned char* p)
         uint32_t s1 = rs_rotr(w[i - 2], 17) ^ rs_rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
         w[i] = w[i - 16] + s0 + w[i - 7] + s1;
     }
-    uint32_t a = c->h[0], b = c->h[1], d = c->h[3], e = c->h[4], f = c->h[5], g = c->h[6],
-             h = c->h[7], cc = c->h[2];
+    uint32_t a = hs[0], b = hs[1], d = hs[3], e = hs[4], f = hs[5], g = hs[6], h = hs[7],
+             cc = hs[2];
     for (int i = 0; i < 64; i++)
     {
         uint32_t S1 = rs_rotr(e, 6) ^ rs_rotr(e, 11) ^ rs_rotr(e, 25);
@@ -117,14 +265,43 @@ static void rogue_sha256_block(RogueSHA256Ctx* c, const unsigned char* p)
         b = a;
         a = temp1 + temp2;
     }
-    c->h[0] += a;
-    c->h[1] += b;
-    c->h[2] += cc;
-    c->h[3] += d;
-    c->h[4] += e;
-    c->h[5] += f;
-    c->h[6] += g;
-    c->h[7] += h;
+    hs[0] += a;
+    hs[1] += b;
+    hs[2] += cc;
+    hs[3] += d;
+    hs[4] += e;
+    hs[5] += f;
+    hs[6] += g;
+    hs[7] += h;
+}
+
+int rogue_sha256_set_backend(RogueHashBackend b)
+{
+    if (b == ROGUE_HASH_BACKEND_AUTO)
+        b = rogue__sha256_hw_available() ? ROGUE_HASH_BACKEND_HW : ROGUE_HASH_BACKEND_SCALAR;
+    if (b == ROGUE_HASH_BACKEND_SLICE8 ||
+        (b == ROGUE_HASH_BACKEND_HW && !rogue__sha256_hw_available()))
+        return -1;
+    g_sha_backend = b;
+    return 0;
+}
+
+RogueHashBackend rogue_sha256_backend(void)
+{
+    if (g_sha_backend == ROGUE_HASH_BACKEND_AUTO)
+        rogue_sha256_set_backend(ROGUE_HASH_BACKEND_AUTO);
+    return g_sha_backend;
+}
+
+static void sha256_blocks(uint32_t h[8], const unsigned char* p, size_t nblocks)
+{
+    if (rogue_sha256_backend() == ROGUE_HASH_BACKEND_HW)
+    {
+        rogue__sha256_blocks_shani(h, p, nblocks);
+        return;
+    }
+    for (size_t i = 0; i < nblocks; i++)
+        rogue_sha256_block(h, p + 64 * i);
 }
 
 void rogue_sha256_update(RogueSHA256Ctx* c, const void* data, size_t len)
@@ -133,6 +310,14 @@ void rogue_sha256_update(RogueSHA256Ctx* c, const void* data, size_t len)
     c->len += len;
     while (len > 0)
     {
+        if (c->buf_len == 0 && len >= 64)
+        { /* hash whole blocks straight from the input */
+            size_t nblocks = len / 64;
+            sha256_blocks(c->h, p, nblocks);
+            p += nblocks * 64;
+            len -= nblocks * 64;
+            continue;
+        }
         size_t space = 64 - c->buf_len;
         size_t take = len < space ? len : space;
         memcpy(c->buf + c->buf_len, p, take);
@@ -141,7 +326,7 @@ void rogue_sha256_update(RogueSHA256Ctx* c, const void* data, size_t len)
         len -= take;
         if (c->buf_len == 64)
         {
-            rogue_sha256_block(c, c->buf);
+            sha256_blocks(c->h, c->buf, 1);
             c->buf_len = 0;
         }
     }
@@ -5,13 +5,26 @@
 #include <stdint.h>
 #include <stdio.h>
 
-/* Compact varint (LEB128-style) helpers used inside section payloads */
-int rogue_write_varuint(FILE* f, uint32_t v);   /* returns 0 on success */
-int rogue_read_varuint(FILE* f, uint32_t* out); /* returns 0 on success */
-
-/* CRC32 (polynomial 0xEDB88320) */
+/* CRC32 (polynomial 0xEDB88320), dispatched to the fastest available backend */
 uint32_t rogue_crc32(const void* data, size_t len);
 
+/* Integrity hash backends. Every backend produces bit-identical CRC32 / SHA256 output; AUTO picks
+ * the fastest one the CPU supports (runtime cpuid detection). Explicit selection is for tests and
+ * throughput benchmarks. */
+typedef enum RogueHashBackend
+{
+    ROGUE_HASH_BACKEND_AUTO = 0,
+    ROGUE_HASH_BACKEND_SCALAR = 1, /* reference: byte-at-a-time CRC table / portable SHA256 */
+    ROGUE_HASH_BACKEND_SLICE8 = 2, /* CRC32 only: slice-by-8 tables (portable) */
+    ROGUE_HASH_BACKEND_HW = 3      /* CRC32: PCLMULQDQ folding; SHA256: SHA-NI */
+} RogueHashBackend;
+
+int rogue_crc32_set_backend(RogueHashBackend b); /* returns -1 if unsupported on this CPU */
+RogueHashBackend rogue_crc32_backend(void);      /* resolved backend (never AUTO) */
+int rogue_sha256_set_backend(RogueHashBackend b); /* SCALAR or HW; -1 if unsupported */
+RogueHashBackend rogue_sha256_backend(void);
+const char* rogue_hash_backend_name(RogueHashBackend b);
+
 /* Minimal SHA256 context (public domain style implementation) */
 typedef struct RogueSHA256Ctx
 {
@@ -25,6 +38,40 @@ void rogue_sha256_init(RogueSHA256Ctx* c);
 void rogue_sha256_update(RogueSHA256Ctx* c, const void* data, size_t len);
 void rogue_sha256_final(RogueSHA256Ctx* c, unsigned char out[32]);
 
+/* Growable in-memory byte buffer. A full save image is assembled here and flushed to disk with a
+ * single write, so section sizes / CRCs are patched in memory instead of via fseek round trips.
+ * Component write callbacks append their payload straight into one of these on every platform. */
+typedef struct RogueSaveBuffer
+{
+    unsigned char* data;
+    size_t len;
+    size_t cap;
+} RogueSaveBuffer;
+
+void rogue_save_buffer_init(RogueSaveBuffer* b);
+void rogue_save_buffer_free(RogueSaveBuffer* b);
+int rogue_save_buffer_reserve(RogueSaveBuffer* b, size_t extra); /* returns 0 on success */
+int rogue_save_buffer_append(RogueSaveBuffer* b, const void* data, size_t len);
+int rogue_save_buffer_patch(RogueSaveBuffer* b, size_t offset, const void* data, size_t len);
+/* Compact varint (LEB128-style) used for counts inside section payloads */
+int rogue_save_buffer_write_varuint(RogueSaveBuffer* b, uint32_t v);
+
+/* Bounds-checked cursor over an in-memory section payload; component read callbacks consume their
+ * section through one of these, so load paths never stage payloads in temp files. Reads past the
+ * end fail without copying anything. */
+typedef struct RogueSaveReader
+{
+    const unsigned char* data;
+    size_t len;
+    size_t pos;
+} RogueSaveReader;
+
+void rogue_save_reader_init(RogueSaveReader* r, const void* data, size_t len);
+int rogue_save_reader_read(RogueSaveReader* r, void* out, size_t len); /* returns 0 on success */
+int rogue_save_reader_read_varuint(RogueSaveReader* r, uint32_t* out);
+size_t rogue_save_reader_tell(const RogueSaveReader* r);
+int rogue_save_reader_seek(RogueSaveReader* r, size_t pos); /* -1 if pos is past the end */
+
 /* Endianness helper */
 int rogue_save_format_endianness_is_le(void);
 
@@ -277,7 +277,7 @@ void rogue_player_assets_ensure_loaded(void)
         for (int d = 0; d < 4; d++)
         {
             const char* path = g_app.player_sheet_path[s][d];
-            if (rogue_texture_load(&g_app.player_tex[s][d], path))
+            if (rogue_texture_load_atlased(&g_app.player_tex[s][d], path))
             {
                 any_player_texture_loaded = 1;
                 g_app.player_sheet_loaded[s][d] = 1;
@@ -76,9 +76,9 @@ extern int rogue_progression_passives_is_unlocked(int node_id);
 /* We directly walk internal journal by replaying from unlock states; since internal journal isn't
  * exposed, we persist only unlocked nodes with a synthetic timestamp (order preserved by node id).
  */
-static void write_unlocked_passives(FILE* f, uint32_t* count_out)
+static void write_unlocked_passives(RogueSaveBuffer* out, uint32_t* count_out)
 {
-    if (!f || !count_out)
+    if (!out || !count_out)
     {
         return;
     }
@@ -90,19 +90,19 @@ static void write_unlocked_passives(FILE* f, uint32_t* count_out)
             PassiveEntryDisk e;
             e.node_id = nid;
             e.timestamp_ms = (uint32_t) (nid & 0xFFFFFFFFu);
-            fwrite(&e, sizeof e, 1, f);
+            rogue_save_buffer_append(out, &e, sizeof e);
             (*count_out)++;
         }
     }
 }
 extern int rogue_progression_passive_unlock(int node_id, unsigned int timestamp_ms, int level,
                                             int str, int dex, int intel, int vit);
-static int read_unlocked_passives(FILE* f, uint32_t count)
+static int read_unlocked_passives(RogueSaveReader* in, uint32_t count)
 {
     for (uint32_t i = 0; i < count; i++)
     {
         PassiveEntryDisk e;
-        if (fread(&e, sizeof e, 1, f) != 1)
+        if (rogue_save_reader_read(in, &e, sizeof e) != 0)
             return -1;
         rogue_progression_passive_unlock(e.node_id, e.timestamp_ms, g_app.player.level,
                                          g_attr_state.strength, g_attr_state.dexterity,
@@ -112,9 +112,9 @@ static int read_unlocked_passives(FILE* f, uint32_t count)
 }
 
 /* Attribute operation journal serialization (Phase 12.3) */
-static int write_attr_ops(FILE* f, uint32_t* op_count_out)
+static int write_attr_ops(RogueSaveBuffer* out, uint32_t* op_count_out)
 {
-    if (!f || !op_count_out)
+    if (!out || !op_count_out)
         return -1;
     *op_count_out = (uint32_t) rogue_attr_journal_count();
     for (int i = 0; i < rogue_attr_journal_count(); i++)
@@ -126,17 +126,17 @@ static int write_attr_ops(FILE* f, uint32_t* op_count_out)
         unsigned char rec[2];
         rec[0] = (unsigned char) code;
         rec[1] = (unsigned char) kind;
-        if (fwrite(rec, 1, 2, f) != 2)
+        if (rogue_save_buffer_append(out, rec, 2) != 0)
             return -3;
     }
     return 0;
 }
-static int read_attr_ops(FILE* f, uint32_t count)
+static int read_attr_ops(RogueSaveReader* in, uint32_t count)
 {
     for (uint32_t i = 0; i < count; i++)
     {
         unsigned char rec[2];
-        if (fread(rec, 1, 2, f) != 2)
+        if (rogue_save_reader_read(in, rec, 2) != 0)
             return -1;
         char code = (char) rec[0];
         int kind = (int) rec[1];
@@ -145,9 +145,9 @@ static int read_attr_ops(FILE* f, uint32_t count)
     }
     return 0;
 }
-int rogue_progression_persist_write(FILE* f)
+int rogue_progression_persist_write(RogueSaveBuffer* out)
 {
-    if (!f)
+    if (!out)
         return -1;
     g_chain_hash = 0xcbf29ce484222325ULL;
     g_last_migration_flags = 0;
@@ -171,21 +171,18 @@ int rogue_progression_persist_write(FILE* f)
     h.respec_tokens = (uint32_t) g_attr_state.respec_tokens;
     h.attr_journal_hash = g_attr_state.journal_hash;
     h.passive_journal_hash = rogue_progression_passives_journal_hash();
-    long after_header = 0; /* reserve space for header */
-    if (fwrite(&h, sizeof h, 1, f) != 1)
+    size_t header_at = out->len; /* reserve space for header */
+    if (rogue_save_buffer_append(out, &h, sizeof h) != 0)
         return -2; /* passive entries */
     uint32_t entry_count = 0;
-    write_unlocked_passives(f, &entry_count); /* attribute ops */
+    write_unlocked_passives(out, &entry_count); /* attribute ops */
     uint32_t attr_ops = 0;
-    if (write_attr_ops(f, &attr_ops) != 0)
+    if (write_attr_ops(out, &attr_ops) != 0)
         return -3; /* rewrite header with counts */
     h.passive_entry_count = entry_count;
     h.attr_op_count = attr_ops;
-    after_header = ftell(f);
-    fseek(f, 0, SEEK_SET);
-    if (fwrite(&h, sizeof h, 1, f) != 1)
+    if (rogue_save_buffer_patch(out, header_at, &h, sizeof h) != 0)
         return -4;
-    fseek(f, after_header, SEEK_SET);
     g_chain_hash = fold64(g_chain_hash, h.version);
     g_chain_hash = fold64(g_chain_hash, h.level);
     g_chain_hash = fold64(g_chain_hash, h.xp_total);
@@ -193,21 +190,21 @@ int rogue_progression_persist_write(FILE* f)
     g_chain_hash = fold64(g_chain_hash, h.passive_journal_hash);
     return 0;
 }
-int rogue_progression_persist_read(FILE* f)
+int rogue_progression_persist_read(RogueSaveReader* in)
 {
-    if (!f)
+    if (!in)
         return -1;
     g_chain_hash = 0xcbf29ce484222325ULL;
     g_last_migration_flags = 0;
-    long start = ftell(f);
+    size_t start = rogue_save_reader_tell(in);
     uint32_t version = 0;
-    if (fread(&version, sizeof version, 1, f) != 1)
+    if (rogue_save_reader_read(in, &version, sizeof version) != 0)
         return -2;
-    fseek(f, start, SEEK_SET);
+    rogue_save_reader_seek(in, start);
     if (version == 1)
     {
         ProgHeaderV1 h;
-        if (fread(&h, sizeof h, 1, f) != 1)
+        if (rogue_save_reader_read(in, &h, sizeof h) != 0)
             return -3;
         g_app.level = (int) h.level;
         g_app.player.level = (int) h.level;
@@ -222,7 +219,7 @@ int rogue_progression_persist_read(FILE* f)
         g_attr_state.journal_hash = h.attr_journal_hash;
         if (h.passive_journal_hash != rogue_progression_passives_journal_hash())
             g_last_migration_flags |= ROGUE_PROG_MIG_STAT_REG_CHANGED;
-        if (read_unlocked_passives(f, h.passive_entry_count) != 0)
+        if (read_unlocked_passives(in, h.passive_entry_count) != 0)
             return -4;
         g_chain_hash = fold64(g_chain_hash, h.version);
         g_chain_hash = fold64(g_chain_hash, h.level);
@@ -233,7 +230,7 @@ int rogue_progression_persist_read(FILE* f)
     else if (version == 2)
     {
         ProgHeaderV2 h;
-        if (fread(&h, sizeof h, 1, f) != 1)
+        if (rogue_save_reader_read(in, &h, sizeof h) != 0)
             return -5;
         g_app.level = (int) h.level;
         g_app.player.level = (int) h.level;
@@ -249,7 +246,7 @@ int rogue_progression_persist_read(FILE* f)
         unsigned long long cur_fp = rogue_stat_registry_fingerprint();
         if (cur_fp != h.stat_registry_fp)
             g_last_migration_flags |= ROGUE_PROG_MIG_STAT_REG_CHANGED;
-        if (read_unlocked_passives(f, h.passive_entry_count) != 0)
+        if (read_unlocked_passives(in, h.passive_entry_count) != 0)
             return -6;
         g_chain_hash = fold64(g_chain_hash, h.version);
         g_chain_hash = fold64(g_chain_hash, h.level);
@@ -260,7 +257,7 @@ int rogue_progression_persist_read(FILE* f)
     else if (version == 3)
     {
         ProgHeaderV3 h;
-        if (fread(&h, sizeof h, 1, f) != 1)
+        if (rogue_save_reader_read(in, &h, sizeof h) != 0)
             return -8;
         g_app.level = (int) h.level;
         g_app.player.level = (int) h.level;
@@ -276,9 +273,9 @@ int rogue_progression_persist_read(FILE* f)
         unsigned long long cur_fp = rogue_stat_registry_fingerprint();
         if (cur_fp != h.stat_registry_fp)
             g_last_migration_flags |= ROGUE_PROG_MIG_STAT_REG_CHANGED;
-        if (read_unlocked_passives(f, h.passive_entry_count) != 0)
+        if (read_unlocked_passives(in, h.passive_entry_count) != 0)
             return -9;
-        if (read_attr_ops(f, h.attr_op_count) != 0)
+        if (read_attr_ops(in, h.attr_op_count) != 0)
             return -10;
         g_chain_hash = fold64(g_chain_hash, h.version);
         g_chain_hash = fold64(g_chain_hash, h.level);
@@ -292,11 +289,14 @@ int rogue_progression_persist_read(FILE* f)
     }
     return 0;
 }
-static int save_component_write(FILE* f) { return rogue_progression_persist_write(f); }
-static int save_component_read(FILE* f, size_t size)
+static int save_component_write(RogueSaveBuffer* out)
+{
+    return rogue_progression_persist_write(out);
+}
+static int save_component_read(RogueSaveReader* in, size_t size)
 {
     (void) size;
-    return rogue_progression_persist_read(f);
+    return rogue_progression_persist_read(in);
 }
 int rogue_progression_persist_register(void)
 {
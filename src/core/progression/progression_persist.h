@@ -2,6 +2,7 @@
 #ifndef ROGUE_PROGRESSION_PERSIST_H
 #define ROGUE_PROGRESSION_PERSIST_H
 
+#include "../persistence/save_utils.h"
 #include <stdint.h>
 #include <stdio.h>
 
@@ -11,8 +12,8 @@
 #define ROGUE_PROG_MIG_ATTR_REPLAY 0x8u   /* attribute journal replay applied */
 
 int rogue_progression_persist_register(void);
-int rogue_progression_persist_write(FILE* f);
-int rogue_progression_persist_read(FILE* f);
+int rogue_progression_persist_write(RogueSaveBuffer* out); /* appends the v3 blob */
+int rogue_progression_persist_read(RogueSaveReader* in);
 unsigned long long rogue_progression_persist_chain_hash(void);
 unsigned int rogue_progression_persist_last_migration_flags(void);
 /* For tests: expose version constant */
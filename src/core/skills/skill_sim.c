@@ -0,0 +1,290 @@
+/**
+ * @file skill_sim.c
+ * @brief Isolated skill simulation contexts and the parallel rotation / DPS batch runner.
+ * @details See skill_sim.h. The batch captures the player, skill states and per-skill
+ * coefficients once on the caller thread; workers pull job indices from an atomic cursor and run
+ * each job on their own context reset from that snapshot, so results do not depend on which
+ * worker ran a job or in which order.
+ */
+
+#include "skill_sim.h"
+#include "../app/app_state.h"
+#include "skills_internal.h"
+#include <stdlib.h>
+#include <string.h>
+#if defined(ROGUE_HAVE_SDL)
+#include <SDL.h>
+#endif
+
+/* Reset an isolated context from a player + skill state snapshot (states already allocated). */
+static void ctx_reset(RogueSkillSimCtx* sc, const RoguePlayer* player,
+                      const RogueSkillState* states, double now_ms, unsigned int seed)
+{
+    sc->own_player = *player;
+    if (sc->state_count > 0)
+        memcpy(sc->states, states, sizeof(RogueSkillState) * (size_t) sc->state_count);
+    rogue_buff_set_init(&sc->own_buffs);
+    sc->own_combo = 0;
+    sc->own_throttle_ms = 0.0f;
+    sc->own_overdrive_ms = 0.0f;
+    sc->own_overdrive_bonus = 0;
+    sc->own_overheat = 0;
+    sc->player = &sc->own_player;
+    sc->buffs = &sc->own_buffs;
+    sc->combo = &sc->own_combo;
+    sc->ap_throttle_timer_ms = &sc->own_throttle_ms;
+    sc->ap_overdrive_ms = &sc->own_overdrive_ms;
+    sc->ap_overdrive_bonus = &sc->own_overdrive_bonus;
+    sc->overheat_active = &sc->own_overheat;
+    sc->now_ms = now_ms;
+    sc->rng_state = seed;
+    sc->live = 0;
+}
+
+static int ctx_alloc(RogueSkillSimCtx* sc, int state_count)
+{
+    memset(sc, 0, sizeof *sc);
+    sc->state_count = state_count;
+    sc->states = (RogueSkillState*) malloc(sizeof(RogueSkillState) *
+                                           (size_t) (state_count > 0 ? state_count : 1));
+    return sc->states ? 0 : -1;
+}
+
+int rogue_skill_sim_ctx_init(RogueSkillSimCtx* ctx, const RoguePlayer* player, double now_ms,
+                             unsigned int seed)
+{
+    if (!ctx)
+        return -1;
+    if (ctx_alloc(ctx, g_skill_count_internal) != 0)
+        return -1;
+    ctx_reset(ctx, player ? player : &g_app.player, g_skill_states_internal, now_ms, seed);
+    return 0;
+}
+
+void rogue_skill_sim_ctx_free(RogueSkillSimCtx* ctx)
+{
+    if (!ctx || ctx->live)
+        return;
+    free(ctx->states);
+    ctx->states = NULL;
+    ctx->state_count = 0;
+}
+
+static unsigned int sim_rng_next(RogueSkillSimCtx* sc)
+{
+    sc->rng_state = sc->rng_state * 1664525u + 1013904223u;
+    return sc->rng_state >> 8;
+}
+
+int rogue_skill_sim_run(RogueSkillSimCtx* sc, const RogueSkillSimJob* job, const float* coeffs,
+                        RogueSkillSimResult* out)
+{
+    if (!sc || !job || !out || sc->live)
+        return -1;
+    memset(out, 0, sizeof *out);
+    if (job->duration_ms <= 0.0)
+        return -2;
+    double tick_ms = job->tick_ms > 0.0 ? job->tick_ms : 16.0;
+    int prio[ROGUE_SKILL_SIM_MAX_PRIORITY];
+    int prio_count = job->prio_count;
+    if (prio_count > ROGUE_SKILL_SIM_MAX_PRIORITY)
+        prio_count = ROGUE_SKILL_SIM_MAX_PRIORITY;
+    if (prio_count > 0)
+        memcpy(prio, job->priority, sizeof(int) * (size_t) prio_count);
+    else
+    {
+        prio_count = sc->state_count < ROGUE_SKILL_SIM_MAX_PRIORITY ? sc->state_count
+                                                                    : ROGUE_SKILL_SIM_MAX_PRIORITY;
+        for (int i = 0; i < prio_count; ++i)
+            prio[i] = i;
+    }
+
+    /* AP pool full at start */
+    sc->player->action_points = sc->player->max_action_points;
+    *sc->ap_throttle_timer_ms = 0.0f;
+
+    double now = sc->now_ms;
+    double end_time = now + job->duration_ms;
+    double ap_regen_per_ms = job->ap_regen_per_sec / 1000.0;
+    while (now < end_time)
+    {
+        if (ap_regen_per_ms > 0.0)
+        {
+            sc->player->action_points += (int) (ap_regen_per_ms * tick_ms);
+            if (sc->player->action_points > sc->player->max_action_points)
+                sc->player->action_points = sc->player->max_action_points;
+        }
+        /* one activation per tick, first ready skill in priority order */
+        for (int i = 0; i < prio_count; ++i)
+        {
+            int sid = prio[i];
+            if (sid < 0 || sid >= sc->state_count)
+                continue;
+            RogueSkillCtx ctx = {0};
+            ctx.now_ms = now;
+            if (!rogue_skill_try_activate_ctx(sc, sid, &ctx))
+                continue;
+            const RogueSkillDef* def = &g_skill_defs_internal[sid];
+            out->casts[i]++;
+            out->total_casts++;
+            if (def->action_point_cost > 0)
+                out->ap_spent += (int) def->action_point_cost;
+            if (job->base_damage > 0)
+            {
+                double coeff = coeffs ? coeffs[sid] : skill_get_effective_coefficient(sid);
+                double dmg = (double) job->base_damage * coeff;
+                if ((int) (sim_rng_next(sc) % 100u) < sc->player->crit_chance)
+                {
+                    dmg = dmg * (100.0 + (double) sc->player->crit_damage) / 100.0;
+                    out->crits++;
+                }
+                out->damage += (long long) (dmg + 0.5);
+            }
+            break;
+        }
+        now += tick_ms;
+        sc->now_ms = now;
+        rogue_skills_update_ctx(sc, now);
+        rogue_buff_set_update(sc->buffs, now);
+    }
+    out->dps = (double) out->damage * 1000.0 / job->duration_ms;
+    return 0;
+}
+
+/* ---- Batch ---- */
+#if defined(ROGUE_HAVE_SDL)
+typedef SDL_atomic_t SimAtomic;
+#define sim_atomic_add(a, v) SDL_AtomicAdd((a), (v))
+#else
+typedef struct SimAtomic
+{
+    int value;
+} SimAtomic;
+static int sim_atomic_add(SimAtomic* a, int v)
+{
+    int old = a->value;
+    a->value += v;
+    return old;
+}
+#endif
+
+typedef struct SimBatch
+{
+    const RogueSkillSimJob* jobs;
+    RogueSkillSimResult* results;
+    int count;
+    RoguePlayer player;
+    const RogueSkillState* states;
+    const float* coeffs;
+    double now_ms;
+    SimAtomic next_job;
+    SimAtomic done;
+} SimBatch;
+
+typedef struct SimWorker
+{
+    SimBatch* b;
+    RogueSkillSimCtx ctx;
+} SimWorker;
+
+static void sim_worker_run(SimWorker* w)
+{
+    SimBatch* b = w->b;
+    int done = 0;
+    for (;;)
+    {
+        int j = sim_atomic_add(&b->next_job, 1);
+        if (j >= b->count)
+            break;
+        ctx_reset(&w->ctx, &b->player, b->states, b->now_ms, b->jobs[j].seed);
+        if (rogue_skill_sim_run(&w->ctx, &b->jobs[j], b->coeffs, &b->results[j]) == 0)
+            done++;
+    }
+    sim_atomic_add(&b->done, done);
+}
+
+#if defined(ROGUE_HAVE_SDL)
+static int sim_worker_thread(void* ud)
+{
+    sim_worker_run((SimWorker*) ud);
+    return 0;
+}
+#endif
+
+int rogue_skill_sim_batch(const RogueSkillSimJob* jobs, RogueSkillSimResult* results, int count,
+                          int workers)
+{
+    if (!jobs || !results || count < 0)
+        return -1;
+    if (count == 0)
+        return 0;
+    int n_skills = g_skill_count_internal;
+    SimBatch b;
+    memset(&b, 0, sizeof b);
+    b.jobs = jobs;
+    b.results = results;
+    b.count = count;
+    b.player = g_app.player;
+    b.now_ms = g_app.game_time_ms;
+    /* snapshot live states + coefficients on the caller: workers never read live mutable state */
+    RogueSkillState* states =
+        (RogueSkillState*) malloc(sizeof(RogueSkillState) * (size_t) (n_skills > 0 ? n_skills : 1));
+    float* coeffs = (float*) malloc(sizeof(float) * (size_t) (n_skills > 0 ? n_skills : 1));
+    if (!states || !coeffs)
+    {
+        free(states);
+        free(coeffs);
+        return -2;
+    }
+    if (n_skills > 0)
+        memcpy(states, g_skill_states_internal, sizeof(RogueSkillState) * (size_t) n_skills);
+    for (int i = 0; i < n_skills; i++)
+        coeffs[i] = skill_get_effective_coefficient(i);
+    b.states = states;
+    b.coeffs = coeffs;
+
+#if defined(ROGUE_HAVE_SDL)
+    if (workers <= 0)
+        workers = SDL_GetCPUCount();
+#endif
+    if (workers <= 0)
+        workers = 1;
+    if (workers > ROGUE_SKILL_SIM_MAX_WORKERS)
+        workers = ROGUE_SKILL_SIM_MAX_WORKERS;
+    if (workers > count)
+        workers = count;
+    SimWorker ws[ROGUE_SKILL_SIM_MAX_WORKERS];
+    int ready = 0;
+    for (; ready < workers; ready++)
+    {
+        ws[ready].b = &b;
+        if (ctx_alloc(&ws[ready].ctx, n_skills) != 0)
+            break;
+    }
+    int rc = -2;
+    if (ready > 0)
+    {
+#if defined(ROGUE_HAVE_SDL)
+        SDL_Thread* threads[ROGUE_SKILL_SIM_MAX_WORKERS] = {0};
+        for (int i = 1; i < ready; i++)
+            threads[i] = SDL_CreateThread(sim_worker_thread, "skill_sim", &ws[i]);
+        sim_worker_run(&ws[0]);
+        for (int i = 1; i < ready; i++)
+        {
+            if (threads[i])
+                SDL_WaitThread(threads[i], NULL);
+            else
+                sim_worker_run(&ws[i]); /* thread creation failed: drain remaining jobs here */
+        }
+#else
+        for (int i = 0; i < ready; i++)
+            sim_worker_run(&ws[i]);
+#endif
+        rc = sim_atomic_add(&b.done, 0);
+    }
+    for (int i = 0; i < ready; i++)
+        rogue_skill_sim_ctx_free(&ws[i].ctx);
+    free(states);
+    free(coeffs);
+    return rc;
+}
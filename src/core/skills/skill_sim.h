@@ -0,0 +1,98 @@
+/* Skill simulation contexts + parallel batch runner (Skills sim follow-up).
+ *
+ * A RogueSkillSimCtx bundles everything skill activation reads or writes: player resources, the
+ * per-skill runtime states, buffs, combo / AP throttle / overdrive / overheat meters, the clock and
+ * an RNG stream. rogue_skill_try_activate / rogue_skills_update operate on the live context
+ * (g_app + the skill registry states + the live buff set); the *_ctx variants take an explicit
+ * context.
+ *
+ * Isolated contexts own copies of the player, skill states and buffs and never touch g_app. They
+ * skip FX cues, event bus publishes and RogueSkillDef.on_activate (a present hook is assumed to
+ * consume), and apply EffectSpecs through rogue_effect_apply_buffs (STAT_BUFF only, into the
+ * context buff set); world-facing effects (DOT/AURA damage, pulses, children) are not simulated.
+ * Skill definitions, EffectSpecs and coefficient inputs are only read, so isolated contexts may
+ * run on several threads at once as long as nothing registers skills or effects meanwhile. */
+#ifndef ROGUE_SKILL_SIM_H
+#define ROGUE_SKILL_SIM_H
+
+#include "../../entities/player.h"
+#include "../../game/buffs.h"
+#include "skills.h"
+
+#define ROGUE_SKILL_SIM_MAX_PRIORITY 32
+#define ROGUE_SKILL_SIM_MAX_WORKERS 8
+
+typedef struct RogueSkillSimCtx
+{
+    RoguePlayer* player;
+    RogueSkillState* states; /* one per registered skill at bind / init time */
+    int state_count;
+    RogueBuffSet* buffs;
+    int* combo;
+    float* ap_throttle_timer_ms;
+    float* ap_overdrive_ms;
+    int* ap_overdrive_bonus;
+    int* overheat_active;
+    double now_ms;
+    unsigned int rng_state; /* Monte Carlo stream (crit rolls); activation RNG stays per-skill */
+    int live;               /* 1 = bound to g_app: FX, events, hooks and world effects */
+    /* backing storage for isolated contexts */
+    RoguePlayer own_player;
+    RogueBuffSet own_buffs;
+    int own_combo;
+    float own_throttle_ms, own_overdrive_ms;
+    int own_overdrive_bonus, own_overheat;
+} RogueSkillSimCtx;
+
+/* Live context (rebinds to g_app / the current skill state array on every call). */
+RogueSkillSimCtx* rogue_skill_sim_live(void);
+
+/* Isolated context from a player snapshot (NULL = g_app.player) and the current skill states.
+ * Returns 0 on success, -1 on allocation failure. Release with rogue_skill_sim_ctx_free. */
+int rogue_skill_sim_ctx_init(RogueSkillSimCtx* ctx, const RoguePlayer* player, double now_ms,
+                             unsigned int seed);
+void rogue_skill_sim_ctx_free(RogueSkillSimCtx* ctx);
+
+int rogue_skill_try_activate_ctx(RogueSkillSimCtx* sc, int id, const RogueSkillCtx* ctx);
+int rogue_skill_try_cancel_ctx(RogueSkillSimCtx* sc, int id, const RogueSkillCtx* ctx);
+void rogue_skills_update_ctx(RogueSkillSimCtx* sc, double now_ms);
+
+/* One rotation / Monte Carlo DPS run: each tick regenerates AP, activates the first ready skill
+ * in priority order, then advances skills and buffs. With base_damage > 0 every activation deals
+ * base_damage * effective coefficient, critting on the context RNG with the player's
+ * crit_chance / crit_damage. */
+typedef struct RogueSkillSimJob
+{
+    int priority[ROGUE_SKILL_SIM_MAX_PRIORITY];
+    int prio_count; /* 0 = all registered skills in id order (capped) */
+    double duration_ms;
+    double tick_ms;          /* 0 = 16 */
+    double ap_regen_per_sec; /* 0 = none */
+    int base_damage;         /* 0 = rotation counts only */
+    unsigned int seed;
+} RogueSkillSimJob;
+
+typedef struct RogueSkillSimResult
+{
+    int casts[ROGUE_SKILL_SIM_MAX_PRIORITY]; /* per priority entry */
+    int total_casts;
+    int ap_spent;
+    int crits;
+    long long damage;
+    double dps;
+} RogueSkillSimResult;
+
+/* Run one job on an isolated context prepared by the caller (reset by rogue_skill_sim_ctx_init).
+ * coeffs: per-skill coefficient (NULL = skill_get_effective_coefficient on the calling thread).
+ * Returns 0 on success, <0 on bad arguments. */
+int rogue_skill_sim_run(RogueSkillSimCtx* sc, const RogueSkillSimJob* job, const float* coeffs,
+                        RogueSkillSimResult* out);
+
+/* Run count jobs, each on a fresh isolated context seeded from g_app.player and the current skill
+ * states, across up to `workers` threads (0 = one per CPU, capped; SDL threads when
+ * ROGUE_HAVE_SDL, otherwise the caller). Results are identical to running the jobs one by one.
+ * Blocks until done; returns the number of jobs completed or <0 on failure. */
+int rogue_skill_sim_batch(const RogueSkillSimJob* jobs, RogueSkillSimResult* results, int count,
+                          int workers);
+
+#endif
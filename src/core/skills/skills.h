@@ -169,7 +169,9 @@ float skill_get_effective_coefficient(int skill_id);
      Writes a compact JSON result into out_buf on success, e.g.:
          {"duration_ms":1000,"total_casts":12,"ap_spent":120,
             "casts":[{"id":0,"count":7},{"id":1,"count":5}]}
-     Returns 0 on success, <0 on parse/error. Non-reentrant (uses global state). */
+     Returns 0 on success, <0 on parse/error. Runs on an isolated simulation context
+     (skill_sim.h) seeded from g_app.player at level 1; live player / skill / buff state and
+     g_app.game_time_ms are left untouched. */
 int skill_simulate_rotation(const char* profile_json, char* out_buf, int out_cap);
 
 /* Data-driven loading */
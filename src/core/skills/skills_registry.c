@@ -201,6 +201,9 @@ int rogue_skill_register(const RogueSkillDef* def)
                 g_app.skill_icon_textures[i].handle = NULL;
                 g_app.skill_icon_textures[i].w = 0;
                 g_app.skill_icon_textures[i].h = 0;
+                g_app.skill_icon_textures[i].ax = 0;
+                g_app.skill_icon_textures[i].ay = 0;
+                g_app.skill_icon_textures[i].cache_id = 0;
             }
             s_skill_icon_tex_count = g_skill_count_internal;
         }
@@ -3,20 +3,18 @@
 #include "../../entities/player.h"
 #include "../../game/buffs.h"
 #include "../../util/determinism.h"
+#include "../../util/json_tok.h"
 #include "../app/app_state.h"
 #include "../integration/event_bus.h"
 #include "../progression/progression_mastery.h"
 #include "../progression/progression_specialization.h"
+#include "../../graphics/effect_spec.h"
+#include "skill_sim.h"
 #include "skills_coeffs.h" /* Phase 8: central coefficient table */
 #include "skills_internal.h"
 #include <stdlib.h>
 #include <string.h>
 
-/* Phase 3.5: tick EffectSpec pending events */
-void rogue_effects_update(double now_ms);
-
-void rogue_effect_apply(int effect_spec_id, double now_ms);
-
 /* Export a deterministic hash of active buffs for analytics/replay.
    Incorporates type, magnitude, snapshot flag, and normalized remaining_ms (clamped >=0).
    now_ms is used to compute remaining time; pass g_app.game_time_ms. */
@@ -66,150 +64,89 @@ float skill_get_effective_coefficient(int skill_id)
     return coeff;
 }
 
-/* Tiny helpers to extract numeric fields from a flat JSON object (non-robust).
-   Accepts keys like "\"duration_ms\": 1000" and arrays for priority: "\"priority\":[0,1] */
-static int json_extract_number(const char* s, const char* key, double* out)
+/* Rotation profile: one pass over a flat object such as
+   {"duration_ms":1000,"tick_ms":50,"ap_regen_per_sec":50,"priority":[0,1]}. Unknown keys are
+   skipped. Returns 0 when the document is valid JSON with a numeric duration_ms, -1 otherwise. */
+static int parse_rotation_profile(const char* s, RogueSkillSimJob* job)
 {
-    if (!s || !key || !out)
-        return 0;
-    char pat[64];
-    snprintf(pat, sizeof pat, "\"%s\"", key);
-    const char* p = strstr(s, pat);
-    if (!p)
-        return 0;
-    p = strchr(p, ':');
-    if (!p)
-        return 0;
-    p++;
-    while (*p == ' ' || *p == '\t')
-        ++p;
-    char* e = NULL;
-    double v = strtod(p, &e);
-    if (e == p)
-        return 0;
-    *out = v;
-    return 1;
-}
-
-static int json_extract_int_array(const char* s, const char* key, int* out_ids, int max_ids)
-{
-    if (!s || !key || !out_ids || max_ids <= 0)
-        return 0;
-    char pat[64];
-    snprintf(pat, sizeof pat, "\"%s\"", key);
-    const char* p = strstr(s, pat);
-    if (!p)
-        return 0;
-    p = strchr(p, ':');
-    if (!p)
-        return 0;
-    p++;
-    while (*p && *p != '[')
-        ++p;
-    if (*p != '[')
-        return 0;
-    ++p;
-    int n = 0;
-    while (*p && *p != ']' && n < max_ids)
+    RogueJsonTokenizer t;
+    RogueJsonToken v, e;
+    RogueJsonView key;
+    int have_duration = 0;
+    rogue_json_tok_init(&t, s, strlen(s));
+    if (rogue_json_tok_next(&t, &v) != ROGUE_JTOK_OBJECT_BEGIN)
+        return -1;
+    while (rogue_json_tok_member(&t, &key, &v) > 0)
     {
-        while (*p == ' ' || *p == '\t' || *p == ',')
-            ++p;
-        char* e = NULL;
-        long v = strtol(p, &e, 10);
-        if (e == p)
-            break;
-        out_ids[n++] = (int) v;
-        p = e;
-        while (*p == ' ' || *p == '\t')
-            ++p;
-        if (*p == ',')
-            ++p;
+        if (rogue_json_view_eq(key, "duration_ms"))
+            have_duration = rogue_json_tok_double(&v, &job->duration_ms);
+        else if (rogue_json_view_eq(key, "tick_ms"))
+            (void) rogue_json_tok_double(&v, &job->tick_ms);
+        else if (rogue_json_view_eq(key, "ap_regen_per_sec"))
+            (void) rogue_json_tok_double(&v, &job->ap_regen_per_sec);
+        else if (rogue_json_view_eq(key, "priority") && v.type == ROGUE_JTOK_ARRAY_BEGIN)
+        {
+            while (rogue_json_tok_element(&t, &e) > 0)
+            {
+                if (job->prio_count < ROGUE_SKILL_SIM_MAX_PRIORITY &&
+                    rogue_json_tok_int(&e, &job->priority[job->prio_count]))
+                    job->prio_count++;
+                else
+                    (void) rogue_json_tok_skip(&t, &e);
+            }
+        }
+        else
+            (void) rogue_json_tok_skip(&t, &v);
     }
-    return n;
+    if (rogue_json_tok_next(&t, &v) != ROGUE_JTOK_END)
+        return -1;
+    return have_duration ? 0 : -1;
 }
 
 int skill_simulate_rotation(const char* profile_json, char* out_buf, int out_cap)
 {
     if (!profile_json || !out_buf || out_cap <= 0)
         return -1;
-    double duration_ms = 0.0, tick_ms = 16.0, ap_regen_per_sec = 0.0;
-    (void) json_extract_number(profile_json, "tick_ms", &tick_ms);
-    (void) json_extract_number(profile_json, "ap_regen_per_sec", &ap_regen_per_sec);
-    if (!json_extract_number(profile_json, "duration_ms", &duration_ms) || duration_ms <= 0.0)
+    RogueSkillSimJob job;
+    memset(&job, 0, sizeof job);
+    job.tick_ms = 16.0;
+    if (parse_rotation_profile(profile_json, &job) != 0 || job.duration_ms <= 0.0)
         return -2;
-    int prio[32];
-    int prio_count = json_extract_int_array(profile_json, "priority", prio, 32);
-    if (prio_count <= 0)
+    if (job.prio_count <= 0)
     {
         /* default: try all registered skills in order */
-        prio_count = g_skill_count_internal < 32 ? g_skill_count_internal : 32;
-        for (int i = 0; i < prio_count; ++i)
-            prio[i] = i;
+        job.prio_count = g_skill_count_internal < ROGUE_SKILL_SIM_MAX_PRIORITY
+                             ? g_skill_count_internal
+                             : ROGUE_SKILL_SIM_MAX_PRIORITY;
+        for (int i = 0; i < job.prio_count; ++i)
+            job.priority[i] = i;
     }
 
-    /* counters */
-    int casts[32] = {0};
-    int total_casts = 0;
-    int ap_spent = 0;
-
-    /* Reset a minimal state for deterministic sim: AP pool full at start */
-    g_app.player.level = 1;
-    rogue_player_recalc_derived(&g_app.player);
-    g_app.player.action_points = g_app.player.max_action_points;
-    g_app.ap_throttle_timer_ms = 0.0f;
-
-    double now = g_app.game_time_ms;
-    double end_time = now + duration_ms;
-    double ap_regen_per_ms = ap_regen_per_sec / 1000.0;
-
-    while (now < end_time)
-    {
-        /* Regen AP */
-        if (ap_regen_per_ms > 0.0)
-        {
-            g_app.player.action_points += (int) (ap_regen_per_ms * tick_ms);
-            if (g_app.player.action_points > g_app.player.max_action_points)
-                g_app.player.action_points = g_app.player.max_action_points;
-        }
-        /* Try to activate in priority order */
-        int activated = 0;
-        for (int i = 0; i < prio_count && !activated; ++i)
-        {
-            int sid = prio[i];
-            if (sid < 0 || sid >= g_skill_count_internal)
-                continue;
-            RogueSkillCtx ctx = {0};
-            ctx.now_ms = now;
-            if (rogue_skill_try_activate(sid, &ctx))
-            {
-                const RogueSkillDef* def = &g_skill_defs_internal[sid];
-                casts[i]++;
-                total_casts++;
-                if (def->action_point_cost > 0)
-                    ap_spent += (int) def->action_point_cost;
-                activated = 1;
-            }
-        }
-        /* Update skills */
-        now += tick_ms;
-        g_app.game_time_ms = now;
-        rogue_skills_update(now);
-        /* process effect pulses & child chains */
-        rogue_effects_update(now);
-    }
+    /* Isolated context: deterministic minimal state (level 1, AP pool full at start) without
+     * touching g_app or the live skill states. */
+    RogueSkillSimCtx sc;
+    if (rogue_skill_sim_ctx_init(&sc, NULL, g_app.game_time_ms, 0u) != 0)
+        return -1;
+    sc.player->level = 1;
+    rogue_player_recalc_derived(sc.player);
+    RogueSkillSimResult res;
+    int rc = rogue_skill_sim_run(&sc, &job, NULL, &res);
+    rogue_skill_sim_ctx_free(&sc);
+    if (rc != 0)
+        return -1;
 
     /* Emit compact JSON result */
     int w = 0;
     int n = snprintf(out_buf, out_cap,
                      "{\"duration_ms\":%d,\"total_casts\":%d,\"ap_spent\":%d,\"casts\":[",
-                     (int) duration_ms, total_casts, ap_spent);
+                     (int) job.duration_ms, res.total_casts, res.ap_spent);
     if (n < 0 || n >= out_cap)
         return -3;
     w += n;
-    for (int i = 0; i < prio_count; ++i)
+    for (int i = 0; i < job.prio_count; ++i)
     {
         int m = snprintf(out_buf + w, out_cap - w, "%s{\"id\":%d,\"count\":%d}", (i ? "," : ""),
-                         prio[i], casts[i]);
+                         job.priority[i], res.casts[i]);
         if (m < 0 || w + m >= out_cap)
             return -3;
         w += m;
@@ -222,7 +159,58 @@ int skill_simulate_rotation(const char* profile_json, char* out_buf, int out_cap
     return 0;
 }
 
+/* Live context: rebound on each call since the state array can move when skills register. */
+static RogueSkillSimCtx g_live_ctx;
+
+RogueSkillSimCtx* rogue_skill_sim_live(void)
+{
+    RogueSkillSimCtx* sc = &g_live_ctx;
+    sc->player = &g_app.player;
+    sc->states = g_skill_states_internal;
+    sc->state_count = g_skill_count_internal;
+    sc->buffs = rogue_buffs_live_set();
+    sc->combo = &g_app.player_combat.combo;
+    sc->ap_throttle_timer_ms = &g_app.ap_throttle_timer_ms;
+    sc->ap_overdrive_ms = &g_app.ap_overdrive_ms;
+    sc->ap_overdrive_bonus = &g_app.ap_overdrive_bonus;
+    sc->overheat_active = &g_app.overheat_active;
+    sc->now_ms = g_app.game_time_ms;
+    sc->live = 1;
+    return sc;
+}
+
+/* FX cue (skill/<id>/start|end) at the player position; live context only. */
+static void skill_fx(const RogueSkillSimCtx* sc, int id, const char* what)
+{
+    if (!sc->live)
+        return;
+    char key[48];
+    snprintf(key, sizeof key, "skill/%d/%s", id, what);
+    rogue_fx_trigger_event(key, sc->player->base.pos.x, sc->player->base.pos.y);
+}
+
+/* EffectSpec application: full pipeline when live, buff-only into the context set otherwise. */
+static void skill_effect(RogueSkillSimCtx* sc, int effect_spec_id, double now_ms)
+{
+    if (sc->live)
+        rogue_effect_apply(effect_spec_id, now_ms);
+    else
+        rogue_effect_apply_buffs(effect_spec_id, now_ms, sc->buffs);
+}
+
 int rogue_skill_try_activate(int id, const RogueSkillCtx* ctx)
+{
+    return rogue_skill_try_activate_ctx(rogue_skill_sim_live(), id, ctx);
+}
+
+int rogue_skill_try_cancel(int id, const RogueSkillCtx* ctx)
+{
+    return rogue_skill_try_cancel_ctx(rogue_skill_sim_live(), id, ctx);
+}
+
+void rogue_skills_update(double now_ms) { rogue_skills_update_ctx(rogue_skill_sim_live(), now_ms); }
+
+int rogue_skill_try_activate_ctx(RogueSkillSimCtx* sc, int id, const RogueSkillCtx* ctx)
 {
     extern unsigned int g_skill_defs_canary;
     extern unsigned int g_skill_states_canary;
@@ -231,9 +219,9 @@ int rogue_skill_try_activate(int id, const RogueSkillCtx* ctx)
         fprintf(stderr, "SKILL CANARY CORRUPTION BEFORE ACTIVATE id=%d\n", id);
         abort();
     }
-    if (id < 0 || id >= g_skill_count_internal)
+    if (id < 0 || id >= sc->state_count)
         return 0;
-    RogueSkillState* st = &g_skill_states_internal[id];
+    RogueSkillState* st = &sc->states[id];
     const RogueSkillDef* def = &g_skill_defs_internal[id];
     if (st->rank <= 0)
         return 0;
@@ -264,14 +252,14 @@ int rogue_skill_try_activate(int id, const RogueSkillCtx* ctx)
     int eff_ap = def->action_point_cost;
     if (def->ap_cost_pct_max > 0)
     {
-        int ap_cap = g_app.player.max_action_points +
-                     (g_app.ap_overdrive_ms > 0.0f ? g_app.ap_overdrive_bonus : 0);
+        int ap_cap = sc->player->max_action_points +
+                     (*sc->ap_overdrive_ms > 0.0f ? *sc->ap_overdrive_bonus : 0);
         eff_ap = (ap_cap * (int) def->ap_cost_pct_max) / 100;
     }
     if (st->rank > 1)
         eff_ap += (int) def->ap_cost_per_rank * (st->rank - 1);
     if (def->ap_cost_surcharge_threshold > 0 &&
-        g_app.player.action_points < def->ap_cost_surcharge_threshold)
+        sc->player->action_points < def->ap_cost_surcharge_threshold)
     {
         eff_ap += def->ap_cost_surcharge_amount;
     }
@@ -279,36 +267,37 @@ int rogue_skill_try_activate(int id, const RogueSkillCtx* ctx)
         eff_ap = 0;
     int eff_mana = def->resource_cost_mana;
     if (def->mana_cost_pct_max > 0)
-        eff_mana = (g_app.player.max_mana * (int) def->mana_cost_pct_max) / 100;
+        eff_mana = (sc->player->max_mana * (int) def->mana_cost_pct_max) / 100;
     if (st->rank > 1)
         eff_mana += (int) def->mana_cost_per_rank * (st->rank - 1);
     if (def->mana_cost_surcharge_threshold > 0 &&
-        g_app.player.mana < def->mana_cost_surcharge_threshold)
+        sc->player->mana < def->mana_cost_surcharge_threshold)
         eff_mana += def->mana_cost_surcharge_amount;
     if (eff_mana < 0)
         eff_mana = 0;
-    if (eff_mana > 0 && g_app.player.mana < eff_mana)
+    if (eff_mana > 0 && sc->player->mana < eff_mana)
         return 0;
-    if (eff_ap > 0 && g_app.player.action_points < eff_ap)
+    if (eff_ap > 0 && sc->player->action_points < eff_ap)
         return 0;
     if (def->min_weave_ms > 0 && def->cast_type == 1 && def->cast_time_ms > 0)
     {
         /* Haste override: if a temporary haste buff is active, bypass the min weave gate. */
-        int haste = rogue_buffs_get_total(ROGUE_BUFF_POWER_STRIKE);
+        int haste = rogue_buff_set_get_total(sc->buffs, ROGUE_BUFF_POWER_STRIKE);
         int bypass_weave = (haste >= 10); /* threshold: >=10 magnitude grants weave bypass */
         if (!bypass_weave)
         {
             if (st->last_cast_ms > 0 && (now - st->last_cast_ms) < (double) def->min_weave_ms)
             {
-                fprintf(stderr,
-                        "SKILL DEBUG: block weave id=%d haste=%d now=%.2f last=%.2f delta=%.2f "
-                        "min=%u\n",
-                        id, haste, now, st->last_cast_ms, now - st->last_cast_ms,
-                        def->min_weave_ms);
+                if (sc->live)
+                    fprintf(stderr,
+                            "SKILL DEBUG: block weave id=%d haste=%d now=%.2f last=%.2f "
+                            "delta=%.2f min=%u\n",
+                            id, haste, now, st->last_cast_ms, now - st->last_cast_ms,
+                            def->min_weave_ms);
                 return 0;
             }
         }
-        else
+        else if (sc->live)
         {
             fprintf(
                 stderr,
@@ -328,11 +317,11 @@ int rogue_skill_try_activate(int id, const RogueSkillCtx* ctx)
         {
             return 0;
         }
-        for (int i2 = 0; i2 < g_skill_count_internal; i2++)
+        for (int i2 = 0; i2 < sc->state_count; i2++)
         {
             if (i2 == id)
                 continue;
-            RogueSkillState* other = &g_skill_states_internal[i2];
+            RogueSkillState* other = &sc->states[i2];
             const RogueSkillDef* odef = &g_skill_defs_internal[i2];
             if (other->casting_active && odef->cast_type == 1 && odef->cast_time_ms > 0)
             {
@@ -354,14 +343,9 @@ int rogue_skill_try_activate(int id, const RogueSkillCtx* ctx)
         st->cast_progress_ms = 0;
         st->channel_active = 0;
         /* FX: skill start cue */
-        {
-            char key[48];
-            /* key scheme: skill/<id>/start */
-            snprintf(key, sizeof key, "skill/%d/start", id);
-            rogue_fx_trigger_event(key, g_app.player.base.pos.x, g_app.player.base.pos.y);
-        }
+        skill_fx(sc, id, "start");
         /* Snapshot haste for cast if flag set */
-        int haste = rogue_buffs_get_total(ROGUE_BUFF_POWER_STRIKE);
+        int haste = rogue_buff_set_get_total(sc->buffs, ROGUE_BUFF_POWER_STRIKE);
         double hf = 1.0 - (haste * 0.02);
         if (hf < 0.5)
             hf = 0.5;
@@ -374,13 +358,9 @@ int rogue_skill_try_activate(int id, const RogueSkillCtx* ctx)
         st->channel_start_ms = now;
         st->channel_end_ms = now + def->cast_time_ms;
         /* FX: channel start cue */
-        {
-            char key[48];
-            snprintf(key, sizeof key, "skill/%d/start", id);
-            rogue_fx_trigger_event(key, g_app.player.base.pos.x, g_app.player.base.pos.y);
-        }
+        skill_fx(sc, id, "start");
         /* snapshot or dynamic haste for channel */
-        int haste = rogue_buffs_get_total(ROGUE_BUFF_POWER_STRIKE);
+        int haste = rogue_buff_set_get_total(sc->buffs, ROGUE_BUFF_POWER_STRIKE);
         double hf = 1.0 - (haste * 0.02);
         if (hf < 0.5)
             hf = 0.5;
@@ -399,7 +379,7 @@ int rogue_skill_try_activate(int id, const RogueSkillCtx* ctx)
         double tick_interval = (st->channel_tick_interval_ms > 0.0) ? st->channel_tick_interval_ms
                                                                     : tick_interval_base;
         st->channel_next_tick_ms = now + tick_interval;
-        if (def->on_activate)
+        if (sc->live && def->on_activate)
         {
             def->on_activate(def, st, &local_ctx);
         }
@@ -410,39 +390,37 @@ int rogue_skill_try_activate(int id, const RogueSkillCtx* ctx)
         int act_flags = 0;
         if (def->on_activate)
         {
-            act_flags = def->on_activate(def, st, &local_ctx);
+            /* isolated contexts assume a present hook consumes */
+            act_flags = sc->live ? def->on_activate(def, st, &local_ctx) : ROGUE_ACT_CONSUMED;
         }
         consumed = (act_flags == 1) || (act_flags & ROGUE_ACT_CONSUMED);
         instant_act_flags = act_flags; /* cache for refund handling after spending */
         /* Instant skills: fire start+end cues immediately on successful consume */
         if (consumed)
         {
-            char key[48];
-            snprintf(key, sizeof key, "skill/%d/start", id);
-            rogue_fx_trigger_event(key, g_app.player.base.pos.x, g_app.player.base.pos.y);
-            snprintf(key, sizeof key, "skill/%d/end", id);
-            rogue_fx_trigger_event(key, g_app.player.base.pos.x, g_app.player.base.pos.y);
+            skill_fx(sc, id, "start");
+            skill_fx(sc, id, "end");
         }
     }
     if (consumed)
     {
         if (eff_mana > 0)
         {
-            g_app.player.mana -= eff_mana;
-            if (g_app.player.mana < 0)
-                g_app.player.mana = 0;
+            sc->player->mana -= eff_mana;
+            if (sc->player->mana < 0)
+                sc->player->mana = 0;
         }
         if (eff_ap > 0)
         {
-            g_app.player.action_points -= eff_ap;
-            if (g_app.player.action_points < 0)
-                g_app.player.action_points = 0;
+            sc->player->action_points -= eff_ap;
+            if (sc->player->action_points < 0)
+                sc->player->action_points = 0;
             st->action_points_spent_session += eff_ap;
             if (eff_ap >= 25)
             {
                 float extend = 1500.0f + eff_ap * 10.0f;
-                if (g_app.ap_throttle_timer_ms < extend)
-                    g_app.ap_throttle_timer_ms = extend;
+                if (*sc->ap_throttle_timer_ms < extend)
+                    *sc->ap_throttle_timer_ms = extend;
             }
         }
         /* Apply refunds for instant skills after spending to avoid cap clipping */
@@ -459,17 +437,17 @@ int rogue_skill_try_activate(int id, const RogueSkillCtx* ctx)
                 int refund_mana = (eff_mana * refund_pct) / 100;
                 if (refund_ap > 0)
                 {
-                    g_app.player.action_points += refund_ap;
-                    int ap_max_now = g_app.player.max_action_points +
-                                     (g_app.ap_overdrive_ms > 0.0f ? g_app.ap_overdrive_bonus : 0);
-                    if (g_app.player.action_points > ap_max_now)
-                        g_app.player.action_points = ap_max_now;
+                    sc->player->action_points += refund_ap;
+                    int ap_max_now = sc->player->max_action_points +
+                                     (*sc->ap_overdrive_ms > 0.0f ? *sc->ap_overdrive_bonus : 0);
+                    if (sc->player->action_points > ap_max_now)
+                        sc->player->action_points = ap_max_now;
                 }
                 if (refund_mana > 0)
                 {
-                    g_app.player.mana += refund_mana;
-                    if (g_app.player.mana > g_app.player.max_mana)
-                        g_app.player.mana = g_app.player.max_mana;
+                    sc->player->mana += refund_mana;
+                    if (sc->player->mana > sc->player->max_mana)
+                        sc->player->mana = sc->player->max_mana;
                 }
             }
         }
@@ -496,49 +474,49 @@ int rogue_skill_try_activate(int id, const RogueSkillCtx* ctx)
         if (def->tags & ROGUE_SKILL_TAG_FIRE)
         {
             int heat_gain = 5 + st->rank;
-            g_app.player.heat += heat_gain;
-            if (g_app.player.heat >= g_app.player.max_heat)
+            sc->player->heat += heat_gain;
+            if (sc->player->heat >= sc->player->max_heat)
             {
-                g_app.player.heat = g_app.player.max_heat;
-                g_app.overheat_active = 1;
+                sc->player->heat = sc->player->max_heat;
+                *sc->overheat_active = 1;
             }
         }
         if (def->effect_spec_id >= 0 && !(def->cast_type == 1 && def->cast_time_ms > 0))
         {
-            rogue_effect_apply(def->effect_spec_id, now);
+            skill_effect(sc, def->effect_spec_id, now);
         }
         /* Combo flags: apply builder/spender semantics on successful activation. */
         if (def->combo_builder)
         {
-            g_app.player_combat.combo++;
-            if (g_app.player_combat.combo > 5)
-                g_app.player_combat.combo = 5;
+            (*sc->combo)++;
+            if (*sc->combo > 5)
+                *sc->combo = 5;
         }
         if (def->combo_spender)
         {
             /* Phase 7.1: publish combo spend event before zeroing for instant skills */
-            if (g_app.player_combat.combo > 0)
+            if (sc->live && *sc->combo > 0)
             {
                 RogueEventPayload p;
                 memset(&p, 0, sizeof p);
                 p.skill_combo_spend.skill_id = (uint16_t) id;
-                p.skill_combo_spend.amount = (uint8_t) (g_app.player_combat.combo & 0xFF);
+                p.skill_combo_spend.amount = (uint8_t) (*sc->combo & 0xFF);
                 p.skill_combo_spend.when_ms = now;
                 rogue_event_publish(ROGUE_EVENT_SKILL_COMBO_SPEND, &p, ROGUE_EVENT_PRIORITY_NORMAL,
                                     0x534B494C, "skills");
             }
-            g_app.player_combat.combo = 0;
+            *sc->combo = 0;
         }
     }
     return consumed;
 }
 
-int rogue_skill_try_cancel(int id, const RogueSkillCtx* ctx)
+int rogue_skill_try_cancel_ctx(RogueSkillSimCtx* sc, int id, const RogueSkillCtx* ctx)
 {
-    if (id < 0 || id >= g_skill_count_internal)
+    if (id < 0 || id >= sc->state_count)
         return 0;
     (void) ctx;
-    RogueSkillState* st = &g_skill_states_internal[id];
+    RogueSkillState* st = &sc->states[id];
     const RogueSkillDef* def = &g_skill_defs_internal[id];
     if (!st->casting_active || def->cast_type != 1 || def->cast_time_ms <= 0)
         return 0;
@@ -553,13 +531,13 @@ int rogue_skill_try_cancel(int id, const RogueSkillCtx* ctx)
     c2.now_ms = effective_now;
     c2.partial_scalar = scalar;
     c2.rng_state = (unsigned int) (id * 2654435761u) ^ (unsigned int) st->uses * 2246822519u;
-    if (def->on_activate)
+    if (sc->live && def->on_activate)
     {
         def->on_activate(def, st, &c2);
     }
     if (def->effect_spec_id >= 0)
     {
-        rogue_effect_apply(def->effect_spec_id, c2.now_ms);
+        skill_effect(sc, def->effect_spec_id, c2.now_ms);
     }
     st->last_cast_ms = effective_now;
     /* Phase 2.3: refund on cancel scaled by progress */
@@ -570,12 +548,12 @@ int rogue_skill_try_cancel(int id, const RogueSkillCtx* ctx)
         int eff_ap = def->action_point_cost;
         if (def->ap_cost_pct_max > 0)
         {
-            eff_ap = (g_app.player.max_action_points * (int) def->ap_cost_pct_max) / 100;
+            eff_ap = (sc->player->max_action_points * (int) def->ap_cost_pct_max) / 100;
         }
         if (st->rank > 1)
             eff_ap += (int) def->ap_cost_per_rank * (st->rank - 1);
         if (def->ap_cost_surcharge_threshold > 0 &&
-            g_app.player.action_points < def->ap_cost_surcharge_threshold)
+            sc->player->action_points < def->ap_cost_surcharge_threshold)
         {
             eff_ap += def->ap_cost_surcharge_amount;
         }
@@ -583,11 +561,11 @@ int rogue_skill_try_cancel(int id, const RogueSkillCtx* ctx)
             eff_ap = 0;
         int eff_mana = def->resource_cost_mana;
         if (def->mana_cost_pct_max > 0)
-            eff_mana = (g_app.player.max_mana * (int) def->mana_cost_pct_max) / 100;
+            eff_mana = (sc->player->max_mana * (int) def->mana_cost_pct_max) / 100;
         if (st->rank > 1)
             eff_mana += (int) def->mana_cost_per_rank * (st->rank - 1);
         if (def->mana_cost_surcharge_threshold > 0 &&
-            g_app.player.mana < def->mana_cost_surcharge_threshold)
+            sc->player->mana < def->mana_cost_surcharge_threshold)
             eff_mana += def->mana_cost_surcharge_amount;
         if (eff_mana < 0)
             eff_mana = 0;
@@ -603,23 +581,23 @@ int rogue_skill_try_cancel(int id, const RogueSkillCtx* ctx)
         refund_mana = (int) (refund_mana * unspent);
         if (refund_ap > 0)
         {
-            g_app.player.action_points += refund_ap;
-            int ap_max_now = g_app.player.max_action_points +
-                             (g_app.ap_overdrive_ms > 0.0f ? g_app.ap_overdrive_bonus : 0);
-            if (g_app.player.action_points > ap_max_now)
-                g_app.player.action_points = ap_max_now;
+            sc->player->action_points += refund_ap;
+            int ap_max_now = sc->player->max_action_points +
+                             (*sc->ap_overdrive_ms > 0.0f ? *sc->ap_overdrive_bonus : 0);
+            if (sc->player->action_points > ap_max_now)
+                sc->player->action_points = ap_max_now;
         }
         if (refund_mana > 0)
         {
-            g_app.player.mana += refund_mana;
-            if (g_app.player.mana > g_app.player.max_mana)
-                g_app.player.mana = g_app.player.max_mana;
+            sc->player->mana += refund_mana;
+            if (sc->player->mana > sc->player->max_mana)
+                sc->player->mana = sc->player->max_mana;
         }
     }
     return 1;
 }
 
-void rogue_skills_update(double now_ms)
+void rogue_skills_update_ctx(RogueSkillSimCtx* sc, double now_ms)
 {
     extern unsigned int g_skill_defs_canary;
     extern unsigned int g_skill_states_canary;
@@ -628,9 +606,9 @@ void rogue_skills_update(double now_ms)
         fprintf(stderr, "SKILL CANARY CORRUPTION BEFORE UPDATE\n");
         abort();
     }
-    for (int i = 0; i < g_skill_count_internal; i++)
+    for (int i = 0; i < sc->state_count; i++)
     {
-        RogueSkillState* st = &g_skill_states_internal[i];
+        RogueSkillState* st = &sc->states[i];
         const RogueSkillDef* def = &g_skill_defs_internal[i];
         if (def->max_charges > 0 && st->charges_cur < def->max_charges &&
             st->next_charge_ready_ms > 0 && now_ms >= st->next_charge_ready_ms)
@@ -652,7 +630,7 @@ void rogue_skills_update(double now_ms)
                 haste_factor = st->haste_factor_cast;
             else
             {
-                int haste = rogue_buffs_get_total(ROGUE_BUFF_POWER_STRIKE);
+                int haste = rogue_buff_set_get_total(sc->buffs, ROGUE_BUFF_POWER_STRIKE);
                 haste_factor = 1.0 - (haste * 0.02);
                 if (haste_factor < 0.5)
                     haste_factor = 0.5;
@@ -667,13 +645,13 @@ void rogue_skills_update(double now_ms)
                 ctx.rng_state =
                     (unsigned int) (i * 2654435761u) ^ (unsigned int) st->uses * 2246822519u;
                 int act_flags = 0;
-                if (def->on_activate)
+                if (sc->live && def->on_activate)
                 {
                     act_flags = def->on_activate(def, st, &ctx);
                 }
                 if (def->effect_spec_id >= 0)
                 {
-                    rogue_effect_apply(def->effect_spec_id, now_ms);
+                    skill_effect(sc, def->effect_spec_id, now_ms);
                 }
                 /* Refund on cast-complete based on outcome flags (miss/resist). */
                 if (act_flags & (ROGUE_ACT_MISSED | ROGUE_ACT_RESISTED))
@@ -690,41 +668,37 @@ void rogue_skills_update(double now_ms)
                         int refund_mana = (base_mana * refund_pct) / 100;
                         if (refund_ap > 0)
                         {
-                            g_app.player.action_points += refund_ap;
+                            sc->player->action_points += refund_ap;
                             int ap_max_now =
-                                g_app.player.max_action_points +
-                                (g_app.ap_overdrive_ms > 0.0f ? g_app.ap_overdrive_bonus : 0);
-                            if (g_app.player.action_points > ap_max_now)
-                                g_app.player.action_points = ap_max_now;
+                                sc->player->max_action_points +
+                                (*sc->ap_overdrive_ms > 0.0f ? *sc->ap_overdrive_bonus : 0);
+                            if (sc->player->action_points > ap_max_now)
+                                sc->player->action_points = ap_max_now;
                         }
                         if (refund_mana > 0)
                         {
-                            g_app.player.mana += refund_mana;
-                            if (g_app.player.mana > g_app.player.max_mana)
-                                g_app.player.mana = g_app.player.max_mana;
+                            sc->player->mana += refund_mana;
+                            if (sc->player->mana > sc->player->max_mana)
+                                sc->player->mana = sc->player->max_mana;
                         }
                     }
                 }
                 /* FX: cast end cue */
-                {
-                    char key[48];
-                    snprintf(key, sizeof key, "skill/%d/end", i);
-                    rogue_fx_trigger_event(key, g_app.player.base.pos.x, g_app.player.base.pos.y);
-                }
+                skill_fx(sc, i, "end");
                 /* Combo flags on cast completion */
                 if (def->combo_builder)
                 {
-                    g_app.player_combat.combo++;
-                    if (g_app.player_combat.combo > 5)
-                        g_app.player_combat.combo = 5;
+                    (*sc->combo)++;
+                    if (*sc->combo > 5)
+                        *sc->combo = 5;
                 }
                 if (def->combo_spender)
                 {
-                    g_app.player_combat.combo = 0;
+                    *sc->combo = 0;
                 }
-                for (int qi = 0; qi < g_skill_count_internal; ++qi)
+                for (int qi = 0; qi < sc->state_count; ++qi)
                 {
-                    RogueSkillState* qst = &g_skill_states_internal[qi];
+                    RogueSkillState* qst = &sc->states[qi];
                     if (qst->queued_trigger_ms > 0 && now_ms >= qst->queued_trigger_ms &&
                         now_ms <= qst->queued_until_ms)
                     {
@@ -732,7 +706,7 @@ void rogue_skills_update(double now_ms)
                         qst->queued_until_ms = 0;
                         RogueSkillCtx qctx = {0};
                         qctx.now_ms = now_ms;
-                        rogue_skill_try_activate(qi, &qctx);
+                        rogue_skill_try_activate_ctx(sc, qi, &qctx);
                     }
                 }
             }
@@ -745,7 +719,7 @@ void rogue_skills_update(double now_ms)
                 tick_interval = st->channel_tick_interval_ms;
             else
             {
-                int haste = rogue_buffs_get_total(ROGUE_BUFF_POWER_STRIKE);
+                int haste = rogue_buff_set_get_total(sc->buffs, ROGUE_BUFF_POWER_STRIKE);
                 double haste_factor = 1.0 - (haste * 0.02);
                 if (haste_factor < 0.5)
                     haste_factor = 0.5;
@@ -759,15 +733,16 @@ void rogue_skills_update(double now_ms)
                 ctx.rng_state = (unsigned int) (i * 2654435761u) ^
                                 (unsigned int) st->uses * 2246822519u +
                                     (unsigned int) (st->channel_next_tick_ms);
-                if (def->on_activate)
+                if (sc->live && def->on_activate)
                 {
                     def->on_activate(def, st, &ctx);
                 }
                 if (def->effect_spec_id >= 0)
                 {
-                    rogue_effect_apply(def->effect_spec_id, st->channel_next_tick_ms);
+                    skill_effect(sc, def->effect_spec_id, st->channel_next_tick_ms);
                 }
                 /* Phase 7.1: publish channel tick event */
+                if (sc->live)
                 {
                     RogueEventPayload p;
                     memset(&p, 0, sizeof p);
@@ -789,24 +764,24 @@ void rogue_skills_update(double now_ms)
                 }
                 if (def->combo_builder)
                 {
-                    g_app.player_combat.combo++;
-                    if (g_app.player_combat.combo > 5)
-                        g_app.player_combat.combo = 5;
+                    (*sc->combo)++;
+                    if (*sc->combo > 5)
+                        *sc->combo = 5;
                 }
                 if (def->combo_spender)
                 {
                     /* Phase 7.1: publish combo spend before zeroing */
-                    if (g_app.player_combat.combo > 0)
+                    if (sc->live && *sc->combo > 0)
                     {
                         RogueEventPayload p;
                         memset(&p, 0, sizeof p);
                         p.skill_combo_spend.skill_id = (uint16_t) i;
-                        p.skill_combo_spend.amount = (uint8_t) (g_app.player_combat.combo & 0xFF);
+                        p.skill_combo_spend.amount = (uint8_t) (*sc->combo & 0xFF);
                         p.skill_combo_spend.when_ms = now_ms;
                         rogue_event_publish(ROGUE_EVENT_SKILL_COMBO_SPEND, &p,
                                             ROGUE_EVENT_PRIORITY_NORMAL, 0x534B494C, "skills");
                     }
-                    g_app.player_combat.combo = 0;
+                    *sc->combo = 0;
                 }
                 /* drift-correct: compute next tick by counting intervals from channel_start */
                 if (st->channel_start_ms <= 0.0)
@@ -824,11 +799,7 @@ void rogue_skills_update(double now_ms)
             {
                 st->channel_active = 0;
                 /* FX: channel end cue */
-                {
-                    char key[48];
-                    snprintf(key, sizeof key, "skill/%d/end", i);
-                    rogue_fx_trigger_event(key, g_app.player.base.pos.x, g_app.player.base.pos.y);
-                }
+                skill_fx(sc, i, "end");
             }
         }
     }
@@ -184,6 +184,11 @@ void rogue_vegetation_generate(float tree_cover_target, unsigned int seed)
             for (int ox = -r; ox <= r && !blocked; ox++)
             {
                 int tx = gx + ox, ty = gy + oy;
+                if (tx < 0 || ty < 0 || tx >= w || ty >= h)
+                {
+                    blocked = 1; /* canopy wider than the 2-tile border margin */
+                    break;
+                }
                 unsigned char t = g_app.world_map.tiles[ty * w + tx];
                 if (t != ROGUE_TILE_GRASS && t != ROGUE_TILE_FOREST)
                 {
@@ -25,7 +25,7 @@ static RogueTexture* veg_get_texture(const char* path)
     VegSheetTex* slot = &g_sheet_textures[g_sheet_tex_count];
     memset(slot, 0, sizeof *slot);
     strncpy_s(slot->path, sizeof slot->path, path, _TRUNCATE);
-    if (!rogue_texture_load(&slot->tex, path))
+    if (!rogue_texture_load_atlased(&slot->tex, path))
     {
         slot->path[0] = '\0';
         return NULL;
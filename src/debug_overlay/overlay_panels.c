@@ -10,6 +10,7 @@
 #include "overlay_widgets.h"
 /* Needed for RogueVfxFrameStats definition used in the Audio/VFX panel */
 #include "../audio_vfx/effects.h"
+#include "../graphics/texture_cache.h"
 
 #if ROGUE_ENABLE_DEBUG_OVERLAY
 
@@ -23,6 +24,11 @@ static void panel_system(void* user)
     overlay_label(buf);
     snprintf(buf, sizeof(buf), "Draw calls: %d", g_app.frame_draw_calls);
     overlay_label(buf);
+    RogueTextureCacheStats tcs;
+    rogue_texture_cache_get_stats(&tcs);
+    snprintf(buf, sizeof(buf), "Textures: %d (atlas pages %d)  Binds: %d/%d", tcs.textures,
+             tcs.atlas_pages, tcs.binds_last_frame, tcs.draws_last_frame);
+    overlay_label(buf);
     snprintf(buf, sizeof(buf), "Tile quads: %d", g_app.frame_tile_quads);
     overlay_label(buf);
     int flags = g_app.show_metrics_overlay ? 1 : 0;
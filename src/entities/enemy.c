@@ -552,14 +552,14 @@ int rogue_enemy_types_load_directory_json(const char* dir_path, RogueEnemyTypeDe
  */
 static int load_sheet(const char* path, RogueTexture* tex, RogueSprite frames[], int* out_count)
 {
-    if (!rogue_texture_load(tex, path))
+    if (!rogue_texture_load_atlased(tex, path))
     {
         /* Attempt implicit ../ fallback if not already containing ../ and initial load failed */
         if (strncmp(path, "../", 3) != 0)
         {
             char alt[256];
             snprintf(alt, sizeof alt, "../%s", path);
-            if (!rogue_texture_load(tex, alt))
+            if (!rogue_texture_load_atlased(tex, alt))
                 return 0; /* still fail */
         }
         else
@@ -61,16 +61,16 @@ typedef struct RogueEnemy
     float attack_cooldown_ms; /* time until next attack allowed */
     int crit_chance;          /* percent flat */
     int crit_damage;          /* percent bonus over 100 */
-    /* --- Status buildup placeholders (Phase 1A scaffold) --- */
-    float bleed_buildup; /* accumulates until threshold triggers bleed (future) */
-    float frost_buildup; /* accumulates; future slow/freeze effects */
+    /* --- Status buildup meters (Phase 14, see combat_status.c) --- */
+    float bleed_buildup; /* accumulates per hit; full meter applies ROGUE_STATUS_BLEED */
+    float frost_buildup; /* accumulates per hit; full meter applies ROGUE_STATUS_CHILL */
     /* --- Phase 2: mitigation stats (simple baseline) --- */
     int armor;           /* reduces physical (flat first then percent) */
     int resist_physical; /* percent 0-90 (separate from armor) */
     int resist_fire;     /* percent 0-90 */
     int resist_frost;    /* percent 0-90 */
     int resist_arcane;   /* percent 0-90 */
-    int resist_bleed;    /* percent (future DOT mitigation) */
+    int resist_bleed;    /* percent 0-90 (bleed damage over time) */
     int resist_poison;   /* percent */
     /* --- Phase 3.1: Add guard & poise meters for future stagger / block systems --- */
     float guard_meter;
@@ -23,52 +23,75 @@
 #include "buffs.h"
 #include "../audio_vfx/effects.h" /* Phase 5.4: buff gain/expire cues */
 #include "../core/app/app_state.h"
+#include <stdio.h>
 #include <string.h>
 
-/* Handle-based pool (backed by fixed capacity, free-list) */
-#define ROGUE_MAX_ACTIVE_BUFFS 32
-static RogueBuff g_buffs[ROGUE_MAX_ACTIVE_BUFFS];
-static int g_free_head = -1;                    /* index of first free slot */
-static double g_min_reapply_interval_ms = 50.0; /* default dampening window */
-static RogueBuffExpireFn g_on_expire = NULL;
-/* Auto-init guard to preserve legacy behavior where init wasn't explicitly called in tests */
-static int g_initialized = 0;
-/* Phase 4.5: DR tracker for CC categories (per-target global for now) */
-static double g_dr_window_ms = 15000.0; /* 15s default DR window */
-static double g_dr_stun_end_ms = 0.0;
-static double g_dr_root_end_ms = 0.0;
-static double g_dr_slow_end_ms = 0.0;
-/* active stacks within window: 0 -> 1.0, 1 -> 0.5, 2 -> 0.25, 3+ -> 0.0 */
-static int g_dr_stun_count = 0;
-static int g_dr_root_count = 0;
-static int g_dr_slow_count = 0;
+/* Handle-based pool (backed by fixed capacity, free-list). The live set is the process-wide pool
+ * behind the rogue_buffs_* API; simulation contexts own their own RogueBuffSet. */
+static RogueBuffSet g_live = {.emit_fx = 1};
 
 /**
- * @brief Ensures the buff system is initialized.
+ * @brief Resets a buff set to its defaults (empty pool, default dampening and DR window).
  *
- * This function provides lazy initialization of the buff pool and global state.
- * It preserves legacy behavior where initialization wasn't explicitly called in tests.
+ * @param set The set to reset; its emit_fx flag is preserved.
+ */
+static void set_reset(RogueBuffSet* set)
+{
+    int emit_fx = set->emit_fx;
+    memset(set, 0, sizeof *set);
+    set->free_head = 0;
+    for (int i = 0; i < ROGUE_MAX_ACTIVE_BUFFS; i++)
+    {
+        set->buffs[i]._gen = 1; /* non-zero */
+        set->buffs[i]._next_free = (i + 1 < ROGUE_MAX_ACTIVE_BUFFS) ? (i + 1) : -1;
+    }
+    set->min_reapply_interval_ms = 50.0; /* default dampening window */
+    set->on_expire = NULL;
+    set->initialized = 1;
+    set->dr_window_ms = 15000.0; /* 15s default DR window */
+    set->emit_fx = emit_fx;
+}
+
+/**
+ * @brief Ensures a buff set is initialized.
+ *
+ * Lazy initialization preserves legacy behavior where init wasn't explicitly called in tests.
  * Safe to call multiple times.
  */
-static inline void _ensure_init(void)
+static inline void _ensure_init(RogueBuffSet* set)
 {
-    if (!g_initialized)
+    if (!set->initialized)
+        set_reset(set);
+}
+
+/**
+ * @brief Emits a buff FX cue at the player position (live set only).
+ *
+ * Keys ("buff/<type>/gain", "buff/<type>/expire") are interned once on first use instead of
+ * formatted per gain / expiry event.
+ *
+ * @param expire 0 for the gain cue, 1 for the expire cue
+ */
+static void buff_fx(const RogueBuffSet* set, int expire, RogueBuffType type)
+{
+    static RogueFxId keys[ROGUE_BUFF_MAX][2];
+    static int keys_ready = 0;
+    if (!set->emit_fx || (unsigned) type >= (unsigned) ROGUE_BUFF_MAX)
+        return;
+    if (!keys_ready)
     {
-        /* initialize free list and defaults */
-        memset(g_buffs, 0, sizeof g_buffs);
-        g_free_head = 0;
-        for (int i = 0; i < ROGUE_MAX_ACTIVE_BUFFS; i++)
+        char key[24];
+        for (int t = 0; t < ROGUE_BUFF_MAX; t++)
         {
-            g_buffs[i]._gen = 1; /* non-zero */
-            g_buffs[i]._next_free = (i + 1 < ROGUE_MAX_ACTIVE_BUFFS) ? (i + 1) : -1;
+            snprintf(key, sizeof key, "buff/%d/gain", t);
+            keys[t][0] = rogue_fx_intern(key);
+            snprintf(key, sizeof key, "buff/%d/expire", t);
+            keys[t][1] = rogue_fx_intern(key);
         }
-        g_min_reapply_interval_ms = 50.0;
-        g_on_expire = NULL;
-        g_initialized = 1;
-        g_dr_window_ms = 15000.0;
-        g_dr_stun_end_ms = g_dr_root_end_ms = g_dr_slow_end_ms = 0.0;
-        g_dr_stun_count = g_dr_root_count = g_dr_slow_count = 0;
+        keys_ready = 1;
     }
+    rogue_fx_trigger_event_id(keys[type][expire ? 1 : 0], g_app.player.base.pos.x,
+                              g_app.player.base.pos.y);
 }
 
 /**
@@ -80,10 +103,10 @@ static inline void _ensure_init(void)
  * @param idx The internal pool index (0 to ROGUE_MAX_ACTIVE_BUFFS-1)
  * @return A valid RogueBuffHandle
  */
-static inline RogueBuffHandle _make_handle(int idx)
+static inline RogueBuffHandle _make_handle(const RogueBuffSet* set, int idx)
 {
     /* pack gen (hi16) | index (lo16) */
-    uint16_t gen = g_buffs[idx]._gen ? g_buffs[idx]._gen : 1;
+    uint16_t gen = set->buffs[idx]._gen ? set->buffs[idx]._gen : 1;
     return ((uint32_t) gen << 16) | (uint32_t) (idx & 0xFFFF);
 }
 /**
@@ -110,7 +133,7 @@ static inline uint16_t _handle_gen(RogueBuffHandle h) { return (uint16_t) (h >>
  * @param h The buff handle to validate
  * @return The pool index if valid, -1 if invalid
  */
-static int _validate_handle(RogueBuffHandle h)
+static int _validate_handle(const RogueBuffSet* set, RogueBuffHandle h)
 {
     if (h == ROGUE_BUFF_INVALID_HANDLE)
         return -1;
@@ -118,9 +141,9 @@ static int _validate_handle(RogueBuffHandle h)
     uint16_t gen = _handle_gen(h);
     if (idx < 0 || idx >= ROGUE_MAX_ACTIVE_BUFFS)
         return -1;
-    if (!g_buffs[idx].active)
+    if (!set->buffs[idx].active)
         return -1;
-    if (g_buffs[idx]._gen != gen)
+    if (set->buffs[idx]._gen != gen)
         return -1;
     return idx;
 }
@@ -131,13 +154,13 @@ static int _validate_handle(RogueBuffHandle h)
  *
  * @return The allocated pool index, or -1 if pool is full
  */
-static int _alloc_slot(void)
+static int _alloc_slot(RogueBuffSet* set)
 {
-    if (g_free_head < 0)
+    if (set->free_head < 0)
         return -1;
-    int idx = g_free_head;
-    g_free_head = g_buffs[idx]._next_free;
-    g_buffs[idx]._next_free = -1;
+    int idx = set->free_head;
+    set->free_head = set->buffs[idx]._next_free;
+    set->buffs[idx]._next_free = -1;
     return idx;
 }
 /**
@@ -148,97 +171,57 @@ static int _alloc_slot(void)
  *
  * @param idx The pool index to free (must be valid)
  */
-static void _free_slot(int idx)
+static void _free_slot(RogueBuffSet* set, int idx)
 {
     if (idx < 0 || idx >= ROGUE_MAX_ACTIVE_BUFFS)
         return;
-    g_buffs[idx].active = 0;
+    RogueBuff* b = &set->buffs[idx];
+    b->active = 0;
     /* bump generation (avoid 0) */
-    g_buffs[idx]._gen = (uint16_t) (g_buffs[idx]._gen + 1);
-    if (g_buffs[idx]._gen == 0)
-        g_buffs[idx]._gen = 1;
-    g_buffs[idx]._next_free = g_free_head;
-    g_free_head = idx;
+    b->_gen = (uint16_t) (b->_gen + 1);
+    if (b->_gen == 0)
+        b->_gen = 1;
+    b->_next_free = set->free_head;
+    set->free_head = idx;
 }
 
 /**
- * @brief Initializes the buff system.
- *
- * Sets up the free-list, zeros all buff slots, and initializes global state.
- * Safe to call multiple times - subsequent calls are no-ops.
+ * @brief Phase 4.5 diminishing-returns factor for one CC category; advances the tracker.
  */
-void rogue_buffs_init(void)
+static double dr_factor(const RogueBuffSet* set, double now_ms, double* end_ms, int* count)
 {
-    memset(g_buffs, 0, sizeof g_buffs);
-    g_free_head = 0;
-    for (int i = 0; i < ROGUE_MAX_ACTIVE_BUFFS; i++)
+    if (now_ms > *end_ms)
     {
-        g_buffs[i]._gen = 1;
-        g_buffs[i]._next_free = (i + 1 < ROGUE_MAX_ACTIVE_BUFFS) ? (i + 1) : -1;
+        *count = 0;
+        *end_ms = now_ms + set->dr_window_ms; /* anchor window at first apply */
     }
-    g_min_reapply_interval_ms = 50.0;
-    g_on_expire = NULL;
-    g_initialized = 1;
-    g_dr_window_ms = 15000.0;
-    g_dr_stun_end_ms = g_dr_root_end_ms = g_dr_slow_end_ms = 0.0;
-    g_dr_stun_count = g_dr_root_count = g_dr_slow_count = 0;
-}
-
-/**
- * @brief Updates the buff system, expiring buffs that have reached their end time.
- *
- * Iterates through all active buffs and expires those whose end_ms is less than
- * or equal to the current time. Triggers audio-visual feedback and expiration
- * callbacks for expired buffs.
- *
- * @param now_ms Current time in milliseconds
- */
-void rogue_buffs_update(double now_ms)
-{
-    _ensure_init();
-    for (int i = 0; i < ROGUE_MAX_ACTIVE_BUFFS; i++)
-        if (g_buffs[i].active && now_ms >= g_buffs[i].end_ms)
-        {
-            /* FX: buff expire cue before deactivating */
-            char key[48];
-            snprintf(key, sizeof key, "buff/%d/expire", (int) g_buffs[i].type);
-            rogue_fx_trigger_event(key, g_app.player.base.pos.x, g_app.player.base.pos.y);
-            if (g_on_expire)
-                g_on_expire(g_buffs[i].type, g_buffs[i].magnitude);
-            _free_slot(i);
-        }
+    double factor = (*count == 0) ? 1.0 : (*count == 1) ? 0.5 : (*count == 2) ? 0.25 : 0.0;
+    (*count)++;
+    return factor;
 }
 
 /**
- * @brief Applies a buff with the specified parameters.
+ * @brief Shared apply path for rogue_buffs_apply / rogue_buffs_apply_h / rogue_buff_set_apply.
  *
- * Attempts to apply a buff of the given type, magnitude, and duration. Handles stacking
- * rules, diminishing returns for crowd control effects, anti-oscillation dampening,
- * and audio-visual feedback.
- *
- * @param type The type of buff to apply
- * @param magnitude The strength/intensity of the buff
- * @param duration_ms How long the buff should last in milliseconds
- * @param now_ms Current time in milliseconds
- * @param rule How to handle stacking with existing buffs of the same type
- * @param snapshot Whether the buff magnitude should be snapshotted (immutable)
- * @return 1 if the buff was successfully applied, 0 otherwise
+ * @param out_h Receives the affected or created buff handle (INVALID when no record changed).
+ * @return 1 if the application was accepted (including a DR-zeroed CC), 0 otherwise
  */
-int rogue_buffs_apply(RogueBuffType type, int magnitude, double duration_ms, double now_ms,
-                      RogueBuffStackRule rule, int snapshot)
+static int set_apply(RogueBuffSet* set, RogueBuffType type, int magnitude, double duration_ms,
+                     double now_ms, RogueBuffStackRule rule, int snapshot, RogueBuffHandle* out_h)
 {
-    _ensure_init();
+    *out_h = ROGUE_BUFF_INVALID_HANDLE;
+    _ensure_init(set);
     if (magnitude <= 0 || duration_ms <= 0)
         return 0;
     if (now_ms < 0)
         now_ms = 0;
     if (rule < 0 || rule > ROGUE_BUFF_STACK_REPLACE_IF_STRONGER)
         rule = ROGUE_BUFF_STACK_ADD;
-    /* dampening */
+    /* dampening: see if an active same-type exists and was applied too recently */
     for (int i = 0; i < ROGUE_MAX_ACTIVE_BUFFS; i++)
-        if (g_buffs[i].active && g_buffs[i].type == type && now_ms < g_buffs[i].end_ms)
+        if (set->buffs[i].active && set->buffs[i].type == type && now_ms < set->buffs[i].end_ms)
         {
-            if (now_ms - g_buffs[i].last_apply_ms < g_min_reapply_interval_ms)
+            if (now_ms - set->buffs[i].last_apply_ms < set->min_reapply_interval_ms)
                 return 0;
             break;
         }
@@ -249,54 +232,21 @@ int rogue_buffs_apply(RogueBuffType type, int magnitude, double duration_ms, dou
         (cats & (ROGUE_BUFF_CCFLAG_STUN | ROGUE_BUFF_CCFLAG_ROOT | ROGUE_BUFF_CCFLAG_SLOW)))
     {
         if (type == ROGUE_BUFF_CC_STUN || (cats & ROGUE_BUFF_CCFLAG_STUN))
-        {
-            if (now_ms > g_dr_stun_end_ms)
-            {
-                g_dr_stun_count = 0;
-                g_dr_stun_end_ms = now_ms + g_dr_window_ms; /* anchor window at first apply */
-            }
-            double factor = (g_dr_stun_count == 0)   ? 1.0
-                            : (g_dr_stun_count == 1) ? 0.5
-                            : (g_dr_stun_count == 2) ? 0.25
-                                                     : 0.0;
-            effective_duration *= factor;
-            g_dr_stun_count++;
-        }
+            effective_duration *=
+                dr_factor(set, now_ms, &set->dr_stun_end_ms, &set->dr_stun_count);
         else if (type == ROGUE_BUFF_CC_ROOT || (cats & ROGUE_BUFF_CCFLAG_ROOT))
-        {
-            if (now_ms > g_dr_root_end_ms)
-            {
-                g_dr_root_count = 0;
-                g_dr_root_end_ms = now_ms + g_dr_window_ms; /* anchor window */
-            }
-            double factor = (g_dr_root_count == 0)   ? 1.0
-                            : (g_dr_root_count == 1) ? 0.5
-                            : (g_dr_root_count == 2) ? 0.25
-                                                     : 0.0;
-            effective_duration *= factor;
-            g_dr_root_count++;
-        }
+            effective_duration *=
+                dr_factor(set, now_ms, &set->dr_root_end_ms, &set->dr_root_count);
         else if (type == ROGUE_BUFF_CC_SLOW || (cats & ROGUE_BUFF_CCFLAG_SLOW))
-        {
-            if (now_ms > g_dr_slow_end_ms)
-            {
-                g_dr_slow_count = 0;
-                g_dr_slow_end_ms = now_ms + g_dr_window_ms; /* anchor window */
-            }
-            double factor = (g_dr_slow_count == 0)   ? 1.0
-                            : (g_dr_slow_count == 1) ? 0.5
-                            : (g_dr_slow_count == 2) ? 0.25
-                                                     : 0.0;
-            effective_duration *= factor;
-            g_dr_slow_count++;
-        }
+            effective_duration *=
+                dr_factor(set, now_ms, &set->dr_slow_end_ms, &set->dr_slow_count);
         if (effective_duration <= 0)
             return 1; /* counted for DR but zero duration -> no buff record */
     }
     for (int i = 0; i < ROGUE_MAX_ACTIVE_BUFFS; i++)
-        if (g_buffs[i].active && g_buffs[i].type == type && now_ms < g_buffs[i].end_ms)
+        if (set->buffs[i].active && set->buffs[i].type == type && now_ms < set->buffs[i].end_ms)
         {
-            RogueBuff* b = &g_buffs[i];
+            RogueBuff* b = &set->buffs[i];
             b->last_apply_ms = now_ms;
             switch (rule)
             {
@@ -306,14 +256,14 @@ int rogue_buffs_apply(RogueBuffType type, int magnitude, double duration_ms, dou
                 if (magnitude > b->magnitude)
                     b->magnitude = magnitude;
                 b->end_ms = now_ms + effective_duration;
-                return 1;
+                break;
             case ROGUE_BUFF_STACK_EXTEND:
                 b->end_ms += effective_duration;
                 if (b->end_ms < now_ms + effective_duration)
                     b->end_ms = now_ms + effective_duration;
                 if (b->magnitude < magnitude)
                     b->magnitude = magnitude;
-                return 1;
+                break;
             case ROGUE_BUFF_STACK_ADD:
             default:
                 b->magnitude += magnitude;
@@ -321,7 +271,7 @@ int rogue_buffs_apply(RogueBuffType type, int magnitude, double duration_ms, dou
                     b->magnitude = 999;
                 if (now_ms + effective_duration > b->end_ms)
                     b->end_ms = now_ms + effective_duration;
-                return 1;
+                break;
             case ROGUE_BUFF_STACK_MULTIPLY:
             {
                 /* Interpret incoming magnitude as percent (e.g., 110 = +10%). Clamp floor at 1%. */
@@ -339,7 +289,7 @@ int rogue_buffs_apply(RogueBuffType type, int magnitude, double duration_ms, dou
                 double new_end = now_ms + effective_duration;
                 if (new_end > b->end_ms)
                     b->end_ms = new_end;
-                return 1;
+                break;
             }
             case ROGUE_BUFF_STACK_REPLACE_IF_STRONGER:
                 if (magnitude > b->magnitude)
@@ -347,36 +297,194 @@ int rogue_buffs_apply(RogueBuffType type, int magnitude, double duration_ms, dou
                 /* Always take the longer remaining duration */
                 if (now_ms + effective_duration > b->end_ms)
                     b->end_ms = now_ms + effective_duration;
-                return 1;
+                break;
             }
+            if (b->end_ms < set->next_end_ms)
+                set->next_end_ms = b->end_ms;
+            *out_h = _make_handle(set, i);
+            return 1;
         }
     /* allocate new slot */
+    int idx = _alloc_slot(set);
+    if (idx < 0)
+        return 0;
+    /* For multiplicative stacking, if there's no existing buff to multiply, do nothing. */
+    if (rule == ROGUE_BUFF_STACK_MULTIPLY)
     {
-        int idx = _alloc_slot();
-        if (idx < 0)
-            return 0;
-        /* For multiplicative stacking, if there's no existing buff to multiply, do nothing. */
-        if (rule == ROGUE_BUFF_STACK_MULTIPLY)
+        _free_slot(set, idx);
+        return 0;
+    }
+    RogueBuff* b = &set->buffs[idx];
+    b->active = 1;
+    b->type = type;
+    b->magnitude = magnitude;
+    b->end_ms = now_ms + effective_duration;
+    b->snapshot = snapshot ? 1 : 0;
+    b->stack_rule = rule;
+    b->last_apply_ms = now_ms;
+    b->categories = cats;
+    if (b->end_ms < set->next_end_ms)
+        set->next_end_ms = b->end_ms;
+    buff_fx(set, 0, type); /* FX: buff gain cue */
+    *out_h = _make_handle(set, idx);
+    return 1;
+}
+
+/**
+ * @brief Initializes a caller-owned buff set (empty, no FX cues).
+ */
+void rogue_buff_set_init(RogueBuffSet* set)
+{
+    if (!set)
+        return;
+    set->emit_fx = 0;
+    set_reset(set);
+}
+
+/**
+ * @brief Expires buffs of a set that have reached their end time.
+ *
+ * Triggers audio-visual feedback (live set) and the expiration callback for expired buffs.
+ * Returns without scanning while now_ms is before the set's earliest recorded end time.
+ *
+ * @param now_ms Current time in milliseconds
+ */
+void rogue_buff_set_update(RogueBuffSet* set, double now_ms)
+{
+    _ensure_init(set);
+    if (now_ms < set->next_end_ms)
+        return;
+    for (int i = 0; i < ROGUE_MAX_ACTIVE_BUFFS; i++)
+        if (set->buffs[i].active && now_ms >= set->buffs[i].end_ms)
         {
-            _free_slot(idx);
-            return 0;
+            RogueBuffType type = set->buffs[i].type;
+            /* FX: buff expire cue before deactivating */
+            buff_fx(set, 1, type);
+            if (set->on_expire)
+                set->on_expire(type, set->buffs[i].magnitude);
+            _free_slot(set, i);
         }
-        g_buffs[idx].active = 1;
-        g_buffs[idx].type = type;
-        g_buffs[idx].magnitude = magnitude;
-        g_buffs[idx].end_ms = now_ms + effective_duration;
-        g_buffs[idx].snapshot = snapshot ? 1 : 0;
-        g_buffs[idx].stack_rule = rule;
-        g_buffs[idx].last_apply_ms = now_ms;
-        g_buffs[idx].categories = cats;
-        /* FX: buff gain cue */
+    /* callbacks may have applied new buffs: recompute the earliest end over the whole pool */
+    double next = 1e300;
+    for (int i = 0; i < ROGUE_MAX_ACTIVE_BUFFS; i++)
+        if (set->buffs[i].active && set->buffs[i].end_ms < next)
+            next = set->buffs[i].end_ms;
+    set->next_end_ms = next;
+}
+
+/**
+ * @brief Applies a buff to a set (see rogue_buffs_apply).
+ * @return 1 if the buff was successfully applied, 0 otherwise
+ */
+int rogue_buff_set_apply(RogueBuffSet* set, RogueBuffType type, int magnitude,
+                         double duration_ms, double now_ms, RogueBuffStackRule rule, int snapshot)
+{
+    RogueBuffHandle h;
+    return set_apply(set, type, magnitude, duration_ms, now_ms, rule, snapshot, &h);
+}
+
+/**
+ * @brief Total magnitude of all active buffs of a type in a set.
+ */
+int rogue_buff_set_get_total(const RogueBuffSet* set, RogueBuffType type)
+{
+    if (!set->initialized)
+        return 0;
+    int total = 0;
+    for (int i = 0; i < ROGUE_MAX_ACTIVE_BUFFS; i++)
+        if (set->buffs[i].active && set->buffs[i].type == type)
+            total += set->buffs[i].magnitude;
+    return total;
+}
+
+/**
+ * @brief Number of active buff records in a set.
+ */
+int rogue_buff_set_active_count(const RogueBuffSet* set)
+{
+    if (!set->initialized)
+        return 0;
+    int c = 0;
+    for (int i = 0; i < ROGUE_MAX_ACTIVE_BUFFS; i++)
+        if (set->buffs[i].active)
+            c++;
+    return c;
+}
+
+/**
+ * @brief Copies up to max active buffs of a set, pruning expired ones (see rogue_buffs_snapshot).
+ */
+int rogue_buff_set_snapshot(RogueBuffSet* set, RogueBuff* out, int max, double now_ms)
+{
+    _ensure_init(set);
+    if (!out || max <= 0)
+        return 0;
+    int c = 0;
+    for (int i = 0; i < ROGUE_MAX_ACTIVE_BUFFS && c < max; i++)
+    {
+        if (set->buffs[i].active)
         {
-            char key[48];
-            snprintf(key, sizeof key, "buff/%d/gain", (int) type);
-            rogue_fx_trigger_event(key, g_app.player.base.pos.x, g_app.player.base.pos.y);
+            if (now_ms >= set->buffs[i].end_ms)
+            {
+                RogueBuffType type = set->buffs[i].type;
+                if (set->on_expire)
+                    set->on_expire(type, set->buffs[i].magnitude);
+                _free_slot(set, i);
+                continue;
+            }
+            out[c++] = set->buffs[i];
         }
-        return 1;
     }
+    return c;
+}
+
+/**
+ * @brief Returns the process-wide live buff set (lazily initialized).
+ */
+RogueBuffSet* rogue_buffs_live_set(void)
+{
+    _ensure_init(&g_live);
+    return &g_live;
+}
+
+/**
+ * @brief Initializes the buff system.
+ *
+ * Sets up the free-list, zeros all buff slots, and initializes global state.
+ * Safe to call multiple times - subsequent calls are no-ops.
+ */
+void rogue_buffs_init(void) { set_reset(&g_live); }
+
+/**
+ * @brief Updates the buff system, expiring buffs that have reached their end time.
+ *
+ * Iterates through all active buffs and expires those whose end_ms is less than
+ * or equal to the current time. Triggers audio-visual feedback and expiration
+ * callbacks for expired buffs.
+ *
+ * @param now_ms Current time in milliseconds
+ */
+void rogue_buffs_update(double now_ms) { rogue_buff_set_update(&g_live, now_ms); }
+
+/**
+ * @brief Applies a buff with the specified parameters.
+ *
+ * Attempts to apply a buff of the given type, magnitude, and duration. Handles stacking
+ * rules, diminishing returns for crowd control effects, anti-oscillation dampening,
+ * and audio-visual feedback.
+ *
+ * @param type The type of buff to apply
+ * @param magnitude The strength/intensity of the buff
+ * @param duration_ms How long the buff should last in milliseconds
+ * @param now_ms Current time in milliseconds
+ * @param rule How to handle stacking with existing buffs of the same type
+ * @param snapshot Whether the buff magnitude should be snapshotted (immutable)
+ * @return 1 if the buff was successfully applied, 0 otherwise
+ */
+int rogue_buffs_apply(RogueBuffType type, int magnitude, double duration_ms, double now_ms,
+                      RogueBuffStackRule rule, int snapshot)
+{
+    return rogue_buff_set_apply(&g_live, type, magnitude, duration_ms, now_ms, rule, snapshot);
 }
 
 /**
@@ -396,152 +504,9 @@ int rogue_buffs_apply(RogueBuffType type, int magnitude, double duration_ms, dou
 RogueBuffHandle rogue_buffs_apply_h(RogueBuffType type, int magnitude, double duration_ms,
                                     double now_ms, RogueBuffStackRule rule, int snapshot)
 {
-    _ensure_init();
-    if (magnitude <= 0 || duration_ms <= 0)
-        return ROGUE_BUFF_INVALID_HANDLE;
-    if (now_ms < 0)
-        now_ms = 0;
-    if (rule < 0 || rule > ROGUE_BUFF_STACK_REPLACE_IF_STRONGER)
-        rule = ROGUE_BUFF_STACK_ADD;
-
-    /* dampening: see if an active same-type exists and was applied too recently */
-    for (int i = 0; i < ROGUE_MAX_ACTIVE_BUFFS; i++)
-        if (g_buffs[i].active && g_buffs[i].type == type && now_ms < g_buffs[i].end_ms)
-        {
-            if (now_ms - g_buffs[i].last_apply_ms < g_min_reapply_interval_ms)
-                return ROGUE_BUFF_INVALID_HANDLE;
-            break;
-        }
-    /* DR compute for CC (applies to both stack-with-existing and new). If zero, do nothing and
-     * return invalid handle. */
-    double effective_duration = duration_ms;
-    uint32_t cats = rogue_buffs_type_categories(type);
-    if (type == ROGUE_BUFF_CC_STUN || type == ROGUE_BUFF_CC_ROOT || type == ROGUE_BUFF_CC_SLOW ||
-        (cats & (ROGUE_BUFF_CCFLAG_STUN | ROGUE_BUFF_CCFLAG_ROOT | ROGUE_BUFF_CCFLAG_SLOW)))
-    {
-        if (type == ROGUE_BUFF_CC_STUN || (cats & ROGUE_BUFF_CCFLAG_STUN))
-        {
-            if (now_ms > g_dr_stun_end_ms)
-            {
-                g_dr_stun_count = 0;
-                g_dr_stun_end_ms = now_ms + g_dr_window_ms;
-            }
-            double factor = (g_dr_stun_count == 0)   ? 1.0
-                            : (g_dr_stun_count == 1) ? 0.5
-                            : (g_dr_stun_count == 2) ? 0.25
-                                                     : 0.0;
-            effective_duration *= factor;
-            g_dr_stun_count++;
-        }
-        else if (type == ROGUE_BUFF_CC_ROOT || (cats & ROGUE_BUFF_CCFLAG_ROOT))
-        {
-            if (now_ms > g_dr_root_end_ms)
-            {
-                g_dr_root_count = 0;
-                g_dr_root_end_ms = now_ms + g_dr_window_ms;
-            }
-            double factor = (g_dr_root_count == 0)   ? 1.0
-                            : (g_dr_root_count == 1) ? 0.5
-                            : (g_dr_root_count == 2) ? 0.25
-                                                     : 0.0;
-            effective_duration *= factor;
-            g_dr_root_count++;
-        }
-        else if (type == ROGUE_BUFF_CC_SLOW || (cats & ROGUE_BUFF_CCFLAG_SLOW))
-        {
-            if (now_ms > g_dr_slow_end_ms)
-            {
-                g_dr_slow_count = 0;
-                g_dr_slow_end_ms = now_ms + g_dr_window_ms;
-            }
-            double factor = (g_dr_slow_count == 0)   ? 1.0
-                            : (g_dr_slow_count == 1) ? 0.5
-                            : (g_dr_slow_count == 2) ? 0.25
-                                                     : 0.0;
-            effective_duration *= factor;
-            g_dr_slow_count++;
-        }
-        if (effective_duration <= 0)
-            return ROGUE_BUFF_INVALID_HANDLE;
-    }
-    /* try stack with existing */
-    for (int i = 0; i < ROGUE_MAX_ACTIVE_BUFFS; i++)
-        if (g_buffs[i].active && g_buffs[i].type == type && now_ms < g_buffs[i].end_ms)
-        {
-            RogueBuff* b = &g_buffs[i];
-            b->last_apply_ms = now_ms;
-            switch (rule)
-            {
-            case ROGUE_BUFF_STACK_UNIQUE:
-                return ROGUE_BUFF_INVALID_HANDLE;
-            case ROGUE_BUFF_STACK_REFRESH:
-                if (magnitude > b->magnitude)
-                    b->magnitude = magnitude;
-                b->end_ms = now_ms + effective_duration;
-                return _make_handle(i);
-            case ROGUE_BUFF_STACK_EXTEND:
-                b->end_ms += effective_duration;
-                if (b->end_ms < now_ms + effective_duration)
-                    b->end_ms = now_ms + effective_duration;
-                if (b->magnitude < magnitude)
-                    b->magnitude = magnitude;
-                return _make_handle(i);
-            case ROGUE_BUFF_STACK_ADD:
-            default:
-                b->magnitude += magnitude;
-                if (b->magnitude > 999)
-                    b->magnitude = 999;
-                if (now_ms + effective_duration > b->end_ms)
-                    b->end_ms = now_ms + effective_duration;
-                return _make_handle(i);
-            case ROGUE_BUFF_STACK_MULTIPLY:
-            {
-                int pct = magnitude;
-                if (pct < 1)
-                    pct = 1;
-                long long nm = (long long) b->magnitude * (long long) pct;
-                nm /= 100;
-                if (nm < 0)
-                    nm = 0;
-                if (nm > 999)
-                    nm = 999;
-                b->magnitude = (int) nm;
-                double new_end = now_ms + effective_duration;
-                if (new_end > b->end_ms)
-                    b->end_ms = new_end;
-                return _make_handle(i);
-            }
-            case ROGUE_BUFF_STACK_REPLACE_IF_STRONGER:
-                if (magnitude > b->magnitude)
-                    b->magnitude = magnitude;
-                if (now_ms + effective_duration > b->end_ms)
-                    b->end_ms = now_ms + effective_duration;
-                return _make_handle(i);
-            }
-        }
-    /* new */
-    int idx = _alloc_slot();
-    if (idx < 0)
-        return ROGUE_BUFF_INVALID_HANDLE;
-    if (rule == ROGUE_BUFF_STACK_MULTIPLY)
-    {
-        _free_slot(idx);
-        return ROGUE_BUFF_INVALID_HANDLE;
-    }
-    g_buffs[idx].active = 1;
-    g_buffs[idx].type = type;
-    g_buffs[idx].magnitude = magnitude;
-    g_buffs[idx].end_ms = now_ms + effective_duration;
-    g_buffs[idx].snapshot = snapshot ? 1 : 0;
-    g_buffs[idx].stack_rule = rule;
-    g_buffs[idx].last_apply_ms = now_ms;
-    g_buffs[idx].categories = cats;
-    {
-        char key[48];
-        snprintf(key, sizeof key, "buff/%d/gain", (int) type);
-        rogue_fx_trigger_event(key, g_app.player.base.pos.x, g_app.player.base.pos.y);
-    }
-    return _make_handle(idx);
+    RogueBuffHandle h;
+    set_apply(&g_live, type, magnitude, duration_ms, now_ms, rule, snapshot, &h);
+    return h;
 }
 
 /**
@@ -561,13 +526,13 @@ RogueBuffHandle rogue_buffs_apply_h(RogueBuffType type, int magnitude, double du
 int rogue_buffs_refresh_h(RogueBuffHandle h, int magnitude, double duration_ms, double now_ms,
                           RogueBuffStackRule rule, int snapshot)
 {
-    _ensure_init();
-    int idx = _validate_handle(h);
+    _ensure_init(&g_live);
+    int idx = _validate_handle(&g_live, h);
     if (idx < 0)
         return 0;
     (void) snapshot; /* snapshot immutable post-creation in this minimal API */
-    return rogue_buffs_apply(g_buffs[idx].type, magnitude, duration_ms, now_ms, rule,
-                             g_buffs[idx].snapshot);
+    return rogue_buffs_apply(g_live.buffs[idx].type, magnitude, duration_ms, now_ms, rule,
+                             g_live.buffs[idx].snapshot);
 }
 
 /**
@@ -582,18 +547,17 @@ int rogue_buffs_refresh_h(RogueBuffHandle h, int magnitude, double duration_ms,
  */
 int rogue_buffs_remove_h(RogueBuffHandle h, double now_ms)
 {
-    _ensure_init();
-    int idx = _validate_handle(h);
+    _ensure_init(&g_live);
+    int idx = _validate_handle(&g_live, h);
     if (idx < 0)
         return 0;
     (void) now_ms; /* reserved */
     /* FX + callback mirror natural expiry */
-    char key[48];
-    snprintf(key, sizeof key, "buff/%d/expire", (int) g_buffs[idx].type);
-    rogue_fx_trigger_event(key, g_app.player.base.pos.x, g_app.player.base.pos.y);
-    if (g_on_expire)
-        g_on_expire(g_buffs[idx].type, g_buffs[idx].magnitude);
-    _free_slot(idx);
+    RogueBuffType type = g_live.buffs[idx].type;
+    buff_fx(&g_live, 1, type);
+    if (g_live.on_expire)
+        g_live.on_expire(type, g_live.buffs[idx].magnitude);
+    _free_slot(&g_live, idx);
     return 1;
 }
 
@@ -608,11 +572,11 @@ int rogue_buffs_remove_h(RogueBuffHandle h, double now_ms)
  */
 int rogue_buffs_query_h(RogueBuffHandle h, RogueBuff* out)
 {
-    _ensure_init();
-    int idx = _validate_handle(h);
+    _ensure_init(&g_live);
+    int idx = _validate_handle(&g_live, h);
     if (idx < 0 || !out)
         return 0;
-    *out = g_buffs[idx];
+    *out = g_live.buffs[idx];
     return 1;
 }
 
@@ -626,12 +590,7 @@ int rogue_buffs_query_h(RogueBuffHandle h, RogueBuff* out)
  */
 int rogue_buffs_strength_bonus(void)
 {
-    _ensure_init();
-    int total = 0;
-    for (int i = 0; i < ROGUE_MAX_ACTIVE_BUFFS; i++)
-        if (g_buffs[i].active && g_buffs[i].type == ROGUE_BUFF_STAT_STRENGTH)
-            total += g_buffs[i].magnitude;
-    return total;
+    return rogue_buff_set_get_total(&g_live, ROGUE_BUFF_STAT_STRENGTH);
 }
 /**
  * @brief Sets the minimum interval between same-type buff applications.
@@ -643,10 +602,10 @@ int rogue_buffs_strength_bonus(void)
  */
 void rogue_buffs_set_dampening(double min_interval_ms)
 {
-    _ensure_init();
+    _ensure_init(&g_live);
     if (min_interval_ms < 0)
         min_interval_ms = 0;
-    g_min_reapply_interval_ms = min_interval_ms;
+    g_live.min_reapply_interval_ms = min_interval_ms;
 }
 
 /**
@@ -657,30 +616,14 @@ void rogue_buffs_set_dampening(double min_interval_ms)
  * @param type The buff type to query
  * @return Total magnitude of all matching active buffs
  */
-int rogue_buffs_get_total(RogueBuffType type)
-{
-    _ensure_init();
-    int total = 0;
-    for (int i = 0; i < ROGUE_MAX_ACTIVE_BUFFS; i++)
-        if (g_buffs[i].active && g_buffs[i].type == type)
-            total += g_buffs[i].magnitude;
-    return total;
-}
+int rogue_buffs_get_total(RogueBuffType type) { return rogue_buff_set_get_total(&g_live, type); }
 
 /**
  * @brief Gets the number of currently active buffs.
  *
  * @return The count of active buff slots
  */
-int rogue_buffs_active_count(void)
-{
-    _ensure_init();
-    int c = 0;
-    for (int i = 0; i < ROGUE_MAX_ACTIVE_BUFFS; i++)
-        if (g_buffs[i].active)
-            c++;
-    return c;
-}
+int rogue_buffs_active_count(void) { return rogue_buff_set_active_count(&g_live); }
 /**
  * @brief Gets the Nth active buff by index.
  *
@@ -693,16 +636,16 @@ int rogue_buffs_active_count(void)
  */
 int rogue_buffs_get_active(int index, RogueBuff* out)
 {
-    _ensure_init();
+    _ensure_init(&g_live);
     if (!out)
         return 0;
     int c = 0;
     for (int i = 0; i < ROGUE_MAX_ACTIVE_BUFFS; i++)
-        if (g_buffs[i].active)
+        if (g_live.buffs[i].active)
         {
             if (c == index)
             {
-                *out = g_buffs[i];
+                *out = g_live.buffs[i];
                 return 1;
             }
             c++;
@@ -722,25 +665,7 @@ int rogue_buffs_get_active(int index, RogueBuff* out)
  */
 int rogue_buffs_snapshot(RogueBuff* out, int max, double now_ms)
 {
-    _ensure_init();
-    if (!out || max <= 0)
-        return 0;
-    int c = 0;
-    for (int i = 0; i < ROGUE_MAX_ACTIVE_BUFFS && c < max; i++)
-    {
-        if (g_buffs[i].active)
-        {
-            if (now_ms >= g_buffs[i].end_ms)
-            {
-                if (g_on_expire)
-                    g_on_expire(g_buffs[i].type, g_buffs[i].magnitude);
-                _free_slot(i);
-                continue;
-            }
-            out[c++] = g_buffs[i];
-        }
-    }
-    return c;
+    return rogue_buff_set_snapshot(&g_live, out, max, now_ms);
 }
 
 /**
@@ -751,7 +676,7 @@ int rogue_buffs_snapshot(RogueBuff* out, int max, double now_ms)
  *
  * @param cb Function pointer to the expiration callback, or NULL to disable
  */
-void rogue_buffs_set_on_expire(RogueBuffExpireFn cb) { g_on_expire = cb; }
+void rogue_buffs_set_on_expire(RogueBuffExpireFn cb) { g_live.on_expire = cb; }
 
 /* Phase 4.3: Category helpers. Keep a simple mapping for built-in types. */
 /**
@@ -793,10 +718,10 @@ uint32_t rogue_buffs_type_categories(RogueBuffType type)
  */
 void rogue_buffs_set_dr_window_ms(double ms)
 {
-    _ensure_init();
+    _ensure_init(&g_live);
     if (ms < 0)
         ms = 0;
-    g_dr_window_ms = ms;
+    g_live.dr_window_ms = ms;
 }
 /**
  * @brief Resets the diminishing returns state.
@@ -806,7 +731,7 @@ void rogue_buffs_set_dr_window_ms(double ms)
  */
 void rogue_buffs_reset_dr_state(void)
 {
-    _ensure_init();
-    g_dr_stun_end_ms = g_dr_root_end_ms = g_dr_slow_end_ms = 0.0;
-    g_dr_stun_count = g_dr_root_count = g_dr_slow_count = 0;
+    _ensure_init(&g_live);
+    g_live.dr_stun_end_ms = g_live.dr_root_end_ms = g_live.dr_slow_end_ms = 0.0;
+    g_live.dr_stun_count = g_live.dr_root_count = g_live.dr_slow_count = 0;
 }
@@ -60,6 +60,9 @@ extern "C"
         int _next_free;
     } RogueBuff;
 
+    /* Phase 4.4: expiration callback type (see rogue_buffs_set_on_expire). */
+    typedef void (*RogueBuffExpireFn)(RogueBuffType type, int magnitude);
+
     /* Phase 4.1–4.2: Handle-based pool API */
     typedef uint32_t RogueBuffHandle;
     enum
@@ -67,6 +70,37 @@ extern "C"
         ROGUE_BUFF_INVALID_HANDLE = 0
     };
 
+    /* Explicit buff pool (simulation contexts, Skills sim follow-up). The rogue_buffs_* API below
+     * operates on the process-wide live set; rogue_buff_set_* operate on a caller-owned set so
+     * isolated simulations can run concurrently without touching live state. Only the live set
+     * emits FX cues. */
+#define ROGUE_MAX_ACTIVE_BUFFS 32
+    typedef struct RogueBuffSet
+    {
+        RogueBuff buffs[ROGUE_MAX_ACTIVE_BUFFS];
+        int free_head; /* index of first free slot */
+        double min_reapply_interval_ms;
+        RogueBuffExpireFn on_expire;
+        int initialized;
+        /* Phase 4.5 DR tracker: active stacks within window 0 -> 1.0, 1 -> 0.5, 2 -> 0.25 */
+        double dr_window_ms;
+        double dr_stun_end_ms, dr_root_end_ms, dr_slow_end_ms;
+        int dr_stun_count, dr_root_count, dr_slow_count;
+        int emit_fx;        /* 1 = buff gain/expire cues (live set) */
+        double next_end_ms; /* lower bound on the earliest active end (update early-out) */
+    } RogueBuffSet;
+
+    void rogue_buff_set_init(RogueBuffSet* set);
+    void rogue_buff_set_update(RogueBuffSet* set, double now_ms);
+    int rogue_buff_set_apply(RogueBuffSet* set, RogueBuffType type, int magnitude,
+                             double duration_ms, double now_ms, RogueBuffStackRule rule,
+                             int snapshot);
+    int rogue_buff_set_get_total(const RogueBuffSet* set, RogueBuffType type);
+    int rogue_buff_set_active_count(const RogueBuffSet* set);
+    int rogue_buff_set_snapshot(RogueBuffSet* set, RogueBuff* out, int max, double now_ms);
+    /* The set behind the rogue_buffs_* API (owning thread only). */
+    RogueBuffSet* rogue_buffs_live_set(void);
+
     void rogue_buffs_init(void);
     void rogue_buffs_update(double now_ms);
     int rogue_buffs_apply(RogueBuffType type, int magnitude, double duration_ms, double now_ms,
@@ -94,7 +128,6 @@ extern "C"
     int rogue_buffs_snapshot(RogueBuff* out, int max, double now_ms);
 
     /* Phase 4.4: Optional expiration callback (on natural expiry or manual remove). */
-    typedef void (*RogueBuffExpireFn)(RogueBuffType type, int magnitude);
     void rogue_buffs_set_on_expire(RogueBuffExpireFn cb);
 
     /* Phase 4.3: Category helpers */
@@ -240,6 +240,19 @@ int rogue_player_try_deflect_projectile(struct RoguePlayer* p, struct RoguePlaye
                                         float proj_dir_x, float proj_dir_y,
                                         float* out_reflect_dir_x, float* out_reflect_dir_y);
 
+/* Phase 14 status buildup: strike windows fill an enemy's bleed/frost meters; a full meter
+ * (ROGUE_STATUS_BUILDUP_THRESHOLD) applies ROGUE_STATUS_BLEED / ROGUE_STATUS_CHILL in the status
+ * store keyed by the enemy's slot in g_app.enemies. */
+#define ROGUE_STATUS_BUILDUP_THRESHOLD 1.0f
+void rogue_combat_add_status_buildup(struct RogueEnemy* e, int enemy_index, float bleed,
+                                     float frost);
+/* Reset meters and drop status records of an enemy slot (call when spawning into it). */
+void rogue_combat_clear_enemy_status(struct RogueEnemy* e, int enemy_index);
+/* Movement speed multiplier from chill (1.0 when not chilled). */
+float rogue_combat_enemy_move_scale(int enemy_index);
+/* Deliver bleed ticks (mitigated damage to the enemy) and status expiry cues. */
+void rogue_combat_status_update(double now_ms);
+
 /* ---------------- Combat Observer Interface (Phase M2.3) ---------------- */
 typedef struct RogueDamageEvent RogueDamageEvent; /* forward for callback */
 typedef void (*RogueDamageObserverFn)(const RogueDamageEvent* ev, void* user);
@@ -198,6 +198,9 @@ int rogue_apply_mitigation_enemy(RogueEnemy* e, int raw, unsigned char dmg_type,
             case ROGUE_DMG_ARCANE:
                 resist = e->resist_arcane;
                 break;
+            case ROGUE_DMG_BLEED:
+                resist = e->resist_bleed;
+                break;
             default:
                 break;
             }
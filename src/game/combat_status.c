@@ -0,0 +1,183 @@
+/**
+ * @file combat_status.c
+ * @brief Enemy bleed / chill statuses driven by per-hit buildup (Phase 14)
+ *
+ * Strike windows add bleed and frost buildup to the struck enemy's meters. A meter that reaches
+ * ROGUE_STATUS_BUILDUP_THRESHOLD is consumed and applies a record in the status store
+ * (status_effects.h) keyed by the enemy's slot in g_app.enemies:
+ * - ROGUE_STATUS_BLEED: periodic physical damage over time, mitigated by resist_bleed
+ * - ROGUE_STATUS_CHILL: movement slow percent, reduced by resist_frost
+ *
+ * rogue_combat_status_update() runs the store's batched update with the bleed tick and expiry
+ * callbacks; records of enemies that died or despawned are dropped on their next tick or expiry,
+ * and spawning into a slot clears whatever the previous occupant left behind.
+ */
+
+#include "../audio_vfx/effects.h"
+#include "../core/app/app_state.h"
+#include "combat.h"
+#include "damage_numbers.h"
+#include "status_effects.h"
+#include <stdio.h>
+
+#define BLEED_DURATION_MS 3000.0
+#define BLEED_TICK_MS 500.0f
+#define BLEED_HEALTH_PCT 5 /* per-tick damage as percent of max health (minimum 1) */
+#define CHILL_DURATION_MS 2500.0
+#define CHILL_SLOW_PCT 35
+#define CHILL_SLOW_MAX_PCT 80
+
+/**
+ * @brief Emits a status cue ("status/<type>/gain" or "status/<type>/expire") at the enemy.
+ *
+ * Keys are interned once on first use like the buff cues in buffs.c.
+ */
+static void status_fx(int type, int expire, const RogueEnemy* e)
+{
+    static RogueFxId keys[2][2];
+    static int keys_ready = 0;
+    int row = type == ROGUE_STATUS_BLEED ? 0 : type == ROGUE_STATUS_CHILL ? 1 : -1;
+    if (row < 0)
+        return;
+    if (!keys_ready)
+    {
+        static const char* names[2] = {"bleed", "chill"};
+        char key[32];
+        for (int r = 0; r < 2; r++)
+        {
+            snprintf(key, sizeof key, "status/%s/gain", names[r]);
+            keys[r][0] = rogue_fx_intern(key);
+            snprintf(key, sizeof key, "status/%s/expire", names[r]);
+            keys[r][1] = rogue_fx_intern(key);
+        }
+        keys_ready = 1;
+    }
+    rogue_fx_trigger_event_id(keys[row][expire ? 1 : 0], e->base.pos.x, e->base.pos.y);
+}
+
+/**
+ * @brief Resolves a status store entity to a live enemy in g_app.enemies (NULL otherwise).
+ */
+static RogueEnemy* status_enemy(RogueStatusEntity entity)
+{
+    if (entity < ROGUE_STATUS_ENTITY_ENEMY_BASE)
+        return NULL;
+    uint32_t index = entity - ROGUE_STATUS_ENTITY_ENEMY_BASE;
+    if (index >= ROGUE_MAX_ENEMIES)
+        return NULL;
+    RogueEnemy* e = &g_app.enemies[index];
+    return (e->alive && e->health > 0) ? e : NULL;
+}
+
+/**
+ * @brief Adds one hit's status buildup to an enemy and applies statuses whose meter filled.
+ *
+ * @param e Struck enemy
+ * @param enemy_index Slot of e in g_app.enemies (status store key)
+ * @param bleed Bleed buildup contributed by the hit
+ * @param frost Frost buildup contributed by the hit
+ */
+void rogue_combat_add_status_buildup(RogueEnemy* e, int enemy_index, float bleed, float frost)
+{
+    if (!e || enemy_index < 0)
+        return;
+    RogueStatusEntity entity = rogue_status_entity_enemy(enemy_index);
+    double now_ms = g_app.game_time_ms;
+    if (bleed > 0.0f)
+    {
+        e->bleed_buildup += bleed;
+        if (e->bleed_buildup >= ROGUE_STATUS_BUILDUP_THRESHOLD)
+        {
+            e->bleed_buildup = 0.0f;
+            int per_tick = e->max_health * BLEED_HEALTH_PCT / 100;
+            if (per_tick < 1)
+                per_tick = 1;
+            if (rogue_status_apply(entity, ROGUE_STATUS_BLEED, per_tick, BLEED_DURATION_MS,
+                                   now_ms, ROGUE_BUFF_STACK_ADD, BLEED_TICK_MS))
+                status_fx(ROGUE_STATUS_BLEED, 0, e);
+        }
+    }
+    if (frost > 0.0f)
+    {
+        e->frost_buildup += frost;
+        if (e->frost_buildup >= ROGUE_STATUS_BUILDUP_THRESHOLD)
+        {
+            e->frost_buildup = 0.0f;
+            int resist = e->resist_frost < 0 ? 0 : e->resist_frost > 90 ? 90 : e->resist_frost;
+            int slow = CHILL_SLOW_PCT * (100 - resist) / 100;
+            if (slow > 0 && rogue_status_apply(entity, ROGUE_STATUS_CHILL, slow,
+                                               CHILL_DURATION_MS, now_ms,
+                                               ROGUE_BUFF_STACK_REPLACE_IF_STRONGER, 0.0f))
+                status_fx(ROGUE_STATUS_CHILL, 0, e);
+        }
+    }
+}
+
+/**
+ * @brief Resets an enemy slot's buildup meters and drops its status records (spawn path).
+ */
+void rogue_combat_clear_enemy_status(RogueEnemy* e, int enemy_index)
+{
+    if (e)
+    {
+        e->bleed_buildup = 0.0f;
+        e->frost_buildup = 0.0f;
+    }
+    if (enemy_index >= 0)
+        rogue_status_remove_entity(rogue_status_entity_enemy(enemy_index));
+}
+
+/**
+ * @brief Movement speed multiplier from the enemy's chill record (1.0 when not chilled).
+ */
+float rogue_combat_enemy_move_scale(int enemy_index)
+{
+    int slow = rogue_status_get_total(rogue_status_entity_enemy(enemy_index), ROGUE_STATUS_CHILL);
+    if (slow <= 0)
+        return 1.0f;
+    if (slow > CHILL_SLOW_MAX_PCT)
+        slow = CHILL_SLOW_MAX_PCT;
+    return (float) (100 - slow) / 100.0f;
+}
+
+static void on_status_tick(RogueStatusEntity entity, int type, int magnitude, int ticks,
+                           void* user)
+{
+    (void) user;
+    RogueEnemy* e = status_enemy(entity);
+    if (!e)
+    {
+        rogue_status_remove_entity(entity);
+        return;
+    }
+    if (type != ROGUE_STATUS_BLEED)
+        return;
+    int over = 0;
+    int raw = magnitude * ticks;
+    int dmg = rogue_apply_mitigation_enemy(e, raw, ROGUE_DMG_BLEED, &over);
+    e->health -= dmg;
+    if (e->health < 0)
+        e->health = 0; /* the AI pass turns this into a death (XP, loot, fade) */
+    e->hurt_timer = 150.0f;
+    rogue_add_damage_number(e->base.pos.x, e->base.pos.y - 0.25f, dmg, 1);
+    rogue_damage_event_record(0, ROGUE_DMG_BLEED, 0, raw, dmg, over, 0);
+}
+
+static void on_status_expire(RogueStatusEntity entity, int type, int magnitude, void* user)
+{
+    (void) magnitude;
+    (void) user;
+    RogueEnemy* e = status_enemy(entity);
+    if (e)
+        status_fx(type, 1, e);
+}
+
+/**
+ * @brief Ticks enemy damage-over-time records and expires due statuses.
+ *
+ * @param now_ms Current game time in milliseconds
+ */
+void rogue_combat_status_update(double now_ms)
+{
+    rogue_status_update(now_ms, on_status_tick, on_status_expire, NULL);
+}
@@ -910,15 +910,8 @@ int rogue_combat_player_strike(RoguePlayerCombat* pc, RoguePlayer* player, Rogue
                 rogue_hit_mark_explosion();
             }
 
-            /* Phase 14: Status Effect Buildup */
-            if (bleed_build > 0)
-            {
-                enemies[i].bleed_buildup += bleed_build;
-            }
-            if (frost_build > 0)
-            {
-                enemies[i].frost_buildup += frost_build;
-            }
+            /* Phase 14: Status Effect Buildup (full meters apply bleed / chill) */
+            rogue_combat_add_status_buildup(&enemies[i], i, bleed_build, frost_build);
 
             /* Phase 15: Poise Damage and Staggering */
             if (def && def->poise_damage > 0.0f && enemies[i].poise_max > 0.0f)
@@ -5,10 +5,12 @@
 #include "../graphics/font.h"
 #include "../graphics/sprite.h"
 #include "../ui/core/ui_context.h"
+#include "../util/json_tok.h"
 #include "../util/log.h"
 #include "../util/path_utils.h"
 #include <assert.h>
 #include <ctype.h>
+#include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -16,6 +18,11 @@
 #include <SDL.h>
 #endif
 
+/* Dialogue logs under its own category so "ROGUE_LOG_CATEGORIES=dialogue=info" can trace line
+   display without raising every other system's level. */
+#define RD_LOG_INFO(...) ROGUE_LOGC_INFO(ROGUE_LOG_CAT_DIALOGUE, __VA_ARGS__)
+#define RD_LOG_WARN(...) ROGUE_LOGC_WARN(ROGUE_LOG_CAT_DIALOGUE, __VA_ARGS__)
+
 #ifndef ROGUE_DIALOGUE_MAX_SCRIPTS
 #define ROGUE_DIALOGUE_MAX_SCRIPTS 64
 #endif
@@ -199,13 +206,7 @@ int rogue_dialogue_style_set(const RogueDialogueStyle* style)
 }
 const RogueDialogueStyle* rogue_dialogue_style_get(void) { return &g_style; }
 
-/* --- Minimal JSON helpers (non-recursive, tolerant) --- */
-static const char* jd_skip_ws(const char* s)
-{
-    while (*s == ' ' || *s == '\n' || *s == '\r' || *s == '\t')
-        ++s;
-    return s;
-}
+/* --- JSON helpers (documents are walked with util/json_tok) --- */
 static unsigned int jd_hex_nibble(char c)
 {
     if (c >= '0' && c <= '9')
@@ -261,67 +262,6 @@ static int jd_parse_color(const char* s, unsigned int* out)
     }
     return -1;
 }
-static int jd_extract_string(const char* json, const char* key, char* out, size_t cap)
-{
-    const char* search = json;
-    size_t key_len = strlen(key);
-    while (1)
-    {
-        const char* found = strstr(search, key);
-        if (!found)
-            return -1;
-        search = found + key_len; /* advance for next search if fails */
-        const char* colon = strchr(found, ':');
-        if (!colon)
-            continue;
-        const char* v = jd_skip_ws(colon + 1);
-        if (*v != '"')
-            continue;
-        v++;
-        const char* end = strchr(v, '"');
-        if (!end)
-            return -1;
-        size_t len = (size_t) (end - v);
-        if (len > cap - 1)
-            len = cap - 1;
-        memcpy(out, v, len);
-        out[len] = '\0';
-        return 0;
-    }
-}
-static int jd_extract_int(const char* json, const char* key, int* out)
-{
-    const char* search = json;
-    size_t key_len = strlen(key);
-    while (1)
-    {
-        const char* found = strstr(search, key);
-        if (!found)
-            return -1;
-        search = found + key_len;
-        const char* colon = strchr(found, ':');
-        if (!colon)
-            continue;
-        const char* v = jd_skip_ws(colon + 1);
-        int sign = 1;
-        if (*v == '-')
-        {
-            sign = -1;
-            v++;
-        }
-        if (!isdigit((unsigned char) *v))
-            continue;
-        int val = 0;
-        while (isdigit((unsigned char) *v))
-        {
-            val = val * 10 + (*v - '0');
-            v++;
-        }
-        *out = val * sign;
-        return 0;
-    }
-}
-
 /* Simple file slurp (binary) placed here so JSON loaders can use it */
 static int load_file(const char* path, char** out_buf, int* out_len)
 {
@@ -399,6 +339,36 @@ static int load_file(const char* path, char** out_buf, int* out_len)
     return 0;
 }
 
+/* Style keys: "#RRGGBB" / "#AARRGGBB" colors and integer switches / sizes. */
+typedef struct RdStyleField
+{
+    const char* key;
+    size_t offset;
+} RdStyleField;
+static const RdStyleField k_style_colors[] = {
+    {"panel_color_top", offsetof(RogueDialogueStyle, panel_color_top)},
+    {"panel_color_bottom", offsetof(RogueDialogueStyle, panel_color_bottom)},
+    {"border_color", offsetof(RogueDialogueStyle, border_color)},
+    {"speaker_color", offsetof(RogueDialogueStyle, speaker_color)},
+    {"text_color", offsetof(RogueDialogueStyle, text_color)},
+    {"text_shadow_color", offsetof(RogueDialogueStyle, text_shadow_color)},
+    {"accent_color", offsetof(RogueDialogueStyle, accent_color)},
+    {"glow_color", offsetof(RogueDialogueStyle, glow_color)},
+    {"rune_strip_color", offsetof(RogueDialogueStyle, rune_strip_color)},
+};
+static const RdStyleField k_style_ints[] = {
+    {"enable_gradient", offsetof(RogueDialogueStyle, enable_gradient)},
+    {"enable_text_shadow", offsetof(RogueDialogueStyle, enable_text_shadow)},
+    {"show_blink_prompt", offsetof(RogueDialogueStyle, show_blink_prompt)},
+    {"show_caret", offsetof(RogueDialogueStyle, show_caret)},
+    {"panel_height", offsetof(RogueDialogueStyle, panel_height)},
+    {"border_thickness", offsetof(RogueDialogueStyle, border_thickness)},
+    {"use_parchment", offsetof(RogueDialogueStyle, use_parchment)},
+    {"glow_strength", offsetof(RogueDialogueStyle, glow_strength)},
+    {"corner_ornaments", offsetof(RogueDialogueStyle, corner_ornaments)},
+    {"vignette", offsetof(RogueDialogueStyle, vignette)},
+};
+
 int rogue_dialogue_style_load_from_json(const char* path)
 {
     if (!path)
@@ -411,77 +381,55 @@ int rogue_dialogue_style_load_from_json(const char* path)
     RogueDialogueStyle st = g_style;
     char tmp[128];
     unsigned int col;
-    int iv;
-    if (jd_extract_string(buf, "panel_color_top", tmp, sizeof tmp) == 0)
-    {
-        if (jd_parse_color(tmp, &col) == 0)
-            st.panel_color_top = col;
-    }
-    if (jd_extract_string(buf, "panel_color_bottom", tmp, sizeof tmp) == 0)
-    {
-        if (jd_parse_color(tmp, &col) == 0)
-            st.panel_color_bottom = col;
-    }
-    if (jd_extract_string(buf, "border_color", tmp, sizeof tmp) == 0)
-    {
-        if (jd_parse_color(tmp, &col) == 0)
-            st.border_color = col;
-    }
-    if (jd_extract_string(buf, "speaker_color", tmp, sizeof tmp) == 0)
+    RogueJsonTokenizer t;
+    RogueJsonToken v;
+    RogueJsonView key;
+    rogue_json_tok_init(&t, buf, (size_t) len);
+    if (rogue_json_tok_next(&t, &v) != ROGUE_JTOK_OBJECT_BEGIN)
     {
-        if (jd_parse_color(tmp, &col) == 0)
-            st.speaker_color = col;
-    }
-    if (jd_extract_string(buf, "text_color", tmp, sizeof tmp) == 0)
-    {
-        if (jd_parse_color(tmp, &col) == 0)
-            st.text_color = col;
-    }
-    if (jd_extract_string(buf, "text_shadow_color", tmp, sizeof tmp) == 0)
-    {
-        if (jd_parse_color(tmp, &col) == 0)
-            st.text_shadow_color = col;
-    }
-    if (jd_extract_string(buf, "accent_color", tmp, sizeof tmp) == 0)
-    {
-        if (jd_parse_color(tmp, &col) == 0)
-            st.accent_color = col;
-    }
-    if (jd_extract_string(buf, "parchment_texture", tmp, sizeof tmp) == 0)
-    {
-        if (rogue_texture_load(&g_parchment_tex, tmp))
-            g_parchment_loaded = 1;
+        free(buf);
+        return -3;
     }
-    if (jd_extract_int(buf, "enable_gradient", &iv) == 0)
-        st.enable_gradient = iv;
-    if (jd_extract_int(buf, "enable_text_shadow", &iv) == 0)
-        st.enable_text_shadow = iv;
-    if (jd_extract_int(buf, "show_blink_prompt", &iv) == 0)
-        st.show_blink_prompt = iv;
-    if (jd_extract_int(buf, "show_caret", &iv) == 0)
-        st.show_caret = iv;
-    if (jd_extract_int(buf, "panel_height", &iv) == 0)
-        st.panel_height = iv;
-    if (jd_extract_int(buf, "border_thickness", &iv) == 0)
-        st.border_thickness = iv;
-    if (jd_extract_int(buf, "use_parchment", &iv) == 0)
-        st.use_parchment = iv;
-    if (jd_extract_string(buf, "glow_color", tmp, sizeof tmp) == 0)
+    while (rogue_json_tok_member(&t, &key, &v) > 0)
     {
-        if (jd_parse_color(tmp, &col) == 0)
-            st.glow_color = col;
+        size_t i;
+        if (v.type == ROGUE_JTOK_STRING)
+        {
+            rogue_json_tok_copy(&v, tmp, sizeof tmp);
+            if (rogue_json_view_eq(key, "parchment_texture"))
+            {
+                if (rogue_texture_load(&g_parchment_tex, tmp))
+                    g_parchment_loaded = 1;
+                continue;
+            }
+            for (i = 0; i < sizeof k_style_colors / sizeof k_style_colors[0]; i++)
+                if (rogue_json_view_eq(key, k_style_colors[i].key))
+                {
+                    if (jd_parse_color(tmp, &col) == 0)
+                        *(unsigned int*) ((char*) &st + k_style_colors[i].offset) = col;
+                    break;
+                }
+        }
+        else if (v.type == ROGUE_JTOK_NUMBER || v.type == ROGUE_JTOK_TRUE ||
+                 v.type == ROGUE_JTOK_FALSE)
+        {
+            for (i = 0; i < sizeof k_style_ints / sizeof k_style_ints[0]; i++)
+                if (rogue_json_view_eq(key, k_style_ints[i].key))
+                {
+                    rogue_json_tok_int(&v, (int*) ((char*) &st + k_style_ints[i].offset));
+                    break;
+                }
+        }
+        else
+            (void) rogue_json_tok_skip(&t, &v);
     }
-    if (jd_extract_string(buf, "rune_strip_color", tmp, sizeof tmp) == 0)
+    if (t.error)
     {
-        if (jd_parse_color(tmp, &col) == 0)
-            st.rune_strip_color = col;
+        RD_LOG_WARN("Dialogue style JSON invalid at byte %zu (%s): %s", t.error_pos, t.error,
+                    path);
+        free(buf);
+        return -3;
     }
-    if (jd_extract_int(buf, "glow_strength", &iv) == 0)
-        st.glow_strength = iv;
-    if (jd_extract_int(buf, "corner_ornaments", &iv) == 0)
-        st.corner_ornaments = iv;
-    if (jd_extract_int(buf, "vignette", &iv) == 0)
-        st.vignette = iv;
     g_style = st;
     free(buf);
     return 0;
@@ -521,21 +469,24 @@ static unsigned int rd_mood_tint(const char* mood)
         return 0xFF80E070u; /* soft green */
     return 0xFFFFFFFFu;     /* unknown -> neutral */
 }
+/* ROGUE_DIALOGUE_DEBUG is read once; the JSON loaders consult it per line. */
 static int rd_debug_enabled(void)
 {
+    static int cached = -1;
+    if (cached >= 0)
+        return cached;
 #if defined(_MSC_VER)
     char* val = NULL;
     size_t len = 0;
     if (_dupenv_s(&val, &len, "ROGUE_DIALOGUE_DEBUG") != 0 || !val)
-        return 0;
-    int enabled = (*val == '1' || *val == 't' || *val == 'T' || *val == 'y' || *val == 'Y');
+        return cached = 0;
+    cached = (*val == '1' || *val == 't' || *val == 'T' || *val == 'y' || *val == 'Y');
     free(val);
-    return enabled;
 #else
     const char* env = getenv("ROGUE_DIALOGUE_DEBUG");
-    return (env && (*env == '1' || *env == 't' || *env == 'T' || *env == 'y' || *env == 'Y')) ? 1
-                                                                                              : 0;
+    cached = (env && (*env == '1' || *env == 't' || *env == 'T' || *env == 'y' || *env == 'Y'));
 #endif
+    return cached;
 }
 static void rd_validate_mood(char* mood)
 {
@@ -548,7 +499,7 @@ static void rd_validate_mood(char* mood)
             return;
     }
     if (rd_debug_enabled())
-        ROGUE_LOG_WARN("Dialogue: mood '%s' not allowed (forcing neutral)", mood); /* safe copy */
+        RD_LOG_WARN("Dialogue: mood '%s' not allowed (forcing neutral)", mood); /* safe copy */
 #if defined(_MSC_VER)
     strncpy_s(mood, 64, "neutral", _TRUNCATE);
 #else
@@ -556,348 +507,251 @@ static void rd_validate_mood(char* mood)
     mood[63] = '\0';
 #endif
 }
-int rogue_dialogue_load_script_from_json_file(const char* path)
+/* Script JSON: either {"id":N,"lines":[...]} or {"scripts":[{"id":N,"lines":[...]}, ...]}.
+   Each line object carries speaker / text and optional race / name / mood / side / mirror; the
+   lines are rendered into the "speaker[@meta]|text" buffer format parse_and_register reads. */
+typedef struct RdJsonStats
 {
-    if (!path)
+    int lines_total;
+    int lines_kept;
+    int lines_skipped;
+} RdJsonStats;
+typedef struct RdJsonScript
+{
+    int id;
+    int have_lines;
+    int multi; /* root carried a "scripts" array */
+    int line_idx;
+    size_t out;
+    char temp[20000];
+} RdJsonScript;
+
+/* Tokenizer sits just past the line object's '{'. */
+static int rd_json_line(RogueJsonTokenizer* t, RdJsonScript* sc, RdJsonStats* stats)
+{
+    char speaker[64] = "", textv[512] = "";
+    char race[64] = "", name[64] = "", mood[64] = "";
+    char side[16] = "", mirror[16] = "";
+    RogueJsonToken v;
+    RogueJsonView key;
+    int r;
+    while ((r = rogue_json_tok_member(t, &key, &v)) > 0)
+    {
+        if (v.type != ROGUE_JTOK_STRING)
+            (void) rogue_json_tok_skip(t, &v);
+        else if (rogue_json_view_eq(key, "speaker"))
+            rogue_json_tok_copy(&v, speaker, sizeof speaker);
+        else if (rogue_json_view_eq(key, "text"))
+            rogue_json_tok_copy(&v, textv, sizeof textv);
+        else if (rogue_json_view_eq(key, "race"))
+            rogue_json_tok_copy(&v, race, sizeof race);
+        else if (rogue_json_view_eq(key, "name"))
+            rogue_json_tok_copy(&v, name, sizeof name);
+        else if (rogue_json_view_eq(key, "mood"))
+            rogue_json_tok_copy(&v, mood, sizeof mood);
+        else if (rogue_json_view_eq(key, "side"))
+            rogue_json_tok_copy(&v, side, sizeof side);
+        else if (rogue_json_view_eq(key, "mirror"))
+            rogue_json_tok_copy(&v, mirror, sizeof mirror);
+    }
+    if (r < 0)
         return -1;
-    char* buf = NULL;
-    int len = 0;
-    int lf = load_file(path, &buf, &len);
-    if (lf != 0)
+    int line_idx = sc->line_idx++;
+    if (mood[0])
+        rd_validate_mood(mood);
+    stats->lines_total++;
+    if (!(speaker[0] && textv[0]))
     {
-        ROGUE_LOG_WARN("Dialogue JSON open failed (%d): %s", lf, path);
-        return -2;
+        stats->lines_skipped++;
+        if (rd_debug_enabled())
+            RD_LOG_WARN("Dialogue script %d skip line %d (missing speaker/text)", sc->id,
+                        line_idx);
+        return 0;
     }
-    buf[len] = '\0';
-    if (rd_debug_enabled())
+    char avatar_path[256] = "";
+    if (race[0] && name[0] && mood[0])
+    {
+        /* Path scheme: assets/avatar_icons/<race>/<name>_<mood>.png
+         * (replaces older nested mood folder). */
+        snprintf(avatar_path, sizeof avatar_path, "../assets/avatar_icons/%s/%s_%s.png", race,
+                 name, mood);
+    }
+    int sflag = (strcmp(side, "right") == 0);
+    /* legacy 'v' value now treated as horizontal */
+    int hflag = (mirror[0] == 'v' || mirror[0] == 'V');
+    unsigned int tint = rd_mood_tint(mood);
+    char meta[320];
+    if (avatar_path[0])
+        snprintf(meta, sizeof meta, "%s;S=%d;V=%d;TR=%u;TG=%u;TB=%u", avatar_path, sflag, hflag,
+                 (tint >> 16) & 255, (tint >> 8) & 255, tint & 255);
+    else
+        meta[0] = '\0';
+    size_t room = sizeof(sc->temp) - sc->out;
+    int n = avatar_path[0]
+                ? snprintf(sc->temp + sc->out, room, "%s@%s|%s\n", speaker, meta, textv)
+                : snprintf(sc->temp + sc->out, room, "%s|%s\n", speaker, textv);
+    if (n > 0 && (size_t) n < room)
+    {
+        sc->out += (size_t) n;
+        stats->lines_kept++;
+        if (rd_debug_enabled())
+            RD_LOG_INFO("Dialogue script %d keep line %d speaker='%s' text_len=%zu", sc->id,
+                        line_idx, speaker, strlen(textv));
+    }
+    else
     {
-        ROGUE_LOG_INFO("Dialogue JSON bytes=%d path=%s", len, path);
+        stats->lines_skipped++;
     }
-    int registered = 0;
-    int lines_total = 0;
-    int lines_kept = 0;
-    int lines_skipped = 0;
-    int single = 0;
-    char* scripts_root = strstr(buf, "\"scripts\"");
-    if (scripts_root)
-    { /* multi-script */
-        char* arr = strchr(scripts_root, '[');
-        if (!arr)
-        {
-            free(buf);
-            return -3;
-        }
-        /* Find matching closing bracket for scripts array (handle nested brackets inside objects)
-         */
-        char* arr_end = NULL;
-        int bdepth = 0;
-        for (char* p = arr; *p; ++p)
+    return 0;
+}
+
+/* Walk one script object (tokenizer just past its '{'). A "scripts" member is only meaningful
+   at the document root and is handed to on_scripts. */
+static int rd_json_script(RogueJsonTokenizer* t, RdJsonScript* sc, RdJsonStats* stats,
+                          int (*on_scripts)(RogueJsonTokenizer*, RdJsonStats*, int*),
+                          int* registered)
+{
+    RogueJsonToken v, e;
+    RogueJsonView key;
+    int r;
+    sc->id = -1;
+    sc->have_lines = 0;
+    sc->multi = 0;
+    sc->line_idx = 0;
+    sc->out = 0;
+    while ((r = rogue_json_tok_member(t, &key, &v)) > 0)
+    {
+        if (rogue_json_view_eq(key, "id"))
+            rogue_json_tok_int(&v, &sc->id);
+        else if (rogue_json_view_eq(key, "lines") && v.type == ROGUE_JTOK_ARRAY_BEGIN)
         {
-            if (*p == '[')
+            sc->have_lines = 1;
+            while ((r = rogue_json_tok_element(t, &e)) > 0)
             {
-                if (bdepth == 0 && p != arr)
-                { /* nested array start */
-                }
-                bdepth++;
-            }
-            else if (*p == ']')
-            {
-                bdepth--;
-                if (bdepth == 0)
-                {
-                    arr_end = p;
-                    break;
-                }
+                if (e.type != ROGUE_JTOK_OBJECT_BEGIN)
+                    (void) rogue_json_tok_skip(t, &e);
+                else if (rd_json_line(t, sc, stats) != 0)
+                    return -1;
             }
+            if (r < 0)
+                return -1;
         }
-        if (!arr_end)
-        {
-            free(buf);
-            return -4;
-        }
-        char* s = arr;
-        while (s < arr_end)
+        else if (on_scripts && rogue_json_view_eq(key, "scripts") &&
+                 v.type == ROGUE_JTOK_ARRAY_BEGIN)
         {
-            char* sobj = strchr(s, '{');
-            if (!sobj || sobj >= arr_end)
-                break;
-            /* Find matching closing brace for this script object (brace depth) */
-            char* sobj_end = NULL;
-            int depth = 0;
-            for (char* p = sobj; p < arr_end; ++p)
-            {
-                if (*p == '{')
-                {
-                    depth++;
-                }
-                else if (*p == '}')
-                {
-                    depth--;
-                    if (depth == 0)
-                    {
-                        sobj_end = p;
-                        break;
-                    }
-                }
-            }
-            if (!sobj_end)
-                break; /* malformed */
-            size_t slen = (size_t) (sobj_end - sobj + 1);
-            /* Copy full script object into temp buffer (enlarge if needed) */
-            char scopy[16384];
-            if (slen > sizeof scopy - 1)
-                slen = sizeof scopy - 1;
-            memcpy(scopy, sobj, slen);
-            scopy[slen] = '\0';
-            int sid = -1;
-            jd_extract_int(scopy, "id", &sid);
-            if (sid >= 0)
-            {
-                char* lines_sec = strstr(scopy, "\"lines\"");
-                if (lines_sec)
-                {
-                    char* larr = strchr(lines_sec, '[');
-                    if (larr)
-                    {
-                        char* larr_end = strchr(larr, ']');
-                        if (larr_end)
-                        {
-                            char temp[20000];
-                            size_t out = 0;
-                            char* lc = larr;
-                            int line_idx = 0;
-                            while (lc < larr_end)
-                            {
-                                char* lobj = strchr(lc, '{');
-                                if (!lobj || lobj >= larr_end)
-                                    break;
-                                char* lobj_end = NULL;
-                                int ldepth = 0;
-                                for (char* q = lobj; q < larr_end; ++q)
-                                {
-                                    if (*q == '{')
-                                    {
-                                        ldepth++;
-                                    }
-                                    else if (*q == '}')
-                                    {
-                                        ldepth--;
-                                        if (ldepth == 0)
-                                        {
-                                            lobj_end = q;
-                                            break;
-                                        }
-                                    }
-                                }
-                                if (!lobj_end)
-                                    break;
-                                char lcopy[1024];
-                                size_t llen = (size_t) (lobj_end - lobj + 1);
-                                if (llen > sizeof lcopy - 1)
-                                    llen = sizeof lcopy - 1;
-                                memcpy(lcopy, lobj, llen);
-                                lcopy[llen] = '\0';
-                                char speaker[64] = "", textv[512] = "";
-                                char race[64] = "", name[64] = "", mood[64] = "";
-                                char side[16] = "", mirror[16] = "";
-                                jd_extract_string(lcopy, "speaker", speaker, sizeof speaker);
-                                jd_extract_string(lcopy, "text", textv, sizeof textv);
-                                jd_extract_string(lcopy, "race", race, sizeof race);
-                                jd_extract_string(lcopy, "name", name, sizeof name);
-                                jd_extract_string(lcopy, "mood", mood, sizeof mood);
-                                jd_extract_string(lcopy, "side", side, sizeof side);
-                                jd_extract_string(lcopy, "mirror", mirror, sizeof mirror);
-                                if (mood[0])
-                                    rd_validate_mood(mood);
-                                lines_total++;
-                                if (!(speaker[0] && textv[0]))
-                                {
-                                    lines_skipped++;
-                                    if (rd_debug_enabled())
-                                        ROGUE_LOG_WARN("Dialogue script %d skip line %d (missing "
-                                                       "speaker/text)",
-                                                       sid, line_idx);
-                                    lc = lobj_end + 1;
-                                    line_idx++;
-                                    continue;
-                                }
-                                char avatar_path[256] = "";
-                                if (race[0] && name[0] && mood[0])
-                                {
-                                    /* Path scheme: assets/avatar_icons/<race>/<name>_<mood>.png
-                                     * (replaces older nested mood folder). */
-                                    snprintf(avatar_path, sizeof avatar_path,
-                                             "../assets/avatar_icons/%s/%s_%s.png", race, name,
-                                             mood);
-                                }
-                                int sflag = (strcmp(side, "right") == 0);
-                                int hflag =
-                                    (mirror[0] == 'v' ||
-                                     mirror[0] ==
-                                         'V'); /* legacy 'v' value now treated as horizontal */
-                                unsigned int tint = rd_mood_tint(mood);
-                                char meta[320];
-                                if (avatar_path[0])
-                                    snprintf(meta, sizeof meta, "%s;S=%d;V=%d;TR=%u;TG=%u;TB=%u",
-                                             avatar_path, sflag, hflag, (tint >> 16) & 255,
-                                             (tint >> 8) & 255, tint & 255);
-                                else
-                                    meta[0] = '\0';
-                                int n =
-                                    avatar_path[0]
-                                        ? snprintf(temp + out, sizeof(temp) - out, "%s%s@%s|%s\n",
-                                                   out ? "" : "", speaker, meta, textv)
-                                        : snprintf(temp + out, sizeof(temp) - out, "%s%s|%s\n",
-                                                   out ? "" : "", speaker, textv);
-                                if (n > 0)
-                                {
-                                    out += (size_t) n;
-                                    lines_kept++;
-                                    if (rd_debug_enabled())
-                                        ROGUE_LOG_INFO("Dialogue script %d keep line %d "
-                                                       "speaker='%s' text_len=%zu",
-                                                       sid, line_idx, speaker, strlen(textv));
-                                }
-                                else
-                                {
-                                    lines_skipped++;
-                                }
-                                lc = lobj_end + 1;
-                                line_idx++;
-                            }
-                            if (out > 0 &&
-                                rogue_dialogue_register_from_buffer(sid, temp, (int) out) == 0)
-                            {
-                                registered++;
-                                if (rd_debug_enabled())
-                                    ROGUE_LOG_INFO("Dialogue script %d registered lines=%d", sid,
-                                                   lines_kept);
-                            }
-                            else if (rd_debug_enabled())
-                            {
-                                ROGUE_LOG_WARN("Dialogue script %d registration failed (out=%zu)",
-                                               sid, out);
-                            }
-                        }
-                    }
-                }
-            }
-            s = sobj_end + 1;
+            sc->multi = 1;
+            if (on_scripts(t, stats, registered) != 0)
+                return -1;
         }
-        if (rd_debug_enabled())
-            ROGUE_LOG_INFO("Dialogue multi summary scripts=%d lines_total=%d kept=%d skipped=%d",
-                           registered, lines_total, lines_kept, lines_skipped);
-        free(buf);
-        return (registered > 0) ? 0 : -5;
-    }
-    /* single */
-    single = 1;
-    int script_id = -1;
-    jd_extract_int(buf, "id", &script_id);
-    if (script_id < 0)
-    {
-        if (rd_debug_enabled())
-            ROGUE_LOG_WARN("Dialogue single missing id");
-        free(buf);
-        return -6;
-    }
-    char* lines_sec = strstr(buf, "\"lines\"");
-    if (!lines_sec)
-    {
-        free(buf);
-        return -7;
-    }
-    char* arr = strchr(lines_sec, '[');
-    if (!arr)
-    {
-        free(buf);
-        return -8;
-    }
-    char* arr_end = strchr(arr, ']');
-    if (!arr_end)
-    {
-        free(buf);
-        return -9;
+        else
+            (void) rogue_json_tok_skip(t, &v);
     }
-    char temp[20000];
-    size_t out = 0;
-    char* cursor = arr;
-    int line_idx = 0;
-    while (cursor < arr_end)
+    return r < 0 ? -1 : 0;
+}
+
+static int rd_json_scripts(RogueJsonTokenizer* t, RdJsonStats* stats, int* registered)
+{
+    RdJsonScript* sc = (RdJsonScript*) malloc(sizeof *sc);
+    if (!sc)
+        return -1;
+    RogueJsonToken e;
+    int r;
+    while ((r = rogue_json_tok_element(t, &e)) > 0)
     {
-        char* obj = strchr(cursor, '{');
-        if (!obj || obj >= arr_end)
-            break;
-        char* obj_end = strchr(obj, '}');
-        if (!obj_end || obj_end > arr_end)
-            break;
-        char oc[1024];
-        size_t olen = (size_t) (obj_end - obj + 1);
-        if (olen > sizeof oc - 1)
-            olen = sizeof oc - 1;
-        memcpy(oc, obj, olen);
-        oc[olen] = '\0';
-        char speaker[64] = "", textv[512] = "";
-        char race[64] = "", name[64] = "", mood[64] = "";
-        char side[16] = "", mirror[16] = "";
-        jd_extract_string(oc, "speaker", speaker, sizeof speaker);
-        jd_extract_string(oc, "text", textv, sizeof textv);
-        jd_extract_string(oc, "race", race, sizeof race);
-        jd_extract_string(oc, "name", name, sizeof name);
-        jd_extract_string(oc, "mood", mood, sizeof mood);
-        jd_extract_string(oc, "side", side, sizeof side);
-        jd_extract_string(oc, "mirror", mirror, sizeof mirror);
-        if (mood[0])
-            rd_validate_mood(mood);
-        lines_total++;
-        if (!(speaker[0] && textv[0]))
+        if (e.type != ROGUE_JTOK_OBJECT_BEGIN)
         {
-            lines_skipped++;
-            if (rd_debug_enabled())
-                ROGUE_LOG_WARN("Dialogue single skip line %d (missing speaker/text)", line_idx);
-            cursor = obj_end + 1;
-            line_idx++;
+            (void) rogue_json_tok_skip(t, &e);
             continue;
         }
-        char avatar_path[256] = "";
-        if (race[0] && name[0] && mood[0])
+        if (rd_json_script(t, sc, stats, NULL, NULL) != 0)
         {
-            snprintf(avatar_path, sizeof avatar_path, "../assets/avatar_icons/%s/%s_%s.png", race,
-                     name, mood);
+            r = -1;
+            break;
         }
-        int sflag = (strcmp(side, "right") == 0);
-        int hflag = (mirror[0] == 'v' || mirror[0] == 'V');
-        unsigned int tint = rd_mood_tint(mood);
-        char meta[320];
-        if (avatar_path[0])
-            snprintf(meta, sizeof meta, "%s;S=%d;V=%d;TR=%u;TG=%u;TB=%u", avatar_path, sflag, hflag,
-                     (tint >> 16) & 255, (tint >> 8) & 255, tint & 255);
-        else
-            meta[0] = '\0';
-        int n = avatar_path[0] ? snprintf(temp + out, sizeof(temp) - out, "%s%s@%s|%s\n",
-                                          out ? "" : "", speaker, meta, textv)
-                               : snprintf(temp + out, sizeof(temp) - out, "%s%s|%s\n",
-                                          out ? "" : "", speaker, textv);
-        if (n > 0)
+        if (sc->id < 0)
+            continue;
+        if (sc->out > 0 &&
+            rogue_dialogue_register_from_buffer(sc->id, sc->temp, (int) sc->out) == 0)
         {
-            out += (size_t) n;
-            lines_kept++;
+            (*registered)++;
             if (rd_debug_enabled())
-                ROGUE_LOG_INFO("Dialogue single keep line %d speaker='%s' text_len=%zu", line_idx,
-                               speaker, strlen(textv));
+                RD_LOG_INFO("Dialogue script %d registered lines=%d", sc->id, sc->line_idx);
         }
-        else
+        else if (rd_debug_enabled())
         {
-            lines_skipped++;
+            RD_LOG_WARN("Dialogue script %d registration failed (out=%zu)", sc->id, sc->out);
         }
-        cursor = obj_end + 1;
-        line_idx++;
     }
-    int r = (out > 0) ? rogue_dialogue_register_from_buffer(script_id, temp, (int) out) : -10;
+    free(sc);
+    return r < 0 ? -1 : 0;
+}
+
+int rogue_dialogue_load_script_from_json_file(const char* path)
+{
+    if (!path)
+        return -1;
+    char* buf = NULL;
+    int len = 0;
+    int lf = load_file(path, &buf, &len);
+    if (lf != 0)
+    {
+        RD_LOG_WARN("Dialogue JSON open failed (%d): %s", lf, path);
+        return -2;
+    }
+    buf[len] = '\0';
     if (rd_debug_enabled())
-        ROGUE_LOG_INFO("Dialogue single summary id=%d status=%d lines_total=%d kept=%d skipped=%d",
-                       script_id, r, lines_total, lines_kept, lines_skipped);
+    {
+        RD_LOG_INFO("Dialogue JSON bytes=%d path=%s", len, path);
+    }
+    RdJsonStats stats = {0, 0, 0};
+    int registered = 0;
+    RdJsonScript* root = (RdJsonScript*) malloc(sizeof *root);
+    if (!root)
+    {
+        free(buf);
+        return -4;
+    }
+    RogueJsonTokenizer t;
+    RogueJsonToken v;
+    rogue_json_tok_init(&t, buf, (size_t) len);
+    int ok = rogue_json_tok_next(&t, &v) == ROGUE_JTOK_OBJECT_BEGIN &&
+             rd_json_script(&t, root, &stats, rd_json_scripts, &registered) == 0 &&
+             rogue_json_tok_next(&t, &v) == ROGUE_JTOK_END;
     free(buf);
+    if (!ok)
+    {
+        RD_LOG_WARN("Dialogue JSON invalid at byte %zu (%s): %s", t.error_pos,
+                    t.error ? t.error : "expected object", path);
+        free(root);
+        return -3;
+    }
+    int r;
+    if (root->multi)
+    {
+        r = registered > 0 ? 0 : -5;
+        if (rd_debug_enabled())
+            RD_LOG_INFO("Dialogue multi summary scripts=%d lines_total=%d kept=%d skipped=%d",
+                        registered, stats.lines_total, stats.lines_kept, stats.lines_skipped);
+    }
+    else if (root->id < 0)
+    {
+        if (rd_debug_enabled())
+            RD_LOG_WARN("Dialogue single missing id");
+        r = -6;
+    }
+    else if (!root->have_lines)
+        r = -7;
+    else
+    {
+        r = root->out > 0 ? rogue_dialogue_register_from_buffer(root->id, root->temp,
+                                                                (int) root->out)
+                          : -10;
+        if (rd_debug_enabled())
+            RD_LOG_INFO("Dialogue single summary id=%d status=%d lines_total=%d kept=%d "
+                        "skipped=%d",
+                        root->id, r, stats.lines_total, stats.lines_kept, stats.lines_skipped);
+    }
+    free(root);
     return r;
 }
 
@@ -1512,19 +1366,19 @@ int rogue_dialogue_restore(const RogueDialoguePersistState* st)
 
 /* Save component (choose id 9 unused in save manager enum range) */
 #define ROGUE_SAVE_COMP_DIALOGUE 9
-static int dialogue_write_fn(FILE* f)
+static int dialogue_write_fn(RogueSaveBuffer* out)
 {
     RogueDialoguePersistState st;
     int cap = rogue_dialogue_capture(&st);
     (void) cap;
-    return fwrite(&st, sizeof st, 1, f) == 1 ? 0 : -1;
+    return rogue_save_buffer_append(out, &st, sizeof st);
 }
-static int dialogue_read_fn(FILE* f, size_t size)
+static int dialogue_read_fn(RogueSaveReader* in, size_t size)
 {
     if (size != sizeof(RogueDialoguePersistState))
         return -1;
     RogueDialoguePersistState st;
-    if (fread(&st, sizeof st, 1, f) != 1)
+    if (rogue_save_reader_read(in, &st, sizeof st) != 0)
         return -2;
     return rogue_dialogue_restore(&st);
 }
@@ -1575,7 +1429,7 @@ void rogue_dialogue_log_current_line(void)
         expand_tokens(text, expanded, sizeof expanded);
         text = expanded;
     }
-    ROGUE_LOG_INFO("DIALOGUE[%d] %s: %s", sc->id, ln->speaker_id, text);
+    RD_LOG_INFO("DIALOGUE[%d] %s: %s", sc->id, ln->speaker_id, text);
     /* Phase 7 analytics update: on first display of a line (log moment) increment counters */
     int script_index = find_script_index(sc->id);
     if (script_index >= 0)
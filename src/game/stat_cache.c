@@ -10,7 +10,10 @@
  *
  * Key Features:
  * - Multi-layered stat aggregation (base, implicit, unique, set, runeword, affix, passive, buff)
- * - Dirty bit tracking for selective recomputation
+ * - Dirty bit tracking for selective recomputation: each bit is a node of the recompute graph
+ *   (attributes, passives, buffs, equipment) and only the dirty layers are re-queried before
+ *   totals, derived metrics and the fingerprint are rebuilt
+ * - Fingerprint-verified debug mode cross-checking incremental updates against full recomputes
  * - Equipment analytics and histogram tracking
  * - DPS/EHP estimation with outlier detection
  * - Deterministic fingerprinting for state validation
@@ -38,6 +41,7 @@
 #include "../util/log.h"
 #include <stddef.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 /* Forward buff query (Phase 10) */
@@ -45,6 +49,13 @@ int rogue_buffs_strength_bonus(void);
 
 RogueStatCache g_player_stat_cache = {0};
 
+/* Equipment inputs of the derived metrics, rescanned only when the equipment node is dirty so that
+ * attribute / passive / buff updates (every combat frame) skip the slot walks entirely. */
+static int g_equip_weapon_base = 3;
+static int g_equip_armor_total = 0;
+static int g_equip_scan_valid = 0;
+static int g_verify = -1; /* -1 = read ROGUE_STAT_CACHE_VERIFY on first query */
+
 /**
  * @brief Marks the entire stat cache as dirty, forcing full recomputation on next update.
  *
@@ -55,7 +66,8 @@ RogueStatCache g_player_stat_cache = {0};
 void rogue_stat_cache_mark_dirty(void)
 {
     g_player_stat_cache.dirty = 1;
-    g_player_stat_cache.dirty_bits = 0xFFFFFFFFu;
+    g_player_stat_cache.dirty_bits = ROGUE_STAT_DIRTY_ALL;
+    g_player_stat_cache.equipment_slot_dirty = 0xFFFFFFFFu;
 }
 
 /**
@@ -68,7 +80,7 @@ void rogue_stat_cache_mark_dirty(void)
 void rogue_stat_cache_mark_attr_dirty(void)
 {
     g_player_stat_cache.dirty = 1;
-    g_player_stat_cache.dirty_bits |= 1u;
+    g_player_stat_cache.dirty_bits |= ROGUE_STAT_DIRTY_ATTR;
 }
 
 /**
@@ -81,7 +93,7 @@ void rogue_stat_cache_mark_attr_dirty(void)
 void rogue_stat_cache_mark_passive_dirty(void)
 {
     g_player_stat_cache.dirty = 1;
-    g_player_stat_cache.dirty_bits |= 2u;
+    g_player_stat_cache.dirty_bits |= ROGUE_STAT_DIRTY_PASSIVE;
 }
 
 /**
@@ -94,7 +106,7 @@ void rogue_stat_cache_mark_passive_dirty(void)
 void rogue_stat_cache_mark_buff_dirty(void)
 {
     g_player_stat_cache.dirty = 1;
-    g_player_stat_cache.dirty_bits |= 4u;
+    g_player_stat_cache.dirty_bits |= ROGUE_STAT_DIRTY_BUFF;
 }
 
 /**
@@ -102,12 +114,68 @@ void rogue_stat_cache_mark_buff_dirty(void)
  *
  * Sets the dirty flag and marks the equipment dirty bit (bit 3) to trigger
  * recomputation of equipment-based bonuses during the next cache update.
- * Used when items are equipped, unequipped, or modified.
+ * Used when items are equipped, unequipped, or modified. Every slot is
+ * re-aggregated on the next rogue_equipment_apply_stat_bonuses.
  */
 void rogue_stat_cache_mark_equipment_dirty(void)
 {
     g_player_stat_cache.dirty = 1;
-    g_player_stat_cache.dirty_bits |= 8u;
+    g_player_stat_cache.dirty_bits |= ROGUE_STAT_DIRTY_EQUIPMENT;
+    g_player_stat_cache.equipment_slot_dirty = 0xFFFFFFFFu;
+}
+
+/**
+ * @brief Marks a single equipment slot as dirty.
+ *
+ * Like rogue_stat_cache_mark_equipment_dirty, but only the given slot has its
+ * contribution re-aggregated; the other slots keep their cached partial sums.
+ *
+ * @param slot Equipment slot index (out of range slots mark every slot)
+ */
+void rogue_stat_cache_mark_equipment_slot_dirty(int slot)
+{
+    g_player_stat_cache.dirty = 1;
+    g_player_stat_cache.dirty_bits |= ROGUE_STAT_DIRTY_EQUIPMENT;
+    if (slot < 0 || slot >= 32)
+        g_player_stat_cache.equipment_slot_dirty = 0xFFFFFFFFu;
+    else
+        g_player_stat_cache.equipment_slot_dirty |= 1u << slot;
+}
+
+/**
+ * @brief Enables or disables the fingerprint-verified debug mode.
+ *
+ * @param enabled Non-zero to cross-check every incremental update against a full recompute
+ */
+void rogue_stat_cache_set_verify(int enabled) { g_verify = enabled ? 1 : 0; }
+
+/**
+ * @brief Returns whether verify mode is active.
+ *
+ * The first query reads ROGUE_STAT_CACHE_VERIFY (any value other than "0" enables it)
+ * unless rogue_stat_cache_set_verify was called before.
+ *
+ * @return 1 when incremental updates are cross-checked, 0 otherwise
+ */
+int rogue_stat_cache_verify_enabled(void)
+{
+    if (g_verify < 0)
+    {
+#if defined(_MSC_VER)
+        char* v = NULL;
+        size_t vl = 0;
+        g_verify = 0;
+        if (_dupenv_s(&v, &vl, "ROGUE_STAT_CACHE_VERIFY") == 0 && v)
+        {
+            g_verify = v[0] && v[0] != '0';
+            free(v);
+        }
+#else
+        const char* v = getenv("ROGUE_STAT_CACHE_VERIFY");
+        g_verify = v && v[0] && v[0] != '0';
+#endif
+    }
+    return g_verify;
 }
 
 /**
@@ -293,7 +361,7 @@ static void compute_layers(const RoguePlayer* p, unsigned int dirty_bits)
      * update. */
     /* Passive layer (Phase 11.5 integration) only recomputed / fetched if passive dirty bit set to
      * avoid extra calls. */
-    if (dirty_bits & 2u)
+    if (dirty_bits & ROGUE_STAT_DIRTY_PASSIVE)
     {
         size_t def_count = 0;
         const RogueStatDef* defs = rogue_stat_def_all(&def_count);
@@ -332,7 +400,7 @@ static void compute_layers(const RoguePlayer* p, unsigned int dirty_bits)
     }
     /* Buff layer (Phase 10.1) fetched via buff system for snapshot/dynamic layering (currently
      * strength only exemplar) */
-    if (dirty_bits & 4u)
+    if (dirty_bits & ROGUE_STAT_DIRTY_BUFF)
     {
         g_player_stat_cache.buff_strength = rogue_buffs_strength_bonus();
     }
@@ -752,17 +820,26 @@ int rogue_equipment_usage_export_json(char* buf, int cap)
  * and performs final stat validation.
  *
  * @param p Pointer to player state for crit/haste calculations
+ * @param dirty_bits Recompute graph nodes that changed
  *
+ * @note Weapon damage and base armor are rescanned only when the equipment node is dirty
  * @note DPS = base_weapon_damage × dexterity_scalar × crit_multiplier
  * @note EHP = max_health + armor × 2 × vitality_scalar
  * @note Applies soft cap (75%) with diminishing returns to resistances
  * @note Hard caps resistances at 90% maximum
  * @note Logs final resistance values for debugging
  */
-static void compute_derived(const RoguePlayer* p)
+static void compute_derived(const RoguePlayer* p, unsigned int dirty_bits)
 {
-    int base_weapon = weapon_base_damage_estimate();
-    int armor_total = total_armor_value();
+    if ((dirty_bits & ROGUE_STAT_DIRTY_EQUIPMENT) || !g_equip_scan_valid)
+    {
+        g_equip_weapon_base = weapon_base_damage_estimate();
+        g_equip_armor_total = total_armor_value();
+        g_equip_scan_valid = 1;
+        g_player_stat_cache.equipment_scan_count++;
+    }
+    int base_weapon = g_equip_weapon_base;
+    int armor_total = g_equip_armor_total;
     float dex_scalar = 1.0f + (float) g_player_stat_cache.total_dexterity / 50.0f;
     float crit_mult = 1.0f + (p->crit_chance / 100.0f) * (p->crit_damage / 100.0f);
     g_player_stat_cache.dps_estimate = (int) (base_weapon * dex_scalar * crit_mult);
@@ -962,6 +1039,61 @@ static void compute_fingerprint(void)
 #undef F
 }
 
+/**
+ * @brief Runs the recompute graph for the given dirty nodes.
+ *
+ * Source layers are refreshed only when their node is dirty; totals, ratings, derived
+ * metrics and the fingerprint depend on every layer and are always rebuilt (cheap
+ * arithmetic over the cached per-layer partial sums).
+ *
+ * @param baseline Player with recovered base attributes
+ * @param p Player state used for crit / health inputs of derived metrics
+ * @param bits Dirty nodes (ROGUE_STAT_DIRTY_*)
+ */
+static void recompute(const RoguePlayer* baseline, const RoguePlayer* p, unsigned int bits)
+{
+    compute_layers(baseline, bits);
+    compute_derived(p, bits);
+    compute_fingerprint();
+}
+
+/**
+ * @brief Verify mode: cross-checks an incremental update against a full recompute.
+ *
+ * Replays the update from the pre-update state with every node dirty and compares the
+ * fingerprint, totals and derived metrics. A mismatch means some input changed without
+ * its node being marked; it is logged and counted, and the full result is kept.
+ *
+ * @param before Cache state before the incremental update
+ * @param bits Dirty nodes the incremental update used
+ * @param baseline Player with recovered base attributes
+ * @param p Player state
+ */
+static void verify_against_full(const RogueStatCache* before, unsigned int bits,
+                                const RoguePlayer* baseline, const RoguePlayer* p)
+{
+    RogueStatCache inc = g_player_stat_cache;
+    int inc_weapon = g_equip_weapon_base, inc_armor = g_equip_armor_total;
+    g_player_stat_cache = *before;
+    recompute(baseline, p, ROGUE_STAT_DIRTY_ALL);
+    g_player_stat_cache.equipment_scan_count = inc.equipment_scan_count;
+    if (inc.fingerprint == g_player_stat_cache.fingerprint &&
+        inc.total_strength == g_player_stat_cache.total_strength &&
+        inc.total_dexterity == g_player_stat_cache.total_dexterity &&
+        inc.total_vitality == g_player_stat_cache.total_vitality &&
+        inc.total_intelligence == g_player_stat_cache.total_intelligence &&
+        inc.dps_estimate == g_player_stat_cache.dps_estimate &&
+        inc.ehp_estimate == g_player_stat_cache.ehp_estimate &&
+        inc.mobility_index == g_player_stat_cache.mobility_index)
+        return;
+    g_player_stat_cache.verify_mismatch_count++;
+    ROGUE_LOG_WARN("stat cache verify: bits=0x%x incremental fp=%llu dps=%d ehp=%d weapon=%d "
+                   "armor=%d != full fp=%llu dps=%d ehp=%d weapon=%d armor=%d",
+                   bits, inc.fingerprint, inc.dps_estimate, inc.ehp_estimate, inc_weapon,
+                   inc_armor, g_player_stat_cache.fingerprint, g_player_stat_cache.dps_estimate,
+                   g_player_stat_cache.ehp_estimate, g_equip_weapon_base, g_equip_armor_total);
+}
+
 /**
  * @brief Updates the stat cache if marked as dirty.
  *
@@ -984,15 +1116,16 @@ void rogue_stat_cache_update(const RoguePlayer* p)
 }
 
 /**
- * @brief Forces a complete stat cache update regardless of dirty state.
+ * @brief Forces a stat cache update regardless of dirty state.
  *
- * Performs a full stat cache recomputation including layer computation, derived stats,
- * and fingerprint generation. Handles baseline recovery for robust updates and maintains
+ * Recomputes the dirty layers (all of them when no dirty bit is set), then totals, derived
+ * stats and the fingerprint. Handles baseline recovery for robust updates and maintains
  * snapshots for future incremental updates.
  *
  * @param p Pointer to player state
  *
- * @note Always performs full recomputation
+ * @note Always recomputes; layer sources are only re-queried when their dirty bit is set
+ * @note In verify mode incremental updates are cross-checked against a full recompute
  * @note Handles UI vs non-UI updates differently for baseline recovery
  * @note Updates recompute count and heavy passive count
  * @note Generates new fingerprint for state validation
@@ -1027,10 +1160,15 @@ void rogue_stat_cache_force_update(const RoguePlayer* p)
         baseline.intelligence = g_player_stat_cache.last_base_intelligence;
     }
     unsigned int bits =
-        g_player_stat_cache.dirty_bits ? g_player_stat_cache.dirty_bits : 0xFFFFFFFFu;
-    compute_layers(&baseline, bits);
-    compute_derived(p);
-    compute_fingerprint();
+        g_player_stat_cache.dirty_bits ? g_player_stat_cache.dirty_bits : ROGUE_STAT_DIRTY_ALL;
+    if (bits != ROGUE_STAT_DIRTY_ALL && rogue_stat_cache_verify_enabled())
+    {
+        RogueStatCache before = g_player_stat_cache;
+        recompute(&baseline, p, bits);
+        verify_against_full(&before, bits, &baseline, p);
+    }
+    else
+        recompute(&baseline, p, bits);
     g_player_stat_cache.dirty = 0;
     g_player_stat_cache.dirty_bits = 0;
     if (!ui_update)
@@ -1045,7 +1183,7 @@ void rogue_stat_cache_force_update(const RoguePlayer* p)
         g_player_stat_cache.last_base_dexterity = g_player_stat_cache.base_dexterity;
         g_player_stat_cache.last_base_vitality = g_player_stat_cache.base_vitality;
         g_player_stat_cache.last_base_intelligence = g_player_stat_cache.base_intelligence;
-        if (bits & 2u)
+        if (bits & ROGUE_STAT_DIRTY_PASSIVE)
             g_player_stat_cache.heavy_passive_recompute_count++;
         ROGUE_LOG_DEBUG(
             "DBG_TOTALS base[%d,%d,%d,%d] totals[%d,%d,%d,%d] affix[%d,%d,%d,%d] imp[%d,%d,%d,%d] "
@@ -4,6 +4,14 @@
 
 #include "../entities/player.h"
 
+/* Dirty bits (Phase 11.1). Each names one node of the recompute graph: a source layer whose change
+ * forces only that layer plus totals, derived metrics and the fingerprint to be refreshed. */
+#define ROGUE_STAT_DIRTY_ATTR 1u      /* base layer (player attributes, ratings) */
+#define ROGUE_STAT_DIRTY_PASSIVE 2u   /* passive layer */
+#define ROGUE_STAT_DIRTY_BUFF 4u      /* buff layer */
+#define ROGUE_STAT_DIRTY_EQUIPMENT 8u /* weapon damage / base armor scans feeding derived metrics */
+#define ROGUE_STAT_DIRTY_ALL 0xFFFFFFFFu
+
 typedef struct RogueStatCache
 {
     /* Layered attribute model (Phase 2.1) */
@@ -48,8 +56,11 @@ typedef struct RogueStatCache
     unsigned long long fingerprint;
     int dirty;               /* non-zero when cache invalid */
     unsigned int dirty_bits; /* bitmask: 1=attributes,2=passives,4=buffs,8=equipment (Phase 11.1) */
+    unsigned int equipment_slot_dirty;          /* per-slot bits forcing re-aggregation */
     unsigned int recompute_count;               /* total updates performed */
     unsigned int heavy_passive_recompute_count; /* times passive aggregation recomputed */
+    unsigned int equipment_scan_count;          /* times weapon/armor equipment scans ran */
+    unsigned int verify_mismatch_count;         /* verify mode: incremental != full recompute */
     /* Snapshots to support order-invariant baseline recovery across calls even if cache layers are
        externally altered between calls (e.g., tests zeroing affix_*). When the caller-provided
        player attributes match the last applied totals, we can restore the true base from these
@@ -82,12 +93,19 @@ void rogue_stat_cache_mark_attr_dirty(void);
 void rogue_stat_cache_mark_passive_dirty(void);
 void rogue_stat_cache_mark_buff_dirty(void);
 void rogue_stat_cache_mark_equipment_dirty(void);
+/* Only the given equipment slot changed; the other slots keep their cached contributions. */
+void rogue_stat_cache_mark_equipment_slot_dirty(int slot);
 /* Export instrumentation counters (Phase 11 tests) */
 unsigned int rogue_stat_cache_heavy_passive_recompute_count(void);
 size_t rogue_stat_cache_sizeof(void);
 void rogue_stat_cache_update(const RoguePlayer* p);       /* no-op if not dirty */
 void rogue_stat_cache_force_update(const RoguePlayer* p); /* always recompute */
 unsigned long long rogue_stat_cache_fingerprint(void);
+/* Debug verify mode (also enabled by env ROGUE_STAT_CACHE_VERIFY=1): every incremental update is
+ * cross-checked against a full recompute by fingerprint and derived metrics; mismatches are logged,
+ * counted in verify_mismatch_count and the full result is kept. */
+void rogue_stat_cache_set_verify(int enabled);
+int rogue_stat_cache_verify_enabled(void);
 /* Soft cap helper (Phase 2.4): applies diminishing returns; cap>0, softness>0 (higher softness ->
  * slower approach) */
 float rogue_soft_cap_apply(float value, float cap, float softness);
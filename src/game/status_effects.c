@@ -0,0 +1,534 @@
+/**
+ * @file status_effects.c
+ * @brief Entity-agnostic status effect store with batched ticking and timer-driven expiry.
+ *
+ * Records live in stable slots with structure-of-arrays columns (entity, type, magnitude, stacks,
+ * expiry, tick period / next tick) so the per-frame tick pass is one linear sweep over a few
+ * contiguous arrays regardless of how many entities carry effects. Expiry never scans: every
+ * expiry change pushes a (end_ms, slot, generation) entry into a 4-ary min-heap and superseded
+ * entries are discarded when they surface (or compacted once they dominate the heap). An
+ * open-addressing map from entity to its record chain serves per-entity queries.
+ *
+ * Enemies are the current producers: strike buildup applies bleed / chill and combat_status.c
+ * drives the update with the damage-over-time and expiry callbacks. Player buffs stay on the
+ * handle-based RogueBuffSet (buffs.c).
+ */
+
+#include "status_effects.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* ---- Record columns (indexed by slot) ---- */
+static RogueStatusEntity* g_entity = NULL; /* ROGUE_STATUS_ENTITY_NONE = free slot */
+static uint16_t* g_type = NULL;
+static uint16_t* g_stacks = NULL;
+static int* g_magnitude = NULL;
+static double* g_end_ms = NULL;
+static float* g_tick_period = NULL;
+static double* g_next_tick = NULL;
+static uint32_t* g_gen = NULL; /* bumped when expiry changes or the slot is freed */
+static int* g_next = NULL;     /* entity chain, or free list when the slot is free */
+static int g_cap = 0;
+static int g_high_water = 0;
+static int g_free_head = -1;
+static int g_live = 0;
+
+/* ---- Entity map: entity -> chain head (linear probing, backward-shift deletion) ---- */
+typedef struct StatusEntitySlot
+{
+    RogueStatusEntity entity; /* NONE = empty */
+    int head;
+    int count;
+} StatusEntitySlot;
+static StatusEntitySlot* g_map = NULL;
+static unsigned g_map_mask = 0;
+static int g_map_count = 0;
+
+/* ---- Expiry timers (4-ary min-heap on (when, slot)) ---- */
+typedef struct StatusTimer
+{
+    double when;
+    int slot;
+    uint32_t gen;
+} StatusTimer;
+static StatusTimer* g_heap = NULL;
+static int g_heap_count = 0;
+static int g_heap_cap = 0;
+
+static unsigned int g_expired_total = 0;
+static unsigned int g_ticks_total = 0;
+
+#define STATUS_GROW(ptr, type, cap)                                                                \
+    do                                                                                             \
+    {                                                                                              \
+        type* p_ = (type*) realloc(ptr, sizeof(type) * (size_t) (cap));                            \
+        if (!p_)                                                                                   \
+            return 0;                                                                              \
+        ptr = p_;                                                                                  \
+    } while (0)
+
+static int records_reserve(int need)
+{
+    if (need <= g_cap)
+        return 1;
+    int cap = g_cap ? g_cap * 2 : 256;
+    while (cap < need)
+        cap *= 2;
+    STATUS_GROW(g_entity, RogueStatusEntity, cap);
+    STATUS_GROW(g_type, uint16_t, cap);
+    STATUS_GROW(g_stacks, uint16_t, cap);
+    STATUS_GROW(g_magnitude, int, cap);
+    STATUS_GROW(g_end_ms, double, cap);
+    STATUS_GROW(g_tick_period, float, cap);
+    STATUS_GROW(g_next_tick, double, cap);
+    STATUS_GROW(g_gen, uint32_t, cap);
+    STATUS_GROW(g_next, int, cap);
+    g_cap = cap;
+    return 1;
+}
+
+static unsigned entity_hash(RogueStatusEntity e)
+{
+    uint32_t h = e * 0x9E3779B1u;
+    return (unsigned) (h ^ (h >> 15));
+}
+
+static StatusEntitySlot* map_find(RogueStatusEntity e)
+{
+    if (!g_map)
+        return NULL;
+    for (unsigned i = entity_hash(e) & g_map_mask;; i = (i + 1) & g_map_mask)
+    {
+        if (g_map[i].entity == e)
+            return &g_map[i];
+        if (g_map[i].entity == ROGUE_STATUS_ENTITY_NONE)
+            return NULL;
+    }
+}
+
+static int map_rehash(unsigned size)
+{
+    StatusEntitySlot* old = g_map;
+    unsigned old_size = g_map ? g_map_mask + 1 : 0;
+    StatusEntitySlot* map = (StatusEntitySlot*) calloc(size, sizeof(StatusEntitySlot));
+    if (!map)
+        return 0;
+    g_map = map;
+    g_map_mask = size - 1;
+    for (unsigned i = 0; i < old_size; i++)
+        if (old[i].entity != ROGUE_STATUS_ENTITY_NONE)
+        {
+            unsigned j = entity_hash(old[i].entity) & g_map_mask;
+            while (g_map[j].entity != ROGUE_STATUS_ENTITY_NONE)
+                j = (j + 1) & g_map_mask;
+            g_map[j] = old[i];
+        }
+    free(old);
+    return 1;
+}
+
+static StatusEntitySlot* map_insert(RogueStatusEntity e)
+{
+    if (!g_map || (unsigned) (g_map_count + 1) * 2 > g_map_mask + 1)
+        if (!map_rehash(g_map ? (g_map_mask + 1) * 2 : 64))
+            return NULL;
+    unsigned i = entity_hash(e) & g_map_mask;
+    while (g_map[i].entity != ROGUE_STATUS_ENTITY_NONE)
+        i = (i + 1) & g_map_mask;
+    g_map[i].entity = e;
+    g_map[i].head = -1;
+    g_map[i].count = 0;
+    g_map_count++;
+    return &g_map[i];
+}
+
+static void map_erase(StatusEntitySlot* slot)
+{
+    unsigned i = (unsigned) (slot - g_map);
+    g_map[i].entity = ROGUE_STATUS_ENTITY_NONE;
+    g_map_count--;
+    /* backward-shift: pull later cluster members into the hole when it is on their probe path */
+    for (unsigned j = (i + 1) & g_map_mask; g_map[j].entity != ROGUE_STATUS_ENTITY_NONE;
+         j = (j + 1) & g_map_mask)
+    {
+        unsigned home = entity_hash(g_map[j].entity) & g_map_mask;
+        if (((j - home) & g_map_mask) >= ((j - i) & g_map_mask))
+        {
+            g_map[i] = g_map[j];
+            g_map[j].entity = ROGUE_STATUS_ENTITY_NONE;
+            i = j;
+        }
+    }
+}
+
+static int timer_before(const StatusTimer* a, const StatusTimer* b)
+{
+    return a->when < b->when || (a->when == b->when && a->slot < b->slot);
+}
+
+static void heap_sift_down(int i)
+{
+    StatusTimer t = g_heap[i];
+    for (;;)
+    {
+        int first = (i << 2) + 1;
+        if (first >= g_heap_count)
+            break;
+        int best = first;
+        int last = first + 4 < g_heap_count ? first + 4 : g_heap_count;
+        for (int c = first + 1; c < last; ++c)
+            if (timer_before(&g_heap[c], &g_heap[best]))
+                best = c;
+        if (!timer_before(&g_heap[best], &t))
+            break;
+        g_heap[i] = g_heap[best];
+        i = best;
+    }
+    g_heap[i] = t;
+}
+
+static int timer_is_live(const StatusTimer* t)
+{
+    return g_entity[t->slot] != ROGUE_STATUS_ENTITY_NONE && g_gen[t->slot] == t->gen;
+}
+
+/* Superseded entries outnumber live records: drop them in one pass and re-heapify. */
+static void heap_compact(void)
+{
+    int n = 0;
+    for (int i = 0; i < g_heap_count; ++i)
+        if (timer_is_live(&g_heap[i]))
+            g_heap[n++] = g_heap[i];
+    g_heap_count = n;
+    for (int i = (n - 2) >> 2; i >= 0; --i)
+        heap_sift_down(i);
+}
+
+/* (Re)arm the expiry timer of a slot after its end_ms changed. */
+static int schedule_expiry(int slot)
+{
+    g_gen[slot]++;
+    if (g_heap_count - g_live > g_live + 64)
+        heap_compact();
+    if (g_heap_count == g_heap_cap)
+    {
+        int cap = g_heap_cap ? g_heap_cap * 2 : 256;
+        STATUS_GROW(g_heap, StatusTimer, cap);
+        g_heap_cap = cap;
+    }
+    StatusTimer t = {g_end_ms[slot], slot, g_gen[slot]};
+    int i = g_heap_count++;
+    while (i > 0)
+    {
+        int parent = (i - 1) >> 2;
+        if (!timer_before(&t, &g_heap[parent]))
+            break;
+        g_heap[i] = g_heap[parent];
+        i = parent;
+    }
+    g_heap[i] = t;
+    return 1;
+}
+
+static int find_record(RogueStatusEntity entity, int type)
+{
+    const StatusEntitySlot* m = map_find(entity);
+    if (!m)
+        return -1;
+    for (int s = m->head; s >= 0; s = g_next[s])
+        if (g_type[s] == (uint16_t) type)
+            return s;
+    return -1;
+}
+
+static int create_record(RogueStatusEntity entity, int type)
+{
+    StatusEntitySlot* m = map_find(entity);
+    if (!m && !(m = map_insert(entity)))
+        return -1;
+    int slot = g_free_head;
+    if (slot >= 0)
+        g_free_head = g_next[slot];
+    else
+    {
+        if (!records_reserve(g_high_water + 1))
+        {
+            if (m->count == 0)
+                map_erase(m);
+            return -1;
+        }
+        slot = g_high_water++;
+        g_gen[slot] = 0;
+    }
+    g_entity[slot] = entity;
+    g_type[slot] = (uint16_t) type;
+    g_stacks[slot] = 1;
+    g_magnitude[slot] = 0;
+    g_end_ms[slot] = 0.0;
+    g_tick_period[slot] = 0.0f;
+    g_next_tick[slot] = 0.0;
+    g_next[slot] = m->head;
+    m->head = slot;
+    m->count++;
+    g_live++;
+    return slot;
+}
+
+static void destroy_record(int slot)
+{
+    StatusEntitySlot* m = map_find(g_entity[slot]);
+    if (m)
+    {
+        int* link = &m->head;
+        while (*link >= 0 && *link != slot)
+            link = &g_next[*link];
+        if (*link == slot)
+            *link = g_next[slot];
+        if (--m->count == 0)
+            map_erase(m);
+    }
+    g_entity[slot] = ROGUE_STATUS_ENTITY_NONE;
+    g_gen[slot]++;
+    g_next[slot] = g_free_head;
+    g_free_head = slot;
+    g_live--;
+}
+
+static int valid_key(RogueStatusEntity entity, int type)
+{
+    return entity != ROGUE_STATUS_ENTITY_NONE && type >= 0 && type < ROGUE_STATUS_TYPE_MAX;
+}
+
+/**
+ * @brief Drops every record and timer; allocations are kept for reuse.
+ */
+void rogue_status_reset(void)
+{
+    g_high_water = 0;
+    g_free_head = -1;
+    g_live = 0;
+    g_heap_count = 0;
+    if (g_map)
+        memset(g_map, 0, sizeof(StatusEntitySlot) * (size_t) (g_map_mask + 1));
+    g_map_count = 0;
+    g_expired_total = 0;
+    g_ticks_total = 0;
+}
+
+/**
+ * @brief Releases all store memory.
+ */
+void rogue_status_shutdown(void)
+{
+    free(g_entity);
+    free(g_type);
+    free(g_stacks);
+    free(g_magnitude);
+    free(g_end_ms);
+    free(g_tick_period);
+    free(g_next_tick);
+    free(g_gen);
+    free(g_next);
+    free(g_map);
+    free(g_heap);
+    g_entity = NULL;
+    g_type = g_stacks = NULL;
+    g_magnitude = g_next = NULL;
+    g_end_ms = g_next_tick = NULL;
+    g_tick_period = NULL;
+    g_gen = NULL;
+    g_map = NULL;
+    g_map_mask = 0;
+    g_heap = NULL;
+    g_cap = g_heap_cap = 0;
+    rogue_status_reset();
+}
+
+/**
+ * @brief Applies a status with buff stacking semantics.
+ *
+ * A record whose expiry has passed but which the update has not yet collected is replaced as if
+ * absent. MULTIPLY needs an existing record; UNIQUE rejects while one is active.
+ *
+ * @return 1 if a record was created or changed, 0 otherwise
+ */
+int rogue_status_apply(RogueStatusEntity entity, int type, int magnitude, double duration_ms,
+                       double now_ms, RogueBuffStackRule rule, float tick_period_ms)
+{
+    if (!valid_key(entity, type) || magnitude <= 0 || duration_ms <= 0)
+        return 0;
+    if (rule < ROGUE_BUFF_STACK_UNIQUE || rule > ROGUE_BUFF_STACK_REPLACE_IF_STRONGER)
+        rule = ROGUE_BUFF_STACK_ADD;
+    double new_end = now_ms + duration_ms;
+    int s = find_record(entity, type);
+    if (s >= 0 && g_end_ms[s] <= now_ms)
+    {
+        destroy_record(s);
+        s = -1;
+    }
+    if (s < 0)
+    {
+        if (rule == ROGUE_BUFF_STACK_MULTIPLY)
+            return 0;
+        s = create_record(entity, type);
+        if (s < 0)
+            return 0;
+        g_magnitude[s] = magnitude > 999 ? 999 : magnitude;
+        g_end_ms[s] = new_end;
+        g_tick_period[s] = tick_period_ms > 0.0f ? tick_period_ms : 0.0f;
+        g_next_tick[s] = now_ms + (double) g_tick_period[s];
+        return schedule_expiry(s);
+    }
+    double old_end = g_end_ms[s];
+    switch (rule)
+    {
+    case ROGUE_BUFF_STACK_UNIQUE:
+        return 0;
+    case ROGUE_BUFF_STACK_REFRESH:
+        if (magnitude > g_magnitude[s])
+            g_magnitude[s] = magnitude;
+        g_end_ms[s] = new_end;
+        break;
+    case ROGUE_BUFF_STACK_EXTEND:
+        g_end_ms[s] += duration_ms;
+        if (g_end_ms[s] < new_end)
+            g_end_ms[s] = new_end;
+        if (g_magnitude[s] < magnitude)
+            g_magnitude[s] = magnitude;
+        break;
+    case ROGUE_BUFF_STACK_ADD:
+    default:
+        g_magnitude[s] += magnitude;
+        if (g_magnitude[s] > 999)
+            g_magnitude[s] = 999;
+        if (g_stacks[s] < 0xFFFFu)
+            g_stacks[s]++;
+        if (new_end > g_end_ms[s])
+            g_end_ms[s] = new_end;
+        break;
+    case ROGUE_BUFF_STACK_MULTIPLY:
+    {
+        long long nm = (long long) g_magnitude[s] * (long long) magnitude / 100;
+        g_magnitude[s] = (int) (nm > 999 ? 999 : nm);
+        if (new_end > g_end_ms[s])
+            g_end_ms[s] = new_end;
+        break;
+    }
+    case ROGUE_BUFF_STACK_REPLACE_IF_STRONGER:
+        if (magnitude > g_magnitude[s])
+            g_magnitude[s] = magnitude;
+        if (new_end > g_end_ms[s])
+            g_end_ms[s] = new_end;
+        break;
+    }
+    if (g_end_ms[s] != old_end)
+        return schedule_expiry(s);
+    return 1;
+}
+
+/**
+ * @brief Removes one record without invoking callbacks.
+ * @return 1 if a record was removed
+ */
+int rogue_status_remove(RogueStatusEntity entity, int type)
+{
+    if (!valid_key(entity, type))
+        return 0;
+    int s = find_record(entity, type);
+    if (s < 0)
+        return 0;
+    destroy_record(s);
+    return 1;
+}
+
+/**
+ * @brief Removes every record of an entity (despawn / death).
+ */
+void rogue_status_remove_entity(RogueStatusEntity entity)
+{
+    const StatusEntitySlot* m = map_find(entity);
+    while (m && m->head >= 0)
+    {
+        destroy_record(m->head);
+        m = map_find(entity);
+    }
+}
+
+int rogue_status_get_total(RogueStatusEntity entity, int type)
+{
+    int s = valid_key(entity, type) ? find_record(entity, type) : -1;
+    return s >= 0 ? g_magnitude[s] : 0;
+}
+
+int rogue_status_stacks(RogueStatusEntity entity, int type)
+{
+    int s = valid_key(entity, type) ? find_record(entity, type) : -1;
+    return s >= 0 ? (int) g_stacks[s] : 0;
+}
+
+double rogue_status_end_ms(RogueStatusEntity entity, int type)
+{
+    int s = valid_key(entity, type) ? find_record(entity, type) : -1;
+    return s >= 0 ? g_end_ms[s] : -1.0;
+}
+
+int rogue_status_entity_count(RogueStatusEntity entity)
+{
+    const StatusEntitySlot* m = map_find(entity);
+    return m ? m->count : 0;
+}
+
+/**
+ * @brief Delivers due periodic ticks, then expires due records.
+ *
+ * The tick pass reads the period / next-tick columns of every slot below the high-water mark
+ * captured at entry; a record ticks for each period boundary in (last tick, min(now, end)].
+ * Expiry pops the timer heap only while its root is due, so idle frames cost O(1).
+ */
+void rogue_status_update(double now_ms, RogueStatusTickFn on_tick,
+                         RogueStatusExpireFn on_expire, void* user)
+{
+    int hw = g_high_water;
+    for (int s = 0; s < hw; ++s)
+    {
+        if (g_tick_period[s] <= 0.0f || g_next_tick[s] > now_ms ||
+            g_entity[s] == ROGUE_STATUS_ENTITY_NONE)
+            continue;
+        double limit = now_ms < g_end_ms[s] ? now_ms : g_end_ms[s];
+        if (g_next_tick[s] > limit)
+            continue;
+        double period = (double) g_tick_period[s];
+        int n = (int) ((limit - g_next_tick[s]) / period) + 1;
+        g_next_tick[s] += period * n;
+        g_ticks_total += (unsigned int) n;
+        if (on_tick)
+            on_tick(g_entity[s], (int) g_type[s], g_magnitude[s], n, user);
+    }
+    while (g_heap_count > 0 && g_heap[0].when <= now_ms)
+    {
+        StatusTimer t = g_heap[0];
+        g_heap[0] = g_heap[--g_heap_count];
+        if (g_heap_count > 0)
+            heap_sift_down(0);
+        if (!timer_is_live(&t))
+            continue;
+        RogueStatusEntity entity = g_entity[t.slot];
+        int type = (int) g_type[t.slot];
+        int magnitude = g_magnitude[t.slot];
+        destroy_record(t.slot);
+        g_expired_total++;
+        if (on_expire)
+            on_expire(entity, type, magnitude, user);
+    }
+}
+
+void rogue_status_stats(RogueStatusStats* out)
+{
+    if (!out)
+        return;
+    out->live = g_live;
+    out->entities = g_map_count;
+    out->timer_entries = g_heap_count;
+    out->expired = g_expired_total;
+    out->ticks = g_ticks_total;
+}
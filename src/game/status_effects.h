@@ -0,0 +1,70 @@
+/* Entity-agnostic status effect store (buffs, debuffs, damage-over-time) */
+#ifndef ROGUE_GAME_STATUS_EFFECTS_H
+#define ROGUE_GAME_STATUS_EFFECTS_H
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+#include "buffs.h"
+#include <stdint.h>
+
+    /* Records are keyed by (entity, status type). Entities are opaque non-zero handles; enemies
+     * use their g_app.enemies slot offset by ROGUE_STATUS_ENTITY_ENEMY_BASE. Status types share the
+     * RogueBuffType id space and extend past ROGUE_BUFF_MAX for entity-only effects. */
+    typedef uint32_t RogueStatusEntity;
+#define ROGUE_STATUS_ENTITY_NONE 0u
+#define ROGUE_STATUS_ENTITY_ENEMY_BASE 0x10000u
+    static inline RogueStatusEntity rogue_status_entity_enemy(int enemy_index)
+    {
+        return ROGUE_STATUS_ENTITY_ENEMY_BASE + (uint32_t) enemy_index;
+    }
+
+    typedef enum RogueStatusType
+    {
+        ROGUE_STATUS_BLEED = ROGUE_BUFF_MAX, /* physical damage over time from bleed buildup */
+        ROGUE_STATUS_CHILL,                  /* movement slow percent from frost buildup */
+        ROGUE_STATUS_TYPE_MAX = 64
+    } RogueStatusType;
+
+    /* Batched update callbacks. on_tick receives the number of periods elapsed since the last
+     * update (so a long frame delivers one call, not one per period). */
+    typedef void (*RogueStatusTickFn)(RogueStatusEntity entity, int type, int magnitude, int ticks,
+                                      void* user);
+    typedef void (*RogueStatusExpireFn)(RogueStatusEntity entity, int type, int magnitude,
+                                        void* user);
+
+    typedef struct RogueStatusStats
+    {
+        int live;             /* active records */
+        int entities;         /* entities with at least one record */
+        int timer_entries;    /* expiry heap entries (live + superseded) */
+        unsigned int expired; /* records removed by their expiry timer */
+        unsigned int ticks;   /* tick periods delivered */
+    } RogueStatusStats;
+
+    void rogue_status_reset(void); /* drop every record (keeps allocations) */
+    void rogue_status_shutdown(void);
+    /* Apply with buff stacking semantics (UNIQUE / REFRESH / EXTEND / ADD / MULTIPLY /
+     * REPLACE_IF_STRONGER). tick_period_ms > 0 makes the record periodic. Returns 1 if a record
+     * was created or changed. */
+    int rogue_status_apply(RogueStatusEntity entity, int type, int magnitude, double duration_ms,
+                           double now_ms, RogueBuffStackRule rule, float tick_period_ms);
+    int rogue_status_remove(RogueStatusEntity entity, int type);
+    void rogue_status_remove_entity(RogueStatusEntity entity);
+
+    int rogue_status_get_total(RogueStatusEntity entity, int type); /* 0 when absent */
+    int rogue_status_stacks(RogueStatusEntity entity, int type);
+    double rogue_status_end_ms(RogueStatusEntity entity, int type); /* -1 when absent */
+    int rogue_status_entity_count(RogueStatusEntity entity);        /* records on the entity */
+
+    /* Deliver periodic ticks due up to min(now, expiry) in one pass over the SoA columns, then
+     * expire due records from the timer heap. Callbacks may be NULL and may apply / remove
+     * records; records created during the update tick from the next one. */
+    void rogue_status_update(double now_ms, RogueStatusTickFn on_tick,
+                             RogueStatusExpireFn on_expire, void* user);
+    void rogue_status_stats(RogueStatusStats* out);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -20,6 +20,7 @@
 
 #include "weapon_pose.h"
 #include "../core/app/app_state.h"
+#include "../util/json_tok.h"
 #include "../util/log.h"
 #include <stdio.h>
 #include <stdlib.h>
@@ -151,6 +152,76 @@ static int parse_float(const char* s, float* out)
     return 1;
 }
 
+/**
+ * @brief Apply the "frames" array of a pose JSON document onto a frame array.
+ *
+ * Walks the document once with the shared tokenizer. Each frame object overrides the fields it
+ * names (dx, dy, angle, scale, pivot_x, pivot_y; numbers or numeric strings) on top of the
+ * frame already in place, so missing keys keep their defaults.
+ *
+ * @param buf JSON text
+ * @param len Length of buf in bytes
+ * @param frames Array of FRAME_COUNT frames, pre-filled with defaults
+ * @return Number of frame objects applied (parsing stops at the first malformed token)
+ */
+static int parse_pose_frames(const char* buf, size_t len, RogueWeaponPoseFrame* frames)
+{
+    RogueJsonTokenizer t;
+    RogueJsonToken v, e;
+    RogueJsonView key;
+    int frame_idx = 0;
+    rogue_json_tok_init(&t, buf, len);
+    if (rogue_json_tok_next(&t, &v) != ROGUE_JTOK_OBJECT_BEGIN)
+        return 0;
+    while (rogue_json_tok_member(&t, &key, &v) > 0)
+    {
+        if (!rogue_json_view_eq(key, "frames") || v.type != ROGUE_JTOK_ARRAY_BEGIN)
+        {
+            (void) rogue_json_tok_skip(&t, &v);
+            continue;
+        }
+        while (rogue_json_tok_element(&t, &e) > 0)
+        {
+            if (e.type != ROGUE_JTOK_OBJECT_BEGIN || frame_idx >= FRAME_COUNT)
+            {
+                (void) rogue_json_tok_skip(&t, &e);
+                continue;
+            }
+            RogueWeaponPoseFrame fr = frames[frame_idx];
+            int r;
+            while ((r = rogue_json_tok_member(&t, &key, &v)) > 0)
+            {
+                char val[64];
+                float fv;
+                if (v.type != ROGUE_JTOK_NUMBER && v.type != ROGUE_JTOK_STRING)
+                {
+                    (void) rogue_json_tok_skip(&t, &v);
+                    continue;
+                }
+                rogue_json_tok_copy(&v, val, sizeof val);
+                if (!parse_float(val, &fv))
+                    continue;
+                if (rogue_json_view_eq(key, "dx"))
+                    fr.dx = fv;
+                else if (rogue_json_view_eq(key, "dy"))
+                    fr.dy = fv;
+                else if (rogue_json_view_eq(key, "angle"))
+                    fr.angle = fv;
+                else if (rogue_json_view_eq(key, "scale"))
+                    fr.scale = fv;
+                else if (rogue_json_view_eq(key, "pivot_x"))
+                    fr.pivot_x = fv;
+                else if (rogue_json_view_eq(key, "pivot_y"))
+                    fr.pivot_y = fv;
+            }
+            if (r < 0)
+                return frame_idx;
+            frames[frame_idx++] = fr;
+        }
+    }
+    return frame_idx;
+}
+
 /**
  * @brief Initialize weapon pose frames with default values.
  *
@@ -267,102 +338,7 @@ static int load_json_pose(int weapon_id, WeaponPoseSet* set)
     buf[sz] = '\0';
     fclose(f);
     default_frames(set);
-    const char* s = buf;
-    int frame_idx = 0;
-    while (*s && frame_idx < FRAME_COUNT)
-    {
-        const char* fkey = strstr(s, "\"frames\"");
-        if (!fkey)
-            break;
-        s = fkey;
-        while (*s && *s != '[')
-            s++;
-        if (*s != '[')
-            break;
-        s++; /* inside frames */
-        while (*s && frame_idx < FRAME_COUNT)
-        {
-            while (*s && (*s == ' ' || *s == '\n' || *s == '\r' || *s == '\t' || *s == ','))
-                s++;
-            if (*s == ']' || !*s)
-                break;
-            if (*s != '{')
-            {
-                s++;
-                continue;
-            }
-            s++;
-            RogueWeaponPoseFrame fr = set->frames[frame_idx];
-            while (*s && *s != '}')
-            {
-                while (*s && (*s == ' ' || *s == '\n' || *s == '\r' || *s == '\t' || *s == ','))
-                    s++;
-                if (*s != '"')
-                {
-                    s++;
-                    continue;
-                }
-                s++;
-                const char* key = s;
-                while (*s && *s != '"')
-                    s++;
-                if (!*s)
-                    break;
-                size_t klen = (size_t) (s - key);
-                s++;
-                while (*s && *s != ':')
-                    s++;
-                if (*s == ':')
-                    s++;
-                while (*s == ' ' || *s == '\n' || *s == '\r')
-                    s++;
-                char val[64];
-                int vi = 0;
-                if (*s == '"')
-                {
-                    s++;
-                    while (*s && *s != '"' && vi < 63)
-                    {
-                        val[vi++] = *s++;
-                    }
-                    if (*s == '"')
-                        s++;
-                }
-                else
-                {
-                    while (*s && *s != ',' && *s != '}' && vi < 63)
-                    {
-                        val[vi++] = *s++;
-                    }
-                }
-                val[vi] = '\0';
-                float fv;
-                if (parse_float(val, &fv))
-                {
-                    if (klen == 2 && strncmp(key, "dx", 2) == 0)
-                        fr.dx = fv;
-                    else if (klen == 2 && strncmp(key, "dy", 2) == 0)
-                        fr.dy = fv;
-                    else if (klen == 5 && strncmp(key, "angle", 5) == 0)
-                        fr.angle = fv;
-                    else if (klen == 5 && strncmp(key, "scale", 5) == 0)
-                        fr.scale = fv;
-                    else if (klen == 7 && strncmp(key, "pivot_x", 7) == 0)
-                        fr.pivot_x = fv;
-                    else if (klen == 7 && strncmp(key, "pivot_y", 7) == 0)
-                        fr.pivot_y = fv;
-                }
-            }
-            while (*s && *s != '}')
-                s++;
-            if (*s == '}')
-            {
-                s++;
-                set->frames[frame_idx] = fr;
-                frame_idx++;
-            }
-        }
-    }
+    parse_pose_frames(buf, (size_t) sz, set->frames);
     free(buf);
     return 1;
 }
@@ -452,101 +428,7 @@ static int load_json_pose_dir(int weapon_id, int dir_group, RogueWeaponPoseFrame
     buf[sz] = '\0';
     fclose(f);
     default_frames_dir(out_frames);
-    const char* s = buf;
-    int frame_idx = 0;
-    const char* fkey = strstr(s, "\"frames\"");
-    if (fkey)
-    {
-        s = fkey;
-        while (*s && *s != '[')
-            s++;
-        if (*s == '[')
-        {
-            s++;
-            while (*s && frame_idx < FRAME_COUNT)
-            {
-                while (*s && (*s == ' ' || *s == '\n' || *s == '\r' || *s == '\t' || *s == ','))
-                    s++;
-                if (*s == ']' || !*s)
-                    break;
-                if (*s != '{')
-                {
-                    s++;
-                    continue;
-                }
-                s++;
-                RogueWeaponPoseFrame fr = out_frames[frame_idx];
-                while (*s && *s != '}')
-                {
-                    while (*s && (*s == ' ' || *s == '\n' || *s == '\r' || *s == '\t' || *s == ','))
-                        s++;
-                    if (*s != '\"')
-                    {
-                        s++;
-                        continue;
-                    }
-                    s++;
-                    const char* key = s;
-                    while (*s && *s != '\"')
-                        s++;
-                    if (!*s)
-                        break;
-                    size_t klen = (size_t) (s - key);
-                    s++;
-                    while (*s && *s != ':')
-                        s++;
-                    if (*s == ':')
-                        s++;
-                    while (*s == ' ' || *s == '\n' || *s == '\r')
-                        s++;
-                    char val[64];
-                    int vi = 0;
-                    if (*s == '\"')
-                    {
-                        s++;
-                        while (*s && *s != '\"' && vi < 63)
-                        {
-                            val[vi++] = *s++;
-                        }
-                        if (*s == '\"')
-                            s++;
-                    }
-                    else
-                    {
-                        while (*s && *s != ',' && *s != '}' && vi < 63)
-                        {
-                            val[vi++] = *s++;
-                        }
-                    }
-                    val[vi] = '\0';
-                    float fv;
-                    if (parse_float(val, &fv))
-                    {
-                        if (klen == 2 && strncmp(key, "dx", 2) == 0)
-                            fr.dx = fv;
-                        else if (klen == 2 && strncmp(key, "dy", 2) == 0)
-                            fr.dy = fv;
-                        else if (klen == 5 && strncmp(key, "angle", 5) == 0)
-                            fr.angle = fv;
-                        else if (klen == 5 && strncmp(key, "scale", 5) == 0)
-                            fr.scale = fv;
-                        else if (klen == 7 && strncmp(key, "pivot_x", 7) == 0)
-                            fr.pivot_x = fv;
-                        else if (klen == 7 && strncmp(key, "pivot_y", 7) == 0)
-                            fr.pivot_y = fv;
-                    }
-                }
-                while (*s && *s != '}')
-                    s++;
-                if (*s == '}')
-                {
-                    s++;
-                    out_frames[frame_idx] = fr;
-                    frame_idx++;
-                }
-            }
-        }
-    }
+    int frame_idx = parse_pose_frames(buf, (size_t) sz, out_frames);
     free(buf);
     ROGUE_LOG_DEBUG("weapon_pose_dir_loaded: wid=%d dir=%d frames=%d", weapon_id, dir_group,
                     frame_idx);
@@ -0,0 +1,360 @@
+/* Skyline atlas packer + manifest bake / IO */
+#include "atlas_packer.h"
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+int rogue_atlas_packer_init(RogueAtlasPacker* p, int width, int height, int padding)
+{
+    if (!p || width <= 0 || height <= 0 || padding < 0)
+        return -1;
+    memset(p, 0, sizeof *p);
+    p->nodes = (RogueAtlasSkylineNode*) malloc(sizeof(RogueAtlasSkylineNode) * 16);
+    if (!p->nodes)
+        return -1;
+    p->node_cap = 16;
+    p->node_count = 1;
+    p->nodes[0].x = 0;
+    p->nodes[0].y = 0;
+    p->nodes[0].w = width;
+    p->width = width;
+    p->height = height;
+    p->padding = padding;
+    return 0;
+}
+
+void rogue_atlas_packer_free(RogueAtlasPacker* p)
+{
+    if (!p)
+        return;
+    free(p->nodes);
+    memset(p, 0, sizeof *p);
+}
+
+/* Lowest y at which a rect w x h, whose skyline footprint is span wide, rests on the skyline
+   starting at node i; -1 when it does not fit. */
+static int skyline_fit(const RogueAtlasPacker* p, int i, int w, int h, int span)
+{
+    int x = p->nodes[i].x;
+    if (x + w > p->width)
+        return -1;
+    int y = 0;
+    for (int remaining = span; remaining > 0; ++i)
+    {
+        if (i >= p->node_count)
+            return -1;
+        if (p->nodes[i].y > y)
+            y = p->nodes[i].y;
+        if (y + h > p->height)
+            return -1;
+        remaining -= p->nodes[i].w;
+    }
+    return y;
+}
+
+int rogue_atlas_packer_insert(RogueAtlasPacker* p, int w, int h, int* out_x, int* out_y)
+{
+    if (!p || !p->nodes || w <= 0 || h <= 0)
+        return 0;
+    /* the padding may hang off the right / bottom edge */
+    int fh = h + p->padding;
+    int best = -1, best_y = INT_MAX, best_w = INT_MAX, best_span = 0;
+    for (int i = 0; i < p->node_count; ++i)
+    {
+        int span = w + p->padding;
+        if (p->nodes[i].x + span > p->width)
+            span = p->width - p->nodes[i].x;
+        int y = skyline_fit(p, i, w, h, span);
+        if (y < 0)
+            continue;
+        if (y < best_y || (y == best_y && p->nodes[i].w < best_w))
+        {
+            best_span = span;
+            best = i;
+            best_y = y;
+            best_w = p->nodes[i].w;
+        }
+    }
+    if (best < 0)
+        return 0;
+    if (p->node_count + 1 > p->node_cap)
+    {
+        int cap = p->node_cap * 2;
+        RogueAtlasSkylineNode* nodes = (RogueAtlasSkylineNode*) realloc(
+            p->nodes, sizeof(RogueAtlasSkylineNode) * (size_t) cap);
+        if (!nodes)
+            return 0;
+        p->nodes = nodes;
+        p->node_cap = cap;
+    }
+    memmove(&p->nodes[best + 1], &p->nodes[best],
+            sizeof(RogueAtlasSkylineNode) * (size_t) (p->node_count - best));
+    p->node_count++;
+    RogueAtlasSkylineNode* n = &p->nodes[best];
+    n->x = p->nodes[best + 1].x;
+    n->y = best_y + fh;
+    n->w = best_span;
+    *out_x = n->x; /* n moves once neighbours merge */
+    *out_y = best_y;
+    /* trim the segments now covered by the new one */
+    for (int j = best + 1; j < p->node_count; ++j)
+    {
+        int prev_end = p->nodes[j - 1].x + p->nodes[j - 1].w;
+        if (p->nodes[j].x >= prev_end)
+            break;
+        int shrink = prev_end - p->nodes[j].x;
+        p->nodes[j].x += shrink;
+        p->nodes[j].w -= shrink;
+        if (p->nodes[j].w > 0)
+            break;
+        memmove(&p->nodes[j], &p->nodes[j + 1],
+                sizeof(RogueAtlasSkylineNode) * (size_t) (p->node_count - j - 1));
+        p->node_count--;
+        --j;
+    }
+    /* merge neighbours at the same height */
+    for (int j = 0; j + 1 < p->node_count; ++j)
+    {
+        if (p->nodes[j].y != p->nodes[j + 1].y)
+            continue;
+        p->nodes[j].w += p->nodes[j + 1].w;
+        memmove(&p->nodes[j + 1], &p->nodes[j + 2],
+                sizeof(RogueAtlasSkylineNode) * (size_t) (p->node_count - j - 2));
+        p->node_count--;
+        --j;
+    }
+    p->used_area += (long long) best_span * fh;
+    return 1;
+}
+
+double rogue_atlas_packer_occupancy(const RogueAtlasPacker* p)
+{
+    if (!p || p->width <= 0 || p->height <= 0)
+        return 0.0;
+    return (double) p->used_area / ((double) p->width * (double) p->height);
+}
+
+/* -------- Manifests -------- */
+
+static int manifest_push(RogueAtlasManifest* m, const char* path, int page, int x, int y, int w,
+                         int h)
+{
+    if (m->count == m->cap)
+    {
+        int cap = m->cap ? m->cap * 2 : 64;
+        RogueAtlasPlacement* items =
+            (RogueAtlasPlacement*) realloc(m->items, sizeof(RogueAtlasPlacement) * (size_t) cap);
+        if (!items)
+            return -1;
+        m->items = items;
+        m->cap = cap;
+    }
+    RogueAtlasPlacement* it = &m->items[m->count++];
+    snprintf(it->path, sizeof it->path, "%s", path);
+    rogue_atlas_normalize_path(it->path);
+    it->page = page;
+    it->x = x;
+    it->y = y;
+    it->w = w;
+    it->h = h;
+    return 0;
+}
+
+typedef struct BakeItem
+{
+    const char* path;
+    int w, h;
+} BakeItem;
+
+static int cmp_bake_item(const void* a, const void* b)
+{
+    const BakeItem* A = (const BakeItem*) a;
+    const BakeItem* B = (const BakeItem*) b;
+    if (A->h != B->h)
+        return B->h - A->h;
+    if (A->w != B->w)
+        return B->w - A->w;
+    return strcmp(A->path, B->path);
+}
+
+int rogue_atlas_manifest_bake(RogueAtlasManifest* m, const char* const* paths, const int* ws,
+                              const int* hs, int n, int page_size, int padding)
+{
+    if (!m || n < 0 || (n > 0 && (!paths || !ws || !hs)) || page_size <= 0 || padding < 0)
+        return -1;
+    memset(m, 0, sizeof *m);
+    m->page_w = m->page_h = page_size;
+    m->padding = padding;
+    BakeItem* items = (BakeItem*) malloc(sizeof(BakeItem) * (size_t) (n ? n : 1));
+    if (!items)
+        return -1;
+    int count = 0;
+    for (int i = 0; i < n; ++i)
+        if (paths[i] && ws[i] > 0 && hs[i] > 0 && ws[i] <= page_size && hs[i] <= page_size)
+        {
+            items[count].path = paths[i];
+            items[count].w = ws[i];
+            items[count].h = hs[i];
+            count++;
+        }
+    qsort(items, (size_t) count, sizeof(BakeItem), cmp_bake_item);
+    RogueAtlasPacker* pages = NULL;
+    int rc = 0;
+    for (int i = 0; i < count && rc == 0; ++i)
+    {
+        int x = 0, y = 0, page = 0;
+        while (page < m->page_count &&
+               !rogue_atlas_packer_insert(&pages[page], items[i].w, items[i].h, &x, &y))
+            page++;
+        if (page == m->page_count)
+        {
+            RogueAtlasPacker* grown = (RogueAtlasPacker*) realloc(
+                pages, sizeof(RogueAtlasPacker) * (size_t) (m->page_count + 1));
+            if (!grown)
+            {
+                rc = -1;
+                break;
+            }
+            pages = grown;
+            if (rogue_atlas_packer_init(&pages[page], page_size, page_size, padding) != 0)
+            {
+                rc = -1;
+                break;
+            }
+            m->page_count++;
+            rogue_atlas_packer_insert(&pages[page], items[i].w, items[i].h, &x, &y);
+        }
+        rc = manifest_push(m, items[i].path, page, x, y, items[i].w, items[i].h);
+    }
+    for (int p = 0; p < m->page_count; ++p)
+        rogue_atlas_packer_free(&pages[p]);
+    free(pages);
+    free(items);
+    if (rc != 0)
+    {
+        rogue_atlas_manifest_free(m);
+        return -1;
+    }
+    return m->page_count;
+}
+
+int rogue_atlas_manifest_write(const RogueAtlasManifest* m, const char* path)
+{
+    if (!m || !path)
+        return -1;
+    FILE* f = NULL;
+#if defined(_MSC_VER)
+    if (fopen_s(&f, path, "wb") != 0)
+        f = NULL;
+#else
+    f = fopen(path, "wb");
+#endif
+    if (!f)
+        return -1;
+    fprintf(f, "# rogue atlas manifest v1: ATLAS page_w page_h padding pages, then\n");
+    fprintf(f, "# page x y w h path\n");
+    fprintf(f, "ATLAS %d %d %d %d\n", m->page_w, m->page_h, m->padding, m->page_count);
+    for (int i = 0; i < m->count; ++i)
+    {
+        const RogueAtlasPlacement* it = &m->items[i];
+        fprintf(f, "%d %d %d %d %d %s\n", it->page, it->x, it->y, it->w, it->h, it->path);
+    }
+    int rc = ferror(f) ? -1 : 0;
+    if (fclose(f) != 0)
+        rc = -1;
+    return rc;
+}
+
+int rogue_atlas_manifest_read(RogueAtlasManifest* m, const char* path)
+{
+    if (!m || !path)
+        return -1;
+    memset(m, 0, sizeof *m);
+    FILE* f = NULL;
+#if defined(_MSC_VER)
+    if (fopen_s(&f, path, "rb") != 0)
+        f = NULL;
+#else
+    f = fopen(path, "rb");
+#endif
+    if (!f)
+        return -1;
+    char line[512];
+    int have_header = 0, rc = 0;
+    while (rc == 0 && fgets(line, sizeof line, f))
+    {
+        line[strcspn(line, "\r\n")] = '\0';
+        if (line[0] == '#' || line[0] == '\0')
+            continue;
+        if (!have_header)
+        {
+            if (sscanf(line, "ATLAS %d %d %d %d", &m->page_w, &m->page_h, &m->padding,
+                       &m->page_count) != 4 ||
+                m->page_w <= 0 || m->page_h <= 0 || m->page_count < 0)
+                rc = -1;
+            have_header = 1;
+            continue;
+        }
+        int page, x, y, w, h, consumed = 0;
+        if (sscanf(line, "%d %d %d %d %d %n", &page, &x, &y, &w, &h, &consumed) != 5 ||
+            consumed <= 0 || line[consumed] == '\0' || page < 0 || page >= m->page_count ||
+            x < 0 || y < 0 || w <= 0 || h <= 0 || x + w > m->page_w || y + h > m->page_h)
+        {
+            rc = -1;
+            break;
+        }
+        rc = manifest_push(m, line + consumed, page, x, y, w, h);
+    }
+    fclose(f);
+    if (rc != 0 || !have_header)
+    {
+        rogue_atlas_manifest_free(m);
+        return -1;
+    }
+    return 0;
+}
+
+const RogueAtlasPlacement* rogue_atlas_manifest_find(const RogueAtlasManifest* m, const char* path)
+{
+    if (!m || !path)
+        return NULL;
+    for (int i = 0; i < m->count; ++i)
+        if (strcmp(m->items[i].path, path) == 0)
+            return &m->items[i];
+    return NULL;
+}
+
+void rogue_atlas_manifest_free(RogueAtlasManifest* m)
+{
+    if (!m)
+        return;
+    free(m->items);
+    memset(m, 0, sizeof *m);
+}
+
+void rogue_atlas_normalize_path(char* p)
+{
+    if (!p)
+        return;
+    char* w = p;
+    const char* r = p;
+    while (*r)
+    {
+        char c = *r == '\\' ? '/' : *r;
+        int at_segment_start = (w == p || w[-1] == '/');
+        if (c == '/' && w > p && w[-1] == '/')
+        {
+            r++;
+            continue;
+        }
+        if (c == '.' && at_segment_start && (r[1] == '/' || r[1] == '\\'))
+        {
+            r += 2;
+            continue;
+        }
+        *w++ = c;
+        r++;
+    }
+    *w = '\0';
+}
@@ -0,0 +1,68 @@
+/* Skyline rectangle packer and baked atlas manifests for the texture cache.
+ *
+ * Pure logic (no SDL) so offline tools and headless tests can pack and round-trip manifests.
+ * The runtime texture cache packs small sprites into shared atlas pages with the packer; a
+ * manifest baked offline (tools/atlas_bake.c) fixes every placement up front so startup only
+ * uploads pixels. */
+#ifndef ROGUE_GRAPHICS_ATLAS_PACKER_H
+#define ROGUE_GRAPHICS_ATLAS_PACKER_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    typedef struct RogueAtlasSkylineNode
+    {
+        int x, y, w; /* segment [x, x+w) is free from y downwards */
+    } RogueAtlasSkylineNode;
+
+    typedef struct RogueAtlasPacker
+    {
+        int width, height;
+        int padding; /* gap kept right of / below every rect (bleed guard) */
+        RogueAtlasSkylineNode* nodes;
+        int node_count;
+        int node_cap;
+        long long used_area; /* padded area handed out */
+    } RogueAtlasPacker;
+
+    int rogue_atlas_packer_init(RogueAtlasPacker* p, int width, int height, int padding);
+    void rogue_atlas_packer_free(RogueAtlasPacker* p);
+    /* Bottom-left skyline placement; returns 1 and the rect origin, 0 when it does not fit. */
+    int rogue_atlas_packer_insert(RogueAtlasPacker* p, int w, int h, int* out_x, int* out_y);
+    double rogue_atlas_packer_occupancy(const RogueAtlasPacker* p); /* 0..1 */
+
+    typedef struct RogueAtlasPlacement
+    {
+        char path[256]; /* normalized path key */
+        int page, x, y, w, h;
+    } RogueAtlasPlacement;
+
+    typedef struct RogueAtlasManifest
+    {
+        int page_w, page_h, padding;
+        int page_count;
+        RogueAtlasPlacement* items;
+        int count;
+        int cap;
+    } RogueAtlasManifest;
+
+    /* Pack n images (tallest first, ties by width then path) onto as many pages as needed.
+       Images larger than a page are left out and stay standalone textures. Returns the page
+       count or -1 on invalid input / allocation failure. */
+    int rogue_atlas_manifest_bake(RogueAtlasManifest* m, const char* const* paths, const int* ws,
+                                  const int* hs, int n, int page_size, int padding);
+    int rogue_atlas_manifest_write(const RogueAtlasManifest* m, const char* path); /* 0 ok */
+    int rogue_atlas_manifest_read(RogueAtlasManifest* m, const char* path);        /* 0 ok */
+    const RogueAtlasPlacement* rogue_atlas_manifest_find(const RogueAtlasManifest* m,
+                                                         const char* path);
+    void rogue_atlas_manifest_free(RogueAtlasManifest* m);
+
+    /* Canonical key for an image path: '\\' -> '/', duplicate '/' and "./" segments removed. */
+    void rogue_atlas_normalize_path(char* p);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* ROGUE_GRAPHICS_ATLAS_PACKER_H */
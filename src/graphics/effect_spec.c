@@ -24,22 +24,39 @@ static RogueEffectSpec* g_effect_specs = NULL;
 static int g_effect_spec_count = 0;
 static int g_effect_spec_cap = 0;
 
-/* Phase 3.5: minimal pending events queue for periodic pulses & child chains */
+/* Phase 3.5: pending events queue for periodic pulses & child chains.
+ * A pooled 4-ary min-heap keyed by (when_ms, seq) replaces the linear scan for the earliest event;
+ * it grows on demand, so pulses are no longer dropped at a fixed cap. Cancelling every pending
+ * event of an effect is O(1): each effect carries a cancel generation stamped into its events, and
+ * events from an older generation are discarded when they surface (or by an O(n) compaction once
+ * they outnumber the live ones). */
 typedef struct RogueEffectEvent
 {
     int effect_id;
     double when_ms;
     unsigned int seq;       /* tie-breaker for deterministic ordering when when_ms equal */
+    unsigned int gen;       /* effect cancel generation at push time */
     int override_magnitude; /* >=0 to force magnitude (snapshot_scale pulses) */
     signed char
         force_crit; /* -1 = unset (compute), 0 = no crit, 1 = crit (per-application snapshot) */
 } RogueEffectEvent;
 
-#define ROGUE_EFFECT_EV_CAP 256
-static RogueEffectEvent g_events[ROGUE_EFFECT_EV_CAP];
-static int g_event_count = 0;
+#define ROGUE_EFFECT_EV_INITIAL_CAP 256
+static RogueEffectEvent* g_events = NULL; /* heap order */
+static int g_event_count = 0;             /* heap entries (live + cancelled) */
+static int g_event_cap = 0;
+
+/* Per effect id: cancel generation and number of live pending events. */
+typedef struct RogueEffectEventTrack
+{
+    unsigned int gen;
+    int pending;
+} RogueEffectEventTrack;
+static RogueEffectEventTrack* g_event_track = NULL;
+static int g_event_track_cap = 0;
 
 static unsigned int g_event_seq = 0;
+static RogueEffectSchedulerStats g_event_stats;
 
 /* ---- Phase 6.3: Minimal active AURA tracking for exclusivity groups ---- */
 typedef struct ActiveAuraRec
@@ -185,39 +202,147 @@ static int find_active_dot_index(int effect_id)
     return -1;
 }
 
+static int event_before(const RogueEffectEvent* a, const RogueEffectEvent* b)
+{
+    return a->when_ms < b->when_ms || (a->when_ms == b->when_ms && a->seq < b->seq);
+}
+
+static void heap_sift_up(int i)
+{
+    RogueEffectEvent ev = g_events[i];
+    while (i > 0)
+    {
+        int parent = (i - 1) >> 2;
+        if (!event_before(&ev, &g_events[parent]))
+            break;
+        g_events[i] = g_events[parent];
+        i = parent;
+    }
+    g_events[i] = ev;
+}
+
+static void heap_sift_down(int i)
+{
+    RogueEffectEvent ev = g_events[i];
+    for (;;)
+    {
+        int first = (i << 2) + 1;
+        if (first >= g_event_count)
+            break;
+        int best = first;
+        int last = first + 4 < g_event_count ? first + 4 : g_event_count;
+        for (int c = first + 1; c < last; ++c)
+            if (event_before(&g_events[c], &g_events[best]))
+                best = c;
+        if (!event_before(&g_events[best], &ev))
+            break;
+        g_events[i] = g_events[best];
+        i = best;
+    }
+    g_events[i] = ev;
+}
+
+static RogueEffectEventTrack* event_track(int effect_id)
+{
+    if (effect_id < 0)
+        return NULL;
+    if (effect_id >= g_event_track_cap)
+    {
+        int cap = g_event_track_cap ? g_event_track_cap : 64;
+        while (cap <= effect_id)
+            cap *= 2;
+        RogueEffectEventTrack* t = (RogueEffectEventTrack*) realloc(
+            g_event_track, sizeof(RogueEffectEventTrack) * (size_t) cap);
+        if (!t)
+            return NULL;
+        memset(t + g_event_track_cap, 0,
+               sizeof(RogueEffectEventTrack) * (size_t) (cap - g_event_track_cap));
+        g_event_track = t;
+        g_event_track_cap = cap;
+    }
+    return &g_event_track[effect_id];
+}
+
+static int event_is_live(const RogueEffectEvent* ev)
+{
+    return ev->effect_id < g_event_track_cap && g_event_track[ev->effect_id].gen == ev->gen;
+}
+
+/* Drop cancelled entries in one pass and re-heapify (bottom-up, O(n)). */
+static void compact_events(void)
+{
+    int n = 0;
+    for (int i = 0; i < g_event_count; ++i)
+        if (event_is_live(&g_events[i]))
+            g_events[n++] = g_events[i];
+    g_event_count = n;
+    for (int i = (n - 2) >> 2; i >= 0; --i)
+        heap_sift_down(i);
+}
+
 /**
- * @brief Removes all pending events for a specific effect ID.
+ * @brief Cancels all pending events for a specific effect ID (O(1): bumps its generation).
  * @param effect_id The effect ID to remove pending events for.
  */
 static void remove_pending_for_effect(int effect_id)
 {
-    for (int i = 0; i < g_event_count;)
-    {
-        if (g_events[i].effect_id == effect_id)
-        {
-            g_events[i] = g_events[g_event_count - 1];
-            g_event_count--;
-            continue;
-        }
-        ++i;
-    }
+    if (effect_id < 0 || effect_id >= g_event_track_cap)
+        return;
+    RogueEffectEventTrack* t = &g_event_track[effect_id];
+    t->gen++;
+    g_event_stats.cancelled += (unsigned int) t->pending;
+    g_event_stats.pending -= t->pending;
+    t->pending = 0;
+    int dead = g_event_count - g_event_stats.pending;
+    if (dead > 64 && dead > g_event_stats.pending)
+        compact_events();
 }
 
 /**
  * @brief Pushes a new effect event to the event queue.
  * @param effect_id The effect ID for the event.
  * @param when_ms The time in milliseconds when the event should occur.
+ * @param override_magnitude Forced magnitude (>= 0) or -1 to compute at fire time.
+ * @param force_crit Crit snapshot (0/1) or -1 to roll at fire time.
  */
-static void push_event(int effect_id, double when_ms)
+static void push_event(int effect_id, double when_ms, int override_magnitude,
+                       signed char force_crit)
 {
-    if (g_event_count >= ROGUE_EFFECT_EV_CAP)
+    RogueEffectEventTrack* t = event_track(effect_id);
+    if (t && g_event_count == g_event_cap)
+    {
+        int cap = g_event_cap ? g_event_cap * 2 : ROGUE_EFFECT_EV_INITIAL_CAP;
+        RogueEffectEvent* ev =
+            (RogueEffectEvent*) realloc(g_events, sizeof(RogueEffectEvent) * (size_t) cap);
+        if (ev)
+        {
+            g_events = ev;
+            g_event_cap = cap;
+        }
+    }
+    if (!t || g_event_count == g_event_cap)
+    {
+        g_event_stats.dropped++;
         return;
-    g_events[g_event_count].effect_id = effect_id;
-    g_events[g_event_count].when_ms = when_ms;
-    g_events[g_event_count].seq = g_event_seq++;
-    g_events[g_event_count].override_magnitude = -1;
-    g_events[g_event_count].force_crit = -1;
-    g_event_count++;
+    }
+    RogueEffectEvent* ev = &g_events[g_event_count];
+    ev->effect_id = effect_id;
+    ev->when_ms = when_ms;
+    ev->seq = g_event_seq++;
+    ev->gen = t->gen;
+    ev->override_magnitude = override_magnitude;
+    ev->force_crit = force_crit;
+    heap_sift_up(g_event_count++);
+    t->pending++;
+    g_event_stats.scheduled++;
+    if (++g_event_stats.pending > g_event_stats.peak_pending)
+        g_event_stats.peak_pending = g_event_stats.pending;
+}
+
+void rogue_effect_scheduler_stats(RogueEffectSchedulerStats* out)
+{
+    if (out)
+        *out = g_event_stats;
 }
 
 /**
@@ -229,8 +354,15 @@ void rogue_effect_reset(void)
     g_effect_specs = NULL;
     g_effect_spec_count = 0;
     g_effect_spec_cap = 0;
+    free(g_events);
+    g_events = NULL;
     g_event_count = 0;
+    g_event_cap = 0;
+    free(g_event_track);
+    g_event_track = NULL;
+    g_event_track_cap = 0;
     g_event_seq = 0;
+    memset(&g_event_stats, 0, sizeof g_event_stats);
     g_active_dot_count = 0;
     g_active_aura_count = 0;
 }
@@ -302,14 +434,14 @@ const RogueEffectSpec* rogue_effect_get(int id)
 /**
  * @brief Computes the effective magnitude of an effect with optional scaling.
  * @param s The effect specification.
+ * @param total Current total of the spec's scale_by_buff_type buff.
  * @return The computed effective magnitude.
  */
-static int compute_scaled_magnitude(const RogueEffectSpec* s)
+static int compute_scaled_magnitude_from(const RogueEffectSpec* s, int total)
 {
     int mag = s->magnitude;
     if (s->scale_by_buff_type != (unsigned short) 0xFFFFu && s->scale_pct_per_point != 0)
     {
-        int total = rogue_buffs_get_total((RogueBuffType) s->scale_by_buff_type);
         long long pct = 100 + (long long) s->scale_pct_per_point * (long long) total;
         if (pct < 0)
             pct = 0; /* clamp */
@@ -323,6 +455,14 @@ static int compute_scaled_magnitude(const RogueEffectSpec* s)
     return mag;
 }
 
+static int compute_scaled_magnitude(const RogueEffectSpec* s)
+{
+    if (s->scale_by_buff_type == (unsigned short) 0xFFFFu || s->scale_pct_per_point == 0)
+        return s->magnitude;
+    return compute_scaled_magnitude_from(
+        s, rogue_buffs_get_total((RogueBuffType) s->scale_by_buff_type));
+}
+
 /* One-shot crit override channel for the next apply_with_magnitude() invocation.
    Values: -2 (unset), 0 (force non-crit), 1 (force crit). */
 static int g_effects_force_next_crit = -2;
@@ -585,14 +725,12 @@ void rogue_effect_apply(int id, double now_ms)
         /* schedule subsequent pulses within duration (or updated schedule_end_ms) */
         double t = now_ms + (double) s->pulse_period_ms;
         double end = schedule_end_ms;
-        while (t <= end && g_event_count < ROGUE_EFFECT_EV_CAP)
+        /* Carry snapshot magnitude / per-application crit snapshot to all pulses */
+        int pulse_mag = s->snapshot_scale ? eff_mag : -1;
+        signed char pulse_crit = (signed char) (snapshot_cd >= 0 ? snapshot_cd : -1);
+        while (t <= end)
         {
-            push_event(id, t);
-            if (s->snapshot_scale)
-                g_events[g_event_count - 1].override_magnitude = eff_mag;
-            /* Carry per-application crit snapshot to all pulses */
-            if (snapshot_cd >= 0)
-                g_events[g_event_count - 1].force_crit = (signed char) snapshot_cd;
+            push_event(id, t, pulse_mag, pulse_crit);
             t += (double) s->pulse_period_ms;
         }
     }
@@ -627,8 +765,40 @@ void rogue_effect_apply(int id, double now_ms)
     {
         const RogueEffectChild* ch = &s->children[i];
         if (ch->child_effect_id >= 0)
-            push_event(ch->child_effect_id, now_ms + (double) ch->delay_ms);
+            push_event(ch->child_effect_id, now_ms + (double) ch->delay_ms, -1, -1);
+    }
+}
+
+/**
+ * @brief Applies the immediate buff part of an effect to a caller-owned buff set.
+ *
+ * Used by isolated skill simulation contexts: the precondition gate and magnitude scaling read
+ * the given set, STAT_BUFF effects apply into it, and nothing global (DOT/AURA damage, scheduled
+ * pulses, children, active records) is touched.
+ *
+ * @param id The effect ID to apply.
+ * @param now_ms The current (simulation) time in milliseconds.
+ * @param set Destination buff set.
+ */
+void rogue_effect_apply_buffs(int id, double now_ms, RogueBuffSet* set)
+{
+    const RogueEffectSpec* s = rogue_effect_get(id);
+    if (!s || !set || s->kind != ROGUE_EFFECT_STAT_BUFF)
+        return;
+    if (s->require_buff_type != (unsigned short) 0xFFFFu)
+    {
+        int have = rogue_buff_set_get_total(set, (RogueBuffType) s->require_buff_type);
+        int need = (s->require_buff_min > 0) ? s->require_buff_min : 1;
+        if (have < need)
+            return;
     }
+    int mag = compute_scaled_magnitude_from(s, rogue_buff_set_get_total(
+                                                    set, (RogueBuffType) s->scale_by_buff_type));
+    RogueBuffStackRule rule = (RogueBuffStackRule) s->stack_rule;
+    if (rule < ROGUE_BUFF_STACK_UNIQUE || rule > ROGUE_BUFF_STACK_REPLACE_IF_STRONGER)
+        rule = ROGUE_BUFF_STACK_ADD;
+    rogue_buff_set_apply(set, (RogueBuffType) s->buff_type, mag, s->duration_ms, now_ms, rule,
+                         s->snapshot ? 1 : 0);
 }
 
 /**
@@ -645,32 +815,24 @@ void rogue_effect_apply(int id, double now_ms)
  */
 void rogue_effects_update(double now_ms)
 {
-    /* Process ready events in stable order (when_ms asc, then seq asc). */
-    for (;;)
+    /* Process ready events in stable order (when_ms asc, then seq asc). Events scheduled while
+       draining (re-entrant applies) join the heap and fire this frame if already due. */
+    while (g_event_count > 0 && g_events[0].when_ms <= now_ms)
     {
-        int picked = -1;
-        double best_t = 0.0;
-        unsigned int best_seq = 0;
-        for (int i = 0; i < g_event_count; ++i)
-        {
-            RogueEffectEvent ev = g_events[i];
-            if (ev.when_ms <= now_ms)
-            {
-                if (picked < 0 || ev.when_ms < best_t ||
-                    (ev.when_ms == best_t && ev.seq < best_seq))
-                {
-                    picked = i;
-                    best_t = ev.when_ms;
-                    best_seq = ev.seq;
-                }
-            }
-        }
-        if (picked < 0)
-            break;
-        RogueEffectEvent ev = g_events[picked];
-        /* remove picked by swapping with last and reducing count */
-        g_events[picked] = g_events[g_event_count - 1];
-        g_event_count--;
+        RogueEffectEvent ev = g_events[0];
+        g_events[0] = g_events[--g_event_count];
+        if (g_event_count > 0)
+            heap_sift_down(0);
+        if (!event_is_live(&ev))
+            continue; /* cancelled */
+        g_event_track[ev.effect_id].pending--;
+        g_event_stats.pending--;
+        g_event_stats.fired++;
+        double late_ms = now_ms - ev.when_ms;
+        if (late_ms > ROGUE_EFFECT_EVENT_LATE_MS)
+            g_event_stats.late++;
+        if (late_ms > g_event_stats.max_late_ms)
+            g_event_stats.max_late_ms = late_ms;
         const RogueEffectSpec* s = rogue_effect_get(ev.effect_id);
         if (!s)
             continue;
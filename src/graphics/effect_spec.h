@@ -73,8 +73,31 @@ extern "C"
     /* Returns 1 on success; outputs effect_id and end_ms. Index is 0..count-1. */
     int rogue_effect_active_aura_get(int index, int* effect_id, double* end_ms);
     void rogue_effect_apply(int id, double now_ms);
+    /* Skill simulation contexts: immediate STAT_BUFF application (precondition + scaling read
+       from `set`) into a caller-owned buff set. Other kinds, pulses and children are skipped. */
+    struct RogueBuffSet;
+    void rogue_effect_apply_buffs(int id, double now_ms, struct RogueBuffSet* set);
     /* Phase 3.5: process scheduled effect events (periodic pulses and child chains). */
     void rogue_effects_update(double now_ms);
+
+/* An event firing more than this many ms after its scheduled time counts as late. */
+#ifndef ROGUE_EFFECT_EVENT_LATE_MS
+#define ROGUE_EFFECT_EVENT_LATE_MS 50.0
+#endif
+
+    /* Event scheduler counters (reset by rogue_effect_reset). */
+    typedef struct RogueEffectSchedulerStats
+    {
+        int pending;            /* live scheduled events */
+        int peak_pending;       /* high-water mark of `pending` */
+        unsigned int scheduled; /* events pushed */
+        unsigned int fired;     /* events delivered by rogue_effects_update */
+        unsigned int cancelled; /* events discarded by refresh / aura replacement */
+        unsigned int late;      /* fired more than ROGUE_EFFECT_EVENT_LATE_MS after due */
+        unsigned int dropped;   /* pushes lost to allocation failure */
+        double max_late_ms;     /* largest observed firing delay */
+    } RogueEffectSchedulerStats;
+    void rogue_effect_scheduler_stats(RogueEffectSchedulerStats* out);
     void rogue_effect_reset(void); /* free registry for tests */
     /* Query helpers */
     int rogue_effect_spec_is_debuff(int id);
@@ -1,4 +1,6 @@
 #include "scene_drawlist.h"
+#include "texture_cache.h"
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 #ifdef ROGUE_HAVE_SDL
@@ -54,6 +56,7 @@ void rogue_scene_drawlist_push_sprite(const RogueSprite* spr, int dx, int dy, in
     it->dw = spr->sw;
     it->dh = spr->sh;
     it->y_sort = y_base;
+    it->seq = g_item_count;
     it->flip = (unsigned char) flip;
     it->tint_r = r;
     it->tint_g = g;
@@ -61,6 +64,17 @@ void rogue_scene_drawlist_push_sprite(const RogueSprite* spr, int dx, int dy, in
     it->tint_a = a;
 }
 
+static const void* draw_item_texture(const RogueDrawItem* it)
+{
+#ifdef ROGUE_HAVE_SDL
+    return it->sprite ? (const void*) it->sprite->tex->handle : NULL;
+#else
+    return it->sprite ? (const void*) it->sprite->tex : NULL;
+#endif
+}
+
+/* Depth first; items on the same row are grouped by texture (atlas page) so consecutive copies
+   share a bind, then kept in push order. */
 static int cmp_draw_items(const void* a, const void* b)
 {
     const RogueDrawItem* A = (const RogueDrawItem*) a;
@@ -69,7 +83,11 @@ static int cmp_draw_items(const void* a, const void* b)
         return -1;
     if (A->y_sort > B->y_sort)
         return 1;
-    return 0;
+    const void* ta = draw_item_texture(A);
+    const void* tb = draw_item_texture(B);
+    if (ta != tb)
+        return (uintptr_t) ta < (uintptr_t) tb ? -1 : 1;
+    return A->seq - B->seq;
 }
 
 void rogue_scene_drawlist_flush(void)
@@ -86,10 +104,11 @@ void rogue_scene_drawlist_flush(void)
             if (it->kind == ROGUE_DRAW_SPRITE)
             {
                 const RogueSprite* spr = it->sprite;
-                SDL_Rect src = {spr->sx, spr->sy, spr->sw, spr->sh};
+                SDL_Rect src = {spr->tex->ax + spr->sx, spr->tex->ay + spr->sy, spr->sw, spr->sh};
                 SDL_Rect dst = {it->dx, it->dy, it->dw, it->dh};
                 if (spr->tex && spr->tex->handle)
                 {
+                    rogue_texture_cache_note_draw(spr->tex->handle);
                     if (it->tint_r != 255 || it->tint_g != 255 || it->tint_b != 255)
                         SDL_SetTextureColorMod(spr->tex->handle, it->tint_r, it->tint_g,
                                                it->tint_b);
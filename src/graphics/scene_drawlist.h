@@ -19,6 +19,7 @@ extern "C"
         int sx, sy, sw, sh;        /* source override if sprite null */
         int dx, dy, dw, dh;        /* destination rect */
         int y_sort;                /* key */
+        int seq;                   /* push order; keeps equal keys stable */
         unsigned char flip;        /* SDL_RendererFlip bits (0 or 1 for horizontal) */
         unsigned char tint_r, tint_g, tint_b, tint_a; /* modulation */
     } RogueDrawItem;
@@ -1,7 +1,9 @@
 /* Sprite/texture abstraction */
 #include "sprite.h"
 #include "../util/log.h"
+#include "texture_cache.h"
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #ifdef ROGUE_HAVE_SDL
@@ -13,97 +15,55 @@ extern SDL_Renderer* g_internal_sdl_renderer_ref;
 #ifdef _WIN32
 bool rogue_png_load_rgba(const char* path, unsigned char** out_pixels, int* w, int* h);
 #endif
-#endif
 
-bool rogue_texture_load(RogueTexture* t, const char* path)
+SDL_Surface* rogue_texture_load_surface(const char* path, unsigned char** owned_pixels)
 {
-#if defined(ROGUE_HAVE_SDL) && defined(ROGUE_HAVE_SDL_IMAGE)
-    if (!g_internal_sdl_renderer_ref)
-    {
-        /* In headless test runs using SDL's dummy video driver, allow stub textures. */
-        const char* drv = SDL_GetCurrentVideoDriver();
-        if (drv && strcmp(drv, "dummy") == 0)
-        {
-            t->handle = NULL; /* draw path will no-op when handle is NULL */
-            t->w = 0;
-            t->h = 0;
-            ROGUE_LOG_INFO("Headless (dummy video): stubbing texture load for %s", path);
-            return true;
-        }
-        ROGUE_LOG_ERROR("rogue_texture_load: renderer not ready");
-        return false;
-    }
-    const char* prefixes[] = {"", "../", "../../", "../../../"};
-    SDL_Surface* surf = NULL;
-    char attempt[512];
-    for (size_t i = 0; i < sizeof(prefixes) / sizeof(prefixes[0]); i++)
-    {
-        snprintf(attempt, sizeof attempt, "%s%s", prefixes[i], path);
-        surf = IMG_Load(attempt);
-        if (surf)
-        {
-            if (i > 0)
-                ROGUE_LOG_INFO("Loaded texture via fallback path: %s", attempt);
-            break;
-        }
-    }
-    if (!surf)
-    {
+    *owned_pixels = NULL;
+#ifdef ROGUE_HAVE_SDL_IMAGE
+    SDL_Surface* surf = IMG_Load(path);
+    if (surf)
+        return surf;
 #ifdef _WIN32
-        ROGUE_LOG_WARN("IMG_Load failed for %s (last error: %s). Trying WIC fallback.", path,
-                       IMG_GetError());
-        /* Try WIC fallback manually */
-        unsigned char* pixels = NULL;
-        int w = 0, h = 0;
-        int ok = 0;
-        for (size_t i = 0; i < sizeof(prefixes) / sizeof(prefixes[0]) && !ok; i++)
-        {
-            snprintf(attempt, sizeof attempt, "%s%s", prefixes[i], path);
-            if (rogue_png_load_rgba(attempt, &pixels, &w, &h))
-            {
-                SDL_Surface* tmp = SDL_CreateRGBSurfaceWithFormatFrom(pixels, w, h, 32, w * 4,
-                                                                      SDL_PIXELFORMAT_RGBA32);
-                if (tmp)
-                {
-                    surf = tmp;
-                    ok = 1;
-                    if (i > 0)
-                        ROGUE_LOG_INFO("Loaded (WIC) via fallback path: %s", attempt);
-                }
-                else
-                {
-                    free(pixels);
-                    pixels = NULL;
-                }
-            }
-        }
-        if (!surf)
-        {
-            return false;
-        }
+    ROGUE_LOGC_WARN(ROGUE_LOG_CAT_RENDER,
+                    "IMG_Load failed for %s (last error: %s). Trying WIC fallback.", path,
+                    IMG_GetError());
 #else
-        ROGUE_LOG_WARN("IMG_Load failed for all path variants of %s (last error: %s)", path,
-                       IMG_GetError());
-        return false;
+    ROGUE_LOGC_WARN(ROGUE_LOG_CAT_RENDER, "IMG_Load failed for %s (last error: %s)", path,
+                    IMG_GetError());
+    return NULL;
+#endif
 #endif
-    }
-    t->handle = SDL_CreateTextureFromSurface(g_internal_sdl_renderer_ref, surf);
-    if (!t->handle)
-    {
-        ROGUE_LOG_WARN("SDL_CreateTextureFromSurface failed for %s", path);
-        SDL_FreeSurface(surf);
-        return false;
-    }
-    t->w = surf->w;
-    t->h = surf->h;
-    SDL_SetTextureBlendMode(t->handle, SDL_BLENDMODE_BLEND); /* enable alpha & color mod blending */
-    SDL_FreeSurface(surf);
-    return true;
-#elif defined(ROGUE_HAVE_SDL)
-/* SDL available but SDL_image not compiled in: attempt WIC fallback (Windows) */
 #ifdef _WIN32
     unsigned char* pixels = NULL;
     int w = 0, h = 0;
+    if (!rogue_png_load_rgba(path, &pixels, &w, &h))
+    {
+        ROGUE_LOGC_WARN(ROGUE_LOG_CAT_RENDER, "WIC PNG load failed for %s", path);
+        return NULL;
+    }
+    SDL_Surface* tmp =
+        SDL_CreateRGBSurfaceWithFormatFrom(pixels, w, h, 32, w * 4, SDL_PIXELFORMAT_RGBA32);
+    if (!tmp)
+    {
+        ROGUE_LOGC_WARN(ROGUE_LOG_CAT_RENDER, "SDL_CreateRGBSurfaceWithFormatFrom failed: %s",
+                        path);
+        free(pixels);
+        return NULL;
+    }
+    *owned_pixels = pixels; /* surface wraps pixels; free after the surface */
+    return tmp;
+#elif !defined(ROGUE_HAVE_SDL_IMAGE)
+    ROGUE_LOGC_WARN(ROGUE_LOG_CAT_RENDER,
+                    "rogue_texture_load: built without SDL_image and no WIC fallback available");
+    (void) path;
+    return NULL;
+#endif
+}
+
+static bool texture_load(RogueTexture* t, const char* path, int atlased)
+{
+    t->ax = t->ay = 0;
+    t->cache_id = 0;
     if (!g_internal_sdl_renderer_ref)
     {
         /* In headless test runs using SDL's dummy video driver, allow stub textures. */
@@ -113,61 +73,32 @@ bool rogue_texture_load(RogueTexture* t, const char* path)
             t->handle = NULL; /* draw path will no-op when handle is NULL */
             t->w = 0;
             t->h = 0;
-            ROGUE_LOG_INFO("Headless (dummy video): stubbing texture load (WIC) for %s", path);
+            ROGUE_LOGC_INFO(ROGUE_LOG_CAT_RENDER,
+                            "Headless (dummy video): stubbing texture load for %s", path);
             return true;
         }
-        ROGUE_LOG_ERROR("rogue_texture_load (WIC): renderer not ready");
-        return false;
-    }
-    const char* prefixes[] = {"", "../", "../../", "../../../"};
-    int tried = 0;
-    int ok = 0;
-    char attempt[512];
-    for (size_t i = 0; i < sizeof(prefixes) / sizeof(prefixes[0]) && !ok; i++)
-    {
-        snprintf(attempt, sizeof attempt, "%s%s", prefixes[i], path);
-        tried++;
-        if (rogue_png_load_rgba(attempt, &pixels, &w, &h))
-        {
-            if (i > 0)
-                ROGUE_LOG_INFO("Loaded texture via fallback path: %s", attempt);
-            ok = 1;
-            break;
-        }
-    }
-    if (!ok)
-    {
-        ROGUE_LOG_WARN("WIC PNG load failed for all path variants of %s", path);
+        ROGUE_LOGC_ERROR(ROGUE_LOG_CAT_RENDER, "rogue_texture_load: renderer not ready");
         return false;
     }
-    SDL_Surface* surf =
-        SDL_CreateRGBSurfaceWithFormatFrom(pixels, w, h, 32, w * 4, SDL_PIXELFORMAT_RGBA32);
-    if (!surf)
-    {
-        ROGUE_LOG_WARN("SDL_CreateRGBSurfaceWithFormatFrom failed: %s", path);
-        free(pixels);
-        return false;
-    }
-    t->handle = SDL_CreateTextureFromSurface(g_internal_sdl_renderer_ref, surf);
-    if (!t->handle)
-    {
-        ROGUE_LOG_WARN("SDL_CreateTextureFromSurface failed (WIC) %s", path);
-        SDL_FreeSurface(surf);
-        free(pixels);
-        return false;
-    }
-    t->w = w;
-    t->h = h;
-    SDL_SetTextureBlendMode(t->handle, SDL_BLENDMODE_BLEND);
-    SDL_FreeSurface(surf);
-    free(pixels); /* SDL copy done */
-    return true;
+    return rogue_texture_cache_acquire(t, path, atlased);
+}
+#endif
+
+bool rogue_texture_load(RogueTexture* t, const char* path)
+{
+#ifdef ROGUE_HAVE_SDL
+    return texture_load(t, path, 0);
 #else
-    (void) path;
     (void) t;
-    ROGUE_LOG_WARN("rogue_texture_load: built without SDL_image and no WIC fallback available");
+    (void) path;
     return false;
 #endif
+}
+
+bool rogue_texture_load_atlased(RogueTexture* t, const char* path)
+{
+#ifdef ROGUE_HAVE_SDL
+    return texture_load(t, path, 1);
 #else
     (void) t;
     (void) path;
@@ -178,10 +109,14 @@ bool rogue_texture_load(RogueTexture* t, const char* path)
 void rogue_texture_destroy(RogueTexture* t)
 {
 #ifdef ROGUE_HAVE_SDL
-    if (t->handle)
+    if (t->cache_id)
+        rogue_texture_cache_release(t);
+    else if (t->handle)
         SDL_DestroyTexture(t->handle);
     t->handle = NULL;
     t->w = t->h = 0;
+    t->ax = t->ay = 0;
+    t->cache_id = 0;
 #else
     (void) t;
 #endif
@@ -194,8 +129,9 @@ void rogue_sprite_draw(const RogueSprite* spr, int x, int y, int scale)
         return;
     if (scale < 1)
         scale = 1;
-    SDL_Rect src = {spr->sx, spr->sy, spr->sw, spr->sh};
+    SDL_Rect src = {spr->tex->ax + spr->sx, spr->tex->ay + spr->sy, spr->sw, spr->sh};
     SDL_Rect dst = {x, y, spr->sw * scale, spr->sh * scale};
+    rogue_texture_cache_note_draw(spr->tex->handle);
     SDL_RenderCopy(g_internal_sdl_renderer_ref, spr->tex->handle, &src, &dst);
 #else
     (void) spr;
@@ -12,15 +12,22 @@ typedef struct RogueTexture
     SDL_Texture* handle;
 #endif
     int w, h;
+    int ax, ay;   /* image origin inside handle (non-zero when packed into a shared atlas) */
+    int cache_id; /* texture cache entry + 1; 0 when the texture is owned directly */
 } RogueTexture;
 
 typedef struct RogueSprite
 {
     RogueTexture* tex;
-    int sx, sy, sw, sh;
+    int sx, sy, sw, sh; /* relative to the image; draws add tex->ax / tex->ay */
 } RogueSprite;
 
+/* Load (or share) the texture for path. Loads are deduplicated by resolved path through the
+   texture cache; rogue_texture_destroy releases the shared reference. */
 bool rogue_texture_load(RogueTexture* t, const char* path);
+/* Same, but small images are packed into a shared atlas page. Only for textures drawn through
+   RogueSprite source rects (whole-texture draws would show the entire atlas). */
+bool rogue_texture_load_atlased(RogueTexture* t, const char* path);
 void rogue_texture_destroy(RogueTexture* t);
 void rogue_sprite_draw(const RogueSprite* spr, int x, int y, int scale);
 
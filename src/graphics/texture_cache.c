@@ -0,0 +1,401 @@
+/* Texture cache + atlas pages (see texture_cache.h) */
+#include "texture_cache.h"
+#include "../util/log.h"
+#include "atlas_packer.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static RogueAtlasManifest g_manifest;
+static int g_manifest_loaded = 0;
+static unsigned g_dedup_hits = 0;
+static const void* g_last_bound = NULL;
+static int g_frame_binds = 0, g_frame_draws = 0;
+static int g_last_binds = 0, g_last_draws = 0;
+
+#ifdef ROGUE_HAVE_SDL
+extern SDL_Renderer* g_internal_sdl_renderer_ref;
+
+typedef struct TexEntry
+{
+    char key[512]; /* normalized resolved path; empty = free slot */
+    SDL_Texture* handle;
+    int w, h, ax, ay;
+    int page; /* atlas page index, -1 for a standalone texture */
+    int refs;
+} TexEntry;
+
+typedef struct AtlasPage
+{
+    SDL_Texture* tex;
+    RogueAtlasPacker packer; /* runtime pages only */
+    int manifest_page;       /* baked page number, -1 for runtime pages */
+    int images;
+} AtlasPage;
+
+static TexEntry* g_entries = NULL;
+static int g_entry_count = 0;
+static int g_entry_cap = 0;
+static AtlasPage g_pages[ROGUE_TEXTURE_MAX_ATLAS_PAGES];
+static int g_page_count = 0;
+static int g_standalone_live = 0;
+
+static int path_exists(const char* path)
+{
+    FILE* f = NULL;
+#if defined(_MSC_VER)
+    if (fopen_s(&f, path, "rb") != 0)
+        f = NULL;
+#else
+    f = fopen(path, "rb");
+#endif
+    if (!f)
+        return 0;
+    fclose(f);
+    return 1;
+}
+
+/* Probe the same relative prefixes the loader always accepted; out gets the first existing
+   variant (or path itself when none exists, so the decode reports the failure). */
+static void resolve_path(const char* path, char* out, size_t out_sz)
+{
+    static const char* prefixes[] = {"", "../", "../../", "../../../"};
+    for (size_t i = 0; i < sizeof(prefixes) / sizeof(prefixes[0]); i++)
+    {
+        snprintf(out, out_sz, "%s%s", prefixes[i], path);
+        if (path_exists(out))
+        {
+            if (i > 0)
+                ROGUE_LOGC_INFO(ROGUE_LOG_CAT_RENDER, "Loaded texture via fallback path: %s", out);
+            return;
+        }
+    }
+    snprintf(out, out_sz, "%s", path);
+}
+
+/* Atlased requests may share a standalone texture (sprites draw sub-rects of either); whole
+   texture users must not get an atlas page. */
+static int entry_find(const char* key, int atlased)
+{
+    int fallback = -1;
+    for (int i = 0; i < g_entry_count; ++i)
+    {
+        const TexEntry* e = &g_entries[i];
+        if (!e->key[0] || strcmp(e->key, key) != 0)
+            continue;
+        if ((e->page >= 0) == (atlased != 0))
+            return i;
+        if (atlased && e->page < 0)
+            fallback = i;
+    }
+    return fallback;
+}
+
+static int entry_alloc(void)
+{
+    for (int i = 0; i < g_entry_count; ++i)
+        if (!g_entries[i].key[0])
+            return i;
+    if (g_entry_count == g_entry_cap)
+    {
+        int cap = g_entry_cap ? g_entry_cap * 2 : 64;
+        TexEntry* e = (TexEntry*) realloc(g_entries, sizeof(TexEntry) * (size_t) cap);
+        if (!e)
+            return -1;
+        g_entries = e;
+        g_entry_cap = cap;
+    }
+    return g_entry_count++;
+}
+
+static SDL_Texture* page_texture_create(int w, int h)
+{
+    SDL_Texture* tex = SDL_CreateTexture(g_internal_sdl_renderer_ref, SDL_PIXELFORMAT_RGBA32,
+                                         SDL_TEXTUREACCESS_STATIC, w, h);
+    if (!tex)
+        return NULL;
+    SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND);
+    /* static textures start undefined; clear so padding gutters are transparent */
+    void* zeros = calloc((size_t) w * (size_t) h, 4);
+    if (zeros)
+    {
+        SDL_UpdateTexture(tex, NULL, zeros, w * 4);
+        free(zeros);
+    }
+    return tex;
+}
+
+static int page_size(void)
+{
+    int size = ROGUE_TEXTURE_ATLAS_PAGE_SIZE;
+    SDL_RendererInfo info;
+    if (SDL_GetRendererInfo(g_internal_sdl_renderer_ref, &info) == 0)
+    {
+        if (info.max_texture_width > 0 && info.max_texture_width < size)
+            size = info.max_texture_width;
+        if (info.max_texture_height > 0 && info.max_texture_height < size)
+            size = info.max_texture_height;
+    }
+    return size;
+}
+
+/* Baked placement for key (leading "../" added by path resolution ignored), else -1. */
+static int place_from_manifest(const char* key, int w, int h, SDL_Rect* rect)
+{
+    if (!g_manifest_loaded)
+        return -1;
+    const char* k = key;
+    while (strncmp(k, "../", 3) == 0)
+        k += 3;
+    const RogueAtlasPlacement* pl = rogue_atlas_manifest_find(&g_manifest, k);
+    if (!pl || pl->w != w || pl->h != h)
+        return -1;
+    int page = -1;
+    for (int i = 0; i < g_page_count; ++i)
+        if (g_pages[i].manifest_page == pl->page)
+            page = i;
+    if (page < 0)
+    {
+        if (g_page_count >= ROGUE_TEXTURE_MAX_ATLAS_PAGES)
+            return -1;
+        SDL_Texture* tex = page_texture_create(g_manifest.page_w, g_manifest.page_h);
+        if (!tex)
+            return -1;
+        page = g_page_count++;
+        memset(&g_pages[page], 0, sizeof g_pages[page]);
+        g_pages[page].tex = tex;
+        g_pages[page].manifest_page = pl->page;
+    }
+    rect->x = pl->x;
+    rect->y = pl->y;
+    rect->w = w;
+    rect->h = h;
+    return page;
+}
+
+static int place_runtime(int w, int h, SDL_Rect* rect)
+{
+    for (int i = 0; i < g_page_count; ++i)
+        if (g_pages[i].manifest_page < 0 &&
+            rogue_atlas_packer_insert(&g_pages[i].packer, w, h, &rect->x, &rect->y))
+        {
+            rect->w = w;
+            rect->h = h;
+            return i;
+        }
+    if (g_page_count >= ROGUE_TEXTURE_MAX_ATLAS_PAGES)
+        return -1;
+    int size = page_size();
+    if (w > size || h > size)
+        return -1;
+    AtlasPage* pg = &g_pages[g_page_count];
+    memset(pg, 0, sizeof *pg);
+    pg->manifest_page = -1;
+    if (rogue_atlas_packer_init(&pg->packer, size, size, ROGUE_TEXTURE_ATLAS_PADDING) != 0)
+        return -1;
+    pg->tex = page_texture_create(size, size);
+    if (!pg->tex || !rogue_atlas_packer_insert(&pg->packer, w, h, &rect->x, &rect->y))
+    {
+        if (pg->tex)
+            SDL_DestroyTexture(pg->tex);
+        rogue_atlas_packer_free(&pg->packer);
+        return -1;
+    }
+    rect->w = w;
+    rect->h = h;
+    return g_page_count++;
+}
+
+/* Copy surf into an atlas page; returns the page index or -1 (caller falls back). */
+static int atlas_upload(const char* key, SDL_Surface* surf, SDL_Rect* rect)
+{
+    if (surf->w > ROGUE_TEXTURE_ATLAS_MAX_IMAGE || surf->h > ROGUE_TEXTURE_ATLAS_MAX_IMAGE)
+        return -1;
+    int page = place_from_manifest(key, surf->w, surf->h, rect);
+    if (page < 0)
+        page = place_runtime(surf->w, surf->h, rect);
+    if (page < 0)
+        return -1;
+    SDL_Surface* conv = SDL_ConvertSurfaceFormat(surf, SDL_PIXELFORMAT_RGBA32, 0);
+    if (!conv)
+        return -1;
+    int rc = SDL_UpdateTexture(g_pages[page].tex, rect, conv->pixels, conv->pitch);
+    SDL_FreeSurface(conv);
+    if (rc != 0)
+        return -1;
+    g_pages[page].images++;
+    return page;
+}
+
+static void entry_to_texture(int idx, RogueTexture* t)
+{
+    const TexEntry* e = &g_entries[idx];
+    t->handle = e->handle;
+    t->w = e->w;
+    t->h = e->h;
+    t->ax = e->ax;
+    t->ay = e->ay;
+    t->cache_id = idx + 1;
+}
+
+bool rogue_texture_cache_acquire(RogueTexture* t, const char* path, int atlased)
+{
+    char resolved[512];
+    resolve_path(path, resolved, sizeof resolved);
+    char key[sizeof resolved];
+    memcpy(key, resolved, sizeof key);
+    rogue_atlas_normalize_path(key);
+    int idx = entry_find(key, atlased);
+    if (idx >= 0)
+    {
+        g_entries[idx].refs++;
+        g_dedup_hits++;
+        entry_to_texture(idx, t);
+        return true;
+    }
+    unsigned char* owned_pixels = NULL;
+    SDL_Surface* surf = rogue_texture_load_surface(resolved, &owned_pixels);
+    if (!surf)
+        return false;
+    idx = entry_alloc();
+    if (idx < 0)
+    {
+        SDL_FreeSurface(surf);
+        free(owned_pixels);
+        return false;
+    }
+    TexEntry* e = &g_entries[idx];
+    memset(e, 0, sizeof *e);
+    e->w = surf->w;
+    e->h = surf->h;
+    e->page = -1;
+    SDL_Rect rect = {0, 0, 0, 0};
+    int page = atlased ? atlas_upload(key, surf, &rect) : -1;
+    if (page >= 0)
+    {
+        e->handle = g_pages[page].tex;
+        e->page = page;
+        e->ax = rect.x;
+        e->ay = rect.y;
+    }
+    else
+    {
+        e->handle = SDL_CreateTextureFromSurface(g_internal_sdl_renderer_ref, surf);
+        if (!e->handle)
+        {
+            ROGUE_LOGC_WARN(ROGUE_LOG_CAT_RENDER, "SDL_CreateTextureFromSurface failed for %s",
+                            path);
+            SDL_FreeSurface(surf);
+            free(owned_pixels);
+            return false;
+        }
+        SDL_SetTextureBlendMode(e->handle, SDL_BLENDMODE_BLEND); /* alpha & color mod blending */
+        g_standalone_live++;
+    }
+    SDL_FreeSurface(surf);
+    free(owned_pixels);
+    memcpy(e->key, key, sizeof e->key);
+    e->refs = 1;
+    entry_to_texture(idx, t);
+    return true;
+}
+
+void rogue_texture_cache_release(RogueTexture* t)
+{
+    int idx = t->cache_id - 1;
+    if (idx < 0 || idx >= g_entry_count || !g_entries[idx].key[0])
+        return;
+    TexEntry* e = &g_entries[idx];
+    if (e->refs > 0)
+        e->refs--;
+    /* atlas rects are not reclaimed: the entry stays so a reload is a hit */
+    if (e->refs == 0 && e->page < 0)
+    {
+        if (e->handle)
+            SDL_DestroyTexture(e->handle);
+        g_standalone_live--;
+        memset(e, 0, sizeof *e);
+    }
+}
+#endif
+
+int rogue_texture_cache_load_manifest(const char* path)
+{
+    RogueAtlasManifest m;
+    if (rogue_atlas_manifest_read(&m, path) != 0)
+        return -1;
+    if (m.page_count > ROGUE_TEXTURE_MAX_ATLAS_PAGES)
+    {
+        ROGUE_LOGC_WARN(ROGUE_LOG_CAT_RENDER, "atlas manifest %s has %d pages (max %d); ignored",
+                        path, m.page_count, ROGUE_TEXTURE_MAX_ATLAS_PAGES);
+        rogue_atlas_manifest_free(&m);
+        return -1;
+    }
+    rogue_atlas_manifest_free(&g_manifest);
+    g_manifest = m;
+    g_manifest_loaded = 1;
+    return 0;
+}
+
+void rogue_texture_cache_get_stats(RogueTextureCacheStats* out)
+{
+    if (!out)
+        return;
+    memset(out, 0, sizeof *out);
+#ifdef ROGUE_HAVE_SDL
+    out->atlas_pages = g_page_count;
+    out->textures = g_standalone_live + g_page_count;
+    for (int i = 0; i < g_page_count; ++i)
+        out->atlas_images += g_pages[i].images;
+    for (int i = 0; i < g_entry_count; ++i)
+        if (g_entries[i].key[0])
+            out->entries++;
+#endif
+    out->dedup_hits = g_dedup_hits;
+    out->binds_last_frame = g_last_binds;
+    out->draws_last_frame = g_last_draws;
+}
+
+void rogue_texture_cache_note_draw(const void* handle)
+{
+    g_frame_draws++;
+    if (handle != g_last_bound)
+    {
+        g_frame_binds++;
+        g_last_bound = handle;
+    }
+}
+
+void rogue_texture_cache_frame_reset(void)
+{
+    g_last_binds = g_frame_binds;
+    g_last_draws = g_frame_draws;
+    g_frame_binds = g_frame_draws = 0;
+    g_last_bound = NULL;
+}
+
+void rogue_texture_cache_shutdown(void)
+{
+#ifdef ROGUE_HAVE_SDL
+    for (int i = 0; i < g_entry_count; ++i)
+        if (g_entries[i].key[0] && g_entries[i].page < 0 && g_entries[i].handle)
+            SDL_DestroyTexture(g_entries[i].handle);
+    for (int i = 0; i < g_page_count; ++i)
+    {
+        if (g_pages[i].tex)
+            SDL_DestroyTexture(g_pages[i].tex);
+        if (g_pages[i].manifest_page < 0)
+            rogue_atlas_packer_free(&g_pages[i].packer);
+    }
+    free(g_entries);
+    g_entries = NULL;
+    g_entry_count = g_entry_cap = 0;
+    g_page_count = 0;
+    g_standalone_live = 0;
+#endif
+    rogue_atlas_manifest_free(&g_manifest);
+    g_manifest_loaded = 0;
+    g_dedup_hits = 0;
+    g_last_bound = NULL;
+    g_frame_binds = g_frame_draws = g_last_binds = g_last_draws = 0;
+}
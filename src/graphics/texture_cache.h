@@ -0,0 +1,55 @@
+/* Texture cache: path-deduplicated textures, shared atlas pages and per-frame bind stats.
+ *
+ * rogue_texture_load / rogue_texture_load_atlased (sprite.h) go through this cache: the same
+ * resolved image path yields one GPU texture however many RogueTexture copies refer to it, and
+ * atlased loads pack small images into shared pages (placements from a baked manifest when one
+ * is loaded, runtime skyline packing otherwise). */
+#ifndef ROGUE_GRAPHICS_TEXTURE_CACHE_H
+#define ROGUE_GRAPHICS_TEXTURE_CACHE_H
+
+#include "sprite.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define ROGUE_TEXTURE_ATLAS_PAGE_SIZE 2048
+#define ROGUE_TEXTURE_ATLAS_MAX_IMAGE 1024 /* larger images stay standalone */
+#define ROGUE_TEXTURE_ATLAS_PADDING 1
+#define ROGUE_TEXTURE_MAX_ATLAS_PAGES 16
+#define ROGUE_TEXTURE_ATLAS_MANIFEST "assets/atlas.manifest"
+
+    typedef struct RogueTextureCacheStats
+    {
+        int textures;         /* live GPU textures (standalone + atlas pages) */
+        int atlas_pages;      /* of which atlas pages */
+        int atlas_images;     /* images packed into pages */
+        int entries;          /* distinct cached images */
+        unsigned dedup_hits;  /* loads served by an existing texture */
+        int binds_last_frame; /* texture switches between consecutive sprite draws */
+        int draws_last_frame; /* sprite draws */
+    } RogueTextureCacheStats;
+
+    /* Use baked placements for atlased loads (tools/atlas_bake). 0 on success. */
+    int rogue_texture_cache_load_manifest(const char* path);
+    void rogue_texture_cache_get_stats(RogueTextureCacheStats* out);
+    /* Sprite draw sites report the texture they bind; frame_reset publishes the counts. */
+    void rogue_texture_cache_note_draw(const void* handle);
+    void rogue_texture_cache_frame_reset(void);
+    /* Destroy every cached texture and atlas page (after all users released theirs). */
+    void rogue_texture_cache_shutdown(void);
+
+#ifdef ROGUE_HAVE_SDL
+    /* Internal (sprite.c): fill t from the cache, loading on a miss. */
+    bool rogue_texture_cache_acquire(RogueTexture* t, const char* path, int atlased);
+    void rogue_texture_cache_release(RogueTexture* t);
+    /* Internal (sprite.c): decode an already resolved path. *owned_pixels is set when the
+       surface wraps a buffer to free after the surface. */
+    SDL_Surface* rogue_texture_load_surface(const char* path, unsigned char** owned_pixels);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* ROGUE_GRAPHICS_TEXTURE_CACHE_H */
@@ -211,7 +211,7 @@ bool rogue_tile_sprites_finalize(void)
             TileVariant* v = &b->variants[i];
             if (!v->loaded)
             {
-                if (!rogue_texture_load(&v->texture, v->path))
+                if (!rogue_texture_load_atlased(&v->texture, v->path))
                 {
                     ROGUE_LOG_WARN("tile texture load fail: %s (tile=%d variant=%d)", v->path, t,
                                    i);
@@ -28,15 +28,23 @@ int main(void)
 {
     /* Honor env-based logging level as early as possible. */
     rogue_log_set_level_from_env();
+    /* Log lines are formatted into per-thread rings and written by a background thread. */
+    rogue_log_async_start();
     RogueAppConfig cfg = {
-        .window_title = "Roguelike", .window_width = 1920, .window_height = 1080, .target_fps = 60};
+        .window_title = "Roguelike",
+        .window_width = 1920,
+        .window_height = 1080,
+        .target_fps = 60,
+        .sim_hz = 60};
     if (!rogue_app_init(&cfg))
     {
         ROGUE_LOG_ERROR("Failed to initialize app");
+        rogue_log_async_stop();
         return 1;
     }
     /* Disable trunk collision for player/entities globally. */
     rogue_app_run();
     rogue_app_shutdown();
+    rogue_log_async_stop();
     return 0;
 }
@@ -1,5 +1,6 @@
 #include "ui_context.h"
 #include "../../util/log.h"
+#include "../../util/profiler.h"
 #include "ui_animation.h"
 #include <math.h>
 #include <stdint.h>
@@ -2273,16 +2274,27 @@ void rogue_ui_render(RogueUIContext* ctx)
 }
 
 /* --------- Extended Phase 9 APIs (per-phase instrumentation) ---------- */
+/* Phases also open unified profiler scopes (wall clock) so they show up in frame traces; the
+   accumulators keep using the context time provider. */
+static int ui_perf_phase_zone(int phase_id)
+{
+    static RogueProfZoneSlot slots[8];
+    static const char* const names[8] = {"ui_phase0", "ui_phase1", "ui_phase2", "ui_phase3",
+                                         "ui_phase4", "ui_phase5", "ui_phase6", "ui_phase7"};
+    return rogue_prof_zone_slot(&slots[phase_id], names[phase_id]);
+}
 void rogue_ui_perf_phase_begin(RogueUIContext* ctx, int phase_id)
 {
     if (!ctx || phase_id < 0 || phase_id > 7)
         return;
     ctx->perf_phase_start[phase_id] = ui_perf_now(ctx);
+    rogue_prof_begin(ui_perf_phase_zone(phase_id));
 }
 void rogue_ui_perf_phase_end(RogueUIContext* ctx, int phase_id)
 {
     if (!ctx || phase_id < 0 || phase_id > 7)
         return;
+    rogue_prof_end(ui_perf_phase_zone(phase_id));
     double now = ui_perf_now(ctx);
     double start = ctx->perf_phase_start[phase_id];
     if (start > 0 && now >= start)
@@ -0,0 +1,302 @@
+/* Microbenchmark harness (see bench.h) */
+#include "bench.h"
+#include "json_tok.h"
+#include "profiler.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int cmp_double(const void* a, const void* b)
+{
+    double x = *(const double*) a, y = *(const double*) b;
+    return (x > y) - (x < y);
+}
+
+double rogue_bench_percentile(double* samples, int n, double pct)
+{
+    if (!samples || n <= 0)
+        return 0.0;
+    qsort(samples, (size_t) n, sizeof(double), cmp_double);
+    if (pct == 50.0 && (n % 2) == 0)
+        return 0.5 * (samples[n / 2 - 1] + samples[n / 2]);
+    if (pct <= 0.0)
+        return samples[0];
+    int rank = (int) ceil(pct / 100.0 * n - 1e-9);
+    if (rank < 1)
+        rank = 1;
+    if (rank > n)
+        rank = n;
+    return samples[rank - 1];
+}
+
+int rogue_bench_run_case(const RogueBenchCase* c, const RogueBenchConfig* cfg,
+                         RogueBenchResult* out)
+{
+    if (!c || !c->name || !c->run || !out)
+        return -1;
+    int warmup = cfg && cfg->warmup > 0 ? cfg->warmup : 0;
+    int reps = cfg && cfg->reps > 0 ? cfg->reps : 1;
+    if (reps > ROGUE_BENCH_MAX_REPS)
+        reps = ROGUE_BENCH_MAX_REPS;
+    int ops = c->ops > 0 ? c->ops : 1;
+    if (c->setup && c->setup(c->ud) != 0)
+        return 1;
+    static double samples[ROGUE_BENCH_MAX_REPS];
+    for (int i = 0; i < warmup; ++i)
+        c->run(c->ud);
+    double sum = 0.0;
+    for (int i = 0; i < reps; ++i)
+    {
+        uint64_t t0 = rogue_prof_now_ns();
+        c->run(c->ud);
+        samples[i] = (double) (rogue_prof_now_ns() - t0) / ops;
+        sum += samples[i];
+    }
+    if (c->teardown)
+        c->teardown(c->ud);
+    memset(out, 0, sizeof *out);
+    snprintf(out->name, sizeof out->name, "%s", c->name);
+    out->ops = ops;
+    out->reps = reps;
+    out->mean_ns = sum / reps;
+    out->p95_ns = rogue_bench_percentile(samples, reps, 95.0);
+    out->median_ns = rogue_bench_percentile(samples, reps, 50.0);
+    out->min_ns = samples[0]; /* sorted by the percentile calls */
+    return 0;
+}
+
+int rogue_bench_run_all(const RogueBenchCase* cases, int count, const RogueBenchConfig* cfg,
+                        RogueBenchReport* out)
+{
+    if (!out)
+        return 0;
+    memset(out, 0, sizeof *out);
+    out->warmup = cfg && cfg->warmup > 0 ? cfg->warmup : 0;
+    out->reps = cfg && cfg->reps > 0 ? cfg->reps : 1;
+    if (out->reps > ROGUE_BENCH_MAX_REPS)
+        out->reps = ROGUE_BENCH_MAX_REPS;
+    for (int i = 0; cases && i < count && out->count < ROGUE_BENCH_MAX_RESULTS; ++i)
+    {
+        if (cfg && cfg->filter && cfg->filter[0] && !strstr(cases[i].name, cfg->filter))
+            continue;
+        if (rogue_bench_run_case(&cases[i], cfg, &out->results[out->count]) == 0)
+            out->count++;
+    }
+    return out->count;
+}
+
+int rogue_bench_write_json(const RogueBenchReport* r, FILE* f)
+{
+    if (!r || !f)
+        return -1;
+    fprintf(f, "{\n  \"schema\": \"%s\",\n  \"warmup\": %d,\n  \"reps\": %d,\n  \"results\": [",
+            ROGUE_BENCH_SCHEMA, r->warmup, r->reps);
+    for (int i = 0; i < r->count; ++i)
+    {
+        const RogueBenchResult* x = &r->results[i];
+        fprintf(f,
+                "%s\n    {\"name\": \"%s\", \"ops\": %d, \"reps\": %d, \"median_ns\": %.1f, "
+                "\"p95_ns\": %.1f, \"min_ns\": %.1f, \"mean_ns\": %.1f}",
+                i ? "," : "", x->name, x->ops, x->reps, x->median_ns, x->p95_ns, x->min_ns,
+                x->mean_ns);
+    }
+    fprintf(f, "%s]\n}\n", r->count ? "\n  " : "");
+    return ferror(f) ? -1 : 0;
+}
+
+static FILE* bench_open(const char* path, const char* mode)
+{
+    FILE* f = NULL;
+#if defined(_MSC_VER)
+    if (fopen_s(&f, path, mode) != 0)
+        f = NULL;
+#else
+    f = fopen(path, mode);
+#endif
+    return f;
+}
+
+int rogue_bench_save_json(const RogueBenchReport* r, const char* path)
+{
+    if (!r || !path)
+        return -1;
+    FILE* f = bench_open(path, "wb");
+    if (!f)
+        return -1;
+    int rc = rogue_bench_write_json(r, f);
+    if (fclose(f) != 0)
+        rc = -1;
+    return rc;
+}
+
+static int parse_result(RogueJsonTokenizer* t, RogueBenchResult* x)
+{
+    RogueJsonView key;
+    RogueJsonToken v;
+    int r;
+    memset(x, 0, sizeof *x);
+    while ((r = rogue_json_tok_member(t, &key, &v)) > 0)
+    {
+        if (rogue_json_view_eq(key, "name") && v.type == ROGUE_JTOK_STRING)
+            rogue_json_tok_copy(&v, x->name, sizeof x->name);
+        else if (rogue_json_view_eq(key, "ops"))
+            rogue_json_tok_int(&v, &x->ops);
+        else if (rogue_json_view_eq(key, "reps"))
+            rogue_json_tok_int(&v, &x->reps);
+        else if (rogue_json_view_eq(key, "median_ns"))
+            rogue_json_tok_double(&v, &x->median_ns);
+        else if (rogue_json_view_eq(key, "p95_ns"))
+            rogue_json_tok_double(&v, &x->p95_ns);
+        else if (rogue_json_view_eq(key, "min_ns"))
+            rogue_json_tok_double(&v, &x->min_ns);
+        else if (rogue_json_view_eq(key, "mean_ns"))
+            rogue_json_tok_double(&v, &x->mean_ns);
+        else if (rogue_json_tok_skip(t, &v) != 0)
+            return -1;
+    }
+    return r < 0 || !x->name[0] ? -1 : 0;
+}
+
+int rogue_bench_parse_json(RogueBenchReport* r, const char* src, size_t len)
+{
+    if (!r || !src)
+        return -1;
+    memset(r, 0, sizeof *r);
+    RogueJsonTokenizer t;
+    RogueJsonToken v, item;
+    RogueJsonView key;
+    rogue_json_tok_init(&t, src, len);
+    if (rogue_json_tok_next(&t, &v) != ROGUE_JTOK_OBJECT_BEGIN)
+        return -1;
+    int have_schema = 0, m;
+    while ((m = rogue_json_tok_member(&t, &key, &v)) > 0)
+    {
+        if (rogue_json_view_eq(key, "schema") && v.type == ROGUE_JTOK_STRING)
+            have_schema = rogue_json_view_eq(v.text, ROGUE_BENCH_SCHEMA);
+        else if (rogue_json_view_eq(key, "warmup"))
+            rogue_json_tok_int(&v, &r->warmup);
+        else if (rogue_json_view_eq(key, "reps"))
+            rogue_json_tok_int(&v, &r->reps);
+        else if (rogue_json_view_eq(key, "results") && v.type == ROGUE_JTOK_ARRAY_BEGIN)
+        {
+            int e;
+            while ((e = rogue_json_tok_element(&t, &item)) > 0)
+            {
+                if (item.type != ROGUE_JTOK_OBJECT_BEGIN || r->count >= ROGUE_BENCH_MAX_RESULTS)
+                {
+                    if (rogue_json_tok_skip(&t, &item) != 0)
+                        return -1;
+                    continue;
+                }
+                if (parse_result(&t, &r->results[r->count]) != 0)
+                    return -1;
+                r->count++;
+            }
+            if (e < 0)
+                return -1;
+        }
+        else if (rogue_json_tok_skip(&t, &v) != 0)
+            return -1;
+    }
+    if (m < 0 || rogue_json_tok_next(&t, &v) != ROGUE_JTOK_END || !have_schema)
+        return -1;
+    return 0;
+}
+
+int rogue_bench_load_json(RogueBenchReport* r, const char* path)
+{
+    if (!r || !path)
+        return -1;
+    FILE* f = bench_open(path, "rb");
+    if (!f)
+        return -1;
+    fseek(f, 0, SEEK_END);
+    long sz = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    char* buf = sz > 0 ? (char*) malloc((size_t) sz + 1) : NULL;
+    if (!buf)
+    {
+        fclose(f);
+        return -1;
+    }
+    size_t rd = fread(buf, 1, (size_t) sz, f);
+    buf[rd] = '\0';
+    fclose(f);
+    int rc = rogue_bench_parse_json(r, buf, rd);
+    free(buf);
+    return rc;
+}
+
+static const RogueBenchResult* find_result(const RogueBenchReport* r, const char* name)
+{
+    for (int i = 0; i < r->count; ++i)
+        if (strcmp(r->results[i].name, name) == 0)
+            return &r->results[i];
+    return NULL;
+}
+
+int rogue_bench_compare(const RogueBenchReport* base, const RogueBenchReport* cur,
+                        double tolerance, RogueBenchDelta* out, int max, int* out_count)
+{
+    int n = 0, regressions = 0;
+    if (tolerance < 0.0)
+        tolerance = 0.0;
+    for (int i = 0; cur && i < cur->count; ++i)
+    {
+        const RogueBenchResult* c = &cur->results[i];
+        const RogueBenchResult* b = base ? find_result(base, c->name) : NULL;
+        RogueBenchDelta d;
+        memset(&d, 0, sizeof d);
+        snprintf(d.name, sizeof d.name, "%s", c->name);
+        d.cur_ns = c->median_ns;
+        d.verdict = ROGUE_BENCH_NEW;
+        if (b && b->median_ns > 0.0)
+        {
+            d.base_ns = b->median_ns;
+            d.ratio = c->median_ns / b->median_ns;
+            if (d.ratio > 1.0 + tolerance)
+                d.verdict = ROGUE_BENCH_SLOWER;
+            else if (d.ratio < 1.0 / (1.0 + tolerance))
+                d.verdict = ROGUE_BENCH_FASTER;
+            else
+                d.verdict = ROGUE_BENCH_SAME;
+        }
+        regressions += d.verdict == ROGUE_BENCH_SLOWER;
+        if (out && n < max)
+            out[n++] = d;
+    }
+    for (int i = 0; base && i < base->count; ++i)
+    {
+        if (cur && find_result(cur, base->results[i].name))
+            continue;
+        if (out && n < max)
+        {
+            memset(&out[n], 0, sizeof out[n]);
+            snprintf(out[n].name, sizeof out[n].name, "%s", base->results[i].name);
+            out[n].base_ns = base->results[i].median_ns;
+            out[n].verdict = ROGUE_BENCH_MISSING;
+            n++;
+        }
+    }
+    if (out_count)
+        *out_count = n;
+    return regressions;
+}
+
+const char* rogue_bench_verdict_name(RogueBenchVerdict v)
+{
+    switch (v)
+    {
+    case ROGUE_BENCH_SAME:
+        return "ok";
+    case ROGUE_BENCH_FASTER:
+        return "faster";
+    case ROGUE_BENCH_SLOWER:
+        return "REGRESSED";
+    case ROGUE_BENCH_NEW:
+        return "new";
+    case ROGUE_BENCH_MISSING:
+        return "missing";
+    }
+    return "?";
+}
@@ -0,0 +1,99 @@
+/* Microbenchmark harness behind the rogue_bench target (tools/rogue_bench.c).
+ *
+ * A case is a setup / run / teardown triple; run performs `ops` operations. Each case is set up
+ * once, run `warmup` times untimed, then `reps` times timed with rogue_prof_now_ns, and the
+ * per-operation times of the repetitions are summarized as median / p95 / min / mean.
+ *
+ * Reports serialize to a stable JSON schema (keys in fixed order, results in case order):
+ *
+ *     {"schema": "rogue_bench/1", "warmup": 3, "reps": 15, "results": [
+ *       {"name": "pathfinding.astar", "ops": 16, "reps": 15, "median_ns": 1234.5,
+ *        "p95_ns": 1400.0, "min_ns": 1200.1, "mean_ns": 1250.2}, ...]}
+ *
+ * Compare mode matches a report against a stored baseline by case name; a case regresses when
+ * its median exceeds the baseline median by more than the tolerance. */
+#ifndef ROGUE_UTIL_BENCH_H
+#define ROGUE_UTIL_BENCH_H
+
+#include <stdio.h>
+
+#define ROGUE_BENCH_SCHEMA "rogue_bench/1"
+#define ROGUE_BENCH_MAX_RESULTS 64
+#define ROGUE_BENCH_MAX_REPS 1024
+#define ROGUE_BENCH_NAME_CAP 64
+
+typedef struct RogueBenchCase
+{
+    const char* name;         /* "group.case"; the key baselines are matched on */
+    int (*setup)(void* ud);   /* optional; nonzero skips the case */
+    void (*run)(void* ud);    /* one repetition of `ops` operations */
+    void (*teardown)(void* ud); /* optional */
+    void* ud;
+    int ops;
+} RogueBenchCase;
+
+typedef struct RogueBenchConfig
+{
+    int warmup;
+    int reps;           /* clamped to [1, ROGUE_BENCH_MAX_REPS] */
+    const char* filter; /* run only cases whose name contains this; NULL = all */
+} RogueBenchConfig;
+
+typedef struct RogueBenchResult
+{
+    char name[ROGUE_BENCH_NAME_CAP];
+    int ops;
+    int reps;
+    double median_ns, p95_ns, min_ns, mean_ns; /* per operation */
+} RogueBenchResult;
+
+typedef struct RogueBenchReport
+{
+    int warmup;
+    int reps;
+    int count;
+    RogueBenchResult results[ROGUE_BENCH_MAX_RESULTS];
+} RogueBenchReport;
+
+typedef enum RogueBenchVerdict
+{
+    ROGUE_BENCH_SAME = 0,
+    ROGUE_BENCH_FASTER,
+    ROGUE_BENCH_SLOWER, /* regression */
+    ROGUE_BENCH_NEW,    /* not in the baseline */
+    ROGUE_BENCH_MISSING /* in the baseline, not run */
+} RogueBenchVerdict;
+
+typedef struct RogueBenchDelta
+{
+    char name[ROGUE_BENCH_NAME_CAP];
+    double base_ns, cur_ns; /* medians; 0 when absent */
+    double ratio;           /* cur / base; 0 when either is absent */
+    RogueBenchVerdict verdict;
+} RogueBenchDelta;
+
+/* Nearest-rank percentile (pct in [0,100]) of n samples; sorts samples in place. The median
+   (pct 50) of an even count averages the two middle samples. 0 when n <= 0. */
+double rogue_bench_percentile(double* samples, int n, double pct);
+
+/* Run one case into out. 0 ok, -1 bad case, 1 skipped by its setup. */
+int rogue_bench_run_case(const RogueBenchCase* c, const RogueBenchConfig* cfg,
+                         RogueBenchResult* out);
+/* Run every case matching cfg->filter in order; returns the number of results. */
+int rogue_bench_run_all(const RogueBenchCase* cases, int count, const RogueBenchConfig* cfg,
+                        RogueBenchReport* out);
+
+/* JSON IO (schema above). 0 ok, -1 on IO / parse errors or a schema mismatch. */
+int rogue_bench_write_json(const RogueBenchReport* r, FILE* f);
+int rogue_bench_save_json(const RogueBenchReport* r, const char* path);
+int rogue_bench_load_json(RogueBenchReport* r, const char* path);
+int rogue_bench_parse_json(RogueBenchReport* r, const char* src, size_t len);
+
+/* One delta per current result (in order) then one per baseline-only case. tolerance is a
+   fraction (0.10 = 10%). Returns the number of regressions; *out_count gets the deltas
+   written (at most max). */
+int rogue_bench_compare(const RogueBenchReport* base, const RogueBenchReport* cur,
+                        double tolerance, RogueBenchDelta* out, int max, int* out_count);
+const char* rogue_bench_verdict_name(RogueBenchVerdict v);
+
+#endif
@@ -0,0 +1,413 @@
+/**
+ * @file content_pack.c
+ * @brief Baked content pack container: in-memory writer and memory-mapped validating reader.
+ * @details See content_pack.h. Validation happens once at open: header fields, the section table
+ * and every section range must lie inside the file, the string pool must end with a NUL (so any
+ * in-range offset yields a terminated string) and the FNV-1a checksum must match. After that the
+ * accessors are plain pointer arithmetic. Files are mapped read-only; when mapping is not
+ * available the file is read into an 8-byte aligned heap buffer instead.
+ */
+
+#include "content_pack.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define PACK_ALIGN 8u
+
+static size_t align_up(size_t v) { return (v + (PACK_ALIGN - 1)) & ~(size_t) (PACK_ALIGN - 1); }
+
+uint64_t rogue_pack_checksum(const void* data, size_t size)
+{
+    const unsigned char* p = (const unsigned char*) data;
+    uint64_t h = 1469598103934665603ull;
+    for (size_t i = 0; i < size; i++)
+    {
+        h ^= p[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+/* ---- Reader ---- */
+
+static int validate(RoguePack* pack)
+{
+    if (pack->size < sizeof(RoguePackHeader) || ((uintptr_t) pack->base % PACK_ALIGN) != 0)
+        return ROGUE_PACK_ERR_FORMAT;
+    const RoguePackHeader* h = (const RoguePackHeader*) pack->base;
+    if (h->magic != ROGUE_PACK_MAGIC || h->endian_tag != ROGUE_PACK_ENDIAN_TAG)
+        return ROGUE_PACK_ERR_FORMAT;
+    if (h->version != ROGUE_PACK_VERSION)
+        return ROGUE_PACK_ERR_VERSION;
+    if (h->total_size != (uint64_t) pack->size || h->section_count > ROGUE_PACK_MAX_SECTIONS)
+        return ROGUE_PACK_ERR_FORMAT;
+    size_t table_end = sizeof(RoguePackHeader) + sizeof(RoguePackSection) * h->section_count;
+    if (table_end > pack->size || h->strings_size == 0 || h->strings_offset < table_end ||
+        (uint64_t) h->strings_offset + h->strings_size > pack->size ||
+        pack->base[h->strings_offset + h->strings_size - 1] != '\0')
+        return ROGUE_PACK_ERR_FORMAT;
+    const RoguePackSection* s = (const RoguePackSection*) (pack->base + sizeof(RoguePackHeader));
+    for (uint32_t i = 0; i < h->section_count; i++)
+    {
+        uint64_t end = (uint64_t) s[i].offset + (uint64_t) s[i].record_size * s[i].count;
+        if (s[i].offset < table_end || (s[i].offset % PACK_ALIGN) != 0 || end > h->strings_offset)
+            return ROGUE_PACK_ERR_FORMAT;
+    }
+    if (rogue_pack_checksum(pack->base + sizeof(RoguePackHeader),
+                            pack->size - sizeof(RoguePackHeader)) != h->checksum)
+        return ROGUE_PACK_ERR_CHECKSUM;
+    pack->header = h;
+    pack->sections = s;
+    return 0;
+}
+
+int rogue_pack_open_memory(RoguePack* pack, const void* data, size_t size)
+{
+    if (!pack || !data)
+        return ROGUE_PACK_ERR_IO;
+    memset(pack, 0, sizeof *pack);
+    pack->base = (const unsigned char*) data;
+    pack->size = size;
+    int rc = validate(pack);
+    if (rc != 0)
+        memset(pack, 0, sizeof *pack);
+    return rc;
+}
+
+/* Fallback when the file cannot be mapped: read it into a heap buffer (malloc is suitably
+ * aligned for the 8-byte records). */
+static int read_whole(RoguePack* pack, FILE* f, size_t size)
+{
+    unsigned char* buf = (unsigned char*) malloc(size ? size : 1);
+    if (!buf)
+        return ROGUE_PACK_ERR_IO;
+    if (fread(buf, 1, size, f) != size)
+    {
+        free(buf);
+        return ROGUE_PACK_ERR_IO;
+    }
+    pack->base = buf;
+    pack->size = size;
+    pack->mode = 2;
+    return 0;
+}
+
+int rogue_pack_open(RoguePack* pack, const char* path)
+{
+    if (!pack || !path)
+        return ROGUE_PACK_ERR_IO;
+    memset(pack, 0, sizeof *pack);
+#if defined(_WIN32)
+    HANDLE fh = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL, NULL);
+    if (fh == INVALID_HANDLE_VALUE)
+        return ROGUE_PACK_ERR_IO;
+    LARGE_INTEGER sz;
+    if (!GetFileSizeEx(fh, &sz))
+    {
+        CloseHandle(fh);
+        return ROGUE_PACK_ERR_IO;
+    }
+    if (sz.QuadPart <= 0)
+    {
+        CloseHandle(fh);
+        return ROGUE_PACK_ERR_FORMAT;
+    }
+    HANDLE mh = CreateFileMappingA(fh, NULL, PAGE_READONLY, 0, 0, NULL);
+    const void* view = mh ? MapViewOfFile(mh, FILE_MAP_READ, 0, 0, 0) : NULL;
+    if (!view)
+    {
+        if (mh)
+            CloseHandle(mh);
+        CloseHandle(fh);
+        return ROGUE_PACK_ERR_IO;
+    }
+    pack->base = (const unsigned char*) view;
+    pack->size = (size_t) sz.QuadPart;
+    pack->mode = 1;
+    pack->file_handle = fh;
+    pack->map_handle = mh;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return ROGUE_PACK_ERR_IO;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0)
+    {
+        close(fd);
+        return ROGUE_PACK_ERR_FORMAT;
+    }
+    size_t size = (size_t) st.st_size;
+    void* view = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (view != MAP_FAILED)
+    {
+        pack->base = (const unsigned char*) view;
+        pack->size = size;
+        pack->mode = 1;
+        close(fd);
+    }
+    else
+    {
+        close(fd);
+        FILE* f = fopen(path, "rb");
+        int rc = f ? read_whole(pack, f, size) : ROGUE_PACK_ERR_IO;
+        if (f)
+            fclose(f);
+        if (rc != 0)
+            return rc;
+    }
+#endif
+    int rc = validate(pack);
+    if (rc != 0)
+        rogue_pack_close(pack);
+    return rc;
+}
+
+void rogue_pack_close(RoguePack* pack)
+{
+    if (!pack)
+        return;
+    if (pack->mode == 1)
+    {
+#if defined(_WIN32)
+        UnmapViewOfFile(pack->base);
+        CloseHandle((HANDLE) pack->map_handle);
+        CloseHandle((HANDLE) pack->file_handle);
+#else
+        munmap((void*) pack->base, pack->size);
+#endif
+    }
+    else if (pack->mode == 2)
+        free((void*) pack->base);
+    memset(pack, 0, sizeof *pack);
+}
+
+const void* rogue_pack_section(const RoguePack* pack, uint32_t kind, uint32_t record_size,
+                               int* count)
+{
+    if (count)
+        *count = 0;
+    if (!pack || !pack->header)
+        return NULL;
+    for (uint32_t i = 0; i < pack->header->section_count; i++)
+    {
+        const RoguePackSection* s = &pack->sections[i];
+        if (s->kind != kind)
+            continue;
+        if (s->record_size != record_size)
+            return NULL;
+        if (count)
+            *count = (int) s->count;
+        return pack->base + s->offset;
+    }
+    return NULL;
+}
+
+const char* rogue_pack_string(const RoguePack* pack, uint32_t offset)
+{
+    if (!pack || !pack->header || offset >= pack->header->strings_size)
+        return "";
+    return (const char*) pack->base + pack->header->strings_offset + offset;
+}
+
+/* ---- Writer ---- */
+
+static int grow(void** buf, size_t* cap, size_t need)
+{
+    if (need <= *cap)
+        return 0;
+    size_t ncap = *cap ? *cap : 256;
+    while (ncap < need)
+        ncap *= 2;
+    void* nb = realloc(*buf, ncap);
+    if (!nb)
+        return -1;
+    *buf = nb;
+    *cap = ncap;
+    return 0;
+}
+
+static uint32_t hash_str(const char* s)
+{
+    return (uint32_t) rogue_pack_checksum(s, strlen(s));
+}
+
+int rogue_pack_writer_init(RoguePackWriter* w)
+{
+    if (!w)
+        return -1;
+    memset(w, 0, sizeof *w);
+    w->intern_cap = 256;
+    w->intern = (uint32_t*) calloc(w->intern_cap, sizeof(uint32_t));
+    if (!w->intern || grow((void**) &w->strings, &w->strings_cap, 1) != 0)
+    {
+        rogue_pack_writer_free(w);
+        return -1;
+    }
+    w->strings[0] = '\0'; /* offset 0 = "" */
+    w->strings_size = 1;
+    return 0;
+}
+
+void rogue_pack_writer_free(RoguePackWriter* w)
+{
+    if (!w)
+        return;
+    free(w->data);
+    free(w->strings);
+    free(w->intern);
+    memset(w, 0, sizeof *w);
+}
+
+static uint32_t* intern_slot(uint32_t* table, uint32_t cap, const char* pool, const char* s)
+{
+    uint32_t i = hash_str(s) & (cap - 1);
+    while (table[i] && strcmp(pool + table[i] - 1, s) != 0)
+        i = (i + 1) & (cap - 1);
+    return &table[i];
+}
+
+static int intern_rehash(RoguePackWriter* w)
+{
+    uint32_t ncap = w->intern_cap * 2;
+    uint32_t* nt = (uint32_t*) calloc(ncap, sizeof(uint32_t));
+    if (!nt)
+        return -1;
+    for (uint32_t i = 0; i < w->intern_cap; i++)
+        if (w->intern[i])
+            *intern_slot(nt, ncap, w->strings, w->strings + w->intern[i] - 1) = w->intern[i];
+    free(w->intern);
+    w->intern = nt;
+    w->intern_cap = ncap;
+    return 0;
+}
+
+uint32_t rogue_pack_writer_string(RoguePackWriter* w, const char* s)
+{
+    if (!w || !s || !s[0] || w->failed)
+        return 0;
+    if ((w->intern_count + 1) * 2 > w->intern_cap && intern_rehash(w) != 0)
+    {
+        w->failed = 1;
+        return 0;
+    }
+    uint32_t* slot = intern_slot(w->intern, w->intern_cap, w->strings, s);
+    if (*slot)
+        return *slot - 1;
+    size_t len = strlen(s) + 1;
+    if (w->strings_size + len > UINT32_MAX / 2 ||
+        grow((void**) &w->strings, &w->strings_cap, w->strings_size + len) != 0)
+    {
+        w->failed = 1;
+        return 0;
+    }
+    uint32_t off = (uint32_t) w->strings_size;
+    memcpy(w->strings + off, s, len);
+    w->strings_size += len;
+    *slot = off + 1;
+    w->intern_count++;
+    return off;
+}
+
+int rogue_pack_writer_section(RoguePackWriter* w, uint32_t kind, uint32_t record_size,
+                              const void* records, int count)
+{
+    if (!w || w->failed || record_size == 0 || count < 0 || (count > 0 && !records) ||
+        w->section_count >= ROGUE_PACK_MAX_SECTIONS)
+        return -1;
+    for (int i = 0; i < w->section_count; i++)
+        if (w->sections[i].kind == kind)
+            return -1;
+    size_t bytes = (size_t) record_size * (size_t) count;
+    size_t start = align_up(w->data_size);
+    if (start + bytes > UINT32_MAX / 2 ||
+        grow((void**) &w->data, &w->data_cap, start + bytes + 1) != 0)
+    {
+        w->failed = 1;
+        return -1;
+    }
+    memset(w->data + w->data_size, 0, start - w->data_size);
+    if (bytes)
+        memcpy(w->data + start, records, bytes);
+    w->data_size = start + bytes;
+    RoguePackSection* s = &w->sections[w->section_count++];
+    s->kind = kind;
+    s->record_size = record_size;
+    s->count = (uint32_t) count;
+    s->offset = (uint32_t) start; /* relative to the data block until finish */
+    return 0;
+}
+
+int rogue_pack_writer_finish(RoguePackWriter* w, void** out, size_t* out_size)
+{
+    if (!w || w->failed || !out || !out_size)
+        return -1;
+    size_t table_end =
+        sizeof(RoguePackHeader) + sizeof(RoguePackSection) * (size_t) w->section_count;
+    size_t data_off = align_up(table_end);
+    size_t strings_off = align_up(data_off + w->data_size);
+    size_t total = strings_off + w->strings_size;
+    if (total > UINT32_MAX)
+        return -1;
+    unsigned char* buf = (unsigned char*) calloc(1, total);
+    if (!buf)
+        return -1;
+    RoguePackHeader h;
+    memset(&h, 0, sizeof h);
+    h.magic = ROGUE_PACK_MAGIC;
+    h.version = ROGUE_PACK_VERSION;
+    h.endian_tag = ROGUE_PACK_ENDIAN_TAG;
+    h.section_count = (uint32_t) w->section_count;
+    h.strings_offset = (uint32_t) strings_off;
+    h.strings_size = (uint32_t) w->strings_size;
+    h.total_size = (uint64_t) total;
+    RoguePackSection* table = (RoguePackSection*) (buf + sizeof(RoguePackHeader));
+    for (int i = 0; i < w->section_count; i++)
+    {
+        table[i] = w->sections[i];
+        table[i].offset += (uint32_t) data_off;
+    }
+    if (w->data_size)
+        memcpy(buf + data_off, w->data, w->data_size);
+    memcpy(buf + strings_off, w->strings, w->strings_size);
+    h.checksum = rogue_pack_checksum(buf + sizeof h, total - sizeof h);
+    memcpy(buf, &h, sizeof h);
+    *out = buf;
+    *out_size = total;
+    return 0;
+}
+
+int rogue_pack_writer_save(RoguePackWriter* w, const char* path)
+{
+    void* buf = NULL;
+    size_t size = 0;
+    if (!path || rogue_pack_writer_finish(w, &buf, &size) != 0)
+        return -1;
+    FILE* f = NULL;
+#if defined(_MSC_VER)
+    if (fopen_s(&f, path, "wb") != 0)
+        f = NULL;
+#else
+    f = fopen(path, "wb");
+#endif
+    int rc = ROGUE_PACK_ERR_IO;
+    if (f)
+    {
+        if (fwrite(buf, 1, size, f) == size)
+            rc = 0;
+        if (fclose(f) != 0)
+            rc = ROGUE_PACK_ERR_IO;
+    }
+    free(buf);
+    return rc;
+}
@@ -0,0 +1,107 @@
+/* Baked content pack: versioned, checksummed binary container for pre-compiled content.
+ *
+ * Layout (little-endian, every offset relative to the start of the file):
+ *   RoguePackHeader | RoguePackSection[section_count] | section data (8-byte aligned) | strings
+ * A section is an array of fixed-size records of one kind (four-character code). Records hold
+ * plain integers; text lives in the interned string pool and is referenced by its byte offset
+ * (offset 0 is the empty string), so identical ids and names are stored once.
+ *
+ * Readers map the file (mmap / MapViewOfFile, plain read as a fallback), validate the header,
+ * section bounds and checksum once, and then use the records in place: no text is parsed.
+ * Writers collect sections and strings in memory and emit the file in one go (offline bake). */
+#ifndef ROGUE_UTIL_CONTENT_PACK_H
+#define ROGUE_UTIL_CONTENT_PACK_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define ROGUE_PACK_MAGIC 0x4B505252u /* "RRPK" */
+#define ROGUE_PACK_VERSION 1u
+#define ROGUE_PACK_ENDIAN_TAG 0x01020304u
+#define ROGUE_PACK_MAX_SECTIONS 32
+
+#define ROGUE_PACK_FOURCC(a, b, c, d)                                                              \
+    ((uint32_t) (a) | ((uint32_t) (b) << 8) | ((uint32_t) (c) << 16) | ((uint32_t) (d) << 24))
+
+/* open / load error codes */
+#define ROGUE_PACK_ERR_IO -1
+#define ROGUE_PACK_ERR_FORMAT -2   /* bad magic, endianness, sizes or offsets */
+#define ROGUE_PACK_ERR_VERSION -3  /* built by an incompatible baker */
+#define ROGUE_PACK_ERR_CHECKSUM -4 /* contents changed after the bake */
+
+typedef struct RoguePackHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t endian_tag;
+    uint32_t section_count;
+    uint32_t strings_offset;
+    uint32_t strings_size; /* pool always ends with a NUL */
+    uint64_t total_size;
+    uint64_t checksum; /* FNV-1a 64 over bytes [sizeof header, total_size) */
+} RoguePackHeader;
+
+typedef struct RoguePackSection
+{
+    uint32_t kind;
+    uint32_t record_size;
+    uint32_t count;
+    uint32_t offset;
+} RoguePackSection;
+
+typedef struct RoguePack
+{
+    const unsigned char* base;
+    size_t size;
+    const RoguePackHeader* header;
+    const RoguePackSection* sections;
+    int mode; /* 0 borrowed memory, 1 mapped, 2 heap copy */
+#if defined(_WIN32)
+    void* file_handle;
+    void* map_handle;
+#endif
+} RoguePack;
+
+/* Map and validate a pack file. Returns 0 or a ROGUE_PACK_ERR_* code (pack left closed). */
+int rogue_pack_open(RoguePack* pack, const char* path);
+/* Validate a pack already in memory (not copied; must outlive the pack, 8-byte aligned). */
+int rogue_pack_open_memory(RoguePack* pack, const void* data, size_t size);
+void rogue_pack_close(RoguePack* pack);
+
+/* Records of a section, used in place. NULL (count 0) when the kind is missing or its record
+ * size differs from record_size (layout changed without a version bump). */
+const void* rogue_pack_section(const RoguePack* pack, uint32_t kind, uint32_t record_size,
+                               int* count);
+/* String at a pool offset; "" for out-of-range offsets. */
+const char* rogue_pack_string(const RoguePack* pack, uint32_t offset);
+
+uint64_t rogue_pack_checksum(const void* data, size_t size);
+
+/* ---- Writer (bake) ---- */
+typedef struct RoguePackWriter
+{
+    unsigned char* data; /* section payloads, 8-byte aligned */
+    size_t data_size, data_cap;
+    char* strings;
+    size_t strings_size, strings_cap;
+    uint32_t* intern;   /* open-addressed: pool offset + 1, 0 = empty */
+    uint32_t intern_cap; /* power of two */
+    uint32_t intern_count;
+    RoguePackSection sections[ROGUE_PACK_MAX_SECTIONS];
+    int section_count;
+    int failed; /* allocation failure or overflow: finish refuses to emit */
+} RoguePackWriter;
+
+int rogue_pack_writer_init(RoguePackWriter* w);
+void rogue_pack_writer_free(RoguePackWriter* w);
+/* Intern a string (NULL = ""). Returns its pool offset. */
+uint32_t rogue_pack_writer_string(RoguePackWriter* w, const char* s);
+/* Append a section of count records (kinds must be unique). Returns 0 or -1. */
+int rogue_pack_writer_section(RoguePackWriter* w, uint32_t kind, uint32_t record_size,
+                              const void* records, int count);
+/* Emit the pack into a malloc'd buffer (free() it). Returns 0 or -1. */
+int rogue_pack_writer_finish(RoguePackWriter* w, void** out, size_t* out_size);
+/* finish + write to path. Returns 0 or ROGUE_PACK_ERR_IO / -1. */
+int rogue_pack_writer_save(RoguePackWriter* w, const char* path);
+
+#endif
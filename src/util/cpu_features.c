@@ -0,0 +1,55 @@
+#include "cpu_features.h"
+#if ROGUE_ARCH_X86
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+static RogueCpuFeatures g_cpu;
+static volatile int g_cpu_detected = 0;
+
+#if ROGUE_ARCH_X86
+static void cpuid_count(unsigned leaf, unsigned sub, unsigned r[4])
+{
+#if defined(_MSC_VER)
+    int regs[4];
+    __cpuidex(regs, (int) leaf, (int) sub);
+    for (int i = 0; i < 4; i++)
+        r[i] = (unsigned) regs[i];
+#else
+    r[0] = r[1] = r[2] = r[3] = 0;
+    __cpuid_count(leaf, sub, r[0], r[1], r[2], r[3]);
+#endif
+}
+#endif
+
+const RogueCpuFeatures* rogue_cpu_features(void)
+{
+    if (g_cpu_detected)
+        return &g_cpu;
+    RogueCpuFeatures f = {0};
+#if ROGUE_ARCH_X86
+    unsigned r[4];
+    cpuid_count(0, 0, r);
+    unsigned max_leaf = r[0];
+    if (max_leaf >= 1)
+    {
+        cpuid_count(1, 0, r);
+        f.pclmul = (r[2] >> 1) & 1;
+        f.ssse3 = (r[2] >> 9) & 1;
+        f.sse41 = (r[2] >> 19) & 1;
+        f.sse42 = (r[2] >> 20) & 1;
+    }
+    if (max_leaf >= 7)
+    {
+        cpuid_count(7, 0, r);
+        f.avx2 = (r[1] >> 5) & 1;
+        f.sha = (r[1] >> 29) & 1;
+    }
+#endif
+    g_cpu = f; /* idempotent: concurrent first callers store identical values */
+    g_cpu_detected = 1;
+    return &g_cpu;
+}
@@ -0,0 +1,32 @@
+/* Runtime CPU feature detection (x86 cpuid; all zero on other architectures) */
+#ifndef ROGUE_UTIL_CPU_FEATURES_H
+#define ROGUE_UTIL_CPU_FEATURES_H
+
+typedef struct RogueCpuFeatures
+{
+    int sse41;
+    int ssse3;
+    int sse42;
+    int pclmul;
+    int sha; /* SHA-NI (sha256rnds2 / sha256msg1 / sha256msg2) */
+    int avx2;
+} RogueCpuFeatures;
+
+/* Detected once and cached; safe to call from any thread after the first call. */
+const RogueCpuFeatures* rogue_cpu_features(void);
+
+/* Annotate functions that use instruction-set extensions beyond the build baseline. MSVC exposes
+ * all intrinsics unconditionally, GCC/Clang need a per-function target. */
+#if defined(__GNUC__) || defined(__clang__)
+#define ROGUE_TARGET(isa) __attribute__((target(isa)))
+#else
+#define ROGUE_TARGET(isa)
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define ROGUE_ARCH_X86 1
+#else
+#define ROGUE_ARCH_X86 0
+#endif
+
+#endif
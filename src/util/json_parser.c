@@ -2,146 +2,376 @@
  * @file json_parser.c
  * @brief JSON data structure manipulation library.
  * @details This module provides functions for creating, manipulating, and managing
- * JSON data structures including objects, arrays, and primitive values.
+ * JSON data structures including objects, arrays, and primitive values. Values live either on
+ * the heap (json_create_*, freed node by node with json_free) or in a RogueJsonArena
+ * (json_arena_*, json_parse with an arena), where a whole document is one chunked bump
+ * allocation released at once. Arrays and objects grow geometrically; objects past
+ * JSON_OBJECT_INDEX_MIN members keep an open-addressing hash index for key lookup.
  */
 
 #include "json_parser.h"
+#include "json_tok.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
-/* Windows compatibility for strdup */
-#ifdef _WIN32
-#define strdup _strdup
-#endif
+/* ===== Arena ===== */
 
-/* ===== JSON Value Creation Functions ===== */
+#define JSON_ARENA_ALIGN 16u
+#define JSON_ARENA_DEFAULT_CHUNK (64u * 1024u)
+
+typedef struct JsonArenaChunk
+{
+    struct JsonArenaChunk* next;
+    size_t cap;
+    size_t used;
+} JsonArenaChunk;
+
+/* Chunk payload starts after the header, rounded up to the arena alignment. */
+#define JSON_ARENA_HDR                                                                             \
+    ((sizeof(JsonArenaChunk) + (JSON_ARENA_ALIGN - 1)) & ~(size_t) (JSON_ARENA_ALIGN - 1))
+
+struct RogueJsonArena
+{
+    JsonArenaChunk* head; /* chunk currently being filled */
+    size_t chunk_size;
+    size_t bytes_used;
+};
 
 /**
- * @brief Creates a JSON null value.
- * @return Pointer to the new JSON value, or NULL on allocation failure.
- * @details Allocates and initializes a new JSON value of type null.
+ * @brief Creates an empty arena.
+ * @param chunk_size Bytes per chunk (0 selects 64 KiB).
+ * @return The arena, or NULL on allocation failure.
  */
-RogueJsonValue* json_create_null(void)
+RogueJsonArena* json_arena_create(size_t chunk_size)
 {
-    RogueJsonValue* json = calloc(1, sizeof(RogueJsonValue));
-    if (!json)
+    RogueJsonArena* arena = calloc(1, sizeof(RogueJsonArena));
+    if (!arena)
         return NULL;
+    arena->chunk_size = chunk_size ? chunk_size : JSON_ARENA_DEFAULT_CHUNK;
+    return arena;
+}
 
-    json->type = JSON_NULL;
-    return json;
+/**
+ * @brief Releases an arena and every value allocated from it.
+ * @param arena The arena (NULL is ignored).
+ * @details Cost is one free per chunk, independent of the number of nodes.
+ */
+void json_arena_destroy(RogueJsonArena* arena)
+{
+    if (!arena)
+        return;
+    JsonArenaChunk* c = arena->head;
+    while (c)
+    {
+        JsonArenaChunk* next = c->next;
+        free(c);
+        c = next;
+    }
+    free(arena);
 }
 
 /**
- * @brief Creates a JSON boolean value.
- * @param value The boolean value to store.
- * @return Pointer to the new JSON value, or NULL on allocation failure.
- * @details Allocates and initializes a new JSON value with the specified boolean value.
+ * @brief Drops every value in the arena while keeping one regular chunk for reuse.
+ * @param arena The arena (NULL is ignored).
+ */
+void json_arena_reset(RogueJsonArena* arena)
+{
+    if (!arena)
+        return;
+    JsonArenaChunk* keep = NULL;
+    JsonArenaChunk* c = arena->head;
+    while (c)
+    {
+        JsonArenaChunk* next = c->next;
+        if (!keep && c->cap == arena->chunk_size)
+            keep = c;
+        else
+            free(c);
+        c = next;
+    }
+    if (keep)
+    {
+        keep->next = NULL;
+        keep->used = 0;
+    }
+    arena->head = keep;
+    arena->bytes_used = 0;
+}
+
+/**
+ * @brief Returns the bytes handed out by the arena since creation or the last reset.
+ * @param arena The arena.
+ * @return Allocated bytes (after alignment), 0 for NULL.
  */
-RogueJsonValue* json_create_boolean(bool value)
+size_t json_arena_bytes_used(const RogueJsonArena* arena) { return arena ? arena->bytes_used : 0; }
+
+static void* arena_alloc(RogueJsonArena* arena, size_t n)
+{
+    n = (n + (JSON_ARENA_ALIGN - 1)) & ~(size_t) (JSON_ARENA_ALIGN - 1);
+    JsonArenaChunk* c = arena->head;
+    if (!c || c->cap - c->used < n)
+    {
+        size_t cap = n > arena->chunk_size ? n : arena->chunk_size;
+        JsonArenaChunk* fresh = malloc(JSON_ARENA_HDR + cap);
+        if (!fresh)
+            return NULL;
+        fresh->cap = cap;
+        fresh->used = 0;
+        if (c && cap > arena->chunk_size)
+        { /* oversized block: keep filling the current chunk afterwards */
+            fresh->next = c->next;
+            c->next = fresh;
+        }
+        else
+        {
+            fresh->next = c;
+            arena->head = fresh;
+        }
+        c = fresh;
+    }
+    void* p = (char*) c + JSON_ARENA_HDR + c->used;
+    c->used += n;
+    arena->bytes_used += n;
+    return p;
+}
+
+/* Allocation helpers: arena when given, heap otherwise. */
+static void* jp_alloc(RogueJsonArena* arena, size_t n)
+{
+    return arena ? arena_alloc(arena, n) : malloc(n);
+}
+
+static void* jp_grow(RogueJsonArena* arena, void* old, size_t old_n, size_t new_n)
+{
+    if (!arena)
+        return realloc(old, new_n);
+    void* p = arena_alloc(arena, new_n);
+    if (p && old_n)
+        memcpy(p, old, old_n);
+    return p; /* the old block stays in the arena until it is reset */
+}
+
+static void jp_release(RogueJsonArena* arena, void* p)
+{
+    if (!arena)
+        free(p);
+}
+
+static char* jp_strdup(RogueJsonArena* arena, const char* s)
 {
-    RogueJsonValue* json = calloc(1, sizeof(RogueJsonValue));
+    size_t n = strlen(s) + 1;
+    char* d = jp_alloc(arena, n);
+    if (d)
+        memcpy(d, s, n);
+    return d;
+}
+
+/* ===== JSON Value Creation Functions ===== */
+
+static RogueJsonValue* new_value(RogueJsonArena* arena, JsonType type)
+{
+    RogueJsonValue* json = jp_alloc(arena, sizeof(RogueJsonValue));
     if (!json)
         return NULL;
-
-    json->type = JSON_BOOLEAN;
-    json->data.boolean_value = value;
+    memset(json, 0, sizeof *json);
+    json->type = type;
+    json->arena = arena;
     return json;
 }
 
 /**
- * @brief Creates a JSON integer value.
- * @param value The integer value to store.
+ * @brief Creates a JSON null value in an arena.
+ * @param arena Owning arena, or NULL for a heap value.
  * @return Pointer to the new JSON value, or NULL on allocation failure.
- * @details Allocates and initializes a new JSON value with the specified 64-bit integer value.
  */
-RogueJsonValue* json_create_integer(int64_t value)
-{
-    RogueJsonValue* json = calloc(1, sizeof(RogueJsonValue));
-    if (!json)
-        return NULL;
+RogueJsonValue* json_arena_null(RogueJsonArena* arena) { return new_value(arena, JSON_NULL); }
 
-    json->type = JSON_INTEGER;
-    json->data.integer_value = value;
+/**
+ * @brief Creates a JSON boolean value in an arena.
+ * @param arena Owning arena, or NULL for a heap value.
+ * @param value The boolean value to store.
+ * @return Pointer to the new JSON value, or NULL on allocation failure.
+ */
+RogueJsonValue* json_arena_boolean(RogueJsonArena* arena, bool value)
+{
+    RogueJsonValue* json = new_value(arena, JSON_BOOLEAN);
+    if (json)
+        json->data.boolean_value = value;
     return json;
 }
 
 /**
- * @brief Creates a JSON number (floating point) value.
- * @param value The number value to store.
+ * @brief Creates a JSON integer value in an arena.
+ * @param arena Owning arena, or NULL for a heap value.
+ * @param value The 64-bit integer value to store.
  * @return Pointer to the new JSON value, or NULL on allocation failure.
- * @details Allocates and initializes a new JSON value with the specified double-precision value.
  */
-RogueJsonValue* json_create_number(double value)
+RogueJsonValue* json_arena_integer(RogueJsonArena* arena, int64_t value)
 {
-    RogueJsonValue* json = calloc(1, sizeof(RogueJsonValue));
-    if (!json)
-        return NULL;
-
-    json->type = JSON_NUMBER;
-    json->data.number_value = value;
+    RogueJsonValue* json = new_value(arena, JSON_INTEGER);
+    if (json)
+        json->data.integer_value = value;
     return json;
 }
 
 /**
- * @brief Creates a JSON string value.
- * @param value The string value to store (will be duplicated).
+ * @brief Creates a JSON number (floating point) value in an arena.
+ * @param arena Owning arena, or NULL for a heap value.
+ * @param value The double-precision value to store.
  * @return Pointer to the new JSON value, or NULL on allocation failure.
- * @details Allocates and initializes a new JSON value with a copy of the specified string.
  */
-RogueJsonValue* json_create_string(const char* value)
+RogueJsonValue* json_arena_number(RogueJsonArena* arena, double value)
+{
+    RogueJsonValue* json = new_value(arena, JSON_NUMBER);
+    if (json)
+        json->data.number_value = value;
+    return json;
+}
+
+/**
+ * @brief Creates a JSON string value in an arena.
+ * @param arena Owning arena, or NULL for a heap value.
+ * @param value The string value to store (copied into the arena / heap).
+ * @return Pointer to the new JSON value, or NULL on allocation failure or NULL value.
+ */
+RogueJsonValue* json_arena_string(RogueJsonArena* arena, const char* value)
 {
     if (!value)
         return NULL;
-
-    RogueJsonValue* json = calloc(1, sizeof(RogueJsonValue));
+    RogueJsonValue* json = new_value(arena, JSON_STRING);
     if (!json)
         return NULL;
-
-    json->type = JSON_STRING;
-    json->data.string_value = strdup(value);
+    json->data.string_value = jp_strdup(arena, value);
     if (!json->data.string_value)
     {
-        free(json);
+        jp_release(arena, json);
         return NULL;
     }
-
     return json;
 }
 
+/**
+ * @brief Creates an empty JSON array in an arena.
+ * @param arena Owning arena, or NULL for a heap value.
+ * @return Pointer to the new JSON array, or NULL on allocation failure.
+ */
+RogueJsonValue* json_arena_array(RogueJsonArena* arena) { return new_value(arena, JSON_ARRAY); }
+
+/**
+ * @brief Creates an empty JSON object in an arena.
+ * @param arena Owning arena, or NULL for a heap value.
+ * @return Pointer to the new JSON object, or NULL on allocation failure.
+ */
+RogueJsonValue* json_arena_object(RogueJsonArena* arena) { return new_value(arena, JSON_OBJECT); }
+
+/**
+ * @brief Creates a JSON null value.
+ * @return Pointer to the new JSON value, or NULL on allocation failure.
+ * @details Allocates and initializes a new JSON value of type null.
+ */
+RogueJsonValue* json_create_null(void) { return json_arena_null(NULL); }
+
+/**
+ * @brief Creates a JSON boolean value.
+ * @param value The boolean value to store.
+ * @return Pointer to the new JSON value, or NULL on allocation failure.
+ * @details Allocates and initializes a new JSON value with the specified boolean value.
+ */
+RogueJsonValue* json_create_boolean(bool value) { return json_arena_boolean(NULL, value); }
+
+/**
+ * @brief Creates a JSON integer value.
+ * @param value The integer value to store.
+ * @return Pointer to the new JSON value, or NULL on allocation failure.
+ * @details Allocates and initializes a new JSON value with the specified 64-bit integer value.
+ */
+RogueJsonValue* json_create_integer(int64_t value) { return json_arena_integer(NULL, value); }
+
+/**
+ * @brief Creates a JSON number (floating point) value.
+ * @param value The number value to store.
+ * @return Pointer to the new JSON value, or NULL on allocation failure.
+ * @details Allocates and initializes a new JSON value with the specified double-precision value.
+ */
+RogueJsonValue* json_create_number(double value) { return json_arena_number(NULL, value); }
+
+/**
+ * @brief Creates a JSON string value.
+ * @param value The string value to store (will be duplicated).
+ * @return Pointer to the new JSON value, or NULL on allocation failure.
+ * @details Allocates and initializes a new JSON value with a copy of the specified string.
+ */
+RogueJsonValue* json_create_string(const char* value) { return json_arena_string(NULL, value); }
+
 /**
  * @brief Creates an empty JSON array.
  * @return Pointer to the new JSON array, or NULL on allocation failure.
  * @details Allocates and initializes a new empty JSON array value.
  */
-RogueJsonValue* json_create_array(void)
-{
-    RogueJsonValue* json = calloc(1, sizeof(RogueJsonValue));
-    if (!json)
-        return NULL;
-
-    json->type = JSON_ARRAY;
-    json->data.array_value.items = NULL;
-    json->data.array_value.count = 0;
-    return json;
-}
+RogueJsonValue* json_create_array(void) { return json_arena_array(NULL); }
 
 /**
  * @brief Creates an empty JSON object.
  * @return Pointer to the new JSON object, or NULL on allocation failure.
  * @details Allocates and initializes a new empty JSON object value.
  */
-RogueJsonValue* json_create_object(void)
+RogueJsonValue* json_create_object(void) { return json_arena_object(NULL); }
+
+/* ===== Object key index ===== */
+
+static uint32_t key_hash(const char* key)
 {
-    RogueJsonValue* json = calloc(1, sizeof(RogueJsonValue));
-    if (!json)
-        return NULL;
+    uint32_t h = 2166136261u;
+    for (const unsigned char* p = (const unsigned char*) key; *p; ++p)
+        h = (h ^ *p) * 16777619u;
+    return h;
+}
 
-    json->type = JSON_OBJECT;
-    json->data.object_value.keys = NULL;
-    json->data.object_value.values = NULL;
-    json->data.object_value.count = 0;
-    return json;
+static void index_insert(JsonObject* obj, size_t entry)
+{
+    size_t mask = obj->index_cap - 1;
+    size_t i = key_hash(obj->keys[entry]) & mask;
+    while (obj->index[i])
+        i = (i + 1) & mask;
+    obj->index[i] = (uint32_t) (entry + 1);
+}
+
+/* (Re)build the index with room for at least twice the member count. */
+static bool index_rebuild(RogueJsonArena* arena, JsonObject* obj)
+{
+    size_t cap = obj->index_cap ? obj->index_cap : 32;
+    while (cap < obj->count * 2)
+        cap *= 2;
+    uint32_t* index = jp_alloc(arena, cap * sizeof(uint32_t));
+    if (!index)
+        return false;
+    memset(index, 0, cap * sizeof(uint32_t));
+    jp_release(arena, obj->index);
+    obj->index = index;
+    obj->index_cap = cap;
+    for (size_t e = 0; e < obj->count; e++)
+        index_insert(obj, e);
+    return true;
+}
+
+static long object_find(const JsonObject* obj, const char* key)
+{
+    if (obj->index)
+    {
+        size_t mask = obj->index_cap - 1;
+        for (size_t i = key_hash(key) & mask; obj->index[i]; i = (i + 1) & mask)
+        {
+            uint32_t e = obj->index[i] - 1;
+            if (strcmp(obj->keys[e], key) == 0)
+                return (long) e;
+        }
+        return -1;
+    }
+    for (size_t i = 0; i < obj->count; i++)
+        if (strcmp(obj->keys[i], key) == 0)
+            return (long) i;
+    return -1;
 }
 
 /* ===== JSON Manipulation Functions ===== */
@@ -152,26 +382,29 @@ RogueJsonValue* json_create_object(void)
  * @param item Pointer to the JSON value to add.
  * @return true on success, false on failure.
  * @details Appends the item to the end of the array. The array takes ownership of the item.
+ * Storage doubles when full. The item must come from the same arena as the array (or both from
+ * the heap).
  */
 bool json_array_add(RogueJsonValue* array, RogueJsonValue* item)
 {
-    if (!array || array->type != JSON_ARRAY || !item)
+    if (!array || array->type != JSON_ARRAY || !item || item->arena != array->arena)
     {
         return false;
     }
 
-    size_t new_count = array->data.array_value.count + 1;
-    RogueJsonValue** new_items =
-        realloc(array->data.array_value.items, new_count * sizeof(RogueJsonValue*));
-    if (!new_items)
+    JsonArray* arr = &array->data.array_value;
+    if (arr->count == arr->capacity)
     {
-        return false;
+        size_t cap = arr->capacity ? arr->capacity * 2 : 4;
+        RogueJsonValue** items = jp_grow(array->arena, arr->items,
+                                         arr->count * sizeof(RogueJsonValue*),
+                                         cap * sizeof(RogueJsonValue*));
+        if (!items)
+            return false;
+        arr->items = items;
+        arr->capacity = cap;
     }
-
-    new_items[new_count - 1] = item;
-    array->data.array_value.items = new_items;
-    array->data.array_value.count = new_count;
-
+    arr->items[arr->count++] = item;
     return true;
 }
 
@@ -182,56 +415,65 @@ bool json_array_add(RogueJsonValue* array, RogueJsonValue* item)
  * @param value Pointer to the JSON value to set.
  * @return true on success, false on failure.
  * @details If the key already exists, replaces the value. Otherwise adds a new key-value pair.
- * The object takes ownership of both the key and value.
+ * The object takes ownership of the value; the value must come from the same arena as the
+ * object (or both from the heap).
  */
 bool json_object_set(RogueJsonValue* object, const char* key, RogueJsonValue* value)
 {
-    if (!object || object->type != JSON_OBJECT || !key || !value)
+    if (!object || object->type != JSON_OBJECT || !key || !value ||
+        value->arena != object->arena)
     {
         return false;
     }
 
-    /* Check if key already exists */
-    for (size_t i = 0; i < object->data.object_value.count; i++)
+    JsonObject* obj = &object->data.object_value;
+    RogueJsonArena* arena = object->arena;
+    long existing = object_find(obj, key);
+    if (existing >= 0)
     {
-        if (strcmp(object->data.object_value.keys[i], key) == 0)
-        {
-            /* Replace existing value */
-            json_free(object->data.object_value.values[i]);
-            object->data.object_value.values[i] = value;
-            return true;
-        }
+        /* Replace existing value */
+        json_free(obj->values[existing]);
+        obj->values[existing] = value;
+        return true;
     }
 
-    /* Add new key-value pair */
-    size_t new_count = object->data.object_value.count + 1;
-
-    char** new_keys = realloc(object->data.object_value.keys, new_count * sizeof(char*));
-    if (!new_keys)
-        return false;
-
-    RogueJsonValue** new_values =
-        realloc(object->data.object_value.values, new_count * sizeof(RogueJsonValue*));
-    if (!new_values)
+    if (obj->count == obj->capacity)
     {
-        free(new_keys);
-        return false;
+        size_t cap = obj->capacity ? obj->capacity * 2 : 4;
+        char** keys = jp_grow(arena, obj->keys, obj->count * sizeof(char*), cap * sizeof(char*));
+        if (!keys)
+            return false;
+        obj->keys = keys;
+        RogueJsonValue** values =
+            jp_grow(arena, obj->values, obj->count * sizeof(RogueJsonValue*),
+                    cap * sizeof(RogueJsonValue*));
+        if (!values)
+            return false;
+        obj->values = values;
+        obj->capacity = cap;
     }
 
-    new_keys[new_count - 1] = strdup(key);
-    if (!new_keys[new_count - 1])
-    {
-        free(new_keys);
-        free(new_values);
+    char* dup = jp_strdup(arena, key);
+    if (!dup)
         return false;
-    }
-
-    new_values[new_count - 1] = value;
-
-    object->data.object_value.keys = new_keys;
-    object->data.object_value.values = new_values;
-    object->data.object_value.count = new_count;
+    obj->keys[obj->count] = dup;
+    obj->values[obj->count] = value;
+    obj->count++;
 
+    if (obj->count > JSON_OBJECT_INDEX_MIN)
+    {
+        if (obj->index_cap < obj->count * 2)
+        {
+            if (!index_rebuild(arena, obj))
+            {
+                obj->count--;
+                jp_release(arena, dup);
+                return false;
+            }
+        }
+        else
+            index_insert(obj, obj->count - 1);
+    }
     return true;
 }
 
@@ -240,7 +482,8 @@ bool json_object_set(RogueJsonValue* object, const char* key, RogueJsonValue* va
  * @param object Pointer to the JSON object value.
  * @param key The key to look up.
  * @return Pointer to the JSON value, or NULL if not found.
- * @details Returns the value associated with the key, or NULL if the key doesn't exist.
+ * @details Returns the value associated with the key, or NULL if the key doesn't exist. Uses
+ * the hash index once the object has more than JSON_OBJECT_INDEX_MIN members.
  */
 RogueJsonValue* json_object_get(const RogueJsonValue* object, const char* key)
 {
@@ -249,15 +492,8 @@ RogueJsonValue* json_object_get(const RogueJsonValue* object, const char* key)
         return NULL;
     }
 
-    for (size_t i = 0; i < object->data.object_value.count; i++)
-    {
-        if (strcmp(object->data.object_value.keys[i], key) == 0)
-        {
-            return object->data.object_value.values[i];
-        }
-    }
-
-    return NULL;
+    long i = object_find(&object->data.object_value, key);
+    return i >= 0 ? object->data.object_value.values[i] : NULL;
 }
 
 /**
@@ -278,11 +514,11 @@ bool json_object_has_key(const RogueJsonValue* object, const char* key)
  * @brief Frees a JSON value and all its associated memory.
  * @param json Pointer to the JSON value to free.
  * @details Recursively frees all nested JSON values, strings, and arrays/objects.
- * Safe to call with NULL.
+ * Safe to call with NULL. Arena values are left alone; they go with their arena.
  */
 void json_free(RogueJsonValue* json)
 {
-    if (!json)
+    if (!json || json->arena)
         return;
 
     switch (json->type)
@@ -307,6 +543,7 @@ void json_free(RogueJsonValue* json)
         }
         free(json->data.object_value.keys);
         free(json->data.object_value.values);
+        free(json->data.object_value.index);
         break;
 
     default:
@@ -317,6 +554,154 @@ void json_free(RogueJsonValue* json)
     free(json);
 }
 
+/* ===== Parsing ===== */
+
+static RogueJsonValue* parse_value(RogueJsonTokenizer* t, const RogueJsonToken* tok,
+                                   RogueJsonArena* arena);
+
+static RogueJsonValue* parse_number(const RogueJsonToken* tok, RogueJsonArena* arena)
+{
+    const char* s = tok->text.ptr;
+    size_t n = tok->text.len;
+    size_t digits = n - (s[0] == '-');
+    if (digits <= 18 && !memchr(s, '.', n) && !memchr(s, 'e', n) && !memchr(s, 'E', n))
+    {
+        int64_t v = 0;
+        for (size_t i = s[0] == '-'; i < n; i++)
+            v = v * 10 + (s[i] - '0');
+        return json_arena_integer(arena, s[0] == '-' ? -v : v);
+    }
+    double d = 0.0;
+    rogue_json_tok_double(tok, &d);
+    return json_arena_number(arena, d);
+}
+
+/* Decoded string / key text (never longer than the raw token) in a heap or arena buffer. */
+static char* decode_text(const RogueJsonToken* tok, RogueJsonArena* arena)
+{
+    char* s = jp_alloc(arena, tok->text.len + 1);
+    if (s)
+        rogue_json_tok_copy(tok, s, tok->text.len + 1);
+    return s;
+}
+
+static RogueJsonValue* parse_container(RogueJsonTokenizer* t, const RogueJsonToken* tok,
+                                       RogueJsonArena* arena)
+{
+    RogueJsonValue* json =
+        tok->type == ROGUE_JTOK_OBJECT_BEGIN ? json_arena_object(arena) : json_arena_array(arena);
+    if (!json)
+        return NULL;
+    RogueJsonToken v;
+    int r;
+    if (tok->type == ROGUE_JTOK_ARRAY_BEGIN)
+    {
+        while ((r = rogue_json_tok_element(t, &v)) > 0)
+        {
+            RogueJsonValue* item = parse_value(t, &v, arena);
+            if (!item || !json_array_add(json, item))
+            {
+                json_free(item);
+                json_free(json);
+                return NULL;
+            }
+        }
+    }
+    else
+    {
+        RogueJsonToken key_tok;
+        while ((r = rogue_json_tok_next(t, &key_tok)) == ROGUE_JTOK_KEY)
+        {
+            char local[128];
+            char* key = key_tok.text.len < sizeof local ? local : malloc(key_tok.text.len + 1);
+            if (key)
+                rogue_json_tok_copy(&key_tok, key, key_tok.text.len + 1);
+            RogueJsonValue* item = NULL;
+            if (key && rogue_json_tok_next(t, &v) > ROGUE_JTOK_END)
+                item = parse_value(t, &v, arena);
+            bool ok = item && json_object_set(json, key, item);
+            if (key != local)
+                free(key);
+            if (!ok)
+            {
+                json_free(item);
+                json_free(json);
+                return NULL;
+            }
+        }
+        r = r == ROGUE_JTOK_OBJECT_END ? 0 : -1;
+    }
+    if (r < 0)
+    {
+        json_free(json);
+        return NULL;
+    }
+    return json;
+}
+
+static RogueJsonValue* parse_value(RogueJsonTokenizer* t, const RogueJsonToken* tok,
+                                   RogueJsonArena* arena)
+{
+    switch (tok->type)
+    {
+    case ROGUE_JTOK_OBJECT_BEGIN:
+    case ROGUE_JTOK_ARRAY_BEGIN:
+        return parse_container(t, tok, arena);
+    case ROGUE_JTOK_STRING:
+    {
+        RogueJsonValue* json = new_value(arena, JSON_STRING);
+        if (!json)
+            return NULL;
+        json->data.string_value = decode_text(tok, arena);
+        if (!json->data.string_value)
+        {
+            jp_release(arena, json);
+            return NULL;
+        }
+        return json;
+    }
+    case ROGUE_JTOK_NUMBER:
+        return parse_number(tok, arena);
+    case ROGUE_JTOK_TRUE:
+    case ROGUE_JTOK_FALSE:
+        return json_arena_boolean(arena, tok->type == ROGUE_JTOK_TRUE);
+    case ROGUE_JTOK_NULL:
+        return json_arena_null(arena);
+    default:
+        return NULL;
+    }
+}
+
+/**
+ * @brief Parses JSON text into a value tree.
+ * @param text JSON text (need not be NUL terminated).
+ * @param len Length of text in bytes.
+ * @param arena Arena receiving the whole document, or NULL for heap values.
+ * @param err_pos Optional; receives the byte offset of the first error.
+ * @return The root value, or NULL on invalid input or allocation failure.
+ * @details Validation follows util/json_tok. Duplicate keys keep the last value. Heap results
+ * are released with json_free; arena results with the arena.
+ */
+RogueJsonValue* json_parse(const char* text, size_t len, RogueJsonArena* arena, size_t* err_pos)
+{
+    if (!text)
+        return NULL;
+    RogueJsonTokenizer t;
+    RogueJsonToken tok;
+    rogue_json_tok_init(&t, text, len);
+    RogueJsonValue* root = NULL;
+    if (rogue_json_tok_next(&t, &tok) > ROGUE_JTOK_END)
+        root = parse_value(&t, &tok, arena);
+    if (root && rogue_json_tok_next(&t, &tok) != ROGUE_JTOK_END)
+    {
+        json_free(root);
+        root = NULL;
+    }
+    if (!root && err_pos)
+        *err_pos = t.error ? t.error_pos : t.pos;
+    return root;
+}
+
 /* ===== Utility Functions ===== */
 
 /**
@@ -24,22 +24,36 @@ extern "C"
 
     typedef struct RogueJsonValue RogueJsonValue;
 
+    /* Arena allocation mode: every node, key, string and growth buffer of a document comes from
+     * one chunked bump allocator and the whole document is released with json_arena_destroy
+     * (json_free on arena values is a no-op). Containers only accept children from their own
+     * arena (or, for heap containers, heap children). */
+    typedef struct RogueJsonArena RogueJsonArena;
+
+/* Objects with more members than this get an open-addressing hash index for key lookup. */
+#define JSON_OBJECT_INDEX_MIN 8
+
     typedef struct
     {
         char** keys;
         RogueJsonValue** values;
         size_t count;
+        size_t capacity;  /* keys / values grow geometrically */
+        uint32_t* index;  /* hash slots holding entry + 1 (0 = empty), NULL while small */
+        size_t index_cap; /* power of two, at least twice count */
     } JsonObject;
 
     typedef struct
     {
         RogueJsonValue** items;
         size_t count;
+        size_t capacity;
     } JsonArray;
 
     struct RogueJsonValue
     {
         JsonType type;
+        RogueJsonArena* arena; /* owning arena, NULL for heap values */
         union
         {
             bool boolean_value;
@@ -72,6 +86,27 @@ extern "C"
     /* Utility functions */
     const char* json_type_to_string(JsonType type);
 
+    /* Arena mode. chunk_size 0 picks a default; allocations larger than a chunk get their own. */
+    RogueJsonArena* json_arena_create(size_t chunk_size);
+    void json_arena_destroy(RogueJsonArena* arena);
+    void json_arena_reset(RogueJsonArena* arena); /* drop all documents, keep the first chunk */
+    size_t json_arena_bytes_used(const RogueJsonArena* arena);
+
+    RogueJsonValue* json_arena_null(RogueJsonArena* arena);
+    RogueJsonValue* json_arena_boolean(RogueJsonArena* arena, bool value);
+    RogueJsonValue* json_arena_integer(RogueJsonArena* arena, int64_t value);
+    RogueJsonValue* json_arena_number(RogueJsonArena* arena, double value);
+    RogueJsonValue* json_arena_string(RogueJsonArena* arena, const char* value);
+    RogueJsonValue* json_arena_array(RogueJsonArena* arena);
+    RogueJsonValue* json_arena_object(RogueJsonArena* arena);
+
+    /* Parse JSON text (util/json_tok grammar) into a tree, in `arena` when given, else on the
+     * heap (release with json_free). Integral numbers that fit int64 become JSON_INTEGER. Returns
+     * NULL on invalid input or allocation failure, with *err_pos (optional) at the offending
+     * byte. */
+    RogueJsonValue* json_parse(const char* text, size_t len, RogueJsonArena* arena,
+                               size_t* err_pos);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,519 @@
+/**
+ * @file json_tok.c
+ * @brief Zero-copy validating pull tokenizer for JSON content files.
+ * @details See json_tok.h. The tokenizer is a small state machine over the separators (what may
+ * follow the previous token) plus a bracket stack; string bodies and numbers are scanned once
+ * in place and handed out as views. Decoding of escapes and number conversion only happen on
+ * request, for the tokens a loader actually keeps.
+ */
+
+#include "json_tok.h"
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+enum
+{
+    ST_VALUE,        /* root, after ':' or after ',' in an array */
+    ST_VALUE_OR_END, /* after '[' */
+    ST_KEY_OR_END,   /* after '{' */
+    ST_KEY,          /* after ',' in an object */
+    ST_AFTER,        /* after a value inside a container: ',' or the closing bracket */
+    ST_DONE          /* root value complete */
+};
+
+void rogue_json_tok_init(RogueJsonTokenizer* t, const char* src, size_t len)
+{
+    memset(t, 0, sizeof *t);
+    t->src = src ? src : "";
+    t->len = src ? len : 0;
+    t->state = ST_VALUE;
+}
+
+static RogueJsonTokType fail(RogueJsonTokenizer* t, RogueJsonToken* tok, const char* msg)
+{
+    if (!t->error)
+    {
+        t->error = msg;
+        t->error_pos = t->pos;
+    }
+    tok->type = ROGUE_JTOK_ERROR;
+    tok->text.ptr = t->src + t->error_pos;
+    tok->text.len = 0;
+    return ROGUE_JTOK_ERROR;
+}
+
+static void skip_ws(RogueJsonTokenizer* t)
+{
+    const char* s = t->src;
+    size_t p = t->pos, n = t->len;
+    while (p < n && (s[p] == ' ' || s[p] == '\n' || s[p] == '\r' || s[p] == '\t'))
+        p++;
+    t->pos = p;
+}
+
+static int is_hex(char c)
+{
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+/* t->pos at the opening quote; leaves it past the closing quote. */
+static RogueJsonTokType scan_string(RogueJsonTokenizer* t, RogueJsonToken* tok,
+                                    RogueJsonTokType type)
+{
+    const char* s = t->src;
+    size_t n = t->len;
+    size_t p = ++t->pos;
+    int escaped = 0;
+    for (;;)
+    {
+        while (p < n && s[p] != '"' && s[p] != '\\' && (unsigned char) s[p] >= 0x20)
+            p++;
+        if (p >= n)
+        {
+            t->pos = p;
+            return fail(t, tok, "unterminated string");
+        }
+        if (s[p] == '"')
+            break;
+        if (s[p] != '\\')
+        {
+            t->pos = p;
+            return fail(t, tok, "control character in string");
+        }
+        escaped = 1;
+        if (++p >= n)
+        {
+            t->pos = p;
+            return fail(t, tok, "unterminated string");
+        }
+        switch (s[p])
+        {
+        case '"':
+        case '\\':
+        case '/':
+        case 'b':
+        case 'f':
+        case 'n':
+        case 'r':
+        case 't':
+            p++;
+            break;
+        case 'u':
+            if (p + 4 >= n || !is_hex(s[p + 1]) || !is_hex(s[p + 2]) || !is_hex(s[p + 3]) ||
+                !is_hex(s[p + 4]))
+            {
+                t->pos = p;
+                return fail(t, tok, "bad \\u escape");
+            }
+            p += 5;
+            break;
+        default:
+            t->pos = p;
+            return fail(t, tok, "bad escape");
+        }
+    }
+    tok->type = type;
+    tok->text.ptr = s + t->pos;
+    tok->text.len = p - t->pos;
+    tok->escaped = escaped;
+    t->pos = p + 1;
+    return type;
+}
+
+static int scan_digits(RogueJsonTokenizer* t)
+{
+    size_t start = t->pos;
+    while (t->pos < t->len && t->src[t->pos] >= '0' && t->src[t->pos] <= '9')
+        t->pos++;
+    return t->pos > start;
+}
+
+static RogueJsonTokType scan_number(RogueJsonTokenizer* t, RogueJsonToken* tok)
+{
+    const char* s = t->src;
+    size_t start = t->pos;
+    if (s[t->pos] == '-')
+        t->pos++;
+    if (t->pos < t->len && s[t->pos] == '0')
+        t->pos++;
+    else if (!scan_digits(t))
+        return fail(t, tok, "bad number");
+    if (t->pos < t->len && s[t->pos] == '.')
+    {
+        t->pos++;
+        if (!scan_digits(t))
+            return fail(t, tok, "bad number fraction");
+    }
+    if (t->pos < t->len && (s[t->pos] == 'e' || s[t->pos] == 'E'))
+    {
+        t->pos++;
+        if (t->pos < t->len && (s[t->pos] == '+' || s[t->pos] == '-'))
+            t->pos++;
+        if (!scan_digits(t))
+            return fail(t, tok, "bad number exponent");
+    }
+    tok->type = ROGUE_JTOK_NUMBER;
+    tok->text.ptr = s + start;
+    tok->text.len = t->pos - start;
+    return ROGUE_JTOK_NUMBER;
+}
+
+static RogueJsonTokType scan_literal(RogueJsonTokenizer* t, RogueJsonToken* tok, const char* lit,
+                                     RogueJsonTokType type)
+{
+    size_t n = strlen(lit);
+    if (t->len - t->pos < n || memcmp(t->src + t->pos, lit, n) != 0)
+        return fail(t, tok, "bad literal");
+    tok->type = type;
+    tok->text.ptr = t->src + t->pos;
+    tok->text.len = n;
+    t->pos += n;
+    return type;
+}
+
+static RogueJsonTokType open_container(RogueJsonTokenizer* t, RogueJsonToken* tok, char c)
+{
+    if (t->depth >= ROGUE_JSON_TOK_MAX_DEPTH)
+        return fail(t, tok, "nesting too deep");
+    tok->type = c == '{' ? ROGUE_JTOK_OBJECT_BEGIN : ROGUE_JTOK_ARRAY_BEGIN;
+    tok->text.ptr = t->src + t->pos;
+    tok->text.len = 1;
+    t->stack[t->depth++] = c;
+    t->pos++;
+    t->state = c == '{' ? ST_KEY_OR_END : ST_VALUE_OR_END;
+    return tok->type;
+}
+
+static RogueJsonTokType close_container(RogueJsonTokenizer* t, RogueJsonToken* tok)
+{
+    char open = t->stack[--t->depth];
+    tok->type = open == '{' ? ROGUE_JTOK_OBJECT_END : ROGUE_JTOK_ARRAY_END;
+    tok->text.ptr = t->src + t->pos;
+    tok->text.len = 1;
+    tok->depth = t->depth;
+    t->pos++;
+    t->state = t->depth ? ST_AFTER : ST_DONE;
+    return tok->type;
+}
+
+static RogueJsonTokType scan_value(RogueJsonTokenizer* t, RogueJsonToken* tok)
+{
+    RogueJsonTokType type;
+    tok->depth = t->depth;
+    switch (t->src[t->pos])
+    {
+    case '{':
+    case '[':
+        return open_container(t, tok, t->src[t->pos]);
+    case '"':
+        type = scan_string(t, tok, ROGUE_JTOK_STRING);
+        break;
+    case 't':
+        type = scan_literal(t, tok, "true", ROGUE_JTOK_TRUE);
+        break;
+    case 'f':
+        type = scan_literal(t, tok, "false", ROGUE_JTOK_FALSE);
+        break;
+    case 'n':
+        type = scan_literal(t, tok, "null", ROGUE_JTOK_NULL);
+        break;
+    default:
+        if (t->src[t->pos] == '-' || (t->src[t->pos] >= '0' && t->src[t->pos] <= '9'))
+            type = scan_number(t, tok);
+        else
+            return fail(t, tok, "unexpected character");
+        break;
+    }
+    if (type != ROGUE_JTOK_ERROR)
+        t->state = t->depth ? ST_AFTER : ST_DONE;
+    return type;
+}
+
+RogueJsonTokType rogue_json_tok_next(RogueJsonTokenizer* t, RogueJsonToken* tok)
+{
+    tok->escaped = 0;
+    tok->depth = t->depth;
+    if (t->error)
+        return fail(t, tok, t->error);
+    skip_ws(t);
+    if (t->state == ST_DONE)
+    {
+        if (t->pos < t->len)
+            return fail(t, tok, "trailing characters after root value");
+        tok->type = ROGUE_JTOK_END;
+        tok->text.ptr = t->src + t->pos;
+        tok->text.len = 0;
+        return ROGUE_JTOK_END;
+    }
+    if (t->pos >= t->len)
+        return fail(t, tok, "unexpected end of input");
+    char c = t->src[t->pos];
+    if (t->state == ST_AFTER)
+    {
+        char open = t->stack[t->depth - 1];
+        if ((c == '}' && open == '{') || (c == ']' && open == '['))
+            return close_container(t, tok);
+        if (c != ',')
+            return fail(t, tok, "expected ',' or closing bracket");
+        t->pos++;
+        skip_ws(t);
+        if (t->pos >= t->len)
+            return fail(t, tok, "unexpected end of input");
+        c = t->src[t->pos];
+        t->state = open == '{' ? ST_KEY : ST_VALUE;
+    }
+    if ((t->state == ST_KEY_OR_END && c == '}') || (t->state == ST_VALUE_OR_END && c == ']'))
+        return close_container(t, tok);
+    if (t->state == ST_KEY || t->state == ST_KEY_OR_END)
+    {
+        if (c != '"')
+            return fail(t, tok, "expected object key");
+        if (scan_string(t, tok, ROGUE_JTOK_KEY) == ROGUE_JTOK_ERROR)
+            return ROGUE_JTOK_ERROR;
+        skip_ws(t);
+        if (t->pos >= t->len || t->src[t->pos] != ':')
+            return fail(t, tok, "expected ':' after key");
+        t->pos++;
+        t->state = ST_VALUE;
+        return ROGUE_JTOK_KEY;
+    }
+    return scan_value(t, tok);
+}
+
+int rogue_json_tok_skip(RogueJsonTokenizer* t, const RogueJsonToken* value)
+{
+    if (value->type == ROGUE_JTOK_ERROR || value->type == ROGUE_JTOK_END)
+        return -1;
+    if (value->type != ROGUE_JTOK_OBJECT_BEGIN && value->type != ROGUE_JTOK_ARRAY_BEGIN)
+        return 0;
+    RogueJsonToken tok;
+    for (;;)
+    {
+        RogueJsonTokType type = rogue_json_tok_next(t, &tok);
+        if (type == ROGUE_JTOK_ERROR || type == ROGUE_JTOK_END)
+            return -1;
+        if ((type == ROGUE_JTOK_OBJECT_END || type == ROGUE_JTOK_ARRAY_END) &&
+            tok.depth == value->depth)
+            return 0;
+    }
+}
+
+static int is_value_start(RogueJsonTokType type)
+{
+    return type >= ROGUE_JTOK_OBJECT_BEGIN && type != ROGUE_JTOK_OBJECT_END &&
+           type != ROGUE_JTOK_ARRAY_END && type != ROGUE_JTOK_KEY;
+}
+
+int rogue_json_tok_member(RogueJsonTokenizer* t, RogueJsonView* key, RogueJsonToken* value)
+{
+    RogueJsonToken k;
+    RogueJsonTokType type = rogue_json_tok_next(t, &k);
+    if (type == ROGUE_JTOK_OBJECT_END)
+        return 0;
+    if (type != ROGUE_JTOK_KEY)
+        return -1;
+    if (key)
+        *key = k.text;
+    return is_value_start(rogue_json_tok_next(t, value)) ? 1 : -1;
+}
+
+int rogue_json_tok_element(RogueJsonTokenizer* t, RogueJsonToken* value)
+{
+    RogueJsonTokType type = rogue_json_tok_next(t, value);
+    if (type == ROGUE_JTOK_ARRAY_END)
+        return 0;
+    return is_value_start(type) ? 1 : -1;
+}
+
+int rogue_json_validate(const char* src, size_t len, size_t* err_pos)
+{
+    RogueJsonTokenizer t;
+    RogueJsonToken tok;
+    rogue_json_tok_init(&t, src, len);
+    RogueJsonTokType type;
+    do
+        type = rogue_json_tok_next(&t, &tok);
+    while (type != ROGUE_JTOK_END && type != ROGUE_JTOK_ERROR);
+    if (type == ROGUE_JTOK_END)
+        return 0;
+    if (err_pos)
+        *err_pos = t.error_pos;
+    return -1;
+}
+
+int rogue_json_view_eq(RogueJsonView v, const char* s)
+{
+    size_t n = strlen(s);
+    return v.len == n && memcmp(v.ptr, s, n) == 0;
+}
+
+static unsigned hex4(const char* s)
+{
+    unsigned v = 0;
+    for (int i = 0; i < 4; i++)
+    {
+        char c = s[i];
+        v = (v << 4) | (unsigned) (c <= '9' ? c - '0' : (c | 0x20) - 'a' + 10);
+    }
+    return v;
+}
+
+static size_t utf8_encode(unsigned cp, char* out)
+{
+    if (cp < 0x80)
+    {
+        out[0] = (char) cp;
+        return 1;
+    }
+    if (cp < 0x800)
+    {
+        out[0] = (char) (0xC0 | (cp >> 6));
+        out[1] = (char) (0x80 | (cp & 0x3F));
+        return 2;
+    }
+    if (cp < 0x10000)
+    {
+        out[0] = (char) (0xE0 | (cp >> 12));
+        out[1] = (char) (0x80 | ((cp >> 6) & 0x3F));
+        out[2] = (char) (0x80 | (cp & 0x3F));
+        return 3;
+    }
+    out[0] = (char) (0xF0 | (cp >> 18));
+    out[1] = (char) (0x80 | ((cp >> 12) & 0x3F));
+    out[2] = (char) (0x80 | ((cp >> 6) & 0x3F));
+    out[3] = (char) (0x80 | (cp & 0x3F));
+    return 4;
+}
+
+size_t rogue_json_tok_copy(const RogueJsonToken* tok, char* out, size_t cap)
+{
+    if (!out || cap == 0)
+        return 0;
+    const char* s = tok->text.ptr;
+    size_t n = tok->text.len, w = 0;
+    int decode = tok->escaped && (tok->type == ROGUE_JTOK_STRING || tok->type == ROGUE_JTOK_KEY);
+    if (!decode)
+    {
+        w = n < cap - 1 ? n : cap - 1;
+        if (w < n) /* do not cut a UTF-8 sequence */
+            while (w > 0 && ((unsigned char) s[w] & 0xC0) == 0x80)
+                w--;
+        memcpy(out, s, w);
+        out[w] = '\0';
+        return w;
+    }
+    for (size_t i = 0; i < n;)
+    {
+        char buf[4];
+        size_t k = 1;
+        if (s[i] != '\\')
+        {
+            size_t run = i + 1; /* copy a whole UTF-8 sequence or nothing */
+            while (run < n && ((unsigned char) s[run] & 0xC0) == 0x80)
+                run++;
+            if (w + (run - i) > cap - 1)
+                break;
+            memcpy(out + w, s + i, run - i);
+            w += run - i;
+            i = run;
+            continue;
+        }
+        char e = s[i + 1];
+        i += 2;
+        switch (e)
+        {
+        case 'b':
+            buf[0] = '\b';
+            break;
+        case 'f':
+            buf[0] = '\f';
+            break;
+        case 'n':
+            buf[0] = '\n';
+            break;
+        case 'r':
+            buf[0] = '\r';
+            break;
+        case 't':
+            buf[0] = '\t';
+            break;
+        case 'u':
+        {
+            unsigned cp = hex4(s + i);
+            i += 4;
+            if (cp >= 0xD800 && cp <= 0xDBFF && i + 6 <= n && s[i] == '\\' && s[i + 1] == 'u')
+            {
+                unsigned lo = hex4(s + i + 2);
+                if (lo >= 0xDC00 && lo <= 0xDFFF)
+                {
+                    cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+                    i += 6;
+                }
+            }
+            if (cp >= 0xD800 && cp <= 0xDFFF)
+                cp = 0xFFFD; /* lone surrogate */
+            k = utf8_encode(cp, buf);
+            break;
+        }
+        default: /* '"', '\\', '/' */
+            buf[0] = e;
+            break;
+        }
+        if (w + k > cap - 1)
+            break;
+        memcpy(out + w, buf, k);
+        w += k;
+    }
+    out[w] = '\0';
+    return w;
+}
+
+int rogue_json_tok_double(const RogueJsonToken* tok, double* out)
+{
+    if (tok->type == ROGUE_JTOK_TRUE || tok->type == ROGUE_JTOK_FALSE)
+    {
+        *out = tok->type == ROGUE_JTOK_TRUE ? 1.0 : 0.0;
+        return 1;
+    }
+    if (tok->type != ROGUE_JTOK_NUMBER)
+        return 0;
+    char local[64];
+    char* buf = tok->text.len < sizeof local ? local : (char*) malloc(tok->text.len + 1);
+    if (!buf)
+        return 0;
+    memcpy(buf, tok->text.ptr, tok->text.len);
+    buf[tok->text.len] = '\0';
+    *out = strtod(buf, NULL);
+    if (buf != local)
+        free(buf);
+    return 1;
+}
+
+int rogue_json_tok_int(const RogueJsonToken* tok, int* out)
+{
+    if (tok->type == ROGUE_JTOK_TRUE || tok->type == ROGUE_JTOK_FALSE)
+    {
+        *out = tok->type == ROGUE_JTOK_TRUE;
+        return 1;
+    }
+    if (tok->type != ROGUE_JTOK_NUMBER)
+        return 0;
+    const char* s = tok->text.ptr;
+    size_t n = tok->text.len, i = s[0] == '-';
+    long long v = 0;
+    for (; i < n && s[i] >= '0' && s[i] <= '9'; i++)
+        if (v <= INT_MAX)
+            v = v * 10 + (s[i] - '0');
+    if (i < n) /* fraction or exponent: go through the double */
+    {
+        double d;
+        rogue_json_tok_double(tok, &d);
+        *out = d >= (double) INT_MAX ? INT_MAX : d <= (double) INT_MIN ? INT_MIN : (int) d;
+        return 1;
+    }
+    if (s[0] == '-')
+        v = -v;
+    *out = v > INT_MAX ? INT_MAX : v < INT_MIN ? INT_MIN : (int) v;
+    return 1;
+}
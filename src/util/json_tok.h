@@ -0,0 +1,100 @@
+/* Zero-copy streaming JSON tokenizer shared by the content loaders.
+ *
+ * Pull style: rogue_json_tok_next returns one token at a time straight out of the caller's
+ * buffer. Keys, strings and numbers come back as views (pointer + length into the source, string
+ * views without the quotes and with escapes left undecoded); nothing is allocated or copied
+ * unless the caller asks for it with rogue_json_tok_copy.
+ *
+ * The tokenizer validates as it goes (RFC 8259 grammar: string escapes and control characters,
+ * number syntax, literals, separators, bracket matching, a single root value and nothing after
+ * it). The first violation latches ROGUE_JTOK_ERROR with its byte offset; every later call
+ * returns the error again, so loaders can check once after their loop.
+ *
+ * Loaders normally walk a document in one pass with the member / element iterators:
+ *
+ *     RogueJsonTokenizer t;
+ *     RogueJsonToken v;
+ *     RogueJsonView key;
+ *     rogue_json_tok_init(&t, buf, len);
+ *     if (rogue_json_tok_next(&t, &v) != ROGUE_JTOK_OBJECT_BEGIN) ...
+ *     while (rogue_json_tok_member(&t, &key, &v) > 0)
+ *         if (rogue_json_view_eq(key, "duration_ms")) rogue_json_tok_double(&v, &ms);
+ *         else rogue_json_tok_skip(&t, &v);
+ *
+ * A member / element value that opens a container must be walked or skipped before the next
+ * iterator call. */
+#ifndef ROGUE_UTIL_JSON_TOK_H
+#define ROGUE_UTIL_JSON_TOK_H
+
+#include <stddef.h>
+
+#define ROGUE_JSON_TOK_MAX_DEPTH 64
+
+typedef enum RogueJsonTokType
+{
+    ROGUE_JTOK_ERROR = -1,
+    ROGUE_JTOK_END = 0, /* root value complete and only whitespace left */
+    ROGUE_JTOK_OBJECT_BEGIN,
+    ROGUE_JTOK_OBJECT_END,
+    ROGUE_JTOK_ARRAY_BEGIN,
+    ROGUE_JTOK_ARRAY_END,
+    ROGUE_JTOK_KEY,
+    ROGUE_JTOK_STRING,
+    ROGUE_JTOK_NUMBER,
+    ROGUE_JTOK_TRUE,
+    ROGUE_JTOK_FALSE,
+    ROGUE_JTOK_NULL
+} RogueJsonTokType;
+
+typedef struct RogueJsonView
+{
+    const char* ptr;
+    size_t len;
+} RogueJsonView;
+
+typedef struct RogueJsonToken
+{
+    RogueJsonTokType type;
+    RogueJsonView text; /* string / key body without quotes, number or literal text */
+    int escaped;        /* string / key contains backslash escapes */
+    int depth;          /* container depth the token sits at (root value = 0) */
+} RogueJsonToken;
+
+typedef struct RogueJsonTokenizer
+{
+    const char* src;
+    size_t len;
+    size_t pos;
+    int state;
+    int depth;
+    char stack[ROGUE_JSON_TOK_MAX_DEPTH];
+    size_t error_pos;
+    const char* error; /* NULL until the first violation */
+} RogueJsonTokenizer;
+
+void rogue_json_tok_init(RogueJsonTokenizer* t, const char* src, size_t len);
+RogueJsonTokType rogue_json_tok_next(RogueJsonTokenizer* t, RogueJsonToken* tok);
+
+/* Skip the rest of the value whose first token is `value` (no-op for scalars). 0 or -1. */
+int rogue_json_tok_skip(RogueJsonTokenizer* t, const RogueJsonToken* value);
+/* Next member of the current object: 1 with key and the value's first token, 0 at the closing
+ * brace, -1 on error. */
+int rogue_json_tok_member(RogueJsonTokenizer* t, RogueJsonView* key, RogueJsonToken* value);
+/* Next element of the current array: 1 with the element's first token, 0 at the closing
+ * bracket, -1 on error. */
+int rogue_json_tok_element(RogueJsonTokenizer* t, RogueJsonToken* value);
+
+/* Validate a whole document. 0 when valid, else -1 with *err_pos (optional) set. */
+int rogue_json_validate(const char* src, size_t len, size_t* err_pos);
+
+int rogue_json_view_eq(RogueJsonView v, const char* s);
+/* Decode a string / key token (escapes, \u incl. surrogate pairs -> UTF-8) into out, truncated
+ * at a character boundary to cap-1 bytes and NUL terminated. Other tokens copy their raw text.
+ * Returns the bytes written. */
+size_t rogue_json_tok_copy(const RogueJsonToken* tok, char* out, size_t cap);
+/* Number tokens (integers saturate to int range, fractions truncate toward zero); true / false
+ * read as 1 / 0. Return 1 when converted, 0 otherwise (out untouched). */
+int rogue_json_tok_int(const RogueJsonToken* tok, int* out);
+int rogue_json_tok_double(const RogueJsonToken* tok, double* out);
+
+#endif
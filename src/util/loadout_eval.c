@@ -0,0 +1,360 @@
+/**
+ * @file loadout_eval.c
+ * @brief Pure stat evaluation for explicit loadouts (optimizer scoring without equip/unequip).
+ * @details Sums the per-item contributions equipment_stats.c aggregates
+ * (rogue_equip_contrib_gather, rogue_equip_contrib_set_layer) and reproduces the layer/derived
+ * passes of stat_cache.c. Nothing here writes global state.
+ */
+
+#include "loadout_eval.h"
+#include "../core/loot/loot_affixes.h"
+#include "../core/loot/loot_instances.h"
+#include "../core/loot/loot_item_defs.h"
+#include "../core/progression/progression_ratings.h"
+#include <string.h>
+
+/**
+ * @brief Weapon damage term used by the DPS estimate (stat_cache.c weapon_base_damage_estimate).
+ */
+static int weapon_damage(const RogueItemInstance* it)
+{
+    int base = 5 + it->rarity * 4;
+    if (it->prefix_index >= 0)
+    {
+        const RogueAffixDef* a = rogue_affix_at(it->prefix_index);
+        if (a && a->stat == ROGUE_AFFIX_STAT_DAMAGE_FLAT)
+            base += it->prefix_value;
+    }
+    if (it->suffix_index >= 0)
+    {
+        const RogueAffixDef* a = rogue_affix_at(it->suffix_index);
+        if (a && a->stat == ROGUE_AFFIX_STAT_DAMAGE_FLAT)
+            base += it->suffix_value;
+    }
+    return base;
+}
+
+/** @brief Jewelry slots do not contribute definition base armor. */
+static int slot_has_base_armor(enum RogueEquipSlot slot)
+{
+    if (slot < ROGUE_EQUIP_ARMOR_HEAD)
+        return 0;
+    return !(slot == ROGUE_EQUIP_RING1 || slot == ROGUE_EQUIP_RING2 || slot == ROGUE_EQUIP_AMULET ||
+             slot == ROGUE_EQUIP_CHARM1 || slot == ROGUE_EQUIP_CHARM2);
+}
+
+void rogue_loadout_item_contrib(enum RogueEquipSlot slot, int inst_index, RogueLoadoutContrib* out)
+{
+    memset(out, 0, sizeof *out);
+    if (inst_index < 0)
+        return;
+    const RogueItemInstance* it = rogue_item_instance_at(inst_index);
+    if (!it)
+        return;
+    out->occupied = 1;
+    int has_def = rogue_equip_contrib_gather(inst_index, out->v, &out->set_id);
+    if (slot == ROGUE_EQUIP_WEAPON)
+        out->v[ROGUE_LOADOUT_CH_WEAPON_DAMAGE] = weapon_damage(it);
+    const RogueItemDef* d = has_def ? rogue_item_def_at(it->def_index) : NULL;
+    if (d && slot_has_base_armor(slot))
+        out->v[ROGUE_LOADOUT_CH_BASE_ARMOR] = d->base_armor;
+}
+
+void rogue_loadout_base_from_player(const RoguePlayer* p, RogueLoadoutBaseState* out)
+{
+    memset(out, 0, sizeof *out);
+    if (!p)
+        return;
+    const RogueStatCache* c = &g_player_stat_cache;
+    out->strength = p->strength;
+    out->dexterity = p->dexterity;
+    out->vitality = p->vitality;
+    out->intelligence = p->intelligence;
+    /* Same baseline recovery as rogue_stat_cache_force_update: a player holding the last applied
+     * totals maps back to the recorded base. */
+    if (c->recompute_count > 0 && p->strength == c->last_total_strength &&
+        p->dexterity == c->last_total_dexterity && p->vitality == c->last_total_vitality &&
+        p->intelligence == c->last_total_intelligence)
+    {
+        out->strength = c->last_base_strength;
+        out->dexterity = c->last_base_dexterity;
+        out->vitality = c->last_base_vitality;
+        out->intelligence = c->last_base_intelligence;
+    }
+    else if (p->strength == c->total_strength && p->dexterity == c->total_dexterity &&
+             p->vitality == c->total_vitality && p->intelligence == c->total_intelligence)
+    {
+        /* preview player (equip_try path) holds the current totals */
+        out->strength = c->base_strength;
+        out->dexterity = c->base_dexterity;
+        out->vitality = c->base_vitality;
+        out->intelligence = c->base_intelligence;
+    }
+    out->passive_strength = c->passive_strength;
+    out->passive_dexterity = c->passive_dexterity;
+    out->passive_vitality = c->passive_vitality;
+    out->passive_intelligence = c->passive_intelligence;
+    out->buff_strength = c->buff_strength;
+    out->max_health = p->max_health;
+    out->crit_chance = p->crit_chance;
+    out->crit_damage = p->crit_damage;
+    out->crit_rating = p->crit_rating;
+    out->haste_rating = p->haste_rating;
+    out->avoidance_rating = p->avoidance_rating;
+    out->crit_eff_pct =
+        (int) (rogue_rating_effective_percent(ROGUE_RATING_CRIT, p->crit_rating) + 0.5f);
+    out->haste_eff_pct =
+        (int) (rogue_rating_effective_percent(ROGUE_RATING_HASTE, p->haste_rating) + 0.5f);
+    out->avoidance_eff_pct =
+        (int) (rogue_rating_effective_percent(ROGUE_RATING_AVOIDANCE, p->avoidance_rating) +
+               0.5f);
+}
+
+void rogue_loadout_from_equipped(RogueLoadout* out)
+{
+    for (int s = 0; s < ROGUE_EQUIP_SLOT_COUNT; s++)
+        out->inst[s] = rogue_equip_get((enum RogueEquipSlot) s);
+}
+
+static void refresh_set_layer(RogueLoadoutEvalCtx* ctx)
+{
+    rogue_equip_contrib_set_layer(ctx->slot_set, ctx->set);
+}
+
+void rogue_loadout_eval_set_slot_contrib(RogueLoadoutEvalCtx* ctx, enum RogueEquipSlot slot,
+                                         int inst_index, const RogueLoadoutContrib* c)
+{
+    if (slot < 0 || slot >= ROGUE_EQUIP_SLOT_COUNT)
+        return;
+    int* v = ctx->slot_v[slot];
+    for (int ch = 0; ch < ROGUE_LOADOUT_CH__COUNT; ch++)
+    {
+        ctx->sum[ch] += c->v[ch] - v[ch];
+        v[ch] = c->v[ch];
+    }
+    int set_id = c->occupied ? c->set_id : -1;
+    ctx->loadout.inst[slot] = inst_index;
+    ctx->slot_used[slot] = c->occupied;
+    if (ctx->slot_set[slot] != set_id)
+    {
+        ctx->slot_set[slot] = set_id;
+        refresh_set_layer(ctx);
+    }
+}
+
+void rogue_loadout_eval_set_slot(RogueLoadoutEvalCtx* ctx, enum RogueEquipSlot slot,
+                                 int inst_index)
+{
+    RogueLoadoutContrib c;
+    rogue_loadout_item_contrib(slot, inst_index, &c);
+    rogue_loadout_eval_set_slot_contrib(ctx, slot, inst_index, &c);
+}
+
+void rogue_loadout_eval_init(RogueLoadoutEvalCtx* ctx, const RogueLoadoutBaseState* base,
+                             const RogueLoadout* loadout)
+{
+    memset(ctx, 0, sizeof *ctx);
+    ctx->base = *base;
+    for (int s = 0; s < ROGUE_EQUIP_SLOT_COUNT; s++)
+    {
+        RogueLoadoutContrib c;
+        int inst = loadout ? loadout->inst[s] : -1;
+        rogue_loadout_item_contrib((enum RogueEquipSlot) s, inst, &c);
+        memcpy(ctx->slot_v[s], c.v, sizeof c.v);
+        for (int ch = 0; ch < ROGUE_LOADOUT_CH__COUNT; ch++)
+            ctx->sum[ch] += c.v[ch];
+        ctx->slot_set[s] = c.occupied ? c.set_id : -1;
+        ctx->slot_used[s] = c.occupied;
+        ctx->loadout.inst[s] = inst;
+    }
+    refresh_set_layer(ctx);
+}
+
+/* Primary totals for a channel sum vector + set layer (compute_layers order of layers). */
+typedef struct EvalTotals
+{
+    int str, dex, vit, intel;
+    int affix_str, affix_dex, affix_vit, affix_int;
+} EvalTotals;
+
+static void eval_totals(const RogueLoadoutBaseState* b, const int* sum, const int* set,
+                        EvalTotals* t)
+{
+    const int* sp = set + ROGUE_EQUIP_CONTRIB_SET; /* set layer primaries */
+    t->affix_str = sum[ROGUE_LOADOUT_CH_AFFIX_STR];
+    t->affix_dex = sum[ROGUE_LOADOUT_CH_AFFIX_DEX];
+    t->affix_vit = sum[ROGUE_LOADOUT_CH_AFFIX_VIT];
+    t->affix_int = sum[ROGUE_LOADOUT_CH_AFFIX_INT];
+    if (sum[ROGUE_LOADOUT_CH_GEM_PCT_STR] > 0)
+        t->affix_str += (b->strength * sum[ROGUE_LOADOUT_CH_GEM_PCT_STR]) / 100;
+    if (sum[ROGUE_LOADOUT_CH_GEM_PCT_DEX] > 0)
+        t->affix_dex += (b->dexterity * sum[ROGUE_LOADOUT_CH_GEM_PCT_DEX]) / 100;
+    if (sum[ROGUE_LOADOUT_CH_GEM_PCT_VIT] > 0)
+        t->affix_vit += (b->vitality * sum[ROGUE_LOADOUT_CH_GEM_PCT_VIT]) / 100;
+    if (sum[ROGUE_LOADOUT_CH_GEM_PCT_INT] > 0)
+        t->affix_int += (b->intelligence * sum[ROGUE_LOADOUT_CH_GEM_PCT_INT]) / 100;
+    t->str = b->strength + sum[ROGUE_LOADOUT_CH_IMPLICIT_STR] + sum[ROGUE_LOADOUT_CH_UNIQUE_STR] +
+             sp[0] + sum[ROGUE_LOADOUT_CH_RUNEWORD_STR] + t->affix_str + b->passive_strength +
+             b->buff_strength;
+    t->dex = b->dexterity + sum[ROGUE_LOADOUT_CH_IMPLICIT_DEX] + sum[ROGUE_LOADOUT_CH_UNIQUE_DEX] +
+             sp[1] + sum[ROGUE_LOADOUT_CH_RUNEWORD_DEX] + t->affix_dex + b->passive_dexterity;
+    t->vit = b->vitality + sum[ROGUE_LOADOUT_CH_IMPLICIT_VIT] + sum[ROGUE_LOADOUT_CH_UNIQUE_VIT] +
+             sp[2] + sum[ROGUE_LOADOUT_CH_RUNEWORD_VIT] + t->affix_vit + b->passive_vitality;
+    t->intel = b->intelligence + sum[ROGUE_LOADOUT_CH_IMPLICIT_INT] +
+               sum[ROGUE_LOADOUT_CH_UNIQUE_INT] + sp[3] + sum[ROGUE_LOADOUT_CH_RUNEWORD_INT] +
+               t->affix_int + b->passive_intelligence;
+}
+
+/* Derived metrics exactly as stat_cache.c compute_derived. */
+static void eval_derived(const RogueLoadoutBaseState* b, int has_weapon, int weapon_damage,
+                         int armor_total, int total_dex, int total_vit, RogueLoadoutScore* out)
+{
+    int base_weapon = has_weapon ? weapon_damage : 3;
+    float dex_scalar = 1.0f + (float) total_dex / 50.0f;
+    float crit_mult = 1.0f + ((float) b->crit_chance / 100.0f) * ((float) b->crit_damage / 100.0f);
+    out->dps = (int) ((float) base_weapon * dex_scalar * crit_mult);
+    int max_hp = b->max_health + armor_total * 2;
+    float vit_scalar = 1.0f + (float) total_vit / 200.0f;
+    out->ehp = (int) ((float) max_hp * vit_scalar);
+    if (out->ehp < max_hp)
+        out->ehp = max_hp;
+    out->mobility = (int) (100 + (float) total_dex * 1.5f);
+}
+
+void rogue_loadout_eval_score(const RogueLoadoutEvalCtx* ctx, RogueLoadoutScore* out)
+{
+    EvalTotals t;
+    eval_totals(&ctx->base, ctx->sum, ctx->set, &t);
+    eval_derived(&ctx->base, ctx->slot_used[ROGUE_EQUIP_WEAPON],
+                 ctx->sum[ROGUE_LOADOUT_CH_WEAPON_DAMAGE], ctx->sum[ROGUE_LOADOUT_CH_BASE_ARMOR],
+                 t.dex, t.vit, out);
+}
+
+void rogue_loadout_eval_try_slot(const RogueLoadoutEvalCtx* ctx, enum RogueEquipSlot slot,
+                                 const RogueLoadoutContrib* c, RogueLoadoutScore* out)
+{
+    if (slot < 0 || slot >= ROGUE_EQUIP_SLOT_COUNT)
+    {
+        rogue_loadout_eval_score(ctx, out);
+        return;
+    }
+    int sum[ROGUE_LOADOUT_CH__COUNT];
+    for (int ch = 0; ch < ROGUE_LOADOUT_CH__COUNT; ch++)
+        sum[ch] = ctx->sum[ch] - ctx->slot_v[slot][ch] + c->v[ch];
+    const int* set = ctx->set;
+    int set_id = c->occupied ? c->set_id : -1;
+    int swapped_set[ROGUE_EQUIP_CONTRIB__COUNT];
+    if (set_id != ctx->slot_set[slot])
+    {
+        int slot_set[ROGUE_EQUIP_SLOT_COUNT];
+        memcpy(slot_set, ctx->slot_set, sizeof slot_set);
+        slot_set[slot] = set_id;
+        rogue_equip_contrib_set_layer(slot_set, swapped_set);
+        set = swapped_set;
+    }
+    EvalTotals t;
+    eval_totals(&ctx->base, sum, set, &t);
+    int has_weapon = slot == ROGUE_EQUIP_WEAPON ? c->occupied : ctx->slot_used[ROGUE_EQUIP_WEAPON];
+    eval_derived(&ctx->base, has_weapon, sum[ROGUE_LOADOUT_CH_WEAPON_DAMAGE],
+                 sum[ROGUE_LOADOUT_CH_BASE_ARMOR], t.dex, t.vit, out);
+}
+
+/* Soft cap at 75% with diminishing returns, hard cap 90% (stat_cache.c compute_derived). */
+static int cap_resist(int v)
+{
+    const float soft_cap = 75.f;
+    const float softness = 0.85f;
+    const int hard_cap = 90;
+    if (v < 0)
+        return 0;
+    if (v >= hard_cap)
+        return hard_cap;
+    if (v > (int) soft_cap)
+    {
+        float adj = rogue_soft_cap_apply((float) v, soft_cap, softness);
+        v = (int) (adj + 0.5f);
+        if (v > hard_cap)
+            v = hard_cap;
+    }
+    return v;
+}
+
+void rogue_loadout_eval_full(const RogueLoadoutEvalCtx* ctx, RogueStatCache* out)
+{
+    const RogueLoadoutBaseState* b = &ctx->base;
+    const int* sum = ctx->sum;
+    EvalTotals t;
+    memset(out, 0, sizeof *out);
+    eval_totals(b, sum, ctx->set, &t);
+    out->base_strength = b->strength;
+    out->base_dexterity = b->dexterity;
+    out->base_vitality = b->vitality;
+    out->base_intelligence = b->intelligence;
+    out->implicit_strength = sum[ROGUE_LOADOUT_CH_IMPLICIT_STR];
+    out->implicit_dexterity = sum[ROGUE_LOADOUT_CH_IMPLICIT_DEX];
+    out->implicit_vitality = sum[ROGUE_LOADOUT_CH_IMPLICIT_VIT];
+    out->implicit_intelligence = sum[ROGUE_LOADOUT_CH_IMPLICIT_INT];
+    out->unique_strength = sum[ROGUE_LOADOUT_CH_UNIQUE_STR];
+    out->unique_dexterity = sum[ROGUE_LOADOUT_CH_UNIQUE_DEX];
+    out->unique_vitality = sum[ROGUE_LOADOUT_CH_UNIQUE_VIT];
+    out->unique_intelligence = sum[ROGUE_LOADOUT_CH_UNIQUE_INT];
+    out->set_strength = ctx->set[ROGUE_EQUIP_CONTRIB_SET + 0];
+    out->set_dexterity = ctx->set[ROGUE_EQUIP_CONTRIB_SET + 1];
+    out->set_vitality = ctx->set[ROGUE_EQUIP_CONTRIB_SET + 2];
+    out->set_intelligence = ctx->set[ROGUE_EQUIP_CONTRIB_SET + 3];
+    out->runeword_strength = sum[ROGUE_LOADOUT_CH_RUNEWORD_STR];
+    out->runeword_dexterity = sum[ROGUE_LOADOUT_CH_RUNEWORD_DEX];
+    out->runeword_vitality = sum[ROGUE_LOADOUT_CH_RUNEWORD_VIT];
+    out->runeword_intelligence = sum[ROGUE_LOADOUT_CH_RUNEWORD_INT];
+    out->affix_strength = t.affix_str;
+    out->affix_dexterity = t.affix_dex;
+    out->affix_vitality = t.affix_vit;
+    out->affix_intelligence = t.affix_int;
+    out->passive_strength = b->passive_strength;
+    out->passive_dexterity = b->passive_dexterity;
+    out->passive_vitality = b->passive_vitality;
+    out->passive_intelligence = b->passive_intelligence;
+    out->buff_strength = b->buff_strength;
+    out->total_strength = t.str;
+    out->total_dexterity = t.dex;
+    out->total_vitality = t.vit;
+    out->total_intelligence = t.intel;
+    out->affix_armor_flat =
+        sum[ROGUE_LOADOUT_CH_ARMOR_FLAT] + ctx->set[ROGUE_EQUIP_CONTRIB_ARMOR_FLAT];
+    out->rating_crit = b->crit_rating;
+    out->rating_haste = b->haste_rating;
+    out->rating_avoidance = b->avoidance_rating;
+    out->rating_crit_eff_pct = b->crit_eff_pct;
+    out->rating_haste_eff_pct = b->haste_eff_pct;
+    out->rating_avoidance_eff_pct = b->avoidance_eff_pct;
+    const int* set_res = ctx->set + ROGUE_EQUIP_CONTRIB_RESIST;
+    out->resist_physical = cap_resist(sum[ROGUE_LOADOUT_CH_RESIST_PHYS] + set_res[0]);
+    out->resist_fire = cap_resist(sum[ROGUE_LOADOUT_CH_RESIST_FIRE] + set_res[1]);
+    out->resist_cold = cap_resist(sum[ROGUE_LOADOUT_CH_RESIST_COLD] + set_res[2]);
+    out->resist_lightning = cap_resist(sum[ROGUE_LOADOUT_CH_RESIST_LIGHT] + set_res[3]);
+    out->resist_poison = cap_resist(sum[ROGUE_LOADOUT_CH_RESIST_POISON] + set_res[4]);
+    out->resist_status = cap_resist(sum[ROGUE_LOADOUT_CH_RESIST_STATUS] + set_res[5]);
+    out->block_chance = sum[ROGUE_LOADOUT_CH_BLOCK_CHANCE];
+    out->block_value = sum[ROGUE_LOADOUT_CH_BLOCK_VALUE];
+    out->phys_conv_fire_pct = sum[ROGUE_LOADOUT_CH_CONV_FIRE];
+    out->phys_conv_frost_pct = sum[ROGUE_LOADOUT_CH_CONV_FROST];
+    out->phys_conv_arcane_pct = sum[ROGUE_LOADOUT_CH_CONV_ARCANE];
+    out->guard_recovery_pct = sum[ROGUE_LOADOUT_CH_GUARD_RECOVERY];
+    out->thorns_percent = sum[ROGUE_LOADOUT_CH_THORNS_PCT];
+    out->thorns_cap = sum[ROGUE_LOADOUT_CH_THORNS_CAP];
+    RogueLoadoutScore sc;
+    rogue_loadout_eval_score(ctx, &sc);
+    out->dps_estimate = sc.dps;
+    out->ehp_estimate = sc.ehp;
+    out->toughness_index = sc.ehp;
+    out->mobility_index = sc.mobility;
+    out->sustain_index = 0;
+}
+
+void rogue_loadout_evaluate(const RogueLoadoutBaseState* base, const RogueLoadout* loadout,
+                            RogueStatCache* out)
+{
+    RogueLoadoutEvalCtx ctx;
+    rogue_loadout_eval_init(&ctx, base, loadout);
+    rogue_loadout_eval_full(&ctx, out);
+}
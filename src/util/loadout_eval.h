@@ -0,0 +1,140 @@
+/* Side-effect-free loadout stat evaluation (Equipment Phase 9 optimizer support).
+ *
+ * Mirrors rogue_equipment_apply_stat_bonuses + rogue_stat_cache_force_update for an explicit
+ * loadout (slot -> item instance) and a captured player base state, without touching the live
+ * equipment slots or g_player_stat_cache. Each slot keeps the contribution gathered by
+ * rogue_equip_contrib_gather (the routine equipment_stats.c sums) so swapping one slot is a
+ * subtract/add of that slot's channels plus the non-additive set layer. The evaluator only
+ * reads item/affix/gem/set registries, so a const context may be scored from several threads as
+ * long as those registries are not mutated concurrently. */
+#ifndef ROGUE_LOADOUT_EVAL_H
+#define ROGUE_LOADOUT_EVAL_H
+
+#include <stddef.h> /* stat_cache.h uses size_t */
+#include "../core/equipment/equipment.h"
+#include "../core/equipment/equipment_contrib.h"
+#include "../game/stat_cache.h"
+
+/* Additive contribution channels: the shared equipment contribution fields followed by the two
+ * terms only the optimizer's derived metrics need. */
+enum RogueLoadoutChannel
+{
+    ROGUE_LOADOUT_CH_IMPLICIT_STR = ROGUE_EQUIP_CONTRIB_IMPLICIT,
+    ROGUE_LOADOUT_CH_IMPLICIT_DEX,
+    ROGUE_LOADOUT_CH_IMPLICIT_VIT,
+    ROGUE_LOADOUT_CH_IMPLICIT_INT,
+    ROGUE_LOADOUT_CH_UNIQUE_STR = ROGUE_EQUIP_CONTRIB_UNIQUE,
+    ROGUE_LOADOUT_CH_UNIQUE_DEX,
+    ROGUE_LOADOUT_CH_UNIQUE_VIT,
+    ROGUE_LOADOUT_CH_UNIQUE_INT,
+    ROGUE_LOADOUT_CH_RUNEWORD_STR = ROGUE_EQUIP_CONTRIB_RUNEWORD,
+    ROGUE_LOADOUT_CH_RUNEWORD_DEX,
+    ROGUE_LOADOUT_CH_RUNEWORD_VIT,
+    ROGUE_LOADOUT_CH_RUNEWORD_INT,
+    ROGUE_LOADOUT_CH_AFFIX_STR = ROGUE_EQUIP_CONTRIB_AFFIX, /* affix + socketed gem flat */
+    ROGUE_LOADOUT_CH_AFFIX_DEX,
+    ROGUE_LOADOUT_CH_AFFIX_VIT,
+    ROGUE_LOADOUT_CH_AFFIX_INT,
+    /* percent of base, applied once on the summed percent */
+    ROGUE_LOADOUT_CH_GEM_PCT_STR = ROGUE_EQUIP_CONTRIB_GEM_PCT,
+    ROGUE_LOADOUT_CH_GEM_PCT_DEX,
+    ROGUE_LOADOUT_CH_GEM_PCT_VIT,
+    ROGUE_LOADOUT_CH_GEM_PCT_INT,
+    ROGUE_LOADOUT_CH_ARMOR_FLAT = ROGUE_EQUIP_CONTRIB_ARMOR_FLAT,
+    ROGUE_LOADOUT_CH_RESIST_PHYS = ROGUE_EQUIP_CONTRIB_RESIST,
+    ROGUE_LOADOUT_CH_RESIST_FIRE,
+    ROGUE_LOADOUT_CH_RESIST_COLD,
+    ROGUE_LOADOUT_CH_RESIST_LIGHT,
+    ROGUE_LOADOUT_CH_RESIST_POISON,
+    ROGUE_LOADOUT_CH_RESIST_STATUS,
+    ROGUE_LOADOUT_CH_BLOCK_CHANCE = ROGUE_EQUIP_CONTRIB_BLOCK_CHANCE,
+    ROGUE_LOADOUT_CH_BLOCK_VALUE = ROGUE_EQUIP_CONTRIB_BLOCK_VALUE,
+    ROGUE_LOADOUT_CH_CONV_FIRE = ROGUE_EQUIP_CONTRIB_PHYS_CONV_FIRE,
+    ROGUE_LOADOUT_CH_CONV_FROST = ROGUE_EQUIP_CONTRIB_PHYS_CONV_FROST,
+    ROGUE_LOADOUT_CH_CONV_ARCANE = ROGUE_EQUIP_CONTRIB_PHYS_CONV_ARCANE,
+    ROGUE_LOADOUT_CH_GUARD_RECOVERY = ROGUE_EQUIP_CONTRIB_GUARD_RECOVERY,
+    ROGUE_LOADOUT_CH_THORNS_PCT = ROGUE_EQUIP_CONTRIB_THORNS_PERCENT,
+    ROGUE_LOADOUT_CH_THORNS_CAP = ROGUE_EQUIP_CONTRIB_THORNS_CAP,
+    ROGUE_LOADOUT_CH_BASE_ARMOR = ROGUE_EQUIP_CONTRIB_ITEM_FIELDS, /* armor-like slots only */
+    ROGUE_LOADOUT_CH_WEAPON_DAMAGE, /* weapon slot only; 0 = empty */
+    ROGUE_LOADOUT_CH__COUNT
+};
+
+/* Explicit loadout value: item instance index per slot (-1 empty). */
+typedef struct RogueLoadout
+{
+    int inst[ROGUE_EQUIP_SLOT_COUNT];
+} RogueLoadout;
+
+/* Player inputs the loadout does not change (captured once, read-only during a search). */
+typedef struct RogueLoadoutBaseState
+{
+    int strength, dexterity, vitality, intelligence; /* base layer (pre-equipment) */
+    int passive_strength, passive_dexterity, passive_vitality, passive_intelligence;
+    int buff_strength;
+    int max_health;
+    int crit_chance, crit_damage;
+    int crit_rating, haste_rating, avoidance_rating;
+    int crit_eff_pct, haste_eff_pct, avoidance_eff_pct;
+} RogueLoadoutBaseState;
+
+/* One item's contribution when placed in a given slot. */
+typedef struct RogueLoadoutContrib
+{
+    int v[ROGUE_LOADOUT_CH__COUNT];
+    int set_id; /* item definition set id (0 when not part of a set) */
+    int occupied;
+} RogueLoadoutContrib;
+
+/* The three metrics the optimizer constrains / maximizes. */
+typedef struct RogueLoadoutScore
+{
+    int dps;
+    int ehp;
+    int mobility;
+} RogueLoadoutScore;
+
+typedef struct RogueLoadoutEvalCtx
+{
+    RogueLoadoutBaseState base;
+    RogueLoadout loadout;
+    int slot_v[ROGUE_EQUIP_SLOT_COUNT][ROGUE_LOADOUT_CH__COUNT]; /* per-slot contributions */
+    int slot_set[ROGUE_EQUIP_SLOT_COUNT];  /* set id per slot, -1 when empty */
+    int slot_used[ROGUE_EQUIP_SLOT_COUNT]; /* slot holds a live instance */
+    int sum[ROGUE_LOADOUT_CH__COUNT];
+    int set[ROGUE_EQUIP_CONTRIB__COUNT]; /* cached set layer for the current loadout */
+} RogueLoadoutEvalCtx;
+
+/* Capture base state from a player plus the passive/buff layers currently held in
+ * g_player_stat_cache (call on the owning thread before a search). */
+void rogue_loadout_base_from_player(const RoguePlayer* p, RogueLoadoutBaseState* out);
+/* Current live equipment as a loadout value. */
+void rogue_loadout_from_equipped(RogueLoadout* out);
+
+/* Contribution of instance inst_index placed in slot (empty contrib for inst_index < 0). */
+void rogue_loadout_item_contrib(enum RogueEquipSlot slot, int inst_index,
+                                RogueLoadoutContrib* out);
+
+void rogue_loadout_eval_init(RogueLoadoutEvalCtx* ctx, const RogueLoadoutBaseState* base,
+                             const RogueLoadout* loadout);
+/* Commit a slot change (incremental: only that slot's column and the set layer change). */
+void rogue_loadout_eval_set_slot(RogueLoadoutEvalCtx* ctx, enum RogueEquipSlot slot,
+                                 int inst_index);
+void rogue_loadout_eval_set_slot_contrib(RogueLoadoutEvalCtx* ctx, enum RogueEquipSlot slot,
+                                         int inst_index, const RogueLoadoutContrib* c);
+
+/* Score the context's loadout. */
+void rogue_loadout_eval_score(const RogueLoadoutEvalCtx* ctx, RogueLoadoutScore* out);
+/* Score the loadout with one slot replaced by a precomputed contribution (ctx untouched). */
+void rogue_loadout_eval_try_slot(const RogueLoadoutEvalCtx* ctx, enum RogueEquipSlot slot,
+                                 const RogueLoadoutContrib* c, RogueLoadoutScore* out);
+/* Full RogueStatCache-equivalent for the context's loadout (layers, totals, ratings, resists after
+ * soft/hard caps, derived metrics). Bookkeeping fields (fingerprint, dirty, counters, last_*) are
+ * zero. */
+void rogue_loadout_eval_full(const RogueLoadoutEvalCtx* ctx, RogueStatCache* out);
+
+/* One-shot convenience wrapper around init + full. */
+void rogue_loadout_evaluate(const RogueLoadoutBaseState* base, const RogueLoadout* loadout,
+                            RogueStatCache* out);
+
+#endif
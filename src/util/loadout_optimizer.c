@@ -16,8 +16,11 @@
 #include "../core/loot/loot_instances.h"
 #include "../core/loot/loot_item_defs.h"
 #include "../game/stat_cache.h"
+#include "loadout_eval.h"
 #include <string.h>
-#if defined(_WIN32)
+#if defined(ROGUE_HAVE_SDL)
+#include <SDL.h>
+#elif defined(_WIN32)
 #include <windows.h>
 #endif
 
@@ -223,24 +226,6 @@ static void recompute_stats(void)
     rogue_stat_cache_force_update(&g_exposed_player_for_stats);
 }
 
-/* Attempt equipping instance (if category fits) returning 0 on success else negative. Wraps
- * existing API. */
-
-/**
- * @brief Attempts to equip an item in a specific slot.
- * @param slot Equipment slot to modify.
- * @param inst_index Item instance index to equip.
- * @param prev_out Pointer to store previous item index (can be NULL).
- * @return 0 on success, negative on failure.
- * @details Wraps the existing equipment API with optional previous item tracking.
- */
-static int try_equip_slot(enum RogueEquipSlot slot, int inst_index, int* prev_out)
-{
-    if (prev_out)
-        *prev_out = rogue_equip_get(slot);
-    return rogue_equip_try(slot, inst_index);
-}
-
 /* Evaluate current equipped DPS/EHP/Mobility after ensuring cache updated */
 
 /**
@@ -255,25 +240,6 @@ static void ensure_stats(void)
     }
 }
 
-/* Return 1 if constraints satisfied, 0 otherwise */
-
-/**
- * @brief Checks if current loadout meets minimum constraints.
- * @param min_mobility Minimum required mobility index.
- * @param min_ehp Minimum required EHP estimate.
- * @return 1 if constraints are satisfied, 0 otherwise.
- * @details Verifies that current stats meet the specified minimums.
- */
-static int constraints_ok(int min_mobility, int min_ehp)
-{
-    ensure_stats();
-    if (g_player_stat_cache.mobility_index < min_mobility)
-        return 0;
-    if (g_player_stat_cache.ehp_estimate < min_ehp)
-        return 0;
-    return 1;
-}
-
 /* Collect candidate item instances by scanning active instances and filtering by category vs slot.
  */
 
@@ -288,7 +254,7 @@ static int constraints_ok(int min_mobility, int min_ehp)
 static int collect_candidates(enum RogueEquipSlot slot, int* out_indices, int cap)
 {
     int count = 0;
-    for (int i = 0; i < ROGUE_ITEM_INSTANCE_CAP && count < cap; i++)
+    for (int i = 0, n = rogue_items_capacity(); i < n && count < cap; i++)
     {
         const RogueItemInstance* it = rogue_item_instance_at(i);
         if (!it)
@@ -316,7 +282,42 @@ static int collect_candidates(enum RogueEquipSlot slot, int* out_indices, int ca
     return count;
 }
 
-/* Hill-climb: single pass trying improving swaps per slot until no improvement. */
+/* Snapshot for an evaluated (not equipped) loadout so cache hashing stays identical to
+ * rogue_loadout_snapshot on the live state. */
+static void snapshot_from_eval(const RogueLoadoutEvalCtx* ctx, enum RogueEquipSlot slot, int inst,
+                               const RogueLoadoutScore* sc, RogueLoadoutSnapshot* out)
+{
+    memset(out, 0, sizeof *out);
+    out->slot_count = ROGUE_EQUIP_SLOT_COUNT;
+    for (int i = 0; i < ROGUE_EQUIP_SLOT_COUNT; i++)
+    {
+        int ii = (i == (int) slot) ? inst : ctx->loadout.inst[i];
+        const RogueItemInstance* it = ii >= 0 ? rogue_item_instance_at(ii) : NULL;
+        out->inst_indices[i] = ii;
+        out->def_indices[i] = it ? it->def_index : -1;
+    }
+    out->dps_estimate = sc->dps;
+    out->ehp_estimate = sc->ehp;
+    out->mobility_index = sc->mobility;
+}
+
+/* Score a weapon candidate; a two-handed weapon also empties the offhand (rogue_equip_try rule). */
+static void score_candidate(const RogueLoadoutEvalCtx* ctx, enum RogueEquipSlot slot, int cand,
+                            const RogueLoadoutContrib* c, RogueLoadoutScore* out)
+{
+    if (slot == ROGUE_EQUIP_WEAPON && ctx->loadout.inst[ROGUE_EQUIP_OFFHAND] >= 0 &&
+        rogue_equip_item_is_two_handed(cand))
+    {
+        RogueLoadoutEvalCtx tmp = *ctx;
+        rogue_loadout_eval_set_slot(&tmp, ROGUE_EQUIP_OFFHAND, -1);
+        rogue_loadout_eval_try_slot(&tmp, slot, c, out);
+        return;
+    }
+    rogue_loadout_eval_try_slot(ctx, slot, c, out);
+}
+
+/* Hill-climb: single pass trying improving swaps per slot until no improvement. Candidates are
+ * scored with the pure evaluator (loadout_eval.h); only accepted swaps touch live equipment. */
 
 /**
  * @brief Optimizes the current loadout using hill-climbing algorithm.
@@ -327,6 +328,7 @@ static int collect_candidates(enum RogueEquipSlot slot, int* out_indices, int ca
  */
 int rogue_loadout_optimize(int min_mobility, int min_ehp)
 {
+    extern RoguePlayer g_exposed_player_for_stats;
     rogue_equip_profiler_zone_begin("optimize");
     ensure_stats();
     RogueLoadoutSnapshot baseline;
@@ -334,6 +336,12 @@ int rogue_loadout_optimize(int min_mobility, int min_ehp)
     unsigned int base_hash = rogue_loadout_hash(&baseline);
     cache_insert(base_hash);
     g_cache_inserts++;
+    RogueLoadoutBaseState base;
+    RogueLoadout current;
+    RogueLoadoutEvalCtx ctx;
+    rogue_loadout_base_from_player(&g_exposed_player_for_stats, &base);
+    rogue_loadout_from_equipped(&current);
+    rogue_loadout_eval_init(&ctx, &base, &current);
     int improved_total = 0;
     int progress = 1;
     int guard = 0;
@@ -343,60 +351,57 @@ int rogue_loadout_optimize(int min_mobility, int min_ehp)
         guard++;
         for (int slot = 0; slot < ROGUE_EQUIP_SLOT_COUNT; ++slot)
         {
-            int current_inst = rogue_equip_get((enum RogueEquipSlot) slot);
+            int current_inst = ctx.loadout.inst[slot];
+            if (slot == ROGUE_EQUIP_OFFHAND && ctx.loadout.inst[ROGUE_EQUIP_WEAPON] >= 0 &&
+                rogue_equip_item_is_two_handed(ctx.loadout.inst[ROGUE_EQUIP_WEAPON]))
+                continue; /* offhand locked by two-handed weapon */
             int* candidates = (int*) rogue_equip_frame_alloc(sizeof(int) * 128, sizeof(int));
+            int candidates_stack[128];
             if (!candidates)
-            {
-                int candidates_stack[128];
                 candidates = candidates_stack;
-            }
             int ccount = collect_candidates((enum RogueEquipSlot) slot, candidates, 128);
-            int best_dps = g_player_stat_cache.dps_estimate;
+            RogueLoadoutScore cur;
+            rogue_loadout_eval_score(&ctx, &cur);
+            int best_dps = cur.dps;
             int best_inst = current_inst;
             for (int ci = 0; ci < ccount; ++ci)
             {
                 int cand = candidates[ci];
                 if (cand == current_inst)
                     continue;
-                int prev;
-                if (try_equip_slot((enum RogueEquipSlot) slot, cand, &prev) == 0)
+                RogueLoadoutContrib c;
+                RogueLoadoutScore sc;
+                rogue_loadout_item_contrib((enum RogueEquipSlot) slot, cand, &c);
+                score_candidate(&ctx, (enum RogueEquipSlot) slot, cand, &c, &sc);
+                RogueLoadoutSnapshot snap;
+                snapshot_from_eval(&ctx, (enum RogueEquipSlot) slot, cand, &sc, &snap);
+                unsigned int h = rogue_loadout_hash(&snap);
+                if (cache_contains(h))
+                {
+                    g_cache_hits++;
+                    continue;
+                }
+                cache_insert(h);
+                g_cache_inserts++;
+                if (sc.mobility >= min_mobility && sc.ehp >= min_ehp && sc.dps > best_dps)
                 {
-                    recompute_stats();
-                    RogueLoadoutSnapshot snap;
-                    rogue_loadout_snapshot(&snap);
-                    unsigned int h = rogue_loadout_hash(&snap);
-                    if (cache_contains(h))
-                    {
-                        g_cache_hits++; /* revert */
-                        rogue_equip_try((enum RogueEquipSlot) slot, prev);
-                        continue;
-                    }
-                    else
-                    {
-                        cache_insert(h);
-                        g_cache_inserts++;
-                    }
-                    if (constraints_ok(min_mobility, min_ehp))
-                    {
-                        if (g_player_stat_cache.dps_estimate > best_dps)
-                        {
-                            best_dps = g_player_stat_cache.dps_estimate;
-                            best_inst = cand;
-                        }
-                    }
-                    rogue_equip_try((enum RogueEquipSlot) slot, prev);
-                    recompute_stats();
+                    best_dps = sc.dps;
+                    best_inst = cand;
                 }
             }
             if (best_inst != current_inst)
             {
+                if (slot == ROGUE_EQUIP_WEAPON && rogue_equip_item_is_two_handed(best_inst))
+                    rogue_loadout_eval_set_slot(&ctx, ROGUE_EQUIP_OFFHAND, -1);
+                rogue_loadout_eval_set_slot(&ctx, (enum RogueEquipSlot) slot, best_inst);
                 rogue_equip_try((enum RogueEquipSlot) slot, best_inst);
-                recompute_stats();
                 improved_total++;
                 progress = 1;
             }
         }
     }
+    if (improved_total > 0)
+        recompute_stats();
     rogue_equip_profiler_zone_end("optimize");
     return improved_total;
 }
@@ -405,6 +410,8 @@ int rogue_loadout_optimize(int min_mobility, int min_ehp)
 
 /** @brief Flag indicating if async optimization is running */
 static volatile int g_async_running = 0;
+/** @brief Set when a launched job has not been joined yet (its result is still pending) */
+static int g_async_pending = 0;
 /** @brief Minimum mobility constraint for async optimization */
 static int g_async_min_mob = 0;
 /** @brief Minimum EHP constraint for async optimization */
@@ -412,7 +419,23 @@ static int g_async_min_ehp = 0;
 /** @brief Result of async optimization */
 static int g_async_result = 0;
 
-#if defined(_WIN32)
+#if defined(ROGUE_HAVE_SDL)
+/** @brief Handle to the async optimization thread */
+static SDL_Thread* g_async_thread = NULL;
+
+/**
+ * @brief Thread function for async optimization (SDL threads, all platforms).
+ * @param ud Unused parameter.
+ * @return Always 0.
+ */
+static int rogue__opt_thread(void* ud)
+{
+    (void) ud;
+    g_async_result = rogue_loadout_optimize(g_async_min_mob, g_async_min_ehp);
+    g_async_running = 0;
+    return 0;
+}
+#elif defined(_WIN32)
 /** @brief Handle to the async optimization thread */
 static HANDLE g_async_thread = NULL;
 
@@ -436,24 +459,35 @@ static DWORD WINAPI rogue__opt_thread(LPVOID p)
  * @param min_mobility Minimum required mobility index.
  * @param min_ehp Minimum required EHP estimate.
  * @return 0 on success, negative on error.
- * @details Launches optimization in a background thread (Windows) or synchronously (other
- * platforms).
+ * @details Launches optimization on an SDL thread (or a Win32 thread without SDL); builds without
+ * thread support run it synchronously and keep the result for join.
  */
 int rogue_loadout_optimize_async(int min_mobility, int min_ehp)
 {
-    if (g_async_running)
+    if (g_async_running || g_async_pending)
         return -1;
     g_async_running = 1;
+    g_async_pending = 1;
     g_async_min_mob = min_mobility;
     g_async_min_ehp = min_ehp;
     g_async_result = 0;
     rogue_equip_profiler_zone_begin("optimize_async_launch");
     rogue_equip_profiler_zone_end("optimize_async_launch");
-#if defined(_WIN32)
+#if defined(ROGUE_HAVE_SDL)
+    g_async_thread = SDL_CreateThread(rogue__opt_thread, "loadout_opt", NULL);
+    if (!g_async_thread)
+    {
+        g_async_running = 0;
+        g_async_pending = 0;
+        return -2;
+    }
+    return 0;
+#elif defined(_WIN32)
     g_async_thread = CreateThread(NULL, 0, rogue__opt_thread, NULL, 0, NULL);
     if (!g_async_thread)
     {
         g_async_running = 0;
+        g_async_pending = 0;
         return -2;
     }
     return 0;
@@ -467,34 +501,30 @@ int rogue_loadout_optimize_async(int min_mobility, int min_ehp)
 
 /**
  * @brief Waits for asynchronous optimization to complete.
- * @return Number of equipment changes made, or negative on error.
+ * @return Number of equipment changes made, or -1 if no job was launched since the last join.
  * @details Blocks until optimization finishes and returns the result.
  */
 int rogue_loadout_optimize_join(void)
 {
-    if (!g_async_running)
-    {
-#if defined(_WIN32)
-        if (g_async_thread)
-        {
-            WaitForSingleObject(g_async_thread, INFINITE);
-            CloseHandle(g_async_thread);
-            g_async_thread = NULL;
-            return g_async_result;
-        }
-#endif
+    if (!g_async_pending)
         return -1;
+#if defined(ROGUE_HAVE_SDL)
+    if (g_async_thread)
+    {
+        SDL_WaitThread(g_async_thread, NULL);
+        g_async_thread = NULL;
+    }
+#elif defined(_WIN32)
+    if (g_async_thread)
+    {
+        WaitForSingleObject(g_async_thread, INFINITE);
+        CloseHandle(g_async_thread);
+        g_async_thread = NULL;
     }
-#if defined(_WIN32)
-    WaitForSingleObject(g_async_thread, INFINITE);
-    CloseHandle(g_async_thread);
-    g_async_thread = NULL;
-    int res = g_async_result;
-    g_async_running = 0;
-    return res;
-#else
-    return g_async_result; /* already done in fallback */
 #endif
+    g_async_running = 0;
+    g_async_pending = 0;
+    return g_async_result;
 }
 
 /**
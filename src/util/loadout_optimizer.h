@@ -34,7 +34,7 @@ int rogue_loadout_optimize(int min_mobility, int min_ehp);
     negative on failure or if a job is already running. Use join to retrieve the result. */
 int rogue_loadout_optimize_async(int min_mobility, int min_ehp);
 /* Blocks until async optimization (if any) completes. Returns improvements count or negative
-    if no job was running. */
+    if no job was launched since the last join. */
 int rogue_loadout_optimize_join(void);
 /* Query async state: returns 1 if running, 0 otherwise. */
 int rogue_loadout_optimize_async_running(void);
@@ -0,0 +1,892 @@
+/**
+ * @file loadout_search.c
+ * @brief Parallel branch-and-bound loadout search with top-K results.
+ * @details See loadout_search.h. Candidate contributions are precomputed once on the caller
+ * thread; workers only touch their own evaluation context plus the shared atomics (task cursor,
+ * top-K floor, node budget) and the visited table.
+ */
+
+#include "loadout_search.h"
+#include "../core/app/app_state.h"
+#include "../core/equipment/equipment_content.h"
+#include "../core/equipment/equipment_stats.h"
+#include "../core/loot/loot_instances.h"
+#include "../core/loot/loot_item_defs.h"
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(ROGUE_HAVE_SDL)
+#include <SDL.h>
+#endif
+
+/* ---- Portable atomics (SDL when threaded, plain ints on the single-threaded fallback) ---- */
+#if defined(ROGUE_HAVE_SDL)
+typedef SDL_atomic_t SearchAtomic;
+#define search_atomic_get(a) SDL_AtomicGet(a)
+#define search_atomic_set(a, v) SDL_AtomicSet((a), (v))
+#define search_atomic_add(a, v) SDL_AtomicAdd((a), (v))
+#define search_atomic_cas(a, o, n) SDL_AtomicCAS((a), (o), (n))
+#define search_ptr_get(p) SDL_AtomicGetPtr(p)
+#define search_ptr_cas(p, o, n) SDL_AtomicCASPtr((p), (o), (n))
+#else
+typedef struct SearchAtomic
+{
+    int value;
+} SearchAtomic;
+static int search_atomic_get(SearchAtomic* a) { return a->value; }
+static void search_atomic_set(SearchAtomic* a, int v) { a->value = v; }
+static int search_atomic_add(SearchAtomic* a, int v)
+{
+    int old = a->value;
+    a->value += v;
+    return old;
+}
+static int search_atomic_cas(SearchAtomic* a, int o, int n)
+{
+    if (a->value != o)
+        return 0;
+    a->value = n;
+    return 1;
+}
+static void* search_ptr_get(void** p) { return *p; }
+static int search_ptr_cas(void** p, void* o, void* n)
+{
+    if (*p != o)
+        return 0;
+    *p = n;
+    return 1;
+}
+#endif
+
+#define SEARCH_VISITED_MIN (1 << 12)
+#define SEARCH_VISITED_MAX (1 << 20)
+#define SEARCH_VISITED_PROBES 32
+#define SEARCH_NODE_BATCH 1024
+#define SEARCH_ARENA_RECORDS 1024
+#define SEARCH_MAX_CLASSES 16000 /* class codes stay below 65536 */
+
+typedef struct SearchCand
+{
+    int inst; /* -1 = leave slot empty */
+    int twohand;
+    unsigned short code;     /* (item class + 1) * 4 + slot group; slot group alone when empty */
+    unsigned long long term; /* visited-key contribution: hash of code */
+    RogueLoadoutContrib c;
+} SearchCand;
+
+/* Interned item class: the exact data that makes two instances interchangeable. */
+typedef struct SearchClass
+{
+    RogueLoadoutContrib armored; /* armor-slot view (includes set id) */
+    int weapon_damage;           /* weapon-slot view */
+    int twohand;
+} SearchClass;
+
+/* Visited entry: the hashed key for probing plus the sorted codes of the placed depths, which
+ * identify the partial loadout exactly (a key collision alone never prunes). */
+typedef struct SearchVisited
+{
+    unsigned long long key;
+    int depth;
+    unsigned short sig[ROGUE_EQUIP_SLOT_COUNT];
+} SearchVisited;
+
+/* Per-worker record storage; records are published into the table by pointer and never move. */
+typedef struct SearchArena
+{
+    struct SearchArena* next;
+    int used;
+    SearchVisited rec[SEARCH_ARENA_RECORDS];
+} SearchArena;
+
+enum
+{
+    SEARCH_RANK_DEX = 0,
+    SEARCH_RANK_DEX_PCT,
+    SEARCH_RANK_VIT,
+    SEARCH_RANK_VIT_PCT,
+    SEARCH_RANK_ARMOR,
+    SEARCH_RANK__COUNT
+};
+
+typedef struct SearchRank
+{
+    int value;
+    int inst;
+} SearchRank;
+
+typedef struct SearchEntry
+{
+    RogueLoadout lo;
+    RogueLoadoutScore sc;
+} SearchEntry;
+
+typedef struct SearchProblem
+{
+    RogueLoadoutSearchParams params;
+    RogueLoadoutBaseState base;
+    RogueLoadout fixed; /* slots outside the mask; searched slots are -1 */
+    int order[ROGUE_EQUIP_SLOT_COUNT];
+    int depth_count;
+    SearchCand* cand[ROGUE_EQUIP_SLOT_COUNT];
+    int ncand[ROGUE_EQUIP_SLOT_COUNT];
+    /* Non-weapon slots share one armor-category pool, so the bound for the r slots still open is
+     * the sum of the r best unused pool values per channel (positive values only, desc). */
+    SearchRank* rank[SEARCH_RANK__COUNT];
+    int nrank[SEARCH_RANK__COUNT];
+    int open_slots[ROGUE_EQUIP_SLOT_COUNT + 1];   /* non-weapon slots at depth >= d */
+    int open_armored[ROGUE_EQUIP_SLOT_COUNT + 1]; /* ... of which carry definition base armor */
+    int weapon_depth; /* depth at which the weapon is chosen, -1 when fixed */
+    int weapon_ub;    /* best weapon damage among weapon options (3 = bare hands) */
+    int weapon_rank_ub[SEARCH_RANK__COUNT];
+    int set_dex_ub, set_vit_ub;
+    float crit_mult;
+    int item_cap; /* item pool capacity at build time (instance indices are below it) */
+    SearchClass* classes;
+    int class_count, class_cap;
+    void** visited; /* SearchVisited*, NULL = empty */
+    unsigned int visited_mask;
+    SearchAtomic next_task;
+    SearchAtomic floor_dps; /* best published K-th DPS (INT_MIN until some worker has K) */
+    SearchAtomic nodes;
+    SearchAtomic abort;
+} SearchProblem;
+
+typedef struct SearchWorker
+{
+    SearchProblem* p;
+    RogueLoadoutEvalCtx ctx;
+    unsigned char* used; /* item_cap flags: instance placed in the current partial loadout */
+    unsigned long long key;
+    unsigned short codes[ROGUE_EQUIP_SLOT_COUNT]; /* code placed at each depth */
+    SearchArena* arena;
+    long nodes, pruned_bound, pruned_visited;
+    int pending_nodes;
+    SearchEntry top[ROGUE_LOADOUT_SEARCH_MAX_K];
+    int top_count;
+} SearchWorker;
+
+static unsigned long long mix64(unsigned long long x)
+{
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x;
+}
+
+static int slot_group(int slot)
+{
+    if (slot == ROGUE_EQUIP_WEAPON)
+        return 0;
+    if (slot == ROGUE_EQUIP_OFFHAND)
+        return 3; /* armor-category but no definition base armor */
+    if (slot == ROGUE_EQUIP_RING1 || slot == ROGUE_EQUIP_RING2 || slot == ROGUE_EQUIP_AMULET ||
+        slot == ROGUE_EQUIP_CHARM1 || slot == ROGUE_EQUIP_CHARM2)
+        return 2;
+    return 1;
+}
+
+/* Item class: identical full contributions (armor-slot and weapon-slot views, set, two-handed)
+ * make two instances interchangeable for the search. Classes are interned by exact comparison;
+ * returns the class index or -1 on allocation failure / too many classes. */
+static int item_class(SearchProblem* p, int inst, int twohand)
+{
+    SearchClass c;
+    RogueLoadoutContrib w;
+    memset(&c, 0, sizeof c);
+    rogue_loadout_item_contrib(ROGUE_EQUIP_ARMOR_HEAD, inst, &c.armored);
+    rogue_loadout_item_contrib(ROGUE_EQUIP_WEAPON, inst, &w);
+    c.weapon_damage = w.v[ROGUE_LOADOUT_CH_WEAPON_DAMAGE];
+    c.twohand = twohand;
+    for (int i = 0; i < p->class_count; i++)
+        if (memcmp(&p->classes[i], &c, sizeof c) == 0)
+            return i;
+    if (p->class_count >= SEARCH_MAX_CLASSES)
+        return -1;
+    if (p->class_count == p->class_cap)
+    {
+        int cap = p->class_cap ? p->class_cap * 2 : 64;
+        SearchClass* grown = (SearchClass*) realloc(p->classes, sizeof(SearchClass) * (size_t) cap);
+        if (!grown)
+            return -1;
+        p->classes = grown;
+        p->class_cap = cap;
+    }
+    p->classes[p->class_count] = c;
+    return p->class_count++;
+}
+
+static int slot_category(int slot)
+{
+    return slot == ROGUE_EQUIP_WEAPON ? ROGUE_ITEM_WEAPON : ROGUE_ITEM_ARMOR;
+}
+
+/* Flat primary totals over the additive channels (one contribution or a context sum). */
+static int cand_dex_sum(const int* v)
+{
+    return v[ROGUE_LOADOUT_CH_IMPLICIT_DEX] + v[ROGUE_LOADOUT_CH_UNIQUE_DEX] +
+           v[ROGUE_LOADOUT_CH_RUNEWORD_DEX] + v[ROGUE_LOADOUT_CH_AFFIX_DEX];
+}
+static int cand_vit_sum(const int* v)
+{
+    return v[ROGUE_LOADOUT_CH_IMPLICIT_VIT] + v[ROGUE_LOADOUT_CH_UNIQUE_VIT] +
+           v[ROGUE_LOADOUT_CH_RUNEWORD_VIT] + v[ROGUE_LOADOUT_CH_AFFIX_VIT];
+}
+static int cand_dex(const RogueLoadoutContrib* c) { return cand_dex_sum(c->v); }
+static int cand_vit(const RogueLoadoutContrib* c) { return cand_vit_sum(c->v); }
+
+/* Most promising first: weapon damage, then dexterity (DPS / mobility), then vitality / armor. */
+static int cand_cmp(const void* pa, const void* pb)
+{
+    const SearchCand* a = (const SearchCand*) pa;
+    const SearchCand* b = (const SearchCand*) pb;
+    int ka = a->c.v[ROGUE_LOADOUT_CH_WEAPON_DAMAGE], kb = b->c.v[ROGUE_LOADOUT_CH_WEAPON_DAMAGE];
+    if (ka != kb)
+        return kb - ka;
+    ka = cand_dex(&a->c);
+    kb = cand_dex(&b->c);
+    if (ka != kb)
+        return kb - ka;
+    ka = cand_vit(&a->c) + a->c.v[ROGUE_LOADOUT_CH_BASE_ARMOR];
+    kb = cand_vit(&b->c) + b->c.v[ROGUE_LOADOUT_CH_BASE_ARMOR];
+    if (ka != kb)
+        return kb - ka;
+    return a->inst - b->inst;
+}
+
+static int max_int(int a, int b) { return a > b ? a : b; }
+
+static void cand_rank_values(const RogueLoadoutContrib* c, int* v)
+{
+    v[SEARCH_RANK_DEX] = cand_dex(c);
+    v[SEARCH_RANK_DEX_PCT] = c->v[ROGUE_LOADOUT_CH_GEM_PCT_DEX];
+    v[SEARCH_RANK_VIT] = cand_vit(c);
+    v[SEARCH_RANK_VIT_PCT] = c->v[ROGUE_LOADOUT_CH_GEM_PCT_VIT];
+    v[SEARCH_RANK_ARMOR] = c->v[ROGUE_LOADOUT_CH_BASE_ARMOR];
+}
+
+static int rank_cmp(const void* pa, const void* pb)
+{
+    const SearchRank* a = (const SearchRank*) pa;
+    const SearchRank* b = (const SearchRank*) pb;
+    if (a->value != b->value)
+        return b->value - a->value;
+    return a->inst - b->inst;
+}
+
+/* Upper bound on the set layer: for every set among the candidates and fixed slots, the best
+ * bonus at any piece count (never below zero). */
+static void set_bound_add(SearchProblem* p, int set_id, int* seen, int* seen_n)
+{
+    if (set_id < 0 || !rogue_set_find(set_id))
+        return;
+    for (int k = 0; k < *seen_n; k++)
+        if (seen[k] == set_id)
+            return;
+    if (*seen_n >= 64)
+        return;
+    seen[(*seen_n)++] = set_id;
+    int best_dex = 0, best_vit = 0;
+    for (int n = 1; n <= ROGUE_EQUIP_SLOT_COUNT; n++)
+    {
+        int str = 0, dex = 0, vit = 0, intel = 0, armor = 0, r[6] = {0};
+        rogue_set_preview_apply(set_id, n, &str, &dex, &vit, &intel, &armor, &r[1], &r[2], &r[3],
+                                &r[4], &r[5], &r[0]);
+        best_dex = max_int(best_dex, dex);
+        best_vit = max_int(best_vit, vit);
+    }
+    p->set_dex_ub += best_dex;
+    p->set_vit_ub += best_vit;
+}
+
+static void set_bounds(SearchProblem* p)
+{
+    int seen[64];
+    int seen_n = 0;
+    p->set_dex_ub = p->set_vit_ub = 0;
+    for (int s = 0; s < ROGUE_EQUIP_SLOT_COUNT; s++)
+    {
+        for (int i = 0; i < p->ncand[s]; i++)
+            if (p->cand[s][i].c.occupied)
+                set_bound_add(p, p->cand[s][i].c.set_id, seen, &seen_n);
+        if (p->fixed.inst[s] >= 0)
+        {
+            RogueLoadoutContrib c;
+            rogue_loadout_item_contrib((enum RogueEquipSlot) s, p->fixed.inst[s], &c);
+            set_bound_add(p, c.set_id, seen, &seen_n);
+        }
+    }
+}
+
+static int build_problem(SearchProblem* p, const RogueLoadoutSearchParams* params)
+{
+    extern RoguePlayer g_exposed_player_for_stats;
+    RogueLoadout cur;
+    memset(p, 0, sizeof *p);
+    p->params = *params;
+    if (p->params.top_k <= 0)
+        p->params.top_k = 1;
+    if (p->params.top_k > ROGUE_LOADOUT_SEARCH_MAX_K)
+        p->params.top_k = ROGUE_LOADOUT_SEARCH_MAX_K;
+    unsigned int mask = params->slot_mask ? params->slot_mask : (1u << ROGUE_EQUIP_SLOT_COUNT) - 1u;
+    if (g_player_stat_cache.dirty)
+    {
+        rogue_equipment_apply_stat_bonuses(&g_exposed_player_for_stats);
+        rogue_stat_cache_force_update(&g_exposed_player_for_stats);
+    }
+    rogue_loadout_base_from_player(&g_exposed_player_for_stats, &p->base);
+    rogue_loadout_from_equipped(&cur);
+    p->item_cap = rogue_items_capacity();
+    p->crit_mult =
+        1.0f + ((float) p->base.crit_chance / 100.0f) * ((float) p->base.crit_damage / 100.0f);
+    /* search order: weapon first (largest DPS lever), then the remaining slots in enum order */
+    p->weapon_depth = -1;
+    for (int s = 0; s < ROGUE_EQUIP_SLOT_COUNT; s++)
+    {
+        p->fixed.inst[s] = (mask & (1u << s)) ? -1 : cur.inst[s];
+        if (mask & (1u << s))
+        {
+            if (s == ROGUE_EQUIP_WEAPON)
+                p->weapon_depth = p->depth_count;
+            p->order[p->depth_count++] = s;
+        }
+    }
+    int fixed_offhand = p->fixed.inst[ROGUE_EQUIP_OFFHAND] >= 0;
+    int fixed_twohand = p->fixed.inst[ROGUE_EQUIP_WEAPON] >= 0 &&
+                        rogue_equip_item_is_two_handed(p->fixed.inst[ROGUE_EQUIP_WEAPON]);
+    for (int d = 0; d < p->depth_count; d++)
+    {
+        int slot = p->order[d];
+        SearchCand* list =
+            (SearchCand*) malloc(sizeof(SearchCand) * (ROGUE_LOADOUT_SEARCH_MAX_CANDIDATES + 1));
+        if (!list)
+            return -1;
+        p->cand[slot] = list;
+        int n = 0;
+        /* the empty option always exists so bounds and constraints stay well defined */
+        list[n].inst = -1;
+        list[n].twohand = 0;
+        list[n].code = (unsigned short) slot_group(slot);
+        list[n].term = mix64(0x51u + list[n].code);
+        rogue_loadout_item_contrib((enum RogueEquipSlot) slot, -1, &list[n].c);
+        n++;
+        if (!(slot == ROGUE_EQUIP_OFFHAND && fixed_twohand))
+        {
+            for (int i = 0; i < p->item_cap && n <= ROGUE_LOADOUT_SEARCH_MAX_CANDIDATES; i++)
+            {
+                const RogueItemInstance* it = rogue_item_instance_at(i);
+                const RogueItemDef* d2 = it ? rogue_item_def_at(it->def_index) : NULL;
+                if (!d2 || (int) d2->category != slot_category(slot))
+                    continue;
+                int in_fixed = 0;
+                for (int s = 0; s < ROGUE_EQUIP_SLOT_COUNT && !in_fixed; s++)
+                    in_fixed = p->fixed.inst[s] == i;
+                if (in_fixed)
+                    continue;
+                int twohand = slot == ROGUE_EQUIP_WEAPON && rogue_equip_item_is_two_handed(i);
+                if (twohand && fixed_offhand)
+                    continue; /* would displace an offhand the caller asked to keep */
+                int cls = item_class(p, i, twohand);
+                if (cls < 0)
+                    return -1;
+                list[n].inst = i;
+                list[n].twohand = twohand;
+                list[n].code = (unsigned short) ((cls + 1) * 4 + slot_group(slot));
+                list[n].term = mix64(0x51u + list[n].code);
+                rogue_loadout_item_contrib((enum RogueEquipSlot) slot, i, &list[n].c);
+                n++;
+            }
+        }
+        qsort(list, (size_t) n, sizeof *list, cand_cmp);
+        p->ncand[slot] = n;
+    }
+    /* open-slot counts per depth, weapon bounds, and the ranked non-weapon pool */
+    size_t pool = p->item_cap > 0 ? (size_t) p->item_cap : 1u;
+    for (int r = 0; r < SEARCH_RANK__COUNT; r++)
+    {
+        p->rank[r] = (SearchRank*) malloc(sizeof(SearchRank) * pool);
+        if (!p->rank[r])
+            return -1;
+    }
+    unsigned char* seen = (unsigned char*) calloc(pool, 1);
+    if (!seen)
+        return -1;
+    p->weapon_ub = 3;
+    for (int d = p->depth_count - 1; d >= 0; d--)
+    {
+        int slot = p->order[d];
+        int group = slot_group(slot);
+        p->open_slots[d] = p->open_slots[d + 1] + (group != 0);
+        p->open_armored[d] = p->open_armored[d + 1] + (group == 1);
+        for (int i = 0; i < p->ncand[slot]; i++)
+        {
+            const SearchCand* c = &p->cand[slot][i];
+            int v[SEARCH_RANK__COUNT];
+            if (c->inst < 0)
+                continue;
+            if (group == 0)
+            {
+                cand_rank_values(&c->c, v);
+                for (int r = 0; r < SEARCH_RANK__COUNT; r++)
+                    p->weapon_rank_ub[r] = max_int(p->weapon_rank_ub[r], v[r]);
+                p->weapon_ub = max_int(p->weapon_ub, c->c.v[ROGUE_LOADOUT_CH_WEAPON_DAMAGE]);
+                continue;
+            }
+            if (seen[c->inst])
+                continue;
+            seen[c->inst] = 1;
+            RogueLoadoutContrib armored;
+            rogue_loadout_item_contrib(ROGUE_EQUIP_ARMOR_HEAD, c->inst, &armored);
+            cand_rank_values(&armored, v);
+            for (int r = 0; r < SEARCH_RANK__COUNT; r++)
+                if (v[r] > 0)
+                {
+                    p->rank[r][p->nrank[r]].value = v[r];
+                    p->rank[r][p->nrank[r]].inst = c->inst;
+                    p->nrank[r]++;
+                }
+        }
+    }
+    free(seen);
+    for (int r = 0; r < SEARCH_RANK__COUNT; r++)
+        qsort(p->rank[r], (size_t) p->nrank[r], sizeof(SearchRank), rank_cmp);
+    set_bounds(p);
+    /* visited set sized to the candidate space (power of two, bounded) */
+    unsigned long total = 0;
+    for (int d = 0; d < p->depth_count; d++)
+        total += (unsigned long) p->ncand[p->order[d]];
+    unsigned int cap = SEARCH_VISITED_MIN;
+    while (cap < SEARCH_VISITED_MAX && (unsigned long) cap < total * 512ul)
+        cap <<= 1;
+    p->visited = (void**) calloc(cap, sizeof(void*));
+    p->visited_mask = p->visited ? cap - 1u : 0u;
+    search_atomic_set(&p->next_task, 0);
+    search_atomic_set(&p->floor_dps, INT_MIN);
+    search_atomic_set(&p->nodes, 0);
+    search_atomic_set(&p->abort, 0);
+    return 0;
+}
+
+static void free_problem(SearchProblem* p)
+{
+    for (int s = 0; s < ROGUE_EQUIP_SLOT_COUNT; s++)
+        free(p->cand[s]);
+    for (int r = 0; r < SEARCH_RANK__COUNT; r++)
+        free(p->rank[r]);
+    free(p->classes);
+    free(p->visited);
+}
+
+/* Next free record in the worker's arena (not yet published), NULL when out of memory. */
+static SearchVisited* visited_record(SearchWorker* w)
+{
+    if (!w->arena || w->arena->used == SEARCH_ARENA_RECORDS)
+    {
+        SearchArena* a = (SearchArena*) malloc(sizeof *a);
+        if (!a)
+            return NULL;
+        a->next = w->arena;
+        a->used = 0;
+        w->arena = a;
+    }
+    return &w->arena->rec[w->arena->used];
+}
+
+static void free_arenas(SearchWorker* w)
+{
+    while (w->arena)
+    {
+        SearchArena* next = w->arena->next;
+        free(w->arena);
+        w->arena = next;
+    }
+}
+
+/* Lock-free insert of the partial loadout placed through depth; returns 1 only if an identical
+ * one (same key, depth and sorted codes) was already present. A full probe window or a failed
+ * allocation reports "new" (the subtree is simply searched again), so saturation never loses
+ * results. Records are fully written before the CAS publishes them. */
+static int visited_check_insert(SearchWorker* w, unsigned long long key, int depth)
+{
+    SearchProblem* p = w->p;
+    if (!p->visited)
+        return 0;
+    SearchVisited* rec = visited_record(w);
+    if (!rec)
+        return 0;
+    rec->key = key;
+    rec->depth = depth;
+    for (int d = 0; d <= depth; d++)
+    {
+        unsigned short v = w->codes[d];
+        int j = d;
+        for (; j > 0 && rec->sig[j - 1] > v; j--)
+            rec->sig[j] = rec->sig[j - 1];
+        rec->sig[j] = v;
+    }
+    size_t sig_bytes = sizeof(rec->sig[0]) * (size_t) (depth + 1);
+    unsigned int idx = (unsigned int) key & p->visited_mask;
+    for (int probe = 0; probe < SEARCH_VISITED_PROBES; probe++)
+    {
+        void** slot = &p->visited[(idx + (unsigned int) probe) & p->visited_mask];
+        const SearchVisited* cur = (const SearchVisited*) search_ptr_get(slot);
+        if (!cur)
+        {
+            if (search_ptr_cas(slot, NULL, rec))
+            {
+                w->arena->used++;
+                return 0;
+            }
+            cur = (const SearchVisited*) search_ptr_get(slot);
+        }
+        if (cur->key == key && cur->depth == depth && memcmp(cur->sig, rec->sig, sig_bytes) == 0)
+            return 1;
+    }
+    return 0;
+}
+
+/* Sum of the r best pool values whose instance is still unused. */
+static int top_unused(const SearchProblem* p, int rank, int r, const unsigned char* used)
+{
+    int total = 0;
+    for (int i = 0; i < p->nrank[rank] && r > 0; i++)
+    {
+        if (used[p->rank[rank][i].inst])
+            continue;
+        total += p->rank[rank][i].value;
+        r--;
+    }
+    return total;
+}
+
+static int rem_bound(const SearchWorker* w, int depth, int rank)
+{
+    const SearchProblem* p = w->p;
+    int open = rank == SEARCH_RANK_ARMOR ? p->open_armored[depth] : p->open_slots[depth];
+    int v = top_unused(p, rank, open, w->used);
+    if (p->weapon_depth >= depth)
+        v += p->weapon_rank_ub[rank];
+    return v;
+}
+
+/* 1 when no completion of the current partial loadout (next slot at depth) can make the cut. */
+static int prune_bound(SearchWorker* w, int depth)
+{
+    const SearchProblem* p = w->p;
+    const RogueLoadoutBaseState* b = &p->base;
+    const int* sum = w->ctx.sum;
+    int dex_pct = sum[ROGUE_LOADOUT_CH_GEM_PCT_DEX] + rem_bound(w, depth, SEARCH_RANK_DEX_PCT);
+    int dex_ub = b->dexterity + b->passive_dexterity + p->set_dex_ub + cand_dex_sum(sum) +
+                 rem_bound(w, depth, SEARCH_RANK_DEX) +
+                 (dex_pct > 0 && b->dexterity > 0 ? (b->dexterity * dex_pct) / 100 : 0);
+    int mob_ub = (int) (100 + (float) dex_ub * 1.5f);
+    if (mob_ub < p->params.min_mobility)
+        return 1;
+    int wd = p->weapon_depth >= depth                ? p->weapon_ub
+             : w->ctx.slot_used[ROGUE_EQUIP_WEAPON] ? sum[ROGUE_LOADOUT_CH_WEAPON_DAMAGE]
+                                                    : 3;
+    float ds = 1.0f + (float) dex_ub / 50.0f;
+    int dps_ub = ds > 0.0f ? (int) ((float) wd * ds * p->crit_mult) : 0;
+    /* DPS is the objective: a subtree that cannot beat the K-th DPS cannot change the top-K DPS
+     * values (equal-DPS completions are not explored, so EHP order among ties is best effort) */
+    int floor = search_atomic_get((SearchAtomic*) &p->floor_dps);
+    if (floor != INT_MIN && dps_ub <= floor)
+        return 1;
+    if (w->top_count >= p->params.top_k && dps_ub <= w->top[w->top_count - 1].sc.dps)
+        return 1;
+    int vit_pct = sum[ROGUE_LOADOUT_CH_GEM_PCT_VIT] + rem_bound(w, depth, SEARCH_RANK_VIT_PCT);
+    int vit_ub = b->vitality + b->passive_vitality + p->set_vit_ub + cand_vit_sum(sum) +
+                 rem_bound(w, depth, SEARCH_RANK_VIT) +
+                 (vit_pct > 0 && b->vitality > 0 ? (b->vitality * vit_pct) / 100 : 0);
+    int armor_ub = sum[ROGUE_LOADOUT_CH_BASE_ARMOR] + rem_bound(w, depth, SEARCH_RANK_ARMOR);
+    int max_hp_ub = b->max_health + armor_ub * 2;
+    if (max_hp_ub <= 0)
+        return 0;
+    float vs = 1.0f + (float) vit_ub / 200.0f;
+    return max_int(max_hp_ub, (int) ((float) max_hp_ub * vs)) < p->params.min_ehp;
+}
+
+static int entry_better(const SearchEntry* a, const SearchEntry* b)
+{
+    if (a->sc.dps != b->sc.dps)
+        return a->sc.dps > b->sc.dps;
+    if (a->sc.ehp != b->sc.ehp)
+        return a->sc.ehp > b->sc.ehp;
+    if (a->sc.mobility != b->sc.mobility)
+        return a->sc.mobility > b->sc.mobility;
+    return memcmp(a->lo.inst, b->lo.inst, sizeof a->lo.inst) < 0;
+}
+
+static void publish_floor(SearchProblem* p, int v)
+{
+    for (;;)
+    {
+        int old = search_atomic_get(&p->floor_dps);
+        if (old != INT_MIN && old >= v)
+            return;
+        if (search_atomic_cas(&p->floor_dps, old, v))
+            return;
+    }
+}
+
+static void leaf(SearchWorker* w)
+{
+    SearchProblem* p = w->p;
+    SearchEntry e;
+    rogue_loadout_eval_score(&w->ctx, &e.sc);
+    if (e.sc.mobility < p->params.min_mobility || e.sc.ehp < p->params.min_ehp)
+        return;
+    e.lo = w->ctx.loadout;
+    int k = p->params.top_k;
+    if (w->top_count >= k && !entry_better(&e, &w->top[k - 1]))
+        return;
+    int pos = w->top_count < k ? w->top_count++ : k - 1;
+    while (pos > 0 && entry_better(&e, &w->top[pos - 1]))
+    {
+        w->top[pos] = w->top[pos - 1];
+        pos--;
+    }
+    w->top[pos] = e;
+    if (w->top_count >= k)
+        publish_floor(p, w->top[k - 1].sc.dps);
+}
+
+static int count_node(SearchWorker* w)
+{
+    SearchProblem* p = w->p;
+    w->nodes++;
+    if (++w->pending_nodes < SEARCH_NODE_BATCH)
+        return 0;
+    int total = search_atomic_add(&p->nodes, w->pending_nodes) + w->pending_nodes;
+    w->pending_nodes = 0;
+    if (p->params.max_nodes > 0 && total >= p->params.max_nodes)
+        search_atomic_set(&p->abort, 1);
+    return search_atomic_get(&p->abort);
+}
+
+static void search_depth(SearchWorker* w, int depth);
+
+/* Place cand at depth, recurse if the subtree survives bounds + visited set, then undo. */
+static void expand(SearchWorker* w, int depth, const SearchCand* c)
+{
+    SearchProblem* p = w->p;
+    int slot = p->order[depth];
+    static const RogueLoadoutContrib empty = {{0}, 0, 0};
+    rogue_loadout_eval_set_slot_contrib(&w->ctx, (enum RogueEquipSlot) slot, c->inst, &c->c);
+    if (c->inst >= 0)
+        w->used[c->inst] = 1;
+    w->key += c->term;
+    w->codes[depth] = c->code;
+    if (!count_node(w))
+    {
+        if (prune_bound(w, depth + 1))
+            w->pruned_bound++;
+        else if (depth >= 1 &&
+                 visited_check_insert(w, w->key ^ mix64(0xD00Dull + (unsigned long long) depth),
+                                      depth))
+            w->pruned_visited++;
+        else
+            search_depth(w, depth + 1);
+    }
+    w->key -= c->term;
+    if (c->inst >= 0)
+        w->used[c->inst] = 0;
+    rogue_loadout_eval_set_slot_contrib(&w->ctx, (enum RogueEquipSlot) slot, -1, &empty);
+}
+
+static void search_depth(SearchWorker* w, int depth)
+{
+    SearchProblem* p = w->p;
+    if (depth == p->depth_count)
+    {
+        leaf(w);
+        return;
+    }
+    int slot = p->order[depth];
+    int weapon_twohand = slot == ROGUE_EQUIP_OFFHAND && w->ctx.slot_used[ROGUE_EQUIP_WEAPON] &&
+                         rogue_equip_item_is_two_handed(w->ctx.loadout.inst[ROGUE_EQUIP_WEAPON]);
+    for (int i = 0; i < p->ncand[slot]; i++)
+    {
+        const SearchCand* c = &p->cand[slot][i];
+        if (c->inst >= 0 && (weapon_twohand || w->used[c->inst]))
+            continue;
+        if (search_atomic_get(&p->abort))
+            return;
+        expand(w, depth, c);
+    }
+}
+
+static void worker_run(SearchWorker* w)
+{
+    SearchProblem* p = w->p;
+    if (p->depth_count == 0)
+    {
+        if (search_atomic_add(&p->next_task, 1) == 0)
+            leaf(w);
+        return;
+    }
+    int slot0 = p->order[0];
+    for (;;)
+    {
+        int t = search_atomic_add(&p->next_task, 1);
+        if (t >= p->ncand[slot0] || search_atomic_get(&p->abort))
+            break;
+        expand(w, 0, &p->cand[slot0][t]);
+    }
+    search_atomic_add(&p->nodes, w->pending_nodes);
+    w->pending_nodes = 0;
+}
+
+#if defined(ROGUE_HAVE_SDL)
+static int worker_thread(void* ud)
+{
+    worker_run((SearchWorker*) ud);
+    return 0;
+}
+#endif
+
+static double search_now_ms(void)
+{
+#if defined(ROGUE_HAVE_SDL)
+    return (double) SDL_GetPerformanceCounter() * 1000.0 / (double) SDL_GetPerformanceFrequency();
+#else
+    return (double) clock() * 1000.0 / (double) CLOCKS_PER_SEC;
+#endif
+}
+
+int rogue_loadout_search(const RogueLoadoutSearchParams* params, RogueLoadoutSearchResult* out)
+{
+    if (!params || !out)
+        return -1;
+    memset(out, 0, sizeof *out);
+    double t0 = search_now_ms();
+    SearchProblem* p = (SearchProblem*) malloc(sizeof *p);
+    if (!p)
+        return -2;
+    if (build_problem(p, params) != 0)
+    {
+        free_problem(p);
+        free(p);
+        return -2;
+    }
+    int workers = params->workers;
+#if defined(ROGUE_HAVE_SDL)
+    if (workers <= 0)
+        workers = SDL_GetCPUCount();
+#endif
+    if (workers <= 0)
+        workers = 1;
+    if (workers > ROGUE_LOADOUT_SEARCH_MAX_WORKERS)
+        workers = ROGUE_LOADOUT_SEARCH_MAX_WORKERS;
+    SearchWorker* ws = (SearchWorker*) calloc((size_t) workers, sizeof *ws);
+    if (!ws)
+    {
+        free_problem(p);
+        free(p);
+        return -2;
+    }
+    for (int i = 0; i < workers; i++)
+    {
+        ws[i].p = p;
+        ws[i].used = (unsigned char*) calloc(p->item_cap > 0 ? (size_t) p->item_cap : 1u, 1);
+        if (!ws[i].used)
+        {
+            for (int j = 0; j < i; j++)
+                free(ws[j].used);
+            free(ws);
+            free_problem(p);
+            free(p);
+            return -2;
+        }
+        rogue_loadout_eval_init(&ws[i].ctx, &p->base, &p->fixed);
+        for (int s = 0; s < ROGUE_EQUIP_SLOT_COUNT; s++)
+            if (p->fixed.inst[s] >= 0 && p->fixed.inst[s] < p->item_cap)
+                ws[i].used[p->fixed.inst[s]] = 1;
+    }
+#if defined(ROGUE_HAVE_SDL)
+    SDL_Thread* threads[ROGUE_LOADOUT_SEARCH_MAX_WORKERS] = {0};
+    for (int i = 1; i < workers; i++)
+        threads[i] = SDL_CreateThread(worker_thread, "loadout_search", &ws[i]);
+    worker_run(&ws[0]);
+    for (int i = 1; i < workers; i++)
+    {
+        if (threads[i])
+            SDL_WaitThread(threads[i], NULL);
+        else
+            worker_run(&ws[i]); /* thread creation failed: drain remaining tasks here */
+    }
+#else
+    for (int i = 0; i < workers; i++)
+        worker_run(&ws[i]);
+#endif
+    /* merge per-worker top-K */
+    int k = p->params.top_k;
+    for (int i = 0; i < workers; i++)
+    {
+        for (int j = 0; j < ws[i].top_count; j++)
+        {
+            const SearchEntry* e = &ws[i].top[j];
+            int pos = out->count < k ? out->count : k;
+            if (pos == k)
+            {
+                SearchEntry last = {out->loadouts[k - 1], out->scores[k - 1]};
+                if (!entry_better(e, &last))
+                    continue;
+                pos = k - 1;
+            }
+            else
+                out->count++;
+            while (pos > 0)
+            {
+                SearchEntry prev = {out->loadouts[pos - 1], out->scores[pos - 1]};
+                if (!entry_better(e, &prev))
+                    break;
+                out->loadouts[pos] = out->loadouts[pos - 1];
+                out->scores[pos] = out->scores[pos - 1];
+                pos--;
+            }
+            out->loadouts[pos] = e->lo;
+            out->scores[pos] = e->sc;
+        }
+        out->nodes += ws[i].nodes;
+        out->pruned_bound += ws[i].pruned_bound;
+        out->pruned_visited += ws[i].pruned_visited;
+    }
+    for (int i = 0; i < workers; i++)
+    {
+        free_arenas(&ws[i]);
+        free(ws[i].used);
+    }
+    out->exhaustive = search_atomic_get(&p->abort) ? 0 : 1;
+    out->workers = workers;
+    out->visited_capacity = p->visited ? (int) p->visited_mask + 1 : 0;
+    for (int s = 0; s < ROGUE_EQUIP_SLOT_COUNT; s++)
+        out->candidates[s] = p->ncand[s];
+    free(ws);
+    free_problem(p);
+    free(p);
+    out->ms = search_now_ms() - t0;
+    return 0;
+}
+
+int rogue_loadout_search_apply(const RogueLoadout* loadout)
+{
+    if (!loadout)
+        return -1;
+    int changed = 0;
+    for (int s = 0; s < ROGUE_EQUIP_SLOT_COUNT; s++)
+    {
+        int want = loadout->inst[s];
+        if (rogue_equip_get((enum RogueEquipSlot) s) == want)
+            continue;
+        if (want < 0)
+            rogue_equip_unequip((enum RogueEquipSlot) s);
+        else if (rogue_equip_try((enum RogueEquipSlot) s, want) != 0)
+            continue;
+        changed++;
+    }
+    return changed;
+}
@@ -0,0 +1,59 @@
+/* Parallel exact loadout search (Equipment Phase 9 / 14.4 follow-up).
+ *
+ * Branch-and-bound over slots (weapon first) using the pure evaluator in loadout_eval.h. Nodes
+ * are pruned with upper bounds for the open slots (best unused pool values for dexterity /
+ * vitality / armor plus the best weapon damage; DPS, mobility and EHP are monotone in those)
+ * against the constraints and the shared top-K floor.
+ * Equivalent partial loadouts (same items placed in interchangeable slots, or identical items) are
+ * collapsed through a shared lock-free visited set sized to the candidate space; entries are
+ * compared by their exact item classes, so hash collisions cost probes but never prune. Top-level
+ * branches (weapon choices) are handed to worker threads through an atomic cursor; each worker
+ * keeps its own top-K and publishes its K-th best DPS as the shared pruning floor. The top-K DPS
+ * values are exact; which of several equal-DPS loadouts fills the last places is not specified.
+ *
+ * Workers are SDL threads when ROGUE_HAVE_SDL is set; otherwise the search runs on the caller.
+ * The search only reads item registries and never touches live equipment; apply a result with
+ * rogue_loadout_search_apply on the owning thread. */
+#ifndef ROGUE_LOADOUT_SEARCH_H
+#define ROGUE_LOADOUT_SEARCH_H
+
+#include "loadout_eval.h"
+
+#define ROGUE_LOADOUT_SEARCH_MAX_K 16
+#define ROGUE_LOADOUT_SEARCH_MAX_WORKERS 8
+#define ROGUE_LOADOUT_SEARCH_MAX_CANDIDATES 256 /* per slot, excluding the empty option */
+
+typedef struct RogueLoadoutSearchParams
+{
+    int min_mobility;
+    int min_ehp;
+    int top_k;              /* 1..ROGUE_LOADOUT_SEARCH_MAX_K (0 = 1) */
+    int workers;            /* 0 = one per CPU (capped); 1 = caller thread only */
+    unsigned int slot_mask; /* bit per slot the search may change (0 = all); others stay equipped */
+    long max_nodes;         /* 0 = exhaustive; otherwise stop after roughly this many nodes */
+} RogueLoadoutSearchParams;
+
+typedef struct RogueLoadoutSearchResult
+{
+    int count; /* loadouts found satisfying the constraints (<= top_k) */
+    RogueLoadout loadouts[ROGUE_LOADOUT_SEARCH_MAX_K];
+    RogueLoadoutScore scores[ROGUE_LOADOUT_SEARCH_MAX_K]; /* DPS desc (EHP among found ties) */
+    int exhaustive; /* 1 when the search space was fully covered (result is optimal) */
+    int workers;
+    long nodes;          /* partial loadouts expanded */
+    long pruned_bound;   /* subtrees cut by upper bounds */
+    long pruned_visited; /* subtrees skipped as equivalent to one already visited */
+    int visited_capacity;
+    int candidates[ROGUE_EQUIP_SLOT_COUNT]; /* options per slot (including empty) */
+    double ms;
+} RogueLoadoutSearchResult;
+
+/* Run the search from the current equipment / player state. Returns 0 on success (out->count
+ * may be 0 if nothing satisfies the constraints), negative on bad arguments / allocation
+ * failure. */
+int rogue_loadout_search(const RogueLoadoutSearchParams* params, RogueLoadoutSearchResult* out);
+
+/* Equip a searched loadout (weapon first so two-handed rules apply). Returns slots changed. */
+int rogue_loadout_search_apply(const RogueLoadout* loadout);
+
+#endif
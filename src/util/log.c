@@ -24,15 +24,117 @@ SOFTWARE.
 
 /**
  * @file log.c
- * @brief Cross-platform logging utility with configurable levels and environment override.
- * @details This module provides a simple logging system with different severity levels,
- * platform-specific implementations for MSVC vs POSIX, and environment variable configuration.
+ * @brief Cross-platform logging utility with levels, categories, rate limiting and an async sink.
+ * @details This module provides the logging system behind util/log.h: per-category thresholds the
+ * call-site macros test inline, environment configuration, per call site rate limiting and an
+ * optional asynchronous mode. In async mode each logging thread claims a slot holding a
+ * single-producer / single-consumer ring of records; the message text is formatted on the caller
+ * (its arguments may not outlive the call) while the "[LEVEL] file:line: " prefix and the stdio
+ * write are deferred to the consumer, whichever thread holds the drain lock: the SDL writer thread,
+ * a producer finding its ring filling up, or rogue_log_flush. Slots are released like the
+ * profiler's (profiler.c): through an SDL TLS destructor when the thread exits.
  */
 
 #include "log.h"
+#include "profiler.h"
 #include <stdarg.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#endif
+#if defined(ROGUE_HAVE_SDL)
+#include <SDL.h>
+#endif
+
+/* ---- Portable atomics on plain ints (same scheme as profiler.c) ---- */
+#if defined(_MSC_VER)
+#define log_load(p) ((int) InterlockedCompareExchange((volatile LONG*) (p), 0, 0))
+#define log_store(p, v) InterlockedExchange((volatile LONG*) (p), (LONG) (v))
+#define log_cas(p, o, n)                                                                           \
+    (InterlockedCompareExchange((volatile LONG*) (p), (LONG) (n), (LONG) (o)) == (LONG) (o))
+#define LOG_TLS __declspec(thread)
+#else
+#define log_load(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define log_store(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+static int log_cas_int(int* p, int expected, int desired)
+{
+    return __atomic_compare_exchange_n(p, &expected, desired, 0, __ATOMIC_ACQ_REL,
+                                       __ATOMIC_ACQUIRE);
+}
+#define log_cas(p, o, n) log_cas_int((p), (o), (n))
+#define LOG_TLS __thread
+#endif
+
+#define RING_MASK (ROGUE_LOG_RING_RECORDS - 1)
+#define RATE_SLOTS 256 /* call sites tracked by the rate limiter, power of two */
+#define RATE_PROBE 8
+#define RATE_WINDOW_NS 1000000000ull
+#define WRITER_POLL_MS 2
+
+enum
+{
+    SLOT_FREE = 0,
+    SLOT_CLAIMING,
+    SLOT_LIVE,
+    SLOT_RETIRED
+};
+
+typedef struct LogRecord
+{
+    const char* file; /* __FILE__ literal: static storage, safe to format later */
+    int line;
+    int level;
+    unsigned dropped; /* messages the rate limiter muted at this site before this one */
+    char msg[ROGUE_LOG_RECORD_CAP];
+} LogRecord;
+
+typedef struct LogThread
+{
+    LogRecord ring[ROGUE_LOG_RING_RECORDS];
+    int head;  /* written by the owner (release) */
+    int tail;  /* written by the consumer (release) */
+    int state; /* SLOT_* */
+} LogThread;
+
+typedef struct RateSite
+{
+    const char* file;
+    int line;
+    uint64_t window_ns;
+    unsigned count;
+    unsigned dropped;
+} RateSite;
+
+int g_rogue_log_threshold[ROGUE_LOG_CAT_COUNT]; /* all DEBUG until the first init */
+
+/* Internal linkage for single TU static state */
+static RogueLogLevel s_global_level = ROGUE_LOG_WARN_LEVEL;
+static int s_cat_level[ROGUE_LOG_CAT_COUNT]; /* -1 = follow the global level (set by init) */
+static int s_init;                            /* environment applied */
+static int s_cfg_lock;
+static int s_rate_limit = ROGUE_LOG_DEFAULT_RATE_LIMIT;
+static RateSite s_sites[RATE_SLOTS];
+static int s_rate_lock;
+static unsigned long long s_suppressed;
+static FILE* s_sink; /* NULL = stdout / stderr */
+
+static LogThread s_threads[ROGUE_LOG_MAX_THREADS];
+static LOG_TLS LogThread* t_self;
+static LOG_TLS int t_no_slot;
+static int s_async;
+static int s_drain_lock;
+#if defined(ROGUE_HAVE_SDL)
+static SDL_TLSID s_tls_id;
+static int s_tls_ready;
+static SDL_Thread* s_writer;
+static int s_writer_run;
+#endif
+
+static const char* s_cat_names[ROGUE_LOG_CAT_COUNT] = {
+    "general", "events", "render", "audio", "worldgen", "ai", "loot", "dialogue", "persist", "ui"};
 
 /**
  * @brief Converts a log level enum to its string representation.
@@ -40,7 +142,7 @@ SOFTWARE.
  * @return String representation of the log level.
  * @details Used internally for formatting log messages.
  */
-static const char* level_to_str(RogueLogLevel lvl)
+static const char* level_to_str(int lvl)
 {
     switch (lvl)
     {
@@ -57,8 +159,14 @@ static const char* level_to_str(RogueLogLevel lvl)
     }
 }
 
-/* Internal linkage for single TU static state */
-static RogueLogLevel s_global_level = ROGUE_LOG_WARN_LEVEL;
+static void spin_lock(int* lock)
+{
+    while (!log_cas(lock, 0, 1))
+    {
+    }
+}
+static int spin_trylock(int* lock) { return log_cas(lock, 0, 1); }
+static void spin_unlock(int* lock) { log_store(lock, 0); }
 
 /* Platform helpers */
 
@@ -89,34 +197,345 @@ static const char* rogue_getenv_safe(const char* name)
 }
 
 /**
- * @brief Performs case-insensitive string comparison.
+ * @brief Performs case-insensitive comparison of at most n characters.
  * @param a First string to compare.
  * @param b Second string to compare.
+ * @param n Maximum number of characters compared.
  * @return Negative if a < b, 0 if equal, positive if a > b (case-insensitive).
  * @details Provides portable case-insensitive comparison for MSVC and POSIX.
  */
-static int rogue_stricmp(const char* a, const char* b)
+static int rogue_strnicmp(const char* a, const char* b, size_t n)
 {
-#ifdef _MSC_VER
-    return _stricmp(a, b);
-#else
-    /* simple portable case-insensitive compare */
-    unsigned char ca, cb;
-    while (*a && *b)
+    for (; n; --n, ++a, ++b)
     {
-        ca = (unsigned char) *a;
-        cb = (unsigned char) *b;
+        unsigned char ca = (unsigned char) *a, cb = (unsigned char) *b;
         if (ca >= 'A' && ca <= 'Z')
             ca = (unsigned char) (ca - 'A' + 'a');
         if (cb >= 'A' && cb <= 'Z')
             cb = (unsigned char) (cb - 'A' + 'a');
-        if (ca != cb)
+        if (ca != cb || !ca)
             return (int) ca - (int) cb;
-        ++a;
-        ++b;
     }
-    return (int) ((unsigned char) *a) - (int) ((unsigned char) *b);
+    return 0;
+}
+
+/**
+ * @brief Parses a level name or digit.
+ * @param s Start of the level text (not necessarily terminated after it).
+ * @param n Length of the level text.
+ * @return The level (0..3) or -1 when unrecognized.
+ */
+static int parse_level(const char* s, size_t n)
+{
+    static const char* names[] = {"debug", "info", "warn", "error"};
+    if (n == 1 && s[0] >= '0' && s[0] <= '3')
+        return s[0] - '0';
+    if (n == 7 && !rogue_strnicmp(s, "warning", 7))
+        return ROGUE_LOG_WARN_LEVEL;
+    for (int i = 0; i < 4; i++)
+        if (strlen(names[i]) == n && !rogue_strnicmp(s, names[i], n))
+            return i;
+    return -1;
+}
+
+/* Caller holds s_cfg_lock. */
+static void recompute_thresholds(void)
+{
+    for (int i = 0; i < ROGUE_LOG_CAT_COUNT; i++)
+        g_rogue_log_threshold[i] = s_cat_level[i] >= 0 ? s_cat_level[i] : (int) s_global_level;
+}
+
+/* Applies one "name=level" list; caller holds s_cfg_lock. */
+static int apply_categories(const char* spec)
+{
+    int applied = 0;
+    while (spec && *spec)
+    {
+        size_t len = strcspn(spec, ",;");
+        const char* eq = memchr(spec, '=', len);
+        if (eq)
+        {
+            size_t name_len = (size_t) (eq - spec);
+            int lvl = parse_level(eq + 1, len - name_len - 1);
+            if (lvl >= 0 && name_len == 1 && spec[0] == '*')
+            {
+                s_global_level = (RogueLogLevel) lvl;
+                applied++;
+            }
+            else if (lvl >= 0)
+                for (int i = 0; i < ROGUE_LOG_CAT_COUNT; i++)
+                    if (strlen(s_cat_names[i]) == name_len &&
+                        !rogue_strnicmp(spec, s_cat_names[i], name_len))
+                    {
+                        s_cat_level[i] = lvl;
+                        applied++;
+                    }
+        }
+        spec += len;
+        if (*spec)
+            spec++;
+    }
+    return applied;
+}
+
+/* Caller holds s_cfg_lock. */
+static void apply_env(void)
+{
+    const char* e = rogue_getenv_safe("ROGUE_LOG_LEVEL");
+    int lvl = e ? parse_level(e, strlen(e)) : -1;
+    if (lvl >= 0)
+        s_global_level = (RogueLogLevel) lvl;
+    apply_categories(rogue_getenv_safe("ROGUE_LOG_CATEGORIES"));
+}
+
+/**
+ * @brief Takes the configuration lock, applying the environment on the first use.
+ * @details The threshold table starts at DEBUG so the first message of any level reaches this
+ * point; afterwards the call-site check filters on the configured levels.
+ */
+static void cfg_lock(void)
+{
+    spin_lock(&s_cfg_lock);
+    if (!s_init)
+    {
+        for (int i = 0; i < ROGUE_LOG_CAT_COUNT; i++)
+            s_cat_level[i] = -1;
+        apply_env();
+        recompute_thresholds();
+        log_store(&s_init, 1);
+    }
+}
+
+static void ensure_init(void)
+{
+    if (!log_load(&s_init))
+    {
+        cfg_lock();
+        spin_unlock(&s_cfg_lock);
+    }
+}
+
+/* ---- Rate limiting ---- */
+
+/**
+ * @brief Accounts one message against its call site's budget for the current second.
+ * @return -1 to mute the message, otherwise the number muted since the site last got through.
+ * @details Sites are keyed by the __FILE__ pointer and line. When the probe window is full the
+ * message passes unlimited rather than evicting another site mid-window.
+ */
+static long rate_admit(const char* file, int line)
+{
+    int limit = log_load(&s_rate_limit);
+    if (limit <= 0)
+        return 0;
+    uintptr_t h = ((uintptr_t) file >> 3) ^ ((uintptr_t) line * 2654435761u);
+    uint64_t now = rogue_prof_now_ns();
+    long result = 0;
+    spin_lock(&s_rate_lock);
+    for (int i = 0; i < RATE_PROBE; i++)
+    {
+        RateSite* s = &s_sites[(h + (uintptr_t) i) & (RATE_SLOTS - 1)];
+        if (s->file && (s->file != file || s->line != line))
+            continue;
+        if (!s->file)
+        {
+            s->file = file;
+            s->line = line;
+            s->window_ns = now;
+        }
+        if (now - s->window_ns >= RATE_WINDOW_NS)
+        {
+            s->window_ns = now;
+            s->count = 0;
+        }
+        if (s->count >= (unsigned) limit)
+        {
+            s->dropped++;
+            s_suppressed++;
+            result = -1;
+        }
+        else
+        {
+            s->count++;
+            result = (long) s->dropped;
+            s->dropped = 0;
+        }
+        break;
+    }
+    spin_unlock(&s_rate_lock);
+    return result;
+}
+
+/* ---- Sink ---- */
+
+static void write_record(int level, const char* file, int line, unsigned dropped, const char* msg)
+{
+    FILE* out = s_sink ? s_sink : (level == ROGUE_LOG_ERROR_LEVEL ? stderr : stdout);
+    if (dropped)
+        fprintf(out, "[%s] %s:%d: (%u similar messages suppressed)\n", level_to_str(level), file,
+                line, dropped);
+    fprintf(out, "[%s] %s:%d: %s\n", level_to_str(level), file, line, msg);
+}
+
+/* ---- Async thread slots ---- */
+#if defined(ROGUE_HAVE_SDL)
+static void log_thread_exit(void* p)
+{
+    LogThread* t = (LogThread*) p;
+    if (t)
+        log_store(&t->state, SLOT_RETIRED); /* consumer drains the rest, then frees the slot */
+}
+#endif
+
+static LogThread* log_self(void)
+{
+    if (t_self || t_no_slot)
+        return t_self;
+#if defined(ROGUE_HAVE_SDL)
+    if (!log_load(&s_tls_ready))
+    {
+        spin_lock(&s_cfg_lock);
+        if (!s_tls_id)
+            s_tls_id = SDL_TLSCreate();
+        spin_unlock(&s_cfg_lock);
+        log_store(&s_tls_ready, 1);
+    }
 #endif
+    for (int i = 0; i < ROGUE_LOG_MAX_THREADS; i++)
+    {
+        LogThread* t = &s_threads[i];
+        if (!log_cas(&t->state, SLOT_FREE, SLOT_CLAIMING))
+            continue;
+        log_store(&t->head, 0);
+        log_store(&t->tail, 0);
+        log_store(&t->state, SLOT_LIVE);
+#if defined(ROGUE_HAVE_SDL)
+        SDL_TLSSet(s_tls_id, t, log_thread_exit);
+#endif
+        t_self = t;
+        return t;
+    }
+    t_no_slot = 1; /* logs synchronously */
+    return NULL;
+}
+
+/* Consumer (drain lock held): writes every published record in slot order. */
+static void drain_locked(void)
+{
+    int wrote = 0;
+    for (int i = 0; i < ROGUE_LOG_MAX_THREADS; i++)
+    {
+        LogThread* t = &s_threads[i];
+        int state = log_load(&t->state);
+        if (state != SLOT_LIVE && state != SLOT_RETIRED)
+            continue;
+        int head = log_load(&t->head);
+        int tail = t->tail;
+        for (; tail != head; tail++)
+        {
+            const LogRecord* r = &t->ring[tail & RING_MASK];
+            write_record(r->level, r->file, r->line, r->dropped, r->msg);
+            wrote = 1;
+        }
+        log_store(&t->tail, tail);
+        if (state == SLOT_RETIRED)
+            log_store(&t->state, SLOT_FREE);
+    }
+    if (wrote)
+    {
+        fflush(s_sink ? s_sink : stdout);
+        if (!s_sink)
+            fflush(stderr);
+    }
+}
+
+static void drain(int block)
+{
+    if (block)
+        spin_lock(&s_drain_lock);
+    else if (!spin_trylock(&s_drain_lock))
+        return;
+    drain_locked();
+    spin_unlock(&s_drain_lock);
+}
+
+/**
+ * @brief Formats a message into the caller's ring.
+ * @return 0 when queued, -1 when the caller has no slot and must write synchronously.
+ * @details A full ring is drained in place (blocking on the drain lock) rather than dropping the
+ * message; without a writer thread the producer also drains once its ring is three quarters full.
+ */
+static int push_async(int level, const char* file, int line, unsigned dropped, const char* fmt,
+                      va_list args)
+{
+    LogThread* t = log_self();
+    if (!t)
+        return -1;
+    int head = t->head;
+    while (head - log_load(&t->tail) >= ROGUE_LOG_RING_RECORDS)
+        drain(1);
+    LogRecord* r = &t->ring[head & RING_MASK];
+    r->file = file;
+    r->line = line;
+    r->level = level;
+    r->dropped = dropped;
+    vsnprintf(r->msg, sizeof r->msg, fmt, args);
+    log_store(&t->head, head + 1);
+#if defined(ROGUE_HAVE_SDL)
+    if (!log_load(&s_writer_run))
+#endif
+        if (head + 1 - log_load(&t->tail) >= ROGUE_LOG_RING_RECORDS * 3 / 4)
+            drain(0);
+    return 0;
+}
+
+/* Synchronous path: one stdio call per line so concurrent loggers do not interleave. */
+static void write_sync(int level, const char* file, int line, unsigned dropped, const char* fmt,
+                       va_list args)
+{
+    char buf[1024];
+    char* msg = buf;
+    va_list copy;
+    va_copy(copy, args);
+    int n = vsnprintf(buf, sizeof buf, fmt, copy);
+    va_end(copy);
+    if (n >= (int) sizeof buf)
+    {
+        msg = (char*) malloc((size_t) n + 1);
+        if (msg)
+            vsnprintf(msg, (size_t) n + 1, fmt, args);
+        else
+            msg = buf; /* truncated */
+    }
+    write_record(level, file, line, dropped, n < 0 ? fmt : msg);
+    if (msg != buf)
+        free(msg);
+}
+
+static void log_v(int level, int cat, const char* file, int line, const char* fmt, va_list args)
+{
+    ensure_init();
+    if (cat < 0 || cat >= ROGUE_LOG_CAT_COUNT)
+        cat = ROGUE_LOG_CAT_GENERAL;
+    if (level < g_rogue_log_threshold[cat])
+        return;
+    long dropped = rate_admit(file, line);
+    if (dropped < 0)
+        return;
+    if (log_load(&s_async))
+    {
+        if (level < ROGUE_LOG_ERROR_LEVEL &&
+            push_async(level, file, line, (unsigned) dropped, fmt, args) == 0)
+            return;
+        /* errors (and threads without a slot) write in place, after what is already queued */
+        spin_lock(&s_drain_lock);
+        drain_locked();
+        write_sync(level, file, line, (unsigned) dropped, fmt, args);
+        fflush(s_sink ? s_sink : stdout);
+        spin_unlock(&s_drain_lock);
+        return;
+    }
+    write_sync(level, file, line, (unsigned) dropped, fmt, args);
 }
 
 /**
@@ -126,71 +545,234 @@ static int rogue_stricmp(const char* a, const char* b)
  * @param line The line number where the log call originated.
  * @param fmt Format string (printf-style).
  * @param ... Variable arguments for the format string.
- * @details Checks the global log level and only outputs if the message level meets the threshold.
- * Outputs to stderr for errors, stdout for other levels. Supports environment variable override on
- * first use.
+ * @details Equivalent to rogue_log_cat with ROGUE_LOG_CAT_GENERAL. Outputs to stderr for errors,
+ * stdout for other levels unless an output file was set.
  */
 void rogue_log(RogueLogLevel level, const char* file, int line, const char* fmt, ...)
 {
-    static int s_init = 0;
-    if (!s_init)
-    {
-        /* allow env override on first use */
-        const char* e = rogue_getenv_safe("ROGUE_LOG_LEVEL");
-        if (e && *e)
-        {
-            if (!rogue_stricmp(e, "debug") || !strcmp(e, "0"))
-                s_global_level = ROGUE_LOG_DEBUG_LEVEL;
-            else if (!rogue_stricmp(e, "info") || !strcmp(e, "1"))
-                s_global_level = ROGUE_LOG_INFO_LEVEL;
-            else if (!rogue_stricmp(e, "warn") || !rogue_stricmp(e, "warning") || !strcmp(e, "2"))
-                s_global_level = ROGUE_LOG_WARN_LEVEL;
-            else if (!rogue_stricmp(e, "error") || !strcmp(e, "3"))
-                s_global_level = ROGUE_LOG_ERROR_LEVEL;
-        }
-        s_init = 1;
-    }
-    if (level < s_global_level)
-        return;
-    FILE* out = (level == ROGUE_LOG_ERROR_LEVEL) ? stderr : stdout;
-    fprintf(out, "[%s] %s:%d: ", level_to_str(level), file, line);
     va_list args;
     va_start(args, fmt);
-    vfprintf(out, fmt, args);
+    log_v((int) level, ROGUE_LOG_CAT_GENERAL, file, line, fmt, args);
+    va_end(args);
+}
+
+/**
+ * @brief Logs a message under a category.
+ * @details Checks the category threshold (the macros already did, this covers direct calls and
+ * the first call before initialization) and the call site's rate limit, then writes the message
+ * or queues it on the caller's ring in async mode.
+ */
+void rogue_log_cat(RogueLogLevel level, RogueLogCategory cat, const char* file, int line,
+                   const char* fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    log_v((int) level, (int) cat, file, line, fmt, args);
     va_end(args);
-    fprintf(out, "\n");
+}
+
+/**
+ * @brief Reports whether a message of this level and category would pass the runtime filter.
+ * @details For guarding diagnostics whose preparation is itself costly; see ROGUE_LOG_ENABLED.
+ */
+int rogue_log_enabled(RogueLogLevel level, RogueLogCategory cat)
+{
+    ensure_init();
+    if ((int) cat < 0 || cat >= ROGUE_LOG_CAT_COUNT)
+        cat = ROGUE_LOG_CAT_GENERAL;
+    return (int) level >= g_rogue_log_threshold[cat];
 }
 
 /**
  * @brief Sets the minimum log level for message output.
  * @param min_level The minimum severity level to output.
- * @details Messages below this level will be suppressed.
+ * @details Messages below this level will be suppressed in categories without an override.
  */
-void rogue_log_set_level(RogueLogLevel min_level) { s_global_level = min_level; }
+void rogue_log_set_level(RogueLogLevel min_level)
+{
+    cfg_lock();
+    s_global_level = min_level;
+    recompute_thresholds();
+    spin_unlock(&s_cfg_lock);
+}
 
 /**
  * @brief Gets the current minimum log level.
  * @return The current minimum log level.
  * @details Returns the threshold level for log message output.
  */
-RogueLogLevel rogue_log_get_level(void) { return s_global_level; }
+RogueLogLevel rogue_log_get_level(void)
+{
+    ensure_init();
+    return s_global_level;
+}
 
 /**
- * @brief Sets the log level from the ROGUE_LOG_LEVEL environment variable.
- * @details Reads and parses the ROGUE_LOG_LEVEL environment variable to set the log level.
- * Supports both string names (debug, info, warn, error) and numeric values (0-3).
+ * @brief Sets the log levels from the environment.
+ * @details Reads ROGUE_LOG_LEVEL (debug, info, warn, error or 0-3) for the global level and
+ * ROGUE_LOG_CATEGORIES ("worldgen=debug,events=info") for category overrides.
  */
 void rogue_log_set_level_from_env(void)
 {
-    const char* e = rogue_getenv_safe("ROGUE_LOG_LEVEL");
-    if (!e || !*e)
+    cfg_lock();
+    apply_env();
+    recompute_thresholds();
+    spin_unlock(&s_cfg_lock);
+}
+
+/**
+ * @brief Overrides the minimum level of one category.
+ * @param cat The category.
+ * @param level Minimum level, or a negative value to follow the global level.
+ */
+void rogue_log_set_category_level(RogueLogCategory cat, int level)
+{
+    if ((int) cat < 0 || cat >= ROGUE_LOG_CAT_COUNT)
+        return;
+    if (level > ROGUE_LOG_ERROR_LEVEL)
+        level = ROGUE_LOG_ERROR_LEVEL;
+    cfg_lock();
+    s_cat_level[cat] = level < 0 ? -1 : level;
+    recompute_thresholds();
+    spin_unlock(&s_cfg_lock);
+}
+
+/**
+ * @brief Gets a category override.
+ * @return The category's minimum level, or -1 when it follows the global level.
+ */
+int rogue_log_get_category_level(RogueLogCategory cat)
+{
+    if ((int) cat < 0 || cat >= ROGUE_LOG_CAT_COUNT)
+        return -1;
+    ensure_init();
+    return s_cat_level[cat];
+}
+
+/**
+ * @brief Gets the lowercase name of a category as used by ROGUE_LOG_CATEGORIES.
+ */
+const char* rogue_log_category_name(RogueLogCategory cat)
+{
+    if ((int) cat < 0 || cat >= ROGUE_LOG_CAT_COUNT)
+        return "?";
+    return s_cat_names[cat];
+}
+
+/**
+ * @brief Applies a comma-separated list of category=level entries.
+ * @param spec e.g. "worldgen=debug,events=info"; the name '*' sets the global level.
+ * @return Number of entries applied.
+ */
+int rogue_log_set_categories_from_string(const char* spec)
+{
+    cfg_lock();
+    int applied = apply_categories(spec);
+    recompute_thresholds();
+    spin_unlock(&s_cfg_lock);
+    return applied;
+}
+
+/**
+ * @brief Sets how many messages each call site may print per second (0 = unlimited).
+ */
+void rogue_log_set_rate_limit(int per_site_per_second)
+{
+    spin_lock(&s_rate_lock);
+    log_store(&s_rate_limit, per_site_per_second < 0 ? 0 : per_site_per_second);
+    memset(s_sites, 0, sizeof s_sites);
+    spin_unlock(&s_rate_lock);
+}
+
+/**
+ * @brief Gets the total number of messages muted by the rate limiter.
+ */
+unsigned long long rogue_log_suppressed_count(void)
+{
+    spin_lock(&s_rate_lock);
+    unsigned long long n = s_suppressed;
+    spin_unlock(&s_rate_lock);
+    return n;
+}
+
+/**
+ * @brief Redirects output; queued records are written to the previous sink first.
+ * @param f Destination for every level, or NULL for stdout / stderr.
+ */
+void rogue_log_set_output(FILE* f)
+{
+    spin_lock(&s_drain_lock);
+    drain_locked();
+    s_sink = f;
+    spin_unlock(&s_drain_lock);
+}
+
+#if defined(ROGUE_HAVE_SDL)
+static int writer_main(void* ud)
+{
+    (void) ud;
+    while (log_load(&s_writer_run))
+    {
+        drain(0);
+        SDL_Delay(WRITER_POLL_MS);
+    }
+    return 0;
+}
+#endif
+
+/**
+ * @brief Switches to asynchronous output.
+ * @return 0 on success.
+ * @details With SDL a writer thread drains the rings every few milliseconds; without it records
+ * are written when a ring fills up, on errors and on rogue_log_flush.
+ */
+int rogue_log_async_start(void)
+{
+    static int s_atexit;
+    ensure_init();
+    if (log_load(&s_async))
+        return 0;
+    if (!s_atexit)
+    {
+        atexit(rogue_log_flush); /* exit() paths skip async_stop */
+        s_atexit = 1;
+    }
+#if defined(ROGUE_HAVE_SDL)
+    log_store(&s_writer_run, 1);
+    s_writer = SDL_CreateThread(writer_main, "rogue_log", NULL);
+    if (!s_writer)
+    {
+        log_store(&s_writer_run, 0);
+        return -1;
+    }
+#endif
+    log_store(&s_async, 1);
+    return 0;
+}
+
+/**
+ * @brief Returns to synchronous output after writing everything queued.
+ */
+void rogue_log_async_stop(void)
+{
+    if (!log_load(&s_async))
         return;
-    if (!rogue_stricmp(e, "debug") || !strcmp(e, "0"))
-        rogue_log_set_level(ROGUE_LOG_DEBUG_LEVEL);
-    else if (!rogue_stricmp(e, "info") || !strcmp(e, "1"))
-        rogue_log_set_level(ROGUE_LOG_INFO_LEVEL);
-    else if (!rogue_stricmp(e, "warn") || !rogue_stricmp(e, "warning") || !strcmp(e, "2"))
-        rogue_log_set_level(ROGUE_LOG_WARN_LEVEL);
-    else if (!rogue_stricmp(e, "error") || !strcmp(e, "3"))
-        rogue_log_set_level(ROGUE_LOG_ERROR_LEVEL);
+    log_store(&s_async, 0);
+#if defined(ROGUE_HAVE_SDL)
+    log_store(&s_writer_run, 0);
+    SDL_WaitThread(s_writer, NULL);
+    s_writer = NULL;
+#endif
+    drain(1);
+}
+
+int rogue_log_async_active(void) { return log_load(&s_async); }
+
+/**
+ * @brief Writes every record queued so far (by any thread) before returning.
+ */
+void rogue_log_flush(void)
+{
+    drain(1);
+    fflush(s_sink ? s_sink : stdout);
 }
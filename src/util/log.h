@@ -26,6 +26,23 @@ SOFTWARE.
 
 #include <stdio.h>
 
+/* Logging front end.
+ *
+ * Filtering happens in three stages, cheapest first:
+ *   1. Compile time: calls below ROGUE_LOG_COMPILE_LEVEL (CMake cache var of the same name,
+ *      default 0 = keep everything) expand to a constant-false branch the compiler removes,
+ *      arguments included.
+ *   2. Call site: the macros test the per-category threshold table inline, so a filtered message
+ *      costs one load and compare and never evaluates its arguments.
+ *   3. Per call site rate limit: a site printing more than the configured number of messages per
+ *      second is muted for the rest of that second; the number dropped is reported when the next
+ *      message from the site gets through.
+ *
+ * Output is synchronous by default. After rogue_log_async_start every thread formats into its own
+ * lock-free ring and a writer thread (ROGUE_HAVE_SDL builds; otherwise whichever logging thread
+ * finds the rings filling up) drains them to the sink, so callers never block on stdio. ERROR
+ * messages are still written synchronously after the rings are flushed. */
+
 typedef enum RogueLogLevel
 {
     ROGUE_LOG_DEBUG_LEVEL,
@@ -34,21 +51,90 @@ typedef enum RogueLogLevel
     ROGUE_LOG_ERROR_LEVEL
 } RogueLogLevel;
 
+typedef enum RogueLogCategory
+{
+    ROGUE_LOG_CAT_GENERAL = 0,
+    ROGUE_LOG_CAT_EVENTS,
+    ROGUE_LOG_CAT_RENDER,
+    ROGUE_LOG_CAT_AUDIO,
+    ROGUE_LOG_CAT_WORLDGEN,
+    ROGUE_LOG_CAT_AI,
+    ROGUE_LOG_CAT_LOOT,
+    ROGUE_LOG_CAT_DIALOGUE,
+    ROGUE_LOG_CAT_PERSIST,
+    ROGUE_LOG_CAT_UI,
+    ROGUE_LOG_CAT_COUNT
+} RogueLogCategory;
+
+#ifndef ROGUE_LOG_COMPILE_LEVEL
+#define ROGUE_LOG_COMPILE_LEVEL 0
+#endif
+
+#define ROGUE_LOG_RING_RECORDS 128 /* per thread, power of two */
+#define ROGUE_LOG_RECORD_CAP 256   /* formatted prefix + message, truncated past this */
+#define ROGUE_LOG_MAX_THREADS 16
+#define ROGUE_LOG_DEFAULT_RATE_LIMIT 64 /* messages per call site per second */
+
+/* Effective minimum level per category: its override when set, else the global level. Read by
+   the macros; maintained by the setters below. */
+extern int g_rogue_log_threshold[ROGUE_LOG_CAT_COUNT];
+
 void rogue_log(RogueLogLevel level, const char* file, int line, const char* fmt, ...);
+void rogue_log_cat(RogueLogLevel level, RogueLogCategory cat, const char* file, int line,
+                   const char* fmt, ...);
+/* Full runtime check (thresholds after env init); the compile-time level is the caller's. */
+int rogue_log_enabled(RogueLogLevel level, RogueLogCategory cat);
 
 /* Configure global log level threshold (messages below are ignored). */
 void rogue_log_set_level(RogueLogLevel min_level);
 RogueLogLevel rogue_log_get_level(void);
-/* Convenience: reads ROGUE_LOG_LEVEL env var: debug|info|warn|error or 0..3 */
+/* Convenience: reads ROGUE_LOG_LEVEL env var: debug|info|warn|error or 0..3, and
+   ROGUE_LOG_CATEGORIES (see rogue_log_set_categories_from_string). */
 void rogue_log_set_level_from_env(void);
 
-#define ROGUE_LOG_DEBUG(fmt, ...)                                                                  \
-    rogue_log(ROGUE_LOG_DEBUG_LEVEL, __FILE__, __LINE__, fmt, ##__VA_ARGS__)
-#define ROGUE_LOG_INFO(fmt, ...)                                                                   \
-    rogue_log(ROGUE_LOG_INFO_LEVEL, __FILE__, __LINE__, fmt, ##__VA_ARGS__)
-#define ROGUE_LOG_WARN(fmt, ...)                                                                   \
-    rogue_log(ROGUE_LOG_WARN_LEVEL, __FILE__, __LINE__, fmt, ##__VA_ARGS__)
-#define ROGUE_LOG_ERROR(fmt, ...)                                                                  \
-    rogue_log(ROGUE_LOG_ERROR_LEVEL, __FILE__, __LINE__, fmt, ##__VA_ARGS__)
+/* Category override; a negative level makes the category follow the global level again. A
+   category can be made more verbose than the global level as well as quieter. */
+void rogue_log_set_category_level(RogueLogCategory cat, int level);
+int rogue_log_get_category_level(RogueLogCategory cat); /* -1 when following the global level */
+const char* rogue_log_category_name(RogueLogCategory cat);
+/* "worldgen=debug,events=info,*=warn" ('*' sets the global level). Returns the number of entries
+   applied; unknown names or levels are skipped. */
+int rogue_log_set_categories_from_string(const char* spec);
+
+/* Per call site messages per second; 0 disables rate limiting. */
+void rogue_log_set_rate_limit(int per_site_per_second);
+unsigned long long rogue_log_suppressed_count(void);
+
+/* Route every level to f (NULL restores stdout / stderr for ERROR). Flushes pending records. */
+void rogue_log_set_output(FILE* f);
+
+/* Asynchronous mode. start returns 0 on success (also when already running); stop drains every
+   ring and joins the writer. flush writes everything logged so far before returning. */
+int rogue_log_async_start(void);
+void rogue_log_async_stop(void);
+int rogue_log_async_active(void);
+void rogue_log_flush(void);
+
+#define ROGUE_LOG_ENABLED(level, cat)                                                              \
+    ((int) (level) >= ROGUE_LOG_COMPILE_LEVEL && (int) (level) >= g_rogue_log_threshold[cat] &&    \
+     rogue_log_enabled((level), (cat)))
+
+#define ROGUE_LOG_AT(level, cat, fmt, ...)                                                         \
+    do                                                                                             \
+    {                                                                                              \
+        if ((int) (level) >= ROGUE_LOG_COMPILE_LEVEL &&                                            \
+            (int) (level) >= g_rogue_log_threshold[cat])                                           \
+            rogue_log_cat((level), (cat), __FILE__, __LINE__, fmt, ##__VA_ARGS__);                 \
+    } while (0)
+
+#define ROGUE_LOGC_DEBUG(cat, fmt, ...) ROGUE_LOG_AT(ROGUE_LOG_DEBUG_LEVEL, cat, fmt, ##__VA_ARGS__)
+#define ROGUE_LOGC_INFO(cat, fmt, ...) ROGUE_LOG_AT(ROGUE_LOG_INFO_LEVEL, cat, fmt, ##__VA_ARGS__)
+#define ROGUE_LOGC_WARN(cat, fmt, ...) ROGUE_LOG_AT(ROGUE_LOG_WARN_LEVEL, cat, fmt, ##__VA_ARGS__)
+#define ROGUE_LOGC_ERROR(cat, fmt, ...) ROGUE_LOG_AT(ROGUE_LOG_ERROR_LEVEL, cat, fmt, ##__VA_ARGS__)
+
+#define ROGUE_LOG_DEBUG(fmt, ...) ROGUE_LOGC_DEBUG(ROGUE_LOG_CAT_GENERAL, fmt, ##__VA_ARGS__)
+#define ROGUE_LOG_INFO(fmt, ...) ROGUE_LOGC_INFO(ROGUE_LOG_CAT_GENERAL, fmt, ##__VA_ARGS__)
+#define ROGUE_LOG_WARN(fmt, ...) ROGUE_LOGC_WARN(ROGUE_LOG_CAT_GENERAL, fmt, ##__VA_ARGS__)
+#define ROGUE_LOG_ERROR(fmt, ...) ROGUE_LOGC_ERROR(ROGUE_LOG_CAT_GENERAL, fmt, ##__VA_ARGS__)
 
 #endif
@@ -10,14 +10,14 @@
 #include "../core/app/app_state.h"
 #include "../core/loot/loot_rarity_adv.h"
 #include "../game/game_loop.h"
-#include <time.h>
+#include "profiler.h"
 
 /**
- * @brief Gets the current time in seconds since program start.
+ * @brief Gets the current monotonic time in seconds.
  * @return Current time in seconds as a double.
- * @details Uses clock() function for timing measurements, normalized to seconds.
+ * @details Uses the unified profiler clock (wall time, not CPU time), normalized to seconds.
  */
-static double now_seconds(void) { return (double) clock() / (double) CLOCKS_PER_SEC; }
+static double now_seconds(void) { return (double) rogue_prof_now_ns() / 1e9; }
 
 /**
  * @brief Resets all metrics to initial state.
@@ -44,20 +44,27 @@ void rogue_metrics_reset(void)
 /**
  * @brief Marks the beginning of a frame for timing.
  * @return Current time in seconds when frame began.
- * @details Should be called at the start of each frame to capture timing data.
+ * @details Should be called at the start of each frame to capture timing data. Also opens the
+ * profiler frame scope (no-op unless profiling is enabled).
  */
-double rogue_metrics_frame_begin(void) { return now_seconds(); }
+double rogue_metrics_frame_begin(void)
+{
+    rogue_prof_frame_begin();
+    return now_seconds();
+}
 
 /**
  * @brief Marks the end of a frame and calculates timing metrics.
  * @param frame_start_seconds The time when the frame began (from rogue_metrics_frame_begin).
  * @details Calculates frame time, FPS, and updates rolling averages.
  * Uses deterministic dt for uncapped framerate to ensure consistent behavior in tests.
+ * Closes the profiler frame (drains thread rings, checks for a frame spike).
  */
 void rogue_metrics_frame_end(double frame_start_seconds)
 {
     g_app.frame_count++;
     double frame_end = now_seconds();
+    rogue_prof_frame_end();
     g_app.frame_ms = (frame_end - frame_start_seconds) * 1000.0;
     /* Deterministic dt: when uncapped (target_fps==0), use a fixed small step to
        avoid wall-clock variance in unit tests and headless runs. */
@@ -0,0 +1,731 @@
+/**
+ * @file profiler.c
+ * @brief Unified hierarchical frame profiler: zones, per-thread rings, frame spikes, trace export.
+ * @details See profiler.h. Each recording thread claims a slot holding a single-producer /
+ * single-consumer event ring and its private scope stack. The producer publishes events with a
+ * release store of the ring head; the consumer is whichever thread wins the drain try-lock and
+ * copies events into the shared history (a power-of-two ring of the most recent events), per-zone
+ * totals and frame records. With ROGUE_HAVE_SDL a thread slot is released through an SDL TLS
+ * destructor when its thread exits, after the consumer has drained what it left behind; without
+ * SDL only the caller thread records.
+ */
+
+#include "profiler.h"
+#include "log.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#endif
+#if defined(ROGUE_HAVE_SDL)
+#include <SDL.h>
+#endif
+
+/* ---- Portable atomics on plain ints (Interlocked on MSVC, GCC/Clang builtins elsewhere) ---- */
+#if defined(_MSC_VER)
+#define prof_load(p) ((int) InterlockedCompareExchange((volatile LONG*) (p), 0, 0))
+#define prof_store(p, v) InterlockedExchange((volatile LONG*) (p), (LONG) (v))
+#define prof_add(p, v) ((int) InterlockedExchangeAdd((volatile LONG*) (p), (LONG) (v)))
+#define prof_cas(p, o, n)                                                                          \
+    (InterlockedCompareExchange((volatile LONG*) (p), (LONG) (n), (LONG) (o)) == (LONG) (o))
+#define PROF_TLS __declspec(thread)
+#else
+#define prof_load(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define prof_store(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define prof_add(p, v) __atomic_fetch_add((p), (v), __ATOMIC_ACQ_REL)
+static int prof_cas_int(int* p, int expected, int desired)
+{
+    return __atomic_compare_exchange_n(p, &expected, desired, 0, __ATOMIC_ACQ_REL,
+                                       __ATOMIC_ACQUIRE);
+}
+#define prof_cas(p, o, n) prof_cas_int((p), (o), (n))
+#define PROF_TLS __thread
+#endif
+
+#define RING_MASK (ROGUE_PROF_RING_EVENTS - 1)
+#define HIST_MASK (ROGUE_PROF_HISTORY_EVENTS - 1)
+#define DEFAULT_CAPTURE_FRAMES 8
+
+enum
+{
+    SLOT_FREE = 0,
+    SLOT_CLAIMING,
+    SLOT_LIVE,
+    SLOT_RETIRED
+};
+
+typedef struct ProfEvent
+{
+    uint64_t start_ns;
+    uint64_t dur_ns;
+    uint16_t zone;
+    uint16_t depth;
+    int tid;
+} ProfEvent;
+
+typedef struct ProfThread
+{
+    ProfEvent ring[ROGUE_PROF_RING_EVENTS];
+    int head;  /* written by the owner (release) */
+    int tail;  /* written by the consumer (release) */
+    int state; /* SLOT_* */
+    int tid;
+    /* owner-private scope stack */
+    int depth;
+    int skipped; /* begins past ROGUE_PROF_MAX_DEPTH awaiting their end */
+    uint16_t stack_zone[ROGUE_PROF_MAX_DEPTH];
+    uint64_t stack_ns[ROGUE_PROF_MAX_DEPTH];
+    char name[32]; /* written under the drain lock */
+} ProfThread;
+
+typedef struct ProfZoneTotals
+{
+    uint64_t total_ns;
+    uint64_t max_ns;
+    int count;
+} ProfZoneTotals;
+
+typedef struct ProfFrame
+{
+    uint32_t index;
+    uint64_t dur_ns;
+    int first_seq; /* history sequence range drained during the frame */
+    int end_seq;
+} ProfFrame;
+
+static char g_zone_names[ROGUE_PROF_MAX_ZONES][ROGUE_PROF_ZONE_NAME_CAP];
+static int g_zone_count;
+static int g_registry_lock;
+
+static ProfThread g_threads[ROGUE_PROF_MAX_THREADS];
+static PROF_TLS ProfThread* t_self;
+static PROF_TLS int t_no_slot;
+static int g_next_tid;
+static int g_enabled;
+static int g_dropped;
+static int g_drain_lock;
+#if defined(ROGUE_HAVE_SDL)
+static SDL_TLSID g_tls_id;
+static int g_tls_ready;
+#endif
+
+/* consumer state (drain lock held) */
+static ProfEvent g_hist[ROGUE_PROF_HISTORY_EVENTS];
+static int g_hist_seq;
+static ProfZoneTotals g_totals[ROGUE_PROF_MAX_ZONES];
+static ProfFrame g_frames[ROGUE_PROF_FRAME_HISTORY];
+static uint32_t g_frame_total;
+static int g_frame_first_seq;
+static ProfEvent* g_capture;
+static int g_capture_count;
+static int g_spike_count;
+static uint64_t g_epoch_ns;
+
+/* frame owner state */
+static int g_frame_zone = -1;
+static uint64_t g_frame_start_ns;
+static int g_frame_open;
+static double g_spike_ms;
+static int g_capture_frames = DEFAULT_CAPTURE_FRAMES;
+
+static char g_trace_path[260];
+static char g_spike_trace_path[260];
+
+uint64_t rogue_prof_now_ns(void)
+{
+#if defined(_WIN32)
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER c;
+    if (freq.QuadPart == 0)
+        QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&c);
+    uint64_t f = (uint64_t) freq.QuadPart, t = (uint64_t) c.QuadPart;
+    return (t / f) * 1000000000ull + (t % f) * 1000000000ull / f;
+#elif defined(CLOCK_MONOTONIC_RAW)
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ull + (uint64_t) ts.tv_nsec;
+#elif defined(CLOCK_MONOTONIC)
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ull + (uint64_t) ts.tv_nsec;
+#else
+    return (uint64_t) clock() * (1000000000ull / (uint64_t) CLOCKS_PER_SEC);
+#endif
+}
+
+static void spin_lock(int* lock)
+{
+    while (!prof_cas(lock, 0, 1))
+    {
+    }
+}
+static void spin_unlock(int* lock) { prof_store(lock, 0); }
+
+/* ---- Zone registry ---- */
+int rogue_prof_zone_register(const char* name)
+{
+    if (!name)
+        return -1;
+    spin_lock(&g_registry_lock);
+    int count = prof_load(&g_zone_count);
+    for (int i = 0; i < count; i++)
+        if (strncmp(g_zone_names[i], name, ROGUE_PROF_ZONE_NAME_CAP - 1) == 0)
+        {
+            spin_unlock(&g_registry_lock);
+            return i;
+        }
+    int id = -1;
+    if (count < ROGUE_PROF_MAX_ZONES)
+    {
+        size_t len = strlen(name);
+        if (len >= ROGUE_PROF_ZONE_NAME_CAP)
+            len = ROGUE_PROF_ZONE_NAME_CAP - 1;
+        memcpy(g_zone_names[count], name, len);
+        g_zone_names[count][len] = '\0';
+        id = count;
+        prof_store(&g_zone_count, count + 1); /* publish after the name is written */
+    }
+    spin_unlock(&g_registry_lock);
+    return id;
+}
+
+int rogue_prof_zone_slot(RogueProfZoneSlot* slot, const char* name)
+{
+    if (!slot)
+        return rogue_prof_zone_register(name);
+    int v = prof_load(&slot->id_plus_one);
+    if (v > 0)
+        return v - 1;
+    int id = rogue_prof_zone_register(name);
+    if (id >= 0)
+        prof_store(&slot->id_plus_one, id + 1);
+    return id;
+}
+
+const char* rogue_prof_zone_name(int zone)
+{
+    if (zone < 0 || zone >= prof_load(&g_zone_count))
+        return "";
+    return g_zone_names[zone];
+}
+
+int rogue_prof_zone_count(void) { return prof_load(&g_zone_count); }
+
+void rogue_prof_set_enabled(int enabled)
+{
+#if ROGUE_ENABLE_PROFILER
+    if (enabled)
+    {
+        spin_lock(&g_drain_lock);
+        if (g_epoch_ns == 0)
+            g_epoch_ns = rogue_prof_now_ns();
+        spin_unlock(&g_drain_lock);
+    }
+    prof_store(&g_enabled, enabled ? 1 : 0);
+#else
+    (void) enabled;
+#endif
+}
+
+int rogue_prof_enabled(void) { return prof_load(&g_enabled); }
+
+/* ---- Thread slots ---- */
+#if defined(ROGUE_HAVE_SDL)
+static void prof_thread_exit(void* p)
+{
+    ProfThread* t = (ProfThread*) p;
+    if (t)
+        prof_store(&t->state, SLOT_RETIRED); /* consumer drains the rest, then frees the slot */
+}
+#endif
+
+static ProfThread* prof_self(void)
+{
+    if (t_self || t_no_slot)
+        return t_self;
+#if defined(ROGUE_HAVE_SDL)
+    if (!prof_load(&g_tls_ready))
+    {
+        spin_lock(&g_registry_lock);
+        if (!g_tls_id)
+            g_tls_id = SDL_TLSCreate();
+        spin_unlock(&g_registry_lock);
+        prof_store(&g_tls_ready, 1);
+    }
+#endif
+    for (int i = 0; i < ROGUE_PROF_MAX_THREADS; i++)
+    {
+        ProfThread* t = &g_threads[i];
+        if (!prof_cas(&t->state, SLOT_FREE, SLOT_CLAIMING))
+            continue;
+        prof_store(&t->head, 0);
+        prof_store(&t->tail, 0);
+        t->depth = 0;
+        t->skipped = 0;
+        t->tid = prof_add(&g_next_tid, 1) + 1;
+        spin_lock(&g_drain_lock);
+        t->name[0] = '\0';
+        spin_unlock(&g_drain_lock);
+        prof_store(&t->state, SLOT_LIVE);
+#if defined(ROGUE_HAVE_SDL)
+        SDL_TLSSet(g_tls_id, t, prof_thread_exit);
+#endif
+        t_self = t;
+        return t;
+    }
+    t_no_slot = 1;
+    return NULL;
+}
+
+/* ---- Consumer (drain lock held) ---- */
+static void drain_locked(void)
+{
+    for (int i = 0; i < ROGUE_PROF_MAX_THREADS; i++)
+    {
+        ProfThread* t = &g_threads[i];
+        int state = prof_load(&t->state);
+        if (state != SLOT_LIVE && state != SLOT_RETIRED)
+            continue;
+        int head = prof_load(&t->head);
+        int tail = t->tail;
+        for (; tail != head; tail++)
+        {
+            const ProfEvent* ev = &t->ring[tail & RING_MASK];
+            g_hist[g_hist_seq & HIST_MASK] = *ev;
+            g_hist_seq++;
+            ProfZoneTotals* z = &g_totals[ev->zone];
+            z->total_ns += ev->dur_ns;
+            if (ev->dur_ns > z->max_ns)
+                z->max_ns = ev->dur_ns;
+            z->count++;
+        }
+        prof_store(&t->tail, tail);
+        if (state == SLOT_RETIRED)
+            prof_store(&t->state, SLOT_FREE);
+    }
+}
+
+static void prof_push(ProfThread* t, uint64_t start_ns, uint64_t dur_ns, int zone, int depth)
+{
+    int head = t->head;
+    int tail = prof_load(&t->tail);
+    if (head - tail >= ROGUE_PROF_RING_EVENTS)
+    {
+        prof_add(&g_dropped, 1);
+        return;
+    }
+    ProfEvent* ev = &t->ring[head & RING_MASK];
+    ev->start_ns = start_ns;
+    ev->dur_ns = dur_ns;
+    ev->zone = (uint16_t) zone;
+    ev->depth = (uint16_t) depth;
+    ev->tid = t->tid;
+    prof_store(&t->head, head + 1);
+    /* ring running full: drain now if no other thread is draining */
+    if (head + 1 - tail >= ROGUE_PROF_RING_EVENTS * 3 / 4 && prof_cas(&g_drain_lock, 0, 1))
+    {
+        drain_locked();
+        spin_unlock(&g_drain_lock);
+    }
+}
+
+/* ---- Scopes ---- */
+void rogue_prof_begin(int zone)
+{
+    if (zone < 0 || zone >= ROGUE_PROF_MAX_ZONES || !prof_load(&g_enabled))
+        return;
+    ProfThread* t = prof_self();
+    if (!t)
+    {
+        prof_add(&g_dropped, 1);
+        return;
+    }
+    if (t->depth >= ROGUE_PROF_MAX_DEPTH)
+    {
+        t->skipped++;
+        return;
+    }
+    t->stack_zone[t->depth] = (uint16_t) zone;
+    t->stack_ns[t->depth] = rogue_prof_now_ns();
+    t->depth++;
+}
+
+void rogue_prof_end(int zone)
+{
+    ProfThread* t = t_self;
+    if (!t || zone < 0)
+        return;
+    if (t->skipped > 0)
+    {
+        t->skipped--;
+        return;
+    }
+    int i = t->depth - 1;
+    while (i >= 0 && t->stack_zone[i] != zone)
+        i--;
+    if (i < 0)
+        return;
+    if (!prof_load(&g_enabled))
+    {
+        t->depth = i;
+        return;
+    }
+    uint64_t now = rogue_prof_now_ns();
+    while (t->depth > i)
+    {
+        t->depth--;
+        uint64_t start = t->stack_ns[t->depth];
+        prof_push(t, start, now - start, t->stack_zone[t->depth], t->depth);
+    }
+}
+
+void rogue_prof_complete(int zone, uint64_t dur_ns)
+{
+    if (zone < 0 || zone >= ROGUE_PROF_MAX_ZONES || !prof_load(&g_enabled))
+        return;
+    ProfThread* t = prof_self();
+    if (!t)
+    {
+        prof_add(&g_dropped, 1);
+        return;
+    }
+    uint64_t now = rogue_prof_now_ns();
+    prof_push(t, now - dur_ns, dur_ns, zone, t->depth);
+}
+
+void rogue_prof_thread_name(const char* name)
+{
+    ProfThread* t = prof_self();
+    if (!t || !name)
+        return;
+    spin_lock(&g_drain_lock);
+    size_t len = strlen(name);
+    if (len >= sizeof t->name)
+        len = sizeof t->name - 1;
+    memcpy(t->name, name, len);
+    t->name[len] = '\0';
+    spin_unlock(&g_drain_lock);
+}
+
+/* ---- Frames / spikes ---- */
+static void capture_locked(int frames)
+{
+    uint32_t have = g_frame_total < ROGUE_PROF_FRAME_HISTORY ? g_frame_total
+                                                             : ROGUE_PROF_FRAME_HISTORY;
+    if ((uint32_t) frames > have)
+        frames = (int) have;
+    if (frames <= 0)
+        return;
+    if (!g_capture)
+    {
+        g_capture = (ProfEvent*) malloc(sizeof(ProfEvent) * ROGUE_PROF_HISTORY_EVENTS);
+        if (!g_capture)
+            return;
+    }
+    const ProfFrame* oldest = &g_frames[(g_frame_total - (uint32_t) frames) %
+                                        ROGUE_PROF_FRAME_HISTORY];
+    int from = oldest->first_seq;
+    if (g_hist_seq - from > ROGUE_PROF_HISTORY_EVENTS)
+        from = g_hist_seq - ROGUE_PROF_HISTORY_EVENTS; /* older events already overwritten */
+    g_capture_count = 0;
+    for (int s = from; s != g_hist_seq; s++)
+        g_capture[g_capture_count++] = g_hist[s & HIST_MASK];
+    g_spike_count++;
+}
+
+void rogue_prof_frame_begin(void)
+{
+    if (!prof_load(&g_enabled))
+        return;
+    if (g_frame_zone < 0)
+        g_frame_zone = rogue_prof_zone_register("frame");
+    g_frame_start_ns = rogue_prof_now_ns();
+    g_frame_open = 1;
+    rogue_prof_begin(g_frame_zone);
+}
+
+void rogue_prof_frame_end(void)
+{
+    if (!g_frame_open)
+        return;
+    g_frame_open = 0;
+    rogue_prof_end(g_frame_zone);
+    uint64_t dur = rogue_prof_now_ns() - g_frame_start_ns;
+    spin_lock(&g_drain_lock);
+    drain_locked();
+    ProfFrame* f = &g_frames[g_frame_total % ROGUE_PROF_FRAME_HISTORY];
+    f->index = g_frame_total;
+    f->dur_ns = dur;
+    f->first_seq = g_frame_first_seq;
+    f->end_seq = g_hist_seq;
+    g_frame_first_seq = g_hist_seq;
+    g_frame_total++;
+    if (g_spike_ms > 0.0 && (double) dur / 1e6 > g_spike_ms)
+        capture_locked(g_capture_frames);
+    spin_unlock(&g_drain_lock);
+}
+
+int rogue_prof_frames(RogueProfFrameInfo* out, int max)
+{
+    if (!out || max <= 0)
+        return 0;
+    spin_lock(&g_drain_lock);
+    uint32_t have = g_frame_total < ROGUE_PROF_FRAME_HISTORY ? g_frame_total
+                                                             : ROGUE_PROF_FRAME_HISTORY;
+    if ((uint32_t) max > have)
+        max = (int) have;
+    for (int i = 0; i < max; i++)
+    {
+        const ProfFrame* f =
+            &g_frames[(g_frame_total - (uint32_t) max + (uint32_t) i) % ROGUE_PROF_FRAME_HISTORY];
+        out[i].index = f->index;
+        out[i].ms = (double) f->dur_ns / 1e6;
+        out[i].events = f->end_seq - f->first_seq;
+    }
+    spin_unlock(&g_drain_lock);
+    return max;
+}
+
+void rogue_prof_set_spike_threshold(double threshold_ms, int frames)
+{
+    g_spike_ms = threshold_ms > 0.0 ? threshold_ms : 0.0;
+    if (frames > ROGUE_PROF_FRAME_HISTORY)
+        frames = ROGUE_PROF_FRAME_HISTORY;
+    if (frames > 0)
+        g_capture_frames = frames;
+}
+
+int rogue_prof_spike_count(void)
+{
+    spin_lock(&g_drain_lock);
+    int n = g_spike_count;
+    spin_unlock(&g_drain_lock);
+    return n;
+}
+
+/* ---- Stats ---- */
+void rogue_prof_flush(void)
+{
+    spin_lock(&g_drain_lock);
+    drain_locked();
+    spin_unlock(&g_drain_lock);
+}
+
+int rogue_prof_zone_stats(int zone, RogueProfZoneStats* out)
+{
+    if (zone < 0 || zone >= ROGUE_PROF_MAX_ZONES)
+        return -1;
+    spin_lock(&g_drain_lock);
+    drain_locked();
+    ProfZoneTotals z = g_totals[zone];
+    spin_unlock(&g_drain_lock);
+    if (z.count == 0)
+        return -1;
+    if (out)
+    {
+        out->total_ms = (double) z.total_ns / 1e6;
+        out->max_ms = (double) z.max_ns / 1e6;
+        out->count = z.count;
+    }
+    return 0;
+}
+
+int rogue_prof_dropped(void) { return prof_load(&g_dropped); }
+
+/* ---- Chrome trace export ---- */
+typedef struct ProfWriter
+{
+    char* buf;
+    int cap;
+    int len;
+    FILE* f;
+    int err;
+} ProfWriter;
+
+static void w_printf(ProfWriter* w, const char* fmt, ...)
+{
+    va_list ap;
+    va_start(ap, fmt);
+    int n;
+    if (w->f)
+        n = vfprintf(w->f, fmt, ap);
+    else if (w->buf && w->len < w->cap)
+        n = vsnprintf(w->buf + w->len, (size_t) (w->cap - w->len), fmt, ap);
+    else
+        n = vsnprintf(NULL, 0, fmt, ap);
+    va_end(ap);
+    if (n < 0)
+        w->err = 1;
+    else
+        w->len += n;
+}
+
+static void w_string(ProfWriter* w, const char* s)
+{
+    char tmp[2 * ROGUE_PROF_ZONE_NAME_CAP + 1];
+    int o = 0;
+    for (; *s && o < (int) sizeof tmp - 2; s++)
+    {
+        unsigned char c = (unsigned char) *s;
+        if (c == '"' || c == '\\')
+            tmp[o++] = '\\';
+        tmp[o++] = c < 0x20 ? ' ' : (char) c;
+    }
+    tmp[o] = '\0';
+    w_printf(w, "\"%s\"", tmp);
+}
+
+static void export_locked(ProfWriter* w, const ProfEvent* events, int count, int first)
+{
+    w_printf(w, "{\"traceEvents\":[");
+    int sep = 0;
+    for (int i = 0; i < ROGUE_PROF_MAX_THREADS; i++)
+    {
+        const ProfThread* t = &g_threads[i];
+        if (prof_load(&t->state) == SLOT_FREE || !t->name[0])
+            continue;
+        w_printf(w, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,",
+                 sep ? "," : "", t->tid);
+        w_printf(w, "\"args\":{\"name\":");
+        w_string(w, t->name);
+        w_printf(w, "}}");
+        sep = 1;
+    }
+    for (int i = 0; i < count; i++)
+    {
+        const ProfEvent* ev = &events[(first + i) & HIST_MASK];
+        double ts_us = (double) (int64_t) (ev->start_ns - g_epoch_ns) / 1000.0;
+        w_printf(w, "%s\n{\"name\":", sep ? "," : "");
+        w_string(w, rogue_prof_zone_name(ev->zone));
+        w_printf(w,
+                 ",\"cat\":\"rogue\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d,"
+                 "\"args\":{\"depth\":%d}}",
+                 ts_us, (double) ev->dur_ns / 1000.0, ev->tid, (int) ev->depth);
+        sep = 1;
+    }
+    w_printf(w, "\n],\"displayTimeUnit\":\"ms\"}\n");
+}
+
+static int export_to(ProfWriter* w, int capture)
+{
+    spin_lock(&g_drain_lock);
+    drain_locked();
+    if (capture && g_spike_count == 0)
+    {
+        spin_unlock(&g_drain_lock);
+        return -1;
+    }
+    if (capture)
+        export_locked(w, g_capture, g_capture_count, 0);
+    else
+    {
+        int count = g_hist_seq < ROGUE_PROF_HISTORY_EVENTS ? g_hist_seq : ROGUE_PROF_HISTORY_EVENTS;
+        export_locked(w, g_hist, count, g_hist_seq - count);
+    }
+    spin_unlock(&g_drain_lock);
+    return w->err ? -1 : 0;
+}
+
+int rogue_prof_export_chrome(char* buf, int cap, int capture)
+{
+    ProfWriter w = {buf, buf ? cap : 0, 0, NULL, 0};
+    if (export_to(&w, capture) != 0)
+        return -1;
+    return w.len;
+}
+
+int rogue_prof_export_chrome_file(const char* path, int capture)
+{
+    if (!path)
+        return -1;
+    FILE* f = NULL;
+#if defined(_MSC_VER)
+    fopen_s(&f, path, "wb");
+#else
+    f = fopen(path, "wb");
+#endif
+    if (!f)
+        return -1;
+    ProfWriter w = {NULL, 0, 0, f, 0};
+    int rc = export_to(&w, capture);
+    if (fclose(f) != 0)
+        rc = -1;
+    return rc;
+}
+
+void rogue_prof_reset(void)
+{
+    spin_lock(&g_drain_lock);
+    drain_locked();
+    g_hist_seq = 0;
+    memset(g_totals, 0, sizeof g_totals);
+    memset(g_frames, 0, sizeof g_frames);
+    g_frame_total = 0;
+    g_frame_first_seq = 0;
+    g_capture_count = 0;
+    g_spike_count = 0;
+    g_epoch_ns = rogue_prof_now_ns();
+    spin_unlock(&g_drain_lock);
+    prof_store(&g_dropped, 0);
+    g_frame_open = 0;
+    if (t_self)
+    {
+        t_self->depth = 0;
+        t_self->skipped = 0;
+    }
+}
+
+/* ---- Headless configuration ---- */
+static int prof_getenv(const char* name, char* out, size_t cap)
+{
+#if defined(_MSC_VER)
+    char* tmp = NULL;
+    size_t len = 0;
+    int ok = _dupenv_s(&tmp, &len, name) == 0 && tmp && *tmp;
+    if (ok)
+        strncpy_s(out, cap, tmp, _TRUNCATE);
+    free(tmp);
+    return ok;
+#else
+    const char* v = getenv(name);
+    if (!v || !*v)
+        return 0;
+    size_t len = strlen(v);
+    if (len >= cap)
+        len = cap - 1;
+    memcpy(out, v, len);
+    out[len] = '\0';
+    return 1;
+#endif
+}
+
+void rogue_prof_configure_from_env(void)
+{
+    char v[64];
+    int trace = prof_getenv("ROGUE_PROF_TRACE", g_trace_path, sizeof g_trace_path);
+    int spike = prof_getenv("ROGUE_PROF_SPIKE_MS", v, sizeof v);
+    if (spike)
+        rogue_prof_set_spike_threshold(strtod(v, NULL), 0);
+    prof_getenv("ROGUE_PROF_SPIKE_TRACE", g_spike_trace_path, sizeof g_spike_trace_path);
+    if (trace || spike)
+    {
+        rogue_prof_reset();
+        rogue_prof_set_enabled(1);
+        ROGUE_LOG_INFO("profiler: recording (trace=%s spike_ms=%.2f)",
+                       trace ? g_trace_path : "-", g_spike_ms);
+    }
+}
+
+void rogue_prof_shutdown_export(void)
+{
+    if (g_trace_path[0] && rogue_prof_export_chrome_file(g_trace_path, 0) != 0)
+        ROGUE_LOG_WARN("profiler: failed to write trace %s", g_trace_path);
+    if (g_spike_trace_path[0] && rogue_prof_spike_count() > 0 &&
+        rogue_prof_export_chrome_file(g_spike_trace_path, 1) != 0)
+        ROGUE_LOG_WARN("profiler: failed to write spike trace %s", g_spike_trace_path);
+}
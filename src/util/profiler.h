@@ -0,0 +1,130 @@
+/* Unified hierarchical frame profiler (Perf follow-up).
+ *
+ * One instrumentation layer for every subsystem timer:
+ *  - rogue_prof_now_ns: monotonic high-resolution clock (QueryPerformanceCounter /
+ *    CLOCK_MONOTONIC_RAW / CLOCK_MONOTONIC), shared by the equipment, loot, AI, UI and frame
+ *    metrics timers.
+ *  - Zones: names registered once into a fixed table; call sites cache the id in a static slot
+ *    (ROGUE_PROF_BEGIN / ROGUE_PROF_END), so the hot path never compares strings.
+ *  - Nested scopes: each thread keeps its own scope stack; a closed scope becomes one event
+ *    {start, duration, zone, depth} pushed into that thread's single-producer ring buffer. Rings
+ *    are lock-free; whichever thread holds the drain try-lock (frame end, a ring running full,
+ *    stats or export) moves their events into a shared history and per-zone totals.
+ *  - Frames: rogue_prof_frame_begin / end bracket a "frame" zone and keep the last
+ *    ROGUE_PROF_FRAME_HISTORY frame times. A frame longer than the spike threshold copies the
+ *    events of the last N frames into a capture buffer that survives later frames.
+ *  - Export: Chrome trace-event JSON ("X" complete events, microseconds), loadable by
+ *    chrome://tracing and Perfetto, from the history or the spike capture.
+ *
+ * Recording is off until rogue_prof_set_enabled(1) or rogue_prof_configure_from_env (headless
+ * runs: ROGUE_PROF_TRACE=<file> enables recording and writes the trace on app shutdown,
+ * ROGUE_PROF_SPIKE_MS=<ms> arms spike capture, ROGUE_PROF_SPIKE_TRACE=<file> writes the capture).
+ * Building with ROGUE_ENABLE_PROFILER=0 compiles the scope macros out and turns recording into
+ * no-ops; the clock and zone registry stay available to the subsystem profilers. */
+#ifndef ROGUE_UTIL_PROFILER_H
+#define ROGUE_UTIL_PROFILER_H
+
+#include <stdint.h>
+
+#ifndef ROGUE_ENABLE_PROFILER
+#define ROGUE_ENABLE_PROFILER 1
+#endif
+
+#define ROGUE_PROF_MAX_ZONES 256
+#define ROGUE_PROF_ZONE_NAME_CAP 32
+#define ROGUE_PROF_MAX_THREADS 16
+#define ROGUE_PROF_RING_EVENTS 4096 /* per thread, power of two */
+#define ROGUE_PROF_MAX_DEPTH 32
+#define ROGUE_PROF_HISTORY_EVENTS 32768 /* power of two */
+#define ROGUE_PROF_FRAME_HISTORY 120
+
+typedef struct RogueProfZoneSlot
+{
+    int id_plus_one; /* 0 = not registered yet; written once, read atomically */
+} RogueProfZoneSlot;
+
+typedef struct RogueProfZoneStats
+{
+    double total_ms;
+    double max_ms;
+    int count;
+} RogueProfZoneStats;
+
+typedef struct RogueProfFrameInfo
+{
+    uint32_t index;
+    double ms;
+    int events;
+} RogueProfFrameInfo;
+
+/* Monotonic nanoseconds (arbitrary epoch). */
+uint64_t rogue_prof_now_ns(void);
+
+/* Zone registry: returns the id for name (registering it on first use), -1 when full. Names
+ * longer than ROGUE_PROF_ZONE_NAME_CAP-1 are truncated. Thread-safe. */
+int rogue_prof_zone_register(const char* name);
+/* Cached registration for call sites: first call registers, later calls are one atomic load. */
+int rogue_prof_zone_slot(RogueProfZoneSlot* slot, const char* name);
+const char* rogue_prof_zone_name(int zone);
+int rogue_prof_zone_count(void);
+
+/* Runtime switch (off by default). Disabling drops open scopes on their next end. */
+void rogue_prof_set_enabled(int enabled);
+int rogue_prof_enabled(void);
+
+/* Scopes on the calling thread. end closes the innermost open scope of that zone (and any
+ * scopes still open inside it); an end without a matching begin is ignored. */
+void rogue_prof_begin(int zone);
+void rogue_prof_end(int zone);
+/* Record an already measured scope of dur_ns ending now at the current depth. */
+void rogue_prof_complete(int zone, uint64_t dur_ns);
+/* Name the calling thread in exported traces. */
+void rogue_prof_thread_name(const char* name);
+
+/* Frame markers (owning thread); frame_end drains all thread rings and checks for a spike. */
+void rogue_prof_frame_begin(void);
+void rogue_prof_frame_end(void);
+/* Last `max` frames, oldest first; returns the number written. */
+int rogue_prof_frames(RogueProfFrameInfo* out, int max);
+
+/* Spike capture: a frame longer than threshold_ms (0 = off) captures the last `frames` frames
+ * (1..ROGUE_PROF_FRAME_HISTORY; 0 keeps the current count, default 8). */
+void rogue_prof_set_spike_threshold(double threshold_ms, int frames);
+/* Number of spikes captured since reset; the capture holds the most recent one. */
+int rogue_prof_spike_count(void);
+
+/* Move pending ring events into the history (also done by frame end / stats / export). */
+void rogue_prof_flush(void);
+/* Totals of closed scopes since reset. Returns 0, or -1 if the zone never completed. */
+int rogue_prof_zone_stats(int zone, RogueProfZoneStats* out);
+/* Events dropped because a thread ring or the thread table was full. */
+int rogue_prof_dropped(void);
+
+/* Chrome trace-event JSON of the retained history (capture=0) or the last spike capture
+ * (capture=1). Returns the full length (like snprintf; output truncated when >= cap, buf may be
+ * NULL with cap 0) or -1 when there is nothing to export for capture=1. */
+int rogue_prof_export_chrome(char* buf, int cap, int capture);
+/* Same as a file; returns 0 on success, -1 on I/O error or nothing to export. */
+int rogue_prof_export_chrome_file(const char* path, int capture);
+
+/* Clear history, stats, frames and captures (zone ids stay valid). Call with no scopes open on
+ * other threads. */
+void rogue_prof_reset(void);
+
+/* Headless hooks used by the app: read the ROGUE_PROF_* variables at init, write the requested
+ * traces at shutdown. */
+void rogue_prof_configure_from_env(void);
+void rogue_prof_shutdown_export(void);
+
+#if ROGUE_ENABLE_PROFILER
+#define ROGUE_PROF_BEGIN(name)                                                                     \
+    static RogueProfZoneSlot rogue_prof_slot_;                                                     \
+    const int rogue_prof_zone_ = rogue_prof_zone_slot(&rogue_prof_slot_, name);                    \
+    rogue_prof_begin(rogue_prof_zone_)
+#define ROGUE_PROF_END() rogue_prof_end(rogue_prof_zone_)
+#else
+#define ROGUE_PROF_BEGIN(name) ((void) 0)
+#define ROGUE_PROF_END() ((void) 0)
+#endif
+
+#endif
@@ -19,15 +19,16 @@ int rogue_item_sprite_load_atlas(const char* path)
         if (rw)
         {
             SDL_RWclose(rw);
-            ROGUE_LOG_DEBUG("item_sprite_atlas_probe_ok: %s", path);
+            ROGUE_LOGC_DEBUG(ROGUE_LOG_CAT_RENDER, "item_sprite_atlas_probe_ok: %s", path);
         }
         else
         {
-            ROGUE_LOG_WARN("item_sprite_atlas_probe_fail: %s", path);
+            ROGUE_LOGC_WARN(ROGUE_LOG_CAT_RENDER, "item_sprite_atlas_probe_fail: %s", path);
         }
     }
 #else
-    ROGUE_LOG_DEBUG("item_sprite_atlas_noop_no_sdl: %s", path ? path : "<null>");
+    ROGUE_LOGC_DEBUG(ROGUE_LOG_CAT_RENDER, "item_sprite_atlas_noop_no_sdl: %s",
+                     path ? path : "<null>");
 #endif
     return 0;
 }
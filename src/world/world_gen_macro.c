@@ -4,6 +4,7 @@
  * RogueWorldGenContext RNG channels.
  */
 #include "world_gen.h"
+#include "../util/log.h"
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -477,8 +478,8 @@ bool rogue_world_generate_macro_layout(const RogueWorldGenConfig* cfg, RogueWorl
         identify_continents(out_map, out_continent_count);
     }
 /* DEBUG: compute quick counts if everything appears zero in tests */
-#ifdef _DEBUG
-    {
+    if (ROGUE_LOG_ENABLED(ROGUE_LOG_DEBUG_LEVEL, ROGUE_LOG_CAT_WORLDGEN))
+    { /* full-map scan; only when worldgen debug output is enabled */
         int water_dbg = 0, land_dbg = 0, river_dbg = 0;
         int total_dbg = w * h;
         for (int i = 0; i < total_dbg; i++)
@@ -492,16 +493,17 @@ bool rogue_world_generate_macro_layout(const RogueWorldGenConfig* cfg, RogueWorl
                 land_dbg++;
         }
         if (water_dbg == 0 && land_dbg == 0 && river_dbg == 0)
-        { /* suspicious: print first 16 tiles raw */
-            fprintf(stderr, "[macro_gen debug] All counts zero. First 32 raw bytes: ");
-            for (int i = 0; i < 32 && i < total_dbg; i++)
-            {
-                fprintf(stderr, "%u ", (unsigned) out_map->tiles[i]);
-            }
-            fprintf(stderr, "\n");
+        { /* suspicious: log the first 32 tiles raw */
+            char raw[160];
+            size_t n = 0;
+            raw[0] = '\0';
+            for (int i = 0; i < 32 && i < total_dbg && n < sizeof raw; i++)
+                n += (size_t) snprintf(raw + n, sizeof raw - n, "%u ",
+                                       (unsigned) out_map->tiles[i]);
+            ROGUE_LOGC_DEBUG(ROGUE_LOG_CAT_WORLDGEN,
+                             "macro_gen: all counts zero. First 32 raw bytes: %s", raw);
         }
     }
-#endif
     free_macro_tmp(&tmp);
     return true;
 }
@@ -300,29 +300,5 @@ int rogue_worldgen_run_noise_benchmark(int width, int height, RogueWorldGenBench
             speedup = scalar_ms / simd_ms;
     }
     *out_bench = (RogueWorldGenBenchmark){scalar_ms, simd_ms, speedup, total};
-/* Regression baseline (optional): store/update simple text file */
-#ifdef _MSC_VER
-    {
-        FILE* f = NULL;
-        fopen_s(&f, "worldgen_noise.baseline", "r");
-        double base_scalar = 0, base_simd = 0;
-        int have = 0;
-        if (f)
-        {
-            if (fscanf_s(f, "%lf %lf", &base_scalar, &base_simd) == 2)
-                have = 1;
-            fclose(f);
-        }
-        if (have && base_scalar > 0)
-        { /* future: tolerance comparison */
-        }
-        fopen_s(&f, "worldgen_noise.baseline", "w");
-        if (f)
-        {
-            fprintf(f, "%.4f %.4f\n", scalar_ms, simd_ms);
-            fclose(f);
-        }
-    }
-#endif
     return 1;
 }
@@ -12,6 +12,7 @@
 #include "../core/loot/loot_instances.h"
 #include "../core/loot/loot_rarity.h"
 #include "../graphics/sprite.h"
+#include "../graphics/texture_cache.h"
 #include "../graphics/tile_sprites.h"
 #ifdef ROGUE_HAVE_SDL
 #include <SDL.h>
@@ -83,11 +84,12 @@ void rogue_world_render_tiles(void)
                     run++;
                 }
 #ifdef ROGUE_HAVE_SDL
-                SDL_Rect src = {spr->sx, spr->sy, spr->sw, spr->sh};
+                SDL_Rect src = {spr->tex->ax + spr->sx, spr->tex->ay + spr->sy, spr->sw, spr->sh};
                 for (int i = 0; i < run; i++)
                 {
                     SDL_Rect dst = {(int) ((x + i) * tsz - g_app.cam_x),
                                     (int) (y * tsz - g_app.cam_y), tsz * scale, tsz * scale};
+                    rogue_texture_cache_note_draw(spr->tex->handle);
                     SDL_RenderCopy(g_app.renderer, spr->tex->handle, &src, &dst);
                 }
 #else
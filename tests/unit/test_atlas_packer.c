@@ -0,0 +1,232 @@
+/* Skyline atlas packer + baked manifests: placements never overlap and keep their padding, pages
+ * fill densely, bakes are deterministic and round-trip through the manifest file, path keys are
+ * normalized, and the texture cache counts binds only when the drawn texture changes. */
+#include "../../src/graphics/atlas_packer.h"
+#include "../../src/graphics/texture_cache.h"
+#include "../../src/util/profiler.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int g_fail = 0;
+#define CHECK(c)                                                                                   \
+    do                                                                                             \
+    {                                                                                              \
+        if (!(c))                                                                                  \
+        {                                                                                          \
+            printf("ATLAS_PACKER_FAIL line %d: %s\n", __LINE__, #c);                              \
+            g_fail = 1;                                                                            \
+        }                                                                                          \
+    } while (0)
+
+typedef struct Rect
+{
+    int x, y, w, h;
+} Rect;
+
+/* Padded rects must be disjoint and the image itself inside the page. */
+static int rects_valid(const Rect* r, int n, int page_w, int page_h, int pad)
+{
+    for (int i = 0; i < n; ++i)
+    {
+        if (r[i].x < 0 || r[i].y < 0 || r[i].x + r[i].w > page_w || r[i].y + r[i].h > page_h)
+            return 0;
+        for (int j = i + 1; j < n; ++j)
+        {
+            if (r[i].x < r[j].x + r[j].w + pad && r[j].x < r[i].x + r[i].w + pad &&
+                r[i].y < r[j].y + r[j].h + pad && r[j].y < r[i].y + r[i].h + pad)
+                return 0;
+        }
+    }
+    return 1;
+}
+
+static void test_packer_basic(void)
+{
+    RogueAtlasPacker p;
+    CHECK(rogue_atlas_packer_init(&p, 64, 64, 0) == 0);
+    int x = -1, y = -1;
+    CHECK(rogue_atlas_packer_insert(&p, 64, 64, &x, &y) == 1 && x == 0 && y == 0);
+    CHECK(rogue_atlas_packer_insert(&p, 1, 1, &x, &y) == 0); /* full */
+    CHECK(rogue_atlas_packer_occupancy(&p) > 0.999);
+    rogue_atlas_packer_free(&p);
+
+    CHECK(rogue_atlas_packer_init(&p, 64, 64, 2) == 0);
+    CHECK(rogue_atlas_packer_insert(&p, 65, 1, &x, &y) == 0);
+    CHECK(rogue_atlas_packer_insert(&p, 0, 4, &x, &y) == 0);
+    /* padding may hang off the edge: four 31x31 images plus 2px gutters fit a 64x64 page */
+    Rect r[4];
+    for (int i = 0; i < 4; ++i)
+    {
+        r[i].w = r[i].h = 31;
+        CHECK(rogue_atlas_packer_insert(&p, 31, 31, &r[i].x, &r[i].y) == 1);
+    }
+    CHECK(rects_valid(r, 4, 64, 64, 2));
+    CHECK(rogue_atlas_packer_insert(&p, 1, 1, &x, &y) == 0);
+    rogue_atlas_packer_free(&p);
+    CHECK(rogue_atlas_packer_init(&p, 0, 64, 0) == -1);
+}
+
+static void test_packer_random(void)
+{
+    enum
+    {
+        N = 400
+    };
+    static Rect r[N];
+    RogueAtlasPacker p;
+    CHECK(rogue_atlas_packer_init(&p, 1024, 1024, 1) == 0);
+    unsigned seed = 12345u;
+    int placed = 0;
+    long long area = 0;
+    for (int i = 0; i < N; ++i)
+    {
+        seed = seed * 1103515245u + 12345u;
+        int w = 8 + (int) ((seed >> 8) % 57u);
+        seed = seed * 1103515245u + 12345u;
+        int h = 8 + (int) ((seed >> 8) % 57u);
+        Rect* q = &r[placed];
+        if (rogue_atlas_packer_insert(&p, w, h, &q->x, &q->y))
+        {
+            q->w = w;
+            q->h = h;
+            area += (long long) w * h;
+            placed++;
+        }
+    }
+    CHECK(placed > 200);
+    CHECK(rects_valid(r, placed, 1024, 1024, 1));
+    double image_fill = (double) area / (1024.0 * 1024.0);
+    CHECK(rogue_atlas_packer_occupancy(&p) >= image_fill);
+    printf("atlas_packer: placed=%d/%d image_fill=%.2f occupancy=%.2f\n", placed, N, image_fill,
+           rogue_atlas_packer_occupancy(&p));
+    rogue_atlas_packer_free(&p);
+}
+
+static void test_bake_roundtrip(void)
+{
+    /* 40 small tile sheets and 8 character strips, one too large for any page */
+    enum
+    {
+        N = 48
+    };
+    static char names[N][32];
+    const char* paths[N];
+    int ws[N], hs[N];
+    for (int i = 0; i < N; ++i)
+    {
+        snprintf(names[i], sizeof names[i], "assets/sheet_%02d.png", i);
+        paths[i] = names[i];
+        ws[i] = i < 40 ? 64 : 192;
+        hs[i] = i < 40 ? 32 : 64;
+    }
+    ws[5] = 600; /* larger than the page: left out */
+    RogueAtlasManifest m;
+    int pages = rogue_atlas_manifest_bake(&m, paths, ws, hs, N, 512, 1);
+    CHECK(pages >= 1 && m.count == N - 1);
+    CHECK(rogue_atlas_manifest_find(&m, "assets/sheet_05.png") == NULL);
+    Rect* r = (Rect*) malloc(sizeof(Rect) * (size_t) m.count);
+    for (int page = 0; page < pages && r; ++page)
+    {
+        int n = 0;
+        for (int i = 0; i < m.count; ++i)
+            if (m.items[i].page == page)
+            {
+                r[n].x = m.items[i].x;
+                r[n].y = m.items[i].y;
+                r[n].w = m.items[i].w;
+                r[n].h = m.items[i].h;
+                n++;
+            }
+        CHECK(n > 0 && rects_valid(r, n, 512, 512, 1));
+    }
+    free(r);
+    /* deterministic regardless of input order */
+    const char* rev_paths[N];
+    int rev_w[N], rev_h[N];
+    for (int i = 0; i < N; ++i)
+    {
+        rev_paths[i] = paths[N - 1 - i];
+        rev_w[i] = ws[N - 1 - i];
+        rev_h[i] = hs[N - 1 - i];
+    }
+    RogueAtlasManifest m2;
+    CHECK(rogue_atlas_manifest_bake(&m2, rev_paths, rev_w, rev_h, N, 512, 1) == pages);
+    CHECK(m2.count == m.count);
+    for (int i = 0; i < m.count && i < m2.count; ++i)
+        CHECK(strcmp(m.items[i].path, m2.items[i].path) == 0 && m.items[i].x == m2.items[i].x &&
+              m.items[i].y == m2.items[i].y && m.items[i].page == m2.items[i].page);
+    rogue_atlas_manifest_free(&m2);
+
+    const char* file = "test_atlas_packer.manifest";
+    CHECK(rogue_atlas_manifest_write(&m, file) == 0);
+    RogueAtlasManifest back;
+    CHECK(rogue_atlas_manifest_read(&back, file) == 0);
+    CHECK(back.page_w == 512 && back.page_h == 512 && back.padding == 1 &&
+          back.page_count == pages && back.count == m.count);
+    const RogueAtlasPlacement* a = rogue_atlas_manifest_find(&m, "assets/sheet_41.png");
+    const RogueAtlasPlacement* b = rogue_atlas_manifest_find(&back, "assets/sheet_41.png");
+    CHECK(a && b && a->page == b->page && a->x == b->x && a->y == b->y && b->w == 192);
+    rogue_atlas_manifest_free(&back);
+    CHECK(rogue_texture_cache_load_manifest(file) == 0);
+    remove(file);
+    CHECK(rogue_atlas_manifest_read(&back, file) == -1);
+
+    /* corrupt manifests are rejected */
+    FILE* f = fopen(file, "wb");
+    if (f)
+    {
+        fprintf(f, "ATLAS 64 64 0 1\n0 60 0 8 8 assets/too_wide.png\n");
+        fclose(f);
+    }
+    CHECK(rogue_atlas_manifest_read(&back, file) == -1);
+    remove(file);
+    rogue_atlas_manifest_free(&m);
+}
+
+static void test_normalize(void)
+{
+    char p[64];
+    snprintf(p, sizeof p, "%s", ".\\assets\\\\tiles//grass.png");
+    rogue_atlas_normalize_path(p);
+    CHECK(strcmp(p, "assets/tiles/grass.png") == 0);
+    snprintf(p, sizeof p, "%s", "../assets/./character/a.png");
+    rogue_atlas_normalize_path(p);
+    CHECK(strcmp(p, "../assets/character/a.png") == 0);
+    snprintf(p, sizeof p, "%s", "assets/.hidden.png");
+    rogue_atlas_normalize_path(p);
+    CHECK(strcmp(p, "assets/.hidden.png") == 0);
+}
+
+static void test_bind_counting(void)
+{
+    int page_a = 0, page_b = 0, loose = 0;
+    const void* order[] = {&page_a, &page_a, &page_a, &page_b, &page_b, &page_a, &loose};
+    rogue_texture_cache_frame_reset();
+    for (size_t i = 0; i < sizeof order / sizeof order[0]; ++i)
+        rogue_texture_cache_note_draw(order[i]);
+    rogue_texture_cache_frame_reset();
+    RogueTextureCacheStats st;
+    rogue_texture_cache_get_stats(&st);
+    CHECK(st.draws_last_frame == 7 && st.binds_last_frame == 4);
+    rogue_texture_cache_frame_reset();
+    rogue_texture_cache_get_stats(&st);
+    CHECK(st.draws_last_frame == 0 && st.binds_last_frame == 0);
+}
+
+int main(void)
+{
+    test_packer_basic();
+    uint64_t t0 = rogue_prof_now_ns();
+    test_packer_random();
+    uint64_t t1 = rogue_prof_now_ns();
+    test_bake_roundtrip();
+    test_normalize();
+    test_bind_counting();
+    rogue_texture_cache_shutdown();
+    printf("atlas_packer: random pack %.3f ms\n", (double) (t1 - t0) / 1e6);
+    if (g_fail)
+        return 1;
+    printf("ATLAS_PACKER_OK\n");
+    return 0;
+}
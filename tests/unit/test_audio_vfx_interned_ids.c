@@ -0,0 +1,140 @@
+/* Interned FX ids: handles are stable and unique, registries resolve by handle, string and id
+ * triggers produce identical frames, compaction merges interleaved duplicates, and queues accept
+ * 10k events per frame. Prints a trigger -> dispatch timing line. */
+#include "../../src/audio_vfx/effects.h"
+#include "../../src/util/profiler.h"
+#include <stdio.h>
+#include <string.h>
+
+static int g_fail = 0;
+#define CHECK(c)                                                                                   \
+    do                                                                                             \
+    {                                                                                              \
+        if (!(c))                                                                                  \
+        {                                                                                          \
+            printf("FX_INTERN_FAIL line %d: %s\n", __LINE__, #c);                                 \
+            g_fail = 1;                                                                            \
+        }                                                                                          \
+    } while (0)
+
+static void test_intern(void)
+{
+    RogueFxId a = rogue_fx_intern("fx/alpha");
+    CHECK(a != ROGUE_FX_ID_NONE && rogue_fx_intern("fx/alpha") == a);
+    CHECK(rogue_fx_id_find("fx/alpha") == a && strcmp(rogue_fx_id_str(a), "fx/alpha") == 0);
+    CHECK(rogue_fx_intern("fx/beta") != a);
+    CHECK(rogue_fx_id_find("fx/never_interned") == ROGUE_FX_ID_NONE);
+    CHECK(rogue_fx_intern("") == ROGUE_FX_ID_NONE && rogue_fx_intern(NULL) == ROGUE_FX_ID_NONE);
+    CHECK(rogue_fx_intern("0123456789012345678901234567890123456789") == ROGUE_FX_ID_NONE);
+    CHECK(rogue_fx_id_str(ROGUE_FX_ID_NONE) == NULL);
+}
+
+static void emit_id(const char* id, RogueEffectEventType type, RogueEffectPriority pri)
+{
+    RogueEffectEvent ev;
+    memset(&ev, 0, sizeof ev);
+    ev.type = (uint8_t) type;
+    ev.priority = (uint8_t) pri;
+    strncpy(ev.id, id, sizeof ev.id - 1);
+    CHECK(rogue_fx_emit(&ev) == 0);
+}
+
+static void test_registries_and_bus(void)
+{
+    rogue_audio_registry_clear();
+    rogue_vfx_registry_clear();
+    rogue_vfx_clear_active();
+    rogue_fx_map_clear();
+    CHECK(rogue_audio_registry_register("hit", "assets/sfx/hit.wav", ROGUE_AUDIO_CAT_SFX, 1.0f) ==
+          0);
+    CHECK(rogue_audio_registry_register("hit_1", "assets/sfx/hit1.wav", ROGUE_AUDIO_CAT_SFX,
+                                        1.0f) == 0);
+    CHECK(rogue_vfx_registry_register("spark", ROGUE_VFX_LAYER_FG, 500, 1) == 0);
+    char path[64];
+    CHECK(rogue_audio_registry_get_path("hit_1", path, sizeof path) == 0 &&
+          strcmp(path, "assets/sfx/hit1.wav") == 0);
+    CHECK(rogue_audio_registry_get_path("hit_2", path, sizeof path) != 0);
+    CHECK(rogue_fx_map_register("combat/hit", ROGUE_FX_MAP_AUDIO, "hit", ROGUE_FX_PRI_COMBAT) == 0);
+    CHECK(rogue_fx_map_register("combat/hit", ROGUE_FX_MAP_VFX, "spark", ROGUE_FX_PRI_COMBAT) ==
+          0);
+
+    /* string and handle triggers enqueue the same frame */
+    rogue_fx_frame_begin(1);
+    CHECK(rogue_fx_trigger_event("combat/hit", 1.0f, 2.0f) == 2);
+    CHECK(rogue_fx_trigger_event("combat/unknown", 0.0f, 0.0f) == 0);
+    rogue_fx_frame_end();
+    CHECK(rogue_fx_dispatch_process() == 2);
+    uint32_t d_str = rogue_fx_get_frame_digest();
+    CHECK(rogue_vfx_active_count() == 1);
+    rogue_fx_frame_begin(1);
+    CHECK(rogue_fx_trigger_event_id(rogue_fx_intern("combat/hit"), 1.0f, 2.0f) == 2);
+    rogue_fx_frame_end();
+    CHECK(rogue_fx_dispatch_process() == 2);
+    CHECK(rogue_fx_get_frame_digest() == d_str);
+
+    /* interleaved duplicates merge after sorting; ids never seen before are interned on emit */
+    rogue_fx_frame_begin(2);
+    emit_id("zeta_new", ROGUE_FX_VFX_SPAWN, ROGUE_FX_PRI_UI);
+    emit_id("spark", ROGUE_FX_VFX_SPAWN, ROGUE_FX_PRI_UI);
+    emit_id("zeta_new", ROGUE_FX_VFX_SPAWN, ROGUE_FX_PRI_UI);
+    emit_id("spark", ROGUE_FX_VFX_SPAWN, ROGUE_FX_PRI_UI);
+    emit_id("spark", ROGUE_FX_VFX_SPAWN, ROGUE_FX_PRI_CRITICAL);
+    rogue_fx_frame_end();
+    CHECK(rogue_fx_dispatch_process() == 3);
+    CHECK(rogue_fx_id_find("zeta_new") != ROGUE_FX_ID_NONE);
+
+    /* clearing a registry drops its handle lookups */
+    rogue_vfx_registry_clear();
+    RogueVfxLayer layer;
+    CHECK(rogue_vfx_registry_get("spark", &layer, NULL, NULL) != 0);
+    CHECK(rogue_vfx_registry_register("spark", ROGUE_VFX_LAYER_BG, 100, 0) == 0);
+    CHECK(rogue_vfx_registry_get("spark", &layer, NULL, NULL) == 0 && layer == ROGUE_VFX_LAYER_BG);
+}
+
+static void bench(void)
+{
+    enum
+    {
+        KEYS = 64,
+        EVENTS = 10000,
+        FRAMES = 60
+    };
+    rogue_audio_registry_clear();
+    rogue_vfx_registry_clear();
+    rogue_fx_map_clear();
+    RogueFxId keys[KEYS];
+    for (int k = 0; k < KEYS; ++k)
+    {
+        char id[24], key[32];
+        snprintf(id, sizeof id, "bench_sfx_%d", k);
+        rogue_audio_registry_register(id, "assets/sfx/bench.wav", ROGUE_AUDIO_CAT_SFX, 0.5f);
+        snprintf(key, sizeof key, "bench/key/%d", k);
+        rogue_fx_map_register(key, ROGUE_FX_MAP_AUDIO, id, (RogueEffectPriority) (k & 3));
+        keys[k] = rogue_fx_intern(key);
+    }
+    int processed = 0, emitted = 0;
+    uint64_t t0 = rogue_prof_now_ns();
+    for (int f = 0; f < FRAMES; ++f)
+    {
+        rogue_fx_frame_begin((uint32_t) (100 + f));
+        for (int i = 0; i < EVENTS; ++i)
+            emitted += rogue_fx_trigger_event_id(keys[(i * 7 + f) % KEYS], 0.0f, 0.0f);
+        rogue_fx_frame_end();
+        processed += rogue_fx_dispatch_process();
+    }
+    double ns = (double) (rogue_prof_now_ns() - t0) / ((double) FRAMES * EVENTS);
+    CHECK(emitted == FRAMES * EVENTS && processed == FRAMES * KEYS);
+    printf("fx_intern_bench: events/frame=%d frames=%d keys=%d trigger+dispatch=%.1fns/event\n",
+           EVENTS, FRAMES, KEYS, ns);
+}
+
+int main(void)
+{
+    test_intern();
+    test_registries_and_bus();
+    bench();
+    if (g_fail)
+        return 1;
+    printf("FX_INTERN_OK\n");
+    return 0;
+}
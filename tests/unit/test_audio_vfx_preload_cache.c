@@ -0,0 +1,187 @@
+/* Audio preload + decoded sample cache: preloaded sounds play without in-frame stalls, queued
+ * decodes honour priority, the byte budget evicts least recently played samples, music tracks
+ * stay pinned while audible, and registry changes drop stale samples. Uses a fake decoder so it
+ * runs without an audio device. */
+#include "../../src/audio_vfx/effects.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int g_fail = 0;
+#define CHECK(c)                                                                                   \
+    do                                                                                             \
+    {                                                                                              \
+        if (!(c))                                                                                  \
+        {                                                                                          \
+            printf("AUDIO_PRELOAD_FAIL line %d: %s\n", __LINE__, #c);                             \
+            g_fail = 1;                                                                            \
+        }                                                                                          \
+    } while (0)
+
+/* Paths encode the decoded size: "<bytes>/<name>"; "bad/..." fails to decode. */
+static int g_log_order = 0;
+static char g_order[16][32];
+static int g_order_count = 0;
+
+static void* fake_decode(const char* path, size_t* out_bytes)
+{
+    if (strncmp(path, "bad/", 4) == 0)
+        return NULL;
+    size_t bytes = (size_t) strtoul(path, NULL, 10);
+    if (g_log_order && g_order_count < 16)
+        snprintf(g_order[g_order_count++], sizeof g_order[0], "%s", path);
+    *out_bytes = bytes;
+    return malloc(bytes ? bytes : 1);
+}
+
+static void fake_release(void* sample) { free(sample); }
+
+static RogueAudioCacheStats stats(void)
+{
+    RogueAudioCacheStats st;
+    rogue_audio_cache_get_stats(&st);
+    return st;
+}
+
+static void test_preload_and_play(void)
+{
+    rogue_audio_registry_clear();
+    char id[16], path[32];
+    for (int i = 0; i < 8; ++i)
+    {
+        snprintf(id, sizeof id, "sfx%d", i);
+        snprintf(path, sizeof path, "1000/sfx%d.wav", i);
+        CHECK(rogue_audio_registry_register(id, path, ROGUE_AUDIO_CAT_SFX, 1.0f) == 0);
+    }
+    rogue_audio_registry_register("click", "500/click.wav", ROGUE_AUDIO_CAT_UI, 1.0f);
+    rogue_audio_registry_register("broken", "bad/broken.wav", ROGUE_AUDIO_CAT_UI, 1.0f);
+    CHECK(rogue_audio_preload_category(ROGUE_AUDIO_CAT_SFX, 1) == 8);
+    CHECK(rogue_audio_preload_category(ROGUE_AUDIO_CAT_SFX, 1) == 0); /* already queued */
+    CHECK(rogue_audio_preload_id("nope", 0) == -1);
+    rogue_audio_preload_wait();
+    RogueAudioCacheStats st = stats();
+    CHECK(st.resident == 8 && st.pending == 0 && st.async_loads == 8 && st.resident_bytes == 8000);
+    for (int frame = 0; frame < 64; ++frame)
+    {
+        snprintf(id, sizeof id, "sfx%d", (frame * 5) % 8);
+        rogue_audio_play_by_id(id);
+        rogue_audio_cache_poll();
+    }
+    st = stats();
+    CHECK(st.stalls == 0 && st.hits == 64);
+    /* a sound nobody preloaded decodes in-frame once, then hits */
+    rogue_audio_play_by_id("click");
+    rogue_audio_play_by_id("click");
+    st = stats();
+    CHECK(st.stalls == 1 && st.hits == 65);
+    /* failed decodes are counted once and not retried every play */
+    rogue_audio_play_by_id("broken");
+    rogue_audio_play_by_id("broken");
+    st = stats();
+    CHECK(st.failures == 1 && st.stalls == 2);
+}
+
+static void test_priority_order(void)
+{
+    /* without workers, poll decodes one queued sound per frame, highest priority first */
+    rogue_audio_registry_clear();
+    rogue_audio_registry_register("low", "10/low", ROGUE_AUDIO_CAT_SFX, 1.0f);
+    rogue_audio_registry_register("high", "10/high", ROGUE_AUDIO_CAT_SFX, 1.0f);
+    rogue_audio_registry_register("mid", "10/mid", ROGUE_AUDIO_CAT_SFX, 1.0f);
+    g_log_order = 1;
+    g_order_count = 0;
+    rogue_audio_preload_id("low", 0);
+    rogue_audio_preload_id("high", 9);
+    rogue_audio_preload_id("mid", 3);
+    CHECK(stats().pending == 3);
+    rogue_audio_cache_poll();
+    CHECK(stats().pending == 2 && stats().resident == 1);
+    rogue_audio_preload_id("low", 5); /* bumped above mid */
+    rogue_audio_cache_poll();
+    rogue_audio_cache_poll();
+    g_log_order = 0;
+    CHECK(g_order_count == 3 && strcmp(g_order[0], "10/high") == 0 &&
+          strcmp(g_order[1], "10/low") == 0 && strcmp(g_order[2], "10/mid") == 0);
+}
+
+static void test_budget_and_pins(void)
+{
+    rogue_audio_registry_clear();
+    rogue_audio_registry_register("a", "100/a", ROGUE_AUDIO_CAT_SFX, 1.0f);
+    rogue_audio_registry_register("b", "100/b", ROGUE_AUDIO_CAT_SFX, 1.0f);
+    rogue_audio_registry_register("c", "100/c", ROGUE_AUDIO_CAT_SFX, 1.0f);
+    rogue_audio_registry_register("theme", "400/theme", ROGUE_AUDIO_CAT_MUSIC, 1.0f);
+    rogue_audio_registry_register("battle", "400/battle", ROGUE_AUDIO_CAT_MUSIC, 1.0f);
+    rogue_audio_cache_set_budget(200);
+    rogue_audio_play_by_id("a");
+    rogue_audio_play_by_id("b");
+    rogue_audio_play_by_id("a");
+    rogue_audio_play_by_id("c"); /* b is least recently played */
+    RogueAudioCacheStats st = stats();
+    CHECK(st.resident == 2 && st.evictions == 1 && st.resident_bytes == 200);
+    unsigned stalls = st.stalls;
+    rogue_audio_play_by_id("a");
+    CHECK(stats().stalls == stalls);
+    rogue_audio_play_by_id("b");
+    CHECK(stats().stalls == stalls + 1);
+
+    /* music tracks are pinned while audible and survive a budget they exceed */
+    CHECK(rogue_audio_music_register(ROGUE_MUSIC_STATE_EXPLORE, "theme") == 0);
+    CHECK(rogue_audio_music_register(ROGUE_MUSIC_STATE_COMBAT, "battle") == 0);
+    CHECK(rogue_audio_music_set_state(ROGUE_MUSIC_STATE_EXPLORE, 0) == 0);
+    rogue_audio_preload_wait();
+    st = stats();
+    CHECK(st.pinned == 1 && st.resident_bytes >= 400);
+    CHECK(rogue_audio_music_set_state(ROGUE_MUSIC_STATE_COMBAT, 500) == 0);
+    rogue_audio_preload_wait();
+    CHECK(stats().pinned == 2);
+    rogue_audio_music_update(250);
+    CHECK(stats().pinned == 2);
+    rogue_audio_music_update(300); /* fade finished: theme unpinned and evictable */
+    rogue_audio_cache_poll();
+    st = stats();
+    CHECK(st.pinned == 1 && st.resident == 1 && st.resident_bytes == 400);
+    CHECK(rogue_audio_cache_pin("c") == 1 && rogue_audio_cache_pin("c") == 2);
+    CHECK(rogue_audio_cache_unpin("c") == 1 && rogue_audio_cache_unpin("c") == 0);
+    CHECK(rogue_audio_cache_pin("nope") == -1);
+    rogue_audio_cache_set_budget((size_t) 32 * 1024 * 1024);
+}
+
+static void test_registry_changes(void)
+{
+    rogue_audio_registry_clear();
+    rogue_audio_registry_register("hit", "100/hit_v1", ROGUE_AUDIO_CAT_SFX, 1.0f);
+    rogue_audio_preload_id("hit", 0);
+    rogue_audio_preload_wait();
+    CHECK(stats().resident_bytes == 100);
+    rogue_audio_registry_register("hit", "100/hit_v1", ROGUE_AUDIO_CAT_SFX, 0.5f); /* same path */
+    CHECK(stats().resident == 1);
+    rogue_audio_registry_register("hit", "300/hit_v2", ROGUE_AUDIO_CAT_SFX, 0.5f);
+    CHECK(stats().resident == 0);
+    rogue_audio_preload_id("hit", 0);
+    rogue_audio_preload_wait();
+    CHECK(stats().resident_bytes == 300);
+    rogue_audio_registry_clear();
+    RogueAudioCacheStats st = stats();
+    CHECK(st.resident == 0 && st.resident_bytes == 0 && st.pinned == 0 && st.pending == 0);
+}
+
+int main(void)
+{
+    rogue_audio_cache_set_decoder(fake_decode, fake_release);
+    int workers = rogue_audio_preload_start(2);
+    test_preload_and_play();
+    test_budget_and_pins();
+    test_registry_changes();
+    RogueAudioCacheStats st = stats();
+    printf("audio_preload: workers=%d hits=%u stalls=%u async=%u evictions=%u stall_ms=%.3f\n",
+           workers, st.hits, st.stalls, st.async_loads, st.evictions, st.stall_ms);
+    rogue_audio_preload_shutdown();
+    test_priority_order(); /* no workers after shutdown */
+    rogue_audio_preload_shutdown();
+    rogue_audio_registry_clear();
+    if (g_fail)
+        return 1;
+    printf("AUDIO_PRELOAD_OK\n");
+    return 0;
+}
@@ -0,0 +1,152 @@
+/* Benchmark harness: percentiles, warmup / repetition accounting, filters, the JSON schema
+ * round trip and baseline comparison verdicts. */
+#include "../../src/util/bench.h"
+#include <stdio.h>
+#include <string.h>
+
+static int g_fail = 0;
+#define CHECK(c)                                                                                   \
+    do                                                                                             \
+    {                                                                                              \
+        if (!(c))                                                                                  \
+        {                                                                                          \
+            printf("BENCH_FAIL line %d: %s\n", __LINE__, #c);                                     \
+            g_fail = 1;                                                                            \
+        }                                                                                          \
+    } while (0)
+
+typedef struct Counter
+{
+    int setups, runs, teardowns;
+    int skip;
+} Counter;
+
+static int count_setup(void* ud)
+{
+    Counter* c = (Counter*) ud;
+    c->setups++;
+    return c->skip;
+}
+static void count_run(void* ud)
+{
+    volatile unsigned x = 0;
+    for (unsigned i = 0; i < 1000u; ++i)
+        x += i;
+    ((Counter*) ud)->runs++;
+}
+static void count_teardown(void* ud) { ((Counter*) ud)->teardowns++; }
+
+static void test_percentile(void)
+{
+    double s[] = {5, 1, 4, 2, 3};
+    CHECK(rogue_bench_percentile(s, 5, 50.0) == 3.0);
+    CHECK(s[0] == 1.0 && s[4] == 5.0); /* sorted in place */
+    CHECK(rogue_bench_percentile(s, 5, 95.0) == 5.0);
+    CHECK(rogue_bench_percentile(s, 5, 0.0) == 1.0);
+    double e[] = {4, 1, 3, 2};
+    CHECK(rogue_bench_percentile(e, 4, 50.0) == 2.5);
+    double twenty[20];
+    for (int i = 0; i < 20; ++i)
+        twenty[i] = (double) (20 - i);
+    CHECK(rogue_bench_percentile(twenty, 20, 95.0) == 19.0);
+    CHECK(rogue_bench_percentile(NULL, 0, 50.0) == 0.0);
+}
+
+static void test_run(void)
+{
+    Counter a = {0, 0, 0, 0}, b = {0, 0, 0, 1};
+    RogueBenchCase cases[] = {
+        {"group.alpha", count_setup, count_run, count_teardown, &a, 10},
+        {"group.skipped", count_setup, count_run, count_teardown, &b, 1},
+        {"other.beta", NULL, count_run, NULL, &a, 0},
+    };
+    RogueBenchConfig cfg = {2, 7, "group."};
+    RogueBenchReport rep;
+    CHECK(rogue_bench_run_all(cases, 3, &cfg, &rep) == 1);
+    CHECK(a.setups == 1 && a.runs == 9 && a.teardowns == 1);
+    CHECK(b.setups == 1 && b.runs == 0 && b.teardowns == 0); /* setup failure skips */
+    const RogueBenchResult* r = &rep.results[0];
+    CHECK(strcmp(r->name, "group.alpha") == 0 && r->ops == 10 && r->reps == 7);
+    CHECK(r->min_ns > 0.0 && r->min_ns <= r->median_ns && r->median_ns <= r->p95_ns);
+    cfg.filter = NULL;
+    cfg.reps = 100000; /* clamped */
+    CHECK(rogue_bench_run_all(cases, 3, &cfg, &rep) == 2);
+    CHECK(rep.reps == ROGUE_BENCH_MAX_REPS && rep.results[1].ops == 1);
+}
+
+static void test_json_and_compare(void)
+{
+    RogueBenchReport base;
+    memset(&base, 0, sizeof base);
+    base.warmup = 3;
+    base.reps = 15;
+    const char* names[] = {"a.same", "a.slow", "a.fast", "a.gone"};
+    double medians[] = {100.0, 100.0, 100.0, 50.0};
+    for (int i = 0; i < 4; ++i)
+    {
+        snprintf(base.results[i].name, sizeof base.results[i].name, "%s", names[i]);
+        base.results[i].ops = i + 1;
+        base.results[i].reps = 15;
+        base.results[i].median_ns = medians[i];
+        base.results[i].p95_ns = medians[i] * 1.5;
+        base.results[i].min_ns = medians[i] * 0.5;
+        base.results[i].mean_ns = medians[i] * 1.1;
+    }
+    base.count = 4;
+
+    const char* file = "test_bench.json";
+    CHECK(rogue_bench_save_json(&base, file) == 0);
+    RogueBenchReport back;
+    CHECK(rogue_bench_load_json(&back, file) == 0);
+    CHECK(back.warmup == 3 && back.reps == 15 && back.count == 4);
+    for (int i = 0; i < 4 && i < back.count; ++i)
+        CHECK(strcmp(back.results[i].name, names[i]) == 0 && back.results[i].ops == i + 1 &&
+              back.results[i].median_ns == medians[i] &&
+              back.results[i].p95_ns == medians[i] * 1.5);
+    remove(file);
+
+    RogueBenchReport cur;
+    memset(&cur, 0, sizeof cur);
+    const char* cur_names[] = {"a.same", "a.slow", "a.fast", "a.new"};
+    double cur_medians[] = {105.0, 125.0, 80.0, 10.0};
+    for (int i = 0; i < 4; ++i)
+    {
+        snprintf(cur.results[i].name, sizeof cur.results[i].name, "%s", cur_names[i]);
+        cur.results[i].median_ns = cur_medians[i];
+    }
+    cur.count = 4;
+    RogueBenchDelta d[8];
+    int n = 0;
+    CHECK(rogue_bench_compare(&back, &cur, 0.10, d, 8, &n) == 1);
+    CHECK(n == 5);
+    CHECK(d[0].verdict == ROGUE_BENCH_SAME && d[1].verdict == ROGUE_BENCH_SLOWER);
+    CHECK(d[1].ratio > 1.24 && d[1].ratio < 1.26 && d[1].base_ns == 100.0);
+    CHECK(d[2].verdict == ROGUE_BENCH_FASTER && d[3].verdict == ROGUE_BENCH_NEW);
+    CHECK(d[4].verdict == ROGUE_BENCH_MISSING && strcmp(d[4].name, "a.gone") == 0);
+    CHECK(rogue_bench_compare(&back, &cur, 0.30, NULL, 0, &n) == 0 && n == 0);
+
+    /* schema is required; malformed documents are rejected */
+    const char* bad[] = {
+        "{\"schema\": \"rogue_bench/2\", \"results\": []}",
+        "{\"results\": []}",
+        "{\"schema\": \"rogue_bench/1\", \"results\": [{\"ops\": 1}]}",
+        "{\"schema\": \"rogue_bench/1\", \"results\": [",
+    };
+    for (size_t i = 0; i < sizeof bad / sizeof bad[0]; ++i)
+        CHECK(rogue_bench_parse_json(&back, bad[i], strlen(bad[i])) == -1);
+    const char* extra = "{\"schema\": \"rogue_bench/1\", \"host\": {\"cpu\": \"x\"}, \"results\": "
+                        "[{\"name\": \"k\", \"median_ns\": 2.5, \"note\": [1, 2]}]}";
+    CHECK(rogue_bench_parse_json(&back, extra, strlen(extra)) == 0 && back.count == 1 &&
+          back.results[0].median_ns == 2.5);
+}
+
+int main(void)
+{
+    test_percentile();
+    test_run();
+    test_json_and_compare();
+    if (g_fail)
+        return 1;
+    printf("BENCH_OK\n");
+    return 0;
+}
@@ -0,0 +1,70 @@
+/* Phase 14 status buildup: a full bleed meter applies a ticking bleed that deals mitigated damage
+ * through rogue_combat_status_update, a full frost meter chills (slows) the enemy, records of a
+ * dead enemy are dropped on their next tick, and spawning into the slot clears the meters. */
+#include "../../src/core/app/app_state.h"
+#include "../../src/game/combat.h"
+#include "../../src/game/status_effects.h"
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+static void reset_world(void)
+{
+    rogue_status_reset();
+    rogue_damage_events_clear();
+    memset(&g_app, 0, sizeof g_app);
+    g_app.enemy_count = 1;
+    g_app.enemies[2].alive = 1;
+    g_app.enemies[2].health = 200;
+    g_app.enemies[2].max_health = 200;
+    g_app.enemies[2].resist_bleed = 50;
+}
+
+int main(void)
+{
+    reset_world();
+    RogueEnemy* e = &g_app.enemies[2];
+    RogueStatusEntity id = rogue_status_entity_enemy(2);
+
+    /* bleed: below threshold nothing applies, the filling hit consumes the meter */
+    rogue_combat_add_status_buildup(e, 2, 0.6f, 0.0f);
+    assert(rogue_status_entity_count(id) == 0 && e->bleed_buildup > 0.5f);
+    rogue_combat_add_status_buildup(e, 2, 0.6f, 0.0f);
+    assert(e->bleed_buildup == 0.0f);
+    assert(rogue_status_get_total(id, ROGUE_STATUS_BLEED) == 10); /* 5% of max health */
+
+    /* two ticks (500ms period) in one update: 20 raw, 50% resist -> 10 */
+    rogue_combat_status_update(1000.0);
+    assert(e->health == 190);
+    RogueDamageEvent evs[4];
+    int n = rogue_damage_events_snapshot(evs, 4);
+    assert(n == 1 && evs[0].damage_type == ROGUE_DMG_BLEED && evs[0].raw_damage == 20);
+
+    /* chill slows movement until it expires (applied at t=0, lasts 2500ms) */
+    assert(rogue_combat_enemy_move_scale(2) == 1.0f);
+    rogue_combat_add_status_buildup(e, 2, 0.0f, 1.0f);
+    float scale = rogue_combat_enemy_move_scale(2);
+    assert(scale > 0.6f && scale < 0.7f);
+    rogue_combat_status_update(2600.0); /* bleed ticks at 1500, 2000, 2500: 30 raw -> 15 */
+    assert(rogue_combat_enemy_move_scale(2) == 1.0f);
+    assert(e->health == 175);
+
+    /* a dead enemy's records are dropped on the next tick without further damage */
+    g_app.game_time_ms = 2600.0;
+    rogue_combat_add_status_buildup(e, 2, 1.0f, 0.0f);
+    assert(rogue_status_stacks(id, ROGUE_STATUS_BLEED) == 2);
+    e->health = 0;
+    rogue_combat_status_update(3200.0);
+    assert(rogue_status_entity_count(id) == 0 && e->health == 0);
+
+    /* spawning into the slot resets partially filled meters */
+    e->health = 200;
+    rogue_combat_add_status_buildup(e, 2, 0.5f, 0.5f);
+    rogue_combat_clear_enemy_status(e, 2);
+    assert(e->bleed_buildup == 0.0f && e->frost_buildup == 0.0f);
+    assert(rogue_status_entity_count(id) == 0);
+
+    rogue_status_shutdown();
+    puts("COMBAT_STATUS_BUILDUP_OK");
+    return 0;
+}
@@ -0,0 +1,220 @@
+/* Content loader: dependency levels, commits on the caller in load order after every dependency,
+ * failed parses skip their commit, cycles are rejected, and the startup manifest leaves the item
+ * and loot registries identical to the sequential loaders. */
+#define SDL_MAIN_HANDLED 1
+#include "../../src/core/app/content_manifest.h"
+#include "../../src/core/integration/content_loader.h"
+#include "../../src/core/loot/loot_item_defs.h"
+#include "../../src/core/loot/loot_tables.h"
+#include "../../src/util/profiler.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if defined(ROGUE_HAVE_SDL)
+#include <SDL.h>
+#endif
+
+typedef struct FakeTask
+{
+    const char* name;
+    int fail_parse;
+    double parse_ms;
+} FakeTask;
+
+static char g_commit_log[256];
+
+static void wait_ms(double ms)
+{
+#if defined(ROGUE_HAVE_SDL)
+    SDL_Delay((unsigned) ms); /* sleeping keeps the overlap check independent of core count */
+#else
+    uint64_t end = rogue_prof_now_ns() + (uint64_t) (ms * 1e6);
+    while (rogue_prof_now_ns() < end)
+    {
+    }
+#endif
+}
+
+static int fake_parse(void* user, void** out)
+{
+    FakeTask* t = (FakeTask*) user;
+    wait_ms(t->parse_ms);
+    if (t->fail_parse)
+        return -1;
+    *out = malloc(4);
+    return 1;
+}
+
+static int fake_commit(void* user, void* payload)
+{
+    (void) payload;
+    strcat(g_commit_log, ((FakeTask*) user)->name);
+    return 1;
+}
+
+static void fake_free(void* user, void* payload)
+{
+    (void) user;
+    free(payload);
+}
+
+static const RogueContentTaskTiming* timing_of(const RogueContentTimeline* tl, const char* name)
+{
+    for (int i = 0; i < tl->task_count; i++)
+        if (strcmp(tl->tasks[i].name, name) == 0)
+            return &tl->tasks[i];
+    return NULL;
+}
+
+int main(void)
+{
+    static RogueContentLoader loader;
+    static RogueContentTimeline tl;
+
+    /* 1. a,b,e independent; c after a+b; d after c; f fails to parse */
+    FakeTask fa = {"a", 0, 30.0}, fb = {"b", 0, 30.0}, fc = {"c", 0, 5.0}, fd = {"d", 0, 1.0},
+             fe = {"e", 0, 30.0}, ff = {"f", 1, 1.0};
+    FakeTask* all[] = {&fa, &fb, &fc, &fd, &fe, &ff};
+    if (rogue_content_loader_init(&loader) != 0)
+    {
+        printf("CONTENT_LOADER_FAIL init\n");
+        return 1;
+    }
+    for (int i = 0; i < 6; i++)
+        if (rogue_content_loader_add(&loader, all[i]->name, ROGUE_FILE_TYPE_OTHER, fake_parse,
+                                     fake_commit, fake_free, all[i]) != i)
+        {
+            printf("CONTENT_LOADER_FAIL add %d\n", i);
+            return 1;
+        }
+    if (rogue_content_loader_add(&loader, "a", ROGUE_FILE_TYPE_OTHER, fake_parse, fake_commit,
+                                 fake_free, &fa) != -1 ||
+        rogue_content_loader_depend(&loader, "c", "missing") != -1 ||
+        rogue_content_loader_depend(&loader, "c", "a") != 0 ||
+        rogue_content_loader_depend(&loader, "c", "b") != 0 ||
+        rogue_content_loader_depend(&loader, "d", "c") != 0)
+    {
+        printf("CONTENT_LOADER_FAIL registration checks\n");
+        return 1;
+    }
+    g_commit_log[0] = '\0';
+    int committed = rogue_content_loader_run(&loader, 4, &tl);
+    const RogueContentTaskTiming *ta = timing_of(&tl, "a"), *tb = timing_of(&tl, "b"),
+                                 *tc = timing_of(&tl, "c"), *td = timing_of(&tl, "d"),
+                                 *te = timing_of(&tl, "e"), *tf = timing_of(&tl, "f");
+    if (committed != 5 || tl.task_count != 6 || tl.level_count != 3 || !ta || !tb || !tc || !td ||
+        !te || !tf || ta->level != 0 || te->level != 0 || tc->level != 1 || td->level != 2 ||
+        tf->commit_result != -1 || tf->parse_result != -1)
+    {
+        printf("CONTENT_LOADER_FAIL levels committed=%d levels=%d\n", committed, tl.level_count);
+        return 1;
+    }
+    /* commits follow the load order (registration order within a level) and come after deps */
+    if (strcmp(g_commit_log, "abecd") != 0 || tc->parse_start_ms < ta->commit_end_ms ||
+        tc->parse_start_ms < tb->commit_end_ms || td->parse_start_ms < tc->commit_end_ms)
+    {
+        printf("CONTENT_LOADER_FAIL order log=%s\n", g_commit_log);
+        return 1;
+    }
+#if defined(ROGUE_HAVE_SDL)
+    /* three 30 ms parses on level 0 overlap */
+    if (tl.wall_ms >= tl.parse_ms_sum * 0.8)
+    {
+        printf("CONTENT_LOADER_FAIL no overlap wall=%.2f parse_sum=%.2f\n", tl.wall_ms,
+               tl.parse_ms_sum);
+        return 1;
+    }
+#endif
+    char report[2048];
+    int len = rogue_content_timeline_format(&tl, report, (int) sizeof report);
+    if (len <= 0 || len >= (int) sizeof report || !strstr(report, "speedup") ||
+        rogue_content_timeline_format(&tl, NULL, 0) != len)
+    {
+        printf("CONTENT_LOADER_FAIL report len=%d\n", len);
+        return 1;
+    }
+
+    /* 2. a cycle is rejected before anything runs */
+    rogue_content_loader_depend(&loader, "a", "d");
+    g_commit_log[0] = '\0';
+    if (rogue_content_loader_run(&loader, 2, NULL) != -1 || g_commit_log[0] != '\0')
+    {
+        printf("CONTENT_LOADER_FAIL cycle accepted\n");
+        return 1;
+    }
+    rogue_content_loader_free(&loader);
+
+    /* 3. startup manifest == sequential loaders */
+    rogue_item_defs_reset();
+    rogue_loot_tables_reset();
+    int seq_items = rogue_item_defs_load_directory("../../assets/items");
+    if (seq_items <= 0)
+        seq_items = rogue_item_defs_load_from_cfg("../../assets/test_items.cfg");
+    int seq_tables = rogue_loot_tables_load_from_cfg("../../assets/test_loot_tables.cfg");
+    int n_defs = rogue_item_defs_count();
+    int n_tables = rogue_loot_tables_count();
+    RogueItemDef* defs = (RogueItemDef*) malloc(sizeof(RogueItemDef) * (size_t) (n_defs + 1));
+    /* no index accessor for tables: enumerate their ids from a parse, snapshot by id */
+    RogueLootTableDef* tables = NULL;
+    int parsed_tables = 0;
+    rogue_loot_tables_parse_cfg("../../assets/test_loot_tables.cfg", &tables, &parsed_tables);
+    if (!defs || seq_items <= 0 || seq_tables <= 0 || parsed_tables != n_tables)
+    {
+        printf("CONTENT_LOADER_FAIL sequential baseline items=%d tables=%d/%d\n", seq_items,
+               n_tables, parsed_tables);
+        return 1;
+    }
+    for (int i = 0; i < n_defs; i++)
+        defs[i] = *rogue_item_def_at(i);
+    for (int i = 0; i < n_tables; i++)
+        tables[i] = *rogue_loot_table_by_id(tables[i].id);
+
+    rogue_item_defs_reset();
+    rogue_loot_tables_reset();
+    RogueContentLoadResult res;
+    if (rogue_content_manifest_load(4, &res, &tl) != 0 || res.items_loaded != seq_items ||
+        res.tables_loaded != seq_tables || rogue_item_defs_count() != n_defs ||
+        rogue_loot_tables_count() != n_tables)
+    {
+        printf("CONTENT_LOADER_FAIL manifest items=%d/%d tables=%d/%d\n", res.items_loaded,
+               seq_items, res.tables_loaded, seq_tables);
+        return 1;
+    }
+    for (int i = 0; i < n_defs; i++)
+        if (memcmp(&defs[i], rogue_item_def_at(i), sizeof defs[i]) != 0)
+        {
+            printf("CONTENT_LOADER_FAIL item def %d differs\n", i);
+            return 1;
+        }
+    for (int i = 0; i < n_tables; i++)
+        if (memcmp(&tables[i], rogue_loot_table_by_id(tables[i].id), sizeof tables[i]) != 0)
+        {
+            printf("CONTENT_LOADER_FAIL loot table %d differs\n", i);
+            return 1;
+        }
+    free(defs);
+    free(tables);
+
+    /* 4. parse + commit of loot tables == load_from_cfg once their item ids resolve */
+    rogue_item_defs_reset();
+    rogue_loot_tables_reset();
+    rogue_item_defs_load_from_cfg("../../assets/test_items.cfg");
+    int counted = rogue_loot_tables_load_from_cfg("../../assets/test_loot_tables.cfg");
+    int direct_tables = rogue_loot_tables_count();
+    RogueLootTableDef direct = *rogue_loot_table_by_id("ORC_WARRIOR");
+    rogue_loot_tables_reset();
+    tables = NULL;
+    if (rogue_loot_tables_parse_cfg("../../assets/test_loot_tables.cfg", &tables, &parsed_tables) !=
+            counted ||
+        rogue_loot_tables_commit(tables, parsed_tables) != direct_tables || direct_tables != 4 ||
+        memcmp(&direct, rogue_loot_table_by_id("ORC_WARRIOR"), sizeof direct) != 0)
+    {
+        printf("CONTENT_LOADER_FAIL loot split tables=%d parsed=%d\n", direct_tables,
+               parsed_tables);
+        return 1;
+    }
+    free(tables);
+    printf("CONTENT_LOADER_OK items=%d tables=%d levels=%d wall_ms=%.2f\n", n_defs,
+           direct_tables, tl.level_count, tl.wall_ms);
+    return 0;
+}
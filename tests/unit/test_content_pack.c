@@ -0,0 +1,125 @@
+/* Baked content pack: text-loaded affixes / items / loot tables bake into a pack that maps back
+ * to identical registries, strings are interned, and truncated, corrupted or foreign-version
+ * packs are rejected without touching the registries. */
+#define SDL_MAIN_HANDLED 1
+#include "../../src/core/loot/loot_affixes.h"
+#include "../../src/core/loot/loot_item_defs.h"
+#include "../../src/core/loot/loot_pack.h"
+#include "../../src/core/loot/loot_tables.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PACK_PATH "test_content_pack.pack"
+
+int main(void)
+{
+    rogue_affixes_reset();
+    rogue_item_defs_reset();
+    rogue_loot_tables_reset();
+    int n_affix = rogue_affixes_load_from_cfg("../../assets/affixes.cfg");
+    int n_items = rogue_item_defs_load_from_cfg("../../assets/test_items.cfg");
+    rogue_loot_tables_load_from_cfg("../../assets/test_loot_tables.cfg");
+    int n_tables = rogue_loot_tables_count();
+    if (n_affix <= 0 || n_items <= 0 || n_tables <= 0)
+    {
+        printf("CONTENT_PACK_FAIL text load affixes=%d items=%d tables=%d\n", n_affix, n_items,
+               n_tables);
+        return 1;
+    }
+    RogueItemDef* items = (RogueItemDef*) malloc(sizeof(RogueItemDef) * (size_t) n_items);
+    RogueLootTableDef* tables =
+        (RogueLootTableDef*) malloc(sizeof(RogueLootTableDef) * (size_t) n_tables);
+    if (!items || !tables)
+        return 1;
+    for (int i = 0; i < n_items; i++)
+        items[i] = *rogue_item_def_at(i);
+    for (int i = 0; i < n_tables; i++)
+        tables[i] = *rogue_loot_table_at(i);
+
+    /* 1. bake -> file -> mmap; every record matches its source */
+    if (rogue_loot_pack_bake_file(PACK_PATH) != 0)
+    {
+        printf("CONTENT_PACK_FAIL bake\n");
+        return 1;
+    }
+    RoguePack pack;
+    int rc = rogue_pack_open(&pack, PACK_PATH);
+    if (rc != 0 || rogue_loot_pack_verify(&pack) != 0)
+    {
+        printf("CONTENT_PACK_FAIL open/verify rc=%d\n", rc);
+        return 1;
+    }
+    /* in-place records: ids resolve through the interned pool, repeated strings stored once */
+    int count = 0;
+    const RogueLootPackItem* recs = rogue_loot_pack_items(&pack, &count);
+    if (!recs || count != n_items || strcmp(rogue_pack_string(&pack, recs[0].id), items[0].id) ||
+        rogue_pack_string(&pack, 0xFFFFFFu)[0] != '\0' ||
+        rogue_pack_section(&pack, ROGUE_LOOT_PACK_ITEMS, sizeof(RogueLootPackItem) + 4, &count))
+    {
+        printf("CONTENT_PACK_FAIL item view\n");
+        return 1;
+    }
+    for (int i = 1; i < count; i++)
+        if (recs[i].sprite_sheet != recs[0].sprite_sheet &&
+            strcmp(rogue_pack_string(&pack, recs[i].sprite_sheet),
+                   rogue_pack_string(&pack, recs[0].sprite_sheet)) == 0)
+        {
+            printf("CONTENT_PACK_FAIL string %d not interned\n", i);
+            return 1;
+        }
+
+    /* 2. load into empty registries: identical to the text path */
+    rogue_affixes_reset();
+    rogue_item_defs_reset();
+    rogue_loot_tables_reset();
+    if (rogue_loot_pack_load(&pack) != n_items || rogue_affix_count() != n_affix ||
+        rogue_loot_tables_count() != n_tables || rogue_item_def_index_fast(items[1].id) != 1)
+    {
+        printf("CONTENT_PACK_FAIL load counts\n");
+        return 1;
+    }
+    for (int i = 0; i < n_items; i++)
+        if (memcmp(&items[i], rogue_item_def_at(i), sizeof items[i]) != 0)
+        {
+            printf("CONTENT_PACK_FAIL item %d differs\n", i);
+            return 1;
+        }
+    for (int i = 0; i < n_tables; i++)
+        if (memcmp(&tables[i], rogue_loot_table_at(i), sizeof tables[i]) != 0)
+        {
+            printf("CONTENT_PACK_FAIL table %d differs\n", i);
+            return 1;
+        }
+    size_t size = pack.size;
+    unsigned char* copy = (unsigned char*) malloc(size);
+    memcpy(copy, pack.base, size);
+    rogue_pack_close(&pack);
+
+    /* 3. rejection: checksum, truncation, version; registries stay as they were */
+    RoguePack bad;
+    copy[size - 2] ^= 0x5A;
+    int r_sum = rogue_pack_open_memory(&bad, copy, size);
+    copy[size - 2] ^= 0x5A;
+    int r_trunc = rogue_pack_open_memory(&bad, copy, size - 8);
+    ((RoguePackHeader*) copy)->version = ROGUE_PACK_VERSION + 1;
+    int r_ver = rogue_pack_open_memory(&bad, copy, size);
+    ((RoguePackHeader*) copy)->version = ROGUE_PACK_VERSION;
+    int r_ok = rogue_pack_open_memory(&bad, copy, size);
+    if (r_sum != ROGUE_PACK_ERR_CHECKSUM || r_trunc != ROGUE_PACK_ERR_FORMAT ||
+        r_ver != ROGUE_PACK_ERR_VERSION || r_ok != 0 ||
+        rogue_loot_pack_load_file("missing_content.pack") != ROGUE_PACK_ERR_IO ||
+        rogue_item_defs_count() != n_items)
+    {
+        printf("CONTENT_PACK_FAIL rejection sum=%d trunc=%d ver=%d ok=%d\n", r_sum, r_trunc,
+               r_ver, r_ok);
+        return 1;
+    }
+    free(copy);
+    free(items);
+    free(tables);
+    remove(PACK_PATH);
+    printf("CONTENT_PACK_OK affixes=%d items=%d tables=%d bytes=%zu\n", n_affix, n_items, n_tables,
+           size);
+    return 0;
+}
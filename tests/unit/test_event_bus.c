@@ -5,6 +5,10 @@
 #include <string.h>
 
 #include "../../src/core/integration/event_bus.h"
+#if defined(ROGUE_HAVE_SDL)
+#define SDL_MAIN_HANDLED 1
+#include <SDL.h>
+#endif
 
 /* Test counters and flags */
 static uint32_t g_test_callback_count = 0;
@@ -633,6 +637,134 @@ static bool test_event_bus_overload_detection(void)
     return true;
 }
 
+/* ===== Multi-Producer Publishing Tests ===== */
+
+#define MPSC_PRODUCERS 4
+#define MPSC_EVENTS_PER_PRODUCER 800
+
+typedef struct
+{
+    uint32_t count;
+    uint64_t last_sequence[ROGUE_EVENT_PRIORITY_COUNT];
+    int32_t last_index[MPSC_PRODUCERS][ROGUE_EVENT_PRIORITY_COUNT];
+    bool ordered;
+    bool follow_up_seen;
+} MpscReceipt;
+
+static MpscReceipt g_mpsc;
+
+static bool mpsc_record(const RogueEvent* event, void* user_data)
+{
+    (void) user_data;
+    uint32_t producer = event->payload.entity.entity_type;
+    int32_t index = (int32_t) event->payload.entity.entity_id;
+    if (event->sequence_number <= g_mpsc.last_sequence[event->priority] ||
+        producer >= MPSC_PRODUCERS || index <= g_mpsc.last_index[producer][event->priority])
+        g_mpsc.ordered = false;
+    g_mpsc.last_sequence[event->priority] = event->sequence_number;
+    if (producer < MPSC_PRODUCERS)
+        g_mpsc.last_index[producer][event->priority] = index;
+    g_mpsc.count++;
+    return true;
+}
+
+static bool mpsc_follow_up(const RogueEvent* event, void* user_data)
+{
+    (void) event;
+    (void) user_data;
+    g_mpsc.follow_up_seen = true;
+    return true;
+}
+
+static bool mpsc_publish_follow_up(const RogueEvent* event, void* user_data)
+{
+    (void) event;
+    (void) user_data;
+    RogueEventPayload payload = create_test_payload(0);
+    return rogue_event_publish(ROGUE_EVENT_ENTITY_DESTROYED, &payload, ROGUE_EVENT_PRIORITY_LOW,
+                               9, "FollowUp");
+}
+
+static int mpsc_producer(void* ud)
+{
+    uint32_t producer = (uint32_t) (uintptr_t) ud;
+    for (uint32_t i = 0; i < MPSC_EVENTS_PER_PRODUCER; i++)
+    {
+        RogueEventPayload payload = {0};
+        payload.entity.entity_id = i;
+        payload.entity.entity_type = producer;
+        RogueEventPriority priority =
+            (i % 4 == 0) ? ROGUE_EVENT_PRIORITY_HIGH : ROGUE_EVENT_PRIORITY_NORMAL;
+        if (!rogue_event_publish(ROGUE_EVENT_ENTITY_MODIFIED, &payload, priority, producer,
+                                 "Producer"))
+            return 1;
+    }
+    return 0;
+}
+
+static bool test_event_bus_multi_producer(void)
+{
+    printf("Testing multi-producer publishing...\n");
+
+    RogueEventBusConfig config = rogue_event_bus_create_default_config("MpscTest");
+    config.enable_replay_recording = false;
+    assert(rogue_event_bus_init(&config) == true);
+    memset(&g_mpsc, 0, sizeof g_mpsc);
+    g_mpsc.ordered = true;
+    memset(g_mpsc.last_index, 0xFF, sizeof g_mpsc.last_index); /* -1 */
+    assert(rogue_event_subscribe(ROGUE_EVENT_ENTITY_MODIFIED, mpsc_record, NULL, 1) != 0);
+
+    /* Producers publish concurrently without the bus lock */
+    int producers_run = 1;
+#if defined(ROGUE_HAVE_SDL)
+    SDL_Thread* threads[MPSC_PRODUCERS];
+    for (int i = 0; i < MPSC_PRODUCERS; i++)
+        threads[i] = SDL_CreateThread(mpsc_producer, "event_producer", (void*) (uintptr_t) i);
+    for (int i = 0; i < MPSC_PRODUCERS; i++)
+    {
+        int status = 1;
+        if (threads[i])
+            SDL_WaitThread(threads[i], &status);
+        else
+            status = mpsc_producer((void*) (uintptr_t) i);
+        assert(status == 0);
+    }
+    producers_run = MPSC_PRODUCERS;
+#else
+    assert(mpsc_producer((void*) (uintptr_t) 0) == 0);
+#endif
+    const uint32_t total = (uint32_t) producers_run * MPSC_EVENTS_PER_PRODUCER;
+
+    const RogueEventBusStats* stats = rogue_event_bus_get_stats();
+    assert(stats->events_published == total);
+    assert(stats->max_queue_depth_reached == total);
+    assert(rogue_event_bus_get_queue_depth(ROGUE_EVENT_PRIORITY_HIGH) +
+               rogue_event_bus_get_queue_depth(ROGUE_EVENT_PRIORITY_NORMAL) ==
+           total);
+
+    /* One merge moves everything; delivery follows (priority, sequence), which keeps each
+       producer's own publish order within a priority */
+    assert(rogue_event_process_sync(total, 0) == total);
+    assert(g_mpsc.count == total && g_mpsc.ordered);
+    assert(stats->merge_batches == 1 && stats->max_merge_batch == total);
+    assert(stats->current_queue_depth == 0);
+    printf("  producers=%d events=%u cas_retries=%llu\n", producers_run, total,
+           (unsigned long long) stats->publish_cas_retries);
+
+    /* Events published by a callback are merged and processed within the same call */
+    assert(rogue_event_subscribe(ROGUE_EVENT_ENTITY_CREATED, mpsc_publish_follow_up, NULL, 2) != 0);
+    assert(rogue_event_subscribe(ROGUE_EVENT_ENTITY_DESTROYED, mpsc_follow_up, NULL, 3) != 0);
+    RogueEventPayload payload = create_test_payload(1);
+    assert(rogue_event_publish(ROGUE_EVENT_ENTITY_CREATED, &payload, ROGUE_EVENT_PRIORITY_NORMAL,
+                               2, "Trigger") == true);
+    assert(rogue_event_process_sync(10, 0) == 2);
+    assert(g_mpsc.follow_up_seen);
+
+    rogue_event_bus_shutdown();
+    printf("  ✓ Multi-producer publishing passed\n");
+    return true;
+}
+
 /* ===== Event Replay Tests ===== */
 
 static bool test_event_replay_recording(void)
@@ -742,6 +874,7 @@ int main(void)
                  {"Event Processing Retry", test_event_processing_retry},
                  {"Event Bus Statistics", test_event_bus_statistics},
                  {"Event Bus Overload Detection", test_event_bus_overload_detection},
+                 {"Multi-Producer Publishing", test_event_bus_multi_producer},
                  {"Event Replay Recording", test_event_replay_recording},
                  {"Utility Functions", test_utility_functions}};
 
@@ -0,0 +1,212 @@
+/* JSON DOM arena mode: arena and heap parses of the assets/ JSON files agree, wide objects resolve
+ * keys through the hash index (including after replacement and growth), mixed arena / heap trees
+ * are refused, invalid input reports its offset, and reset / destroy release whole documents. */
+#include "../../src/util/json_parser.h"
+#include "../../src/util/profiler.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int g_fail = 0;
+#define CHECK(c)                                                                                   \
+    do                                                                                             \
+    {                                                                                              \
+        if (!(c))                                                                                  \
+        {                                                                                          \
+            printf("JSON_ARENA_FAIL line %d: %s\n", __LINE__, #c);                                \
+            g_fail = 1;                                                                            \
+        }                                                                                          \
+    } while (0)
+
+static int same_tree(const RogueJsonValue* a, const RogueJsonValue* b)
+{
+    if (!a || !b || a->type != b->type)
+        return 0;
+    switch (a->type)
+    {
+    case JSON_BOOLEAN:
+        return a->data.boolean_value == b->data.boolean_value;
+    case JSON_INTEGER:
+        return a->data.integer_value == b->data.integer_value;
+    case JSON_NUMBER:
+        return memcmp(&a->data.number_value, &b->data.number_value, sizeof(double)) == 0;
+    case JSON_STRING:
+        return strcmp(a->data.string_value, b->data.string_value) == 0;
+    case JSON_ARRAY:
+        if (a->data.array_value.count != b->data.array_value.count)
+            return 0;
+        for (size_t i = 0; i < a->data.array_value.count; i++)
+            if (!same_tree(a->data.array_value.items[i], b->data.array_value.items[i]))
+                return 0;
+        return 1;
+    case JSON_OBJECT:
+        if (a->data.object_value.count != b->data.object_value.count)
+            return 0;
+        for (size_t i = 0; i < a->data.object_value.count; i++)
+        {
+            const char* key = a->data.object_value.keys[i];
+            if (strcmp(key, b->data.object_value.keys[i]) != 0 ||
+                json_object_get(b, key) != b->data.object_value.values[i] ||
+                !same_tree(a->data.object_value.values[i], b->data.object_value.values[i]))
+                return 0;
+        }
+        return 1;
+    default:
+        return 1;
+    }
+}
+
+static void test_parse(void)
+{
+    const char* doc = "{\"i\": -42, \"big\": 12345678901234, \"f\": 2.5e1, \"s\": \"a\\u00e9\\n\","
+                      " \"a\": [true, false, null, {}], \"i\": 7}";
+    size_t pos = 0;
+    RogueJsonValue* v = json_parse(doc, strlen(doc), NULL, &pos);
+    CHECK(v && v->type == JSON_OBJECT && !v->arena && v->data.object_value.count == 5);
+    CHECK(json_object_get(v, "i")->data.integer_value == 7); /* duplicate key: last wins */
+    CHECK(json_object_get(v, "big")->data.integer_value == 12345678901234LL);
+    CHECK(json_object_get(v, "f")->type == JSON_NUMBER &&
+          json_object_get(v, "f")->data.number_value == 25.0);
+    CHECK(strcmp(json_object_get(v, "s")->data.string_value, "a\xC3\xA9\n") == 0);
+    const RogueJsonValue* a = json_object_get(v, "a");
+    CHECK(a && a->data.array_value.count == 4 && a->data.array_value.items[2]->type == JSON_NULL);
+    json_free(v);
+
+    static const char* bad[] = {"", "[1,]", "{\"a\":}", "[1] 2", "{\"a\" 1}", "[\"x"};
+    for (size_t i = 0; i < sizeof bad / sizeof bad[0]; i++)
+        CHECK(json_parse(bad[i], strlen(bad[i]), NULL, NULL) == NULL);
+    CHECK(json_parse("{\"a\": [1, 2,, 3]}", 17, NULL, &pos) == NULL && pos == 12);
+}
+
+static void test_index(RogueJsonArena* arena)
+{
+    RogueJsonValue* heap = json_create_object();
+    RogueJsonValue* obj = json_arena_object(arena);
+    char key[16];
+    for (int i = 0; i < 200; i++)
+    {
+        snprintf(key, sizeof key, "k%d", i);
+        CHECK(json_object_set(obj, key, json_arena_integer(arena, i)));
+        CHECK(json_object_set(heap, key, json_create_integer(i)));
+        if (i == JSON_OBJECT_INDEX_MIN - 1)
+            CHECK(obj->data.object_value.index == NULL);
+    }
+    CHECK(obj->data.object_value.index && heap->data.object_value.index);
+    CHECK(obj->data.object_value.index_cap >= 2 * obj->data.object_value.count);
+    for (int i = 0; i < 200; i++)
+    {
+        snprintf(key, sizeof key, "k%d", i);
+        const RogueJsonValue* v = json_object_get(obj, key);
+        CHECK(v && v->data.integer_value == i);
+        CHECK(json_object_get(heap, key)->data.integer_value == i);
+    }
+    CHECK(!json_object_get(obj, "k200") && !json_object_has_key(heap, "missing"));
+    /* replacement keeps the slot; the old heap value is freed */
+    CHECK(json_object_set(obj, "k5", json_arena_string(arena, "five")));
+    CHECK(json_object_set(heap, "k5", json_create_string("five")));
+    CHECK(obj->data.object_value.count == 200 && heap->data.object_value.count == 200);
+    CHECK(strcmp(json_object_get(obj, "k5")->data.string_value, "five") == 0);
+    CHECK(same_tree(obj, heap) && same_tree(heap, obj));
+
+    /* containers refuse children from another allocator */
+    RogueJsonValue* stray = json_create_integer(1);
+    CHECK(!json_object_set(obj, "x", stray) && !json_array_add(json_arena_array(arena), stray));
+    CHECK(!json_object_set(heap, "x", json_arena_null(arena)));
+    json_free(stray);
+    json_free(obj); /* no-op for arena values */
+    json_free(heap);
+}
+
+/* ctest runs from build/tests, like the other asset-reading tests */
+static const char* k_assets[] = {
+    "../../assets/dialogue/dialogues.json", "../../assets/dialogue/style_default.json",
+    "../../assets/enemies.json", "../../assets/items.json", "../../assets/loot_tables.json",
+    "../../assets/skills_uhf87f.json", "../../assets/tag_registry.json",
+    "../../assets/vendors/vendors.json", "../../assets/vendors/price_policies.json",
+    "../../assets/weapon_hit_geo.json", "../../assets/weapons/weapon_2_pose.json"};
+
+static char* slurp(const char* path, size_t* len)
+{
+    FILE* f = NULL;
+#if defined(_MSC_VER)
+    fopen_s(&f, path, "rb");
+#else
+    f = fopen(path, "rb");
+#endif
+    if (!f)
+        return NULL;
+    fseek(f, 0, SEEK_END);
+    long sz = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    char* buf = sz > 0 ? (char*) malloc((size_t) sz) : NULL;
+    *len = buf ? fread(buf, 1, (size_t) sz, f) : 0;
+    fclose(f);
+    return buf;
+}
+
+static void test_assets(RogueJsonArena* arena)
+{
+    enum
+    {
+        N = sizeof k_assets / sizeof k_assets[0]
+    };
+    char* docs[N];
+    size_t lens[N];
+    int files = 0;
+    for (size_t i = 0; i < N; i++)
+    {
+        docs[i] = slurp(k_assets[i], &lens[i]);
+        if (!docs[i])
+            continue;
+        files++;
+        size_t pos = 0;
+        RogueJsonValue* heap = json_parse(docs[i], lens[i], NULL, &pos);
+        RogueJsonValue* in_arena = json_parse(docs[i], lens[i], arena, &pos);
+        if (!heap || !in_arena || in_arena->arena != arena || !same_tree(heap, in_arena))
+        {
+            printf("JSON_ARENA_FAIL %s (byte %zu)\n", k_assets[i], pos);
+            g_fail = 1;
+        }
+        json_free(heap);
+    }
+    CHECK(files > 0);
+    size_t used = json_arena_bytes_used(arena);
+    json_arena_reset(arena);
+    CHECK(used > 0 && json_arena_bytes_used(arena) == 0);
+
+    /* build cost: node-by-node heap trees vs one arena released at once */
+    const int iters = 50;
+    uint64_t t0 = rogue_prof_now_ns();
+    for (int it = 0; it < iters; it++)
+        for (size_t i = 0; i < N; i++)
+            if (docs[i])
+                json_free(json_parse(docs[i], lens[i], NULL, NULL));
+    uint64_t t1 = rogue_prof_now_ns();
+    for (int it = 0; it < iters; it++)
+    {
+        for (size_t i = 0; i < N; i++)
+            if (docs[i])
+                json_parse(docs[i], lens[i], arena, NULL);
+        json_arena_reset(arena);
+    }
+    uint64_t t2 = rogue_prof_now_ns();
+    printf("json_arena_bench: files=%d arena_bytes=%zu heap=%.2fms arena=%.2fms per pass\n", files,
+           used, (double) (t1 - t0) / 1e6 / iters, (double) (t2 - t1) / 1e6 / iters);
+    for (size_t i = 0; i < N; i++)
+        free(docs[i]);
+}
+
+int main(void)
+{
+    test_parse();
+    RogueJsonArena* arena = json_arena_create(4096);
+    CHECK(arena != NULL);
+    test_index(arena);
+    test_assets(arena);
+    json_arena_destroy(arena);
+    json_arena_destroy(NULL);
+    if (g_fail)
+        return 1;
+    printf("JSON_ARENA_OK\n");
+    return 0;
+}
@@ -0,0 +1,221 @@
+/* Shared JSON tokenizer: token stream and views, validation failures with offsets, escape
+ * decoding, member / element iteration with skipping, and a parse-throughput benchmark over the
+ * assets/ JSON files (every one must validate). */
+#include "../../src/util/json_tok.h"
+#include "../../src/util/profiler.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int g_fail = 0;
+#define CHECK(c)                                                                                   \
+    do                                                                                             \
+    {                                                                                              \
+        if (!(c))                                                                                  \
+        {                                                                                          \
+            printf("JSON_TOK_FAIL line %d: %s\n", __LINE__, #c);                                  \
+            g_fail = 1;                                                                            \
+        }                                                                                          \
+    } while (0)
+
+static int valid(const char* s) { return rogue_json_validate(s, strlen(s), NULL) == 0; }
+
+static void test_stream(void)
+{
+    const char* doc = " {\"a\": [1, -2.5e3, \"x\\\"y\"], \"b\": {\"c\": true}, \"d\": null} ";
+    static const RogueJsonTokType expect[] = {
+        ROGUE_JTOK_OBJECT_BEGIN, ROGUE_JTOK_KEY,        ROGUE_JTOK_ARRAY_BEGIN,
+        ROGUE_JTOK_NUMBER,       ROGUE_JTOK_NUMBER,     ROGUE_JTOK_STRING,
+        ROGUE_JTOK_ARRAY_END,    ROGUE_JTOK_KEY,        ROGUE_JTOK_OBJECT_BEGIN,
+        ROGUE_JTOK_KEY,          ROGUE_JTOK_TRUE,       ROGUE_JTOK_OBJECT_END,
+        ROGUE_JTOK_KEY,          ROGUE_JTOK_NULL,       ROGUE_JTOK_OBJECT_END,
+        ROGUE_JTOK_END};
+    RogueJsonTokenizer t;
+    RogueJsonToken tok;
+    rogue_json_tok_init(&t, doc, strlen(doc));
+    for (size_t i = 0; i < sizeof expect / sizeof expect[0]; i++)
+    {
+        RogueJsonTokType type = rogue_json_tok_next(&t, &tok);
+        CHECK(type == expect[i]);
+        if (i == 1)
+            CHECK(rogue_json_view_eq(tok.text, "a") && tok.text.ptr == doc + 3);
+        if (i == 4)
+        {
+            double d = 0;
+            int v = 0;
+            CHECK(rogue_json_tok_double(&tok, &d) && d == -2500.0);
+            CHECK(rogue_json_tok_int(&tok, &v) && v == -2500);
+        }
+        if (i == 5)
+        {
+            char buf[8];
+            CHECK(tok.escaped && tok.text.len == 4);
+            CHECK(rogue_json_tok_copy(&tok, buf, sizeof buf) == 3 && strcmp(buf, "x\"y") == 0);
+        }
+    }
+}
+
+static void test_validation(void)
+{
+    CHECK(valid("[]") && valid("{}") && valid("0") && valid("\"\"") && valid(" [1,[2,{}]] "));
+    CHECK(valid("{\"k\":\"\\u00e9\\ud83d\\ude00\\/\"}") && valid("-0.5E+2"));
+    static const char* bad[] = {"",        "[1,]",      "{\"a\" 1}",  "{\"a\":1,}", "[1 2]",
+                                "01",      "1.",        "-",          "1e",        "tru",
+                                "[1]]",    "{\"a\":1]", "\"a\nb\"",   "\"\\x\"",   "\"\\u12g4\"",
+                                "[1] [2]", "{1:2}",     "[\"open",    "{,}",       "nul"};
+    for (size_t i = 0; i < sizeof bad / sizeof bad[0]; i++)
+        if (valid(bad[i]))
+        {
+            printf("JSON_TOK_FAIL accepted invalid '%s'\n", bad[i]);
+            g_fail = 1;
+        }
+    size_t pos = 0;
+    CHECK(rogue_json_validate("{\"a\": [1, 2,, 3]}", 17, &pos) == -1 && pos == 12);
+    char deep[ROGUE_JSON_TOK_MAX_DEPTH + 2];
+    memset(deep, '[', sizeof deep);
+    CHECK(rogue_json_validate(deep, sizeof deep, &pos) == -1 && pos == ROGUE_JSON_TOK_MAX_DEPTH);
+    /* errors latch */
+    RogueJsonTokenizer t;
+    RogueJsonToken tok;
+    rogue_json_tok_init(&t, "[x, 1]", 6);
+    rogue_json_tok_next(&t, &tok);
+    CHECK(rogue_json_tok_next(&t, &tok) == ROGUE_JTOK_ERROR && t.error && t.error_pos == 1);
+    CHECK(rogue_json_tok_next(&t, &tok) == ROGUE_JTOK_ERROR);
+}
+
+static void test_copy(void)
+{
+    RogueJsonTokenizer t;
+    RogueJsonToken tok;
+    const char* doc = "\"a\\u00e9\\ud83d\\ude00\\n\"";
+    rogue_json_tok_init(&t, doc, strlen(doc));
+    CHECK(rogue_json_tok_next(&t, &tok) == ROGUE_JTOK_STRING);
+    char buf[16];
+    CHECK(rogue_json_tok_copy(&tok, buf, sizeof buf) == 8 &&
+          strcmp(buf, "a\xC3\xA9\xF0\x9F\x98\x80\n") == 0);
+    /* truncation never splits a character */
+    CHECK(rogue_json_tok_copy(&tok, buf, 5) == 3 && strcmp(buf, "a\xC3\xA9") == 0);
+    const char* raw = "\"h\xC3\xA9llo\"";
+    rogue_json_tok_init(&t, raw, strlen(raw));
+    rogue_json_tok_next(&t, &tok);
+    CHECK(!tok.escaped && rogue_json_tok_copy(&tok, buf, 3) == 1 && strcmp(buf, "h") == 0);
+    int v = 0;
+    rogue_json_tok_init(&t, "99999999999", 11);
+    rogue_json_tok_next(&t, &tok);
+    CHECK(rogue_json_tok_int(&tok, &v) && v == 2147483647);
+}
+
+static void test_iterators(void)
+{
+    const char* doc = "{\"skip\": {\"x\": [1, {\"y\": []}]}, \"ids\": [3, 4, 5], \"name\": \"n\"}";
+    RogueJsonTokenizer t;
+    RogueJsonToken v, e;
+    RogueJsonView key;
+    rogue_json_tok_init(&t, doc, strlen(doc));
+    CHECK(rogue_json_tok_next(&t, &v) == ROGUE_JTOK_OBJECT_BEGIN);
+    int ids[4], n = 0, members = 0;
+    char name[8] = "";
+    while (rogue_json_tok_member(&t, &key, &v) > 0)
+    {
+        members++;
+        if (rogue_json_view_eq(key, "ids") && v.type == ROGUE_JTOK_ARRAY_BEGIN)
+        {
+            while (rogue_json_tok_element(&t, &e) > 0)
+                if (n < 4)
+                    rogue_json_tok_int(&e, &ids[n++]);
+        }
+        else if (rogue_json_view_eq(key, "name"))
+            rogue_json_tok_copy(&v, name, sizeof name);
+        else
+            CHECK(rogue_json_tok_skip(&t, &v) == 0);
+    }
+    CHECK(members == 3 && n == 3 && ids[0] == 3 && ids[2] == 5 && strcmp(name, "n") == 0);
+    CHECK(rogue_json_tok_next(&t, &v) == ROGUE_JTOK_END && !t.error);
+}
+
+/* ctest runs from build/tests, like the other asset-reading tests */
+static const char* k_assets[] = {
+    "../../assets/dialogue/dialogues.json", "../../assets/dialogue/script_intro.json",
+    "../../assets/dialogue/style_default.json", "../../assets/enemies.json",
+    "../../assets/hitbox_tuning.json", "../../assets/items.json", "../../assets/loot_tables.json",
+    "../../assets/skills_uhf87f.json", "../../assets/tag_registry.json",
+    "../../assets/vendors/inventory_templates.json", "../../assets/vendors/negotiation_rules.json",
+    "../../assets/vendors/price_policies.json", "../../assets/vendors/reputation_tiers.json",
+    "../../assets/vendors/vendors.json", "../../assets/weapon_hit_geo.json",
+    "../../assets/weapons/weapon_0_down_pose.json", "../../assets/weapons/weapon_1_side_pose.json",
+    "../../assets/weapons/weapon_2_pose.json"};
+
+static char* slurp(const char* path, size_t* len)
+{
+    FILE* f = NULL;
+#if defined(_MSC_VER)
+    fopen_s(&f, path, "rb");
+#else
+    f = fopen(path, "rb");
+#endif
+    if (!f)
+        return NULL;
+    fseek(f, 0, SEEK_END);
+    long sz = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    char* buf = sz > 0 ? (char*) malloc((size_t) sz) : NULL;
+    *len = buf ? fread(buf, 1, (size_t) sz, f) : 0;
+    fclose(f);
+    return buf;
+}
+
+static void bench_assets(void)
+{
+    char* docs[sizeof k_assets / sizeof k_assets[0]];
+    size_t lens[sizeof k_assets / sizeof k_assets[0]];
+    size_t bytes = 0;
+    int files = 0;
+    for (size_t i = 0; i < sizeof k_assets / sizeof k_assets[0]; i++)
+    {
+        docs[i] = slurp(k_assets[i], &lens[i]);
+        if (!docs[i])
+            continue;
+        size_t pos = 0;
+        if (rogue_json_validate(docs[i], lens[i], &pos) != 0)
+        {
+            printf("JSON_TOK_FAIL %s invalid at byte %zu\n", k_assets[i], pos);
+            g_fail = 1;
+        }
+        bytes += lens[i];
+        files++;
+    }
+    CHECK(files > 0);
+    const int iters = 200;
+    long long tokens = 0;
+    uint64_t t0 = rogue_prof_now_ns();
+    for (int it = 0; it < iters; it++)
+        for (size_t i = 0; i < sizeof k_assets / sizeof k_assets[0]; i++)
+        {
+            if (!docs[i])
+                continue;
+            RogueJsonTokenizer t;
+            RogueJsonToken tok;
+            rogue_json_tok_init(&t, docs[i], lens[i]);
+            while (rogue_json_tok_next(&t, &tok) > ROGUE_JTOK_END)
+                tokens++;
+        }
+    double sec = (double) (rogue_prof_now_ns() - t0) / 1e9;
+    double mb = (double) bytes * iters / (1024.0 * 1024.0);
+    printf("json_tok_bench: files=%d bytes=%zu tokens/pass=%lld %.1f MB/s\n", files, bytes,
+           tokens / iters, sec > 0 ? mb / sec : 0.0);
+    for (size_t i = 0; i < sizeof k_assets / sizeof k_assets[0]; i++)
+        free(docs[i]);
+}
+
+int main(void)
+{
+    test_stream();
+    test_validation();
+    test_copy();
+    test_iterators();
+    bench_assets();
+    if (g_fail)
+        return 1;
+    printf("JSON_TOK_OK\n");
+    return 0;
+}
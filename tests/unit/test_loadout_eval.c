@@ -0,0 +1,183 @@
+/* Pure loadout evaluator: matches the live equip + stat cache pipeline on random loadouts,
+ * incremental slot deltas agree with full evaluation, and scoring leaves live state untouched. */
+#define SDL_MAIN_HANDLED 1
+#include "../../src/core/app/app_state.h"
+#include "../../src/core/equipment/equipment.h"
+#include "../../src/core/equipment/equipment_stats.h"
+#include "../../src/core/loot/loot_affixes.h"
+#include "../../src/core/loot/loot_instances.h"
+#include "../../src/core/loot/loot_item_defs.h"
+#include "../../src/game/stat_cache.h"
+#include "../../src/util/loadout_eval.h"
+#include "../../src/util/path_utils.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+RoguePlayer g_exposed_player_for_stats = {0};
+int rogue_minimap_ping_loot(float x, float y, int rarity)
+{
+    (void) x;
+    (void) y;
+    (void) rarity;
+    return 0;
+}
+
+static unsigned g_rng = 4242u;
+static unsigned next_rand(void)
+{
+    g_rng = g_rng * 1103515245u + 12345u;
+    return g_rng >> 8;
+}
+
+static int load_content(void)
+{
+    char path[256];
+    if (!rogue_find_asset_path("affixes.cfg", path, sizeof path))
+        return -1;
+    rogue_affixes_reset();
+    if (rogue_affixes_load_from_cfg(path) <= 0)
+        return -1;
+    if (!rogue_find_asset_path("test_items.cfg", path, sizeof path))
+        return -1;
+    rogue_item_defs_reset();
+    return rogue_item_defs_load_from_cfg(path) > 0 ? 0 : -1;
+}
+
+/* Live pipeline from a zero base so repeated applies do not compound. */
+static void live_recompute(void)
+{
+    g_exposed_player_for_stats.strength = 0;
+    g_exposed_player_for_stats.dexterity = 0;
+    g_exposed_player_for_stats.vitality = 0;
+    g_exposed_player_for_stats.intelligence = 0;
+    rogue_equipment_apply_stat_bonuses(&g_exposed_player_for_stats);
+}
+
+static int same_stats(const RogueStatCache* a, const RogueStatCache* b)
+{
+    return a->total_strength == b->total_strength && a->total_dexterity == b->total_dexterity &&
+           a->total_vitality == b->total_vitality &&
+           a->total_intelligence == b->total_intelligence &&
+           a->dps_estimate == b->dps_estimate && a->ehp_estimate == b->ehp_estimate &&
+           a->mobility_index == b->mobility_index && a->affix_armor_flat == b->affix_armor_flat &&
+           a->resist_physical == b->resist_physical && a->resist_fire == b->resist_fire &&
+           a->resist_cold == b->resist_cold && a->resist_lightning == b->resist_lightning &&
+           a->resist_poison == b->resist_poison && a->resist_status == b->resist_status &&
+           a->block_chance == b->block_chance && a->thorns_percent == b->thorns_percent;
+}
+
+int main(void)
+{
+    rogue_items_init_runtime();
+    if (load_content() != 0)
+    {
+        printf("LOADOUT_EVAL_FAIL content\n");
+        return 1;
+    }
+    /* Weapons carry the rolled affixes; the equip API accepts them in any slot. */
+    int pool[48];
+    int pool_n = 0;
+    for (int d = 0; d < rogue_item_defs_count() && pool_n < 48; d++)
+    {
+        const RogueItemDef* def = rogue_item_def_at(d);
+        if (!def || def->category != ROGUE_ITEM_WEAPON ||
+            (def->flags & ROGUE_ITEM_FLAG_TWO_HANDED))
+            continue;
+        for (int k = 0; k < 12 && pool_n < 48; k++)
+        {
+            int inst = rogue_items_spawn(d, 1, 0, 0);
+            unsigned seed = 100u + (unsigned) pool_n;
+            if (inst >= 0 && rogue_item_instance_generate_affixes(inst, &seed, 3) == 0)
+                pool[pool_n++] = inst;
+        }
+    }
+    if (pool_n < 8)
+    {
+        printf("LOADOUT_EVAL_FAIL pool=%d\n", pool_n);
+        return 1;
+    }
+
+    for (int trial = 0; trial < 200; trial++)
+    {
+        rogue_equip_reset();
+        for (int s = 0; s < ROGUE_EQUIP_SLOT_COUNT; s++)
+            if (next_rand() % 3 != 0)
+                rogue_equip_try((enum RogueEquipSlot) s, pool[next_rand() % (unsigned) pool_n]);
+        live_recompute();
+        RogueStatCache live = g_player_stat_cache;
+        RogueLoadoutBaseState base;
+        RogueLoadout lo;
+        RogueStatCache ev;
+        rogue_loadout_base_from_player(&g_exposed_player_for_stats, &base);
+        rogue_loadout_from_equipped(&lo);
+        rogue_loadout_evaluate(&base, &lo, &ev);
+        if (!same_stats(&live, &ev))
+        {
+            printf("LOADOUT_EVAL_FAIL trial=%d dps %d/%d ehp %d/%d mob %d/%d dex %d/%d\n", trial,
+                   live.dps_estimate, ev.dps_estimate, live.ehp_estimate, ev.ehp_estimate,
+                   live.mobility_index, ev.mobility_index, live.total_dexterity,
+                   ev.total_dexterity);
+            return 1;
+        }
+        /* incremental: build up slot by slot from empty, then compare against full */
+        RogueLoadoutEvalCtx inc, full;
+        rogue_loadout_eval_init(&inc, &base, NULL);
+        rogue_loadout_eval_init(&full, &base, &lo);
+        for (int s = 0; s < ROGUE_EQUIP_SLOT_COUNT; s++)
+        {
+            RogueLoadoutContrib c;
+            RogueLoadoutScore tried, committed;
+            rogue_loadout_item_contrib((enum RogueEquipSlot) s, lo.inst[s], &c);
+            rogue_loadout_eval_try_slot(&inc, (enum RogueEquipSlot) s, &c, &tried);
+            rogue_loadout_eval_set_slot_contrib(&inc, (enum RogueEquipSlot) s, lo.inst[s], &c);
+            rogue_loadout_eval_score(&inc, &committed);
+            if (memcmp(&tried, &committed, sizeof tried) != 0)
+            {
+                printf("LOADOUT_EVAL_FAIL try/commit trial=%d slot=%d\n", trial, s);
+                return 1;
+            }
+        }
+        RogueLoadoutScore a, b;
+        rogue_loadout_eval_score(&inc, &a);
+        rogue_loadout_eval_score(&full, &b);
+        if (memcmp(&a, &b, sizeof a) != 0 || memcmp(inc.sum, full.sum, sizeof inc.sum) != 0)
+        {
+            printf("LOADOUT_EVAL_FAIL incremental trial=%d\n", trial);
+            return 1;
+        }
+    }
+
+    /* scoring must not touch live equipment or the global cache */
+    unsigned long long fp = g_player_stat_cache.fingerprint;
+    int weapon = rogue_equip_get(ROGUE_EQUIP_WEAPON);
+    RogueLoadoutBaseState base;
+    RogueLoadout lo;
+    RogueLoadoutEvalCtx ctx;
+    rogue_loadout_base_from_player(&g_exposed_player_for_stats, &base);
+    rogue_loadout_from_equipped(&lo);
+    rogue_loadout_eval_init(&ctx, &base, &lo);
+    RogueLoadoutContrib cands[48];
+    for (int i = 0; i < pool_n; i++)
+        rogue_loadout_item_contrib(ROGUE_EQUIP_WEAPON, pool[i], &cands[i]);
+    long evals = 0;
+    volatile int sink = 0;
+    clock_t t0 = clock();
+    for (int rep = 0; rep < 2000; rep++)
+        for (int i = 0; i < pool_n; i++, evals++)
+        {
+            RogueLoadoutScore sc;
+            rogue_loadout_eval_try_slot(&ctx, ROGUE_EQUIP_WEAPON, &cands[i], &sc);
+            sink += sc.dps;
+        }
+    double secs = (double) (clock() - t0) / CLOCKS_PER_SEC;
+    if (g_player_stat_cache.fingerprint != fp || rogue_equip_get(ROGUE_EQUIP_WEAPON) != weapon)
+    {
+        printf("LOADOUT_EVAL_FAIL side effect\n");
+        return 1;
+    }
+    printf("LOADOUT_EVAL_OK trials=200 pool=%d evals=%ld evals_per_sec=%.0f\n", pool_n, evals,
+           secs > 0.0 ? (double) evals / secs : 0.0);
+    (void) sink;
+    return 0;
+}
@@ -0,0 +1,245 @@
+/* Parallel branch-and-bound loadout search: top-K DPS agrees with brute force on a small slot
+ * mask, worker count does not change the DPS ranking, the full search is never worse than hill
+ * climbing, and applying a result reproduces its score on the live pipeline. */
+#define SDL_MAIN_HANDLED 1
+#include "../../src/core/app/app_state.h"
+#include "../../src/core/equipment/equipment.h"
+#include "../../src/core/equipment/equipment_stats.h"
+#include "../../src/core/loot/loot_affixes.h"
+#include "../../src/core/loot/loot_instances.h"
+#include "../../src/core/loot/loot_item_defs.h"
+#include "../../src/game/stat_cache.h"
+#include "../../src/util/loadout_optimizer.h"
+#include "../../src/util/loadout_search.h"
+#include "../../src/util/path_utils.h"
+#include <stdio.h>
+#include <string.h>
+
+RoguePlayer g_exposed_player_for_stats = {0};
+int rogue_minimap_ping_loot(float x, float y, int rarity)
+{
+    (void) x;
+    (void) y;
+    (void) rarity;
+    return 0;
+}
+
+static int load_content(void)
+{
+    char path[256];
+    if (!rogue_find_asset_path("affixes.cfg", path, sizeof path))
+        return -1;
+    rogue_affixes_reset();
+    if (rogue_affixes_load_from_cfg(path) <= 0)
+        return -1;
+    rogue_item_defs_reset();
+    if (!rogue_find_asset_path("test_items.cfg", path, sizeof path) ||
+        rogue_item_defs_load_from_cfg(path) <= 0)
+        return -1;
+    if (!rogue_find_asset_path("test_equipment_items.cfg", path, sizeof path) ||
+        rogue_item_defs_load_from_cfg(path) <= 0)
+        return -1;
+    return 0;
+}
+
+static int spawn_category(int category, int per_def, unsigned seed_base)
+{
+    int n = 0;
+    for (int d = 0; d < rogue_item_defs_count(); d++)
+    {
+        const RogueItemDef* def = rogue_item_def_at(d);
+        if (!def || (int) def->category != category)
+            continue;
+        for (int k = 0; k < per_def; k++)
+        {
+            int inst = rogue_items_spawn(d, 1, 0, 0);
+            unsigned seed = seed_base + (unsigned) (d * 131 + k);
+            if (inst < 0)
+                return n;
+            rogue_item_instance_generate_affixes(inst, &seed, 2 + (k % 3));
+            n++;
+        }
+    }
+    return n;
+}
+
+/* Live pipeline from a fixed base so repeated applies do not compound. */
+static void live_recompute(void)
+{
+    g_exposed_player_for_stats.strength = 10;
+    g_exposed_player_for_stats.dexterity = 10;
+    g_exposed_player_for_stats.vitality = 10;
+    g_exposed_player_for_stats.intelligence = 5;
+    rogue_equipment_apply_stat_bonuses(&g_exposed_player_for_stats);
+}
+
+static int score_cmp(const RogueLoadoutScore* a, const RogueLoadoutScore* b)
+{
+    if (a->dps != b->dps)
+        return a->dps > b->dps ? -1 : 1;
+    if (a->ehp != b->ehp)
+        return a->ehp > b->ehp ? -1 : 1;
+    if (a->mobility != b->mobility)
+        return a->mobility > b->mobility ? -1 : 1;
+    return 0;
+}
+
+/* Brute force over weapon x head x ring1 (other slots as equipped). Every valid loadout whose DPS
+ * beats the search's K-th DPS must have its DPS among the results (the search reports one
+ * representative per equivalence class, which always shares the score). */
+static int check_brute_force(const RogueLoadoutSearchParams* sp, const RogueLoadoutSearchResult* r)
+{
+    static const int slots[3] = {ROGUE_EQUIP_WEAPON, ROGUE_EQUIP_ARMOR_HEAD, ROGUE_EQUIP_RING1};
+    int opts[3][ROGUE_ITEM_INSTANCE_CAP + 1];
+    int nopt[3];
+    for (int k = 0; k < 3; k++)
+    {
+        nopt[k] = 0;
+        opts[k][nopt[k]++] = -1;
+        for (int i = 0; i < ROGUE_ITEM_INSTANCE_CAP; i++)
+        {
+            const RogueItemInstance* it = rogue_item_instance_at(i);
+            const RogueItemDef* d = it ? rogue_item_def_at(it->def_index) : NULL;
+            int want = slots[k] == ROGUE_EQUIP_WEAPON ? ROGUE_ITEM_WEAPON : ROGUE_ITEM_ARMOR;
+            if (d && (int) d->category == want)
+                opts[k][nopt[k]++] = i;
+        }
+    }
+    RogueLoadoutBaseState base;
+    RogueLoadout lo;
+    rogue_loadout_base_from_player(&g_exposed_player_for_stats, &base);
+    rogue_loadout_from_equipped(&lo);
+    RogueLoadoutEvalCtx ctx;
+    rogue_loadout_eval_init(&ctx, &base, &lo);
+    RogueLoadoutScore best = {0, 0, 0};
+    int valid = 0;
+    for (int a = 0; a < nopt[0]; a++)
+        for (int b = 0; b < nopt[1]; b++)
+            for (int c = 0; c < nopt[2]; c++)
+            {
+                if (opts[1][b] >= 0 && opts[1][b] == opts[2][c])
+                    continue;
+                rogue_loadout_eval_set_slot(&ctx, ROGUE_EQUIP_WEAPON, opts[0][a]);
+                rogue_loadout_eval_set_slot(&ctx, ROGUE_EQUIP_ARMOR_HEAD, opts[1][b]);
+                rogue_loadout_eval_set_slot(&ctx, ROGUE_EQUIP_RING1, opts[2][c]);
+                RogueLoadoutScore sc;
+                rogue_loadout_eval_score(&ctx, &sc);
+                if (sc.mobility < sp->min_mobility || sc.ehp < sp->min_ehp)
+                    continue;
+                if (!valid++ || sc.dps > best.dps)
+                    best = sc;
+                if (r->count == sp->top_k && sc.dps <= r->scores[r->count - 1].dps)
+                    continue;
+                int found = 0;
+                for (int i = 0; i < r->count && !found; i++)
+                    found = sc.dps == r->scores[i].dps;
+                if (!found)
+                {
+                    printf("LOADOUT_SEARCH_FAIL missing dps=%d ehp=%d mob=%d\n", sc.dps, sc.ehp,
+                           sc.mobility);
+                    return 1;
+                }
+            }
+    if (!valid || r->count == 0 || best.dps != r->scores[0].dps)
+    {
+        printf("LOADOUT_SEARCH_FAIL best valid=%d count=%d\n", valid, r->count);
+        return 1;
+    }
+    return 0;
+}
+
+int main(void)
+{
+    rogue_items_init_runtime();
+    if (load_content() != 0)
+    {
+        printf("LOADOUT_SEARCH_FAIL content\n");
+        return 1;
+    }
+    int weapons = spawn_category(ROGUE_ITEM_WEAPON, 10, 7u);
+    int armor = spawn_category(ROGUE_ITEM_ARMOR, 110, 9001u);
+    if (weapons < 20 || armor < 100)
+    {
+        printf("LOADOUT_SEARCH_FAIL spawn weapons=%d armor=%d\n", weapons, armor);
+        return 1;
+    }
+    rogue_equip_reset();
+    live_recompute();
+    int min_mob = g_player_stat_cache.mobility_index;
+    int min_ehp = g_player_stat_cache.ehp_estimate;
+
+    /* 1. exactness on a brute-forceable mask */
+    RogueLoadoutSearchParams sp;
+    memset(&sp, 0, sizeof sp);
+    sp.min_mobility = min_mob;
+    sp.min_ehp = min_ehp;
+    sp.top_k = 8;
+    sp.workers = 1;
+    sp.slot_mask = (1u << ROGUE_EQUIP_WEAPON) | (1u << ROGUE_EQUIP_ARMOR_HEAD) |
+                   (1u << ROGUE_EQUIP_RING1);
+    RogueLoadoutSearchResult small;
+    if (rogue_loadout_search(&sp, &small) != 0 || !small.exhaustive)
+    {
+        printf("LOADOUT_SEARCH_FAIL small search\n");
+        return 1;
+    }
+    for (int i = 1; i < small.count; i++)
+        if (score_cmp(&small.scores[i - 1], &small.scores[i]) > 0)
+        {
+            printf("LOADOUT_SEARCH_FAIL order\n");
+            return 1;
+        }
+    if (check_brute_force(&sp, &small) != 0)
+        return 1;
+
+    /* 2. full problem: single worker vs parallel give the same scores */
+    sp.slot_mask = 0;
+    sp.top_k = 4;
+    RogueLoadoutSearchResult one, many;
+    sp.workers = 1;
+    if (rogue_loadout_search(&sp, &one) != 0 || !one.exhaustive || one.count == 0)
+    {
+        printf("LOADOUT_SEARCH_FAIL full search count=%d\n", one.count);
+        return 1;
+    }
+    sp.workers = 4;
+    if (rogue_loadout_search(&sp, &many) != 0 || !many.exhaustive || many.count != one.count)
+    {
+        printf("LOADOUT_SEARCH_FAIL parallel count=%d/%d\n", many.count, one.count);
+        return 1;
+    }
+    for (int i = 0; i < one.count; i++)
+        if (one.scores[i].dps != many.scores[i].dps)
+        {
+            printf("LOADOUT_SEARCH_FAIL parallel rank=%d dps %d/%d\n", i, one.scores[i].dps,
+                   many.scores[i].dps);
+            return 1;
+        }
+
+    /* 3. applying the best loadout reproduces its score live and beats hill climbing */
+    rogue_loadout_search_apply(&one.loadouts[0]);
+    live_recompute();
+    if (g_player_stat_cache.dps_estimate != one.scores[0].dps ||
+        g_player_stat_cache.ehp_estimate != one.scores[0].ehp)
+    {
+        printf("LOADOUT_SEARCH_FAIL apply dps %d/%d\n", g_player_stat_cache.dps_estimate,
+               one.scores[0].dps);
+        return 1;
+    }
+    rogue_equip_reset();
+    live_recompute();
+    rogue_loadout_cache_reset();
+    rogue_loadout_optimize(min_mob, min_ehp);
+    live_recompute();
+    if (g_player_stat_cache.dps_estimate > one.scores[0].dps)
+    {
+        printf("LOADOUT_SEARCH_FAIL hill climb beat search %d > %d\n",
+               g_player_stat_cache.dps_estimate, one.scores[0].dps);
+        return 1;
+    }
+    printf("LOADOUT_SEARCH_OK weapons=%d armor=%d best_dps=%d hill_dps=%d nodes=%ld "
+           "pruned=%ld/%ld ms=%.2f parallel_ms=%.2f workers=%d\n",
+           weapons, armor, one.scores[0].dps, g_player_stat_cache.dps_estimate, one.nodes,
+           one.pruned_bound, one.pruned_visited, one.ms, many.ms, many.workers);
+    return 0;
+}
@@ -0,0 +1,204 @@
+/* Loadout search past the initial item pool capacity: with every weapon and armor instance at a
+ * slot index >= ROGUE_ITEM_INSTANCE_CAP the search still sees them as candidates, keeps an
+ * equipped high-index item fixed (never reused in another slot) and matches brute force. The
+ * integrity and budget scans cover the grown pool as well. */
+#define SDL_MAIN_HANDLED 1
+#include "../../src/core/app/app_state.h"
+#include "../../src/core/equipment/equipment.h"
+#include "../../src/core/equipment/equipment_budget_analyzer.h"
+#include "../../src/core/equipment/equipment_integrity.h"
+#include "../../src/core/equipment/equipment_stats.h"
+#include "../../src/core/loot/loot_affixes.h"
+#include "../../src/core/loot/loot_instances.h"
+#include "../../src/core/loot/loot_item_defs.h"
+#include "../../src/game/stat_cache.h"
+#include "../../src/util/loadout_search.h"
+#include "../../src/util/path_utils.h"
+#include <stdio.h>
+#include <string.h>
+
+RoguePlayer g_exposed_player_for_stats = {0};
+int rogue_minimap_ping_loot(float x, float y, int rarity)
+{
+    (void) x;
+    (void) y;
+    (void) rarity;
+    return 0;
+}
+
+static int load_content(void)
+{
+    char path[256];
+    if (!rogue_find_asset_path("affixes.cfg", path, sizeof path))
+        return -1;
+    rogue_affixes_reset();
+    if (rogue_affixes_load_from_cfg(path) <= 0)
+        return -1;
+    rogue_item_defs_reset();
+    if (!rogue_find_asset_path("test_items.cfg", path, sizeof path) ||
+        rogue_item_defs_load_from_cfg(path) <= 0)
+        return -1;
+    if (!rogue_find_asset_path("test_equipment_items.cfg", path, sizeof path) ||
+        rogue_item_defs_load_from_cfg(path) <= 0)
+        return -1;
+    return 0;
+}
+
+/* Spawn per_def instances of every definition in category; returns the lowest index spawned. */
+static int spawn_category(int category, int per_def, unsigned seed_base, int* count)
+{
+    int lowest = -1;
+    for (int d = 0; d < rogue_item_defs_count(); d++)
+    {
+        const RogueItemDef* def = rogue_item_def_at(d);
+        if (!def || (int) def->category != category)
+            continue;
+        for (int k = 0; k < per_def; k++)
+        {
+            int inst = rogue_items_spawn(d, 1, (float) (k * 3), 40.0f);
+            unsigned seed = seed_base + (unsigned) (d * 131 + k);
+            if (inst < 0)
+                return -1;
+            rogue_item_instance_generate_affixes(inst, &seed, 2 + (k % 3));
+            if (lowest < 0 || inst < lowest)
+                lowest = inst;
+            (*count)++;
+        }
+    }
+    return lowest;
+}
+
+static int is_category(int inst, int category)
+{
+    const RogueItemInstance* it = rogue_item_instance_at(inst);
+    const RogueItemDef* d = it ? rogue_item_def_at(it->def_index) : NULL;
+    return d && (int) d->category == category;
+}
+
+int main(void)
+{
+    rogue_items_init_runtime();
+    if (load_content() != 0)
+    {
+        printf("LOADOUT_LARGE_POOL_FAIL content\n");
+        return 1;
+    }
+    /* non-equipment filler pushes every equipment instance past the initial capacity */
+    int coin = rogue_item_def_index("gold_coin");
+    for (int i = 0; i < ROGUE_ITEM_INSTANCE_CAP + 20; i++)
+        if (rogue_items_spawn(coin, 1, (float) (i * 3), 0.0f) < 0)
+        {
+            printf("LOADOUT_LARGE_POOL_FAIL filler %d\n", i);
+            return 1;
+        }
+    int weapons = 0, armor = 0;
+    int low_weapon = spawn_category(ROGUE_ITEM_WEAPON, 4, 7u, &weapons);
+    int low_armor = spawn_category(ROGUE_ITEM_ARMOR, 24, 9001u, &armor);
+    if (low_weapon < ROGUE_ITEM_INSTANCE_CAP || low_armor < ROGUE_ITEM_INSTANCE_CAP ||
+        rogue_items_capacity() <= ROGUE_ITEM_INSTANCE_CAP)
+    {
+        printf("LOADOUT_LARGE_POOL_FAIL layout weapon=%d armor=%d cap=%d\n", low_weapon, low_armor,
+               rogue_items_capacity());
+        return 1;
+    }
+
+    rogue_equip_reset();
+    int fixed_head = low_armor;
+    if (rogue_equip_try(ROGUE_EQUIP_ARMOR_HEAD, fixed_head) != 0)
+    {
+        printf("LOADOUT_LARGE_POOL_FAIL equip %d\n", fixed_head);
+        return 1;
+    }
+    rogue_equipment_apply_stat_bonuses(&g_exposed_player_for_stats);
+    rogue_stat_cache_force_update(&g_exposed_player_for_stats);
+
+    RogueLoadoutSearchParams sp;
+    memset(&sp, 0, sizeof sp);
+    sp.top_k = 4;
+    sp.workers = 2;
+    sp.slot_mask = (1u << ROGUE_EQUIP_WEAPON) | (1u << ROGUE_EQUIP_RING1);
+    RogueLoadoutSearchResult r;
+    if (rogue_loadout_search(&sp, &r) != 0 || !r.exhaustive || r.count == 0)
+    {
+        printf("LOADOUT_LARGE_POOL_FAIL search count=%d\n", r.count);
+        return 1;
+    }
+    /* every spawned weapon plus the empty option; every armor except the fixed head */
+    if (r.candidates[ROGUE_EQUIP_WEAPON] != weapons + 1 ||
+        r.candidates[ROGUE_EQUIP_RING1] != armor)
+    {
+        printf("LOADOUT_LARGE_POOL_FAIL candidates weapon=%d/%d ring=%d/%d\n",
+               r.candidates[ROGUE_EQUIP_WEAPON], weapons + 1, r.candidates[ROGUE_EQUIP_RING1],
+               armor);
+        return 1;
+    }
+    for (int i = 0; i < r.count; i++)
+    {
+        if (r.loadouts[i].inst[ROGUE_EQUIP_ARMOR_HEAD] != fixed_head ||
+            r.loadouts[i].inst[ROGUE_EQUIP_RING1] == fixed_head)
+        {
+            printf("LOADOUT_LARGE_POOL_FAIL fixed head reused rank=%d\n", i);
+            return 1;
+        }
+    }
+    if (r.loadouts[0].inst[ROGUE_EQUIP_WEAPON] < ROGUE_ITEM_INSTANCE_CAP)
+    {
+        printf("LOADOUT_LARGE_POOL_FAIL weapon=%d\n", r.loadouts[0].inst[ROGUE_EQUIP_WEAPON]);
+        return 1;
+    }
+
+    /* brute force over weapon x ring1 across the whole pool */
+    RogueLoadoutBaseState base;
+    RogueLoadout lo;
+    rogue_loadout_base_from_player(&g_exposed_player_for_stats, &base);
+    rogue_loadout_from_equipped(&lo);
+    RogueLoadoutEvalCtx ctx;
+    rogue_loadout_eval_init(&ctx, &base, &lo);
+    int best = -1;
+    for (int w = -1; w < rogue_items_capacity(); w++)
+    {
+        if (w >= 0 && !is_category(w, ROGUE_ITEM_WEAPON))
+            continue;
+        for (int g = -1; g < rogue_items_capacity(); g++)
+        {
+            if (g >= 0 && (g == fixed_head || !is_category(g, ROGUE_ITEM_ARMOR)))
+                continue;
+            rogue_loadout_eval_set_slot(&ctx, ROGUE_EQUIP_WEAPON, w);
+            rogue_loadout_eval_set_slot(&ctx, ROGUE_EQUIP_RING1, g);
+            RogueLoadoutScore sc;
+            rogue_loadout_eval_score(&ctx, &sc);
+            if (sc.dps > best)
+                best = sc.dps;
+        }
+    }
+    if (best != r.scores[0].dps)
+    {
+        printf("LOADOUT_LARGE_POOL_FAIL brute dps=%d search=%d\n", best, r.scores[0].dps);
+        return 1;
+    }
+
+    /* scans over the grown pool: the equip chain of the high-index head is consistent, GUIDs
+     * are unique, and the budget report reaches items past the initial capacity */
+    if (rogue_integrity_scan_equip_chain_mismatches(NULL, 0) != 0 ||
+        rogue_integrity_scan_duplicate_guids(NULL, 0) != 0)
+    {
+        printf("LOADOUT_LARGE_POOL_FAIL integrity\n");
+        return 1;
+    }
+    int budgeted = 0;
+    for (int i = 0; i < rogue_items_capacity(); i++)
+    {
+        const RogueItemInstance* it = rogue_item_instance_at(i);
+        budgeted += it && rogue_budget_max(it->item_level, it->rarity) > 0;
+    }
+    RogueBudgetReport rep;
+    rogue_budget_analyzer_run(&rep);
+    if (budgeted <= ROGUE_ITEM_INSTANCE_CAP || rep.item_count != budgeted)
+    {
+        printf("LOADOUT_LARGE_POOL_FAIL budget items=%d/%d\n", rep.item_count, budgeted);
+        return 1;
+    }
+    printf("LOADOUT_LARGE_POOL_OK cap=%d weapons=%d armor=%d best_dps=%d nodes=%ld\n",
+           rogue_items_capacity(), weapons, armor, r.scores[0].dps, r.nodes);
+    return 0;
+}
@@ -1,12 +1,252 @@
+/* Logging: category thresholds, call-site argument gating, compile-time removal, per call site
+ * rate limiting and the asynchronous rings (ordering, overflow draining, errors in order). */
 #include "../../src/util/log.h"
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if defined(ROGUE_HAVE_SDL)
+#define SDL_MAIN_HANDLED 1
+#include <SDL.h>
+#endif
 
-int main(void)
+static int g_fail = 0;
+#define CHECK(c)                                                                                   \
+    do                                                                                             \
+    {                                                                                              \
+        if (!(c))                                                                                  \
+        {                                                                                          \
+            printf("LOG_FAIL line %d: %s\n", __LINE__, #c);                                       \
+            g_fail = 1;                                                                            \
+        }                                                                                          \
+    } while (0)
+
+#define CAPTURE_PATH "test_log_capture.txt"
+#define MAX_LINES 4096
+
+static char g_lines[MAX_LINES][ROGUE_LOG_RECORD_CAP + 128];
+static int g_line_count;
+static FILE* g_capture;
+
+static void capture_begin(void)
+{
+    g_capture = fopen(CAPTURE_PATH, "w+");
+    CHECK(g_capture != NULL);
+    rogue_log_set_output(g_capture);
+}
+
+/* Flushes the logger, reads everything captured into g_lines and restores stdout. */
+static void capture_end(void)
+{
+    rogue_log_flush();
+    rogue_log_set_output(NULL);
+    g_line_count = 0;
+    if (!g_capture)
+        return;
+    fflush(g_capture);
+    rewind(g_capture);
+    while (g_line_count < MAX_LINES &&
+           fgets(g_lines[g_line_count], (int) sizeof g_lines[0], g_capture))
+        g_line_count++;
+    fclose(g_capture);
+    g_capture = NULL;
+    remove(CAPTURE_PATH);
+}
+
+static int count_containing(const char* needle)
+{
+    int n = 0;
+    for (int i = 0; i < g_line_count; i++)
+        n += strstr(g_lines[i], needle) != NULL;
+    return n;
+}
+
+static int bump(int* n) { return ++*n; }
+
+static void test_macros(void)
 {
     /* Invoke each log macro for structural coverage */
     ROGUE_LOG_DEBUG("debug %d", 1);
     ROGUE_LOG_INFO("info %s", "x");
     ROGUE_LOG_WARN("warn");
     ROGUE_LOG_ERROR("error");
+    ROGUE_LOGC_WARN(ROGUE_LOG_CAT_AUDIO, "audio warn %d", 2);
+}
+
+static void test_categories(void)
+{
+    rogue_log_set_rate_limit(0);
+    rogue_log_set_level(ROGUE_LOG_WARN_LEVEL);
+    CHECK(rogue_log_set_categories_from_string("worldgen=debug, events=error,bogus=info,ai=nope") ==
+          1); /* entries are not trimmed: " events" is unknown */
+    CHECK(rogue_log_set_categories_from_string("events=error;AI=Info") == 2);
+    CHECK(rogue_log_get_category_level(ROGUE_LOG_CAT_WORLDGEN) == ROGUE_LOG_DEBUG_LEVEL);
+    CHECK(rogue_log_get_category_level(ROGUE_LOG_CAT_AI) == ROGUE_LOG_INFO_LEVEL);
+    CHECK(rogue_log_get_category_level(ROGUE_LOG_CAT_RENDER) == -1);
+    CHECK(g_rogue_log_threshold[ROGUE_LOG_CAT_RENDER] == ROGUE_LOG_WARN_LEVEL);
+    CHECK(g_rogue_log_threshold[ROGUE_LOG_CAT_EVENTS] == ROGUE_LOG_ERROR_LEVEL);
+    CHECK(strcmp(rogue_log_category_name(ROGUE_LOG_CAT_DIALOGUE), "dialogue") == 0);
+
+    capture_begin();
+    ROGUE_LOG_INFO("general info");
+    ROGUE_LOG_WARN("general warn");
+    ROGUE_LOGC_DEBUG(ROGUE_LOG_CAT_WORLDGEN, "worldgen debug %d", 7);
+    ROGUE_LOGC_WARN(ROGUE_LOG_CAT_EVENTS, "events warn");
+    ROGUE_LOGC_ERROR(ROGUE_LOG_CAT_EVENTS, "events error");
+    capture_end();
+    CHECK(g_line_count == 3);
+    CHECK(count_containing("general warn") == 1 && count_containing("general info") == 0);
+    CHECK(count_containing("[DEBUG]") == 1 && count_containing("worldgen debug 7") == 1);
+    CHECK(count_containing("events warn") == 0 && count_containing("[ERROR]") == 1);
+
+    /* filtered calls never evaluate their arguments */
+    int n = 0;
+    ROGUE_LOG_DEBUG("%d", bump(&n));
+    ROGUE_LOGC_INFO(ROGUE_LOG_CAT_RENDER, "%d", bump(&n));
+    CHECK(n == 0);
+    CHECK(!ROGUE_LOG_ENABLED(ROGUE_LOG_INFO_LEVEL, ROGUE_LOG_CAT_GENERAL));
+    CHECK(ROGUE_LOG_ENABLED(ROGUE_LOG_DEBUG_LEVEL, ROGUE_LOG_CAT_WORLDGEN));
+
+    /* '*' sets the global level; a negative override follows it again */
+    CHECK(rogue_log_set_categories_from_string("*=info") == 1);
+    CHECK(rogue_log_get_level() == ROGUE_LOG_INFO_LEVEL);
+    rogue_log_set_category_level(ROGUE_LOG_CAT_WORLDGEN, -1);
+    CHECK(g_rogue_log_threshold[ROGUE_LOG_CAT_WORLDGEN] == ROGUE_LOG_INFO_LEVEL);
+    for (int c = 0; c < ROGUE_LOG_CAT_COUNT; c++)
+        rogue_log_set_category_level((RogueLogCategory) c, -1);
+    rogue_log_set_level(ROGUE_LOG_WARN_LEVEL);
+}
+
+/* Raising the compile-time floor removes the call even when the runtime level would pass it. */
+#undef ROGUE_LOG_COMPILE_LEVEL
+#define ROGUE_LOG_COMPILE_LEVEL 2
+static void test_compile_level(void)
+{
+    rogue_log_set_level(ROGUE_LOG_DEBUG_LEVEL);
+    int n = 0;
+    capture_begin();
+    ROGUE_LOG_DEBUG("compiled out %d", bump(&n));
+    ROGUE_LOG_INFO("compiled out %d", bump(&n));
+    ROGUE_LOG_WARN("kept %d", bump(&n));
+    capture_end();
+    CHECK(n == 1 && g_line_count == 1 && count_containing("kept 1") == 1);
+    rogue_log_set_level(ROGUE_LOG_WARN_LEVEL);
+}
+#undef ROGUE_LOG_COMPILE_LEVEL
+#define ROGUE_LOG_COMPILE_LEVEL 0
+
+static void test_rate_limit(void)
+{
+    rogue_log_set_rate_limit(5);
+    unsigned long long before = rogue_log_suppressed_count();
+    capture_begin();
+    for (int i = 0; i < 100; i++)
+        ROGUE_LOG_WARN("spam %d", i);
+    ROGUE_LOG_WARN("other site");
+    capture_end();
+    int emitted = count_containing("spam ");
+    /* a second boundary during the loop can open one more window */
+    CHECK(emitted >= 5 && emitted <= 10);
+    CHECK(rogue_log_suppressed_count() - before == (unsigned long long) (100 - emitted));
+    CHECK(count_containing("spam 0") == 1 && count_containing("other site") == 1);
+    rogue_log_set_rate_limit(0);
+}
+
+static void check_sequence(const char* tag, int expected)
+{
+    char needle[32];
+    int next = 0;
+    for (int i = 0; i < g_line_count; i++)
+    {
+        const char* p = strstr(g_lines[i], tag);
+        if (!p)
+            continue;
+        CHECK(atoi(p + strlen(tag)) == next);
+        next++;
+    }
+    snprintf(needle, sizeof needle, "%s%d", tag, expected - 1);
+    CHECK(next == expected && count_containing(needle) == 1);
+}
+
+static void test_async_single_thread(void)
+{
+    rogue_log_set_rate_limit(0);
+    capture_begin();
+    CHECK(rogue_log_async_start() == 0 && rogue_log_async_active());
+    CHECK(rogue_log_async_start() == 0);
+    for (int i = 0; i < ROGUE_LOG_RING_RECORDS * 3; i++) /* overflows the ring several times */
+        ROGUE_LOG_WARN("seq %d", i);
+    ROGUE_LOG_ERROR("after the queue");
+    ROGUE_LOG_WARN("seq %d", ROGUE_LOG_RING_RECORDS * 3);
+    char big[ROGUE_LOG_RECORD_CAP * 2];
+    memset(big, 'x', sizeof big - 1);
+    big[sizeof big - 1] = '\0';
+    ROGUE_LOG_WARN("long %s", big);
+    capture_end();
+    rogue_log_async_stop();
+    CHECK(!rogue_log_async_active());
+    check_sequence("seq ", ROGUE_LOG_RING_RECORDS * 3 + 1);
+    int err_at = -1, last_before = -1;
+    for (int i = 0; i < g_line_count; i++)
+    {
+        if (strstr(g_lines[i], "after the queue"))
+            err_at = i;
+        char needle[32];
+        snprintf(needle, sizeof needle, "seq %d\n", ROGUE_LOG_RING_RECORDS * 3 - 1);
+        if (strstr(g_lines[i], needle))
+            last_before = i;
+    }
+    CHECK(err_at >= 0 && last_before >= 0 && err_at == last_before + 1);
+    CHECK(count_containing("long xxxx") == 1); /* truncated to the record, still one line */
+}
+
+#if defined(ROGUE_HAVE_SDL)
+#define PRODUCERS 4
+#define PER_PRODUCER 600
+static int producer_main(void* ud)
+{
+    int id = *(int*) ud;
+    for (int i = 0; i < PER_PRODUCER; i++)
+        ROGUE_LOG_WARN("p%d %d", id, i);
+    return 0;
+}
+
+static void test_async_producers(void)
+{
+    static int ids[PRODUCERS];
+    SDL_Thread* th[PRODUCERS];
+    capture_begin();
+    CHECK(rogue_log_async_start() == 0);
+    for (int i = 0; i < PRODUCERS; i++)
+    {
+        ids[i] = i;
+        th[i] = SDL_CreateThread(producer_main, "log_producer", &ids[i]);
+    }
+    for (int i = 0; i < PRODUCERS; i++)
+        SDL_WaitThread(th[i], NULL);
+    rogue_log_async_stop();
+    capture_end();
+    CHECK(g_line_count == PRODUCERS * PER_PRODUCER);
+    for (int p = 0; p < PRODUCERS; p++)
+    {
+        char tag[16];
+        snprintf(tag, sizeof tag, "p%d ", p);
+        check_sequence(tag, PER_PRODUCER);
+    }
+}
+#endif
+
+int main(void)
+{
+    test_macros();
+    test_categories();
+    test_compile_level();
+    test_rate_limit();
+    test_async_single_thread();
+#if defined(ROGUE_HAVE_SDL)
+    test_async_producers();
+#endif
+    if (g_fail)
+        return 1;
+    printf("LOG_OK\n");
     return 0;
 }
@@ -2,19 +2,146 @@
  * - Spawns many identical stackable items clustered to trigger merges.
  * - Verifies active count well below spawn attempts (merges occurred) and never exceeds cap.
  * - Ensures no crash and merge ratio reasonable (>20% merges).
+ * - Grows the pool to 10k ground items: the spatial-hash merge matches the all-pairs reference
+ *   slot for slot, radius queries match a brute-force scan, and freed slots are reused lowest
+ *   first. Prints spawn / merge timings.
  */
 #include "../../src/core/app/app_state.h"
 #include "../../src/core/loot/loot_instances.h"
 #include "../../src/core/loot/loot_item_defs.h"
 #include "../../src/core/loot/loot_tables.h"
 #include "../../src/util/path_utils.h"
+#include "../../src/util/profiler.h"
 #include <assert.h>
 #include <stdio.h>
+#include <stdlib.h>
 
 RogueAppState g_app;
 RoguePlayer g_exposed_player_for_stats;
 void rogue_player_recalc_derived(RoguePlayer* p) { (void) p; }
 
+#define STRESS_ITEMS 10000
+
+typedef struct RefItem
+{
+    int def_index, rarity, quantity, active;
+    float x, y;
+} RefItem;
+
+/* Original all-pairs merge sweep, applied to a snapshot of the pool. */
+static void reference_merge(RefItem* r, int n)
+{
+    const float r2 = ROGUE_ITEM_STACK_MERGE_RADIUS * ROGUE_ITEM_STACK_MERGE_RADIUS;
+    for (int i = 0; i < n; i++)
+        if (r[i].active)
+            for (int j = i + 1; j < n; j++)
+            {
+                if (!r[j].active || r[i].def_index != r[j].def_index ||
+                    r[i].rarity != r[j].rarity)
+                    continue;
+                float dx = r[i].x - r[j].x, dy = r[i].y - r[j].y;
+                if (dx * dx + dy * dy > r2)
+                    continue;
+                const RogueItemDef* d = rogue_item_def_at(r[i].def_index);
+                int space = (d ? d->stack_max : 999999) - r[i].quantity;
+                if (space <= 0)
+                    continue;
+                int move = r[j].quantity < space ? r[j].quantity : space;
+                r[i].quantity += move;
+                r[j].quantity -= move;
+                if (r[j].quantity <= 0)
+                    r[j].active = 0;
+            }
+}
+
+static int stress_10k(int gold_index, int bandage_index)
+{
+    rogue_items_init_runtime();
+    g_rogue_loot_suppress_spawn_log = 1;
+    unsigned seed = 12345u;
+    uint64_t t0 = rogue_prof_now_ns();
+    for (int i = 0; i < STRESS_ITEMS; i++)
+    {
+        /* clusters of nearby drops on a 1.5-tile lattice with jitter across cell borders */
+        int c = i / 9;
+        seed = seed * 1664525u + 1013904223u;
+        float jx = (float) (seed >> 20) / 4096.0f * 0.6f;
+        float jy = (float) ((seed >> 8) & 0xFFFu) / 4096.0f * 0.6f;
+        int def = (seed >> 4) % 3 ? gold_index : bandage_index;
+        if (rogue_items_spawn(def, 1 + (int) (seed % 4u), (float) (c % 40) * 1.5f + jx,
+                              (float) (c / 40) * 1.5f + jy) != i)
+        {
+            fprintf(stderr, "FAIL: stress spawn %d not in lowest free slot\n", i);
+            return 9;
+        }
+    }
+    uint64_t t1 = rogue_prof_now_ns();
+    if (rogue_items_capacity() < STRESS_ITEMS || g_app.item_instance_cap != rogue_items_capacity())
+    {
+        fprintf(stderr, "FAIL: pool did not grow cap=%d\n", rogue_items_capacity());
+        return 10;
+    }
+    /* radius query vs brute force (sorted ascending) */
+    int got[64], expect = 0;
+    int n = rogue_items_query_radius(10.0f, 10.0f, 1.0f, got, 64);
+    for (int i = 0; i < STRESS_ITEMS; i++)
+    {
+        const RogueItemInstance* it = rogue_item_instance_at(i);
+        float dx = it->x - 10.0f, dy = it->y - 10.0f;
+        if (dx * dx + dy * dy <= 1.0f && (expect >= n || got[expect++] != i))
+        {
+            fprintf(stderr, "FAIL: radius query mismatch at slot %d\n", i);
+            return 11;
+        }
+    }
+    if (n != expect || n == 0)
+    {
+        fprintf(stderr, "FAIL: radius query count %d expected %d\n", n, expect);
+        return 11;
+    }
+
+    RefItem* ref = (RefItem*) malloc(sizeof(RefItem) * STRESS_ITEMS);
+    if (!ref)
+        return 12;
+    for (int i = 0; i < STRESS_ITEMS; i++)
+    {
+        const RogueItemInstance* it = rogue_item_instance_at(i);
+        ref[i] = (RefItem){it->def_index, it->rarity, it->quantity, 1, it->x, it->y};
+    }
+    reference_merge(ref, STRESS_ITEMS);
+    uint64_t t2 = rogue_prof_now_ns();
+    rogue_items_update(0.0f);
+    uint64_t t3 = rogue_prof_now_ns();
+    int active = 0;
+    for (int i = 0; i < STRESS_ITEMS; i++)
+    {
+        const RogueItemInstance* it = rogue_item_instance_at(i);
+        if ((it != NULL) != ref[i].active || (it && it->quantity != ref[i].quantity))
+        {
+            fprintf(stderr, "FAIL: merge mismatch slot %d\n", i);
+            free(ref);
+            return 13;
+        }
+        active += it != NULL;
+    }
+    free(ref);
+    /* emptied slots are handed out again lowest first */
+    int hole = -1;
+    for (int i = 0; i < STRESS_ITEMS && hole < 0; i++)
+        if (!rogue_item_instance_at(i))
+            hole = i;
+    if (hole < 0 || rogue_items_spawn(gold_index, 1, -50.0f, -50.0f) != hole ||
+        rogue_items_despawn(hole) != 0 || rogue_item_instance_at(hole) != NULL)
+    {
+        fprintf(stderr, "FAIL: free slot reuse hole=%d\n", hole);
+        return 14;
+    }
+    printf("loot_merge_stress_10k spawned=%d active=%d cap=%d spawn=%.2fms merge=%.2fms\n",
+           STRESS_ITEMS, active, rogue_items_capacity(), (double) (t1 - t0) / 1e6,
+           (double) (t3 - t2) / 1e6);
+    return 0;
+}
+
 int main(void)
 {
     rogue_item_defs_reset();
@@ -76,9 +203,9 @@ int main(void)
     /* Trigger merge pass (recent refactor moved merging to update loop). */
     rogue_items_update(0.0f);
     int active = rogue_items_active_count();
-    if (active > ROGUE_ITEM_INSTANCE_CAP)
+    if (active > rogue_items_capacity())
     {
-        fprintf(stderr, "FAIL: active exceeds cap %d>%d\n", active, ROGUE_ITEM_INSTANCE_CAP);
+        fprintf(stderr, "FAIL: active exceeds cap %d>%d\n", active, rogue_items_capacity());
         return 6;
     }
     int merges = spawned - active;
@@ -97,5 +224,5 @@ int main(void)
     }
     printf("loot_merge_stress_ok spawned=%d active=%d merges=%d ratio=%.2f\n", spawned, active,
            merges, merge_ratio);
-    return 0;
+    return stress_10k(gold_index, rogue_item_def_index("bandage"));
 }
@@ -0,0 +1,180 @@
+/* Unified profiler: nested scopes, per-thread rings drained into zone totals, frame spike capture
+ * of the last N frames and Chrome trace-event export. */
+#define SDL_MAIN_HANDLED 1
+#include "../../src/util/profiler.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if defined(ROGUE_HAVE_SDL)
+#include <SDL.h>
+#endif
+
+#define THREADS 4
+#define SCOPES_PER_THREAD 6000
+
+static void busy_wait_ms(double ms)
+{
+    uint64_t end = rogue_prof_now_ns() + (uint64_t) (ms * 1e6);
+    while (rogue_prof_now_ns() < end)
+    {
+    }
+}
+
+static int count_substr(const char* s, const char* sub)
+{
+    int n = 0;
+    size_t len = strlen(sub);
+    for (const char* p = strstr(s, sub); p; p = strstr(p + len, sub))
+        n++;
+    return n;
+}
+
+static int worker(void* ud)
+{
+    (void) ud;
+    rogue_prof_thread_name("prof_worker");
+    for (int i = 0; i < SCOPES_PER_THREAD; i++)
+    {
+        ROGUE_PROF_BEGIN("worker_item");
+        ROGUE_PROF_END();
+    }
+    return 0;
+}
+
+int main(void)
+{
+    rogue_prof_reset();
+    rogue_prof_set_enabled(1);
+    if (!rogue_prof_enabled())
+    {
+        printf("PROFILER_OK skipped (ROGUE_ENABLE_PROFILER=0)\n");
+        return 0;
+    }
+    rogue_prof_thread_name("main");
+    int outer = rogue_prof_zone_register("outer");
+    int inner = rogue_prof_zone_register("inner");
+    if (outer < 0 || inner < 0 || rogue_prof_zone_register("outer") != outer ||
+        strcmp(rogue_prof_zone_name(inner), "inner") != 0)
+    {
+        printf("PROFILER_FAIL registry\n");
+        return 1;
+    }
+
+    /* 1. nesting: inner closes inside outer; ending outer also closes a dangling inner */
+    rogue_prof_begin(outer);
+    rogue_prof_begin(inner);
+    busy_wait_ms(1.0);
+    rogue_prof_end(inner);
+    rogue_prof_begin(inner);
+    rogue_prof_end(outer);
+    rogue_prof_end(inner); /* no open scope left: ignored */
+    RogueProfZoneStats so, si;
+    if (rogue_prof_zone_stats(outer, &so) != 0 || rogue_prof_zone_stats(inner, &si) != 0 ||
+        so.count != 1 || si.count != 2 || so.total_ms < 1.0 || so.total_ms < si.max_ms)
+    {
+        printf("PROFILER_FAIL nesting outer=%d inner=%d\n", so.count, si.count);
+        return 1;
+    }
+
+    /* 2. runtime switch: nothing recorded while disabled */
+    rogue_prof_set_enabled(0);
+    rogue_prof_begin(outer);
+    rogue_prof_end(outer);
+    rogue_prof_set_enabled(1);
+    if (rogue_prof_zone_stats(outer, &so) != 0 || so.count != 1)
+    {
+        printf("PROFILER_FAIL disabled scope recorded\n");
+        return 1;
+    }
+
+    /* 3. threads: every scope lands in the totals (or is counted as dropped) */
+    int threads_run = 1;
+#if defined(ROGUE_HAVE_SDL)
+    SDL_Thread* th[THREADS];
+    for (int i = 0; i < THREADS; i++)
+        th[i] = SDL_CreateThread(worker, "prof_worker", NULL);
+    for (int i = 0; i < THREADS; i++)
+    {
+        if (th[i])
+            SDL_WaitThread(th[i], NULL);
+        else
+            worker(NULL);
+    }
+    threads_run = THREADS;
+#else
+    worker(NULL);
+#endif
+    int item = rogue_prof_zone_register("worker_item");
+    RogueProfZoneStats sw;
+    if (rogue_prof_zone_stats(item, &sw) != 0 ||
+        sw.count + rogue_prof_dropped() != threads_run * SCOPES_PER_THREAD)
+    {
+        printf("PROFILER_FAIL threads count=%d dropped=%d\n", sw.count, rogue_prof_dropped());
+        return 1;
+    }
+
+    /* 4. export: one "X" event per retained scope, balanced JSON */
+    rogue_prof_reset();
+    rogue_prof_begin(outer);
+    rogue_prof_begin(inner);
+    rogue_prof_end(inner);
+    rogue_prof_end(outer);
+    int need = rogue_prof_export_chrome(NULL, 0, 0);
+    char* json = (char*) malloc((size_t) need + 1);
+    if (!json || rogue_prof_export_chrome(json, need + 1, 0) != need ||
+        strncmp(json, "{\"traceEvents\":[", 16) != 0 || count_substr(json, "\"ph\":\"X\"") != 2 ||
+        !strstr(json, "\"name\":\"inner\"") || !strstr(json, "\"depth\":1") ||
+        !strstr(json, "\"thread_name\"") || count_substr(json, "{") != count_substr(json, "}"))
+    {
+        printf("PROFILER_FAIL export %s\n", json ? json : "(alloc)");
+        return 1;
+    }
+    free(json);
+    if (rogue_prof_export_chrome(NULL, 0, 1) != -1)
+    {
+        printf("PROFILER_FAIL capture before any spike\n");
+        return 1;
+    }
+
+    /* 5. spike: a slow frame captures the last 3 frames (including the spike) */
+    rogue_prof_reset();
+    rogue_prof_set_spike_threshold(5.0, 3);
+    for (int f = 0; f < 10; f++)
+    {
+        rogue_prof_frame_begin();
+        if (f == 6)
+        {
+            ROGUE_PROF_BEGIN("spike_work");
+            busy_wait_ms(8.0);
+            ROGUE_PROF_END();
+        }
+        else
+        {
+            ROGUE_PROF_BEGIN("light_work");
+            ROGUE_PROF_END();
+        }
+        rogue_prof_frame_end();
+    }
+    RogueProfFrameInfo frames[ROGUE_PROF_FRAME_HISTORY];
+    int nf = rogue_prof_frames(frames, ROGUE_PROF_FRAME_HISTORY);
+    need = rogue_prof_export_chrome(NULL, 0, 1);
+    json = need > 0 ? (char*) malloc((size_t) need + 1) : NULL;
+    if (nf != 10 || frames[6].ms < 5.0 || rogue_prof_spike_count() != 1 || !json ||
+        rogue_prof_export_chrome(json, need + 1, 1) != need)
+    {
+        printf("PROFILER_FAIL spike frames=%d spikes=%d\n", nf, rogue_prof_spike_count());
+        return 1;
+    }
+    /* frames 4,5,6: two light frames, the spike frame, and their frame scopes */
+    if (!strstr(json, "spike_work") || count_substr(json, "light_work") != 2 ||
+        count_substr(json, "\"name\":\"frame\"") != 3)
+    {
+        printf("PROFILER_FAIL capture %s\n", json);
+        return 1;
+    }
+    free(json);
+
+    printf("PROFILER_OK threads=%d scopes=%d dropped=%d spike_ms=%.2f\n", threads_run, sw.count,
+           rogue_prof_dropped(), frames[6].ms);
+    return 0;
+}
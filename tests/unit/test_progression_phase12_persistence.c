@@ -43,16 +43,10 @@ int main(void)
     rogue_progression_persist_reset_state_for_tests();
     rogue_progression_persist_register();
     init_state();
-    FILE* f = NULL;
-#if defined(_MSC_VER)
-    tmpfile_s(&f);
-#else
-    f = tmpfile();
-#endif
-    assert(f);
-    assert(rogue_progression_persist_write(f) == 0);
+    RogueSaveBuffer blob;
+    rogue_save_buffer_init(&blob);
+    assert(rogue_progression_persist_write(&blob) == 0);
     unsigned long long chainA = rogue_progression_persist_chain_hash();
-    fseek(f, 0, SEEK_SET);
     g_app.level = 1;
     g_app.xp_total_accum = 0;
     g_attr_state.strength = 0;
@@ -61,7 +55,10 @@ int main(void)
     g_attr_state.intelligence = 0;
     g_attr_state.spent_points = 0;
     g_attr_state.respec_tokens = 0;
-    assert(rogue_progression_persist_read(f) == 0);
+    RogueSaveReader in;
+    rogue_save_reader_init(&in, blob.data, blob.len);
+    assert(rogue_progression_persist_read(&in) == 0);
+    rogue_save_buffer_free(&blob);
     assert(g_app.level == 15 && g_attr_state.strength == 5);
     unsigned long long chainB = rogue_progression_persist_chain_hash();
     assert(chainA == chainB);
@@ -80,16 +77,9 @@ int main(void)
     legacy.attr_journal_hash = 111;
     legacy.passive_journal_hash = 222;
     legacy.passive_entry_count = 0;
-    FILE* f2 = NULL;
-#if defined(_MSC_VER)
-    tmpfile_s(&f2);
-#else
-    f2 = tmpfile();
-#endif
-    assert(f2);
-    fwrite(&legacy, sizeof legacy, 1, f2);
-    fseek(f2, 0, SEEK_SET);
-    assert(rogue_progression_persist_read(f2) == 0);
+    RogueSaveReader legacy_in;
+    rogue_save_reader_init(&legacy_in, &legacy, sizeof legacy);
+    assert(rogue_progression_persist_read(&legacy_in) == 0);
     assert(g_app.level == 20 && g_attr_state.dexterity == 8);
     unsigned int mig = rogue_progression_persist_last_migration_flags();
     (void) mig;
@@ -37,14 +37,9 @@ int main(void)
     rogue_attr_respec(&g_attr_state, 'D'); /* op2 */
     int ops_before = rogue_attr_journal_count();
     unsigned long long chain_before = 0ULL;
-    FILE* f = NULL;
-#if defined(_MSC_VER)
-    tmpfile_s(&f);
-#else
-    f = tmpfile();
-#endif
-    assert(f);
-    assert(rogue_progression_persist_write(f) == 0);
+    RogueSaveBuffer blob;
+    rogue_save_buffer_init(&blob);
+    assert(rogue_progression_persist_write(&blob) == 0);
     chain_before = rogue_progression_persist_chain_hash();
     /* wipe and restore */
     g_app.level = 1;
@@ -62,8 +57,10 @@ int main(void)
         free(g_attr_state.ops);
         g_attr_state.ops = NULL;
     }
-    fseek(f, 0, SEEK_SET);
-    assert(rogue_progression_persist_read(f) == 0);
+    RogueSaveReader in;
+    rogue_save_reader_init(&in, blob.data, blob.len);
+    assert(rogue_progression_persist_read(&in) == 0);
+    rogue_save_buffer_free(&blob);
     assert(g_app.level == 22);
     unsigned long long chain_after = rogue_progression_persist_chain_hash();
     assert(chain_before == chain_after);
@@ -6,17 +6,16 @@
  * LNK2005. */
 typedef struct RogueBuff RogueBuff; /* opaque for this test */
 int rogue_buffs_apply(int type, int magnitude, double duration_ms, double now_ms);
-static int write_comp(FILE* f)
+static int write_comp(RogueSaveBuffer* out)
 {
     int v = 1;
-    fwrite(&v, sizeof v, 1, f);
-    return 0;
+    return rogue_save_buffer_append(out, &v, sizeof v);
 }
-static int read_comp(FILE* f, size_t s)
+static int read_comp(RogueSaveReader* in, size_t s)
 {
     (void) s;
     int v;
-    fread(&v, sizeof v, 1, f);
+    rogue_save_reader_read(in, &v, sizeof v);
     return 0;
 }
 
@@ -5,16 +5,15 @@
 
 /* Minimal component for scheduling */
 static int dummy_val = 7;
-static int write_dummy(FILE* f)
+static int write_dummy(RogueSaveBuffer* out)
 {
-    fwrite(&dummy_val, sizeof dummy_val, 1, f);
-    return 0;
+    return rogue_save_buffer_append(out, &dummy_val, sizeof dummy_val);
 }
-static int read_dummy(FILE* f, size_t sz)
+static int read_dummy(RogueSaveReader* in, size_t sz)
 {
     if (sz < sizeof(int))
         return -1;
-    fread(&dummy_val, sizeof dummy_val, 1, f);
+    rogue_save_reader_read(in, &dummy_val, sizeof dummy_val);
     return 0;
 }
 /* Use real buff system (no local stub). */
@@ -31,6 +30,7 @@ int main(void)
     for (int t = 0; t <= 5000; t += 250)
     {
         rogue_save_manager_update((uint32_t) t, 0);
+        rogue_save_async_wait(); /* autosaves are async by default; settle before the next tick */
     }
     if (rogue_save_autosave_count() < 4)
     {
@@ -6,28 +6,29 @@
 /* Define two lightweight dummy components to exercise incremental caching */
 static int g_dummy_a_value = 1234; /* component id 1 */
 static int g_dummy_b_value = 5678; /* component id 2 */
-static int write_dummy_a(FILE* f)
+static int g_fail_b = 0;           /* make B's writer fail (simulated capture error) */
+static int write_dummy_a(RogueSaveBuffer* out)
 {
-    fwrite(&g_dummy_a_value, sizeof g_dummy_a_value, 1, f);
-    return 0;
+    return rogue_save_buffer_append(out, &g_dummy_a_value, sizeof g_dummy_a_value);
 }
-static int read_dummy_a(FILE* f, size_t size)
+static int read_dummy_a(RogueSaveReader* in, size_t size)
 {
     if (size < sizeof(int))
         return -1;
-    fread(&g_dummy_a_value, sizeof g_dummy_a_value, 1, f);
+    rogue_save_reader_read(in, &g_dummy_a_value, sizeof g_dummy_a_value);
     return 0;
 }
-static int write_dummy_b(FILE* f)
+static int write_dummy_b(RogueSaveBuffer* out)
 {
-    fwrite(&g_dummy_b_value, sizeof g_dummy_b_value, 1, f);
-    return 0;
+    if (g_fail_b)
+        return -7;
+    return rogue_save_buffer_append(out, &g_dummy_b_value, sizeof g_dummy_b_value);
 }
-static int read_dummy_b(FILE* f, size_t size)
+static int read_dummy_b(RogueSaveReader* in, size_t size)
 {
     if (size < sizeof(int))
         return -1;
-    fread(&g_dummy_b_value, sizeof g_dummy_b_value, 1, f);
+    rogue_save_reader_read(in, &g_dummy_b_value, sizeof g_dummy_b_value);
     return 0;
 }
 
@@ -86,6 +87,31 @@ int main(void)
         printf("INCR_FAIL third save dirty\n");
         return 1;
     }
+    /* A failed save keeps the dirty bits it captured: A changes, B's writer fails, and the next
+     * save must rewrite A instead of reusing its stale cached section. */
+    g_dummy_a_value = 2468;
+    rogue_save_mark_component_dirty(1);
+    rogue_save_mark_component_dirty(2);
+    g_fail_b = 1;
+    if (rogue_save_manager_save_slot(0) == 0 || rogue_save_component_is_dirty(1) != 1)
+    {
+        printf("INCR_FAIL failed save cleared dirty\n");
+        return 1;
+    }
+    g_fail_b = 0;
+    unsigned reused = 0, written = 0;
+    if (rogue_save_manager_save_slot(0) != 0)
+    {
+        printf("INCR_FAIL save after failure\n");
+        return 1;
+    }
+    rogue_save_last_section_reuse(&reused, &written);
+    g_dummy_a_value = 0;
+    if (written != 2 || rogue_save_manager_load_slot(0) != 0 || g_dummy_a_value != 2468)
+    {
+        printf("INCR_FAIL stale section written=%u a=%d\n", written, g_dummy_a_value);
+        return 1;
+    }
     printf("INCR_OK sz=%ld a=%d b=%d\n", sz2, g_dummy_a_value, g_dummy_b_value);
     return 0;
 }
@@ -0,0 +1,224 @@
+/* v10 LZ section codec: block round trips across levels, streaming decode in arbitrary chunk
+ * sizes, malformed input rejection, and save/load with per-component codec stats. */
+#include "../../src/core/persistence/save_codec.h"
+#include "../../src/core/persistence/save_manager.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static unsigned g_rng = 12345u;
+static unsigned next_rand(void)
+{
+    g_rng = g_rng * 1103515245u + 12345u;
+    return g_rng >> 8;
+}
+
+/* Structured sample resembling serialized records: repeated field layouts, small ints, names. */
+static void fill_records(unsigned char* buf, size_t n)
+{
+    static const char* names[] = {"long_sword", "oak_staff", "healing_potion", "iron_helm"};
+    size_t p = 0;
+    while (p < n)
+    {
+        unsigned char rec[48];
+        memset(rec, 0, sizeof rec);
+        unsigned v = next_rand();
+        rec[0] = (unsigned char) (v & 7);
+        rec[4] = (unsigned char) (v >> 5);
+        const char* nm = names[(v >> 9) & 3];
+        memcpy(rec + 8, nm, strlen(nm));
+        for (size_t i = 0; i < sizeof rec && p < n; i++)
+            buf[p++] = rec[i];
+    }
+}
+
+typedef struct Collect
+{
+    unsigned char* out;
+    size_t len;
+    size_t cap;
+} Collect;
+
+static int collect_sink(const unsigned char* data, size_t len, void* user)
+{
+    Collect* c = (Collect*) user;
+    if (c->len + len > c->cap)
+        return -1;
+    memcpy(c->out + c->len, data, len);
+    c->len += len;
+    return 0;
+}
+
+static int check_roundtrip(const unsigned char* src, size_t n, int level, RogueSaveDecodeStream* ds,
+                           size_t* out_enc)
+{
+    size_t cap = rogue_save_lz_bound(n);
+    unsigned char* enc = (unsigned char*) malloc(cap);
+    unsigned char* dec = (unsigned char*) malloc(n + 1);
+    size_t w = rogue_save_lz_compress(src, n, enc, cap, level);
+    if (!enc || !dec || w == 0)
+        return -1;
+    long d = rogue_save_lz_decompress(enc, w, dec, n);
+    if (d != (long) n || memcmp(src, dec, n) != 0)
+        return -2;
+    /* stream in uneven chunks */
+    Collect c = {dec, 0, n};
+    memset(dec, 0, n + 1);
+    rogue_save_decode_stream_init(ds, ROGUE_SAVE_CODEC_LZ, n, collect_sink, &c);
+    size_t off = 0, step = 1;
+    while (off < w)
+    {
+        size_t k = (w - off < step) ? w - off : step;
+        if (rogue_save_decode_stream_feed(ds, enc + off, k) != 0)
+            return -3;
+        off += k;
+        step = step * 3 + 1;
+        if (step > 5000)
+            step = 1;
+    }
+    if (rogue_save_decode_stream_finish(ds) != 0 || c.len != n || memcmp(src, dec, n) != 0)
+        return -4;
+    /* truncated input must be rejected by both decoders */
+    if (w > 1 && rogue_save_lz_decompress(enc, w - 1, dec, n) == (long) n)
+        return -5;
+    if (out_enc)
+        *out_enc = w;
+    free(enc);
+    free(dec);
+    return 0;
+}
+
+static int write_blob(RogueSaveBuffer* out)
+{
+    unsigned char* b = (unsigned char*) malloc(64 * 1024);
+    fill_records(b, 64 * 1024);
+    int rc = rogue_save_buffer_append(out, b, 64 * 1024);
+    free(b);
+    return rc;
+}
+static int read_blob(RogueSaveReader* in, size_t size)
+{
+    if (size != 64 * 1024)
+        return -1;
+    unsigned char* b = (unsigned char*) malloc(size);
+    unsigned char* e = (unsigned char*) malloc(size);
+    int r = rogue_save_reader_read(in, b, size);
+    g_rng = 777u;
+    fill_records(e, size);
+    int ok = r == 0 && memcmp(b, e, size) == 0;
+    free(b);
+    free(e);
+    return ok ? 0 : -1;
+}
+static int write_blob_seeded(RogueSaveBuffer* out)
+{
+    g_rng = 777u;
+    return write_blob(out);
+}
+
+int main(void)
+{
+    RogueSaveDecodeStream* ds = (RogueSaveDecodeStream*) malloc(sizeof *ds);
+    size_t sizes[] = {0, 1, 5, 12, 13, 17, 64, 255, 1000, 70000, 300000};
+    unsigned char* src = (unsigned char*) malloc(300000);
+    for (size_t si = 0; si < sizeof sizes / sizeof sizes[0]; si++)
+    {
+        size_t n = sizes[si];
+        for (int pattern = 0; pattern < 3; pattern++)
+        {
+            if (pattern == 0)
+                fill_records(src, n);
+            else if (pattern == 1)
+                for (size_t i = 0; i < n; i++)
+                    src[i] = (unsigned char) next_rand(); /* incompressible */
+            else
+                memset(src, 'z', n); /* long overlapping matches */
+            for (int level = 1; level <= 9; level += 4)
+            {
+                int rc = check_roundtrip(src, n, level, ds, NULL);
+                if (rc != 0)
+                {
+                    printf("LZ_FAIL roundtrip n=%zu pattern=%d level=%d rc=%d\n", n, pattern,
+                           level, rc);
+                    return 1;
+                }
+            }
+        }
+    }
+    /* ratio / speed on structured data vs legacy RLE */
+    size_t n = 256 * 1024;
+    unsigned char* big = (unsigned char*) malloc(n);
+    fill_records(big, n);
+    unsigned char* tmp = (unsigned char*) malloc(n * 2 + 16);
+    size_t rle = rogue_save_rle_compress(big, n, tmp, n * 2 + 16);
+    printf("LZ_RATIO rle=%.3f", (double) rle / (double) n);
+    for (int level = 1; level <= 9; level += 4)
+    {
+        size_t enc = 0;
+        clock_t t0 = clock();
+        if (check_roundtrip(big, n, level, ds, &enc) != 0)
+        {
+            printf("\nLZ_FAIL big level=%d\n", level);
+            return 1;
+        }
+        double ms = (double) (clock() - t0) * 1000.0 / CLOCKS_PER_SEC;
+        printf(" L%d=%.3f(%.1fms)", level, (double) enc / (double) n, ms);
+        if (enc >= rle)
+        {
+            printf("\nLZ_FAIL lz not smaller than rle\n");
+            return 1;
+        }
+    }
+    printf("\n");
+    /* malformed: zero offset */
+    unsigned char bad[] = {0x10, 'a', 0x00, 0x00, 0x50, 'a', 'b', 'c', 'd', 'e'};
+    unsigned char out[64];
+    if (rogue_save_lz_decompress(bad, sizeof bad, out, sizeof out) >= 0)
+    {
+        printf("LZ_FAIL accepted zero offset\n");
+        return 1;
+    }
+    Collect c = {out, 0, sizeof out};
+    rogue_save_decode_stream_init(ds, ROGUE_SAVE_CODEC_LZ, sizeof out, collect_sink, &c);
+    if (rogue_save_decode_stream_feed(ds, bad, sizeof bad) == 0)
+    {
+        printf("LZ_FAIL stream accepted zero offset\n");
+        return 1;
+    }
+
+    /* end to end: compressed save + load with per-component stats */
+    rogue_save_manager_reset_for_tests();
+    rogue_save_manager_init();
+    RogueSaveComponent C = {20, write_blob_seeded, read_blob, "blob"};
+    rogue_save_manager_register(&C);
+    rogue_save_set_compression(1, 64);
+    rogue_save_set_compression_level(5);
+    if (rogue_save_manager_save_slot(0) != 0)
+    {
+        printf("LZ_FAIL save\n");
+        return 1;
+    }
+    RogueSaveCodecStats st;
+    if (rogue_save_codec_stats(20, &st) != 0 || st.codec != ROGUE_SAVE_CODEC_LZ ||
+        st.raw_bytes != 64 * 1024 || st.stored_bytes >= st.raw_bytes)
+    {
+        printf("LZ_FAIL encode stats codec=%d raw=%u stored=%u\n", st.codec, st.raw_bytes,
+               st.stored_bytes);
+        return 1;
+    }
+    if (rogue_save_manager_load_slot(0) != 0)
+    {
+        printf("LZ_FAIL load\n");
+        return 1;
+    }
+    rogue_save_codec_stats(20, &st);
+    printf("LZ_OK component=blob raw=%u stored=%u ratio=%.3f enc_ms=%.3f dec_ms=%.3f\n",
+           st.raw_bytes, st.stored_bytes, (double) st.stored_bytes / (double) st.raw_bytes,
+           st.encode_ms, st.decode_ms);
+    free(big);
+    free(tmp);
+    free(src);
+    free(ds);
+    return 0;
+}
@@ -3,16 +3,15 @@
 #include <stdio.h>
 #include <string.h>
 
-static int dummy_write(FILE* f)
+static int dummy_write(RogueSaveBuffer* out)
 {
     const char data[] = "ABC";
-    fwrite(data, 1, sizeof data, f);
-    return 0;
+    return rogue_save_buffer_append(out, data, sizeof data);
 }
-static int dummy_read(FILE* f, size_t size)
+static int dummy_read(RogueSaveReader* in, size_t size)
 {
     char buf[8] = {0};
-    fread(buf, 1, size < sizeof buf ? size : sizeof buf, f);
+    rogue_save_reader_read(in, buf, size < sizeof buf ? size : sizeof buf);
     return (buf[0] == 'A') ? 0 : -1;
 }
 static RogueSaveComponent DUMMY = {10, dummy_write, dummy_read, "dummy"};
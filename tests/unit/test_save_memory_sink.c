@@ -0,0 +1,102 @@
+/* In-memory save writer: component callbacks append straight into the save buffer, compressed +
+ * raw sections round-trip, and the file size on disk matches the assembled image. */
+#include "../../src/core/persistence/save_manager.h"
+#include "../../src/core/persistence/save_paths.h"
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+
+static unsigned char g_blob[8192];
+static unsigned char g_blob_loaded[8192];
+static int g_small = 4242;
+static int g_small_loaded = 0;
+
+static int write_blob(RogueSaveBuffer* out)
+{
+    return rogue_save_buffer_append(out, g_blob, sizeof g_blob);
+}
+static int read_blob(RogueSaveReader* in, size_t size)
+{
+    if (size != sizeof g_blob_loaded)
+        return -1;
+    return rogue_save_reader_read(in, g_blob_loaded, size);
+}
+static int write_small(RogueSaveBuffer* out)
+{
+    return rogue_save_buffer_append(out, &g_small, sizeof g_small);
+}
+static int read_small(RogueSaveReader* in, size_t size)
+{
+    if (size < sizeof(int))
+        return -1;
+    rogue_save_reader_read(in, &g_small_loaded, sizeof g_small_loaded);
+    return 0;
+}
+
+static long fsize(const char* p)
+{
+    struct stat st;
+    if (stat(p, &st) != 0)
+        return -1;
+    return (long) st.st_size;
+}
+
+int main(void)
+{
+    for (size_t i = 0; i < sizeof g_blob; i++)
+        g_blob[i] = (unsigned char) ((i / 64) & 0xFF); /* long runs => RLE-compressible */
+    rogue_save_manager_reset_for_tests();
+    rogue_save_manager_init();
+    RogueSaveComponent A = {1, write_blob, read_blob, "blob"};
+    RogueSaveComponent B = {2, write_small, read_small, "small"};
+    rogue_save_manager_register(&A);
+    rogue_save_manager_register(&B);
+    rogue_save_set_compression(1, 64); /* blob compresses, small stays raw (< min bytes) */
+    for (int pass = 0; pass < 2; pass++)
+    {
+        rogue_save_set_incremental(pass); /* second pass exercises cache capture from memory */
+        if (rogue_save_manager_save_slot(0) != 0)
+        {
+            printf("MEMSINK_FAIL save pass=%d\n", pass);
+            return 1;
+        }
+        long on_disk = fsize(rogue_build_slot_path(0));
+        if (on_disk <= 0 || (uint32_t) on_disk != rogue_save_last_save_bytes())
+        {
+            printf("MEMSINK_FAIL size disk=%ld image=%u\n", on_disk, rogue_save_last_save_bytes());
+            return 1;
+        }
+        if (on_disk >= (long) sizeof g_blob)
+        {
+            printf("MEMSINK_FAIL not_compressed size=%ld\n", on_disk);
+            return 1;
+        }
+        memset(g_blob_loaded, 0, sizeof g_blob_loaded);
+        g_small_loaded = 0;
+        if (rogue_save_manager_load_slot(0) != 0)
+        {
+            printf("MEMSINK_FAIL load pass=%d\n", pass);
+            return 1;
+        }
+        if (memcmp(g_blob, g_blob_loaded, sizeof g_blob) != 0 || g_small_loaded != g_small)
+        {
+            printf("MEMSINK_FAIL payload mismatch pass=%d\n", pass);
+            return 1;
+        }
+    }
+    /* Incremental reuse path: clean components come from the in-memory section cache */
+    if (rogue_save_manager_save_slot(0) != 0 || rogue_save_manager_load_slot(0) != 0)
+    {
+        printf("MEMSINK_FAIL reuse roundtrip\n");
+        return 1;
+    }
+    unsigned reused = 0, written = 0;
+    rogue_save_last_section_reuse(&reused, &written);
+    if (reused != 2 || written != 0)
+    {
+        printf("MEMSINK_FAIL reuse reused=%u written=%u\n", reused, written);
+        return 1;
+    }
+    printf("MEMSINK_OK bytes=%u\n", rogue_save_last_save_bytes());
+    return 0;
+}
@@ -0,0 +1,201 @@
+/* Skill simulation contexts: isolated runs match the live activation path, a parallel batch gives
+ * the same results as running each job alone, and neither touches live player / skill / buff
+ * state (including the JSON rotation wrapper). */
+#define SDL_MAIN_HANDLED 1
+#include "../../src/core/app/app_state.h"
+#include "../../src/core/skills/skill_sim.h"
+#include "../../src/core/skills/skills.h"
+#include "../../src/game/buffs.h"
+#include "../../src/graphics/effect_spec.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define JOBS 256
+
+static int consume(const RogueSkillDef* def, struct RogueSkillState* st, const RogueSkillCtx* ctx)
+{
+    (void) def;
+    (void) st;
+    (void) ctx;
+    return ROGUE_ACT_CONSUMED;
+}
+
+static int register_skills(void)
+{
+    RogueEffectSpec haste;
+    memset(&haste, 0, sizeof haste);
+    haste.kind = ROGUE_EFFECT_STAT_BUFF;
+    haste.buff_type = ROGUE_BUFF_POWER_STRIKE;
+    haste.magnitude = 5;
+    haste.duration_ms = 1500.0f;
+    haste.stack_rule = ROGUE_BUFF_STACK_ADD;
+    haste.scale_by_buff_type = 0xFFFFu;
+    haste.require_buff_type = 0xFFFFu;
+    int haste_id = rogue_effect_register(&haste);
+    if (haste_id < 0)
+        return -1;
+    static const float cooldowns[3] = {300.0f, 700.0f, 1200.0f};
+    static const float costs[3] = {5.0f, 20.0f, 35.0f};
+    for (int i = 0; i < 3; i++)
+    {
+        RogueSkillDef d;
+        memset(&d, 0, sizeof d);
+        d.name = i == 0 ? "Jab" : i == 1 ? "Surge" : "Burst";
+        d.max_rank = 1;
+        d.base_cooldown_ms = cooldowns[i];
+        d.action_point_cost = costs[i];
+        d.on_activate = consume;
+        d.effect_spec_id = i == 1 ? haste_id : -1;
+        if (rogue_skill_register(&d) != i)
+            return -1;
+    }
+    g_app.talent_points = 3;
+    for (int i = 0; i < 3; i++)
+        if (rogue_skill_rank_up(i) != 1)
+            return -1;
+    return 0;
+}
+
+static void make_job(RogueSkillSimJob* job, int i)
+{
+    memset(job, 0, sizeof *job);
+    job->prio_count = 3;
+    for (int k = 0; k < 3; k++)
+        job->priority[k] = (i + k) % 3;
+    job->duration_ms = 4000.0 + 250.0 * (i % 4);
+    job->tick_ms = 16.0;
+    job->ap_regen_per_sec = 80.0 + (i % 5) * 40.0;
+    job->base_damage = 100;
+    job->seed = 1234u + (unsigned) i * 7919u;
+}
+
+static int same_result(const RogueSkillSimResult* a, const RogueSkillSimResult* b)
+{
+    return a->total_casts == b->total_casts && a->ap_spent == b->ap_spent &&
+           a->crits == b->crits && a->damage == b->damage &&
+           memcmp(a->casts, b->casts, sizeof a->casts) == 0;
+}
+
+int main(void)
+{
+    rogue_skills_init();
+    if (register_skills() != 0)
+    {
+        printf("SKILL_SIM_BATCH_FAIL register\n");
+        return 1;
+    }
+    g_app.player.level = 1;
+    g_app.player.dexterity = 10;
+    g_app.player.crit_chance = 30;
+    g_app.player.crit_damage = 50;
+    rogue_player_recalc_derived(&g_app.player);
+    g_app.game_time_ms = 500.0;
+
+    RoguePlayer player_before = g_app.player;
+    RogueSkillState states_before[3];
+    for (int i = 0; i < 3; i++)
+        states_before[i] = *rogue_skill_get_state(i);
+
+    /* 1. sequential reference, then the parallel batch */
+    static RogueSkillSimJob jobs[JOBS];
+    static RogueSkillSimResult seq[JOBS], par[JOBS];
+    for (int i = 0; i < JOBS; i++)
+        make_job(&jobs[i], i);
+    clock_t t0 = clock();
+    for (int i = 0; i < JOBS; i++)
+    {
+        RogueSkillSimCtx sc;
+        if (rogue_skill_sim_ctx_init(&sc, NULL, g_app.game_time_ms, jobs[i].seed) != 0 ||
+            rogue_skill_sim_run(&sc, &jobs[i], NULL, &seq[i]) != 0)
+        {
+            printf("SKILL_SIM_BATCH_FAIL sequential job=%d\n", i);
+            return 1;
+        }
+        rogue_skill_sim_ctx_free(&sc);
+    }
+    double seq_ms = (double) (clock() - t0) * 1000.0 / CLOCKS_PER_SEC;
+    if (rogue_skill_sim_batch(jobs, par, JOBS, 4) != JOBS)
+    {
+        printf("SKILL_SIM_BATCH_FAIL batch\n");
+        return 1;
+    }
+    long long crits = 0, casts = 0;
+    for (int i = 0; i < JOBS; i++)
+    {
+        if (!same_result(&seq[i], &par[i]))
+        {
+            printf("SKILL_SIM_BATCH_FAIL mismatch job=%d casts %d/%d dmg %lld/%lld\n", i,
+                   seq[i].total_casts, par[i].total_casts, seq[i].damage, par[i].damage);
+            return 1;
+        }
+        crits += seq[i].crits;
+        casts += seq[i].total_casts;
+    }
+    if (casts == 0 || crits == 0 || crits >= casts)
+    {
+        printf("SKILL_SIM_BATCH_FAIL crits=%lld casts=%lld\n", crits, casts);
+        return 1;
+    }
+
+    /* 2. no live side effects (batch + JSON wrapper) */
+    char out[256];
+    if (skill_simulate_rotation("{\"duration_ms\":3000,\"priority\":[2,1,0]}", out,
+                                (int) sizeof out) != 0)
+    {
+        printf("SKILL_SIM_BATCH_FAIL rotation\n");
+        return 1;
+    }
+    if (memcmp(&player_before, &g_app.player, sizeof player_before) != 0 ||
+        g_app.game_time_ms != 500.0 || rogue_buffs_active_count() != 0)
+    {
+        printf("SKILL_SIM_BATCH_FAIL live player/time/buffs touched\n");
+        return 1;
+    }
+    for (int i = 0; i < 3; i++)
+        if (memcmp(&states_before[i], rogue_skill_get_state(i), sizeof states_before[i]) != 0)
+        {
+            printf("SKILL_SIM_BATCH_FAIL live skill state %d touched\n", i);
+            return 1;
+        }
+
+    /* 3. an isolated run reproduces the live activation path tick for tick */
+    const RogueSkillSimJob* job = &jobs[1];
+    int live_casts[3] = {0, 0, 0};
+    g_app.player.action_points = g_app.player.max_action_points;
+    g_app.ap_throttle_timer_ms = 0.0f;
+    double now = g_app.game_time_ms;
+    double end = now + job->duration_ms;
+    while (now < end)
+    {
+        g_app.player.action_points += (int) (job->ap_regen_per_sec / 1000.0 * job->tick_ms);
+        if (g_app.player.action_points > g_app.player.max_action_points)
+            g_app.player.action_points = g_app.player.max_action_points;
+        for (int k = 0; k < job->prio_count; k++)
+        {
+            RogueSkillCtx ctx = {0};
+            ctx.now_ms = now;
+            if (rogue_skill_try_activate(job->priority[k], &ctx))
+            {
+                live_casts[k]++;
+                break;
+            }
+        }
+        now += job->tick_ms;
+        rogue_skills_update(now);
+        rogue_buffs_update(now);
+    }
+    for (int k = 0; k < 3; k++)
+        if (live_casts[k] != seq[1].casts[k])
+        {
+            printf("SKILL_SIM_BATCH_FAIL live parity prio=%d %d/%d\n", k, live_casts[k],
+                   seq[1].casts[k]);
+            return 1;
+        }
+
+    rogue_skills_shutdown();
+    printf("SKILL_SIM_BATCH_OK jobs=%d casts=%lld crits=%lld seq_ms=%.2f\n", JOBS, casts, crits,
+           seq_ms);
+    return 0;
+}
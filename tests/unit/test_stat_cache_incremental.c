@@ -0,0 +1,154 @@
+/* Incremental stat cache: steady frames and buff-only changes skip equipment aggregation, a single
+ * equip change re-gathers one slot, incremental results match a full recompute and verify mode
+ * catches inputs that changed without being marked. */
+#include "../../src/core/equipment/equipment.h"
+#include "../../src/core/equipment/equipment_stats.h"
+#include "../../src/core/loot/loot_affixes.h"
+#include "../../src/core/loot/loot_instances.h"
+#include "../../src/core/loot/loot_item_defs.h"
+#include "../../src/entities/player.h"
+#include "../../src/game/buffs.h"
+#include "../../src/game/stat_cache.h"
+#include <stdio.h>
+
+static int g_fail = 0;
+#define CHECK(c)                                                                                   \
+    do                                                                                             \
+    {                                                                                              \
+        if (!(c))                                                                                  \
+        {                                                                                          \
+            printf("STAT_CACHE_INCR_FAIL line %d: %s\n", __LINE__, #c);                           \
+            g_fail = 1;                                                                            \
+        }                                                                                          \
+    } while (0)
+
+static void seed_content(void)
+{
+    rogue_affixes_reset();
+    FILE* f = fopen("stat_incr_affix_tmp.cfg", "wb");
+    fprintf(f, "PREFIX,str_flat,strength_flat,3,3,10,10,10,10,10\n");
+    fprintf(f, "PREFIX,vit_flat,vitality_flat,5,5,10,10,10,10,10\n");
+    fprintf(f, "SUFFIX,armor_flat,armor_flat,7,7,10,10,10,10,10\n");
+    fclose(f);
+    rogue_affixes_load_from_cfg("stat_incr_affix_tmp.cfg");
+    rogue_item_defs_reset();
+    f = fopen("stat_incr_item_tmp.cfg", "wb");
+    fprintf(f, "blade_basic,BladeBasic,2,1,1,10,3,5,0,sheet.png,0,0,1,1,1\n");
+    fprintf(f, "helm_basic,HelmBasic,3,1,1,8,0,0,2,sheet.png,0,0,1,1,1\n");
+    fclose(f);
+    rogue_item_defs_load_from_cfg("stat_incr_item_tmp.cfg");
+    remove("stat_incr_affix_tmp.cfg");
+    remove("stat_incr_item_tmp.cfg");
+}
+
+static int spawn_item(const char* id, const char* prefix, const char* suffix)
+{
+    int inst = rogue_items_spawn(rogue_item_def_index(id), 1, 0.f, 0.f);
+    RogueItemInstance* it = (RogueItemInstance*) rogue_item_instance_at(inst);
+    if (!it)
+        return -1;
+    it->prefix_index = prefix ? rogue_affix_index(prefix) : -1;
+    it->prefix_value = prefix ? rogue_affix_at(it->prefix_index)->min_value : 0;
+    it->suffix_index = suffix ? rogue_affix_index(suffix) : -1;
+    it->suffix_value = suffix ? rogue_affix_at(it->suffix_index)->min_value : 0;
+    return inst;
+}
+
+/* One game frame as app_step runs it. */
+static void frame(RoguePlayer* p)
+{
+    rogue_equipment_apply_stat_bonuses(p);
+    rogue_stat_cache_update(p);
+}
+
+int main(void)
+{
+    seed_content();
+    rogue_items_init_runtime();
+    rogue_equip_reset();
+    rogue_buffs_init();
+    rogue_buffs_set_dampening(0.0); /* both test buffs land at t=0 */
+    rogue_stat_cache_set_verify(0);
+    RoguePlayer p;
+    rogue_player_init(&p);
+    int blade = spawn_item("blade_basic", "str_flat", NULL);
+    int helm = spawn_item("helm_basic", "vit_flat", "armor_flat");
+    CHECK(blade >= 0 && helm >= 0);
+    CHECK(rogue_equip_try(ROGUE_EQUIP_WEAPON, blade) == 0);
+    frame(&p);
+    unsigned int gathers = rogue_equipment_stats_slot_gather_count();
+    unsigned int scans = g_player_stat_cache.equipment_scan_count;
+    unsigned long long fp = rogue_stat_cache_fingerprint();
+    int total_str = g_player_stat_cache.total_strength;
+    CHECK(g_player_stat_cache.affix_strength == 3);
+
+    /* steady frames: no slot re-gathered, no equipment scan, identical state */
+    for (int i = 0; i < 20; i++)
+        frame(&p);
+    CHECK(rogue_equipment_stats_slot_gather_count() == gathers);
+    CHECK(g_player_stat_cache.equipment_scan_count == scans);
+    CHECK(rogue_stat_cache_fingerprint() == fp);
+    CHECK(p.strength == total_str && g_player_stat_cache.affix_strength == 3);
+
+    /* buff-only change: buff layer and derived metrics move, equipment stays cached */
+    int dps = g_player_stat_cache.dps_estimate;
+    CHECK(rogue_buffs_apply(ROGUE_BUFF_STAT_STRENGTH, 5, 3000, 0.0, ROGUE_BUFF_STACK_ADD, 1));
+    frame(&p);
+    CHECK(g_player_stat_cache.buff_strength == 5);
+    CHECK(g_player_stat_cache.total_strength == total_str + 5);
+    CHECK(rogue_equipment_stats_slot_gather_count() == gathers);
+    CHECK(g_player_stat_cache.equipment_scan_count == scans);
+    CHECK(g_player_stat_cache.dps_estimate == dps); /* dps scales with dexterity only */
+
+    /* incremental result matches a full recompute */
+    unsigned long long fp_inc = rogue_stat_cache_fingerprint();
+    int ehp_inc = g_player_stat_cache.ehp_estimate;
+    rogue_stat_cache_mark_dirty();
+    rogue_stat_cache_force_update(&p);
+    CHECK(rogue_stat_cache_fingerprint() == fp_inc);
+    CHECK(g_player_stat_cache.dps_estimate == dps && g_player_stat_cache.ehp_estimate == ehp_inc);
+    frame(&p); /* mark_dirty re-gathers every slot once */
+    CHECK(rogue_equipment_stats_slot_gather_count() == gathers + ROGUE_EQUIP__COUNT);
+
+    /* one equip re-gathers one slot and rescans equipment once */
+    gathers = rogue_equipment_stats_slot_gather_count();
+    scans = g_player_stat_cache.equipment_scan_count;
+    int vit = g_player_stat_cache.total_vitality;
+    int ehp = g_player_stat_cache.ehp_estimate;
+    CHECK(rogue_equip_try(ROGUE_EQUIP_ARMOR_HEAD, helm) == 0);
+    frame(&p);
+    CHECK(rogue_equipment_stats_slot_gather_count() == gathers + 1);
+    CHECK(g_player_stat_cache.equipment_scan_count == scans + 1);
+    CHECK(g_player_stat_cache.total_vitality == vit + 5);
+    CHECK(g_player_stat_cache.affix_armor_flat == 7);
+    CHECK(g_player_stat_cache.ehp_estimate > ehp);
+
+    /* verify mode: clean incremental updates agree with full recomputes */
+    rogue_stat_cache_set_verify(1);
+    unsigned int mismatches = g_player_stat_cache.verify_mismatch_count;
+    CHECK(rogue_buffs_apply(ROGUE_BUFF_STAT_STRENGTH, 2, 3000, 0.0, ROGUE_BUFF_STACK_ADD, 1));
+    for (int i = 0; i < 5; i++)
+        frame(&p);
+    CHECK(g_player_stat_cache.verify_mismatch_count == mismatches);
+
+    /* the weapon changes behind the cache's back and only attributes are marked: the incremental
+       update keeps the stale weapon damage; verify mode detects it and keeps the full result */
+    RogueItemInstance* w = (RogueItemInstance*) rogue_item_instance_at(blade);
+    w->rarity += 2;
+    dps = g_player_stat_cache.dps_estimate;
+    rogue_stat_cache_mark_attr_dirty();
+    rogue_stat_cache_update(&p);
+    CHECK(g_player_stat_cache.verify_mismatch_count == mismatches + 1);
+    CHECK(g_player_stat_cache.dps_estimate > dps);
+    int dps_fixed = g_player_stat_cache.dps_estimate;
+    rogue_stat_cache_mark_dirty();
+    rogue_stat_cache_force_update(&p);
+    CHECK(g_player_stat_cache.dps_estimate == dps_fixed);
+    rogue_stat_cache_set_verify(0);
+
+    if (g_fail)
+        return 1;
+    printf("STAT_CACHE_INCR_OK gathers=%u scans=%u\n", rogue_equipment_stats_slot_gather_count(),
+           g_player_stat_cache.equipment_scan_count);
+    return 0;
+}
@@ -0,0 +1,179 @@
+/* Entity status store: stacking rules match the buff system, a batched update ticks and expires
+ * thousands of enemy records through timers, per-entity removal, and the live buff set's expiry
+ * early-out. Prints a timing line for a large enemy population. */
+#include "../../src/game/buffs.h"
+#include "../../src/game/status_effects.h"
+#include "../../src/util/profiler.h"
+#include <stdio.h>
+
+static int g_fail = 0;
+#define CHECK(c)                                                                                   \
+    do                                                                                             \
+    {                                                                                              \
+        if (!(c))                                                                                  \
+        {                                                                                          \
+            printf("STATUS_EFFECTS_FAIL line %d: %s\n", __LINE__, #c);                            \
+            g_fail = 1;                                                                            \
+        }                                                                                          \
+    } while (0)
+
+typedef struct Counters
+{
+    long long tick_damage;
+    int tick_calls;
+    int expired;
+} Counters;
+
+static void on_tick(RogueStatusEntity e, int type, int magnitude, int ticks, void* user)
+{
+    (void) e;
+    (void) type;
+    Counters* c = (Counters*) user;
+    c->tick_damage += (long long) magnitude * ticks;
+    c->tick_calls++;
+}
+
+static void on_expire(RogueStatusEntity e, int type, int magnitude, void* user)
+{
+    (void) type;
+    (void) magnitude;
+    Counters* c = (Counters*) user;
+    c->expired++;
+    /* re-applying from a callback is allowed; the new record ticks from the next update */
+    if (e == rogue_status_entity_enemy(0))
+        rogue_status_apply(e, ROGUE_STATUS_CHILL, 1, 100.0, 1000.0, ROGUE_BUFF_STACK_UNIQUE, 0);
+}
+
+static void test_stacking(void)
+{
+    rogue_status_reset();
+    RogueStatusEntity e = rogue_status_entity_enemy(3);
+    CHECK(rogue_status_apply(e, ROGUE_STATUS_BLEED, 5, 1000.0, 0.0, ROGUE_BUFF_STACK_ADD, 0));
+    CHECK(rogue_status_apply(e, ROGUE_STATUS_BLEED, 7, 500.0, 100.0, ROGUE_BUFF_STACK_ADD, 0));
+    CHECK(rogue_status_get_total(e, ROGUE_STATUS_BLEED) == 12);
+    CHECK(rogue_status_stacks(e, ROGUE_STATUS_BLEED) == 2);
+    CHECK(rogue_status_end_ms(e, ROGUE_STATUS_BLEED) == 1000.0);
+    CHECK(!rogue_status_apply(e, ROGUE_STATUS_BLEED, 1, 10.0, 200.0, ROGUE_BUFF_STACK_UNIQUE, 0));
+    CHECK(rogue_status_apply(e, ROGUE_STATUS_BLEED, 3, 100.0, 200.0, ROGUE_BUFF_STACK_REFRESH, 0));
+    CHECK(rogue_status_end_ms(e, ROGUE_STATUS_BLEED) == 300.0);
+    CHECK(rogue_status_apply(e, ROGUE_STATUS_BLEED, 1, 100.0, 200.0, ROGUE_BUFF_STACK_EXTEND, 0));
+    CHECK(rogue_status_end_ms(e, ROGUE_STATUS_BLEED) == 400.0);
+    CHECK(rogue_status_apply(e, ROGUE_STATUS_BLEED, 150, 1.0, 200.0, ROGUE_BUFF_STACK_MULTIPLY, 0));
+    CHECK(rogue_status_get_total(e, ROGUE_STATUS_BLEED) == 18);
+    CHECK(!rogue_status_apply(e, ROGUE_STATUS_CHILL, 150, 10.0, 0.0, ROGUE_BUFF_STACK_MULTIPLY, 0));
+    CHECK(rogue_status_apply(e, ROGUE_STATUS_BLEED, 20, 50.0, 200.0,
+                             ROGUE_BUFF_STACK_REPLACE_IF_STRONGER, 0));
+    CHECK(rogue_status_get_total(e, ROGUE_STATUS_BLEED) == 20);
+    CHECK(rogue_status_end_ms(e, ROGUE_STATUS_BLEED) == 400.0);
+    /* a superseded expiry must not remove the record early */
+    rogue_status_update(350.0, NULL, NULL, NULL);
+    CHECK(rogue_status_get_total(e, ROGUE_STATUS_BLEED) == 20);
+    rogue_status_update(400.0, NULL, NULL, NULL);
+    CHECK(rogue_status_get_total(e, ROGUE_STATUS_BLEED) == 0 && rogue_status_end_ms(e, 0) < 0);
+    /* invalid keys are rejected */
+    CHECK(!rogue_status_apply(ROGUE_STATUS_ENTITY_NONE, 0, 1, 1.0, 0.0, ROGUE_BUFF_STACK_ADD, 0));
+    CHECK(!rogue_status_apply(e, ROGUE_STATUS_TYPE_MAX, 1, 1.0, 0.0, ROGUE_BUFF_STACK_ADD, 0));
+    /* entity removal */
+    for (int t = ROGUE_STATUS_BLEED; t <= ROGUE_STATUS_CHILL; t++)
+        rogue_status_apply(e, t, 1, 1000.0, 0.0, ROGUE_BUFF_STACK_ADD, 0);
+    CHECK(rogue_status_entity_count(e) == 2);
+    rogue_status_remove_entity(e);
+    CHECK(rogue_status_entity_count(e) == 0 && rogue_status_get_total(e, ROGUE_STATUS_CHILL) == 0);
+}
+
+static void test_batched_ticks(void)
+{
+    rogue_status_reset();
+    enum
+    {
+        ENEMIES = 3000
+    };
+    /* each enemy bleeds 2/tick every 100ms for 1000ms; odd enemies also carry a periodic
+     * 450ms chill (re-applied to enemy 0 from the expiry callback) */
+    for (int i = 0; i < ENEMIES; i++)
+    {
+        RogueStatusEntity e = rogue_status_entity_enemy(i);
+        rogue_status_apply(e, ROGUE_STATUS_BLEED, 2, 1000.0, 0.0, ROGUE_BUFF_STACK_ADD, 100.0f);
+        if (i & 1)
+            rogue_status_apply(e, ROGUE_STATUS_CHILL, 1, 450.0, 0.0, ROGUE_BUFF_STACK_ADD, 100.0f);
+    }
+    RogueStatusStats st;
+    rogue_status_stats(&st);
+    CHECK(st.live == ENEMIES + ENEMIES / 2 && st.entities == ENEMIES);
+    Counters c = {0, 0, 0};
+    for (int t = 16; t < 1000; t += 16)
+        rogue_status_update((double) t, on_tick, on_expire, &c);
+    rogue_status_stats(&st);
+    CHECK(st.live == ENEMIES); /* chills expired at 450 (4 ticks each) */
+    CHECK(c.expired == ENEMIES / 2);
+    /* a long frame delivers the remaining bleed ticks in one call per record */
+    int calls_before = c.tick_calls;
+    rogue_status_update(1000.0, on_tick, on_expire, &c);
+    CHECK(c.tick_calls - calls_before <= ENEMIES);
+    CHECK(c.tick_damage == (long long) ENEMIES * 2 * 10 + (long long) (ENEMIES / 2) * 4);
+    rogue_status_stats(&st);
+    CHECK(c.expired == ENEMIES + ENEMIES / 2 && st.entities == 1); /* enemy 0 re-chilled */
+    CHECK(rogue_status_get_total(rogue_status_entity_enemy(0), ROGUE_STATUS_CHILL) == 1);
+    CHECK(st.ticks == (unsigned) (ENEMIES * 10 + (ENEMIES / 2) * 4));
+}
+
+static void test_live_buffs(void)
+{
+    rogue_buffs_init();
+    rogue_buffs_set_dampening(0.0);
+    rogue_buffs_apply(ROGUE_BUFF_STAT_STRENGTH, 5, 1000.0, 0.0, ROGUE_BUFF_STACK_ADD, 0);
+    rogue_buffs_apply(ROGUE_BUFF_STAT_STRENGTH, 4, 2000.0, 10.0, ROGUE_BUFF_STACK_ADD, 0);
+    RogueBuffHandle h =
+        rogue_buffs_apply_h(ROGUE_BUFF_POWER_STRIKE, 7, 500.0, 0.0, ROGUE_BUFF_STACK_UNIQUE, 0);
+    CHECK(rogue_buffs_get_total(ROGUE_BUFF_STAT_STRENGTH) == 9);
+    CHECK(rogue_buffs_strength_bonus() == 9);
+    CHECK(rogue_buffs_remove_h(h, 100.0));
+    CHECK(rogue_buffs_get_total(ROGUE_BUFF_POWER_STRIKE) == 0);
+    /* the early-out must not hide an expiry that a later apply moved earlier */
+    rogue_buffs_update(100.0);
+    rogue_buffs_apply(ROGUE_BUFF_CC_SLOW, 3, 50.0, 100.0, ROGUE_BUFF_STACK_ADD, 0);
+    rogue_buffs_update(160.0);
+    CHECK(rogue_buffs_get_total(ROGUE_BUFF_CC_SLOW) == 0 && rogue_buffs_active_count() == 1);
+    rogue_buffs_update(2010.0);
+    CHECK(rogue_buffs_get_total(ROGUE_BUFF_STAT_STRENGTH) == 0);
+}
+
+static void bench(void)
+{
+    rogue_status_reset();
+    enum
+    {
+        ENEMIES = 10000
+    };
+    Counters c = {0, 0, 0};
+    uint64_t t0 = rogue_prof_now_ns();
+    for (int frame = 0; frame < 300; frame++)
+    {
+        double now = frame * 16.0;
+        if (frame % 30 == 0)
+            for (int i = 0; i < ENEMIES; i++)
+                rogue_status_apply(rogue_status_entity_enemy(i), ROGUE_STATUS_BLEED + (i & 1), 1,
+                                   400.0 + (double) (i % 200), now, ROGUE_BUFF_STACK_REFRESH,
+                                   250.0f);
+        rogue_status_update(now, on_tick, NULL, &c);
+    }
+    double ms = (double) (rogue_prof_now_ns() - t0) / 1e6;
+    RogueStatusStats st;
+    rogue_status_stats(&st);
+    CHECK(st.expired > 0 && st.ticks > 0);
+    printf("status_effects_bench: enemies=%d frames=300 ticks=%u expired=%u total=%.2fms\n",
+           ENEMIES, st.ticks, st.expired, ms);
+}
+
+int main(void)
+{
+    test_stacking();
+    test_batched_ticks();
+    test_live_buffs();
+    bench();
+    rogue_status_shutdown();
+    if (g_fail)
+        return 1;
+    printf("STATUS_EFFECTS_OK\n");
+    return 0;
+}
@@ -0,0 +1,160 @@
+/* Offline atlas bake: pack every sprite sheet into atlas pages once and write the manifest the
+ * texture cache uses at startup (see src/graphics/texture_cache.h).
+ *
+ * Usage: atlas_bake [out.manifest] [source.cfg ...]   (run from the repo root)
+ *
+ * Image paths are collected from the sheet-bearing content files (tiles, vegetation, player and
+ * enemy sheets unless sources are given), sized from the PNG header and packed with
+ * rogue_atlas_manifest_bake. Images too large for an atlas are skipped and stay standalone. */
+#define SDL_MAIN_HANDLED
+#include "../src/graphics/atlas_packer.h"
+#include "../src/graphics/texture_cache.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_IMAGES 1024
+
+static char g_paths[MAX_IMAGES][256];
+static int g_w[MAX_IMAGES], g_h[MAX_IMAGES];
+static int g_count = 0;
+
+static FILE* open_file(const char* path, const char* mode)
+{
+    FILE* f = NULL;
+#if defined(_MSC_VER)
+    if (fopen_s(&f, path, mode) != 0)
+        f = NULL;
+#else
+    f = fopen(path, mode);
+#endif
+    return f;
+}
+
+/* Width / height from the IHDR chunk; 0 when path is not a readable PNG. */
+static int png_size(const char* path, int* w, int* h)
+{
+    FILE* f = open_file(path, "rb");
+    if (!f)
+        return 0;
+    unsigned char hdr[24];
+    size_t n = fread(hdr, 1, sizeof hdr, f);
+    fclose(f);
+    static const unsigned char sig[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'};
+    if (n != sizeof hdr || memcmp(hdr, sig, 8) != 0 || memcmp(hdr + 12, "IHDR", 4) != 0)
+        return 0;
+    *w = (int) (((unsigned) hdr[16] << 24) | ((unsigned) hdr[17] << 16) |
+                ((unsigned) hdr[18] << 8) | hdr[19]);
+    *h = (int) (((unsigned) hdr[20] << 24) | ((unsigned) hdr[21] << 16) |
+                ((unsigned) hdr[22] << 8) | hdr[23]);
+    return *w > 0 && *h > 0;
+}
+
+static void add_image(const char* token, size_t len)
+{
+    char path[256];
+    memcpy(path, token, len);
+    path[len] = '\0';
+    rogue_atlas_normalize_path(path);
+    /* config paths relative to build/ resolve from the repo root without the "../" */
+    const char* p = path;
+    while (strncmp(p, "../", 3) == 0)
+        p += 3;
+    for (int i = 0; i < g_count; ++i)
+        if (strcmp(g_paths[i], p) == 0)
+            return;
+    int w = 0, h = 0;
+    if (!png_size(p, &w, &h))
+    {
+        fprintf(stderr, "atlas_bake: skipping unreadable %s\n", p);
+        return;
+    }
+    if (w > ROGUE_TEXTURE_ATLAS_MAX_IMAGE || h > ROGUE_TEXTURE_ATLAS_MAX_IMAGE)
+        return;
+    if (g_count >= MAX_IMAGES)
+    {
+        fprintf(stderr, "atlas_bake: more than %d images, rest left standalone\n", MAX_IMAGES);
+        return;
+    }
+    snprintf(g_paths[g_count], sizeof g_paths[0], "%s", p);
+    g_w[g_count] = w;
+    g_h[g_count] = h;
+    g_count++;
+}
+
+/* Every field ending in ".png" (separated by commas, tabs or quotes) names an image; paths may
+   contain spaces. */
+static void scan_source(const char* path)
+{
+    FILE* f = open_file(path, "rb");
+    if (!f)
+    {
+        fprintf(stderr, "atlas_bake: no %s\n", path);
+        return;
+    }
+    char line[1024];
+    while (fgets(line, sizeof line, f))
+    {
+        if (line[0] == '#')
+            continue;
+        const char* tok = line;
+        while (*tok)
+        {
+            size_t len = strcspn(tok, ",\t\r\n\"");
+            size_t start = strspn(tok, " ");
+            size_t end = len;
+            while (end > start && tok[end - 1] == ' ')
+                end--;
+            if (end - start > 4 && end - start < 256 && strncmp(tok + end - 4, ".png", 4) == 0)
+                add_image(tok + start, end - start);
+            tok += len;
+            if (*tok)
+                tok++;
+        }
+    }
+    fclose(f);
+}
+
+int main(int argc, char** argv)
+{
+    static const char* default_sources[] = {
+        "assets/tiles.cfg",         "assets/biome_assets.cfg", "assets/plants.cfg",
+        "assets/trees.cfg",         "assets/player_sheets.cfg", "assets/enemies.cfg",
+        "assets/enemies.json"};
+    const char* out = argc > 1 ? argv[1] : ROGUE_TEXTURE_ATLAS_MANIFEST;
+    if (argc > 2)
+        for (int i = 2; i < argc; ++i)
+            scan_source(argv[i]);
+    else
+        for (size_t i = 0; i < sizeof default_sources / sizeof default_sources[0]; ++i)
+            scan_source(default_sources[i]);
+    const char* paths[MAX_IMAGES];
+    for (int i = 0; i < g_count; ++i)
+        paths[i] = g_paths[i];
+    RogueAtlasManifest m;
+    int pages =
+        rogue_atlas_manifest_bake(&m, paths, g_w, g_h, g_count, ROGUE_TEXTURE_ATLAS_PAGE_SIZE,
+                                  ROGUE_TEXTURE_ATLAS_PADDING);
+    if (pages < 0)
+    {
+        fprintf(stderr, "atlas_bake: packing failed\n");
+        return 1;
+    }
+    if (pages > ROGUE_TEXTURE_MAX_ATLAS_PAGES)
+    {
+        fprintf(stderr, "atlas_bake: %d pages exceed the runtime limit of %d\n", pages,
+                ROGUE_TEXTURE_MAX_ATLAS_PAGES);
+        rogue_atlas_manifest_free(&m);
+        return 1;
+    }
+    if (rogue_atlas_manifest_write(&m, out) != 0)
+    {
+        fprintf(stderr, "atlas_bake: writing %s failed\n", out);
+        rogue_atlas_manifest_free(&m);
+        return 1;
+    }
+    printf("atlas_bake: %d images on %d page(s) of %dx%d -> %s\n", m.count, pages, m.page_w,
+           m.page_h, out);
+    rogue_atlas_manifest_free(&m);
+    return 0;
+}
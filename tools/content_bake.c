@@ -0,0 +1,55 @@
+/* Offline content bake: parse the text content once and write a memory-mappable pack.
+ *
+ * Usage: content_bake [out.pack]   (default assets/content.pack, run from the repo root)
+ *
+ * Loads affixes, item defs and loot tables through the regular text loaders, bakes them with
+ * rogue_loot_pack_bake, then maps the written file and verifies every record against the
+ * registries it came from. Exit code 0 only when the pack verifies clean. */
+#define SDL_MAIN_HANDLED
+#include "../src/core/app/content_manifest.h"
+#include "../src/core/loot/loot_affixes.h"
+#include "../src/core/loot/loot_item_defs.h"
+#include "../src/core/loot/loot_pack.h"
+#include "../src/core/loot/loot_tables.h"
+#include <stdio.h>
+
+int main(int argc, char** argv)
+{
+    const char* out = argc > 1 ? argv[1] : "assets/content.pack";
+    rogue_affixes_reset();
+    rogue_item_defs_reset();
+    rogue_loot_tables_reset();
+    if (rogue_affixes_load_from_cfg("assets/affixes.cfg") < 0)
+        fprintf(stderr, "content_bake: no affixes.cfg, baking without affixes\n");
+    RogueContentLoadResult loaded;
+    if (rogue_content_manifest_load(0, &loaded, NULL) != 0 || rogue_item_defs_count() == 0)
+    {
+        fprintf(stderr, "content_bake: failed to load text content\n");
+        return 1;
+    }
+    int rc = rogue_loot_pack_bake_file(out);
+    if (rc != 0)
+    {
+        fprintf(stderr, "content_bake: writing %s failed (%d)\n", out, rc);
+        return 1;
+    }
+    RoguePack pack;
+    rc = rogue_pack_open(&pack, out);
+    if (rc != 0)
+    {
+        fprintf(stderr, "content_bake: %s does not reopen (%d)\n", out, rc);
+        return 1;
+    }
+    int mismatches = rogue_loot_pack_verify(&pack);
+    size_t size = pack.size;
+    rogue_pack_close(&pack);
+    if (mismatches != 0)
+    {
+        fprintf(stderr, "content_bake: %s differs from the text content (%d records)\n", out,
+                mismatches);
+        return 1;
+    }
+    printf("content_bake: %s affixes=%d items=%d tables=%d bytes=%zu\n", out, rogue_affix_count(),
+           rogue_item_defs_count(), rogue_loot_tables_count(), size);
+    return 0;
+}
@@ -0,0 +1,144 @@
+/* Headless replay runner: play a recorded input log through the fixed-step simulation as fast as
+ * possible with rendering disabled (see src/core/app/app_replay.h).
+ *
+ * Usage:
+ *   replay_runner <replay.log> [--record] [--csv <frames.csv>]
+ *   replay_runner --make <replay.log> <seed> <frames> [step_ms]
+ *
+ * --record stores the per-frame state hashes into the log (the reference run); without it the
+ * run is checked against the stored hashes and exits 1 at the first divergent frame. --csv writes
+ * frame,hash,frame_ms and the per-subsystem sim stage timings for every frame. --make writes a
+ * scripted log (walking a square, attacking every second) for benchmarking. Prints frames/sec and
+ * the per-stage totals; exit 2 on usage or IO errors. */
+#define SDL_MAIN_HANDLED
+#include "../src/core/app/app_replay.h"
+#include "../src/input/input.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int make_log(const char* path, unsigned int seed, int frames, double step_ms)
+{
+    RogueReplayLog log;
+    rogue_replay_log_init(&log, seed, step_ms, frames);
+    static const int dirs[4] = {ROGUE_KEY_RIGHT, ROGUE_KEY_DOWN, ROGUE_KEY_LEFT, ROGUE_KEY_UP};
+    int segment = (int) (2000.0 / step_ms); /* two seconds per side */
+    if (segment < 1)
+        segment = 1;
+    int rc = 0;
+    for (int f = 0, side = 0; f < frames && rc == 0; f += segment, ++side)
+    {
+        if (f > 0)
+            rc |= rogue_replay_log_add_key(&log, f, dirs[(side - 1) & 3], 0);
+        rc |= rogue_replay_log_add_key(&log, f, dirs[side & 3], 1);
+    }
+    int attack_every = (int) (1000.0 / step_ms);
+    for (int f = attack_every; f + 1 < frames && rc == 0 && attack_every > 0; f += attack_every)
+    {
+        rc |= rogue_replay_log_add_key(&log, f, ROGUE_KEY_ACTION, 1);
+        rc |= rogue_replay_log_add_key(&log, f + 1, ROGUE_KEY_ACTION, 0);
+    }
+    if (rc == 0)
+        rc = rogue_replay_log_write(&log, path);
+    rogue_replay_log_free(&log);
+    return rc;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc >= 5 && strcmp(argv[1], "--make") == 0)
+    {
+        double step_ms = argc > 5 ? atof(argv[5]) : 1000.0 / 60.0;
+        int frames = atoi(argv[4]);
+        if (frames <= 0 || step_ms <= 0.0 ||
+            make_log(argv[2], (unsigned int) strtoul(argv[3], NULL, 10), frames, step_ms) != 0)
+        {
+            fprintf(stderr, "replay_runner: cannot write %s\n", argv[2]);
+            return 2;
+        }
+        printf("replay_runner: wrote %s (%d frames)\n", argv[2], frames);
+        return 0;
+    }
+    const char* path = NULL;
+    const char* csv_path = NULL;
+    int record = 0, bad_args = 0;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--record") == 0)
+            record = 1;
+        else if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc)
+            csv_path = argv[++i];
+        else if (!path && argv[i][0] != '-')
+            path = argv[i];
+        else
+            bad_args = 1;
+    }
+    if (!path || bad_args)
+    {
+        fprintf(stderr, "usage: replay_runner <replay.log> [--record] [--csv <frames.csv>]\n"
+                        "       replay_runner --make <replay.log> <seed> <frames> [step_ms]\n");
+        return 2;
+    }
+    RogueReplayLog log;
+    if (rogue_replay_log_read(&log, path) != 0)
+    {
+        fprintf(stderr, "replay_runner: cannot read %s\n", path);
+        return 2;
+    }
+    FILE* csv = NULL;
+    if (csv_path)
+    {
+#if defined(_MSC_VER)
+        if (fopen_s(&csv, csv_path, "wb") != 0)
+            csv = NULL;
+#else
+        csv = fopen(csv_path, "wb");
+#endif
+        if (!csv)
+        {
+            fprintf(stderr, "replay_runner: cannot write %s\n", csv_path);
+            rogue_replay_log_free(&log);
+            return 2;
+        }
+    }
+#ifdef ROGUE_HAVE_SDL
+    SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy"); /* no window, no renderer */
+#endif
+    RogueAppConfig cfg = {"ReplayRunner", 320, 180, 320, 180, 0, 0, 0, 1, ROGUE_WINDOW_WINDOWED,
+                          {0, 0, 0, 255}, 0};
+    if (!rogue_replay_app_init(&cfg))
+    {
+        fprintf(stderr, "replay_runner: app init failed\n");
+        if (csv)
+            fclose(csv);
+        rogue_replay_log_free(&log);
+        return 2;
+    }
+    RogueReplayResult res;
+    int rc = rogue_replay_run(&log, record, &res, csv);
+    rogue_replay_app_shutdown();
+    if (csv)
+        fclose(csv);
+    printf("replay_runner: %d/%d frames in %.1f ms (%.0f frames/sec, worst frame %.3f ms) "
+           "final=%016llx\n",
+           res.frames_run, log.frames, res.wall_ms, res.frames_per_sec, res.max_frame_ms,
+           (unsigned long long) res.final_hash);
+    for (int i = 0; i < res.zone_count; ++i)
+        printf("  %-16s total %8.3f ms  worst frame %.3f ms\n", res.zones[i].name,
+               res.zones[i].total_ms, res.zones[i].max_frame_ms);
+    if (rc > 0)
+    {
+        printf("replay_runner: DIVERGED at frame %d expected %016llx got %016llx\n",
+               res.divergent_frame, (unsigned long long) res.expected_hash,
+               (unsigned long long) res.actual_hash);
+    }
+    else if (rc == 0 && record && rogue_replay_log_write(&log, path) != 0)
+    {
+        fprintf(stderr, "replay_runner: cannot write hashes to %s\n", path);
+        rc = 2;
+    }
+    else if (rc == 0 && !record && log.hash_count == 0)
+        printf("replay_runner: log has no hashes (run with --record first); benchmark only\n");
+    rogue_replay_log_free(&log);
+    return rc < 0 ? 2 : rc;
+}
@@ -0,0 +1,549 @@
+/* Consolidated microbenchmark suite (see src/util/bench.h).
+ *
+ * Usage: rogue_bench [--filter <substr>] [--reps N] [--warmup N] [--json <out.json>]
+ *                    [--baseline <base.json> [--tolerance <fraction>]] [--list]
+ *
+ * Runs the pathfinding, worldgen stage, loot roll, stat recompute, save/load, event bus, UI
+ * build, particle update, logging and headless sim frame cases, prints median / p95 per operation
+ * and optionally writes the JSON report. With --baseline every case is compared against the
+ * stored report by median; exit 1 when any case is slower than the baseline by more than the
+ * tolerance (default 0.10). Exit 2 on usage or IO errors. Run from the build directory (assets
+ * are found via rogue_find_asset_path); save/load writes into rogue_bench_saves/.
+ *
+ * Logging overhead: log.* time disabled, synchronous and asynchronous calls, and app.sim_frame
+ * times whole simulation frames at the default (WARN) level, i.e. with every debug call compiled
+ * in but filtered at runtime. Write a baseline from a -DROGUE_LOG_COMPILE_LEVEL=2 build (debug and
+ * info compiled out) and run a level 0 build against it with --baseline to see what the disabled
+ * calls cost per frame.
+ *
+ * Reference numbers (Release, no SDL, one shared vCPU; median of the per-run medians over six
+ * interleaved rounds of --reps 21 for log.*, ten rounds of --reps 61 for app.sim_frame):
+ *
+ *                          level 2      level 0
+ *   log.debug_disabled     0.2 ns       0.6 ns     per call
+ *   log.warn_sync          621 ns       475 ns     per call
+ *   log.warn_async         568 ns       541 ns     per call
+ *   app.sim_frame          17.2 us      17.9 us    per sim tick
+ *
+ * The 0.4 ns on a disabled debug call is the inline category threshold test. The WARN paths are
+ * identical in both builds, so those differences are noise. Single app.sim_frame runs on that
+ * host ranged from 11 to 20 us, so the +3.7% is not resolvable there; one --baseline run flagged
+ * it at the 10% tolerance and the next did not. A quieter machine is needed to bound the
+ * compiled-in debug cost below about 5%. */
+#define SDL_MAIN_HANDLED
+#include "../src/audio_vfx/effects.h"
+#include "../src/core/app/app.h"
+#include "../src/core/app/app_replay.h"
+#include "../src/core/app/app_state.h"
+#include "../src/core/equipment/equipment.h"
+#include "../src/core/equipment/equipment_stats.h"
+#include "../src/core/integration/event_bus.h"
+#include "../src/core/loot/loot_instances.h"
+#include "../src/core/loot/loot_item_defs.h"
+#include "../src/core/loot/loot_tables.h"
+#include "../src/core/persistence/save_internal.h"
+#include "../src/core/persistence/save_manager.h"
+#include "../src/entities/player.h"
+#include "../src/game/buffs.h"
+#include "../src/game/navigation.h"
+#include "../src/game/stat_cache.h"
+#include "../src/ui/core/ui_context.h"
+#include "../src/util/bench.h"
+#include "../src/util/log.h"
+#include "../src/util/path_utils.h"
+#include "../src/world/world_gen.h"
+#include "../src/world/world_gen_config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ---- pathfinding: A* between fixed walkable pairs on a generated map ---- */
+#define PATH_PAIRS 16
+static int g_path_pairs[PATH_PAIRS][4];
+static volatile int g_sink;
+
+static int path_setup(void* ud)
+{
+    (void) ud;
+    if (!g_app.world_map.tiles)
+    {
+        if (!rogue_tilemap_init(&g_app.world_map, 128, 128))
+            return -1;
+        RogueWorldGenConfig cfg = rogue_world_gen_config_build(42u, 0, 0);
+        if (!rogue_world_generate(&g_app.world_map, &cfg))
+            return -1;
+    }
+    unsigned rng = 7u;
+    int found = 0;
+    for (int tries = 0; tries < 100000 && found < PATH_PAIRS; ++tries)
+    {
+        int sx = rogue_rng_range(&rng, g_app.world_map.width);
+        int sy = rogue_rng_range(&rng, g_app.world_map.height);
+        int tx = sx + rogue_rng_range(&rng, 81) - 40;
+        int ty = sy + rogue_rng_range(&rng, 81) - 40;
+        if (rogue_nav_is_blocked(sx, sy) || rogue_nav_is_blocked(tx, ty))
+            continue;
+        RoguePath p;
+        if (!rogue_nav_astar(sx, sy, tx, ty, &p) || p.failed || p.length < 20)
+            continue;
+        g_path_pairs[found][0] = sx;
+        g_path_pairs[found][1] = sy;
+        g_path_pairs[found][2] = tx;
+        g_path_pairs[found][3] = ty;
+        found++;
+    }
+    return found == PATH_PAIRS ? 0 : -1;
+}
+
+static void path_run(void* ud)
+{
+    (void) ud;
+    static RoguePath p;
+    for (int i = 0; i < PATH_PAIRS; ++i)
+    {
+        rogue_nav_astar(g_path_pairs[i][0], g_path_pairs[i][1], g_path_pairs[i][2],
+                        g_path_pairs[i][3], &p);
+        g_sink += p.length;
+    }
+}
+
+/* ---- worldgen stages on a 128x128 map; each run starts from the same macro layout ---- */
+static RogueWorldGenConfig g_wg_cfg;
+static RogueTileMap g_wg_macro, g_wg_work;
+
+static int wg_setup(void* ud)
+{
+    (void) ud;
+    if (g_wg_macro.tiles)
+        return 0;
+    memset(&g_wg_cfg, 0, sizeof g_wg_cfg);
+    g_wg_cfg.seed = 1337;
+    g_wg_cfg.width = 128;
+    g_wg_cfg.height = 128;
+    g_wg_cfg.noise_octaves = 4;
+    g_wg_cfg.noise_gain = 0.5;
+    g_wg_cfg.noise_lacunarity = 2.0;
+    g_wg_cfg.cave_fill_chance = 0.45;
+    g_wg_cfg.cave_iterations = 3;
+    g_wg_cfg.river_attempts = 4;
+    RogueWorldGenContext ctx;
+    rogue_worldgen_context_init(&ctx, &g_wg_cfg);
+    if (!rogue_tilemap_init(&g_wg_macro, 128, 128) || !rogue_tilemap_init(&g_wg_work, 128, 128))
+        return -1;
+    int ok = rogue_world_generate_macro_layout(&g_wg_cfg, &ctx, &g_wg_macro, NULL, NULL);
+    rogue_worldgen_context_shutdown(&ctx);
+    return ok ? 0 : -1;
+}
+
+static void wg_macro_run(void* ud)
+{
+    (void) ud;
+    RogueWorldGenContext ctx;
+    rogue_worldgen_context_init(&ctx, &g_wg_cfg);
+    rogue_world_generate_macro_layout(&g_wg_cfg, &ctx, &g_wg_work, NULL, NULL);
+    rogue_worldgen_context_shutdown(&ctx);
+}
+
+static void wg_caves_run(void* ud)
+{
+    (void) ud;
+    memcpy(g_wg_work.tiles, g_wg_macro.tiles, (size_t) (g_wg_macro.width * g_wg_macro.height));
+    RogueWorldGenContext ctx;
+    rogue_worldgen_context_init(&ctx, &g_wg_cfg);
+    rogue_world_generate_local_terrain(&g_wg_cfg, &ctx, &g_wg_work);
+    rogue_world_generate_caves_layer(&g_wg_cfg, &ctx, &g_wg_work);
+    rogue_worldgen_context_shutdown(&ctx);
+}
+
+static void wg_erosion_run(void* ud)
+{
+    (void) ud;
+    memcpy(g_wg_work.tiles, g_wg_macro.tiles, (size_t) (g_wg_macro.width * g_wg_macro.height));
+    RogueWorldGenContext ctx;
+    rogue_worldgen_context_init(&ctx, &g_wg_cfg);
+    rogue_world_refine_rivers(&g_wg_cfg, &ctx, &g_wg_work);
+    rogue_world_apply_erosion(&g_wg_cfg, &ctx, &g_wg_work, 2, 2);
+    rogue_worldgen_context_shutdown(&ctx);
+}
+
+/* ---- content: item defs + loot tables from the test assets ---- */
+static int content_setup(void* ud)
+{
+    (void) ud;
+    if (rogue_loot_tables_count() > 0)
+        return 0;
+    char items[256], tables[256];
+    if (!rogue_find_asset_path("test_items.cfg", items, sizeof items) ||
+        !rogue_find_asset_path("test_loot_tables.cfg", tables, sizeof tables))
+        return -1;
+    rogue_item_defs_reset();
+    rogue_loot_tables_reset();
+    if (rogue_item_defs_load_from_cfg(items) <= 0 || rogue_loot_tables_load_from_cfg(tables) <= 0)
+        return -1;
+    return 0;
+}
+
+#define LOOT_ROLLS 1000
+static void loot_run(void* ud)
+{
+    (void) ud;
+    unsigned rng = 12345u;
+    int idx[8], qty[8], rar[8];
+    for (int i = 0; i < LOOT_ROLLS; ++i)
+        g_sink += rogue_loot_roll_ex(i % rogue_loot_tables_count(), &rng, 8, idx, qty, rar);
+}
+
+/* ---- stat recompute: full derived-stat pass with a weapon and armor equipped ---- */
+static int stats_setup(void* ud)
+{
+    if (content_setup(ud) != 0)
+        return -1;
+    rogue_items_init_runtime();
+    rogue_equip_reset();
+    rogue_player_init(&g_app.player);
+    int armor_slot = ROGUE_EQUIP_ARMOR_HEAD;
+    for (int i = 0; i < rogue_item_defs_count(); ++i)
+    {
+        const RogueItemDef* d = rogue_item_def_at(i);
+        if (!d || (d->category != ROGUE_ITEM_WEAPON && d->category != ROGUE_ITEM_ARMOR))
+            continue;
+        int inst = rogue_items_spawn(i, 1, 0, 0);
+        if (inst < 0)
+            continue;
+        if (d->category == ROGUE_ITEM_WEAPON && rogue_equip_get(ROGUE_EQUIP_WEAPON) < 0)
+            rogue_equip_try(ROGUE_EQUIP_WEAPON, inst);
+        else if (d->category == ROGUE_ITEM_ARMOR && armor_slot <= ROGUE_EQUIP_ARMOR_FEET)
+            rogue_equip_try((enum RogueEquipSlot) armor_slot++, inst);
+    }
+    return 0;
+}
+
+#define STAT_PASSES 64
+static void stats_run(void* ud)
+{
+    (void) ud;
+    for (int i = 0; i < STAT_PASSES; ++i)
+        rogue_stat_cache_force_update(&g_app.player);
+    g_sink += (int) rogue_stat_cache_fingerprint();
+}
+
+/* Combat frame as app_step runs it: a buff changes every pass while the equipment stays put. */
+static int stats_buff_setup(void* ud)
+{
+    if (stats_setup(ud) != 0)
+        return -1;
+    rogue_buffs_init();
+    rogue_buffs_set_dampening(0.0);
+    return 0;
+}
+
+static void stats_buff_run(void* ud)
+{
+    (void) ud;
+    for (int i = 0; i < STAT_PASSES; ++i)
+    {
+        rogue_buffs_apply(ROGUE_BUFF_STAT_STRENGTH, 1, 3000, 0.0, ROGUE_BUFF_STACK_ADD, 1);
+        rogue_equipment_apply_stat_bonuses(&g_app.player);
+        rogue_stat_cache_update(&g_app.player);
+    }
+    g_sink += (int) rogue_stat_cache_fingerprint();
+}
+
+static void stats_teardown(void* ud)
+{
+    (void) ud;
+    rogue_equip_reset();
+    rogue_items_shutdown_runtime();
+}
+
+/* ---- save/load: full slot round trip of the core components ---- */
+static int save_setup(void* ud)
+{
+    (void) ud;
+    rogue_save_paths_set_prefix("rogue_bench_saves");
+    rogue_save_manager_init();
+    rogue_register_core_save_components();
+    if (rogue_save_manager_save_slot(0) != 0)
+        return -1;
+    rogue_items_init_runtime();
+    return rogue_save_manager_load_slot(0) == 0 ? 0 : -1;
+}
+
+/* Loading appends item instances to the live pool, so each load starts from an empty pool the
+ * way a fresh session would; otherwise every repetition doubles the saved inventory. */
+static void save_run(void* ud)
+{
+    (void) ud;
+    g_sink += rogue_save_manager_save_slot(0);
+    rogue_items_init_runtime();
+    g_sink += rogue_save_manager_load_slot(0);
+}
+
+static void save_teardown(void* ud)
+{
+    (void) ud;
+    rogue_save_manager_delete_slot(0);
+    rogue_save_paths_set_prefix("");
+}
+
+/* ---- event bus: publish + synchronous dispatch to one subscriber ---- */
+#define BUS_EVENTS 256
+static bool bus_count(const RogueEvent* e, void* user)
+{
+    (void) e;
+    (*(int*) user)++;
+    return true;
+}
+
+static int g_bus_delivered;
+static int bus_setup(void* ud)
+{
+    (void) ud;
+    RogueEventBusConfig cfg = rogue_event_bus_create_default_config("bench");
+    cfg.enable_replay_recording = false;
+    if (!rogue_event_bus_init(&cfg))
+        return -1;
+    return rogue_event_subscribe(ROGUE_EVENT_ENTITY_CREATED, bus_count, &g_bus_delivered, 1) ? 0
+                                                                                            : -1;
+}
+
+static void bus_run(void* ud)
+{
+    (void) ud;
+    RogueEventPayload payload;
+    memset(&payload, 0, sizeof payload);
+    for (int i = 0; i < BUS_EVENTS; ++i)
+    {
+        payload.entity.entity_id = (uint32_t) i;
+        rogue_event_publish(ROGUE_EVENT_ENTITY_CREATED, &payload, ROGUE_EVENT_PRIORITY_NORMAL, 1,
+                            "bench");
+    }
+    rogue_event_process_sync(BUS_EVENTS, 1000000u);
+}
+
+static void bus_teardown(void* ud)
+{
+    (void) ud;
+    rogue_event_bus_shutdown();
+}
+
+/* ---- UI build: one frame of an inventory-like panel (48 rows of label + button) ---- */
+static RogueUIContext g_ui;
+static int ui_setup(void* ud)
+{
+    (void) ud;
+    RogueUIContextConfig cfg;
+    memset(&cfg, 0, sizeof cfg);
+    cfg.max_nodes = 512;
+    cfg.seed = 7u;
+    return rogue_ui_init(&g_ui, &cfg) ? 0 : -1;
+}
+
+static void ui_run(void* ud)
+{
+    (void) ud;
+    static const char* labels[4] = {"Sword", "Shield", "Potion", "Scroll"};
+    rogue_ui_begin(&g_ui, 16.0);
+    rogue_ui_panel(&g_ui, (RogueUIRect){0, 0, 320, 400}, 0x202028FFu);
+    for (int i = 0; i < 48; ++i)
+    {
+        float y = 4.0f + (float) i * 8.0f;
+        rogue_ui_text(&g_ui, (RogueUIRect){4, y, 200, 8}, labels[i & 3], 0xFFFFFFFFu);
+        rogue_ui_button(&g_ui, (RogueUIRect){210, y, 100, 8}, "Use", 0x404050FFu, 0xFFFFFFFFu);
+    }
+    rogue_ui_end(&g_ui);
+}
+
+static void ui_teardown(void* ud)
+{
+    (void) ud;
+    rogue_ui_shutdown(&g_ui);
+}
+
+/* ---- particles: 32 emitters at steady state, one 16ms update per op ---- */
+static int fx_setup(void* ud)
+{
+    (void) ud;
+    rogue_vfx_registry_clear();
+    rogue_vfx_clear_active();
+    rogue_vfx_set_frozen(0);
+    rogue_vfx_set_timescale(1.0f);
+    if (rogue_vfx_registry_register("bench_sparks", ROGUE_VFX_LAYER_MID, 3600000u, 1) != 0 ||
+        rogue_vfx_registry_set_emitter("bench_sparks", 120.0f, 500u, 64) != 0)
+        return -1;
+    for (int i = 0; i < 32; ++i)
+        rogue_vfx_spawn_by_id("bench_sparks", (float) (i % 8) * 4.0f, (float) (i / 8) * 4.0f);
+    for (int i = 0; i < 60; ++i) /* reach steady state */
+        rogue_vfx_update(16);
+    return rogue_vfx_particles_active_count() > 0 ? 0 : -1;
+}
+
+static void fx_run(void* ud)
+{
+    (void) ud;
+    rogue_vfx_update(16);
+}
+
+static void fx_teardown(void* ud)
+{
+    (void) ud;
+    rogue_vfx_clear_active();
+    rogue_vfx_registry_clear();
+}
+
+/* ---- logging: filtered, synchronous and asynchronous calls (sink: a scratch file) ---- */
+#define LOG_CALLS 256
+#define LOG_SINK_PATH "rogue_bench_log.txt"
+static FILE* g_log_sink;
+
+static int log_setup(void* ud)
+{
+    g_log_sink = fopen(LOG_SINK_PATH, "wb");
+    if (!g_log_sink)
+        return -1;
+    rogue_log_set_rate_limit(0); /* measure the write path, not the limiter */
+    rogue_log_set_output(g_log_sink);
+    if (ud && rogue_log_async_start() != 0)
+        return -1;
+    return 0;
+}
+
+static void log_disabled_run(void* ud)
+{
+    (void) ud;
+    for (int i = 0; i < LOG_CALLS; ++i)
+        ROGUE_LOG_DEBUG("bench debug %d hp=%d", i, g_app.player.health);
+}
+
+static void log_write_run(void* ud)
+{
+    (void) ud;
+    for (int i = 0; i < LOG_CALLS; ++i)
+        ROGUE_LOG_WARN("bench warn %d x=%.2f", i, (double) g_app.player.base.pos.x);
+}
+
+static void log_teardown(void* ud)
+{
+    if (ud)
+        rogue_log_async_stop();
+    rogue_log_set_output(NULL);
+    rogue_log_set_rate_limit(ROGUE_LOG_DEFAULT_RATE_LIMIT);
+    fclose(g_log_sink);
+    remove(LOG_SINK_PATH);
+}
+
+static int g_async_flag = 1;
+
+/* ---- app: whole headless simulation frames (renderer untouched) ---- */
+#define SIM_FRAMES 60
+static int app_setup(void* ud)
+{
+    (void) ud;
+    RogueAppConfig cfg = {"RogueBench", 320, 180, 320, 180, 0, 0, 0, 1, ROGUE_WINDOW_WINDOWED,
+                          {0, 0, 0, 255}, 0};
+    if (!rogue_replay_app_init(&cfg))
+        return -1;
+    rogue_app_sim_run(SIM_FRAMES, 1000.0 / 60.0); /* spawn / settle */
+    return 0;
+}
+
+static void app_run(void* ud)
+{
+    (void) ud;
+    rogue_app_sim_run(SIM_FRAMES, 1000.0 / 60.0);
+}
+
+static void app_teardown(void* ud)
+{
+    (void) ud;
+    rogue_replay_app_shutdown();
+}
+
+static const RogueBenchCase g_cases[] = {
+    {"pathfinding.astar", path_setup, path_run, NULL, NULL, PATH_PAIRS},
+    {"worldgen.macro_layout", wg_setup, wg_macro_run, NULL, NULL, 1},
+    {"worldgen.local_caves", wg_setup, wg_caves_run, NULL, NULL, 1},
+    {"worldgen.rivers_erosion", wg_setup, wg_erosion_run, NULL, NULL, 1},
+    {"loot.roll", content_setup, loot_run, NULL, NULL, LOOT_ROLLS},
+    {"stats.recompute", stats_setup, stats_run, stats_teardown, NULL, STAT_PASSES},
+    {"stats.buff_frame", stats_buff_setup, stats_buff_run, stats_teardown, NULL, STAT_PASSES},
+    {"save.slot_roundtrip", save_setup, save_run, save_teardown, NULL, 1},
+    {"event_bus.publish_dispatch", bus_setup, bus_run, bus_teardown, NULL, BUS_EVENTS},
+    {"ui.build_frame", ui_setup, ui_run, ui_teardown, NULL, 1},
+    {"vfx.particle_update", fx_setup, fx_run, fx_teardown, NULL, 1},
+    {"log.debug_disabled", log_setup, log_disabled_run, log_teardown, NULL, LOG_CALLS},
+    {"log.warn_sync", log_setup, log_write_run, log_teardown, NULL, LOG_CALLS},
+    {"log.warn_async", log_setup, log_write_run, log_teardown, &g_async_flag, LOG_CALLS},
+    {"app.sim_frame", app_setup, app_run, app_teardown, NULL, SIM_FRAMES},
+};
+
+int main(int argc, char** argv)
+{
+    RogueBenchConfig cfg = {3, 15, NULL};
+    const char* json_path = NULL;
+    const char* baseline_path = NULL;
+    double tolerance = 0.10;
+    const int case_count = (int) (sizeof g_cases / sizeof g_cases[0]);
+    for (int i = 1; i < argc; ++i)
+    {
+        const char* a = argv[i];
+        const char* next = i + 1 < argc ? argv[i + 1] : NULL;
+        if (strcmp(a, "--list") == 0)
+        {
+            for (int c = 0; c < case_count; ++c)
+                printf("%s\n", g_cases[c].name);
+            return 0;
+        }
+        else if (strcmp(a, "--filter") == 0 && next)
+            cfg.filter = argv[++i];
+        else if (strcmp(a, "--reps") == 0 && next)
+            cfg.reps = atoi(argv[++i]);
+        else if (strcmp(a, "--warmup") == 0 && next)
+            cfg.warmup = atoi(argv[++i]);
+        else if (strcmp(a, "--json") == 0 && next)
+            json_path = argv[++i];
+        else if (strcmp(a, "--baseline") == 0 && next)
+            baseline_path = argv[++i];
+        else if (strcmp(a, "--tolerance") == 0 && next)
+            tolerance = atof(argv[++i]);
+        else
+        {
+            fprintf(stderr, "usage: rogue_bench [--filter s] [--reps N] [--warmup N] "
+                            "[--json out.json] [--baseline base.json [--tolerance f]] [--list]\n");
+            return 2;
+        }
+    }
+    RogueBenchReport base;
+    if (baseline_path && rogue_bench_load_json(&base, baseline_path) != 0)
+    {
+        fprintf(stderr, "rogue_bench: cannot read baseline %s\n", baseline_path);
+        return 2;
+    }
+    static RogueBenchReport report;
+    rogue_bench_run_all(g_cases, case_count, &cfg, &report);
+    printf("%-28s %6s %14s %14s\n", "case", "ops", "median ns/op", "p95 ns/op");
+    for (int i = 0; i < report.count; ++i)
+        printf("%-28s %6d %14.1f %14.1f\n", report.results[i].name, report.results[i].ops,
+               report.results[i].median_ns, report.results[i].p95_ns);
+    int rc = 0;
+    if (json_path && rogue_bench_save_json(&report, json_path) != 0)
+    {
+        fprintf(stderr, "rogue_bench: cannot write %s\n", json_path);
+        rc = 2;
+    }
+    if (baseline_path)
+    {
+        RogueBenchDelta deltas[2 * ROGUE_BENCH_MAX_RESULTS];
+        int n = 0;
+        int regressions = rogue_bench_compare(&base, &report, tolerance, deltas,
+                                              2 * ROGUE_BENCH_MAX_RESULTS, &n);
+        printf("\ncompare vs %s (tolerance %.0f%%)\n", baseline_path, tolerance * 100.0);
+        for (int i = 0; i < n; ++i)
+            printf("%-28s %14.1f -> %14.1f  x%.2f  %s\n", deltas[i].name, deltas[i].base_ns,
+                   deltas[i].cur_ns, deltas[i].ratio, rogue_bench_verdict_name(deltas[i].verdict));
+        printf("%d regression(s)\n", regressions);
+        if (regressions > 0 && rc == 0)
+            rc = 1;
+    }
+    return rc;
+}